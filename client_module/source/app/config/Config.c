@@ -283,6 +283,7 @@ void _Config_loadDefaults(Config* this)
    _Config_configMapRedefine(this, "tuneUseBufferedAppend",            "true");
    _Config_configMapRedefine(this, "tuneStatFsCacheSecs",              "10");
    _Config_configMapRedefine(this, "tuneCoherentBuffers",              "true");
+   _Config_configMapRedefine(this, "tuneReadMetaFromSecondary",        "false");
 
    _Config_configMapRedefine(this, "sysMgmtdHost",                     "");
    _Config_configMapRedefine(this, "sysInodeIDStyle",                  INODEIDSTYLE_DEFAULT);
@@ -670,6 +671,9 @@ bool _Config_applyConfigMap(Config* this)
       if(!strcmp(keyStr, "tuneCoherentBuffers") )
          this->tuneCoherentBuffers = StringTk_strToBool(valueStr);
       else
+      if(!strcmp(keyStr, "tuneReadMetaFromSecondary") )
+         this->tuneReadMetaFromSecondary = StringTk_strToBool(valueStr);
+      else
       if(!strcmp(keyStr, "sysInodeIDStyle") )
       {
          SAFE_KFREE(this->sysInodeIDStyle);
@@ -134,6 +134,7 @@ static inline bool Config_getTuneUseGlobalAppendLocks(Config* this);
 static inline bool Config_getTuneUseBufferedAppend(Config* this);
 static inline unsigned Config_getTuneStatFsCacheSecs(Config* this);
 static inline bool Config_getTuneCoherentBuffers(Config* this);
+static inline bool Config_getTuneReadMetaFromSecondary(Config* this);
 
 static inline char* Config_getSysMgmtdHost(Config* this);
 static inline char* Config_getSysInodeIDStyle(Config* this);
@@ -283,6 +284,7 @@ struct Config
    bool     tuneUseBufferedAppend; // false disables buffering of append writes
    unsigned       tuneStatFsCacheSecs; // 0 disables caching of free space info from servers
    bool           tuneCoherentBuffers; // try to keep buffer cache and page cache coherent
+   bool           tuneReadMetaFromSecondary; // send read-only meta msgs to buddy secondary
 
    char*          sysMgmtdHost;
    char*          sysInodeIDStyle;
@@ -590,6 +592,11 @@ bool Config_getTuneCoherentBuffers(Config* this)
    return this->tuneCoherentBuffers;
 }
 
+bool Config_getTuneReadMetaFromSecondary(Config* this)
+{
+   return this->tuneReadMetaFromSecondary;
+}
+
 /**
  * Special function to automatically enable TuneRefreshOnGetAttr, e.g. for NFS exports.
  *
@@ -75,6 +75,8 @@ static inline void _NetMessage_setMsgType(NetMessage* this, unsigned short msgTy
 #define MSGHDRFLAG_BUDDYMIRROR_SECOND  (0x01)
 #define MSGHDRFLAG_IS_SELECTIVE_ACK    (0x02)
 #define MSGHDRFLAG_HAS_SEQUENCE_NO     (0x04)
+#define MSGHDRFLAG_READ_FROM_SECONDARY (0x08) /* read-only request sent to secondary of a buddy
+                                                 group, msgSequenceDone is the seq# watermark */
 
 struct NetMessageHeader
 {
@@ -172,6 +172,12 @@
 #define NETMSGTYPE_StripePatternUpdateResp         2130
 #define NETMSGTYPE_SetFileState                    2131
 #define NETMSGTYPE_SetFileStateResp                2132
+#define NETMSGTYPE_GetLatencyStats                 2133
+#define NETMSGTYPE_GetLatencyStatsResp             2134
+#define NETMSGTYPE_UnlinkLocalFiles                2135
+#define NETMSGTYPE_UnlinkLocalFilesResp            2136
+#define NETMSGTYPE_GetTargetLoadStats              2137
+#define NETMSGTYPE_GetTargetLoadStatsResp          2138
 
 // session messages
 #define NETMSGTYPE_OpenFile                        3001
@@ -208,6 +214,10 @@
 #define NETMSGTYPE_ReadLocalFileRDMA               3039
 #define NETMSGTYPE_ReadLocalFileRDMAResp           3040
 #endif
+#define NETMSGTYPE_ReadInlineFile                  3041
+#define NETMSGTYPE_ReadInlineFileResp              3042
+#define NETMSGTYPE_WriteInlineFile                 3043
+#define NETMSGTYPE_WriteInlineFileResp             3044
 
 // control messages
 #define NETMSGTYPE_SetChannelDirect                4001
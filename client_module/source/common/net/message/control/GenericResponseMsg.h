@@ -14,6 +14,8 @@ enum GenericRespMsgCode
       try again (e.g. msg forwarding to other server failed) */
    GenericRespMsgCode_NEWSEQNOBASE = 2, /* client has restarted its seq# sequence. server provides
       the new starting seq#. */
+   GenericRespMsgCode_READFROMPRIMARY = 3, /* buddy secondary can't serve a read-only request,
+      requestor shall send it to the primary. */
 };
 typedef enum GenericRespMsgCode GenericRespMsgCode;
 
@@ -5,7 +5,7 @@ const struct NetMessageOps OpenFileRespMsg_Ops = {
    .serializePayload    = _NetMessage_serializeDummy,
    .deserializePayload  = OpenFileRespMsg_deserializePayload,
    .processIncoming = NetMessage_processIncoming,
-   .getSupportedHeaderFeatureFlagsMask = NetMessage_getSupportedHeaderFeatureFlagsMask,
+   .getSupportedHeaderFeatureFlagsMask = OpenFileRespMsg_getSupportedHeaderFeatureFlagsMask,
 };
 
 bool OpenFileRespMsg_deserializePayload(NetMessage* this, DeserializeCtx* ctx)
@@ -35,3 +35,8 @@ bool OpenFileRespMsg_deserializePayload(NetMessage* this, DeserializeCtx* ctx)
 
    return true;
 }
+
+unsigned OpenFileRespMsg_getSupportedHeaderFeatureFlagsMask(NetMessage* this)
+{
+   return OPENFILERESPMSG_FLAG_INLINE_DATA;
+}
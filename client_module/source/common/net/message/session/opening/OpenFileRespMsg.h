@@ -7,6 +7,9 @@
 #include <common/Common.h>
 
 
+#define OPENFILERESPMSG_FLAG_INLINE_DATA     1 /* file data is in the inode, use Read/WriteInlineFile */
+
+
 struct OpenFileRespMsg;
 typedef struct OpenFileRespMsg OpenFileRespMsg;
 
@@ -14,6 +17,7 @@ static inline void OpenFileRespMsg_init(OpenFileRespMsg* this);
 
 // virtual functions
 extern bool OpenFileRespMsg_deserializePayload(NetMessage* this, DeserializeCtx* ctx);
+extern unsigned OpenFileRespMsg_getSupportedHeaderFeatureFlagsMask(NetMessage* this);
 
 // inliners
 static inline StripePattern* OpenFileRespMsg_createPattern(OpenFileRespMsg* this);
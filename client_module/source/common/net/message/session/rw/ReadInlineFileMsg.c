@@ -0,0 +1,17 @@
+#include "ReadInlineFileMsg.h"
+
+static void ReadInlineFileMsg_serializePayload(NetMessage* this, SerializeCtx* ctx)
+{
+   struct ReadInlineFileMsg* msg = container_of(this, struct ReadInlineFileMsg, netMessage);
+
+   Serialization_serializeInt64(ctx, msg->offset);
+   Serialization_serializeInt64(ctx, msg->count);
+   EntryInfo_serialize(ctx, msg->entryInfo);
+}
+
+const struct NetMessageOps ReadInlineFileMsg_Ops = {
+   .serializePayload = ReadInlineFileMsg_serializePayload,
+   .deserializePayload = _NetMessage_deserializeDummy,
+   .processIncoming = NetMessage_processIncoming,
+   .getSupportedHeaderFeatureFlagsMask = NetMessage_getSupportedHeaderFeatureFlagsMask,
+};
@@ -0,0 +1,36 @@
+#ifndef READINLINEFILEMSG_H_
+#define READINLINEFILEMSG_H_
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/EntryInfo.h>
+
+/**
+ * Read from a file whose data is stored in its metadata inode (see
+ * OPENFILERESPMSG_FLAG_INLINE_DATA) instead of its chunk files.
+ *
+ * Note: This message supports only serialization, deserialization is not implemented.
+ */
+struct ReadInlineFileMsg
+{
+   NetMessage netMessage;
+
+   const EntryInfo* entryInfo;
+   int64_t offset;
+   int64_t count;
+};
+extern const struct NetMessageOps ReadInlineFileMsg_Ops;
+
+/**
+ * @param entryInfo just a reference, so do not free it as long as you use this object!
+ */
+static inline void ReadInlineFileMsg_init(struct ReadInlineFileMsg* this,
+   const EntryInfo* entryInfo, int64_t offset, int64_t count)
+{
+   NetMessage_init(&this->netMessage, NETMSGTYPE_ReadInlineFile, &ReadInlineFileMsg_Ops);
+
+   this->entryInfo = entryInfo;
+   this->offset = offset;
+   this->count = count;
+}
+
+#endif /* READINLINEFILEMSG_H_ */
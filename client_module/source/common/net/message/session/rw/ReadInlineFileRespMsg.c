@@ -0,0 +1,22 @@
+#include "ReadInlineFileRespMsg.h"
+
+static bool ReadInlineFileRespMsg_deserializePayload(NetMessage* this, DeserializeCtx* ctx)
+{
+   struct ReadInlineFileRespMsg* msg = container_of(this, struct ReadInlineFileRespMsg, base);
+
+   int result;
+
+   if (!Serialization_deserializeInt(ctx, &result) ||
+         !Serialization_deserializeStrAlign4(ctx, &msg->dataLen, &msg->data) )
+      return false;
+
+   msg->result = result;
+   return true;
+}
+
+const struct NetMessageOps ReadInlineFileRespMsg_Ops = {
+   .serializePayload = _NetMessage_serializeDummy,
+   .deserializePayload = ReadInlineFileRespMsg_deserializePayload,
+   .processIncoming = NetMessage_processIncoming,
+   .getSupportedHeaderFeatureFlagsMask = NetMessage_getSupportedHeaderFeatureFlagsMask,
+};
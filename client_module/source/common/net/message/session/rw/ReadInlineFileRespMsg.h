@@ -0,0 +1,29 @@
+#ifndef READINLINEFILERESPMSG_H_
+#define READINLINEFILERESPMSG_H_
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/StorageErrors.h>
+
+typedef struct ReadInlineFileRespMsg ReadInlineFileRespMsg;
+
+/**
+ * Result FhgfsOpsErr_NOTSUPP means that the file data is not (or no longer) stored in the inode,
+ * so the chunk files have to be read instead.
+ */
+struct ReadInlineFileRespMsg
+{
+   NetMessage base;
+
+   FhgfsOpsErr result;
+
+   unsigned dataLen; // less than the requested number of bytes if the end of file was reached
+   const char* data; // points into the msg buffer
+};
+extern const struct NetMessageOps ReadInlineFileRespMsg_Ops;
+
+static inline void ReadInlineFileRespMsg_init(struct ReadInlineFileRespMsg* this)
+{
+   NetMessage_init(&this->base, NETMSGTYPE_ReadInlineFileResp, &ReadInlineFileRespMsg_Ops);
+}
+
+#endif /* READINLINEFILERESPMSG_H_ */
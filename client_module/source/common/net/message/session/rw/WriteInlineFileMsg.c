@@ -0,0 +1,17 @@
+#include "WriteInlineFileMsg.h"
+
+static void WriteInlineFileMsg_serializePayload(NetMessage* this, SerializeCtx* ctx)
+{
+   struct WriteInlineFileMsg* msg = container_of(this, struct WriteInlineFileMsg, netMessage);
+
+   Serialization_serializeInt64(ctx, msg->offset);
+   EntryInfo_serialize(ctx, msg->entryInfo);
+   Serialization_serializeStrAlign4(ctx, msg->dataLen, msg->data);
+}
+
+const struct NetMessageOps WriteInlineFileMsg_Ops = {
+   .serializePayload = WriteInlineFileMsg_serializePayload,
+   .deserializePayload = _NetMessage_deserializeDummy,
+   .processIncoming = NetMessage_processIncoming,
+   .getSupportedHeaderFeatureFlagsMask = NetMessage_getSupportedHeaderFeatureFlagsMask,
+};
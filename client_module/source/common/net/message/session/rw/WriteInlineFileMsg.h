@@ -0,0 +1,43 @@
+#ifndef WRITEINLINEFILEMSG_H_
+#define WRITEINLINEFILEMSG_H_
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/EntryInfo.h>
+
+/* meta servers never store more data in an inode (FILEINODE_INLINE_DATA_MAX_SIZE), so writes
+   beyond this always move the data to the chunk files */
+#define WRITEINLINEFILEMSG_MAX_FILE_SIZE  2048
+
+/**
+ * Write to a file whose data is stored in its metadata inode (see
+ * OPENFILERESPMSG_FLAG_INLINE_DATA) instead of its chunk files.
+ *
+ * Note: This message supports only serialization, deserialization is not implemented.
+ */
+struct WriteInlineFileMsg
+{
+   NetMessage netMessage;
+
+   const EntryInfo* entryInfo;
+   int64_t offset;
+   const char* data;
+   unsigned dataLen;
+};
+extern const struct NetMessageOps WriteInlineFileMsg_Ops;
+
+/**
+ * @param entryInfo just a reference, so do not free it as long as you use this object!
+ * @param data just a reference, so do not free it as long as you use this object!
+ */
+static inline void WriteInlineFileMsg_init(struct WriteInlineFileMsg* this,
+   const EntryInfo* entryInfo, int64_t offset, const char* data, unsigned dataLen)
+{
+   NetMessage_init(&this->netMessage, NETMSGTYPE_WriteInlineFile, &WriteInlineFileMsg_Ops);
+
+   this->entryInfo = entryInfo;
+   this->offset = offset;
+   this->data = data;
+   this->dataLen = dataLen;
+}
+
+#endif /* WRITEINLINEFILEMSG_H_ */
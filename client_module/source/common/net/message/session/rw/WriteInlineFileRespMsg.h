@@ -0,0 +1,37 @@
+#ifndef WRITEINLINEFILERESPMSG_H_
+#define WRITEINLINEFILERESPMSG_H_
+
+#include <common/net/message/SimpleIntMsg.h>
+
+
+struct WriteInlineFileRespMsg;
+typedef struct WriteInlineFileRespMsg WriteInlineFileRespMsg;
+
+static inline void WriteInlineFileRespMsg_init(WriteInlineFileRespMsg* this);
+
+// getters & setters
+static inline int WriteInlineFileRespMsg_getValue(WriteInlineFileRespMsg* this);
+
+/**
+ * Result FhgfsOpsErr_NOTSUPP means that the file data is not (or no longer) stored in the inode,
+ * e.g. because the write would have made it too large, so the chunk files have to be written
+ * instead.
+ */
+struct WriteInlineFileRespMsg
+{
+   SimpleIntMsg simpleIntMsg;
+};
+
+
+void WriteInlineFileRespMsg_init(WriteInlineFileRespMsg* this)
+{
+   SimpleIntMsg_init( (SimpleIntMsg*)this, NETMSGTYPE_WriteInlineFileResp);
+}
+
+int WriteInlineFileRespMsg_getValue(WriteInlineFileRespMsg* this)
+{
+   return SimpleIntMsg_getValue( (SimpleIntMsg*)this);
+}
+
+
+#endif /* WRITEINLINEFILERESPMSG_H_ */
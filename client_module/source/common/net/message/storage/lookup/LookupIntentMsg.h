@@ -19,6 +19,7 @@
 #define LOOKUPINTENTMSG_FLAG_CREATEEXCLUSIVE    4 /* exclusive file creation */
 #define LOOKUPINTENTMSG_FLAG_OPEN               8 /* open file */
 #define LOOKUPINTENTMSG_FLAG_STAT              16 /* stat file */
+#define LOOKUPINTENTMSG_FLAG_INLINE_DATA       32 /* client can access inline file data */
 
 
 // feature flags as header flags
@@ -49,6 +50,7 @@ static inline void LookupIntentMsg_addIntentCreateExclusive(LookupIntentMsg* thi
 static inline void LookupIntentMsg_addIntentOpen(LookupIntentMsg* this, NumNodeID clientNumID,
    unsigned accessFlags);
 static inline void LookupIntentMsg_addIntentStat(LookupIntentMsg* this);
+static inline void LookupIntentMsg_addIntentInlineData(LookupIntentMsg* this);
 
 
 struct LookupIntentMsg
@@ -163,6 +165,15 @@ void LookupIntentMsg_addIntentStat(LookupIntentMsg* this)
    this->intentFlags |= LOOKUPINTENTMSG_FLAG_STAT;
 }
 
+/**
+ * Let the server create and open files with inline data (see LOOKUPINTENTMSG_FLAG_INLINE_DATA);
+ * only useful together with the open intent.
+ */
+void LookupIntentMsg_addIntentInlineData(LookupIntentMsg* this)
+{
+   this->intentFlags |= LOOKUPINTENTMSG_FLAG_INLINE_DATA;
+}
+
 
 
 #endif /* LOOKUPINTENTMSG_H_ */
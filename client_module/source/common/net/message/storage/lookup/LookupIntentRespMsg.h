@@ -21,6 +21,7 @@
 #define LOOKUPINTENTRESPMSG_FLAG_CREATE             2 /* create file response */
 #define LOOKUPINTENTRESPMSG_FLAG_OPEN               4 /* open file response */
 #define LOOKUPINTENTRESPMSG_FLAG_STAT               8 /* stat file response */
+#define LOOKUPINTENTRESPMSG_FLAG_INLINE_DATA       16 /* opened file has inline data */
 
 
 struct LookupIntentRespMsg;
@@ -13,6 +13,7 @@ struct MirrorBuddyGroup* MirrorBuddyGroup_constructFromTargetIDs(uint16_t groupI
    this->firstTargetID = firstTargetID;
    this->secondTargetID = secondTargetID;
    this->sequence = 0;
+   this->highestSeqNoDone = 0;
 
    if (doneBufferSize == 0)
       goto fail;
@@ -225,3 +226,16 @@ void MirrorBuddyGroup_setSeqNoBase(MirrorBuddyGroup* this, uint64_t seqNoBase)
       this->sequence = seqNoBase;
    mutex_unlock(&this->mtx);
 }
+
+/**
+ * Record that the request with the given seq# was answered by the primary. The primary answers only
+ * after the secondary has processed the request, so the secondary may serve read-only requests of
+ * this client if it has processed all seq#s up to highestSeqNoDone.
+ */
+void MirrorBuddyGroup_setSeqNoDone(MirrorBuddyGroup* this, uint64_t seqNo)
+{
+   mutex_lock(&this->mtx);
+   if (this->highestSeqNoDone < seqNo)
+      this->highestSeqNoDone = seqNo;
+   mutex_unlock(&this->mtx);
+}
@@ -25,6 +25,7 @@ struct MirrorBuddyGroup
    uint16_t secondTargetID;
 
    uint64_t sequence;
+   uint64_t highestSeqNoDone; // highest seq# that got a response, see tuneReadMetaFromSecondary
 
    struct semaphore slotsAvail;
 
@@ -58,5 +59,6 @@ extern void MirrorBuddyGroup_releaseSequenceNumber(MirrorBuddyGroup* this,
    struct BuddySequenceNumber** handle);
 
 extern void MirrorBuddyGroup_setSeqNoBase(MirrorBuddyGroup* this, uint64_t seqNoBase);
+extern void MirrorBuddyGroup_setSeqNoDone(MirrorBuddyGroup* this, uint64_t seqNo);
 
 #endif /* MIRRORBUDDYGROUP_H */
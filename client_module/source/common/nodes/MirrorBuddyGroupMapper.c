@@ -92,6 +92,35 @@ uint16_t MirrorBuddyGroupMapper_getSecondaryTargetID(MirrorBuddyGroupMapper* thi
    return targetID;
 }
 
+/**
+ * Get the secondary of a group for a read-only request and the seq# watermark that the secondary
+ * must have reached to serve it (see MirrorBuddyGroup_setSeqNoDone).
+ *
+ * @return 0 if group not found
+ */
+uint16_t MirrorBuddyGroupMapper_getSecondaryForRead(MirrorBuddyGroupMapper* this,
+   uint16_t mirrorBuddyGroupID, uint64_t* outSeqNoDone)
+{
+   MirrorBuddyGroup* buddyGroup;
+   uint16_t targetID = 0;
+
+   RWLock_readLock(&this->rwlock); // L O C K
+
+   buddyGroup = _MirrorBuddyGroupMapper_find(this, mirrorBuddyGroupID);
+   if(likely(buddyGroup))
+   {
+      targetID = buddyGroup->secondTargetID;
+
+      mutex_lock(&buddyGroup->mtx);
+      *outSeqNoDone = buddyGroup->highestSeqNoDone;
+      mutex_unlock(&buddyGroup->mtx);
+   }
+
+   RWLock_readUnlock(&this->rwlock); // U N L O C K
+
+   return targetID;
+}
+
 int MirrorBuddyGroupMapper_acquireSequenceNumber(MirrorBuddyGroupMapper* this,
    uint16_t mirrorBuddyGroupID, uint64_t* seqNo, uint64_t* finishedSeqNo, bool* isSelective,
    struct BuddySequenceNumber** handle, struct MirrorBuddyGroup** group)
@@ -21,6 +21,8 @@ extern uint16_t MirrorBuddyGroupMapper_getPrimaryTargetID(MirrorBuddyGroupMapper
    uint16_t mirrorBuddyGroupID);
 extern uint16_t MirrorBuddyGroupMapper_getSecondaryTargetID(MirrorBuddyGroupMapper* this,
    uint16_t mirrorBuddyGroupID);
+extern uint16_t MirrorBuddyGroupMapper_getSecondaryForRead(MirrorBuddyGroupMapper* this,
+   uint16_t mirrorBuddyGroupID, uint64_t* outSeqNoDone);
 extern int MirrorBuddyGroupMapper_acquireSequenceNumber(MirrorBuddyGroupMapper* this,
    uint16_t mirrorBuddyGroupID, uint64_t* seqNo, uint64_t* finishedSeqNo, bool* isSelective,
    struct BuddySequenceNumber** handle, struct MirrorBuddyGroup** group);
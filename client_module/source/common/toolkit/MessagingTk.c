@@ -241,6 +241,8 @@ FhgfsOpsErr __MessagingTk_requestResponseNodeRetry(App* app, RequestResponseNode
    struct BuddySequenceNumber* handle = NULL;
    struct MirrorBuddyGroup* group = NULL;
    bool wasIndirectCommErr = false;
+   bool readFromSecondary = rrNode->peer.isMirrorGroup && rrNode->allowSecondaryRead &&
+      Config_getTuneReadMetaFromSecondary(App_getConfig(app) );
 
    BEEGFS_BUG_ON_DEBUG(rrNode->targetStates == NULL, "targetStates missing");
    BEEGFS_BUG_ON_DEBUG(rrNode->mirrorBuddies == NULL, "mirrorBuddies missing");
@@ -255,7 +257,11 @@ FhgfsOpsErr __MessagingTk_requestResponseNodeRetry(App* app, RequestResponseNode
 
       NumNodeID nodeID; // don't modify caller's nodeID
 
-      if (rrNode->peer.isMirrorGroup)
+      // read-only msg for a buddy mirror group => sets nodeID to the secondary on success
+      if (readFromSecondary)
+         readFromSecondary = __MessagingTk_prepareSecondaryRead(app, rrNode, rrArgs, &nodeID);
+
+      if (!readFromSecondary && rrNode->peer.isMirrorGroup)
       { // given targetID refers to a buddy mirror group
          nodeID = (NumNodeID){MirrorBuddyGroupMapper_getPrimaryTargetID(rrNode->mirrorBuddies,
                rrNode->peer.address.group)};
@@ -299,6 +305,7 @@ FhgfsOpsErr __MessagingTk_requestResponseNodeRetry(App* app, RequestResponseNode
          }
       }
       else
+      if (!readFromSecondary)
          nodeID = rrNode->peer.address.target;
 
       // check target state
@@ -400,6 +407,16 @@ FhgfsOpsErr __MessagingTk_requestResponseNodeRetry(App* app, RequestResponseNode
          goto release_node_and_break;
       }
       else
+      if (readFromSecondary)
+      { // secondary didn't serve the request => send it to the primary (doesn't count as retry)
+         readFromSecondary = false;
+
+         rrArgs->requestMsg->msgHeader.msgFlags &= ~MSGHDRFLAG_READ_FROM_SECONDARY;
+         rrArgs->requestMsg->msgHeader.msgSequenceDone = 0;
+
+         goto release_node_and_continue;
+      }
+      else
       if(!Node_getIsActive(rrArgs->node) )
       { // no retry allowed in this situation
          commRes = FhgfsOpsErr_UNKNOWNNODE;
@@ -484,11 +501,49 @@ FhgfsOpsErr __MessagingTk_requestResponseNodeRetry(App* app, RequestResponseNode
 
 exit:
    if (handle)
+   {
+      if (commRes == FhgfsOpsErr_SUCCESS)
+         MirrorBuddyGroup_setSeqNoDone(group, rrArgs->requestMsg->msgHeader.msgSequence);
+
       MirrorBuddyGroup_releaseSequenceNumber(group, &handle);
+   }
 
    return commRes;
 }
 
+/**
+ * Prepare a read-only request to a buddy mirror group for the secondary of the group, if the
+ * secondary is online and good: sets the READ_FROM_SECONDARY header flag and the seq# watermark
+ * that the secondary must have reached to serve the request (msgSequenceDone).
+ *
+ * Note: The secondary replies with GenericRespMsgCode_READFROMPRIMARY if it can't serve the
+ * request, so the caller must be prepared to resend the request to the primary.
+ *
+ * @param outNodeID set to the secondary if true is returned.
+ * @return false if the request should be sent to the primary.
+ */
+bool __MessagingTk_prepareSecondaryRead(App* app, RequestResponseNode* rrNode,
+   RequestResponseArgs* rrArgs, NumNodeID* outNodeID)
+{
+   uint64_t seqNoDone = 0;
+   CombinedTargetState state;
+   NumNodeID nodeID = (NumNodeID){MirrorBuddyGroupMapper_getSecondaryForRead(
+      rrNode->mirrorBuddies, rrNode->peer.address.group, &seqNoDone)};
+
+   if (NumNodeID_isZero(&nodeID) ||
+         !TargetStateStore_getState(rrNode->targetStates, nodeID.value, &state) ||
+         state.reachabilityState != TargetReachabilityState_ONLINE ||
+         state.consistencyState != TargetConsistencyState_GOOD)
+      return false;
+
+   rrArgs->requestMsg->msgHeader.msgFlags |= MSGHDRFLAG_READ_FROM_SECONDARY;
+   rrArgs->requestMsg->msgHeader.msgSequenceDone = seqNoDone;
+
+   *outNodeID = nodeID;
+
+   return true;
+}
+
 
 
 /**
@@ -807,6 +862,16 @@ FhgfsOpsErr __MessagingTk_handleGenericResponse(App* app, RequestResponseArgs* r
          break;
       }
 
+      case GenericRespMsgCode_READFROMPRIMARY:
+      {
+         LOG_DEBUG_FORMATTED(log, Log_DEBUG, logContext,
+            "Secondary can't serve read-only request: %s; Reason: %s; Message type: %hu",
+            nodeAndType.buf, GenericResponseMsg_getLogStr(genericResp),
+            NetMessage_getMsgType(rrArgs->requestMsg) );
+
+         retVal = FhgfsOpsErr_COMMUNICATION;
+      } break;
+
       default:
       {
          Logger_logFormatted(log, Log_NOTICE, logContext,
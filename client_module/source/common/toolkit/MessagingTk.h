@@ -41,6 +41,8 @@ extern FhgfsOpsErr __MessagingTk_handleGenericResponse(App* app, RequestResponse
 
 extern FhgfsOpsErr __MessagingTk_requestResponseNodeRetry(App* app,
    RequestResponseNode* rrNode, RequestResponseArgs* rrArgs);
+extern bool __MessagingTk_prepareSecondaryRead(App* app, RequestResponseNode* rrNode,
+   RequestResponseArgs* rrArgs, NumNodeID* outNodeID);
 
 // inliners
 
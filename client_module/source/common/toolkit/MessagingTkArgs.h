@@ -81,6 +81,9 @@ struct RequestResponseNode
    struct TargetStateStore* targetStates; /* if !NULL, check for state "good" or fail immediately if
                                           offline (other states handling depend on mirrorBuddies) */
    struct MirrorBuddyGroupMapper* mirrorBuddies; // if !NULL, the given targetID is a mirror groupID
+
+   bool allowSecondaryRead; /* read-only msg that may be sent to the secondary of a mirror group
+                               (if tuneReadMetaFromSecondary is set) */
 };
 
 enum MessagingTkBufType
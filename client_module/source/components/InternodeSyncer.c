@@ -954,6 +954,7 @@ void __InternodeSyncer_delayedClosePrepareRemoting(InternodeSyncer* this,
    outIOInfo->firstWriteDone = NULL;
    outIOInfo->userID = 0;
    outIOInfo->groupID = 0;
+   outIOInfo->fhgfsInode = NULL;
 #ifdef BEEGFS_NVFS
    outIOInfo->nvfs = false;
 #endif
@@ -977,6 +978,7 @@ void __InternodeSyncer_delayedEntryUnlockPrepareRemoting(InternodeSyncer* this,
    outIOInfo->firstWriteDone = NULL;
    outIOInfo->userID = 0;
    outIOInfo->groupID = 0;
+   outIOInfo->fhgfsInode = NULL;
 #ifdef BEEGFS_NVFS
    outIOInfo->nvfs = false;
 #endif
@@ -1000,6 +1002,7 @@ void __InternodeSyncer_delayedRangeUnlockPrepareRemoting(InternodeSyncer* this,
    outIOInfo->firstWriteDone = NULL;
    outIOInfo->userID = 0;
    outIOInfo->groupID = 0;
+   outIOInfo->fhgfsInode = NULL;
 #ifdef BEEGFS_NVFS
    outIOInfo->nvfs = false;
 #endif
@@ -172,6 +172,9 @@ FhgfsOpsErr FhgfsInode_referenceHandle(FhgfsInode* this, struct dentry* dentry,
          ioInfo.pattern       = lookupInfo->stripePattern;
          PathInfo_update(pathInfo, &lookupInfo->pathInfo);
 
+         FhgfsInode_setHasInlineData(this,
+            lookupInfo->responseFlags & LOOKUPINTENTRESPMSG_FLAG_INLINE_DATA);
+
          retVal = FhgfsOpsErr_SUCCESS;
       }
       else
@@ -473,6 +476,8 @@ void __FhgfsInode_initOpenIOInfo(FhgfsInode* this, FhgfsInodeFileHandle* fileHan
 
    outIOInfo->userID  = i_uid_read(&this->vfs_inode);
    outIOInfo->groupID = i_gid_read(&this->vfs_inode);
+
+   outIOInfo->fhgfsInode = this;
 }
 
 /**
@@ -42,6 +42,7 @@
                                                // if set switches to sync writes to faster notify
                                                // applications
 #define BEEGFS_INODE_FLAG_PAGED               2 // the inode was written to from page functions
+#define BEEGFS_INODE_FLAG_INLINE_DATA         4 // file data is stored in the meta inode
 
 struct StripePattern; // forward declaration
 
@@ -206,6 +207,8 @@ static inline int FhgfsInode_getNoIsizeDecrease(FhgfsInode* this);
 static inline void FhgfsInode_setPageWriteFlag(FhgfsInode* this);
 static inline void FhgfsInode_clearWritePageError(FhgfsInode* this);
 static inline int FhgfsInode_getHasPageWriteFlag(FhgfsInode* this);
+static inline void FhgfsInode_setHasInlineData(FhgfsInode* this, bool hasInlineData);
+static inline bool FhgfsInode_getHasInlineData(FhgfsInode* this);
 
 /**
  * Represents an open file handle on the mds.
@@ -756,4 +759,28 @@ int FhgfsInode_getHasWritePageError(FhgfsInode* this)
    return this->flags & BEEGFS_INODE_FLAG_WRITE_ERROR;
 }
 
+/**
+ * Set whether the file data is stored in the meta inode (as reported by the meta server on open).
+ */
+void FhgfsInode_setHasInlineData(FhgfsInode* this, bool hasInlineData)
+{
+   spin_lock(&this->vfs_inode.i_lock);
+
+   if (hasInlineData)
+      this->flags |= BEEGFS_INODE_FLAG_INLINE_DATA;
+   else
+      this->flags &= ~(BEEGFS_INODE_FLAG_INLINE_DATA);
+
+   spin_unlock(&this->vfs_inode.i_lock);
+}
+
+/**
+ * Note: Called without i_lock. A stale value only costs a round trip, because the meta server
+ *    rejects inline IO for files that were moved to the storage targets (FhgfsOpsErr_NOTSUPP).
+ */
+bool FhgfsInode_getHasInlineData(FhgfsInode* this)
+{
+   return this->flags & BEEGFS_INODE_FLAG_INLINE_DATA;
+}
+
 #endif /* FHGFSINODE_H_ */
@@ -64,6 +64,7 @@ const char* const PROCFSHELPER_CONFIGKEYS[] =
    "tuneUseBufferedAppend",
    "tuneStatFsCacheSecs",
    "tuneCoherentBuffers",
+   "tuneReadMetaFromSecondary",
    "sysACLsEnabled",
    "sysMgmtdHost",
    "sysInodeIDStyle",
@@ -145,6 +146,8 @@ int ProcFsHelper_readV2_config(struct seq_file* file, App* app)
    seq_printf(file, "tuneUseBufferedAppend = %d\n", (int)Config_getTuneUseBufferedAppend(cfg) );
    seq_printf(file, "tuneStatFsCacheSecs = %u\n", Config_getTuneStatFsCacheSecs(cfg) );
    seq_printf(file, "tuneCoherentBuffers = %u\n", Config_getTuneCoherentBuffers(cfg) );
+   seq_printf(file, "tuneReadMetaFromSecondary = %d\n",
+      (int)Config_getTuneReadMetaFromSecondary(cfg) );
    seq_printf(file, "sysACLsEnabled = %d\n", (int)Config_getSysACLsEnabled(cfg) );
    seq_printf(file, "sysMgmtdHost = %s\n", Config_getSysMgmtdHost(cfg) );
    seq_printf(file, "sysInodeIDStyle = %s\n",
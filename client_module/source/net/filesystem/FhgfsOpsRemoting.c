@@ -49,6 +49,10 @@
 #include <common/net/message/session/opening/OpenFileRespMsg.h>
 #include <common/net/message/session/opening/CloseFileMsg.h>
 #include <common/net/message/session/opening/CloseFileRespMsg.h>
+#include <common/net/message/session/rw/ReadInlineFileMsg.h>
+#include <common/net/message/session/rw/ReadInlineFileRespMsg.h>
+#include <common/net/message/session/rw/WriteInlineFileMsg.h>
+#include <common/net/message/session/rw/WriteInlineFileRespMsg.h>
 #include <common/storage/Path.h>
 #include <common/storage/StorageDefinitions.h>
 #include <common/storage/StorageErrors.h>
@@ -77,6 +81,12 @@ static bool __FhgfsOpsRemoting_writefileVerify(App* app, RemotingIOInfo* ioInfo,
    unsigned numStripeNodes);
 static inline int64_t __FhgfsOpsRemoting_getChunkOffset(int64_t pos, unsigned chunkSize,
    size_t numNodes, size_t stripeNodeIndex);
+static ssize_t __FhgfsOpsRemoting_readInline(RemotingIOInfo* ioInfo, loff_t offset,
+   size_t count, struct iov_iter* iter, FhgfsChunkPageVec* pageVec);
+static ssize_t __FhgfsOpsRemoting_writeInline(RemotingIOInfo* ioInfo, loff_t offset,
+   const char* data, size_t dataLen);
+static ssize_t __FhgfsOpsRemoting_rwChunkPageVecInline(FhgfsChunkPageVec* pageVec,
+   RemotingIOInfo* ioInfo, Fhgfs_RWType rwType);
 
 
 struct Fhgfs_RWTypeStrEntry
@@ -345,7 +355,8 @@ FhgfsOpsErr FhgfsOpsRemoting_statAndGetParentInfo(App* app, const EntryInfo* ent
       .peer = rrpeer_from_entryinfo(entryInfo),
       .nodeStore = app->metaNodes,
       .targetStates = app->metaStateStore,
-      .mirrorBuddies = app->metaBuddyGroupMapper
+      .mirrorBuddies = app->metaBuddyGroupMapper,
+      .allowSecondaryRead = true
    };
    RequestResponseArgs rrArgs;
    FhgfsOpsErr requestRes;
@@ -777,6 +788,11 @@ FhgfsOpsErr FhgfsOpsRemoting_openfile(const EntryInfo* entryInfo, RemotingIOInfo
    if(Config_getSysBypassFileAccessCheckOnMeta(cfg))
       NetMessage_addMsgHeaderFeatureFlag((NetMessage*)&requestMsg, OPENFILEMSG_FLAG_BYPASS_ACCESS_CHECK);
 
+   /* only opens through an inode can use the inline data msgs; all others (e.g. stateless IO)
+      make the server move inline data to the storage targets */
+   if(ioInfo->fhgfsInode)
+      NetMessage_addMsgHeaderFeatureFlag((NetMessage*)&requestMsg, OPENFILEMSG_FLAG_INLINE_DATA);
+
    RequestResponseArgs_prepare(&rrArgs, NULL, (NetMessage*)&requestMsg, NETMSGTYPE_OpenFileResp);
 
    // communicate
@@ -830,6 +846,10 @@ FhgfsOpsErr FhgfsOpsRemoting_openfile(const EntryInfo* entryInfo, RemotingIOInfo
 
       if (outVersion)
          *outVersion = openResp->fileVersion;
+
+      if(ioInfo->fhgfsInode)
+         FhgfsInode_setHasInlineData(ioInfo->fhgfsInode, NetMessage_isMsgHeaderFeatureFlagSet(
+            (NetMessage*)openResp, OPENFILERESPMSG_FLAG_INLINE_DATA) );
    }
    else
    { // error on server
@@ -1311,6 +1331,236 @@ static void writefile_nextIter(CommKitContext* context, FileOpState* state)
    state->data = vecState->data;
 }
 
+/**
+ * Read from a file whose data is stored in its meta inode (see FhgfsInode_getHasInlineData() ).
+ *
+ * Note: The data is copied either to iter or to the pages of pageVec (pages will not be ended
+ *    here).
+ *
+ * @return number of bytes read or negative fhgfs error code; -FhgfsOpsErr_NOTSUPP if the data is
+ *    (no longer) stored in the inode.
+ */
+static ssize_t __FhgfsOpsRemoting_readInline(RemotingIOInfo* ioInfo, loff_t offset,
+   size_t count, struct iov_iter* iter, FhgfsChunkPageVec* pageVec)
+{
+   App* app = ioInfo->app;
+   FhgfsInode* fhgfsInode = ioInfo->fhgfsInode;
+
+   struct ReadInlineFileMsg requestMsg;
+   RequestResponseNode rrNode = {
+      .nodeStore = app->metaNodes,
+      .targetStates = app->metaStateStore,
+      .mirrorBuddies = app->metaBuddyGroupMapper
+   };
+   RequestResponseArgs rrArgs;
+   FhgfsOpsErr requestRes;
+   ReadInlineFileRespMsg* readResp;
+   ssize_t retVal;
+
+   FhgfsInode_entryInfoReadLock(fhgfsInode); // LOCK EntryInfo
+
+   rrNode.peer = rrpeer_from_entryinfo(FhgfsInode_getEntryInfo(fhgfsInode) );
+
+   ReadInlineFileMsg_init(&requestMsg, FhgfsInode_getEntryInfo(fhgfsInode), offset,
+      MIN(count, (size_t)WRITEINLINEFILEMSG_MAX_FILE_SIZE) );
+
+   RequestResponseArgs_prepare(&rrArgs, NULL, &requestMsg.netMessage,
+      NETMSGTYPE_ReadInlineFileResp);
+
+   App_incNumRemoteReads(app);
+
+   // communicate
+   requestRes = MessagingTk_requestResponseNodeRetryAutoIntr(app, &rrNode, &rrArgs);
+
+   FhgfsInode_entryInfoReadUnlock(fhgfsInode); // UNLOCK EntryInfo
+
+   if(unlikely(requestRes != FhgfsOpsErr_SUCCESS) )
+      return -requestRes;
+
+   // handle result
+   readResp = (ReadInlineFileRespMsg*)rrArgs.outRespMsg;
+
+   if(readResp->result != FhgfsOpsErr_SUCCESS)
+      retVal = -readResp->result;
+   else
+   if(unlikely(readResp->dataLen > count) )
+      retVal = -FhgfsOpsErr_INTERNAL;
+   else
+   if(iter)
+   { // copy to user buffer
+      if(copy_to_iter(readResp->data, readResp->dataLen, iter) == readResp->dataLen)
+         retVal = readResp->dataLen;
+      else
+         retVal = -FhgfsOpsErr_ADDRESSFAULT;
+   }
+   else
+   { // copy to pages (already kmapped)
+      size_t remaining = readResp->dataLen;
+      const char* data = readResp->data;
+
+      FhgfsChunkPageVec_resetIterator(pageVec);
+
+      while(remaining)
+      {
+         FhgfsPage* fhgfsPage = FhgfsChunkPageVec_iterateGetNextPage(pageVec);
+         size_t pageDataLen = MIN(remaining, (size_t)PAGE_SIZE);
+
+         memcpy(fhgfsPage->data, data, pageDataLen);
+
+         data += pageDataLen;
+         remaining -= pageDataLen;
+      }
+
+      FhgfsChunkPageVec_resetIterator(pageVec);
+
+      retVal = readResp->dataLen;
+   }
+
+   // clean-up
+   RequestResponseArgs_freeRespBuffers(&rrArgs, app);
+
+   return retVal;
+}
+
+/**
+ * Write to a file whose data is stored in its meta inode (see FhgfsInode_getHasInlineData() ).
+ *
+ * Note: The server writes either all or nothing; if the file would become too large for the
+ *    inode, it moves the data to the storage targets and returns FhgfsOpsErr_NOTSUPP.
+ *
+ * @return dataLen or negative fhgfs error code; -FhgfsOpsErr_NOTSUPP if the data is (no longer)
+ *    stored in the inode, so that it has to be written to the storage targets.
+ */
+static ssize_t __FhgfsOpsRemoting_writeInline(RemotingIOInfo* ioInfo, loff_t offset,
+   const char* data, size_t dataLen)
+{
+   App* app = ioInfo->app;
+   FhgfsInode* fhgfsInode = ioInfo->fhgfsInode;
+
+   struct WriteInlineFileMsg requestMsg;
+   RequestResponseNode rrNode = {
+      .nodeStore = app->metaNodes,
+      .targetStates = app->metaStateStore,
+      .mirrorBuddies = app->metaBuddyGroupMapper
+   };
+   RequestResponseArgs rrArgs;
+   FhgfsOpsErr requestRes;
+   FhgfsOpsErr writeRes;
+
+   FhgfsInode_entryInfoReadLock(fhgfsInode); // LOCK EntryInfo
+
+   rrNode.peer = rrpeer_from_entryinfo(FhgfsInode_getEntryInfo(fhgfsInode) );
+
+   WriteInlineFileMsg_init(&requestMsg, FhgfsInode_getEntryInfo(fhgfsInode), offset, data,
+      dataLen);
+   NetMessage_setMsgHeaderUserID(&requestMsg.netMessage, ioInfo->userID);
+
+   RequestResponseArgs_prepare(&rrArgs, NULL, &requestMsg.netMessage,
+      NETMSGTYPE_WriteInlineFileResp);
+
+   App_incNumRemoteWrites(app);
+
+   // communicate
+   requestRes = MessagingTk_requestResponseNodeRetryAutoIntr(app, &rrNode, &rrArgs);
+
+   FhgfsInode_entryInfoReadUnlock(fhgfsInode); // UNLOCK EntryInfo
+
+   if(unlikely(requestRes != FhgfsOpsErr_SUCCESS) )
+      return -requestRes;
+
+   // handle result
+   writeRes = (FhgfsOpsErr)WriteInlineFileRespMsg_getValue(
+      (WriteInlineFileRespMsg*)rrArgs.outRespMsg);
+
+   // clean-up
+   RequestResponseArgs_freeRespBuffers(&rrArgs, app);
+
+   return (writeRes == FhgfsOpsErr_SUCCESS) ? (ssize_t)dataLen : -writeRes;
+}
+
+/**
+ * Inline data version of FhgfsOpsRemoting_rwChunkPageVec(): pages are ended here on success and
+ * on errors other than -FhgfsOpsErr_NOTSUPP.
+ *
+ * Note: A write of more than the first page always gets -FhgfsOpsErr_NOTSUPP, as pages before the
+ *    last one are full and PAGE_SIZE is larger than the inline data limit.
+ *
+ * @return number of bytes read/written or negative fhgfs error code; -FhgfsOpsErr_NOTSUPP if the
+ *    data is (no longer) stored in the inode (pages untouched in this case).
+ */
+static ssize_t __FhgfsOpsRemoting_rwChunkPageVecInline(FhgfsChunkPageVec* pageVec,
+   RemotingIOInfo* ioInfo, Fhgfs_RWType rwType)
+{
+   Logger* log = App_getLogger(ioInfo->app);
+   struct inode* inode = FhgfsChunkPageVec_getInode(pageVec);
+   loff_t offset = FhgfsChunkPageVec_getFirstPageFileOffset(pageVec);
+   ssize_t retVal;
+
+   FhgfsChunkPageVec_resetIterator(pageVec);
+
+   if(rwType == BEEGFS_RWTYPE_WRITE)
+   {
+      FhgfsPage* fhgfsPage = FhgfsChunkPageVec_iterateGetNextPage(pageVec);
+
+      retVal = __FhgfsOpsRemoting_writeInline(ioInfo, offset, fhgfsPage->data,
+         fhgfsPage->length);
+
+      FhgfsChunkPageVec_resetIterator(pageVec);
+
+      if(retVal == -FhgfsOpsErr_NOTSUPP)
+         return retVal;
+
+      if(retVal > 0)
+      { // only the first page was sent, so there is only one
+         FhgfsOpsPages_endWritePage(fhgfsPage->page, retVal, inode);
+         return retVal;
+      }
+
+      spin_lock(&inode->i_lock);
+      FhgfsInode_setWritePageError(BEEGFS_INODE(inode) );
+      spin_unlock(&inode->i_lock);
+
+      FhgfsChunkPageVec_iterateAllHandleWritePages(pageVec,
+         (retVal == -FhgfsOpsErr_COMMUNICATION) ? -EAGAIN : FhgfsOpsErr_toSysErr(-retVal) );
+
+      return retVal;
+   }
+
+   retVal = __FhgfsOpsRemoting_readInline(ioInfo, offset,
+      FhgfsChunkPageVec_getDataSize(pageVec), NULL, pageVec);
+
+   if(retVal == -FhgfsOpsErr_NOTSUPP)
+      return retVal;
+
+   if(retVal < 0)
+   {
+      FhgfsChunkPageVec_iterateAllHandleReadErr(pageVec);
+      return retVal;
+   }
+
+   { // end all pages (the ones after the end of the file are zeroed)
+      ssize_t remaining = retVal;
+
+      while(1)
+      {
+         FhgfsPage* fhgfsPage = FhgfsChunkPageVec_iterateGetNextPage(pageVec);
+         int pageReadRes = MIN(remaining, (ssize_t)PAGE_SIZE);
+
+         if(!fhgfsPage)
+            break;
+
+         if(!pageReadRes)
+            FhgfsPage_zeroPage(fhgfsPage);
+
+         FhgfsOpsPages_endReadPage(log, inode, fhgfsPage, pageReadRes);
+
+         remaining -= pageReadRes;
+      }
+   }
+
+   return retVal;
+}
+
 /**
  * Single-threaded parallel file write.
  * Works for mirrored and unmirrored files. In case of a mirrored file, the mirror data will be
@@ -1338,6 +1588,37 @@ ssize_t FhgfsOpsRemoting_writefileVec(struct iov_iter* iter, loff_t offset,
 
    __FhgfsOpsRemoting_logDebugIOCall(__func__, iov_iter_count(iter), offset, ioInfo, NULL);
 
+   if(ioInfo->fhgfsInode && FhgfsInode_getHasInlineData(ioInfo->fhgfsInode) )
+   {
+      size_t dataLen = MIN(iov_iter_count(iter), (size_t)WRITEINLINEFILEMSG_MAX_FILE_SIZE + 1);
+      struct iov_iter dataIter = *iter;
+      char* data = kmalloc(dataLen, GFP_NOFS);
+      ssize_t writeRes;
+
+      if(!data)
+         return -FhgfsOpsErr_OUTOFMEM;
+
+      /* note: if there is more data than this, the server can't store it inline and moves the
+         file data to the storage targets */
+      if(copy_from_iter(data, dataLen, &dataIter) != dataLen)
+         writeRes = -FhgfsOpsErr_ADDRESSFAULT;
+      else
+         writeRes = __FhgfsOpsRemoting_writeInline(ioInfo, offset, data, dataLen);
+
+      kfree(data);
+
+      if(writeRes != -FhgfsOpsErr_NOTSUPP)
+      {
+         if(writeRes > 0)
+            iov_iter_advance(iter, writeRes);
+
+         return writeRes;
+      }
+
+      // data is on the storage targets now => continue with chunk file IO
+      FhgfsInode_setHasInlineData(ioInfo->fhgfsInode, false);
+   }
+
 #ifdef BEEGFS_NVFS
    ioInfo->nvfs = RdmaInfo_acquireNVFS();
 #endif
@@ -1478,6 +1759,16 @@ ssize_t FhgfsOpsRemoting_rwChunkPageVec(FhgfsChunkPageVec *pageVec, RemotingIOIn
    char* msgBuf;
    FhgfsCommKitVec state;
 
+   if(ioInfo->fhgfsInode && FhgfsInode_getHasInlineData(ioInfo->fhgfsInode) )
+   {
+      retVal = __FhgfsOpsRemoting_rwChunkPageVecInline(pageVec, ioInfo, rwType);
+      if(retVal != -FhgfsOpsErr_NOTSUPP)
+         return retVal;
+
+      // data is on the storage targets now => continue with chunk file IO
+      FhgfsInode_setHasInlineData(ioInfo->fhgfsInode, false);
+   }
+
    // sanity check
    if (numPages > chunkPages)
    {
@@ -1594,6 +1885,16 @@ ssize_t FhgfsOpsRemoting_readfileVec(struct iov_iter* iter, size_t toBeRead, lof
 
    __FhgfsOpsRemoting_logDebugIOCall(__func__, iov_iter_count(iter), offset, ioInfo, NULL);
 
+   if(ioInfo->fhgfsInode && FhgfsInode_getHasInlineData(ioInfo->fhgfsInode) )
+   {
+      ssize_t readRes = __FhgfsOpsRemoting_readInline(ioInfo, offset, toBeRead, iter, NULL);
+      if(readRes != -FhgfsOpsErr_NOTSUPP)
+         return readRes;
+
+      // data is on the storage targets now => continue with chunk file IO
+      FhgfsInode_setHasInlineData(ioInfo->fhgfsInode, false);
+   }
+
 #ifdef BEEGFS_NVFS
    ioInfo->nvfs = RdmaInfo_acquireNVFS();
 #endif
@@ -2192,7 +2493,8 @@ extern FhgfsOpsErr FhgfsOpsRemoting_getXAttr(App* app, const EntryInfo* entryInf
       .peer = rrpeer_from_entryinfo(entryInfo),
       .nodeStore = app->metaNodes,
       .targetStates = app->metaStateStore,
-      .mirrorBuddies = app->metaBuddyGroupMapper
+      .mirrorBuddies = app->metaBuddyGroupMapper,
+      .allowSecondaryRead = true
    };
    RequestResponseArgs rrArgs;
 
@@ -2309,11 +2611,17 @@ FhgfsOpsErr FhgfsOpsRemoting_lookupIntent(App* app,
    {
       const NumNodeID localNodeNumID = Node_getNumID(App_getLocalNode(app) );
       LookupIntentMsg_addIntentOpen(&requestMsg, localNodeNumID, openInfo->accessFlags);
+
+      // the result is always used for an inode (see FhgfsInode_referenceHandle() )
+      LookupIntentMsg_addIntentInlineData(&requestMsg);
    }
 
    if(Config_getQuotaEnabled(cfg) )
       NetMessage_addMsgHeaderFeatureFlag((NetMessage*)&requestMsg, LOOKUPINTENTMSG_FLAG_USE_QUOTA);
 
+   // plain lookups and revalidations don't modify anything on the server
+   rrNode.allowSecondaryRead = !createInfo && !openInfo;
+
    RequestResponseArgs_prepare(&rrArgs, NULL, (NetMessage*)&requestMsg,
       NETMSGTYPE_LookupIntentResp);
 
@@ -11,6 +11,8 @@
 struct RemotingIOInfo;
 typedef struct RemotingIOInfo RemotingIOInfo;
 
+struct FhgfsInode; // forward declaration
+
 
 
 // inliners
@@ -41,6 +43,8 @@ struct RemotingIOInfo
 
       unsigned userID;     // only used in storage server write message
       unsigned groupID;    // only used in storage server write message
+
+      struct FhgfsInode* fhgfsInode; // for inline file data IO (can be NULL)
 #ifdef BEEGFS_NVFS
       bool nvfs;
 #endif
@@ -75,6 +79,8 @@ void RemotingIOInfo_initOpen(App* app, unsigned accessFlags, AtomicInt* maxUsedT
 
    outIOInfo->userID = 0;
    outIOInfo->groupID = 0;
+
+   outIOInfo->fhgfsInode = NULL;
 #ifdef BEEGFS_NVFS
    outIOInfo->nvfs = false;
 #endif
@@ -101,6 +107,8 @@ void RemotingIOInfo_initSpecialClose(App* app, const char* fileHandleID,
 
    outIOInfo->userID = 0;
    outIOInfo->groupID = 0;
+
+   outIOInfo->fhgfsInode = NULL;
 #ifdef BEEGFS_NVFS
    outIOInfo->nvfs = false;
 #endif
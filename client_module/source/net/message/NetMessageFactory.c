@@ -35,6 +35,8 @@
 #include <common/net/message/session/opening/OpenFileRespMsg.h>
 #include <common/net/message/session/opening/CloseFileRespMsg.h>
 #include <common/net/message/session/rw/WriteLocalFileRespMsg.h>
+#include <common/net/message/session/rw/ReadInlineFileRespMsg.h>
+#include <common/net/message/session/rw/WriteInlineFileRespMsg.h>
 #ifdef BEEGFS_NVFS
 #include <common/net/message/session/rw/WriteLocalFileRDMARespMsg.h>
 #endif
@@ -197,6 +199,8 @@ NetMessage* NetMessageFactory_createFromMsgType(unsigned short msgType)
 #ifdef BEEGFS_NVFS
       HANDLE(WriteLocalFileRDMAResp, WriteLocalFileRDMARespMsg);
 #endif
+      HANDLE(ReadInlineFileResp, ReadInlineFileRespMsg);
+      HANDLE(WriteInlineFileResp, WriteInlineFileRespMsg);
       HANDLE(FSyncLocalFileResp, FSyncLocalFileRespMsg);
       HANDLE(FLockAppendResp, FLockAppendRespMsg);
       HANDLE(FLockEntryResp, FLockEntryRespMsg);
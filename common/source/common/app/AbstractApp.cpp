@@ -1,3 +1,4 @@
+#include <common/net/sock/Socket.h>
 #include <common/toolkit/StorageTk.h>
 #include <common/toolkit/NodesTk.h>
 #include "AbstractApp.h"
@@ -43,6 +44,16 @@ void AbstractApp::updateLockedPIDFile(LockFD& pidFileFD)
 }
 
 
+/**
+ * Select the stream listener for a newly accepted connection. To be overridden by Apps that place
+ * connections by other criteria than the fd number; getStreamListenerByFD() must return the same
+ * listener for the connection afterwards.
+ */
+StreamListenerV2* AbstractApp::getStreamListenerForNewConn(Socket* sock)
+{
+   return getStreamListenerByFD(sock->getFD() );
+}
+
 /**
  * @param component the thread that we're waiting for via join(); may be NULL (in which case this
  * method returns immediately)
@@ -15,6 +15,7 @@
 #include <mutex>
 
 class StreamListenerV2; // forward declaration
+class Socket;
 class LogContext;
 class AbstractNodeStore;
 
@@ -51,6 +52,8 @@ class AbstractApp : public PThread
          return NULL;
       }
 
+      virtual StreamListenerV2* getStreamListenerForNewConn(Socket* sock);
+
       NicAddressList getLocalNicList()
       {
          const std::lock_guard<Mutex> lock(localNicListMutex);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <common/Common.h>
+#include <common/toolkit/LatencyHistogram.h>
+#include <common/toolkit/serialization/Serialization.h>
 
 
 // defines storage benchmark errors...
@@ -14,6 +16,8 @@
 #define STORAGEBENCH_ERROR_INIT_READ_DATA             11
 #define STORAGEBENCH_ERROR_INIT_CREATE_BENCH_FOLDER   12
 #define STORAGEBENCH_ERROR_INIT_TRANSFER_DATA         13
+#define STORAGEBENCH_ERROR_INIT_IO_ENGINE             14
+#define STORAGEBENCH_ERROR_INIT_INVALID_OPTIONS       15
 
 #define STORAGEBENCH_ERROR_RUNTIME_ERROR              20
 #define STORAGEBENCH_ERROR_RUNTIME_DELETE_FOLDER      21
@@ -23,12 +27,16 @@
 #define STORAGEBENCH_ERROR_RUNTIME_CLEANUP_JOB_ACTIVE 25
 
 
-// map for throughput results; key: targetID, value: throughput in kb/s
+// map for throughput results; key: targetID, value: throughput in kb/s (ops/s for
+// StorageBenchType_CHUNKMETA)
 typedef std::map<uint16_t, int64_t> StorageBenchResultsMap;
 typedef StorageBenchResultsMap::iterator StorageBenchResultsMapIter;
 typedef StorageBenchResultsMap::const_iterator StorageBenchResultsMapCIter;
 typedef StorageBenchResultsMap::value_type StorageBenchResultsMapVal;
 
+// map for latency results; key: targetID, value: latencies of all ops on the target
+typedef std::map<uint16_t, LatencyHistogramData> StorageBenchLatencyMap;
+
 
 /*
  * enum for the action parameter of the storage benchmark
@@ -44,12 +52,51 @@ enum StorageBenchAction
 
 /*
  * enum for the different benchmark types
+ * note: READ/WRITE are sequential; the RAND types use blocksize-aligned random offsets within the
+ *    benchmark file of each thread; CHUNKMETA creates, stats and unlinks <size> chunk files per
+ *    thread (in this order) and ignores the blocksize.
  */
 enum StorageBenchType
 {
    StorageBenchType_READ = 0,
    StorageBenchType_WRITE = 1,
-   StorageBenchType_NONE = 2
+   StorageBenchType_NONE = 2,
+   StorageBenchType_RANDREAD = 3,
+   StorageBenchType_RANDWRITE = 4,
+   StorageBenchType_RANDMIXED = 5, // reads and writes, see StorageBenchOptions::readPercent
+   StorageBenchType_CHUNKMETA = 6
+};
+
+#define STORAGEBENCHTYPE_IS_RANDOM(type) ( (type == StorageBenchType_RANDREAD) || \
+   (type == StorageBenchType_RANDWRITE) || (type == StorageBenchType_RANDMIXED) )
+
+/*
+ * enum for the way the benchmark submits I/O operations
+ */
+enum StorageBenchIOEngine
+{
+   StorageBenchIOEngine_SYNC = 0, // one blocking read/write at a time per thread
+   StorageBenchIOEngine_IOURING = 1 // up to ioDepth ops in flight per thread
+};
+
+/*
+ * optional parameters of a benchmark (older clients don't send them, so the defaults must match
+ * the behavior of the plain sequential read/write benchmark)
+ */
+struct StorageBenchOptions
+{
+   uint32_t readPercent = 50; // share of reads for StorageBenchType_RANDMIXED
+   int32_t ioEngine = StorageBenchIOEngine_SYNC; // StorageBenchIOEngine
+   uint32_t ioDepth = 1; // ops in flight per thread for StorageBenchIOEngine_IOURING
+
+   template<typename This, typename Ctx>
+   static void serialize(This obj, Ctx& ctx)
+   {
+      ctx
+         % obj->readPercent
+         % obj->ioEngine
+         % obj->ioDepth;
+   }
 };
 
 /*
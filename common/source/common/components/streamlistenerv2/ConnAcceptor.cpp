@@ -268,7 +268,7 @@ void ConnAcceptor::onIncomingStandardConnection(StandardSocket* sock)
 
       // hand the socket over to a stream listener
 
-      StreamListenerV2* listener = app->getStreamListenerByFD(acceptedSock->getFD() );
+      StreamListenerV2* listener = app->getStreamListenerForNewConn(acceptedSock);
       StreamListenerV2::SockReturnPipeInfo returnInfo(
          StreamListenerV2::SockPipeReturn_NEWCONN, acceptedSock);
 
@@ -326,7 +326,7 @@ void ConnAcceptor::onIncomingRDMAConnection(RDMASocket* sock)
 
          // hand the socket over to a stream listener
 
-         StreamListenerV2* listener = app->getStreamListenerByFD(acceptedSock->getFD() );
+         StreamListenerV2* listener = app->getStreamListenerForNewConn(acceptedSock);
          StreamListenerV2::SockReturnPipeInfo returnInfo(
             StreamListenerV2::SockPipeReturn_NEWCONN, acceptedSock);
 
@@ -1,6 +1,8 @@
 #include <common/app/log/LogContext.h>
 #include <common/app/AbstractApp.h>
 #include <common/components/streamlistenerv2/StreamListenerV2.h>
+#include <common/components/worker/WorkerLatencyStats.h>
+#include <common/net/sock/StandardSocket.h>
 #include <common/threading/PThread.h>
 #include <common/net/message/NetMessage.h>
 #include "IncomingPreprocessedMsgWork.h"
@@ -8,6 +10,31 @@
 
 void IncomingPreprocessedMsgWork::process(char* bufIn, unsigned bufInLen,
    char* bufOut, unsigned bufOutLen)
+{
+   unsigned numFollowUpMsgs = 0;
+
+   while(processMsg(bufIn, bufInLen, bufOut, bufOutLen) )
+   { // msg done and sock still ours => continue directly if the next msg is already pending
+      if(!recvPendingMsgHeader(numFollowUpMsgs) )
+      {
+         releaseSocket(app, &sock, NULL);
+         return;
+      }
+
+      numFollowUpMsgs++;
+      stats.incVals.workRequests++; // (worker only counts the first msg of this work)
+   }
+}
+
+/**
+ * Receive and process a single msg (header was already received by the stream listener or by
+ * recvPendingMsgHeader() ).
+ *
+ * @return true if the msg was processed successfully and the sock still needs to be released by
+ *    the caller; false if the sock was already released or invalidated.
+ */
+bool IncomingPreprocessedMsgWork::processMsg(char* bufIn, unsigned bufInLen,
+   char* bufOut, unsigned bufOutLen)
 {
    const char* logContextStr = "Work (process incoming msg)";
 
@@ -39,7 +66,7 @@ void IncomingPreprocessedMsgWork::process(char* bufIn, unsigned bufInLen,
          sock->unsetStats();
          invalidateConnection(sock);
 
-         return;
+         return false;
       }
 
       // receive the message payload
@@ -62,7 +89,7 @@ void IncomingPreprocessedMsgWork::process(char* bufIn, unsigned bufInLen,
 
          sock->unsetStats();
          invalidateConnection(sock);
-         return;
+         return false;
       }
 
       // process the received msg
@@ -76,7 +103,15 @@ void IncomingPreprocessedMsgWork::process(char* bufIn, unsigned bufInLen,
          NetMessage::ResponseContext rctx(NULL, sock, bufOut, bufOutLen, &stats);
          LOG_DBG(COMMUNICATION, DEBUG, "Beginning message processing.", sock->getPeername(),
                msg->getMsgTypeStr());
+
+         WorkerLatencyStats* latencyStats = WorkerLatencyStats::getCurrent();
+         TimeFine processStartTime;
+
          processRes = msg->processIncoming(rctx);
+
+         if(latencyStats)
+            latencyStats->recordMsgProcessing(msgHeader.msgType,
+               TimeFine().elapsedSinceMicro(&processStartTime) );
       }
       else
          LogContext(logContextStr).log(Log_NOTICE,
@@ -89,7 +124,7 @@ void IncomingPreprocessedMsgWork::process(char* bufIn, unsigned bufInLen,
       msg.reset();
 
       if(!needSockRelease)
-         return; // sock release was already done within msg->processIncoming() method
+         return false; // sock release was already done within msg->processIncoming() method
 
       if(unlikely(!processRes) )
       { // processIncoming encountered messaging error => invalidate connection
@@ -99,12 +134,10 @@ void IncomingPreprocessedMsgWork::process(char* bufIn, unsigned bufInLen,
 
          invalidateConnection(sock);
 
-         return;
+         return false;
       }
 
-      releaseSocket(app, &sock, NULL);
-
-      return;
+      return true;
 
    }
    catch(SocketTimeoutException& e)
@@ -131,6 +164,68 @@ void IncomingPreprocessedMsgWork::process(char* bufIn, unsigned bufInLen,
       sock->unsetStats();
       invalidateConnection(sock);
    }
+
+   return false;
+}
+
+/**
+ * Run-to-completion for back-to-back msgs: If the header of the next msg from the same peer is
+ * already buffered in the sock, receive it into msgHeader so that the caller can process the msg
+ * directly. This saves the sockReturnPipe write/read, the epoll re-arm and the handover to another
+ * thread, which the stream listener path would cost for each msg.
+ *
+ * Only done for msgs that the stream listener would have put into the same queue (same target and
+ * user) and at most StreamListenerV2::getMaxRunToCompletionMsgs() times per work, so that a busy
+ * connection cannot monopolize a worker.
+ *
+ * @param numFollowUpMsgs number of msgs that this work already processed after the first one.
+ * @return true if the next msg header was received; false if the sock should be returned to the
+ *    stream listener (and the pending data was not touched).
+ */
+bool IncomingPreprocessedMsgWork::recvPendingMsgHeader(unsigned numFollowUpMsgs)
+{
+   // (RDMA socks have their own immediate data notification in releaseSocket() )
+   if(sock->getSockType() != NICADDRTYPE_STANDARD)
+      return false;
+
+   StreamListenerV2* listener = app->getStreamListenerByFD(sock->getFD() );
+   if(numFollowUpMsgs >= listener->getMaxRunToCompletionMsgs() )
+      return false;
+
+   StandardSocket* standardSock = (StandardSocket*)sock;
+   char msgHeaderBuf[NETMSG_HEADER_LENGTH];
+   NetMessageHeader nextMsgHeader;
+
+   try
+   {
+      ssize_t peekRes = standardSock->recvPeekNonblocking(msgHeaderBuf, NETMSG_HEADER_LENGTH);
+      if(peekRes < NETMSG_HEADER_LENGTH)
+         return false; // no (complete) header pending
+
+      NetMessage::deserializeHeader(msgHeaderBuf, NETMSG_HEADER_LENGTH, &nextMsgHeader);
+
+      if( (nextMsgHeader.msgTargetID != msgHeader.msgTargetID) ||
+          (nextMsgHeader.msgUserID != msgHeader.msgUserID) )
+         return false; // would go to a different (per-target or per-user) queue
+
+      // header is completely buffered => won't block (stats are added by processMsg() )
+      sock->unsetStats();
+      sock->recvExact(msgHeaderBuf, NETMSG_HEADER_LENGTH, 0);
+   }
+   catch(SocketException& e)
+   { // leave error handling to the stream listener (it will see the sock as readable)
+      return false;
+   }
+
+   msgHeader = nextMsgHeader;
+
+   sock->setHasActivity();
+
+   LOG_DEBUG("IncomingPreprocessedMsgWork::recvPendingMsgHeader", Log_DEBUG,
+      "Incoming message (run-to-completion): " + netMessageTypeToStr(msgHeader.msgType) + "; "
+      "from: " + sock->getPeername() );
+
+   return true;
 }
 
 /**
@@ -34,5 +34,8 @@ class IncomingPreprocessedMsgWork : public Work
       AbstractApp* app;
       Socket* sock;
       NetMessageHeader msgHeader;
+
+      bool processMsg(char* bufIn, unsigned bufInLen, char* bufOut, unsigned bufOutLen);
+      bool recvPendingMsgHeader(unsigned numFollowUpMsgs);
 };
 
@@ -12,6 +12,7 @@
                                      client-side idle disconnect interval to avoid cases where
                                      server disconnects first) */
 #define SOCKRETURN_SOCKS_NUM         (32)
+#define IOURING_ENTRIES_NUM          (512) /* sq ring size, max number of re-arms per syscall */
 
 
 StreamListenerV2::StreamListenerV2(const std::string& listenerID, AbstractApp* app,
@@ -21,7 +22,9 @@ StreamListenerV2::StreamListenerV2(const std::string& listenerID, AbstractApp* a
       log("StreamLisV2"),
       workQueue(workQueue),
       rdmaCheckForceCounter(0),
-      useAggressivePoll(false)
+      useAggressivePoll(false),
+      maxRunToCompletionMsgs(0),
+      useIoUring(false)
 {
    int epollCreateSize = 10; // size "10" is just a hint (and is actually ignored since Linux 2.6.8)
    this->epollFD = epoll_create(epollCreateSize);
@@ -62,13 +65,39 @@ bool StreamListenerV2::initSockReturnPipe()
    return true;
 }
 
+/**
+ * Note: The sockReturnPipe stays in the epoll set, so we can still fall back to epoll if this
+ * fails.
+ *
+ * @return false if io_uring is not available (e.g. old kernel or disabled by seccomp).
+ */
+bool StreamListenerV2::initIoUring()
+{
+   ioUringPoll.reset(new IoUringPoll() );
+
+   if(ioUringPoll->init(IOURING_ENTRIES_NUM) &&
+      ioUringPoll->armPoll(sockReturnPipe->getReadFD()->getFD(),
+         sockReturnPipe->getReadFD()->getFD() ) )
+      return true;
+
+   log.log(Log_WARNING, "Unable to use io_uring, falling back to epoll. "
+      "SysErr: " + System::getErrString() );
+
+   ioUringPoll.reset();
+
+   return false;
+}
+
 void StreamListenerV2::run()
 {
    try
    {
       registerSignalHandler();
 
-      listenLoop();
+      if(useIoUring && initIoUring() )
+         listenLoopIoUring();
+      else
+         listenLoop();
 
       log.log(Log_DEBUG, "Component stopped.");
    }
@@ -138,6 +167,127 @@ void StreamListenerV2::listenLoop()
 }
 
 
+/**
+ * Like listenLoop(), but with one-shot io_uring poll requests instead of epoll: re-arming a sock
+ * only queues a request in the submission ring and all queued re-arms are submitted together with
+ * the next wait in a single syscall (instead of one epoll_ctl per msg plus epoll_wait).
+ *
+ * The fd of a sock is used as userData of its poll request. This is unique, because a sock with
+ * a pending poll is owned by this listener and only closed after its poll completed (see
+ * ioUringDisposalMap). Cancel requests don't produce completions, so there is exactly one
+ * completion per poll request.
+ */
+void StreamListenerV2::listenLoopIoUring()
+{
+   const int waitTimeoutMS = useAggressivePoll ? 0 : 3000;
+
+   IoUringPoll* ioUringPoll = this->ioUringPoll.get();
+   const int sockReturnPipeReadFD = this->sockReturnPipe->getReadFD()->getFD();
+
+   bool runRDMAConnIdleCheck = false; // true just means we call the method (not enforce the check)
+
+   while(!getSelfTerminate() )
+   {
+      int waitRes = ioUringPoll->submitAndWait(waitTimeoutMS);
+
+      if(unlikely(waitRes < 0) )
+      { // error occurred
+         if(waitRes == -EINTR) // ignore interruption, because the debugger causes this
+            continue;
+
+         log.logErr("Unrecoverable io_uring wait error: " + System::getErrString(-waitRes) );
+         break;
+      }
+
+      uint64_t userData;
+      int pollRes;
+      unsigned numEvents = 0;
+
+      // handle incoming data & connection attempts
+      while(ioUringPoll->popCompletion(userData, pollRes) )
+      {
+         const int fd = (int)userData;
+
+         numEvents++;
+
+         if(fd == sockReturnPipeReadFD)
+         { // (poll requests are one-shot, so we need to re-arm the pipe each time)
+            if(unlikely(!ioUringPoll->armPoll(fd, fd) ) )
+            {
+               log.logErr("Unable to re-arm sock return pipe: " + System::getErrString() );
+               return;
+            }
+
+            if(likely(pollRes > 0) )
+               onSockReturn();
+
+            continue;
+         }
+
+         PollMapIter disposalIter = ioUringDisposalMap.find(fd);
+         if(unlikely(disposalIter != ioUringDisposalMap.end() ) )
+         { // poll of a disposed sock completed (canceled or not) => now it's safe to close it
+            delete(disposalIter->second);
+            ioUringDisposalMap.erase(disposalIter);
+            continue;
+         }
+
+         Socket* sock = (Socket*)pollList.getPollableByFD(fd);
+         if(unlikely(!sock) )
+         { // should never happen
+            log.logErr("Got io_uring completion for unknown FD: " + StringTk::intToStr(fd) );
+            continue;
+         }
+
+         if(unlikely(pollRes < 0) )
+         {
+            log.logErr("io_uring poll failed. FD: " + StringTk::intToStr(fd) + "; "
+               "SysErr: " + System::getErrString(-pollRes) );
+            log.log(Log_NOTICE, "Disconnecting: " + sock->getPeername() );
+
+            pollList.remove(sock);
+            delete(sock);
+            continue;
+         }
+
+         onIncomingData(sock);
+      }
+
+      if(unlikely(!numEvents || (rdmaCheckForceCounter++ > RDMA_CHECK_FORCE_POLLLOOPS) ) )
+      { // no events is nothing to worry about, just idle
+         runRDMAConnIdleCheck = true;
+      }
+
+      if(unlikely(runRDMAConnIdleCheck) )
+      { // note: whether check actually happens depends on elapsed time since last check
+         runRDMAConnIdleCheck = false;
+         rdmaConnIdleCheck();
+      }
+   }
+}
+
+/**
+ * Queue a poll request for the given sock and add it to the pollList. The sock is deleted if this
+ * fails.
+ */
+void StreamListenerV2::armIoUringPoll(Socket* sock)
+{
+   if(likely(ioUringPoll->armPoll(sock->getFD(), sock->getFD() ) ) )
+   {
+      pollList.add(sock);
+      return;
+   }
+
+   log.logErr("Unable to arm io_uring poll for sock. "
+      "FD: " + StringTk::uintToStr(sock->getFD() ) + "; "
+      "SockTypeNum: " + StringTk::uintToStr(sock->getSockType() ) + "; "
+      "SysErr: " + System::getErrString() );
+   log.log(Log_NOTICE, "Disconnecting: " + sock->getPeername() );
+
+   pollList.remove(sock);
+   delete(sock);
+}
+
 /**
  * Receive msg header and add the socket to the work queue.
  */
@@ -266,6 +416,12 @@ void StreamListenerV2::onSockReturn()
          case SockPipeReturn_MSGDONE_NOIMMEDIATE:
          { // most likely case: worker is done with a msg and now returns the sock to the epoll set
 
+            if(ioUringPoll)
+            {
+               armIoUringPoll(currentSock);
+               break; // break out of switch
+            }
+
             struct epoll_event epollEvent;
             epollEvent.events = EPOLLIN | EPOLLONESHOT | EPOLLET;
             epollEvent.data.ptr = currentSock;
@@ -301,6 +457,12 @@ void StreamListenerV2::onSockReturn()
          case SockPipeReturn_NEWCONN:
          { // new conn from ConnAcceptor (or wasn't used with this stream listener yet)
 
+            if(ioUringPoll)
+            {
+               armIoUringPoll(currentSock);
+               break; // break out of switch
+            }
+
             // add new socket file descriptor to epoll set
 
             struct epoll_event epollEvent;
@@ -390,7 +552,11 @@ void StreamListenerV2::rdmaConnIdleCheck()
          log.log(Log_DEBUG,
             "Disconnecting idle RDMA connection: " + currentSock->getPeername() );
 
-         delete(currentSock);
+         if(ioUringPoll && ioUringPoll->cancelPoll(iter->first) )
+            ioUringDisposalMap[iter->first] = currentSock; // deleted when poll is canceled
+         else
+            delete(currentSock);
+
          disposalFDs.push_back(iter->first);
       }
 
@@ -444,6 +610,12 @@ bool StreamListenerV2::isFalseAlarm(RDMASocket* sock)
 
          // we use one-shot mechanism, so we need to re-arm the socket after an event notification
 
+         if(ioUringPoll)
+         {
+            armIoUringPoll(sock);
+            return true;
+         }
+
          struct epoll_event epollEvent;
          epollEvent.events = EPOLLIN | EPOLLONESHOT | EPOLLET;
          epollEvent.data.ptr = sock;
@@ -493,4 +665,9 @@ void StreamListenerV2::deleteAllConns()
    {
       delete(iter->second);
    }
+
+   for(PollMapIter iter = ioUringDisposalMap.begin(); iter != ioUringDisposalMap.end(); iter++)
+   {
+      delete(iter->second);
+   }
 }
@@ -8,6 +8,7 @@
 #include <common/net/message/NetMessage.h>
 #include <common/nodes/Node.h>
 #include <common/threading/PThread.h>
+#include <common/toolkit/poll/IoUringPoll.h>
 #include <common/toolkit/poll/PollList.h>
 #include <common/toolkit/Pipe.h>
 #include <common/Common.h>
@@ -69,12 +70,20 @@ class StreamListenerV2 : public PThread
       int               rdmaCheckForceCounter;
 
       bool              useAggressivePoll; // true to not sleep on epoll and burn CPU
+      unsigned          maxRunToCompletionMsgs; // 0 to always return socks via sockReturnPipe
+
+      bool              useIoUring; // true to try io_uring instead of epoll
+      std::unique_ptr<IoUringPoll> ioUringPoll; // NULL if epoll is used
+      PollMap           ioUringDisposalMap; // socks to be deleted when their poll was canceled
 
       bool initSockReturnPipe();
       bool initSocks(unsigned short listenPort, NicListCapabilities* localNicCaps);
+      bool initIoUring();
 
       virtual void run();
       void listenLoop();
+      void listenLoopIoUring();
+      void armIoUringPoll(Socket* sock);
 
       void onIncomingData(Socket* sock);
       void onSockReturn();
@@ -100,6 +109,34 @@ class StreamListenerV2 : public PThread
          this->useAggressivePoll = true;
       }
 
+      /**
+       * Use io_uring poll requests instead of epoll to wait for incoming data (falls back to epoll
+       * if io_uring is not available).
+       *
+       * Note: Only effective when set before running this component.
+       */
+      void setUseIoUring()
+      {
+         this->useIoUring = true;
+      }
+
+      /**
+       * Max number of additional msgs that a worker may receive and process directly from a sock
+       * if they are already pending after the previous msg, instead of returning the sock to this
+       * listener in between (see IncomingPreprocessedMsgWork::recvPendingMsgHeader() ).
+       *
+       * Note: Only effective when set before running this component.
+       */
+      void setMaxRunToCompletionMsgs(unsigned maxRunToCompletionMsgs)
+      {
+         this->maxRunToCompletionMsgs = maxRunToCompletionMsgs;
+      }
+
+      unsigned getMaxRunToCompletionMsgs() const
+      {
+         return maxRunToCompletionMsgs;
+      }
+
 
    protected:
       // getters & setters
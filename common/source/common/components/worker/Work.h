@@ -35,7 +35,9 @@ class Work
          return &stats;
       }
 
-#ifdef BEEGFS_DEBUG_PROFILING
+      /**
+       * @return creation time of this work package (i.e. roughly the time when it was queued)
+       */
       TimeFine* getAgeTime()
       {
          return &age;
@@ -43,6 +45,5 @@ class Work
 
    private:
       TimeFine age;
-#endif
 };
 
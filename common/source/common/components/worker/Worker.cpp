@@ -24,6 +24,8 @@ void Worker::run()
 
       initBuffers();
 
+      latencyStats.setCurrent();
+
       /* note: we're not directly calling workLoop(workType) below, because:
          1) we want to check that the given workType value is really valid.
          2) we hope that the compiler can use this explicit check and value passing to optimize away
@@ -58,9 +60,9 @@ void Worker::workLoop(QueueWorkType workType)
    {
       Work* work = waitForWorkByType(stats, personalWorkQueue, workType);
 
-#ifdef BEEGFS_DEBUG_PROFILING
       TimeFine workStartTime;
-#endif
+
+      latencyStats.recordQueueWait(workStartTime.elapsedSinceMicro(work->getAgeTime() ) );
 
       HighResolutionStatsTk::resetStats(&stats); // prepare stats
 
@@ -4,6 +4,7 @@
 #include <common/app/AbstractApp.h>
 #include <common/components/worker/queue/MultiWorkQueue.h>
 #include <common/components/worker/queue/PersonalWorkQueue.h>
+#include <common/components/worker/WorkerLatencyStats.h>
 #include <common/components/ComponentInitException.h>
 #include <common/threading/PThread.h>
 
@@ -44,6 +45,7 @@ class Worker : public PThread
       PersonalWorkQueue* personalWorkQueue;
 
       HighResolutionStats stats;
+      WorkerLatencyStats latencyStats;
 
 
       virtual void run();
@@ -0,0 +1,100 @@
+#include "WorkerLatencyStats.h"
+
+#include <mutex>
+
+
+__thread WorkerLatencyStats* WorkerLatencyStats::current;
+
+Mutex WorkerLatencyStats::registryMutex;
+std::set<WorkerLatencyStats*> WorkerLatencyStats::registry;
+LatencyHistogramData WorkerLatencyStats::retiredQueueWait;
+LatencyHistogramDataMap WorkerLatencyStats::retiredMsgProcessing;
+
+
+WorkerLatencyStats::WorkerLatencyStats()
+{
+   for(unsigned i = 0; i < WORKERLATENCYSTATS_TABLE_SIZE; i++)
+      msgTypes[i].store(0, std::memory_order_relaxed);
+
+   std::lock_guard<Mutex> lock(registryMutex);
+   registry.insert(this);
+}
+
+WorkerLatencyStats::~WorkerLatencyStats()
+{
+   std::lock_guard<Mutex> lock(registryMutex);
+
+   // keep the values of terminated workers, so that the aggregated values never go backwards
+   addSnapshotTo(retiredQueueWait, retiredMsgProcessing);
+
+   registry.erase(this);
+}
+
+/**
+ * Note: Only to be called by the owning thread.
+ */
+void WorkerLatencyStats::recordMsgProcessing(uint16_t msgType, uint64_t micro)
+{
+   const unsigned mask = WORKERLATENCYSTATS_TABLE_SIZE - 1;
+
+   for(unsigned probe = 0; probe < WORKERLATENCYSTATS_TABLE_SIZE; probe++)
+   {
+      unsigned idx = (msgType * 2654435761u + probe) & mask;
+      uint16_t slotType = msgTypes[idx].load(std::memory_order_relaxed);
+
+      if(slotType == msgType)
+      {
+         msgHistograms[idx]->record(micro);
+         return;
+      }
+
+      if(!slotType)
+      { // first time we see this msgType
+         msgHistograms[idx].reset(new LatencyHistogram() );
+         msgHistograms[idx]->record(micro);
+         msgTypes[idx].store(msgType, std::memory_order_release);
+         return;
+      }
+   }
+
+   // table full (should never happen with the existing number of msg types) => not recorded
+}
+
+/**
+ * Note: Caller must hold registryMutex.
+ */
+void WorkerLatencyStats::addSnapshotTo(LatencyHistogramData& outQueueWait,
+   LatencyHistogramDataMap& outMsgProcessing) const
+{
+   LatencyHistogramData snapshot;
+
+   queueWait.snapshot(snapshot);
+   outQueueWait.add(snapshot);
+
+   for(unsigned i = 0; i < WORKERLATENCYSTATS_TABLE_SIZE; i++)
+   {
+      uint16_t msgType = msgTypes[i].load(std::memory_order_acquire);
+      if(!msgType)
+         continue;
+
+      msgHistograms[i]->snapshot(snapshot);
+      outMsgProcessing[msgType].add(snapshot);
+   }
+}
+
+/**
+ * Sums up the histograms of all workers of this process (including terminated workers).
+ *
+ * Note: Values are cumulative since process start.
+ */
+void WorkerLatencyStats::getAggregated(LatencyHistogramData& outQueueWait,
+   LatencyHistogramDataMap& outMsgProcessing)
+{
+   std::lock_guard<Mutex> lock(registryMutex);
+
+   outQueueWait = retiredQueueWait;
+   outMsgProcessing = retiredMsgProcessing;
+
+   for(auto iter = registry.begin(); iter != registry.end(); iter++)
+      (*iter)->addSnapshotTo(outQueueWait, outMsgProcessing);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <common/threading/Mutex.h>
+#include <common/toolkit/LatencyHistogram.h>
+#include <common/Common.h>
+
+#include <atomic>
+
+
+#define WORKERLATENCYSTATS_TABLE_SIZE  512 // must be a power of two
+
+
+/**
+ * Per-worker latency histograms for queue wait time and for processing time per message type.
+ *
+ * Each Worker owns one instance and is the only thread that records into it, so the hot path
+ * never takes a lock or touches a shared cache line. All instances register in a global list,
+ * which is only walked (under registryMutex) when a stats request gets aggregated.
+ */
+class WorkerLatencyStats
+{
+   public:
+      WorkerLatencyStats();
+      ~WorkerLatencyStats();
+
+      WorkerLatencyStats(const WorkerLatencyStats&) = delete;
+      WorkerLatencyStats& operator=(const WorkerLatencyStats&) = delete;
+
+      void recordMsgProcessing(uint16_t msgType, uint64_t micro);
+
+      static void getAggregated(LatencyHistogramData& outQueueWait,
+         LatencyHistogramDataMap& outMsgProcessing);
+
+
+   private:
+      LatencyHistogram queueWait;
+
+      // open addressing table: msgType -> histogram (0 means empty, i.e. NETMSGTYPE_Invalid).
+      // only the owner inserts; key is published after the histogram (release/acquire)
+      std::atomic<uint16_t> msgTypes[WORKERLATENCYSTATS_TABLE_SIZE];
+      std::unique_ptr<LatencyHistogram> msgHistograms[WORKERLATENCYSTATS_TABLE_SIZE];
+
+      static __thread WorkerLatencyStats* current;
+
+      static Mutex registryMutex;
+      static std::set<WorkerLatencyStats*> registry;
+      static LatencyHistogramData retiredQueueWait; // from already destructed instances
+      static LatencyHistogramDataMap retiredMsgProcessing;
+
+      void addSnapshotTo(LatencyHistogramData& outQueueWait,
+         LatencyHistogramDataMap& outMsgProcessing) const;
+
+
+   public:
+      // inliners
+
+      void recordQueueWait(uint64_t micro)
+      {
+         queueWait.record(micro);
+      }
+
+      /**
+       * @return stats of the calling worker thread; NULL if the calling thread is not a Worker.
+       */
+      static WorkerLatencyStats* getCurrent()
+      {
+         return current;
+      }
+
+      /**
+       * Note: To be called by the owning thread before it starts processing work.
+       */
+      void setCurrent()
+      {
+         current = this;
+      }
+};
@@ -7,6 +7,7 @@
 #include <common/nodes/NumNodeID.h>
 #include <common/nodes/TargetMapper.h>
 #include <common/nodes/NodeStoreServers.h>
+#include <common/storage/PathInfo.h>
 
 
 struct WriteLocalFileWorkInfo
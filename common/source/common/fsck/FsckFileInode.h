@@ -72,6 +72,7 @@ class FsckFileInode
       bool isBuddyMirrored;
       bool readable;
       bool isMismirrored;
+      bool hasInlineData; // file data is stored in the inode, there are no chunks
 
       uint64_t saveInode;
       int32_t saveDevice;
@@ -108,6 +109,7 @@ class FsckFileInode
          this->isBuddyMirrored = isBuddyMirrored;
          this->readable = readable;
          this->isMismirrored = isMismirrored;
+         this->hasInlineData = false;
       }
 
    public:
@@ -153,6 +155,9 @@ class FsckFileInode
 
       bool getIsMismirrored() const { return isMismirrored; }
 
+      bool getHasInlineData() const { return hasInlineData; }
+      void setHasInlineData(bool value) { hasInlineData = value; }
+
       bool operator<(const FsckFileInode& other) const
       {
          return id < other.id;
@@ -177,7 +182,8 @@ class FsckFileInode
             isInlined == other.isInlined &&
             isBuddyMirrored == other.isBuddyMirrored &&
             readable == other.readable &&
-            isMismirrored == other.isMismirrored;
+            isMismirrored == other.isMismirrored &&
+            hasInlineData == other.hasInlineData;
       }
 
       bool operator!= (const FsckFileInode& other) const
@@ -207,7 +213,8 @@ class FsckFileInode
             % obj->isInlined
             % obj->isBuddyMirrored
             % obj->readable
-            % obj->isMismirrored;
+            % obj->isMismirrored
+            % obj->hasInlineData;
       }
 };
 
@@ -27,8 +27,9 @@ struct NetMessageHeader
    static const uint8_t Flag_BuddyMirrorSecond = 0x01;
    static const uint8_t Flag_IsSelectiveAck    = 0x02;
    static const uint8_t Flag_HasSequenceNumber = 0x04;
+   static const uint8_t Flag_ReadFromSecondary = 0x08; // read-only msg sent to buddy secondary
 
-   static const uint8_t FlagsMask = 0x07;
+   static const uint8_t FlagsMask = 0x0f;
 
    uint32_t       msgLength; // in bytes
    uint16_t       msgFeatureFlags; // feature flags for derived messages (depend on msgType)
@@ -51,16 +52,17 @@ struct NetMessageHeader
       uint64_t prefix = MSG_PREFIX;
 
       ctx
-         % obj->msgLength
-         % obj->msgFeatureFlags
-         % obj->msgCompatFeatureFlags
-         % obj->msgFlags
-         % prefix
-         % obj->msgType
-         % obj->msgTargetID
-         % obj->msgUserID
-         % obj->msgSequence
-         % obj->msgSequenceDone;
+         % serdes::fixed(
+               obj->msgLength,
+               obj->msgFeatureFlags,
+               obj->msgCompatFeatureFlags,
+               obj->msgFlags,
+               prefix,
+               obj->msgType,
+               obj->msgTargetID,
+               obj->msgUserID,
+               obj->msgSequence,
+               obj->msgSequenceDone);
 
       checkPrefix(ctx, prefix);
    }
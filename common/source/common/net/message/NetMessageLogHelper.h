@@ -189,6 +189,12 @@ inline std::string netMessageTypeToStr(int type)
       case NETMSGTYPE_StripePatternUpdateResp: return "StripePatternUpdateResp (2130)";
       case NETMSGTYPE_SetFileState: return "SetFileState (2131)";
       case NETMSGTYPE_SetFileStateResp: return "SetFileStateResp (2132)";
+      case NETMSGTYPE_GetLatencyStats: return "GetLatencyStats (2133)";
+      case NETMSGTYPE_GetLatencyStatsResp: return "GetLatencyStatsResp (2134)";
+      case NETMSGTYPE_UnlinkLocalFiles: return "UnlinkLocalFiles (2135)";
+      case NETMSGTYPE_UnlinkLocalFilesResp: return "UnlinkLocalFilesResp (2136)";
+      case NETMSGTYPE_GetTargetLoadStats: return "GetTargetLoadStats (2137)";
+      case NETMSGTYPE_GetTargetLoadStatsResp: return "GetTargetLoadStatsResp (2138)";
       case NETMSGTYPE_OpenFile: return "OpenFile (3001)";
       case NETMSGTYPE_OpenFileResp: return "OpenFileResp (3002)";
       case NETMSGTYPE_CloseFile: return "CloseFile (3003)";
@@ -223,6 +229,10 @@ inline std::string netMessageTypeToStr(int type)
       case NETMSGTYPE_ReadLocalFileRDMA: return "ReadLocalFileRDMA (3039)";
       case NETMSGTYPE_ReadLocalFileRDMAResp: return "ReadLocalFileRDMAResp (3040)";
 #endif /* BEEGFS_NVFS */
+      case NETMSGTYPE_ReadInlineFile: return "ReadInlineFile (3041)";
+      case NETMSGTYPE_ReadInlineFileResp: return "ReadInlineFileResp (3042)";
+      case NETMSGTYPE_WriteInlineFile: return "WriteInlineFile (3043)";
+      case NETMSGTYPE_WriteInlineFileResp: return "WriteInlineFileResp (3044)";
       case NETMSGTYPE_SetChannelDirect: return "SetChannelDirect (4001)";
       case NETMSGTYPE_Ack: return "Ack (4003)";
       case NETMSGTYPE_Dummy: return "Dummy (4005)";
@@ -278,6 +288,10 @@ inline std::string netMessageTypeToStr(int type)
       case NETMSGTYPE_MoveChunkFileResp: return "MoveChunkFileResp (7043)";
       case NETMSGTYPE_CheckAndRepairDupInode: return "CheckAndRepairDupInode (7044)";
       case NETMSGTYPE_CheckAndRepairDupInodeResp: return "CheckAndRepairDupInodeResp (7045)";
+      case NETMSGTYPE_StreamFsckInodes: return "StreamFsckInodes (7046)";
+      case NETMSGTYPE_StreamFsckInodesResp: return "StreamFsckInodesResp (7047)";
+      case NETMSGTYPE_StreamFsckDirEntries: return "StreamFsckDirEntries (7048)";
+      case NETMSGTYPE_StreamFsckDirEntriesResp: return "StreamFsckDirEntriesResp (7049)";
    }
 
    return "unknown (" + std::to_string(type) + ")";
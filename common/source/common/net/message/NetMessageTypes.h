@@ -182,6 +182,12 @@
 #define NETMSGTYPE_StripePatternUpdateResp         2130
 #define NETMSGTYPE_SetFileState                    2131
 #define NETMSGTYPE_SetFileStateResp                2132
+#define NETMSGTYPE_GetLatencyStats                 2133
+#define NETMSGTYPE_GetLatencyStatsResp             2134
+#define NETMSGTYPE_UnlinkLocalFiles                2135
+#define NETMSGTYPE_UnlinkLocalFilesResp            2136
+#define NETMSGTYPE_GetTargetLoadStats              2137
+#define NETMSGTYPE_GetTargetLoadStatsResp          2138
 
 // session messages
 #define NETMSGTYPE_OpenFile                        3001
@@ -218,6 +224,10 @@
 #define NETMSGTYPE_ReadLocalFileRDMA               3039
 #define NETMSGTYPE_ReadLocalFileRDMAResp           3040
 #endif /* BEEGFS_NVFS */
+#define NETMSGTYPE_ReadInlineFile                  3041
+#define NETMSGTYPE_ReadInlineFileResp              3042
+#define NETMSGTYPE_WriteInlineFile                 3043
+#define NETMSGTYPE_WriteInlineFileResp             3044
 
 // control messages
 #define NETMSGTYPE_SetChannelDirect                4001
@@ -279,4 +289,8 @@
 #define NETMSGTYPE_MoveChunkFileResp               7043
 #define NETMSGTYPE_CheckAndRepairDupInode          7044
 #define NETMSGTYPE_CheckAndRepairDupInodeResp      7045
+#define NETMSGTYPE_StreamFsckInodes                7046
+#define NETMSGTYPE_StreamFsckInodesResp            7047
+#define NETMSGTYPE_StreamFsckDirEntries            7048
+#define NETMSGTYPE_StreamFsckDirEntriesResp        7049
 
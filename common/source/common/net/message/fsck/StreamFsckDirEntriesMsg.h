@@ -0,0 +1,49 @@
+#pragma once
+
+#include <common/net/message/NetMessage.h>
+
+/**
+ * Requests all dir entries (with their content dirs and inlined file inodes) of a range of
+ * top-level hash dirs as a stream of StreamFsckDirEntriesRespMsgs over the connection of this
+ * request (instead of one RetrieveDirEntriesMsg per batch).
+ *
+ * The server walks the hash dirs with several threads and sends batches in no particular order
+ * until the final response with isLast set.
+ */
+class StreamFsckDirEntriesMsg : public NetMessageSerdes<StreamFsckDirEntriesMsg>
+{
+   public:
+      /**
+       * @param hashDirStart first top-level hash dir
+       * @param hashDirEnd last top-level hash dir (inclusive)
+       */
+      StreamFsckDirEntriesMsg(unsigned hashDirStart, unsigned hashDirEnd, bool isBuddyMirrored):
+         BaseType(NETMSGTYPE_StreamFsckDirEntries),
+         hashDirStart(hashDirStart), hashDirEnd(hashDirEnd), isBuddyMirrored(isBuddyMirrored)
+      {
+      }
+
+      StreamFsckDirEntriesMsg() : BaseType(NETMSGTYPE_StreamFsckDirEntries)
+      {
+      }
+
+   private:
+      uint32_t hashDirStart;
+      uint32_t hashDirEnd;
+      bool isBuddyMirrored;
+
+   public:
+      unsigned getHashDirStart() const { return hashDirStart; }
+      unsigned getHashDirEnd() const { return hashDirEnd; }
+      bool getIsBuddyMirrored() const { return isBuddyMirrored; }
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % obj->hashDirStart
+            % obj->hashDirEnd
+            % obj->isBuddyMirrored;
+      }
+};
+
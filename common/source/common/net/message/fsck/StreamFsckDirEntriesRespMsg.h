@@ -0,0 +1,84 @@
+#pragma once
+
+#include <common/fsck/FsckContDir.h>
+#include <common/fsck/FsckDirEntry.h>
+#include <common/fsck/FsckFileInode.h>
+#include <common/net/message/NetMessage.h>
+#include <common/toolkit/ListTk.h>
+
+// max number of dir entries (and of content dirs) in one streamed batch
+#define STREAMFSCKDIRENTRIES_BATCH_SIZE 1000
+
+/**
+ * One batch of a StreamFsckDirEntriesMsg stream. The dir entries of a content dir may be split
+ * across several batches; each content dir itself is sent once, together with its first entries.
+ *
+ * The last message of a stream has isLast set and carries the result of the whole export (and
+ * no entries).
+ */
+class StreamFsckDirEntriesRespMsg : public NetMessageSerdes<StreamFsckDirEntriesRespMsg>
+{
+   public:
+      StreamFsckDirEntriesRespMsg(FsckContDirList* contDirs, FsckDirEntryList* dirEntries,
+         FsckFileInodeList* inlinedFileInodes, bool isLast, FhgfsOpsErr result) :
+         BaseType(NETMSGTYPE_StreamFsckDirEntriesResp),
+         contDirs(contDirs), dirEntries(dirEntries), inlinedFileInodes(inlinedFileInodes),
+         isLast(isLast), result(result)
+      {
+      }
+
+      StreamFsckDirEntriesRespMsg() : BaseType(NETMSGTYPE_StreamFsckDirEntriesResp)
+      {
+      }
+
+   private:
+      FsckContDirList* contDirs;
+      FsckDirEntryList* dirEntries;
+      FsckFileInodeList* inlinedFileInodes;
+      bool isLast;
+      FhgfsOpsErr result;
+
+      // for deserialization
+      struct {
+         FsckContDirList contDirs;
+         FsckDirEntryList dirEntries;
+         FsckFileInodeList inlinedFileInodes;
+      } parsed;
+
+   public:
+      FsckContDirList& getContDirs()
+      {
+         return *contDirs;
+      }
+
+      FsckDirEntryList& getDirEntries()
+      {
+         return *dirEntries;
+      }
+
+      FsckFileInodeList& getInlinedFileInodes()
+      {
+         return *inlinedFileInodes;
+      }
+
+      bool getIsLast() const
+      {
+         return isLast;
+      }
+
+      FhgfsOpsErr getResult() const
+      {
+         return result;
+      }
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % serdes::backedPtr(obj->contDirs, obj->parsed.contDirs)
+            % serdes::backedPtr(obj->dirEntries, obj->parsed.dirEntries)
+            % serdes::backedPtr(obj->inlinedFileInodes, obj->parsed.inlinedFileInodes)
+            % obj->isLast
+            % serdes::as<int32_t>(obj->result);
+      }
+};
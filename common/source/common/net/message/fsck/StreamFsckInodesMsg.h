@@ -0,0 +1,48 @@
+#pragma once
+
+#include <common/net/message/NetMessage.h>
+
+/**
+ * Requests all inodes of a range of top-level hash dirs as a stream of StreamFsckInodesRespMsgs
+ * over the connection of this request (instead of one RetrieveInodesMsg per batch).
+ *
+ * The server walks the hash dirs with several threads and sends batches in no particular order
+ * until the final response with isLast set.
+ */
+class StreamFsckInodesMsg : public NetMessageSerdes<StreamFsckInodesMsg>
+{
+   public:
+      /**
+       * @param hashDirStart first top-level hash dir
+       * @param hashDirEnd last top-level hash dir (inclusive)
+       */
+      StreamFsckInodesMsg(unsigned hashDirStart, unsigned hashDirEnd, bool isBuddyMirrored):
+         BaseType(NETMSGTYPE_StreamFsckInodes),
+         hashDirStart(hashDirStart), hashDirEnd(hashDirEnd), isBuddyMirrored(isBuddyMirrored)
+      {
+      }
+
+      StreamFsckInodesMsg() : BaseType(NETMSGTYPE_StreamFsckInodes)
+      {
+      }
+
+   private:
+      uint32_t hashDirStart;
+      uint32_t hashDirEnd;
+      bool isBuddyMirrored;
+
+   public:
+      unsigned getHashDirStart() const { return hashDirStart; }
+      unsigned getHashDirEnd() const { return hashDirEnd; }
+      bool getIsBuddyMirrored() const { return isBuddyMirrored; }
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % obj->hashDirStart
+            % obj->hashDirEnd
+            % obj->isBuddyMirrored;
+      }
+};
+
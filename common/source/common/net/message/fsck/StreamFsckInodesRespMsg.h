@@ -0,0 +1,72 @@
+#pragma once
+
+#include <common/fsck/FsckDirInode.h>
+#include <common/fsck/FsckFileInode.h>
+#include <common/net/message/NetMessage.h>
+#include <common/toolkit/ListTk.h>
+
+// max number of inodes in one streamed batch
+#define STREAMFSCKINODES_BATCH_SIZE 1000
+
+/**
+ * One batch of a StreamFsckInodesMsg stream. The last message of a stream has isLast set and
+ * carries the result of the whole export (and no inodes).
+ */
+class StreamFsckInodesRespMsg : public NetMessageSerdes<StreamFsckInodesRespMsg>
+{
+   public:
+      StreamFsckInodesRespMsg(FsckFileInodeList* fileInodes, FsckDirInodeList* dirInodes,
+         bool isLast, FhgfsOpsErr result) :
+         BaseType(NETMSGTYPE_StreamFsckInodesResp),
+         fileInodes(fileInodes), dirInodes(dirInodes), isLast(isLast), result(result)
+      {
+      }
+
+      StreamFsckInodesRespMsg() : BaseType(NETMSGTYPE_StreamFsckInodesResp)
+      {
+      }
+
+   private:
+      FsckFileInodeList* fileInodes;
+      FsckDirInodeList* dirInodes;
+      bool isLast;
+      FhgfsOpsErr result;
+
+      // for deserialization
+      struct {
+         FsckFileInodeList fileInodes;
+         FsckDirInodeList dirInodes;
+      } parsed;
+
+   public:
+      FsckFileInodeList& getFileInodes()
+      {
+         return *fileInodes;
+      }
+
+      FsckDirInodeList& getDirInodes()
+      {
+         return *dirInodes;
+      }
+
+      bool getIsLast() const
+      {
+         return isLast;
+      }
+
+      FhgfsOpsErr getResult() const
+      {
+         return result;
+      }
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % serdes::backedPtr(obj->fileInodes, obj->parsed.fileInodes)
+            % serdes::backedPtr(obj->dirInodes, obj->parsed.dirInodes)
+            % obj->isLast
+            % serdes::as<int32_t>(obj->result);
+      }
+};
+
@@ -6,6 +6,9 @@
 #include <common/toolkit/serialization/Serialization.h>
 
 
+#define STORAGEBENCHCONTROLMSG_FLAG_HAS_OPTIONS    1 /* contains StorageBenchOptions */
+
+
 class StorageBenchControlMsg: public NetMessageSerdes<StorageBenchControlMsg>
 {
    public:
@@ -40,6 +43,14 @@ class StorageBenchControlMsg: public NetMessageSerdes<StorageBenchControlMsg>
             % obj->threads
             % obj->odirect
             % serdes::backedPtr(obj->targetIDs, obj->parsed.targetIDs);
+
+         if (obj->isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSG_FLAG_HAS_OPTIONS) )
+            ctx % obj->options;
+      }
+
+      virtual unsigned getSupportedHeaderFeatureFlagsMask() const override
+      {
+         return STORAGEBENCHCONTROLMSG_FLAG_HAS_OPTIONS;
       }
 
    private:
@@ -50,6 +61,7 @@ class StorageBenchControlMsg: public NetMessageSerdes<StorageBenchControlMsg>
       int32_t threads;
       bool odirect;
       UInt16List* targetIDs;
+      StorageBenchOptions options; // defaults if HAS_OPTIONS is not set
 
       // deserialization info
       struct {
@@ -93,5 +105,16 @@ class StorageBenchControlMsg: public NetMessageSerdes<StorageBenchControlMsg>
       {
          return *targetIDs;
       }
+
+      const StorageBenchOptions& getOptions() const
+      {
+         return options;
+      }
+
+      void setOptions(const StorageBenchOptions& options)
+      {
+         this->options = options;
+         addMsgHeaderFeatureFlag(STORAGEBENCHCONTROLMSG_FLAG_HAS_OPTIONS);
+      }
 };
 
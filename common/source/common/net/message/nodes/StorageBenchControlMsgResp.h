@@ -6,6 +6,9 @@
 #include <common/toolkit/ZipIterator.h>
 
 
+#define STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES    1 /* contains per-target latencies */
+
+
 class StorageBenchControlMsgResp: public NetMessageSerdes<StorageBenchControlMsgResp>
 {
    public:
@@ -45,6 +48,14 @@ class StorageBenchControlMsgResp: public NetMessageSerdes<StorageBenchControlMsg
             % obj->errorCode
             % obj->resultTargetIDs
             % obj->resultValues;
+
+         if (obj->isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES) )
+            ctx % obj->latencies;
+      }
+
+      virtual unsigned getSupportedHeaderFeatureFlagsMask() const override
+      {
+         return STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES;
       }
 
    private:
@@ -54,6 +65,7 @@ class StorageBenchControlMsgResp: public NetMessageSerdes<StorageBenchControlMsg
       int32_t errorCode;             // STORAGEBENCH_ERROR...
       UInt16List resultTargetIDs;
       Int64List resultValues;
+      StorageBenchLatencyMap latencies;
 
    public:
       //inliners
@@ -86,5 +98,26 @@ class StorageBenchControlMsgResp: public NetMessageSerdes<StorageBenchControlMsg
             (*outResults)[*(valuesTargetIDIter()->second)] = *(valuesTargetIDIter()->first);
          }
       }
+
+      /**
+       * @return NULL if the server didn't send latencies (older server version)
+       */
+      const StorageBenchLatencyMap* getLatencies() const
+      {
+         if (!isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES) )
+            return NULL;
+
+         return &latencies;
+      }
+
+      /**
+       * Note: The receiver computes percentiles (e.g. p50/p99/p999) with
+       * LatencyHistogramData::percentileMicro().
+       */
+      void setLatencies(StorageBenchLatencyMap latencies)
+      {
+         this->latencies = std::move(latencies);
+         addMsgHeaderFeatureFlag(STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES);
+      }
 };
 
@@ -10,6 +10,7 @@
 #define OPENFILEMSG_FLAG_USE_QUOTA           1 /* if the message contains quota informations */
 #define OPENFILEMSG_FLAG_HAS_EVENT           2 /* contains file event logging information */
 #define OPENFILEMSG_FLAG_BYPASS_ACCESS_CHECK 4 /* bypass file access checks on metadata server */
+#define OPENFILEMSG_FLAG_INLINE_DATA         8 /* client can access inline file data via meta server */
 
 class OpenFileMsg : public MirroredMessageBase<OpenFileMsg>
 {
@@ -92,7 +93,8 @@ class OpenFileMsg : public MirroredMessageBase<OpenFileMsg>
       unsigned getSupportedHeaderFeatureFlagsMask() const override
       {
          return OPENFILEMSG_FLAG_USE_QUOTA
-            | OPENFILEMSG_FLAG_HAS_EVENT | OPENFILEMSG_FLAG_BYPASS_ACCESS_CHECK;
+            | OPENFILEMSG_FLAG_HAS_EVENT | OPENFILEMSG_FLAG_BYPASS_ACCESS_CHECK
+            | OPENFILEMSG_FLAG_INLINE_DATA;
       }
 
       bool supportsMirroring() const override { return true; }
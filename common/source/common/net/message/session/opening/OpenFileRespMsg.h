@@ -5,6 +5,8 @@
 #include <common/storage/PathInfo.h>
 #include <common/Common.h>
 
+#define OPENFILERESPMSG_FLAG_INLINE_DATA     1 /* file data is in the inode, use Read/WriteInlineFile */
+
 
 class OpenFileRespMsg : public NetMessageSerdes<OpenFileRespMsg>
 {
@@ -77,6 +79,11 @@ class OpenFileRespMsg : public NetMessageSerdes<OpenFileRespMsg>
       } parsed;
 
    public:
+      unsigned getSupportedHeaderFeatureFlagsMask() const override
+      {
+         return OPENFILERESPMSG_FLAG_INLINE_DATA;
+      }
+
       StripePattern& getPattern()
       {
          return *pattern;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/EntryInfo.h>
+
+/**
+ * Read from a file whose data is stored in its metadata inode (see OPENFILERESPMSG_FLAG_INLINE_DATA)
+ * instead of its chunk files.
+ */
+class ReadInlineFileMsg : public NetMessageSerdes<ReadInlineFileMsg>
+{
+   public:
+      /**
+       * @param entryInfo just a reference, so do not free it as long as you use this object!
+       */
+      ReadInlineFileMsg(EntryInfo* entryInfo, int64_t offset, int64_t count) :
+         BaseType(NETMSGTYPE_ReadInlineFile),
+         entryInfo(entryInfo), offset(offset), count(count)
+      {
+      }
+
+      /**
+       * For deserialization only!
+       */
+      ReadInlineFileMsg() : BaseType(NETMSGTYPE_ReadInlineFile) {}
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % obj->offset
+            % obj->count
+            % serdes::backedPtr(obj->entryInfo, obj->parsed.entryInfo);
+      }
+
+   private:
+      EntryInfo* entryInfo;
+      int64_t offset;
+      int64_t count;
+
+      // for deserialization
+      struct {
+         EntryInfo entryInfo;
+      } parsed;
+
+   public:
+      EntryInfo* getEntryInfo() const { return entryInfo; }
+      int64_t getOffset() const { return offset; }
+      int64_t getCount() const { return count; }
+};
+
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/StorageErrors.h>
+
+/**
+ * Result FhgfsOpsErr_NOTSUPP means that the file data is not (or no longer) stored in the inode,
+ * so the client has to read the chunk files instead.
+ */
+class ReadInlineFileRespMsg : public NetMessageSerdes<ReadInlineFileRespMsg>
+{
+   public:
+      /**
+       * @param data less than the requested number of bytes if the end of file was reached
+       */
+      ReadInlineFileRespMsg(FhgfsOpsErr result, std::string data) :
+         BaseType(NETMSGTYPE_ReadInlineFileResp),
+         result(result), data(std::move(data))
+      {
+      }
+
+      /**
+       * For deserialization only!
+       */
+      ReadInlineFileRespMsg() : BaseType(NETMSGTYPE_ReadInlineFileResp) {}
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % serdes::as<int32_t>(obj->result)
+            % serdes::stringAlign4(obj->data);
+      }
+
+   private:
+      FhgfsOpsErr result;
+      std::string data;
+
+   public:
+      FhgfsOpsErr getResult() const { return result; }
+      const std::string& getData() const { return data; }
+};
+
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/EntryInfo.h>
+
+/**
+ * Write to a file whose data is stored in its metadata inode (see
+ * OPENFILERESPMSG_FLAG_INLINE_DATA) instead of its chunk files.
+ */
+class WriteInlineFileMsg : public NetMessageSerdes<WriteInlineFileMsg>
+{
+   public:
+      /**
+       * @param entryInfo just a reference, so do not free it as long as you use this object!
+       * @param data just a reference, so do not free it as long as you use this object!
+       */
+      WriteInlineFileMsg(EntryInfo* entryInfo, int64_t offset, const char* data,
+            unsigned dataLen) :
+         BaseType(NETMSGTYPE_WriteInlineFile),
+         entryInfo(entryInfo), offset(offset), data(data), dataLen(dataLen)
+      {
+      }
+
+      /**
+       * For deserialization only!
+       */
+      WriteInlineFileMsg() : BaseType(NETMSGTYPE_WriteInlineFile) {}
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % obj->offset
+            % serdes::backedPtr(obj->entryInfo, obj->parsed.entryInfo)
+            % serdes::rawString(obj->data, obj->dataLen, 4);
+      }
+
+   private:
+      EntryInfo* entryInfo;
+      int64_t offset;
+      const char* data; // points into the message buffer after deserialization
+      unsigned dataLen;
+
+      // for deserialization
+      struct {
+         EntryInfo entryInfo;
+      } parsed;
+
+   public:
+      EntryInfo* getEntryInfo() const { return entryInfo; }
+      int64_t getOffset() const { return offset; }
+      const char* getData() const { return data; }
+      unsigned getDataLen() const { return dataLen; }
+};
+
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/StorageErrors.h>
+
+/**
+ * Result FhgfsOpsErr_NOTSUPP means that the file data is not (or no longer) stored in the inode,
+ * e.g. because the write would have made it too large, so the client has to write the chunk files
+ * instead.
+ */
+class WriteInlineFileRespMsg : public NetMessageSerdes<WriteInlineFileRespMsg>
+{
+   public:
+      WriteInlineFileRespMsg(FhgfsOpsErr result) :
+         BaseType(NETMSGTYPE_WriteInlineFileResp),
+         result(result)
+      {
+      }
+
+      /**
+       * For deserialization only!
+       */
+      WriteInlineFileRespMsg() : BaseType(NETMSGTYPE_WriteInlineFileResp) {}
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx % serdes::as<int32_t>(obj->result);
+      }
+
+   private:
+      FhgfsOpsErr result;
+
+   public:
+      FhgfsOpsErr getResult() const { return result; }
+};
+
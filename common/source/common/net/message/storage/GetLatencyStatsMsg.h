@@ -0,0 +1,18 @@
+#pragma once
+
+#include <common/net/message/SimpleMsg.h>
+#include <common/Common.h>
+
+
+/**
+ * Requests the cumulative worker latency histograms of a server (queue wait time and processing
+ * time per message type).
+ */
+class GetLatencyStatsMsg : public SimpleMsg
+{
+   public:
+      GetLatencyStatsMsg() : SimpleMsg(NETMSGTYPE_GetLatencyStats)
+      {
+      }
+};
+
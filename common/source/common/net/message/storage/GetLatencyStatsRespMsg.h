@@ -0,0 +1,58 @@
+#pragma once
+
+#include <common/net/message/NetMessage.h>
+#include <common/toolkit/LatencyHistogram.h>
+#include <common/Common.h>
+
+
+class GetLatencyStatsRespMsg : public NetMessageSerdes<GetLatencyStatsRespMsg>
+{
+   public:
+      /**
+       * @param queueWait just a reference, so do not free it as long as you use this object!
+       * @param msgProcessing just a reference, so do not free it as long as you use this object!
+       */
+      GetLatencyStatsRespMsg(LatencyHistogramData* queueWait,
+         LatencyHistogramDataMap* msgProcessing) :
+         BaseType(NETMSGTYPE_GetLatencyStatsResp)
+      {
+         this->queueWait = queueWait;
+         this->msgProcessing = msgProcessing;
+      }
+
+      GetLatencyStatsRespMsg() : BaseType(NETMSGTYPE_GetLatencyStatsResp)
+      {
+      }
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % serdes::backedPtr(obj->queueWait, obj->parsed.queueWait)
+            % serdes::backedPtr(obj->msgProcessing, obj->parsed.msgProcessing);
+      }
+
+   private:
+      // for serialization
+      LatencyHistogramData* queueWait; // not owned by this object!
+      LatencyHistogramDataMap* msgProcessing; // not owned by this object!
+
+      // for deserialization
+      struct {
+         LatencyHistogramData queueWait;
+         LatencyHistogramDataMap msgProcessing;
+      } parsed;
+
+
+   public:
+      LatencyHistogramData& getQueueWait()
+      {
+         return *queueWait;
+      }
+
+      LatencyHistogramDataMap& getMsgProcessing()
+      {
+         return *msgProcessing;
+      }
+};
+
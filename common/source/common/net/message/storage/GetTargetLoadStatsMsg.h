@@ -0,0 +1,18 @@
+#pragma once
+
+#include <common/net/message/SimpleMsg.h>
+#include <common/Common.h>
+
+
+/**
+ * Requests the high-res stats of the last stats interval of the worker queue of each target of a
+ * storage server (for the loadaware target chooser).
+ */
+class GetTargetLoadStatsMsg : public SimpleMsg
+{
+   public:
+      GetTargetLoadStatsMsg() : SimpleMsg(NETMSGTYPE_GetTargetLoadStats)
+      {
+      }
+};
+
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <common/net/message/NetMessage.h>
+#include <common/toolkit/HighResolutionStats.h>
+#include <common/Common.h>
+
+
+class GetTargetLoadStatsRespMsg : public NetMessageSerdes<GetTargetLoadStatsRespMsg>
+{
+   public:
+      /**
+       * @param targetStats just a reference, so do not free it as long as you use this object!
+       */
+      GetTargetLoadStatsRespMsg(TargetHighResStatsMap* targetStats) :
+         BaseType(NETMSGTYPE_GetTargetLoadStatsResp)
+      {
+         this->targetStats = targetStats;
+      }
+
+      GetTargetLoadStatsRespMsg() : BaseType(NETMSGTYPE_GetTargetLoadStatsResp)
+      {
+      }
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % serdes::backedPtr(obj->targetStats, obj->parsed.targetStats);
+      }
+
+   private:
+      // for serialization
+      TargetHighResStatsMap* targetStats; // not owned by this object!
+
+      // for deserialization
+      struct {
+         TargetHighResStatsMap targetStats;
+      } parsed;
+
+
+   public:
+      TargetHighResStatsMap& getTargetStats()
+      {
+         return *targetStats;
+      }
+};
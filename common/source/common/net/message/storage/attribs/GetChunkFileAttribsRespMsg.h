@@ -29,12 +29,13 @@ class GetChunkFileAttribsRespMsg : public NetMessageSerdes<GetChunkFileAttribsRe
       static void serialize(This obj, Ctx& ctx)
       {
          ctx
-            % obj->size
-            % obj->allocedBlocks
-            % obj->modificationTimeSecs
-            % obj->lastAccessTimeSecs
-            % obj->storageVersion
-            % obj->result;
+            % serdes::fixed(
+                  obj->size,
+                  obj->allocedBlocks,
+                  obj->modificationTimeSecs,
+                  obj->lastAccessTimeSecs,
+                  obj->storageVersion,
+                  obj->result);
       }
 
    private:
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/PathInfo.h>
+
+
+// max number of chunks in one UnlinkLocalFilesMsg
+#define UNLINKLOCALFILESMSG_MAX_ENTRIES   1024
+
+
+/**
+ * One chunk file of an UnlinkLocalFilesMsg.
+ */
+struct UnlinkLocalFilesEntry
+{
+   std::string entryID;
+   uint16_t targetID;
+   PathInfo pathInfo;
+
+   UnlinkLocalFilesEntry() : targetID(0) {}
+
+   UnlinkLocalFilesEntry(const std::string& entryID, uint16_t targetID, const PathInfo& pathInfo) :
+      entryID(entryID), targetID(targetID), pathInfo(pathInfo)
+   {
+   }
+
+   template<typename This, typename Ctx>
+   static void serialize(This obj, Ctx& ctx)
+   {
+      ctx
+         % serdes::stringAlign4(obj->entryID)
+         % obj->pathInfo
+         % obj->targetID;
+   }
+};
+
+typedef std::vector<UnlinkLocalFilesEntry> UnlinkLocalFilesEntryVec;
+
+
+/**
+ * Unlink many chunk files (of any targets of the receiving storage server) with a single request,
+ * like one UnlinkLocalFileMsg per entry.
+ *
+ * Note: Not for buddy mirrored chunks (which have to be forwarded to the secondary); use
+ * UnlinkLocalFileMsg for those.
+ */
+class UnlinkLocalFilesMsg : public NetMessageSerdes<UnlinkLocalFilesMsg>
+{
+   public:
+      /**
+       * @param entries just a reference, so do not free it as long as you use this object!
+       */
+      UnlinkLocalFilesMsg(UnlinkLocalFilesEntryVec* entries) :
+         BaseType(NETMSGTYPE_UnlinkLocalFiles), entries(entries)
+      {
+      }
+
+      /**
+       * For deserialization only!
+       */
+      UnlinkLocalFilesMsg() : BaseType(NETMSGTYPE_UnlinkLocalFiles) { }
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % serdes::backedPtr(obj->entries, obj->parsed.entries);
+      }
+
+
+   private:
+      // for serialization
+      UnlinkLocalFilesEntryVec* entries; // not owned by this object!
+
+      // for deserialization
+      struct {
+         UnlinkLocalFilesEntryVec entries;
+      } parsed;
+
+
+   public:
+      // getters & setters
+
+      UnlinkLocalFilesEntryVec& getEntries()
+      {
+         return *entries;
+      }
+};
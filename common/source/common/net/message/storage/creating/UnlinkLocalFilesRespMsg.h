@@ -0,0 +1,50 @@
+#pragma once
+
+#include <common/net/message/NetMessage.h>
+
+
+/**
+ * Results of an UnlinkLocalFilesMsg, in the order of the request entries.
+ */
+class UnlinkLocalFilesRespMsg : public NetMessageSerdes<UnlinkLocalFilesRespMsg>
+{
+   public:
+      /**
+       * @param results just a reference, so do not free it as long as you use this object!
+       */
+      UnlinkLocalFilesRespMsg(FhgfsOpsErrVec* results) :
+         BaseType(NETMSGTYPE_UnlinkLocalFilesResp), results(results)
+      {
+      }
+
+      /**
+       * For deserialization only!
+       */
+      UnlinkLocalFilesRespMsg() : BaseType(NETMSGTYPE_UnlinkLocalFilesResp) { }
+
+      template<typename This, typename Ctx>
+      static void serialize(This obj, Ctx& ctx)
+      {
+         ctx
+            % serdes::backedPtr(obj->results, obj->parsed.results);
+      }
+
+
+   private:
+      // for serialization
+      FhgfsOpsErrVec* results; // not owned by this object!
+
+      // for deserialization
+      struct {
+         FhgfsOpsErrVec results;
+      } parsed;
+
+
+   public:
+      // getters & setters
+
+      FhgfsOpsErrVec& getResults()
+      {
+         return *results;
+      }
+};
@@ -16,6 +16,7 @@
 #define LOOKUPINTENTMSG_FLAG_CREATEEXCLUSIVE    4 /* exclusive file creation */
 #define LOOKUPINTENTMSG_FLAG_OPEN               8 /* open file */
 #define LOOKUPINTENTMSG_FLAG_STAT              16 /* stat file */
+#define LOOKUPINTENTMSG_FLAG_INLINE_DATA       32 /* client can access inline file data */
 
 
 // feature flags as header flags
@@ -16,6 +16,7 @@
 #define LOOKUPINTENTRESPMSG_FLAG_CREATE             2 /* create file response */
 #define LOOKUPINTENTRESPMSG_FLAG_OPEN               4 /* open file response */
 #define LOOKUPINTENTRESPMSG_FLAG_STAT               8 /* stat file response */
+#define LOOKUPINTENTRESPMSG_FLAG_INLINE_DATA       16 /* opened file has inline data */
 
 
 class LookupIntentRespMsg : public NetMessageSerdes<LookupIntentRespMsg>
@@ -147,6 +148,11 @@ class LookupIntentRespMsg : public NetMessageSerdes<LookupIntentRespMsg>
          this->pathInfoPtr = pathInfo;
       }
 
+      void addResponseInlineData()
+      {
+         this->responseFlags |= LOOKUPINTENTRESPMSG_FLAG_INLINE_DATA;
+      }
+
       void addResponseStat(FhgfsOpsErr statResult, StatData* statData)
       {
          this->responseFlags |= LOOKUPINTENTRESPMSG_FLAG_STAT;
@@ -131,6 +131,9 @@ class Socket : public Channel
       {
          // note: this uses a soft timeout that is being reset after each received chunk
 
+         // note: each recvT() takes everything that is buffered up to the missing length (and
+         //    StandardSocket only waits if nothing is buffered), so we don't wait per fragment.
+
          ssize_t missing = len;
 
          do
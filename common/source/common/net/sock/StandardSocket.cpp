@@ -485,9 +485,38 @@ ssize_t StandardSocket::recv(void *buf, size_t len, int flags)
    }
 }
 
+/**
+ * Copy data that is already buffered in the receive queue without removing it from the queue and
+ * without waiting for more data to arrive.
+ *
+ * Note: Peeked bytes are not accounted in the stats (that happens when they are really received).
+ *
+ * @return number of bytes copied to buf (may be less than len), 0 if no data is available.
+ * @throw SocketDisconnectException
+ */
+ssize_t StandardSocket::recvPeekNonblocking(void *buf, size_t len)
+{
+   ssize_t recvRes = ::recv(sock, buf, len, MSG_PEEK | MSG_DONTWAIT);
+   if(recvRes > 0)
+      return recvRes;
+
+   if(recvRes == 0)
+      throw SocketDisconnectException(std::string("Soft disconnect from ") + peername);
+
+   if( (errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR) )
+      return 0;
+
+   throw SocketDisconnectException(std::string("Recv(): Hard disconnect from ") +
+      peername + ". SysErr: " + System::getErrString() );
+}
+
 /**
  * Note: This is the default version, using epoll only => see man pages of select(2) bugs section
  *
+ * Note: For stream sockets, we optimistically try a non-blocking recv first, because data is
+ * often already buffered (e.g. msg payload that arrived together with its header, or the remaining
+ * fragments in recvExactT), so we only pay for the epoll_wait when we actually need to wait.
+ *
  * @throw SocketException
  */
 ssize_t StandardSocket::recvT(void *buf, size_t len, int flags, int timeoutMS)
@@ -497,6 +526,25 @@ ssize_t StandardSocket::recvT(void *buf, size_t len, int flags, int timeoutMS)
    if (epollFD == -1)
       throw SocketException("recvT called on non-epoll socket instance");
 
+   if (!isDgramSocket)
+   { // (dgram sockets may be groups with subordinates in the epoll set => always use epoll)
+      ssize_t recvRes = ::recv(sock, buf, len, flags | MSG_DONTWAIT);
+      if (likely(recvRes > 0) )
+      {
+         stats->incVals.netRecvBytes += recvRes;
+         return recvRes;
+      }
+
+      if (recvRes == 0)
+         throw SocketDisconnectException(std::string("Soft disconnect from ") + peername);
+
+      if ( (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR) )
+         throw SocketDisconnectException(std::string("Recv(): Hard disconnect from ") +
+            peername + ". SysErr: " + System::getErrString() );
+
+      // nothing buffered yet => wait for data
+   }
+
    while (true)
    {
       int epollRes = epoll_wait(epollFD, &epollEvent, 1, timeoutMS);
@@ -32,6 +32,7 @@ class StandardSocket : public PooledSocket
 
       virtual ssize_t recv(void *buf, size_t len, int flags);
       virtual ssize_t recvT(void *buf, size_t len, int flags, int timeoutMS);
+      ssize_t recvPeekNonblocking(void *buf, size_t len);
 
       ssize_t recvfrom(void *buf, size_t len, int flags, struct sockaddr *from, socklen_t *fromlen);
       ssize_t recvfromT(void *buf, size_t len, int flags,
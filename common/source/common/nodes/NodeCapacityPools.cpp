@@ -323,6 +323,28 @@ void NodeCapacityPools::chooseStorageTargetsRoundRobin(unsigned numTargets,
 }
 
 
+
+/**
+ * Choose targets with the "power of two choices" (see
+ * TargetCapacityPools::chooseStorageTargetsLoadAware() ).
+ *
+ * @param targetLoads targets without a value are considered unloaded.
+ */
+void NodeCapacityPools::chooseStorageTargetsLoadAware(unsigned numTargets,
+   unsigned minNumRequiredTargets, const TargetLoadMap& targetLoads, UInt16Vector* outTargets)
+{
+   RWLockGuard lock(rwlock, SafeRWLock_READ);
+
+   for (unsigned poolType = 0; poolType < CapacityPool_END_DONTUSE; poolType++)
+   {
+      TargetCapacityPools::chooseStorageNodesNoPrefLoadAware(pools[poolType],
+         numTargets - outTargets->size(), targetLoads, randGen, outTargets);
+
+      if (outTargets->size() >= minNumRequiredTargets)
+         return;
+   }
+}
+
 /**
  * Note: Unlocked (=> caller must hold read lock)
  *
@@ -26,6 +26,8 @@ class NodeCapacityPools
       void chooseStorageTargets(unsigned numTargets, unsigned minNumRequiredTargets,
          const UInt16List* preferredTargets, UInt16Vector* outTargets);
       void chooseStorageTargetsRoundRobin(unsigned numTargets, UInt16Vector* outTargets);
+      void chooseStorageTargetsLoadAware(unsigned numTargets, unsigned minNumRequiredTargets,
+         const TargetLoadMap& targetLoads, UInt16Vector* outTargets);
 
       bool getPoolAssignment(uint16_t nodeID, CapacityPoolType* outPoolType) const;
 
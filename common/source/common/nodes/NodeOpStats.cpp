@@ -1,5 +1,75 @@
 #include "NodeOpStats.h"
 
+#include <mutex>
+
+
+AtomicUInt64 NodeOpStats::nextInstanceID(1);
+
+__thread uint64_t NodeOpStats::threadTableOwnerID;
+__thread NodeOpStats::CounterTable* NodeOpStats::threadTable;
+
+
+NodeOpStats::NodeOpStats() :
+   instanceID(nextInstanceID.increase() )
+{
+}
+
+/**
+ * Slow path of getThreadCounterTable(): create the counter table of the calling thread.
+ */
+NodeOpStats::CounterTable& NodeOpStats::registerThreadCounterTable()
+{
+   std::lock_guard<Mutex> lock(tablesMutex);
+
+   tables.emplace_back(new CounterTable() );
+
+   threadTable = tables.back().get();
+   threadTableOwnerID = instanceID;
+
+   return *threadTable;
+}
+
+/**
+ * Erase the given node from the maps of all threads.
+ *
+ * @param IP of a node
+ */
+void NodeOpStats::removeClientFromMap(unsigned nodeIP)
+{
+   std::lock_guard<Mutex> lock(tablesMutex);
+
+   for(auto iter = tables.begin(); iter != tables.end(); iter++)
+   {
+      std::lock_guard<Mutex> tableLock( (*iter)->mutex);
+      (*iter)->clientCounterMap.erase(nodeIP);
+   }
+}
+
+/**
+ * Sums up the counters of all per-thread tables.
+ */
+void NodeOpStats::getMergedCounterMap(bool wantPerUserStats, NodeOpCounterMap& outCounterMap)
+{
+   std::lock_guard<Mutex> lock(tablesMutex);
+
+   for(auto tableIter = tables.begin(); tableIter != tables.end(); tableIter++)
+   {
+      CounterTable& table = **tableIter;
+
+      std::lock_guard<Mutex> tableLock(table.mutex);
+
+      NodeOpCounterMap& counterMap =
+         wantPerUserStats ? table.userCounterMap : table.clientCounterMap;
+
+      for(auto mapIter = counterMap.begin(); mapIter != counterMap.end(); mapIter++)
+      {
+         auto insertRes = outCounterMap.insert(*mapIter);
+         if(!insertRes.second)
+            insertRes.first->second.addCounters(mapIter->second);
+      }
+   }
+}
+
 /**
  * @param cookieIP  - If several transfers are required to transfer the map to the client,
  *                    cookieIP is the last IP (in the vector) of the last transfer. We will then
@@ -13,9 +83,11 @@
 bool NodeOpStats::mapToUInt64Vec(uint64_t cookieIP, size_t bufLen, bool wantPerUserStats,
    UInt64Vector *outVec)
 {
-   SafeRWLock safeLock(&lock, SafeRWLock_READ); // L O C K
+   NodeOpCounterMap mergedCounterMap;
 
-   NodeOpCounterMap* counterMap = wantPerUserStats ? &userCounterMap : &clientCounterMap;
+   getMergedCounterMap(wantPerUserStats, mergedCounterMap);
+
+   NodeOpCounterMap* counterMap = &mergedCounterMap;
    NodeOpCounterMapIter mapIter;
 
    // position iter right after given cookieIP (if any)
@@ -32,7 +104,6 @@ bool NodeOpStats::mapToUInt64Vec(uint64_t cookieIP, size_t bufLen, bool wantPerU
 
    if (mapIter == counterMap->end() )
    { // reached end of map => nothing to return in outVec
-      safeLock.unlock(); // U N L O C K
       return true;
    }
 
@@ -78,8 +149,6 @@ bool NodeOpStats::mapToUInt64Vec(uint64_t cookieIP, size_t bufLen, bool wantPerU
    if (mapIter != counterMap->end() )
       outVec->at(NODE_OPS_POS_MORE_DATA) = 1;
 
-   safeLock.unlock(); // L O C K
-
    return true;
 }
 
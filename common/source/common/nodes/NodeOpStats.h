@@ -1,7 +1,7 @@
 #pragma once
 
 #include <common/nodes/OpCounter.h>
-#include <common/threading/SafeRWLock.h>
+#include <common/threading/Mutex.h>
 #include <common/nodes/Node.h>
 
 // layout version ofthe vector transfered to fhgfs-ctl
@@ -57,37 +57,60 @@ typedef NodeOpCounterMap::iterator NodeOpCounterMapIter;
  *
  * This is the common basis of "MetaNodeOpStats" and "StorageNodeOpStats", which provide the method
  * updateNodeOp() to update corresponding metadata and storage operation counters.
+ *
+ * Each thread that updates counters gets its own CounterTable, so that the hot path (called for
+ * nearly every request) only takes the uncontended mutex of its own table. The tables of all
+ * threads are only merged when the stats are requested via mapToUInt64Vec().
  */
 class NodeOpStats
 {
    public:
+      NodeOpStats();
+
+      NodeOpStats(const NodeOpStats&) = delete;
+      NodeOpStats& operator=(const NodeOpStats&) = delete;
+
       bool mapToUInt64Vec(uint64_t cookieIP, size_t bufLen, bool wantPerUserStats,
          UInt64Vector *outVec);
 
+      void removeClientFromMap(unsigned nodeIP);
+
    private:
       int getMaxIPsPerVector(OpCounter *opCounter, size_t bufLen);
       bool reserveVector(OpCounter *opCounter, size_t numIPs, UInt64Vector *outVec);
 
-   protected:
-      NodeOpCounterMap clientCounterMap; // maps IPs to corresponding operation counters
-      NodeOpCounterMap userCounterMap; // maps userIDs to corresponding operation counters
-
-      RWLock lock;
-
-   public:
+      void getMergedCounterMap(bool wantPerUserStats, NodeOpCounterMap& outCounterMap);
 
+   protected:
       /**
-       * Erase the given node from the map
-       *
-       * @param IP of a node
+       * Counters of a single thread.
        */
-      void removeClientFromMap(unsigned nodeIP)
+      struct CounterTable
       {
-         SafeRWLock safeLock(&lock, SafeRWLock_WRITE);
-         clientCounterMap.erase(nodeIP); // erase by key
-         safeLock.unlock();
+         Mutex mutex; // only contended while the tables are merged for a stats request
+         NodeOpCounterMap clientCounterMap; // maps IPs to corresponding operation counters
+         NodeOpCounterMap userCounterMap; // maps userIDs to corresponding operation counters
+      };
+
+      CounterTable& getThreadCounterTable()
+      {
+         if(likely(threadTableOwnerID == instanceID) )
+            return *threadTable;
+
+         return registerThreadCounterTable();
       }
 
-};
+   private:
+      const uint64_t instanceID; // process-wide unique, to detect stale thread-local pointers
 
+      Mutex tablesMutex; // protects tables list (not the tables themselves)
+      std::list<std::unique_ptr<CounterTable>> tables; // kept after their thread terminated
+
+      static AtomicUInt64 nextInstanceID;
+
+      static __thread uint64_t threadTableOwnerID; // instanceID of owner of threadTable
+      static __thread CounterTable* threadTable;
+
+      CounterTable& registerThreadCounterTable();
+};
 
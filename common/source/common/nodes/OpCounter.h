@@ -127,6 +127,15 @@ class OpCounter
          return this->numCounter;
       }
 
+      /**
+       * Add the counter values of another OpCounter (of the same type) to our counters
+       */
+      void addCounters(OpCounter& other)
+      {
+         for(int i = 0; i < std::min(numCounter, other.numCounter); i++)
+            opCounters[i].increase(other.opCounters[i].read() );
+      }
+
       /**
        * Add our counters to an existing vector
        */
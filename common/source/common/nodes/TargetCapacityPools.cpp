@@ -462,6 +462,33 @@ void TargetCapacityPools::chooseStorageTargetsRoundRobin(unsigned numTargets,
       chooseStorageNodesNoPrefRoundRobin(pools[CapacityPool_EMERGENCY], numTargets, outTargets);
 }
 
+/**
+ * Choose targets with the "power of two choices": for each stripe target, two random (not yet
+ * chosen) targets of the pool are compared and the one with the lower load is taken.
+ *
+ * In contrast to always taking the least loaded targets, this doesn't send all new files to the
+ * same targets between two updates of the (inevitably stale) load values, but still keeps busy
+ * targets out of new stripe patterns with high probability.
+ *
+ * Pools are used in the same order as in chooseStorageTargets(); no preferred targets support.
+ *
+ * @param targetLoads targets without a value are considered unloaded.
+ */
+void TargetCapacityPools::chooseStorageTargetsLoadAware(unsigned numTargets,
+   unsigned minNumRequiredTargets, const TargetLoadMap& targetLoads, UInt16Vector* outTargets)
+{
+   RWLockGuard lock(rwlock, SafeRWLock_READ);
+
+   for (unsigned poolType = 0; poolType < CapacityPool_END_DONTUSE; poolType++)
+   {
+      chooseStorageNodesNoPrefLoadAware(pools[poolType], numTargets - outTargets->size(),
+         targetLoads, randGen, outTargets);
+
+      if (outTargets->size() >= minNumRequiredTargets)
+         return;
+   }
+}
+
 /**
  * Select storage targets that are attached to different nodes (different failure domains).
  *
@@ -576,6 +603,54 @@ void TargetCapacityPools::chooseStorageNodesNoPref(const UInt16Set& activeTarget
 
 }
 
+/**
+ * Note: Unlocked (=> caller must hold read lock); static because it is shared with
+ * NodeCapacityPools.
+ *
+ * @param outTargets chosen targets are appended; might contain less than numTargets afterwards if
+ *    not enough targets are known.
+ */
+void TargetCapacityPools::chooseStorageNodesNoPrefLoadAware(const UInt16Set& activeTargets,
+   unsigned numTargets, const TargetLoadMap& targetLoads, RandomReentrant& randGen,
+   UInt16Vector* outTargets)
+{
+   // candidates at index >= numChosen have not been chosen yet
+   UInt16Vector candidates(activeTargets.begin(), activeTargets.end() );
+   const unsigned numCandidates = candidates.size();
+
+   if(numTargets > numCandidates)
+      numTargets = numCandidates;
+
+   outTargets->reserve(outTargets->size() + numTargets);
+
+   for(unsigned numChosen = 0; numChosen < numTargets; numChosen++)
+   {
+      unsigned chosenIndex = randGen.getNextInRange(numChosen, numCandidates - 1);
+
+      if(numCandidates - numChosen > 1)
+      { // compare with a second (different) random candidate
+         unsigned otherIndex = randGen.getNextInRange(numChosen, numCandidates - 2);
+         if(otherIndex >= chosenIndex)
+            otherIndex++;
+
+         TargetLoadMapCIter chosenLoadIter = targetLoads.find(candidates[chosenIndex]);
+         TargetLoadMapCIter otherLoadIter = targetLoads.find(candidates[otherIndex]);
+
+         const uint64_t chosenLoad =
+            (chosenLoadIter == targetLoads.end() ) ? 0 : chosenLoadIter->second;
+         const uint64_t otherLoad =
+            (otherLoadIter == targetLoads.end() ) ? 0 : otherLoadIter->second;
+
+         if(otherLoad < chosenLoad)
+            chosenIndex = otherIndex;
+      }
+
+      std::swap(candidates[numChosen], candidates[chosenIndex]);
+
+      outTargets->push_back(candidates[numChosen]);
+   }
+}
+
 /**
  * Note: Unlocked (=> caller must hold write lock)
  *
@@ -19,6 +19,10 @@ typedef GroupedTargets::iterator GroupedTargetsIter;
 typedef GroupedTargets::const_iterator GroupedTargetsCIter;
 typedef GroupedTargets::value_type GroupedTargetsVal;
 
+typedef std::map<uint16_t, uint64_t> TargetLoadMap; // keys: targetIDs (or buddy group IDs),
+   // values: load of the target in an arbitrary unit (lower is better)
+typedef TargetLoadMap::const_iterator TargetLoadMapCIter;
+
 typedef std::vector<GroupedTargets> GroupedTargetsVector; // CapacityPoolType is index
 typedef GroupedTargetsVector::iterator GroupedTargetsVectorIter;
 typedef GroupedTargetsVector::const_iterator GroupedTargetsVectorConstIter;
@@ -48,6 +52,8 @@ class TargetCapacityPools
       void chooseStorageTargets(unsigned numTargets, unsigned minNumRequiredTargets,
          const UInt16List* preferredTargets, UInt16Vector* outTargets);
       void chooseStorageTargetsRoundRobin(unsigned numTargets, UInt16Vector* outTargets);
+      void chooseStorageTargetsLoadAware(unsigned numTargets, unsigned minNumRequiredTargets,
+         const TargetLoadMap& targetLoads, UInt16Vector* outTargets);
       void chooseTargetsInterdomain(unsigned numTargets, unsigned minNumRequiredTargets,
          UInt16Vector* outTargets);
       void chooseTargetsIntradomain(unsigned numTargets, unsigned minNumRequiredTargets,
@@ -59,6 +65,10 @@ class TargetCapacityPools
 
       static const char* poolTypeToStr(CapacityPoolType poolType);
 
+      static void chooseStorageNodesNoPrefLoadAware(const UInt16Set& activeTargets,
+         unsigned numTargets, const TargetLoadMap& targetLoads, RandomReentrant& randGen,
+         UInt16Vector* outTargets);
+
       template<typename This, typename Ctx>
       static void serialize(This obj, Ctx& ctx)
       {
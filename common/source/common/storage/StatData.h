@@ -406,22 +406,25 @@ class StatData
          }
 
          ctx
-            % obj->creationTimeSecs
-            % obj->settableFileAttribs.lastAccessTimeSecs
-            % obj->settableFileAttribs.modificationTimeSecs
-            % obj->attribChangeTimeSecs;
+            % serdes::fixed(
+                  obj->creationTimeSecs,
+                  obj->settableFileAttribs.lastAccessTimeSecs,
+                  obj->settableFileAttribs.modificationTimeSecs,
+                  obj->attribChangeTimeSecs);
 
          if (!(format & StatDataFormat_Flag_DiskDirInode) )
          {
             ctx
-               % obj->fileSize
-               % obj->nlink
-               % obj->metaVersion;
+               % serdes::fixed(
+                     obj->fileSize,
+                     obj->nlink,
+                     obj->metaVersion);
          }
 
          ctx
-            % obj->settableFileAttribs.userID
-            % obj->settableFileAttribs.groupID;
+            % serdes::fixed(
+                  obj->settableFileAttribs.userID,
+                  obj->settableFileAttribs.groupID);
 
          if (!(format & StatDataFormat_Flag_HasFlags) )
             ctx % obj->settableFileAttribs.mode;
@@ -3,12 +3,14 @@
 #include <common/toolkit/StringTk.h>
 #include "System.h"
 
+#include <fstream>
 #include <mutex>
 
 #include <sys/utsname.h>
 #include <sys/syscall.h>
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <sys/stat.h>
 #include <sys/sysmacros.h>
 #include <sys/types.h>
 #include <pwd.h>
@@ -216,6 +218,85 @@ bool System::bindToNumaNode(int nodeNum)
    return true;
 }
 
+/**
+ * Find the NUMA node of a device in sysfs, i.e. the "numa_node" attribute of the device itself or
+ * of the closest parent device that has one (e.g. the PCI device of an NVMe namespace or a
+ * partition).
+ *
+ * @param sysfsPath a device path or link in sysfs, e.g. /sys/class/net/eth0
+ * @return NUMA node or -1 if unknown (e.g. virtual devices or no NUMA support)
+ */
+int System::getNumaNodeOfSysfsDevice(const std::string& sysfsPath)
+{
+   char* realPath = realpath(sysfsPath.c_str(), NULL);
+   if(!realPath)
+      return -1;
+
+   std::string devPath(realPath);
+   free(realPath);
+
+   for( ; devPath.size() > 1; devPath.erase(devPath.rfind('/') ) )
+   {
+      std::ifstream numaNodeFile(devPath + "/numa_node");
+      int numaNode;
+
+      if(numaNodeFile >> numaNode)
+         return (numaNode >= 0) ? numaNode : -1; // (-1 on systems without NUMA)
+   }
+
+   return -1;
+}
+
+/**
+ * @return NUMA node of the given block device (or of the first device underneath a device mapper
+ * or md device), -1 if unknown
+ */
+int System::getNumaNodeOfBlockDevice(dev_t dev)
+{
+   const std::string sysfsPath = "/sys/dev/block/" + StringTk::uintToStr(major(dev) ) + ":" +
+      StringTk::uintToStr(minor(dev) );
+
+   const int numaNode = getNumaNodeOfSysfsDevice(sysfsPath);
+   if(numaNode >= 0)
+      return numaNode;
+
+   StringList slaves;
+
+   if(StorageTk::pathExists(sysfsPath + "/slaves") )
+      StorageTk::readCompleteDir( (sysfsPath + "/slaves").c_str(), &slaves);
+
+   for(StringListIter iter = slaves.begin(); iter != slaves.end(); iter++)
+   {
+      const int slaveNumaNode = getNumaNodeOfSysfsDevice(sysfsPath + "/slaves/" + *iter);
+      if(slaveNumaNode >= 0)
+         return slaveNumaNode;
+   }
+
+   return -1;
+}
+
+/**
+ * @return NUMA node of the block device that holds the given path, -1 if unknown
+ */
+int System::getNumaNodeOfPath(const std::string& path)
+{
+   struct stat statBuf;
+
+   if(stat(path.c_str(), &statBuf) )
+      return -1;
+
+   return getNumaNodeOfBlockDevice(statBuf.st_dev);
+}
+
+/**
+ * @param devName network interface name, e.g. "eth0"
+ * @return NUMA node of the network device, -1 if unknown (e.g. loopback or virtual devices)
+ */
+int System::getNumaNodeOfNetDevice(const std::string& devName)
+{
+   return getNumaNodeOfSysfsDevice("/sys/class/net/" + devName);
+}
+
 /**
  * @return linux thread ID (this is not the POSIX thread ID!)
  */
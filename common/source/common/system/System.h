@@ -21,6 +21,10 @@ class System
       static int getNumNumaNodes();
       static int getNumaCoresByNode(int nodeNum, cpu_set_t* outCpuSet);
       static bool bindToNumaNode(int nodeNum);
+      static int getNumaNodeOfSysfsDevice(const std::string& sysfsPath);
+      static int getNumaNodeOfBlockDevice(dev_t dev);
+      static int getNumaNodeOfPath(const std::string& path);
+      static int getNumaNodeOfNetDevice(const std::string& devName);
       static pid_t getTID();
       static bool incProcessFDLimit(uint64_t newLimit, uint64_t* outOldLimit);
       static void getMemoryInfo(uint64_t *memTotal, uint64_t *memFree, uint64_t *memCached,
@@ -0,0 +1,75 @@
+#include <common/system/System.h>
+#include "ShardedRWLock.h"
+
+
+ShardedRWLock::ShardedRWLock(unsigned numShards) :
+   numShards(numShards ? numShards :
+      std::min(std::max(System::getNumOnlineCPUs(), 1), SHARDEDRWLOCK_MAX_SHARDS) ),
+   shards(new Shard[this->numShards]),
+   writeLocked(false)
+{
+}
+
+/**
+ * @throw RWLockException
+ */
+void ShardedRWLock::readLock()
+{
+   getThreadShard().readLock();
+}
+
+bool ShardedRWLock::tryReadLock()
+{
+   return getThreadShard().tryReadLock();
+}
+
+/**
+ * @throw RWLockException
+ */
+void ShardedRWLock::writeLock()
+{
+   for (unsigned i = 0; i < numShards; i++)
+      shards[i].lock.writeLock();
+
+   writeLocked.store(true, std::memory_order_relaxed);
+}
+
+bool ShardedRWLock::tryWriteLock()
+{
+   for (unsigned i = 0; i < numShards; i++)
+   {
+      if (shards[i].lock.tryWriteLock() )
+         continue;
+
+      while (i--)
+         shards[i].lock.unlock();
+
+      return false;
+   }
+
+   writeLocked.store(true, std::memory_order_relaxed);
+   return true;
+}
+
+void ShardedRWLock::unlock()
+{
+   if (!writeLocked.load(std::memory_order_relaxed) )
+   {
+      getThreadShard().unlock();
+      return;
+   }
+
+   writeLocked.store(false, std::memory_order_relaxed);
+
+   for (unsigned i = numShards; i > 0; i--)
+      shards[i - 1].lock.unlock();
+}
+
+unsigned ShardedRWLock::getThreadShardIndex()
+{
+   static std::atomic<unsigned> nextShardIndex(0);
+   static thread_local unsigned shardIndex = nextShardIndex.fetch_add(1,
+      std::memory_order_relaxed);
+
+   return shardIndex;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <common/threading/RWLock.h>
+#include <common/threading/UniqueRWLock.h>
+#include <common/Common.h>
+
+#include <atomic>
+#include <memory>
+
+
+#define SHARDEDRWLOCK_MAX_SHARDS    64
+#define SHARDEDRWLOCK_CACHELINE     64
+
+
+/**
+ * Distributed reader-writer lock for locks that are taken for reading by (almost) every operation
+ * and only rarely for writing.
+ *
+ * The lock consists of one RWLock per shard, each on its own cache line. Readers only lock the
+ * shard of the calling thread, so concurrent readers on different cores don't bounce the same
+ * cache line. Writers lock all shards (always in the same order, so writers can't deadlock each
+ * other), which makes writeLock() more expensive than for a plain RWLock.
+ *
+ * Each thread is assigned a fixed shard on its first use of any ShardedRWLock (round robin), so
+ * the unlock of a read lock finds the same shard. Consequently, a read lock must be released by
+ * the thread that acquired it.
+ *
+ * Each shard is a writer-preferring RWLock, so recursive read locking has the same deadlock
+ * potential as for RWLock.
+ */
+class ShardedRWLock
+{
+   public:
+      /**
+       * @param numShards 0 for one shard per online CPU (up to SHARDEDRWLOCK_MAX_SHARDS).
+       */
+      explicit ShardedRWLock(unsigned numShards = 0);
+
+      ShardedRWLock(ShardedRWLock&&) = delete;
+      ShardedRWLock(const ShardedRWLock&) = delete;
+      ShardedRWLock& operator=(ShardedRWLock&&) = delete;
+      ShardedRWLock& operator=(const ShardedRWLock&) = delete;
+
+      void readLock();
+      bool tryReadLock();
+      void writeLock();
+      bool tryWriteLock();
+      void unlock();
+
+
+   private:
+      struct alignas(SHARDEDRWLOCK_CACHELINE) Shard
+      {
+         RWLock lock;
+      };
+
+      const unsigned numShards;
+      std::unique_ptr<Shard[]> shards;
+
+      // true while a writer holds all shards. readers can't hold a shard at that time, so
+      // unlock() uses this to tell a write unlock from a read unlock.
+      std::atomic<bool> writeLocked;
+
+      static unsigned getThreadShardIndex();
+
+      RWLock& getThreadShard()
+      {
+         return shards[getThreadShardIndex() % numShards].lock;
+      }
+
+   public:
+      // getters & setters
+      unsigned getNumShards() const
+      {
+         return numShards;
+      }
+};
+
+typedef BasicUniqueRWLock<ShardedRWLock> UniqueShardedRWLock;
@@ -3,15 +3,19 @@
 #include <common/threading/RWLock.h>
 #include <common/threading/SafeRWLock.h>
 
-class UniqueRWLock
+/**
+ * Movable scoped lock for RWLock and lock types with the same interface (e.g. ShardedRWLock).
+ */
+template<typename RWLockT>
+class BasicUniqueRWLock
 {
    public:
-      UniqueRWLock()
+      BasicUniqueRWLock()
          : rwlock(nullptr), locked(false)
       { }
 
 
-      UniqueRWLock(RWLock& lock, SafeRWLockType type)
+      BasicUniqueRWLock(RWLockT& lock, SafeRWLockType type)
          : rwlock(&lock), locked(true)
       {
          if (type == SafeRWLock_READ)
@@ -20,26 +24,26 @@ class UniqueRWLock
             lock.writeLock();
       }
 
-      ~UniqueRWLock()
+      ~BasicUniqueRWLock()
       {
          if (locked)
             rwlock->unlock();
       }
 
-      UniqueRWLock(UniqueRWLock&& old)
+      BasicUniqueRWLock(BasicUniqueRWLock&& old)
          : rwlock(nullptr), locked(false)
       {
          swap(old);
       }
 
-      UniqueRWLock& operator=(UniqueRWLock&& other)
+      BasicUniqueRWLock& operator=(BasicUniqueRWLock&& other)
       {
-         UniqueRWLock(std::move(other)).swap(*this);
+         BasicUniqueRWLock(std::move(other)).swap(*this);
          return *this;
       }
 
-      UniqueRWLock(const UniqueRWLock&) = delete;
-      UniqueRWLock& operator=(const UniqueRWLock&) = delete;
+      BasicUniqueRWLock(const BasicUniqueRWLock&) = delete;
+      BasicUniqueRWLock& operator=(const BasicUniqueRWLock&) = delete;
 
       void unlock()
       {
@@ -57,18 +61,21 @@ class UniqueRWLock
          locked = true;
       }
 
-      void swap(UniqueRWLock& other)
+      void swap(BasicUniqueRWLock& other)
       {
          std::swap(rwlock, other.rwlock);
          std::swap(locked, other.locked);
       }
 
    private:
-      RWLock* rwlock;
+      RWLockT* rwlock;
       bool locked;
 };
 
-inline void swap(UniqueRWLock& a, UniqueRWLock& b)
+typedef BasicUniqueRWLock<RWLock> UniqueRWLock;
+
+template<typename RWLockT>
+inline void swap(BasicUniqueRWLock<RWLockT>& a, BasicUniqueRWLock<RWLockT>& b)
 {
    a.swap(b);
 }
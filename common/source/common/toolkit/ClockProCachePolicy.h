@@ -0,0 +1,238 @@
+#pragma once
+
+#include <common/Common.h>
+
+#include <atomic>
+#include <list>
+#include <unordered_map>
+
+
+#define CLOCKPROCACHEPOLICY_DEFAULT_HOT_PERCENT    50
+
+
+struct CachePolicyStats
+{
+   uint64_t numHits;
+   uint64_t numMisses;
+   uint64_t numEvictions;
+   size_t numEntries;
+   size_t numHotEntries;
+};
+
+/**
+ * Eviction policy for reference caches (the caches only hold the keys of cached entries here, the
+ * values stay in the caches' own maps), based on CLOCK-Pro, but limited to resident entries (no
+ * non-resident "test" entries).
+ *
+ * All entries are kept in a single clock ring. New entries are inserted as cold entries right
+ * behind the clock hand, so that they are the last ones to be checked. Cached entries are marked
+ * as referenced on each access (touch()). To find a victim, the hand moves over the ring:
+ *  - cold & unreferenced: evicted.
+ *  - cold & referenced: if this is the first time the hand finds it referenced, it only gets a
+ *    second chance (test period); if it was referenced again during a whole clock period after
+ *    that, it becomes hot (if the hot share of the cache is not exhausted yet).
+ *  - hot & referenced: reference bit is cleared.
+ *  - hot & unreferenced: demoted to cold.
+ *
+ * Thus, entries that are only accessed in a short burst after insertion (like the directories
+ * of a big "find" or rsync sweep) never become hot and are evicted before the hot working set.
+ *
+ * Thread-safety: touch() and getStats() may be called concurrently with each other (e.g. under a
+ * read lock of the cache), all other methods require exclusive access (e.g. a write lock).
+ */
+template<typename KeyT>
+class ClockProCachePolicy
+{
+   public:
+      /**
+       * @param hotPercent max percentage of hot entries.
+       */
+      explicit ClockProCachePolicy(unsigned hotPercent = CLOCKPROCACHEPOLICY_DEFAULT_HOT_PERCENT) :
+         hotPercent(hotPercent), hand(ring.end() ), numHot(0), numHits(0), numMisses(0),
+         numEvictions(0)
+      {}
+
+      ClockProCachePolicy(const ClockProCachePolicy&) = delete;
+      ClockProCachePolicy& operator=(const ClockProCachePolicy&) = delete;
+
+      /**
+       * Mark an entry as referenced and count the access as hit or miss.
+       *
+       * @return true if key is in the cache.
+       */
+      bool touch(const KeyT& key)
+      {
+         auto iter = index.find(key);
+         if (iter == index.end() )
+         {
+            numMisses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+         }
+
+         // (avoid dirtying the cache line if the entry is referenced already)
+         if (!iter->second->referenced.load(std::memory_order_relaxed) )
+            iter->second->referenced.store(true, std::memory_order_relaxed);
+
+         numHits.fetch_add(1, std::memory_order_relaxed);
+         return true;
+      }
+
+      /**
+       * Add a new cold entry.
+       *
+       * @return false if key was in the cache already.
+       */
+      bool insert(const KeyT& key)
+      {
+         if (index.count(key) )
+            return false;
+
+         // insert behind the hand (before it in list order), i.e. the hand reaches it last
+         auto entryIter = ring.emplace(hand, key);
+         index.emplace(key, entryIter);
+
+         return true;
+      }
+
+      /**
+       * @return false if key was not in the cache.
+       */
+      bool remove(const KeyT& key)
+      {
+         auto iter = index.find(key);
+         if (iter == index.end() )
+            return false;
+
+         eraseEntry(iter->second);
+         index.erase(iter);
+
+         return true;
+      }
+
+      /**
+       * Select the next victim and remove it from the policy.
+       *
+       * @param outKey key of the evicted entry, which the caller must remove from its cache.
+       * @return false if the cache is empty.
+       */
+      bool evict(KeyT& outKey)
+      {
+         if (ring.empty() )
+            return false;
+
+         // each entry is at most: unreferenced (hot => cold), tested, promoted/evicted. so this
+         // loop terminates after a few rounds at most.
+         for ( ; ; )
+         {
+            if (hand == ring.end() )
+               hand = ring.begin();
+
+            Entry& entry = *hand;
+            const bool referenced = entry.referenced.load(std::memory_order_relaxed);
+
+            entry.referenced.store(false, std::memory_order_relaxed);
+
+            if (entry.isHot)
+            {
+               if (!referenced)
+               {
+                  entry.isHot = false;
+                  entry.inTest = false;
+                  numHot--;
+               }
+            }
+            else
+            if (referenced)
+            {
+               if (entry.inTest && (numHot < getMaxHot() ) )
+               { // re-referenced within its test period => promote to hot
+                  entry.isHot = true;
+                  numHot++;
+               }
+               else
+                  entry.inTest = true;
+            }
+            else
+            { // cold and not referenced since the hand passed last time => victim
+               outKey = entry.key;
+
+               index.erase(entry.key);
+               hand = ring.erase(hand);
+
+               numEvictions++;
+               return true;
+            }
+
+            ++hand;
+         }
+      }
+
+      void clear()
+      {
+         index.clear();
+         ring.clear();
+         hand = ring.end();
+         numHot = 0;
+      }
+
+      size_t size() const
+      {
+         return index.size();
+      }
+
+      CachePolicyStats getStats() const
+      {
+         CachePolicyStats stats;
+
+         stats.numHits = numHits.load(std::memory_order_relaxed);
+         stats.numMisses = numMisses.load(std::memory_order_relaxed);
+         stats.numEvictions = numEvictions;
+         stats.numEntries = index.size();
+         stats.numHotEntries = numHot;
+
+         return stats;
+      }
+
+
+   private:
+      struct Entry
+      {
+         explicit Entry(const KeyT& key) : key(key), isHot(false), inTest(false), referenced(false)
+         {}
+
+         KeyT key;
+         bool isHot;
+         bool inTest; // cold entry that was found referenced by the hand once
+         std::atomic<bool> referenced;
+      };
+
+      typedef std::list<Entry> EntryList;
+      typedef typename EntryList::iterator EntryListIter;
+
+      const unsigned hotPercent;
+
+      EntryList ring;
+      std::unordered_map<KeyT, EntryListIter> index;
+      EntryListIter hand;
+      size_t numHot;
+
+      std::atomic<uint64_t> numHits;
+      std::atomic<uint64_t> numMisses;
+      uint64_t numEvictions;
+
+      size_t getMaxHot() const
+      {
+         return std::max<size_t>(ring.size() * hotPercent / 100, 1);
+      }
+
+      void eraseEntry(EntryListIter entryIter)
+      {
+         if (entryIter->isHot)
+            numHot--;
+
+         if (hand == entryIter)
+            hand = ring.erase(entryIter);
+         else
+            ring.erase(entryIter);
+      }
+};
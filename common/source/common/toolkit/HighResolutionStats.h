@@ -33,14 +33,15 @@ struct HighResolutionStats
    static void serialize(This obj, Ctx& ctx)
    {
       ctx
-         % obj->rawVals.statsTimeMS
-         % obj->rawVals.busyWorkers
-         % obj->rawVals.queuedRequests
-         % obj->incVals.diskWriteBytes
-         % obj->incVals.diskReadBytes
-         % obj->incVals.netSendBytes
-         % obj->incVals.netRecvBytes
-         % obj->incVals.workRequests;
+         % serdes::fixed(
+               obj->rawVals.statsTimeMS,
+               obj->rawVals.busyWorkers,
+               obj->rawVals.queuedRequests,
+               obj->incVals.diskWriteBytes,
+               obj->incVals.diskReadBytes,
+               obj->incVals.netSendBytes,
+               obj->incVals.netRecvBytes,
+               obj->incVals.workRequests);
    }
 };
 
@@ -53,6 +54,9 @@ typedef HighResStatsList::reverse_iterator HighResStatsListRevIter;
 
 typedef std::vector<HighResolutionStats> HighResStatsVec;
 
+typedef std::map<uint16_t, HighResolutionStats> TargetHighResStatsMap; // keys: targetIDs
+typedef TargetHighResStatsMap::const_iterator TargetHighResStatsMapCIter;
+
 
 class HighResolutionStatsTk
 {
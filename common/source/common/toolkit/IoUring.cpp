@@ -0,0 +1,264 @@
+#include "IoUring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#if __has_include(<linux/io_uring.h>)
+   #include <linux/io_uring.h>
+   #define IOURING_SUPPORTED
+#endif
+
+
+IoUring::IoUring() :
+   ringFD(-1), features(0), sqRingPtr(MAP_FAILED), sqRingSize(0), cqRingPtr(MAP_FAILED),
+   cqRingSize(0), sqes( (struct io_uring_sqe*)MAP_FAILED), sqesSize(0), sqEntries(0),
+   numUnsubmitted(0)
+{
+}
+
+IoUring::~IoUring()
+{
+   uninit();
+}
+
+void IoUring::uninit()
+{
+   if( (void*)sqes != MAP_FAILED)
+      munmap(sqes, sqesSize);
+
+   if( (cqRingPtr != MAP_FAILED) && (cqRingPtr != sqRingPtr) )
+      munmap(cqRingPtr, cqRingSize);
+
+   if(sqRingPtr != MAP_FAILED)
+      munmap(sqRingPtr, sqRingSize);
+
+   if(ringFD != -1)
+      close(ringFD); // (also cancels all pending requests)
+
+   ringFD = -1;
+   sqRingPtr = MAP_FAILED;
+   cqRingPtr = MAP_FAILED;
+   sqes = (struct io_uring_sqe*)MAP_FAILED;
+   sqEntries = 0;
+   numUnsubmitted = 0;
+}
+
+#ifdef IOURING_SUPPORTED
+
+/**
+ * Set up the ring and map its queues.
+ *
+ * @param numEntries min size of the submission ring (the kernel rounds up to a power of two and
+ *    makes the completion ring twice as big).
+ * @return false if io_uring is not supported by the kernel (or not allowed, e.g. by seccomp);
+ *    errno is set in this case.
+ */
+bool IoUring::init(unsigned numEntries)
+{
+   struct io_uring_params params;
+   memset(&params, 0, sizeof(params) );
+
+   ringFD = syscall(__NR_io_uring_setup, numEntries, &params);
+   if(ringFD == -1)
+      return false;
+
+   features = params.features;
+
+   sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+   cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+   if(params.features & IORING_FEAT_SINGLE_MMAP)
+      sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+   sqRingPtr = mmap(NULL, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+      ringFD, IORING_OFF_SQ_RING);
+   if(sqRingPtr == MAP_FAILED)
+      goto err_uninit;
+
+   if(params.features & IORING_FEAT_SINGLE_MMAP)
+      cqRingPtr = sqRingPtr;
+   else
+   {
+      cqRingPtr = mmap(NULL, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+         ringFD, IORING_OFF_CQ_RING);
+      if(cqRingPtr == MAP_FAILED)
+         goto err_uninit;
+   }
+
+   sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+   sqes = (struct io_uring_sqe*)mmap(NULL, sqesSize, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_SQES);
+   if( (void*)sqes == MAP_FAILED)
+      goto err_uninit;
+
+   {
+      char* sqRing = (char*)sqRingPtr;
+      char* cqRing = (char*)cqRingPtr;
+
+      sqHead = (unsigned*)(sqRing + params.sq_off.head);
+      sqTail = (unsigned*)(sqRing + params.sq_off.tail);
+      sqMask = *(unsigned*)(sqRing + params.sq_off.ring_mask);
+      sqEntries = params.sq_entries;
+      sqArray = (unsigned*)(sqRing + params.sq_off.array);
+
+      cqHead = (unsigned*)(cqRing + params.cq_off.head);
+      cqTail = (unsigned*)(cqRing + params.cq_off.tail);
+      cqMask = *(unsigned*)(cqRing + params.cq_off.ring_mask);
+      cqes = (struct io_uring_cqe*)(cqRing + params.cq_off.cqes);
+   }
+
+   return true;
+
+err_uninit:
+   int savedErrno = errno;
+
+   uninit();
+
+   errno = savedErrno;
+   return false;
+}
+
+/**
+ * @return next free sqe (zeroed) or NULL on error (errno is set); if the sq ring is full, the
+ *    queued requests are submitted to make room. The sqe must be queued with queueSqe() before the
+ *    next call.
+ */
+struct io_uring_sqe* IoUring::getFreeSqe()
+{
+   if(numUnsubmitted == sqEntries)
+   {
+      int enterRes = submitAndWait(0, 0);
+      if(enterRes < 0)
+      {
+         errno = -enterRes;
+         return NULL;
+      }
+   }
+
+   unsigned tail = __atomic_load_n(sqTail, __ATOMIC_RELAXED);
+   struct io_uring_sqe* sqe = &sqes[tail & sqMask];
+
+   memset(sqe, 0, sizeof(*sqe) );
+
+   return sqe;
+}
+
+/**
+ * Queue the sqe returned by the last getFreeSqe().
+ */
+void IoUring::queueSqe()
+{
+   unsigned tail = __atomic_load_n(sqTail, __ATOMIC_RELAXED);
+
+   sqArray[tail & sqMask] = tail & sqMask;
+
+   __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+   numUnsubmitted++;
+}
+
+/**
+ * Submit all queued requests and wait for completions, all in a single syscall.
+ *
+ * @param minComplete number of completions to wait for (0 to only submit).
+ * @param timeoutMS max wait time for minComplete > 0 (requires IORING_FEAT_EXT_ARG, linux 5.11);
+ *    <= 0 to wait without a timeout.
+ * @return 0 on success or timeout, negative errno on error (e.g. -EINTR).
+ */
+int IoUring::submitAndWait(unsigned minComplete, int timeoutMS)
+{
+   struct __kernel_timespec timeout;
+   struct io_uring_getevents_arg eventsArg;
+   unsigned flags = 0;
+   void* arg = NULL;
+   size_t argSize = 0;
+
+   if(minComplete)
+   {
+      flags |= IORING_ENTER_GETEVENTS;
+
+      if(timeoutMS > 0)
+      {
+         memset(&eventsArg, 0, sizeof(eventsArg) );
+
+         timeout.tv_sec = timeoutMS / 1000;
+         timeout.tv_nsec = (timeoutMS % 1000) * 1000000;
+         eventsArg.ts = (uint64_t)(uintptr_t)&timeout;
+
+         flags |= IORING_ENTER_EXT_ARG;
+         arg = &eventsArg;
+         argSize = sizeof(eventsArg);
+      }
+   }
+
+   int enterRes = syscall(__NR_io_uring_enter, ringFD, numUnsubmitted, minComplete, flags,
+      arg, argSize);
+
+   if(enterRes < 0)
+      return (errno == ETIME) ? 0 : -errno;
+
+   // (the kernel consumes all sqes without SQPOLL, unless it fails to allocate a request)
+   numUnsubmitted -= std::min( (unsigned)enterRes, numUnsubmitted);
+
+   return 0;
+}
+
+bool IoUring::hasCompletions() const
+{
+   return __atomic_load_n(cqTail, __ATOMIC_ACQUIRE) != __atomic_load_n(cqHead, __ATOMIC_RELAXED);
+}
+
+/**
+ * @return false if there are no more completions available.
+ */
+bool IoUring::popCompletion(uint64_t& outUserData, int& outRes)
+{
+   unsigned head = __atomic_load_n(cqHead, __ATOMIC_RELAXED);
+
+   if(head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE) )
+      return false;
+
+   struct io_uring_cqe* cqe = &cqes[head & cqMask];
+
+   outUserData = cqe->user_data;
+   outRes = cqe->res;
+
+   __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+
+   return true;
+}
+
+#else // IOURING_SUPPORTED
+
+bool IoUring::init(unsigned numEntries)
+{
+   errno = ENOSYS;
+   return false;
+}
+
+struct io_uring_sqe* IoUring::getFreeSqe()
+{
+   errno = ENOSYS;
+   return NULL;
+}
+
+void IoUring::queueSqe()
+{
+}
+
+int IoUring::submitAndWait(unsigned minComplete, int timeoutMS)
+{
+   return -ENOSYS;
+}
+
+bool IoUring::hasCompletions() const
+{
+   return false;
+}
+
+bool IoUring::popCompletion(uint64_t& outUserData, int& outRes)
+{
+   return false;
+}
+
+#endif // IOURING_SUPPORTED
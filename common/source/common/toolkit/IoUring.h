@@ -0,0 +1,87 @@
+#pragma once
+
+#include <common/Common.h>
+
+
+struct io_uring_sqe; // forward declaration
+struct io_uring_cqe; // forward declaration
+
+
+/**
+ * Minimal io_uring submission/completion ring (raw syscalls, no liburing), shared by the users of
+ * io_uring (e.g. IoUringPoll, StorageBenchIoUring). Users fill the sqes themselves, so they need
+ * <linux/io_uring.h>; see IOURING_SUPPORTED.
+ *
+ * Requests are queued in the shared submission ring and handed to the kernel together with the
+ * next submitAndWait() (or when the submission ring is full), completions are read from the
+ * shared completion ring.
+ *
+ * Note: Not thread-safe, intended to be owned by a single thread.
+ */
+class IoUring
+{
+   public:
+      IoUring();
+      ~IoUring();
+
+      IoUring(const IoUring&) = delete;
+      IoUring& operator=(const IoUring&) = delete;
+
+      bool init(unsigned numEntries);
+
+      struct io_uring_sqe* getFreeSqe();
+      void queueSqe();
+
+      int submitAndWait(unsigned minComplete, int timeoutMS);
+      bool hasCompletions() const;
+      bool popCompletion(uint64_t& outUserData, int& outRes);
+
+
+   private:
+      int ringFD;
+      unsigned features; // IORING_FEAT_... of the kernel
+
+      void* sqRingPtr;
+      size_t sqRingSize;
+      void* cqRingPtr;
+      size_t cqRingSize;
+      struct io_uring_sqe* sqes;
+      size_t sqesSize;
+
+      unsigned* sqHead;
+      unsigned* sqTail;
+      unsigned sqMask;
+      unsigned sqEntries;
+      unsigned* sqArray;
+
+      unsigned* cqHead;
+      unsigned* cqTail;
+      unsigned cqMask;
+      struct io_uring_cqe* cqes;
+
+      unsigned numUnsubmitted; // queued in sq ring, but not yet handed to the kernel
+
+      void uninit();
+
+
+   public:
+      // getters & setters
+
+      unsigned getFeatures() const
+      {
+         return features;
+      }
+
+      /**
+       * @return size of the submission ring (the kernel rounds up to a power of two).
+       */
+      unsigned getNumEntries() const
+      {
+         return sqEntries;
+      }
+
+      unsigned getNumUnsubmitted() const
+      {
+         return numUnsubmitted;
+      }
+};
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <common/Common.h>
+#include <common/toolkit/serialization/Serialization.h>
+
+#include <atomic>
+#include <cmath>
+
+
+/**
+ * Plain (non-atomic) copy of a LatencyHistogram, used for aggregation, serialization and
+ * percentile computation.
+ *
+ * Buckets are log-linear (HDR-style): values below LATENCYHISTOGRAM_SUBBUCKETS map 1:1 to their
+ * bucket, larger values are split into LATENCYHISTOGRAM_SUBBUCKETS linear sub-buckets per power
+ * of two, so the relative error of any reported value is below 1/LATENCYHISTOGRAM_SUBBUCKETS.
+ */
+#define LATENCYHISTOGRAM_SUBBUCKET_BITS   3
+#define LATENCYHISTOGRAM_SUBBUCKETS       (1u << LATENCYHISTOGRAM_SUBBUCKET_BITS)
+#define LATENCYHISTOGRAM_MAX_MAGNITUDE    35 // 2^36us (~19h), larger values go to the last bucket
+#define LATENCYHISTOGRAM_NUM_BUCKETS \
+   ( (LATENCYHISTOGRAM_MAX_MAGNITUDE - LATENCYHISTOGRAM_SUBBUCKET_BITS + 2) * \
+      LATENCYHISTOGRAM_SUBBUCKETS)
+
+
+struct LatencyHistogramData
+{
+   std::vector<uint64_t> buckets; // trailing empty buckets are not stored
+   uint64_t count = 0;
+   uint64_t sumMicro = 0;
+   uint64_t maxMicro = 0; // max since server start (not affected by subtract() )
+
+   template<typename This, typename Ctx>
+   static void serialize(This obj, Ctx& ctx)
+   {
+      ctx
+         % obj->buckets
+         % obj->count
+         % obj->sumMicro
+         % obj->maxMicro;
+   }
+
+   /**
+    * @param quantile e.g. 0.99 for the 99th percentile
+    * @return upper bound of the bucket that contains the given quantile (in microseconds); 0 if
+    *    the histogram is empty.
+    */
+   uint64_t percentileMicro(double quantile) const
+   {
+      if(!count)
+         return 0;
+
+      uint64_t rank = (uint64_t)std::ceil(quantile * count);
+      rank = std::max<uint64_t>(rank, 1);
+
+      uint64_t seen = 0;
+
+      for(size_t i = 0; i < buckets.size(); i++)
+      {
+         seen += buckets[i];
+
+         if(seen >= rank)
+         {
+            uint64_t upper = bucketUpperBound(i);
+            return (maxMicro && upper > maxMicro) ? maxMicro : upper;
+         }
+      }
+
+      return maxMicro;
+   }
+
+   uint64_t meanMicro() const
+   {
+      return count ? sumMicro / count : 0;
+   }
+
+   void add(const LatencyHistogramData& other)
+   {
+      if(buckets.size() < other.buckets.size() )
+         buckets.resize(other.buckets.size(), 0);
+
+      for(size_t i = 0; i < other.buckets.size(); i++)
+         buckets[i] += other.buckets[i];
+
+      count += other.count;
+      sumMicro += other.sumMicro;
+      maxMicro = std::max(maxMicro, other.maxMicro);
+   }
+
+   /**
+    * Turns this cumulative histogram into the delta since an older snapshot of the same
+    * (monotonically growing) histogram.
+    */
+   void subtract(const LatencyHistogramData& older)
+   {
+      for(size_t i = 0; i < std::min(buckets.size(), older.buckets.size() ); i++)
+         buckets[i] -= std::min(buckets[i], older.buckets[i]);
+
+      count -= std::min(count, older.count);
+      sumMicro -= std::min(sumMicro, older.sumMicro);
+   }
+
+   static unsigned bucketIndex(uint64_t micro)
+   {
+      if(micro < LATENCYHISTOGRAM_SUBBUCKETS)
+         return micro;
+
+      unsigned magnitude = 63 - __builtin_clzll(micro);
+
+      if(magnitude > LATENCYHISTOGRAM_MAX_MAGNITUDE)
+         return LATENCYHISTOGRAM_NUM_BUCKETS - 1;
+
+      unsigned shift = magnitude - LATENCYHISTOGRAM_SUBBUCKET_BITS;
+
+      return (shift + 1) * LATENCYHISTOGRAM_SUBBUCKETS +
+         ( (micro >> shift) & (LATENCYHISTOGRAM_SUBBUCKETS - 1) );
+   }
+
+   static uint64_t bucketLowerBound(unsigned index)
+   {
+      if(index < LATENCYHISTOGRAM_SUBBUCKETS)
+         return index;
+
+      unsigned shift = index / LATENCYHISTOGRAM_SUBBUCKETS - 1;
+
+      return (uint64_t)(LATENCYHISTOGRAM_SUBBUCKETS + index % LATENCYHISTOGRAM_SUBBUCKETS)
+         << shift;
+   }
+
+   static uint64_t bucketUpperBound(unsigned index)
+   {
+      if(index < LATENCYHISTOGRAM_SUBBUCKETS)
+         return index;
+
+      unsigned shift = index / LATENCYHISTOGRAM_SUBBUCKETS - 1;
+
+      return bucketLowerBound(index) + (1ull << shift) - 1;
+   }
+};
+
+typedef std::map<uint16_t, LatencyHistogramData> LatencyHistogramDataMap; // key: msg type
+
+
+/**
+ * Lock-free latency histogram with a single writer.
+ *
+ * The owning thread records values with relaxed atomic increments (so there is no shared cache
+ * line between workers), other threads may take a snapshot() at any time. Values are never reset;
+ * consumers compute deltas between snapshots (see LatencyHistogramData::subtract() ).
+ */
+class LatencyHistogram
+{
+   public:
+      LatencyHistogram() : count(0), sumMicro(0), maxMicro(0)
+      {
+         for(unsigned i = 0; i < LATENCYHISTOGRAM_NUM_BUCKETS; i++)
+            buckets[i].store(0, std::memory_order_relaxed);
+      }
+
+      LatencyHistogram(const LatencyHistogram&) = delete;
+      LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+
+   private:
+      std::atomic<uint64_t> buckets[LATENCYHISTOGRAM_NUM_BUCKETS];
+      std::atomic<uint64_t> count;
+      std::atomic<uint64_t> sumMicro;
+      std::atomic<uint64_t> maxMicro;
+
+
+   public:
+      /**
+       * Note: Only to be called by the owning thread.
+       */
+      void record(uint64_t micro)
+      {
+         unsigned index = LatencyHistogramData::bucketIndex(micro);
+
+         // single writer => load+store instead of (more expensive) read-modify-write ops
+         buckets[index].store(buckets[index].load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+         sumMicro.store(sumMicro.load(std::memory_order_relaxed) + micro,
+            std::memory_order_relaxed);
+
+         if(micro > maxMicro.load(std::memory_order_relaxed) )
+            maxMicro.store(micro, std::memory_order_relaxed);
+
+         count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+      }
+
+      void snapshot(LatencyHistogramData& outData) const
+      {
+         outData.count = count.load(std::memory_order_acquire);
+         outData.sumMicro = sumMicro.load(std::memory_order_relaxed);
+         outData.maxMicro = maxMicro.load(std::memory_order_relaxed);
+
+         outData.buckets.assign(LATENCYHISTOGRAM_NUM_BUCKETS, 0);
+
+         size_t usedLen = 0;
+
+         for(unsigned i = 0; i < LATENCYHISTOGRAM_NUM_BUCKETS; i++)
+         {
+            outData.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+            if(outData.buckets[i])
+               usedLen = i + 1;
+         }
+
+         outData.buckets.resize(usedLen);
+      }
+};
@@ -16,6 +16,11 @@
 // performance critical, and the overhead of a 2k allocation is small enough to ignore it.
 #define MSGBUF_SMALL_SIZE 2048
 
+// max bytes of a batch that are sent before their responses are received (to make sure that the
+// requests and responses in flight fit into the socket buffers, otherwise both sides could block
+// in send() )
+#define MSGBATCH_MAX_SEND_SIZE   (64*1024)
+
 bool MessagingTk::requestResponse(RequestResponseArgs* rrArgs)
 {
    FhgfsOpsErr commRes = requestResponseComm(rrArgs);
@@ -470,6 +475,140 @@ err_cleanup:
    return retVal;
 }
 
+/**
+ * Sends multiple request messages to a node over a single connection and receives the responses
+ * (pipelining). The requests are sent in chunks of up to MSGBATCH_MAX_SEND_SIZE bytes with a single
+ * send() call per chunk; the responses of a chunk are received before the next chunk is sent. The
+ * receiver processes the msgs of a connection one after another, so responses arrive in request
+ * order.
+ *
+ * Note: Only intended for msgs without sendExtraData and with small responses.
+ *
+ * @param rrArgsBatch .node must be NULL, it is set to the given node while communicating (and
+ *    reset to NULL before returning).
+ * @param outResults result per request, see requestResponseComm(); requests that did not get a
+ *    response due to a communication error are set to FhgfsOpsErr_COMMUNICATION.
+ */
+void MessagingTk::requestResponseCommBatch(const Node& node, RequestResponseArgs** rrArgsBatch,
+   size_t batchSize, FhgfsOpsErr* outResults)
+{
+   const char* logContext = "Messaging (RPC batch)";
+
+   NodeConnPool* connPool = node.getConnPool();
+   auto netMessageFactory = PThread::getCurrentThreadApp()->getNetMessageFactory();
+
+   // cleanup init
+   Socket* sock = NULL;
+
+   for(size_t i = 0; i < batchSize; i++)
+   {
+      BEEGFS_BUG_ON_DEBUG(rrArgsBatch[i]->node, "rrArgs->node was not NULL");
+
+      rrArgsBatch[i]->node = &node; // (e.g. for handleGenericResponse() )
+      outResults[i] = FhgfsOpsErr_COMMUNICATION;
+   }
+
+   try
+   {
+      size_t numSent = 0;
+      size_t numReceived = 0;
+
+      while(numReceived < batchSize)
+      {
+         // send the next chunk of requests (at least one)
+
+         std::vector<char> sendBuf;
+
+         while(numSent < batchSize)
+         {
+            const auto msgBuf = createMsgVec(*rrArgsBatch[numSent]->requestMsg);
+
+            if(!sendBuf.empty() && (sendBuf.size() + msgBuf.size() > MSGBATCH_MAX_SEND_SIZE) )
+               break;
+
+            sendBuf.insert(sendBuf.end(), msgBuf.begin(), msgBuf.end() );
+            numSent++;
+         }
+
+         if(!sock)
+            sock = connPool->acquireStreamSocket();
+
+         sock->send(&sendBuf[0], sendBuf.size(), 0);
+
+         // receive responses of this chunk
+
+         for( ; numReceived < numSent; numReceived++)
+         {
+            RequestResponseArgs* rrArgs = rrArgsBatch[numReceived];
+
+            auto respBuf = MessagingTk::recvMsgBuf(*sock, rrArgs->minTimeoutMS);
+            if (respBuf.empty())
+            { // error (e.g. message too big)
+               LogContext(logContext).log(Log_WARNING,
+                  "Failed to receive response from: " + node.getNodeIDWithTypeStr() + "; " +
+                  sock->getPeername() + ". " +
+                  "(Message type: " + rrArgs->requestMsg->getMsgTypeStr() + ")");
+
+               goto err_cleanup;
+            }
+
+            rrArgs->outRespMsg = netMessageFactory->createFromBuf(std::move(respBuf));
+
+            if(unlikely(rrArgs->outRespMsg->getMsgType() == NETMSGTYPE_GenericResponse) )
+            { // special control msg received
+               outResults[numReceived] = handleGenericResponse(rrArgs);
+               if(outResults[numReceived] == FhgfsOpsErr_INTERNAL)
+                  goto err_cleanup; // can't re-use the connection
+
+               continue;
+            }
+
+            if(unlikely(rrArgs->outRespMsg->getMsgType() != rrArgs->respMsgType) )
+            { // response invalid (wrong msgType)
+               LogContext(logContext).logErr(
+                  "Received invalid response type: " + rrArgs->outRespMsg->getMsgTypeStr() + "; "
+                  "expected: " + netMessageTypeToStr(rrArgs->respMsgType) + ". "
+                  "Disconnecting: " + node.getNodeIDWithTypeStr() + " @ " +
+                  sock->getPeername() );
+
+               goto err_cleanup;
+            }
+
+            outResults[numReceived] = FhgfsOpsErr_SUCCESS;
+         }
+      }
+
+      // got all responses
+
+      connPool->releaseStreamSocket(sock);
+      sock = NULL;
+   }
+   catch (const std::bad_alloc& e)
+   {
+      LOG(COMMUNICATION, ERR, "Memory allocation for send buffer failed.");
+   }
+   catch(SocketConnectException& e)
+   {
+      LOG(GENERAL, WARNING, "Unable to connect, is the node offline?",
+            ("node", node.getNodeIDWithTypeStr()), ("Batch size", batchSize));
+   }
+   catch(SocketException& e)
+   {
+      LogContext(logContext).logErr("Communication error: " + std::string(e.what() ) + "; " +
+         "Peer: " + node.getNodeIDWithTypeStr() + ". "
+         "(Batch size: " + StringTk::uintToStr(batchSize) + ")");
+   }
+
+
+err_cleanup:
+
+   if(sock)
+      connPool->invalidateStreamSocket(sock);
+
+   for(size_t i = 0; i < batchSize; i++)
+      rrArgsBatch[i]->node = NULL;
+}
+
 std::vector<char> MessagingTk::createMsgVec(NetMessage& msg)
 {
    std::vector<char> result(MSGBUF_SMALL_SIZE);
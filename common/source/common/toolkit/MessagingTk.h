@@ -26,6 +26,8 @@ class MessagingTk
          RequestResponseArgs* rrArgs);
       static FhgfsOpsErr requestResponseTarget(RequestResponseTarget* rrTarget,
          RequestResponseArgs* rrArgs);
+      static void requestResponseCommBatch(const Node& node, RequestResponseArgs** rrArgsBatch,
+         size_t batchSize, FhgfsOpsErr* outResults);
 
       static std::vector<char> recvMsgBuf(Socket& socket, int minTimeout = 0);
       static std::vector<char> createMsgVec(NetMessage& msg);
@@ -0,0 +1,419 @@
+#include "ReedSolomon.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+   #include <immintrin.h>
+   #define REEDSOLOMON_HAVE_X86_KERNELS
+#endif
+
+
+#define REEDSOLOMON_GF_POLY      0x11d // x^8 + x^4 + x^3 + x^2 + 1
+#define REEDSOLOMON_TABLES_SIZE  32 // nibble tables per coefficient (16 low + 16 high)
+#define REEDSOLOMON_BLOCK_SIZE   (8*1024) // region size per pass over all sources (cache blocking)
+
+
+namespace {
+
+struct GFTables
+{
+   uint8_t exp[2 * 255];
+   uint8_t log[256];
+
+   GFTables()
+   {
+      unsigned value = 1;
+
+      for(unsigned i = 0; i < 255; i++)
+      {
+         exp[i] = value;
+         exp[i + 255] = value;
+         log[value] = i;
+
+         value <<= 1;
+         if(value & 0x100)
+            value ^= REEDSOLOMON_GF_POLY;
+      }
+
+      log[0] = 0; // undefined, never used
+   }
+};
+
+const GFTables& gfTables()
+{
+   static const GFTables tables;
+   return tables;
+}
+
+inline uint8_t gfMul(uint8_t a, uint8_t b)
+{
+   if(!a || !b)
+      return 0;
+
+   const GFTables& gf = gfTables();
+   return gf.exp[gf.log[a] + gf.log[b] ];
+}
+
+inline uint8_t gfInv(uint8_t a)
+{
+   const GFTables& gf = gfTables();
+   return gf.exp[255 - gf.log[a] ];
+}
+
+/**
+ * dst = coeff * src (or dst ^= coeff * src if accumulate is set), coeff given as nibble tables.
+ */
+void regionScalar(const uint8_t* tables, const uint8_t* src, uint8_t* dst, size_t len,
+   bool accumulate)
+{
+   const uint8_t* lowTable = tables;
+   const uint8_t* highTable = tables + 16;
+
+   for(size_t i = 0; i < len; i++)
+   {
+      const uint8_t product = lowTable[src[i] & 0x0f] ^ highTable[src[i] >> 4];
+      dst[i] = accumulate ? (dst[i] ^ product) : product;
+   }
+}
+
+#ifdef REEDSOLOMON_HAVE_X86_KERNELS
+
+__attribute__((target("ssse3")))
+void regionSSSE3(const uint8_t* tables, const uint8_t* src, uint8_t* dst, size_t len,
+   bool accumulate)
+{
+   const __m128i lowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables) );
+   const __m128i highTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 16) );
+   const __m128i mask = _mm_set1_epi8(0x0f);
+
+   size_t i = 0;
+
+   for( ; i + 16 <= len; i += 16)
+   {
+      const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i) );
+
+      __m128i product = _mm_xor_si128(
+         _mm_shuffle_epi8(lowTable, _mm_and_si128(in, mask) ),
+         _mm_shuffle_epi8(highTable, _mm_and_si128(_mm_srli_epi64(in, 4), mask) ) );
+
+      if(accumulate)
+         product = _mm_xor_si128(product,
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i) ) );
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), product);
+   }
+
+   regionScalar(tables, src + i, dst + i, len - i, accumulate);
+}
+
+__attribute__((target("avx2")))
+void regionAVX2(const uint8_t* tables, const uint8_t* src, uint8_t* dst, size_t len,
+   bool accumulate)
+{
+   const __m256i lowTable = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables) ) );
+   const __m256i highTable = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 16) ) );
+   const __m256i mask = _mm256_set1_epi8(0x0f);
+
+   size_t i = 0;
+
+   for( ; i + 32 <= len; i += 32)
+   {
+      const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i) );
+
+      __m256i product = _mm256_xor_si256(
+         _mm256_shuffle_epi8(lowTable, _mm256_and_si256(in, mask) ),
+         _mm256_shuffle_epi8(highTable, _mm256_and_si256(_mm256_srli_epi64(in, 4), mask) ) );
+
+      if(accumulate)
+         product = _mm256_xor_si256(product,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i) ) );
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), product);
+   }
+
+   regionScalar(tables, src + i, dst + i, len - i, accumulate);
+}
+
+#endif // REEDSOLOMON_HAVE_X86_KERNELS
+
+}
+
+
+/**
+ * @param kernel the region kernel to use; falls back to the best supported kernel if the CPU
+ *    doesn't support the given one.
+ * @throw std::invalid_argument if numData is 0 or there are more than REEDSOLOMON_MAX_SHARDS shards
+ */
+ReedSolomon::ReedSolomon(unsigned numData, unsigned numParity, ReedSolomonKernel kernel) :
+   numData(numData), numParity(numParity)
+{
+   if(!numData || (numData + numParity > REEDSOLOMON_MAX_SHARDS) )
+      throw std::invalid_argument("Invalid number of Reed-Solomon shards: " +
+         std::to_string(numData) + "+" + std::to_string(numParity) );
+
+   if( (kernel == ReedSolomonKernel_AUTO) || !isKernelSupported(kernel) )
+   {
+      if(isKernelSupported(ReedSolomonKernel_AVX2) )
+         kernel = ReedSolomonKernel_AVX2;
+      else
+      if(isKernelSupported(ReedSolomonKernel_SSSE3) )
+         kernel = ReedSolomonKernel_SSSE3;
+      else
+         kernel = ReedSolomonKernel_SCALAR;
+   }
+
+   this->kernel = kernel;
+
+   switch(kernel)
+   {
+#ifdef REEDSOLOMON_HAVE_X86_KERNELS
+      case ReedSolomonKernel_AVX2: regionKernel = regionAVX2; break;
+      case ReedSolomonKernel_SSSE3: regionKernel = regionSSSE3; break;
+#endif
+      default: regionKernel = regionScalar; break;
+   }
+
+   // Cauchy matrix: parityMatrix[p][d] = 1 / (x_p + y_d) with x_p = numData + p and y_d = d (all
+   // distinct, so the sum is never 0)
+
+   parityMatrix.resize(numParity * numData);
+   parityTables.resize(numParity * numData * REEDSOLOMON_TABLES_SIZE);
+
+   for(unsigned p = 0; p < numParity; p++)
+   {
+      for(unsigned d = 0; d < numData; d++)
+      {
+         const uint8_t coeff = gfInv( (numData + p) ^ d);
+
+         parityMatrix[p * numData + d] = coeff;
+         makeTables(coeff, &parityTables[(p * numData + d) * REEDSOLOMON_TABLES_SIZE]);
+      }
+   }
+}
+
+/**
+ * @param data numData buffers of len bytes
+ * @param parity numParity buffers of len bytes, will be overwritten
+ */
+void ReedSolomon::encode(const char* const* data, char* const* parity, size_t len) const
+{
+   const uint8_t* const* srcs = reinterpret_cast<const uint8_t* const*>(data);
+
+   for(unsigned p = 0; p < numParity; p++)
+      combine(&parityTables[p * numData * REEDSOLOMON_TABLES_SIZE], srcs, numData,
+         reinterpret_cast<uint8_t*>(parity[p]), len);
+}
+
+/**
+ * Reconstruct all missing shards from (any) numData present shards.
+ *
+ * @param shards numData + numParity buffers of len bytes (data shards first); missing shards will
+ *    be overwritten. Missing shards may be NULL if they are not needed; missing parity shards are
+ *    only reconstructed if no data shard is NULL.
+ * @param shardPresent numData + numParity flags, false for missing shards
+ * @return false if fewer than numData shards are present
+ */
+bool ReedSolomon::reconstruct(char* const* shards, const bool* shardPresent, size_t len) const
+{
+   const unsigned numShards = numData + numParity;
+
+   std::vector<unsigned> srcIndices; // first numData present shards
+   bool dataMissing = false;
+
+   for(unsigned i = 0; i < numShards && srcIndices.size() < numData; i++)
+   {
+      if(shardPresent[i])
+         srcIndices.push_back(i);
+      else
+      if(i < numData)
+         dataMissing = true;
+   }
+
+   if(srcIndices.size() < numData)
+      return false;
+
+   if(dataMissing)
+   {
+      // the rows of the encoding matrix for the source shards map data to source shards, so the
+      // inverse maps source shards to data
+
+      std::vector<uint8_t> matrix(numData * numData, 0);
+      std::vector<const uint8_t*> srcs(numData);
+
+      for(unsigned row = 0; row < numData; row++)
+      {
+         const unsigned shard = srcIndices[row];
+
+         if(shard < numData)
+            matrix[row * numData + shard] = 1;
+         else
+            std::copy_n(&parityMatrix[(shard - numData) * numData], numData,
+               &matrix[row * numData]);
+
+         srcs[row] = reinterpret_cast<const uint8_t*>(shards[shard]);
+      }
+
+      if(!invertMatrix(matrix, numData) )
+         return false; // can't happen for a Cauchy matrix
+
+      std::vector<uint8_t> tables(numData * REEDSOLOMON_TABLES_SIZE);
+
+      for(unsigned d = 0; d < numData; d++)
+      {
+         if(shardPresent[d] || !shards[d])
+            continue;
+
+         for(unsigned col = 0; col < numData; col++)
+            makeTables(matrix[d * numData + col], &tables[col * REEDSOLOMON_TABLES_SIZE]);
+
+         combine(tables.data(), srcs.data(), numData, reinterpret_cast<uint8_t*>(shards[d]), len);
+      }
+   }
+
+   // all data is there now => missing parity is just encoded again
+
+   const uint8_t* const* data = reinterpret_cast<const uint8_t* const*>(shards);
+
+   if(std::find(data, data + numData, nullptr) != data + numData)
+      return true;
+
+   for(unsigned p = 0; p < numParity; p++)
+   {
+      if(!shardPresent[numData + p] && shards[numData + p])
+         combine(&parityTables[p * numData * REEDSOLOMON_TABLES_SIZE], data, numData,
+            reinterpret_cast<uint8_t*>(shards[numData + p]), len);
+   }
+
+   return true;
+}
+
+bool ReedSolomon::isKernelSupported(ReedSolomonKernel kernel)
+{
+   switch(kernel)
+   {
+      case ReedSolomonKernel_AUTO:
+      case ReedSolomonKernel_SCALAR:
+         return true;
+
+#ifdef REEDSOLOMON_HAVE_X86_KERNELS
+      case ReedSolomonKernel_SSSE3:
+         return __builtin_cpu_supports("ssse3");
+
+      case ReedSolomonKernel_AVX2:
+         return __builtin_cpu_supports("avx2");
+#endif
+
+      default:
+         return false;
+   }
+}
+
+const char* ReedSolomon::getKernelName(ReedSolomonKernel kernel)
+{
+   switch(kernel)
+   {
+      case ReedSolomonKernel_AUTO: return "auto";
+      case ReedSolomonKernel_SCALAR: return "scalar";
+      case ReedSolomonKernel_SSSE3: return "ssse3";
+      case ReedSolomonKernel_AVX2: return "avx2";
+   }
+
+   return "<unknown>";
+}
+
+/**
+ * dst = sum of coeff[i] * srcs[i], processed in blocks so that dst stays in the cache.
+ *
+ * @param tables nibble tables of the numSrcs coefficients
+ */
+void ReedSolomon::combine(const uint8_t* tables, const uint8_t* const* srcs, unsigned numSrcs,
+   uint8_t* dst, size_t len) const
+{
+   for(size_t blockStart = 0; blockStart < len; blockStart += REEDSOLOMON_BLOCK_SIZE)
+   {
+      const size_t blockLen = std::min<size_t>(REEDSOLOMON_BLOCK_SIZE, len - blockStart);
+
+      for(unsigned i = 0; i < numSrcs; i++)
+         regionKernel(tables + i * REEDSOLOMON_TABLES_SIZE, srcs[i] + blockStart,
+            dst + blockStart, blockLen, i != 0);
+   }
+}
+
+/**
+ * Gauss-Jordan elimination over GF(2^8).
+ *
+ * @param matrix size x size, will be replaced by its inverse
+ * @return false if the matrix is singular
+ */
+bool ReedSolomon::invertMatrix(std::vector<uint8_t>& matrix, unsigned size) const
+{
+   std::vector<uint8_t> inverse(size * size, 0);
+
+   for(unsigned i = 0; i < size; i++)
+      inverse[i * size + i] = 1;
+
+   for(unsigned col = 0; col < size; col++)
+   {
+      // find a pivot row and swap it into place
+
+      unsigned pivot = col;
+
+      while(pivot < size && !matrix[pivot * size + col])
+         pivot++;
+
+      if(pivot == size)
+         return false;
+
+      if(pivot != col)
+      {
+         std::swap_ranges(&matrix[pivot * size], &matrix[pivot * size] + size, &matrix[col * size]);
+         std::swap_ranges(&inverse[pivot * size], &inverse[pivot * size] + size,
+            &inverse[col * size]);
+      }
+
+      // scale pivot row to 1
+
+      const uint8_t scale = gfInv(matrix[col * size + col]);
+
+      for(unsigned j = 0; j < size; j++)
+      {
+         matrix[col * size + j] = gfMul(matrix[col * size + j], scale);
+         inverse[col * size + j] = gfMul(inverse[col * size + j], scale);
+      }
+
+      // eliminate the column from all other rows
+
+      for(unsigned row = 0; row < size; row++)
+      {
+         const uint8_t factor = matrix[row * size + col];
+
+         if(row == col || !factor)
+            continue;
+
+         for(unsigned j = 0; j < size; j++)
+         {
+            matrix[row * size + j] ^= gfMul(factor, matrix[col * size + j]);
+            inverse[row * size + j] ^= gfMul(factor, inverse[col * size + j]);
+         }
+      }
+   }
+
+   matrix.swap(inverse);
+   return true;
+}
+
+/**
+ * @param outTables REEDSOLOMON_TABLES_SIZE bytes: coeff * x for the low nibbles x, followed by
+ *    coeff * (x << 4) for the high nibbles
+ */
+void ReedSolomon::makeTables(uint8_t coeff, uint8_t* outTables)
+{
+   for(unsigned x = 0; x < 16; x++)
+   {
+      outTables[x] = gfMul(coeff, x);
+      outTables[16 + x] = gfMul(coeff, x << 4);
+   }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <common/Common.h>
+
+#include <vector>
+
+
+#define REEDSOLOMON_MAX_SHARDS   256 // data + parity shards, limited by the field size GF(2^8)
+
+
+enum ReedSolomonKernel
+{
+   ReedSolomonKernel_AUTO, // best kernel supported by the CPU
+   ReedSolomonKernel_SCALAR,
+   ReedSolomonKernel_SSSE3,
+   ReedSolomonKernel_AVX2,
+};
+
+/**
+ * Systematic Reed-Solomon erasure code over GF(2^8) with numData data shards and numParity parity
+ * shards: any numData of the numData + numParity shards suffice to reconstruct all others.
+ *
+ * The parity rows of the encoding matrix form a Cauchy matrix, so every square submatrix of the
+ * (identity + Cauchy) encoding matrix is invertible.
+ *
+ * The region kernels multiply a buffer by a constant with two 16-entry lookup tables (for the low
+ * and high nibble of each byte), which maps to a single byte shuffle instruction per 16 (SSSE3) or
+ * 32 (AVX2) bytes. The kernel is selected at runtime; there is a scalar fallback for other CPUs.
+ */
+class ReedSolomon
+{
+   public:
+      ReedSolomon(unsigned numData, unsigned numParity,
+         ReedSolomonKernel kernel = ReedSolomonKernel_AUTO);
+
+      void encode(const char* const* data, char* const* parity, size_t len) const;
+      bool reconstruct(char* const* shards, const bool* shardPresent, size_t len) const;
+
+      static bool isKernelSupported(ReedSolomonKernel kernel);
+      static const char* getKernelName(ReedSolomonKernel kernel);
+
+
+   private:
+      typedef void (*RegionKernel)(const uint8_t* tables, const uint8_t* src, uint8_t* dst,
+         size_t len, bool accumulate);
+
+      unsigned numData;
+      unsigned numParity;
+      ReedSolomonKernel kernel;
+      RegionKernel regionKernel;
+
+      std::vector<uint8_t> parityMatrix; // numParity x numData coefficients
+      std::vector<uint8_t> parityTables; // nibble tables of parityMatrix (32 bytes per coeff)
+
+      void combine(const uint8_t* tables, const uint8_t* const* srcs, unsigned numSrcs,
+         uint8_t* dst, size_t len) const;
+      bool invertMatrix(std::vector<uint8_t>& matrix, unsigned size) const;
+
+      static void makeTables(uint8_t coeff, uint8_t* outTables);
+
+
+   public:
+      // getters & setters
+
+      unsigned getNumData() const
+      {
+         return numData;
+      }
+
+      unsigned getNumParity() const
+      {
+         return numParity;
+      }
+
+      ReedSolomonKernel getKernel() const
+      {
+         return kernel;
+      }
+};
@@ -0,0 +1,157 @@
+#include "IoUringPoll.h"
+
+#include <poll.h>
+
+#if __has_include(<linux/io_uring.h>)
+   #include <linux/io_uring.h>
+   #define IOURINGPOLL_SUPPORTED
+#endif
+
+
+#ifdef IOURINGPOLL_SUPPORTED
+
+/**
+ * @param numEntries size of the submission ring (the completion ring is twice as big and the
+ *    kernel buffers overflowing completions, so this doesn't limit the number of armed polls).
+ * @return false if io_uring is not supported by the kernel (or not allowed, e.g. by seccomp) or
+ *    lacks required features; errno is set in this case.
+ */
+bool IoUringPoll::init(unsigned numEntries)
+{
+   if(!ring.init(numEntries) )
+      return false;
+
+   // NODROP: completions don't get lost if the cq ring is full (linux 5.5)
+   // EXT_ARG: io_uring_enter() takes a timeout (linux 5.11)
+   if(!(ring.getFeatures() & IORING_FEAT_NODROP) || !(ring.getFeatures() & IORING_FEAT_EXT_ARG) )
+   {
+      errno = ENOTSUP;
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Queue a one-shot POLLIN request for fd. The completion result is the returned poll event mask
+ * (or a negative errno, e.g. -ECANCELED after cancelPoll() ).
+ *
+ * Note: The request only reaches the kernel with the next submitAndWait(), so the fd must stay
+ * open until then.
+ *
+ * @param userData anything but IOURINGPOLL_CANCEL_USERDATA
+ * @return false on error (errno is set)
+ */
+bool IoUringPoll::armPoll(int fd, uint64_t userData)
+{
+   if(unlikely(userData == IOURINGPOLL_CANCEL_USERDATA) )
+   {
+      errno = EINVAL;
+      return false;
+   }
+
+   struct io_uring_sqe* sqe = ring.getFreeSqe();
+   if(!sqe)
+      return false;
+
+   sqe->opcode = IORING_OP_POLL_ADD;
+   sqe->fd = fd;
+   sqe->poll32_events = POLLIN;
+   sqe->user_data = userData;
+
+   ring.queueSqe();
+
+   return true;
+}
+
+/**
+ * Queue cancellation of a pending poll request. The canceled request completes with -ECANCELED
+ * (unless it completed before).
+ *
+ * Note: Requests are processed in queue order, so a poll for the same userData that is armed
+ * after this call is not affected.
+ *
+ * Note: The completion of the cancel request itself is not returned by popCompletion(), so the
+ * canceled poll is the only completion with this userData.
+ *
+ * @return false on error (errno is set)
+ */
+bool IoUringPoll::cancelPoll(uint64_t userData)
+{
+   struct io_uring_sqe* sqe = ring.getFreeSqe();
+   if(!sqe)
+      return false;
+
+   sqe->opcode = IORING_OP_POLL_REMOVE;
+   sqe->fd = -1;
+   sqe->addr = userData;
+   sqe->user_data = IOURINGPOLL_CANCEL_USERDATA;
+
+   ring.queueSqe();
+
+   return true;
+}
+
+/**
+ * Submit all queued requests and wait for at least one completion, all in a single syscall.
+ *
+ * @param timeoutMS 0 to only submit (no syscall at all if there is nothing to submit).
+ * @return 0 on success or timeout, negative errno on error (e.g. -EINTR).
+ */
+int IoUringPoll::submitAndWait(int timeoutMS)
+{
+   unsigned minComplete = (timeoutMS && !ring.hasCompletions() ) ? 1 : 0;
+
+   if(!ring.getNumUnsubmitted() && !minComplete)
+      return 0;
+
+   return ring.submitAndWait(minComplete, timeoutMS);
+}
+
+/**
+ * Get the next poll completion (completions of cancel requests are skipped).
+ *
+ * @return false if there are no more completions available.
+ */
+bool IoUringPoll::popCompletion(uint64_t& outUserData, int& outRes)
+{
+   while(ring.popCompletion(outUserData, outRes) )
+   {
+      if(likely(outUserData != IOURINGPOLL_CANCEL_USERDATA) )
+         return true;
+   }
+
+   return false;
+}
+
+#else // IOURINGPOLL_SUPPORTED
+
+bool IoUringPoll::init(unsigned numEntries)
+{
+   errno = ENOSYS;
+   return false;
+}
+
+bool IoUringPoll::armPoll(int fd, uint64_t userData)
+{
+   errno = ENOSYS;
+   return false;
+}
+
+bool IoUringPoll::cancelPoll(uint64_t userData)
+{
+   errno = ENOSYS;
+   return false;
+}
+
+int IoUringPoll::submitAndWait(int timeoutMS)
+{
+   return -ENOSYS;
+}
+
+bool IoUringPoll::popCompletion(uint64_t& outUserData, int& outRes)
+{
+   return false;
+}
+
+#endif // IOURINGPOLL_SUPPORTED
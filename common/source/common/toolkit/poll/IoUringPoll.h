@@ -0,0 +1,42 @@
+#pragma once
+
+#include <common/toolkit/IoUring.h>
+#include <common/Common.h>
+
+
+// userData of cancel requests; their completions are dropped, so it can't be used for polls
+#define IOURINGPOLL_CANCEL_USERDATA    (~0ULL)
+
+
+/**
+ * One-shot readability polls of many file descriptors on an IoUring.
+ *
+ * In contrast to an epoll set, (re-)arming a poll doesn't cost a syscall: requests are queued in
+ * the shared submission ring and handed to the kernel together with the next wait, and
+ * completions are read from the shared completion ring.
+ *
+ * The userData of a poll request is returned with its completion and can be used to cancel it.
+ * Only poll requests produce completions for the caller (see IOURINGPOLL_CANCEL_USERDATA).
+ *
+ * Note: Not thread-safe, intended to be owned by a single thread.
+ */
+class IoUringPoll
+{
+   public:
+      IoUringPoll() {}
+
+      IoUringPoll(const IoUringPoll&) = delete;
+      IoUringPoll& operator=(const IoUringPoll&) = delete;
+
+      bool init(unsigned numEntries);
+
+      bool armPoll(int fd, uint64_t userData);
+      bool cancelPoll(uint64_t userData);
+
+      int submitAndWait(int timeoutMS);
+      bool popCompletion(uint64_t& outUserData, int& outRes);
+
+
+   private:
+      IoUring ring;
+};
@@ -12,6 +12,10 @@
 #include <boost/type_traits/is_same.hpp>
 #include <boost/utility/enable_if.hpp>
 
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 #define SERIALIZATION_NICLISTELEM_NAME_SIZE  (16)
 #define SERIALIZATION_CHUNKINFOLISTELEM_ID_SIZE (96)
 #define SERIALIZATION_CHUNKINFOLISTELEM_PATHSTR_SIZE (255)
@@ -133,6 +137,30 @@ class Serializer
          this->bufferOffset += length;
       }
 
+      /**
+       * Reserve a block at the current position with a single bounds check, so that the caller can
+       * fill it in (see serdes::fixed() ).
+       *
+       * @return NULL if the block doesn't fit into the buffer (this serializer is bad then) or if
+       *    this serializer only computes the size.
+       */
+      char* reserveBlock(size_t length)
+      {
+         char* result = NULL;
+
+         if(this->buffer
+            && likely(
+                  this->bufferOffset + length >= this->bufferOffset
+                  && this->bufferOffset + length <= this->bufferSize) )
+            result = this->buffer + this->bufferOffset;
+         else
+            this->bufferSize = 0;
+
+         this->bufferOffset += length;
+
+         return result;
+      }
+
       void skip(unsigned size)
       {
          while(size > 0)
@@ -353,6 +381,26 @@ class Deserializer
          this->bufferOffset += length;
       }
 
+      /**
+       * Consume a block at the current position with a single bounds check (see serdes::fixed() ).
+       *
+       * @return NULL if the buffer is too short (this deserializer is bad then).
+       */
+      const char* takeBlock(size_t length)
+      {
+         const char* result = NULL;
+
+         if(likely(this->bufferOffset + length >= this->bufferOffset
+               && this->bufferOffset + length <= this->bufferSize) )
+            result = this->buffer + this->bufferOffset;
+         else
+            setBad();
+
+         this->bufferOffset += length;
+
+         return result;
+      }
+
       template<typename Value>
       typename boost::enable_if_c<
             IsSerdesPrimitive<Value>::value,
@@ -869,6 +917,136 @@ inline RawBlockDes rawBlock(const char*& block, uint32_t& size)
 
 
 
+/**
+ * Little-endian load/store of single primitives at a given position (for FixedRun). The wire
+ * format is the same as with Serializer/Deserializer::operator%.
+ */
+struct FixedLE
+{
+   static void put(char* pos, bool value) { *pos = value ? 1 : 0; }
+   static void put(char* pos, char value) { *pos = value; }
+   static void put(char* pos, uint8_t value) { *pos = value; }
+   static void put(char* pos, int16_t value) { put(pos, uint16_t(value) ); }
+   static void put(char* pos, int32_t value) { put(pos, uint32_t(value) ); }
+   static void put(char* pos, int64_t value) { put(pos, uint64_t(value) ); }
+
+   static void put(char* pos, uint16_t value)
+   {
+      value = HOST_TO_LE_16(value);
+      std::memcpy(pos, &value, sizeof(value) );
+   }
+
+   static void put(char* pos, uint32_t value)
+   {
+      value = HOST_TO_LE_32(value);
+      std::memcpy(pos, &value, sizeof(value) );
+   }
+
+   static void put(char* pos, uint64_t value)
+   {
+      value = HOST_TO_LE_64(value);
+      std::memcpy(pos, &value, sizeof(value) );
+   }
+
+   static void get(const char* pos, bool& value) { value = *pos != 0; }
+   static void get(const char* pos, char& value) { value = *pos; }
+   static void get(const char* pos, uint8_t& value) { value = uint8_t(*pos); }
+
+   static void get(const char* pos, uint16_t& value)
+   {
+      std::memcpy(&value, pos, sizeof(value) );
+      value = LE_TO_HOST_16(value);
+   }
+
+   static void get(const char* pos, uint32_t& value)
+   {
+      std::memcpy(&value, pos, sizeof(value) );
+      value = LE_TO_HOST_32(value);
+   }
+
+   static void get(const char* pos, uint64_t& value)
+   {
+      std::memcpy(&value, pos, sizeof(value) );
+      value = LE_TO_HOST_64(value);
+   }
+
+   template<typename Signed>
+   static typename boost::enable_if_c<std::is_signed<Signed>::value
+         && !boost::is_same<Signed, char>::value>::type
+      get(const char* pos, Signed& value)
+   {
+      typename std::make_unsigned<Signed>::type raw;
+
+      get(pos, raw);
+      std::memcpy(&value, &raw, sizeof(value) );
+   }
+};
+
+/**
+ * A run of consecutive fixed-size primitive fields, which is (de)serialized with a single bounds
+ * check for the whole run. The size and the offsets of the run are known at compile time, so on
+ * little-endian hosts the compiler turns this into plain loads and stores (instead of a bounds
+ * check and an offset update per field). The wire format is identical to that of the single
+ * fields.
+ */
+template<typename... Fields>
+struct FixedRun
+{
+   static_assert(sizeof(bool) == 1, "bool is one byte on the wire");
+   static_assert( (IsSerdesPrimitive<Fields>::value && ...),
+      "only fixed-size primitives can be part of a fixed run");
+
+   static constexpr size_t wireSize = (sizeof(Fields) + ...);
+
+   std::tuple<Fields&...> fields;
+
+   FixedRun(Fields&... fields) : fields(fields...) {}
+
+   friend Serializer& operator%(Serializer& ser, const FixedRun& run)
+   {
+      char* pos = ser.reserveBlock(wireSize);
+      if(likely(pos) )
+         run.putAll(pos, std::index_sequence_for<Fields...>() );
+
+      return ser;
+   }
+
+   friend Deserializer& operator%(Deserializer& des, const FixedRun& run)
+   {
+      const char* pos = des.takeBlock(wireSize);
+      if(likely(pos) )
+         run.getAll(pos, std::index_sequence_for<Fields...>() );
+
+      return des;
+   }
+
+   private:
+      template<size_t... Idx>
+      void putAll(char* pos, std::index_sequence<Idx...>) const
+      {
+         ( (FixedLE::put(pos, std::get<Idx>(fields) ), pos += sizeof(Fields) ), ...);
+      }
+
+      template<size_t... Idx>
+      void getAll(const char* pos, std::index_sequence<Idx...>) const
+      {
+         ( (FixedLE::get(pos, std::get<Idx>(fields) ), pos += sizeof(Fields) ), ...);
+      }
+};
+
+/**
+ * (De)serialize consecutive fixed-size primitive fields as one block, e.g.
+ * "ctx % serdes::fixed(obj->size, obj->mtime, obj->atime)" instead of
+ * "ctx % obj->size % obj->mtime % obj->atime".
+ */
+template<typename... Fields>
+inline FixedRun<Fields...> fixed(Fields&... fields)
+{
+   return FixedRun<Fields...>(fields...);
+}
+
+
+
 template<typename Value, typename As>
 struct AtomicAsSer
 {
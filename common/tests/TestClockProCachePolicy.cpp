@@ -0,0 +1,138 @@
+#include <common/toolkit/ClockProCachePolicy.h>
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+
+typedef ClockProCachePolicy<unsigned> Policy;
+
+/**
+ * Simulates a reference cache with the given capacity: every access touches the key and inserts
+ * it on a miss (after evicting one entry if the cache is full).
+ */
+static void access(Policy& policy, unsigned key, size_t capacity)
+{
+   if (policy.touch(key) )
+      return;
+
+   unsigned victim;
+
+   if (policy.size() >= capacity)
+   {
+      ASSERT_TRUE(policy.evict(victim) );
+   }
+
+   policy.insert(key);
+}
+
+TEST(ClockProCachePolicy, evictsUnreferencedFirst)
+{
+   Policy policy;
+
+   for (unsigned key = 0; key < 4; key++)
+      policy.insert(key);
+
+   policy.touch(0);
+   policy.touch(2);
+
+   std::set<unsigned> victims;
+   unsigned victim;
+
+   ASSERT_TRUE(policy.evict(victim) );
+   victims.insert(victim);
+   ASSERT_TRUE(policy.evict(victim) );
+   victims.insert(victim);
+
+   ASSERT_EQ(victims, std::set<unsigned>({1, 3}) );
+   ASSERT_EQ(policy.size(), 2u);
+}
+
+TEST(ClockProCachePolicy, removeAndClear)
+{
+   Policy policy;
+   unsigned victim;
+
+   ASSERT_FALSE(policy.evict(victim) );
+
+   policy.insert(1);
+   policy.insert(2);
+
+   ASSERT_FALSE(policy.insert(1) );
+   ASSERT_TRUE(policy.remove(1) );
+   ASSERT_FALSE(policy.remove(1) );
+
+   ASSERT_TRUE(policy.evict(victim) );
+   ASSERT_EQ(victim, 2u);
+   ASSERT_EQ(policy.size(), 0u);
+
+   policy.insert(3);
+   policy.clear();
+
+   ASSERT_EQ(policy.size(), 0u);
+   ASSERT_FALSE(policy.touch(3) );
+}
+
+TEST(ClockProCachePolicy, counters)
+{
+   Policy policy;
+   unsigned victim;
+
+   policy.insert(1);
+
+   policy.touch(1);
+   policy.touch(1);
+   policy.touch(2);
+   policy.evict(victim);
+
+   CachePolicyStats stats = policy.getStats();
+
+   ASSERT_EQ(stats.numHits, 2u);
+   ASSERT_EQ(stats.numMisses, 1u);
+   ASSERT_EQ(stats.numEvictions, 1u);
+   ASSERT_EQ(stats.numEntries, 0u);
+}
+
+/*
+ * A working set that is accessed repeatedly must survive a scan over many more keys than the
+ * cache can hold. The working set is accessed less often than every <capacity> scanned keys, so
+ * an LRU cache would lose it.
+ */
+TEST(ClockProCachePolicy, scanResistance)
+{
+   const size_t capacity = 100;
+   const unsigned workingSetSize = 40;
+   const unsigned scanSize = 10000;
+
+   Policy policy;
+
+   // establish the working set (accessed over several clock periods)
+   for (unsigned round = 0; round < 10; round++)
+   {
+      for (unsigned key = 0; key < workingSetSize; key++)
+         access(policy, key, capacity);
+
+      // some other traffic that moves the clock hand
+      for (unsigned key = 0; key < capacity / 2; key++)
+         access(policy, 1000000 + round * capacity + key, capacity);
+   }
+
+   // scan, interleaved with continued use of the working set
+   for (unsigned key = 0; key < scanSize; key++)
+   {
+      access(policy, 2000000 + key, capacity);
+
+      if ( (key % 80) == 0)
+         for (unsigned workingKey = 0; workingKey < workingSetSize; workingKey++)
+            policy.touch(workingKey);
+   }
+
+   unsigned numWorkingSetCached = 0;
+
+   for (unsigned key = 0; key < workingSetSize; key++)
+      if (policy.touch(key) )
+         numWorkingSetCached++;
+
+   ASSERT_EQ(numWorkingSetCached, workingSetSize);
+   ASSERT_LE(policy.size(), capacity);
+}
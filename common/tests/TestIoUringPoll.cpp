@@ -0,0 +1,140 @@
+#include <common/toolkit/poll/IoUringPoll.h>
+
+#include <gtest/gtest.h>
+
+
+/* io_uring may be unavailable (old kernel, seccomp), which is not a test failure. The bundled
+ * googletest 1.8 has no GTEST_SKIP, so there the skip is only reported in the output and as a test
+ * property. */
+#ifdef GTEST_SKIP
+   #define SKIP_IF_NO_IOURING(initRes) \
+      if(!(initRes) ) GTEST_SKIP() << "io_uring not available: " << strerror(errno)
+#else
+   #define SKIP_IF_NO_IOURING(initRes) \
+      if(!(initRes) ) \
+      { \
+         const std::string skipReason = std::string("io_uring not available: ") + strerror(errno); \
+         ::testing::Test::RecordProperty("skipped", skipReason); \
+         std::cout << "[  SKIPPED ] " << skipReason << std::endl; \
+         return; \
+      }
+#endif
+
+
+class TestIoUringPoll : public ::testing::Test
+{
+   protected:
+      IoUringPoll ioUringPoll;
+      int pipeFDs[2];
+
+      void SetUp() override
+      {
+         ASSERT_EQ(pipe(pipeFDs), 0);
+      }
+
+      void TearDown() override
+      {
+         close(pipeFDs[0]);
+         close(pipeFDs[1]);
+      }
+};
+
+TEST_F(TestIoUringPoll, armWaitAndCancel)
+{
+   SKIP_IF_NO_IOURING(ioUringPoll.init(8) );
+
+   uint64_t userData;
+   int res;
+
+   ASSERT_TRUE(ioUringPoll.armPoll(pipeFDs[0], 42) );
+
+   // nothing readable => timeout without completion
+   ASSERT_EQ(ioUringPoll.submitAndWait(10), 0);
+   ASSERT_FALSE(ioUringPoll.popCompletion(userData, res) );
+
+   ASSERT_EQ(write(pipeFDs[1], "x", 1), 1);
+
+   ASSERT_EQ(ioUringPoll.submitAndWait(1000), 0);
+   ASSERT_TRUE(ioUringPoll.popCompletion(userData, res) );
+   ASSERT_EQ(userData, 42u);
+   ASSERT_TRUE(res & POLLIN);
+   ASSERT_FALSE(ioUringPoll.popCompletion(userData, res) );
+
+   // one-shot => no further completion until re-armed; re-armed poll of readable fd completes
+   ASSERT_TRUE(ioUringPoll.armPoll(pipeFDs[0], 43) );
+   ASSERT_EQ(ioUringPoll.submitAndWait(1000), 0);
+   ASSERT_TRUE(ioUringPoll.popCompletion(userData, res) );
+   ASSERT_EQ(userData, 43u);
+
+   // cancel a pending poll
+   char buf;
+   ASSERT_EQ(read(pipeFDs[0], &buf, 1), 1);
+
+   ASSERT_TRUE(ioUringPoll.armPoll(pipeFDs[0], 44) );
+   ASSERT_TRUE(ioUringPoll.cancelPoll(44) );
+   ASSERT_EQ(ioUringPoll.submitAndWait(1000), 0);
+
+   // the canceled poll is the only completion (the cancel request's own one is dropped)
+   unsigned numCompletions = 0;
+
+   for(int i = 0; (i < 2) && !numCompletions; i++)
+   {
+      while(ioUringPoll.popCompletion(userData, res) )
+      {
+         ASSERT_EQ(userData, 44u);
+         ASSERT_EQ(res, -ECANCELED);
+         numCompletions++;
+      }
+
+      if(!numCompletions)
+      {
+         ASSERT_EQ(ioUringPoll.submitAndWait(1000), 0);
+      }
+   }
+
+   ASSERT_EQ(numCompletions, 1u);
+
+   ASSERT_EQ(ioUringPoll.submitAndWait(10), 0);
+   ASSERT_FALSE(ioUringPoll.popCompletion(userData, res) );
+}
+
+TEST_F(TestIoUringPoll, reservedUserData)
+{
+   SKIP_IF_NO_IOURING(ioUringPoll.init(8) );
+
+   ASSERT_FALSE(ioUringPoll.armPoll(pipeFDs[0], IOURINGPOLL_CANCEL_USERDATA) );
+   ASSERT_EQ(errno, EINVAL);
+}
+
+TEST_F(TestIoUringPoll, moreArmsThanRingEntries)
+{
+   SKIP_IF_NO_IOURING(ioUringPoll.init(8) );
+
+   const unsigned numPolls = 100; // ring has 8 entries => armPoll() has to flush in between
+
+   for(unsigned i = 0; i < numPolls; i++)
+      ASSERT_TRUE(ioUringPoll.armPoll(pipeFDs[0], i) );
+
+   ASSERT_EQ(write(pipeFDs[1], "x", 1), 1);
+
+   unsigned numCompletions = 0;
+   uint64_t userData;
+   int res;
+
+   while(numCompletions < numPolls)
+   {
+      ASSERT_EQ(ioUringPoll.submitAndWait(1000), 0);
+
+      unsigned numBefore = numCompletions;
+
+      while(ioUringPoll.popCompletion(userData, res) )
+      {
+         ASSERT_TRUE(res & POLLIN);
+         numCompletions++;
+      }
+
+      ASSERT_GT(numCompletions, numBefore);
+   }
+
+   ASSERT_EQ(numCompletions, numPolls);
+}
@@ -0,0 +1,96 @@
+#include <common/toolkit/LatencyHistogram.h>
+
+#include <gtest/gtest.h>
+
+TEST(LatencyHistogram, bucketBoundaries)
+{
+   for(unsigned idx = 0; idx < LATENCYHISTOGRAM_NUM_BUCKETS; idx++)
+   {
+      uint64_t lower = LatencyHistogramData::bucketLowerBound(idx);
+      uint64_t upper = LatencyHistogramData::bucketUpperBound(idx);
+
+      ASSERT_LE(lower, upper);
+      ASSERT_EQ(LatencyHistogramData::bucketIndex(lower), idx);
+      ASSERT_EQ(LatencyHistogramData::bucketIndex(upper), idx);
+
+      if(idx + 1 < LATENCYHISTOGRAM_NUM_BUCKETS)
+      {
+         ASSERT_EQ(LatencyHistogramData::bucketLowerBound(idx + 1), upper + 1);
+      }
+
+      // relative error bound of the log-linear buckets
+      ASSERT_LE(upper - lower, lower / LATENCYHISTOGRAM_SUBBUCKETS);
+   }
+
+   ASSERT_EQ(LatencyHistogramData::bucketIndex(~0ull), LATENCYHISTOGRAM_NUM_BUCKETS - 1);
+}
+
+TEST(LatencyHistogram, percentiles)
+{
+   LatencyHistogram hist;
+   LatencyHistogramData data;
+
+   hist.snapshot(data);
+   ASSERT_EQ(data.count, 0u);
+   ASSERT_EQ(data.percentileMicro(0.5), 0u);
+
+   for(uint64_t i = 1; i <= 1000; i++)
+      hist.record(i);
+
+   hist.snapshot(data);
+
+   ASSERT_EQ(data.count, 1000u);
+   ASSERT_EQ(data.maxMicro, 1000u);
+   ASSERT_EQ(data.meanMicro(), 500u);
+
+   uint64_t p50 = data.percentileMicro(0.5);
+   uint64_t p99 = data.percentileMicro(0.99);
+   uint64_t p999 = data.percentileMicro(0.999);
+
+   ASSERT_GE(p50, 500u);
+   ASSERT_LE(p50, 500u + 500u / LATENCYHISTOGRAM_SUBBUCKETS);
+   ASSERT_GE(p99, 990u);
+   ASSERT_LE(p999, 1000u);
+   ASSERT_EQ(data.percentileMicro(1.0), 1000u);
+}
+
+TEST(LatencyHistogram, deltaAndSerialization)
+{
+   LatencyHistogram hist;
+   LatencyHistogramData older;
+   LatencyHistogramData newer;
+
+   for(unsigned i = 0; i < 100; i++)
+      hist.record(10);
+
+   hist.snapshot(older);
+
+   for(unsigned i = 0; i < 100; i++)
+      hist.record(100000);
+
+   hist.snapshot(newer);
+   newer.subtract(older);
+
+   ASSERT_EQ(newer.count, 100u);
+   ASSERT_EQ(newer.meanMicro(), 100000u);
+   ASSERT_GE(newer.percentileMicro(0.01), 100000u - 100000u / LATENCYHISTOGRAM_SUBBUCKETS);
+
+   LatencyHistogramDataMap map;
+   map[2015] = newer;
+   map[2015].add(older);
+
+   std::vector<char> buf(64 * 1024);
+   Serializer ser(&buf[0], buf.size() );
+   ser % map;
+   ASSERT_TRUE(ser.good() );
+
+   LatencyHistogramDataMap parsed;
+   Deserializer des(&buf[0], ser.size() );
+   des % parsed;
+   ASSERT_TRUE(des.good() );
+
+   ASSERT_EQ(parsed.size(), 1u);
+   ASSERT_EQ(parsed[2015].count, 200u);
+   ASSERT_EQ(parsed[2015].buckets, map[2015].buckets);
+   ASSERT_EQ(parsed[2015].percentileMicro(0.5), map[2015].percentileMicro(0.5) );
+}
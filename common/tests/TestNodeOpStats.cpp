@@ -0,0 +1,154 @@
+#include <common/nodes/NodeOpStats.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace {
+
+class TestOpStats : public NodeOpStats
+{
+   public:
+      void updateNodeOp(unsigned nodeIP, MetaOpCounterTypes opType, unsigned userID)
+      {
+         CounterTable& table = getThreadCounterTable();
+
+         std::lock_guard<Mutex> lock(table.mutex);
+
+         auto nodeIter = table.clientCounterMap.insert(
+            NodeOpCounterMapVal(nodeIP, MetaOpCounter() ) ).first;
+         auto userIter = table.userCounterMap.insert(
+            NodeOpCounterMapVal(userID, MetaOpCounter() ) ).first;
+
+         nodeIter->second.increaseOpCounter(opType);
+         userIter->second.increaseOpCounter(opType);
+      }
+};
+
+const unsigned numThreads = 4;
+const unsigned numOpsPerThread = 1000;
+const size_t bufLen = 64 * 1024;
+
+/**
+ * Counters of one IP/userID in a vector returned by mapToUInt64Vec(), or empty if not found.
+ */
+UInt64Vector findCounters(const UInt64Vector& vec, uint64_t id)
+{
+   const size_t numOps = vec[NODEOPS_POS_NUMOPS];
+
+   for(size_t pos = NODE_OPS_POS_FIRSTDATAELEMENT; pos < vec.size(); pos += numOps + 1)
+   {
+      if(vec[pos] == id)
+         return UInt64Vector(vec.begin() + pos + 1, vec.begin() + pos + 1 + numOps);
+   }
+
+   return {};
+}
+
+}
+
+TEST(NodeOpStats, mergeThreadTables)
+{
+   TestOpStats stats;
+   std::vector<std::thread> threads;
+
+   // every thread counts for the shared IP 1 / user 100 and for its own IP / user
+   for(unsigned t = 0; t < numThreads; t++)
+      threads.emplace_back([&stats, t] () {
+         for(unsigned i = 0; i < numOpsPerThread; i++)
+         {
+            stats.updateNodeOp(1, MetaOpCounter_STAT, 100);
+            stats.updateNodeOp(10 + t, MetaOpCounter_MKDIR, 200 + t);
+         }
+      });
+
+   for(auto& thread : threads)
+      thread.join();
+
+   UInt64Vector clientVec;
+   ASSERT_TRUE(stats.mapToUInt64Vec(~0ULL, bufLen, false, &clientVec) );
+
+   ASSERT_EQ(clientVec[NODEOPS_POS_NUMOPS], uint64_t(MetaOpCounter_OpCounterLastEnum) );
+   ASSERT_EQ(clientVec[NODE_OPS_POS_MORE_DATA], 0u);
+   ASSERT_EQ(clientVec[NODE_OPS_POS_LAYOUT_VERSION], uint64_t(OPCOUNTER_VEC_LAYOUT_VERS) );
+   ASSERT_EQ(clientVec.size(),
+      NODE_OPS_POS_FIRSTDATAELEMENT + (numThreads + 1) * (MetaOpCounter_OpCounterLastEnum + 1) );
+
+   UInt64Vector shared = findCounters(clientVec, 1);
+   ASSERT_FALSE(shared.empty() );
+   EXPECT_EQ(shared[OPCOUNTER_SUM_ELEM_INDEX], numThreads * numOpsPerThread);
+   EXPECT_EQ(shared[MetaOpCounter_STAT], numThreads * numOpsPerThread);
+   EXPECT_EQ(shared[MetaOpCounter_MKDIR], 0u);
+
+   for(unsigned t = 0; t < numThreads; t++)
+   {
+      UInt64Vector own = findCounters(clientVec, 10 + t);
+      ASSERT_FALSE(own.empty() );
+      EXPECT_EQ(own[OPCOUNTER_SUM_ELEM_INDEX], numOpsPerThread);
+      EXPECT_EQ(own[MetaOpCounter_MKDIR], numOpsPerThread);
+   }
+
+   UInt64Vector userVec;
+   ASSERT_TRUE(stats.mapToUInt64Vec(~0ULL, bufLen, true, &userVec) );
+
+   UInt64Vector sharedUser = findCounters(userVec, 100);
+   ASSERT_FALSE(sharedUser.empty() );
+   EXPECT_EQ(sharedUser[MetaOpCounter_STAT], numThreads * numOpsPerThread);
+   EXPECT_TRUE(findCounters(userVec, 1).empty() );
+
+   // merging must not modify the thread tables
+   UInt64Vector clientVec2;
+   ASSERT_TRUE(stats.mapToUInt64Vec(~0ULL, bufLen, false, &clientVec2) );
+   EXPECT_EQ(clientVec, clientVec2);
+}
+
+TEST(NodeOpStats, removeClientFromAllThreads)
+{
+   TestOpStats stats;
+   std::vector<std::thread> threads;
+
+   for(unsigned t = 0; t < numThreads; t++)
+      threads.emplace_back([&stats] () {
+         for(unsigned i = 0; i < numOpsPerThread; i++)
+         {
+            stats.updateNodeOp(1, MetaOpCounter_STAT, 100);
+            stats.updateNodeOp(2, MetaOpCounter_STAT, 100);
+         }
+      });
+
+   for(auto& thread : threads)
+      thread.join();
+
+   stats.removeClientFromMap(1);
+
+   UInt64Vector clientVec;
+   ASSERT_TRUE(stats.mapToUInt64Vec(~0ULL, bufLen, false, &clientVec) );
+
+   EXPECT_TRUE(findCounters(clientVec, 1).empty() );
+   ASSERT_FALSE(findCounters(clientVec, 2).empty() );
+   EXPECT_EQ(findCounters(clientVec, 2)[MetaOpCounter_STAT], numThreads * numOpsPerThread);
+
+   // per-user stats are not affected
+   UInt64Vector userVec;
+   ASSERT_TRUE(stats.mapToUInt64Vec(~0ULL, bufLen, true, &userVec) );
+   EXPECT_EQ(findCounters(userVec, 100)[MetaOpCounter_STAT], 2 * numThreads * numOpsPerThread);
+}
+
+TEST(NodeOpStats, cookie)
+{
+   TestOpStats stats;
+
+   for(unsigned ip = 1; ip <= 3; ip++)
+      stats.updateNodeOp(ip, MetaOpCounter_STAT, 0);
+
+   UInt64Vector vec;
+   ASSERT_TRUE(stats.mapToUInt64Vec(1, bufLen, false, &vec) );
+
+   EXPECT_TRUE(findCounters(vec, 1).empty() );
+   EXPECT_FALSE(findCounters(vec, 2).empty() );
+   EXPECT_FALSE(findCounters(vec, 3).empty() );
+
+   UInt64Vector emptyVec;
+   ASSERT_TRUE(stats.mapToUInt64Vec(3, bufLen, false, &emptyVec) );
+   EXPECT_TRUE(emptyVec.empty() );
+}
@@ -0,0 +1,184 @@
+#include <common/toolkit/ReedSolomon.h>
+#include <common/toolkit/TimeFine.h>
+
+#include <iostream>
+#include <random>
+
+#include <gtest/gtest.h>
+
+
+namespace {
+
+const ReedSolomonKernel allKernels[] = {
+   ReedSolomonKernel_SCALAR,
+   ReedSolomonKernel_SSSE3,
+   ReedSolomonKernel_AVX2,
+};
+
+struct Shards
+{
+   std::vector<std::vector<char>> buffers;
+   std::vector<char*> ptrs;
+
+   Shards(unsigned numShards, size_t len, unsigned seed) :
+      buffers(numShards, std::vector<char>(len) )
+   {
+      std::mt19937 rand(seed);
+
+      for (auto& buf : buffers)
+      {
+         for (auto& c : buf)
+            c = char(rand() );
+
+         ptrs.push_back(buf.data() );
+      }
+   }
+};
+
+}
+
+TEST(ReedSolomon, invalidArgs)
+{
+   ASSERT_THROW(ReedSolomon(0, 2), std::invalid_argument);
+   ASSERT_THROW(ReedSolomon(200, 57), std::invalid_argument);
+}
+
+TEST(ReedSolomon, kernelsAgree)
+{
+   // odd length to cover the scalar tails of the vector kernels
+   const size_t len = 64 * 1024 + 13;
+   const unsigned numData = 6;
+   const unsigned numParity = 3;
+
+   Shards reference(numData + numParity, len, 1);
+   ReedSolomon(numData, numParity, ReedSolomonKernel_SCALAR).encode(reference.ptrs.data(),
+      &reference.ptrs[numData], len);
+
+   for (ReedSolomonKernel kernel : allKernels)
+   {
+      if (!ReedSolomon::isKernelSupported(kernel) )
+         continue;
+
+      SCOPED_TRACE(ReedSolomon::getKernelName(kernel) );
+
+      Shards shards(numData + numParity, len, 1);
+      ReedSolomon(numData, numParity, kernel).encode(shards.ptrs.data(), &shards.ptrs[numData],
+         len);
+
+      for (unsigned p = numData; p < numData + numParity; p++)
+         ASSERT_EQ(shards.buffers[p], reference.buffers[p]);
+   }
+}
+
+TEST(ReedSolomon, reconstructAllErasures)
+{
+   const size_t len = 4096 + 7;
+   const unsigned numData = 4;
+   const unsigned numParity = 3;
+   const unsigned numShards = numData + numParity;
+
+   for (ReedSolomonKernel kernel : allKernels)
+   {
+      if (!ReedSolomon::isKernelSupported(kernel) )
+         continue;
+
+      SCOPED_TRACE(ReedSolomon::getKernelName(kernel) );
+
+      ReedSolomon codec(numData, numParity, kernel);
+
+      Shards original(numShards, len, 2);
+      codec.encode(original.ptrs.data(), &original.ptrs[numData], len);
+
+      // every combination of up to numParity lost shards
+      for (unsigned lostMask = 0; lostMask < (1u << numShards); lostMask++)
+      {
+         if (__builtin_popcount(lostMask) > int(numParity) )
+            continue;
+
+         Shards damaged(original);
+         bool present[numShards];
+
+         for (unsigned i = 0; i < numShards; i++)
+         {
+            damaged.ptrs[i] = damaged.buffers[i].data();
+            present[i] = !(lostMask & (1u << i) );
+
+            if (!present[i])
+               std::fill(damaged.buffers[i].begin(), damaged.buffers[i].end(), 0);
+         }
+
+         ASSERT_TRUE(codec.reconstruct(damaged.ptrs.data(), present, len) ) << lostMask;
+
+         for (unsigned i = 0; i < numShards; i++)
+            ASSERT_EQ(damaged.buffers[i], original.buffers[i]) << lostMask << " " << i;
+      }
+
+      // too many lost shards
+      Shards damaged(original);
+      bool present[numShards] = {false, false, false, false, true, true, true};
+      ASSERT_FALSE(codec.reconstruct(damaged.ptrs.data(), present, len) );
+   }
+}
+
+TEST(ReedSolomon, reconstructSelected)
+{
+   const size_t len = 1000;
+   const unsigned numData = 3;
+   const unsigned numParity = 2;
+
+   ReedSolomon codec(numData, numParity);
+
+   Shards original(numData + numParity, len, 3);
+   codec.encode(original.ptrs.data(), &original.ptrs[numData], len);
+
+   // only shard 0 is wanted, the lost shard 1 is not reconstructed
+   Shards damaged(original);
+   std::vector<char> out(len);
+   char* shards[] = {out.data(), nullptr, damaged.ptrs[2], damaged.ptrs[3], damaged.ptrs[4]};
+   bool present[] = {false, false, true, true, true};
+
+   ASSERT_TRUE(codec.reconstruct(shards, present, len) );
+   ASSERT_EQ(out, original.buffers[0]);
+}
+
+TEST(ReedSolomon, DISABLED_throughput)
+{
+   const size_t len = 1024 * 1024;
+   const unsigned numData = 8;
+   const unsigned numParity = 3;
+   const unsigned rounds = 64;
+
+   Shards shards(numData + numParity, len, 4);
+
+   for (ReedSolomonKernel kernel : allKernels)
+   {
+      if (!ReedSolomon::isKernelSupported(kernel) )
+         continue;
+
+      ReedSolomon codec(numData, numParity, kernel);
+
+      TimeFine startEncodeT;
+
+      for (unsigned i = 0; i < rounds; i++)
+         codec.encode(shards.ptrs.data(), &shards.ptrs[numData], len);
+
+      const uint64_t encodeMicros = TimeFine().elapsedSinceMicro(&startEncodeT);
+
+      // decode of numParity lost data shards, i.e. the worst case
+      bool present[numData + numParity];
+      std::fill_n(present, numData + numParity, true);
+      std::fill_n(present, numParity, false);
+
+      TimeFine startDecodeT;
+
+      for (unsigned i = 0; i < rounds; i++)
+         ASSERT_TRUE(codec.reconstruct(shards.ptrs.data(), present, len) );
+
+      const uint64_t decodeMicros = TimeFine().elapsedSinceMicro(&startDecodeT);
+
+      // throughput in terms of data bytes
+      std::cout << ReedSolomon::getKernelName(kernel) << " " << numData << "+" << numParity << ": "
+         << "encode " << uint64_t(rounds) * numData * len / encodeMicros << " MB/s, "
+         << "decode " << uint64_t(rounds) * numData * len / decodeMicros << " MB/s" << std::endl;
+   }
+}
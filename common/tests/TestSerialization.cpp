@@ -6,18 +6,23 @@
 #include <common/nodes/Node.h>
 #include <common/net/message/storage/attribs/SetXAttrMsg.h>
 #include <common/net/message/storage/creating/MkLocalDirMsg.h>
+#include <common/net/message/NetMessage.h>
 #include <common/net/sock/NetworkInterfaceCard.h>
 #include <common/storage/EntryInfo.h>
 #include <common/storage/EntryInfoWithDepth.h>
 #include <common/storage/Path.h>
 #include <common/storage/PathInfo.h>
+#include <common/storage/StatData.h>
 #include <common/storage/StorageTargetInfo.h>
 #include <common/storage/quota/QuotaData.h>
 #include <common/storage/striping/BuddyMirrorPattern.h>
 #include <common/storage/striping/Raid0Pattern.h>
 #include <common/storage/striping/Raid10Pattern.h>
+#include <common/toolkit/HighResolutionStats.h>
+#include <common/toolkit/TimeFine.h>
 
 #include <arpa/inet.h>
+#include <iostream>
 
 #include <gtest/gtest.h>
 
@@ -1138,3 +1143,283 @@ TEST(Serialization, stringCollections)
       testStringCollection<std::set>(expected);
    }
 }
+
+namespace {
+
+struct FixedFields
+{
+   bool b;
+   char c;
+   uint8_t u8;
+   int16_t i16;
+   uint16_t u16;
+   int32_t i32;
+   uint32_t u32;
+   int64_t i64;
+   uint64_t u64;
+
+   bool operator==(const FixedFields& other) const
+   {
+      return b == other.b && c == other.c && u8 == other.u8 && i16 == other.i16
+         && u16 == other.u16 && i32 == other.i32 && u32 == other.u32 && i64 == other.i64
+         && u64 == other.u64;
+   }
+
+   template<typename This, typename Ctx>
+   static void serialize(This obj, Ctx& ctx)
+   {
+      ctx % serdes::fixed(obj->b, obj->c, obj->u8, obj->i16, obj->u16, obj->i32, obj->u32,
+         obj->i64, obj->u64);
+   }
+};
+
+// same fields, serialized one by one
+struct FieldwiseFields : FixedFields
+{
+   template<typename This, typename Ctx>
+   static void serialize(This obj, Ctx& ctx)
+   {
+      ctx % obj->b % obj->c % obj->u8 % obj->i16 % obj->u16 % obj->i32 % obj->u32 % obj->i64
+         % obj->u64;
+   }
+};
+
+template<typename T>
+std::vector<char> serializeToVec(const T& value)
+{
+   Serializer sizeSer;
+   sizeSer % value;
+
+   std::vector<char> result(sizeSer.size() );
+
+   Serializer ser(&result[0], result.size() );
+   ser % value;
+   EXPECT_TRUE(ser.good() );
+
+   return result;
+}
+
+}
+
+TEST(Serialization, fixedRun)
+{
+   FixedFields value;
+   value.b = true;
+   value.c = 'x';
+   value.u8 = 0xfe;
+   value.i16 = -2;
+   value.u16 = 0x0102;
+   value.i32 = -3;
+   value.u32 = 0x01020304;
+   value.i64 = -4;
+   value.u64 = 0x0102030405060708ULL;
+
+   const char expected[] = {
+      1,
+      'x',
+      char(0xfe),
+      char(0xfe), char(0xff),
+      2, 1,
+      char(0xfd), char(0xff), char(0xff), char(0xff),
+      4, 3, 2, 1,
+      char(0xfc), char(0xff), char(0xff), char(0xff), char(0xff), char(0xff), char(0xff),
+         char(0xff),
+      8, 7, 6, 5, 4, 3, 2, 1
+   };
+
+   static_assert(serdes::FixedRun<bool, char, uint8_t, int16_t, uint16_t, int32_t, uint32_t,
+      int64_t, uint64_t>::wireSize == sizeof(expected), "wire size");
+
+   testSimpleSerializer(value, expected);
+
+   // identical to field by field (de)serialization
+   FieldwiseFields fieldwise;
+   static_cast<FixedFields&>(fieldwise) = value;
+
+   ASSERT_EQ(serializeToVec(value), serializeToVec(fieldwise) );
+
+   // non-zero bools are true, as with operator%
+   {
+      char input[sizeof(expected)];
+      memcpy(input, expected, sizeof(expected) );
+      input[0] = 2;
+
+      Deserializer des(input, sizeof(input) );
+      FixedFields output;
+
+      des % output;
+      ASSERT_TRUE(des.good() );
+      ASSERT_TRUE(output.b);
+   }
+}
+
+TEST(Serialization, fixedRunMessages)
+{
+   // header
+   {
+      NetMessageHeader header;
+      header.msgLength = 1234;
+      header.msgFeatureFlags = 0x0102;
+      header.msgCompatFeatureFlags = 3;
+      header.msgFlags = NetMessageHeader::Flag_HasSequenceNumber;
+      header.msgType = NETMSGTYPE_Stat;
+      header.msgTargetID = 17;
+      header.msgUserID = 1000;
+      header.msgSequence = 1ULL << 40;
+      header.msgSequenceDone = (1ULL << 40) - 1;
+
+      std::vector<char> buf = serializeToVec(header);
+      ASSERT_EQ(buf.size(), size_t(NETMSG_HEADER_LENGTH) );
+
+      NetMessageHeader output;
+      NetMessage::deserializeHeader(&buf[0], buf.size(), &output);
+
+      ASSERT_EQ(output.msgLength, header.msgLength);
+      ASSERT_EQ(output.msgFeatureFlags, header.msgFeatureFlags);
+      ASSERT_EQ(output.msgCompatFeatureFlags, header.msgCompatFeatureFlags);
+      ASSERT_EQ(output.msgFlags, header.msgFlags);
+      ASSERT_EQ(output.msgType, header.msgType);
+      ASSERT_EQ(output.msgTargetID, header.msgTargetID);
+      ASSERT_EQ(output.msgUserID, header.msgUserID);
+      ASSERT_EQ(output.msgSequence, header.msgSequence);
+      ASSERT_EQ(output.msgSequenceDone, header.msgSequenceDone);
+
+      // prefix is still checked
+      buf[8] ^= 1;
+      NetMessage::deserializeHeader(&buf[0], buf.size(), &output);
+      ASSERT_EQ(output.msgType, NETMSGTYPE_Invalid);
+
+      // truncated
+      NetMessage::deserializeHeader(&buf[0], buf.size() - 1, &output);
+      ASSERT_EQ(output.msgType, NETMSGTYPE_Invalid);
+   }
+
+   // high-res stats
+   {
+      HighResolutionStats stats;
+      stats.rawVals.statsTimeMS = 123456789;
+      stats.rawVals.busyWorkers = 7;
+      stats.rawVals.queuedRequests = 8;
+      stats.incVals.diskWriteBytes = 1ULL << 33;
+      stats.incVals.diskReadBytes = 1ULL << 34;
+      stats.incVals.netSendBytes = 1ULL << 35;
+      stats.incVals.netRecvBytes = 1ULL << 36;
+      stats.incVals.workRequests = 9;
+
+      std::vector<char> buf = serializeToVec(stats);
+      ASSERT_EQ(buf.size(), 8u + 4 + 4 + 4 * 8 + 4);
+
+      HighResolutionStats output;
+      Deserializer des(&buf[0], buf.size() );
+      des % output;
+
+      ASSERT_TRUE(des.good() );
+      ASSERT_EQ(des.size(), buf.size() );
+      ASSERT_EQ(output.rawVals.statsTimeMS, stats.rawVals.statsTimeMS);
+      ASSERT_EQ(output.rawVals.busyWorkers, stats.rawVals.busyWorkers);
+      ASSERT_EQ(output.rawVals.queuedRequests, stats.rawVals.queuedRequests);
+      ASSERT_EQ(output.incVals.diskWriteBytes, stats.incVals.diskWriteBytes);
+      ASSERT_EQ(output.incVals.diskReadBytes, stats.incVals.diskReadBytes);
+      ASSERT_EQ(output.incVals.netSendBytes, stats.incVals.netSendBytes);
+      ASSERT_EQ(output.incVals.netRecvBytes, stats.incVals.netRecvBytes);
+      ASSERT_EQ(output.incVals.workRequests, stats.incVals.workRequests);
+   }
+
+   // stat data in all formats
+   {
+      SettableFileAttribs attribs = {0100644, 1000, 1001, 1500000000, 1500000001};
+      StatData statData(4096, &attribs, 1400000000, 1500000002, 2, 5);
+
+      for (StatDataFormat format : {StatDataFormat_NET, StatDataFormat_FILEINODE,
+            StatDataFormat_DENTRYV4, StatDataFormat_DIRINODE,
+            StatDataFormat_DIRINODE_NOFLAGS})
+      {
+         std::vector<char> buf = serializeToVec(statData.serializeAs(format) );
+
+         StatData output;
+         Deserializer des(&buf[0], buf.size() );
+         des % output.serializeAs(format);
+
+         ASSERT_TRUE(des.good() );
+         ASSERT_EQ(des.size(), buf.size() );
+         ASSERT_EQ(output.getCreationTimeSecs(), statData.getCreationTimeSecs() );
+         ASSERT_EQ(output.getModificationTimeSecs(), statData.getModificationTimeSecs() );
+         ASSERT_EQ(output.getLastAccessTimeSecs(), statData.getLastAccessTimeSecs() );
+         ASSERT_EQ(output.getAttribChangeTimeSecs(), statData.getAttribChangeTimeSecs() );
+         ASSERT_EQ(output.getUserID(), statData.getUserID() );
+         ASSERT_EQ(output.getGroupID(), statData.getGroupID() );
+         ASSERT_EQ(output.getMode(), statData.getMode() );
+
+         if (!(format & StatDataFormat_Flag_DiskDirInode) )
+         {
+            ASSERT_EQ(output.getFileSize(), statData.getFileSize() );
+            ASSERT_EQ(output.getNumHardlinks(), statData.getNumHardlinks() );
+         }
+      }
+   }
+}
+
+/**
+ * Compares fixed runs with field by field (de)serialization of the same fields.
+ */
+TEST(Serialization, DISABLED_fixedRunThroughput)
+{
+   const unsigned numRounds = 10000000;
+
+   FieldwiseFields value;
+   value.b = true;
+   value.c = 'x';
+   value.u8 = 1;
+   value.i16 = -2;
+   value.u16 = 3;
+   value.i32 = -4;
+   value.u32 = 5;
+   value.i64 = -6;
+   value.u64 = 7;
+
+   std::vector<char> buf(1024);
+
+   // keeps the compiler from optimizing the (de)serialization away
+   auto clobber = [] (void* ptr) {
+      asm volatile("" : : "g"(ptr) : "memory");
+   };
+
+   auto measure = [&] (const char* name, auto& object) {
+      uint64_t checksum = 0;
+
+      TimeFine serStartT;
+
+      for (unsigned i = 0; i < numRounds; i++)
+      {
+         Serializer ser(&buf[0], buf.size() );
+
+         object.u64 = i;
+         ser % object;
+         clobber(&buf[0]);
+         checksum += ser.size();
+      }
+
+      const uint64_t serNS = TimeFine().elapsedSinceMicro(&serStartT) * 1000;
+
+      TimeFine desStartT;
+
+      for (unsigned i = 0; i < numRounds; i++)
+      {
+         Deserializer des(&buf[0], buf.size() );
+
+         des % object;
+         clobber(&object);
+         checksum += object.u64;
+      }
+
+      const uint64_t desNS = TimeFine().elapsedSinceMicro(&desStartT) * 1000;
+
+      std::cout << name << ": serialize " << double(serNS) / numRounds << " ns, deserialize "
+         << double(desNS) / numRounds << " ns (" << checksum << ")" << std::endl;
+   };
+
+   FixedFields fixedValue = value;
+
+   measure("field by field", value);
+   measure("fixed run", fixedValue);
+}
@@ -0,0 +1,171 @@
+#include <common/threading/RWLock.h>
+#include <common/threading/ShardedRWLock.h>
+#include <common/toolkit/Time.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+
+TEST(ShardedRWLock, readersDontBlockEachOther)
+{
+   ShardedRWLock lock(4);
+
+   lock.readLock();
+
+   bool otherThreadGotLock = false;
+
+   std::thread([&] () {
+      otherThreadGotLock = lock.tryReadLock();
+      if (otherThreadGotLock)
+         lock.unlock();
+   }).join();
+
+   lock.unlock();
+
+   ASSERT_TRUE(otherThreadGotLock);
+}
+
+TEST(ShardedRWLock, writerExcludesReadersOnAllShards)
+{
+   const unsigned numThreads = 8;
+
+   ShardedRWLock lock(4);
+   std::atomic<unsigned> numReadLocks(0);
+
+   lock.writeLock();
+
+   std::vector<std::thread> threads;
+
+   for (unsigned i = 0; i < numThreads; i++)
+      threads.emplace_back([&] () {
+         if (lock.tryReadLock() )
+         {
+            numReadLocks++;
+            lock.unlock();
+         }
+      });
+
+   for (auto& thread : threads)
+      thread.join();
+
+   ASSERT_EQ(numReadLocks, 0u);
+
+   lock.unlock();
+
+   ASSERT_TRUE(lock.tryWriteLock() );
+   lock.unlock();
+}
+
+TEST(ShardedRWLock, readerExcludesWriter)
+{
+   ShardedRWLock lock(4);
+
+   lock.readLock();
+
+   bool otherThreadGotLock = true;
+
+   std::thread([&] () {
+      otherThreadGotLock = lock.tryWriteLock();
+      if (otherThreadGotLock)
+         lock.unlock();
+   }).join();
+
+   lock.unlock();
+
+   ASSERT_FALSE(otherThreadGotLock);
+}
+
+TEST(ShardedRWLock, mutualExclusionOfWriters)
+{
+   const unsigned numThreads = 8;
+   const unsigned numOpsPerThread = 2000;
+
+   ShardedRWLock lock;
+   unsigned counter = 0; // protected by lock
+   std::atomic<unsigned> numInconsistentReads(0);
+
+   std::vector<std::thread> threads;
+
+   for (unsigned t = 0; t < numThreads; t++)
+      threads.emplace_back([&, t] () {
+         for (unsigned i = 0; i < numOpsPerThread; i++)
+         {
+            if ( (i + t) % 4)
+            {
+               UniqueShardedRWLock readLock(lock, SafeRWLock_READ);
+
+               unsigned before = counter;
+               std::this_thread::yield();
+
+               if (counter != before)
+                  numInconsistentReads++;
+            }
+            else
+            {
+               UniqueShardedRWLock writeLock(lock, SafeRWLock_WRITE);
+               counter++;
+            }
+         }
+      });
+
+   for (auto& thread : threads)
+      thread.join();
+
+   ASSERT_EQ(numInconsistentReads, 0u);
+   ASSERT_EQ(counter, numThreads * numOpsPerThread / 4);
+}
+
+/**
+ * @return read lock/unlock pairs per second over all threads.
+ */
+template<typename LockT>
+static uint64_t runReaders(LockT& lock, unsigned numThreads, unsigned numOpsPerThread)
+{
+   std::vector<std::thread> threads;
+
+   Time startTime;
+
+   for (unsigned t = 0; t < numThreads; t++)
+      threads.emplace_back([&] () {
+         for (unsigned i = 0; i < numOpsPerThread; i++)
+         {
+            lock.readLock();
+            lock.unlock();
+         }
+      });
+
+   for (auto& thread : threads)
+      thread.join();
+
+   unsigned elapsedUS = std::max(startTime.elapsedMicro(), 1u);
+
+   return uint64_t(numThreads) * numOpsPerThread * 1000000 / elapsedUS;
+}
+
+/*
+ * Compares the read lock throughput of RWLock and ShardedRWLock for an increasing number of
+ * reader threads. Disabled by default, because it only prints timings.
+ */
+TEST(ShardedRWLock, DISABLED_benchmarkReadScaling)
+{
+   const unsigned numOpsPerThread = 1000000;
+   const unsigned maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+   for (unsigned numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+   {
+      RWLock rwlock;
+      ShardedRWLock shardedLock;
+
+      uint64_t rwlockOps = runReaders(rwlock, numThreads, numOpsPerThread);
+      uint64_t shardedOps = runReaders(shardedLock, numThreads, numOpsPerThread);
+
+      std::cout << "threads: " << numThreads << "; " <<
+         "RWLock: " << rwlockOps << " ops/s; " <<
+         "ShardedRWLock (" << shardedLock.getNumShards() << " shards): " << shardedOps <<
+         " ops/s" << std::endl;
+   }
+}
@@ -0,0 +1,119 @@
+#include <common/net/sock/StandardSocket.h>
+#include <common/toolkit/Time.h>
+
+#include <gtest/gtest.h>
+
+#include <sys/epoll.h>
+#include <iostream>
+#include <thread>
+
+
+class TestStandardSocket : public ::testing::Test
+{
+   protected:
+      std::unique_ptr<StandardSocket> sender;
+      std::unique_ptr<StandardSocket> receiver;
+
+      void SetUp() override
+      {
+         StandardSocket* endpointA;
+         StandardSocket* endpointB;
+
+         StandardSocket::createSocketPair(PF_UNIX, SOCK_STREAM, 0, &endpointA, &endpointB);
+
+         sender.reset(endpointA);
+         receiver.reset(endpointB);
+      }
+};
+
+TEST_F(TestStandardSocket, recvExactTBuffered)
+{
+   const char data[] = "0123456789abcdef";
+   char buf[sizeof(data)] = {};
+
+   // fragments that are already buffered when we start receiving
+   sender->send(data, 4, 0);
+   sender->send(&data[4], 5, 0);
+   sender->send(&data[9], sizeof(data) - 9, 0);
+
+   ASSERT_EQ(receiver->recvExactT(buf, sizeof(buf), 0, 1000), (ssize_t)sizeof(buf) );
+   ASSERT_EQ(std::string(buf), std::string(data) );
+}
+
+TEST_F(TestStandardSocket, recvExactTWaitsForMissingData)
+{
+   const char data[] = "0123456789abcdef";
+   char buf[sizeof(data)] = {};
+
+   sender->send(data, 8, 0);
+
+   std::thread lateSender([&] () {
+      ::usleep(50000);
+      sender->send(&data[8], sizeof(data) - 8, 0);
+   });
+
+   ASSERT_EQ(receiver->recvExactT(buf, sizeof(buf), 0, 5000), (ssize_t)sizeof(buf) );
+   ASSERT_EQ(std::string(buf), std::string(data) );
+
+   lateSender.join();
+}
+
+TEST_F(TestStandardSocket, recvTTimeoutAndDisconnect)
+{
+   char buf[8];
+
+   ASSERT_THROW(receiver->recvT(buf, sizeof(buf), 0, 10), SocketTimeoutException);
+
+   sender.reset();
+
+   ASSERT_THROW(receiver->recvT(buf, sizeof(buf), 0, 10), SocketDisconnectException);
+}
+
+/*
+ * Compares recvExactT() of small already buffered msgs (single optimistic recv) with the previous
+ * epoll_wait+recv sequence. Disabled by default, because it only prints timings.
+ */
+TEST_F(TestStandardSocket, DISABLED_benchmarkBufferedRecv)
+{
+   const unsigned numRounds = 200000;
+   const size_t msgLen = 64;
+
+   char msg[msgLen] = {};
+   char buf[msgLen];
+
+   struct epoll_event epollEvent;
+   int epollFD = epoll_create(1);
+   ASSERT_NE(epollFD, -1);
+
+   epollEvent.events = EPOLLIN;
+   epollEvent.data.ptr = NULL;
+   ASSERT_EQ(epoll_ctl(epollFD, EPOLL_CTL_ADD, receiver->getFD(), &epollEvent), 0);
+
+   Time startTime;
+
+   for(unsigned i = 0; i < numRounds; i++)
+   {
+      sender->send(msg, msgLen, 0);
+
+      ASSERT_EQ(epoll_wait(epollFD, &epollEvent, 1, 1000), 1);
+      ASSERT_EQ(::recv(receiver->getFD(), buf, msgLen, 0), (ssize_t)msgLen);
+   }
+
+   unsigned elapsedEpollMS = startTime.elapsedMS();
+
+   startTime.setToNow();
+
+   for(unsigned i = 0; i < numRounds; i++)
+   {
+      sender->send(msg, msgLen, 0);
+      receiver->recvExactT(buf, msgLen, 0, 1000);
+   }
+
+   unsigned elapsedOptimisticMS = startTime.elapsedMS();
+
+   close(epollFD);
+
+   std::cout << "rounds: " << numRounds << "; " <<
+      "epoll_wait+recv (2 syscalls/recv): " << elapsedEpollMS << "ms; " <<
+      "recvExactT (1 syscall/recv): " << elapsedOptimisticMS << "ms" << std::endl;
+}
@@ -0,0 +1,69 @@
+#include <common/system/System.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <sys/stat.h>
+
+class TestSystem : public ::testing::Test
+{
+   protected:
+      std::string sysfsDir;
+
+      void SetUp() override
+      {
+         char dirTemplate[] = "/tmp/beegfs-test-sysfs-XXXXXX";
+
+         ASSERT_NE(mkdtemp(dirTemplate), nullptr);
+         sysfsDir = dirTemplate;
+      }
+
+      void TearDown() override
+      {
+         if(!sysfsDir.empty() )
+         {
+            ASSERT_EQ(system( ("rm -rf " + sysfsDir).c_str() ), 0);
+         }
+      }
+
+      void makeDir(const std::string& path)
+      {
+         ASSERT_EQ(system( ("mkdir -p " + sysfsDir + "/" + path).c_str() ), 0);
+      }
+
+      void writeNumaNode(const std::string& devPath, int numaNode)
+      {
+         makeDir(devPath);
+         std::ofstream(sysfsDir + "/" + devPath + "/numa_node") << numaNode << "\n";
+      }
+};
+
+TEST_F(TestSystem, numaNodeOfSysfsDevice)
+{
+   // pci device with a numa node, nvme namespace and partition below it (like real sysfs)
+   writeNumaNode("devices/pci0000:80/0000:80:01.0", 1);
+   makeDir("devices/pci0000:80/0000:80:01.0/nvme/nvme0/nvme0n1/nvme0n1p1");
+   makeDir("dev/block");
+   ASSERT_EQ(symlink("../../devices/pci0000:80/0000:80:01.0/nvme/nvme0/nvme0n1/nvme0n1p1",
+      (sysfsDir + "/dev/block/259:1").c_str() ), 0);
+
+   EXPECT_EQ(System::getNumaNodeOfSysfsDevice(sysfsDir + "/dev/block/259:1"), 1);
+   EXPECT_EQ(System::getNumaNodeOfSysfsDevice(
+      sysfsDir + "/devices/pci0000:80/0000:80:01.0/nvme/nvme0"), 1);
+
+   // closest numa_node wins
+   writeNumaNode("devices/pci0000:80/0000:80:01.0/nvme/nvme0", 0);
+   EXPECT_EQ(System::getNumaNodeOfSysfsDevice(sysfsDir + "/dev/block/259:1"), 0);
+}
+
+TEST_F(TestSystem, numaNodeOfSysfsDeviceUnknown)
+{
+   // kernels without numa support report -1
+   writeNumaNode("devices/pci0000:00/0000:00:02.0", -1);
+   makeDir("devices/virtual/net/lo");
+
+   EXPECT_EQ(System::getNumaNodeOfSysfsDevice(sysfsDir + "/devices/pci0000:00/0000:00:02.0"), -1);
+   EXPECT_EQ(System::getNumaNodeOfSysfsDevice(sysfsDir + "/devices/virtual/net/lo"), -1);
+   EXPECT_EQ(System::getNumaNodeOfSysfsDevice(sysfsDir + "/does/not/exist"), -1);
+}
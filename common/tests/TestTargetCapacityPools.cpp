@@ -16,3 +16,45 @@ TEST(TargetCapacityPools, interdomainWithEmptyGroups)
    EXPECT_EQ(chosen.size(), 1u);
    ASSERT_EQ(chosen[0], 1);
 }
+
+TEST(TargetCapacityPools, loadAwareAvoidsLoadedTargets)
+{
+   TargetCapacityPools pools(false, {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0});
+
+   TargetLoadMap loads;
+
+   for (uint16_t targetID = 1; targetID <= 4; targetID++)
+   {
+      pools.addOrUpdate(targetID, NumNodeID(targetID), CapacityPool_NORMAL);
+      loads[targetID] = (targetID == 4) ? 1000 : 0;
+   }
+
+   // with two choices, the loaded target can only win if it is the last candidate left
+   for (int i = 0; i < 100; i++)
+   {
+      std::vector<uint16_t> chosen;
+      pools.chooseStorageTargetsLoadAware(2, 2, loads, &chosen);
+
+      ASSERT_EQ(chosen.size(), 2u);
+      ASSERT_NE(chosen[0], chosen[1]);
+      ASSERT_NE(chosen[0], 4);
+      ASSERT_NE(chosen[1], 4);
+   }
+}
+
+TEST(TargetCapacityPools, loadAwareFallsBackToLowerPools)
+{
+   TargetCapacityPools pools(false, {0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0});
+
+   pools.addOrUpdate(1, NumNodeID(1), CapacityPool_NORMAL);
+   pools.addOrUpdate(2, NumNodeID(1), CapacityPool_LOW);
+   pools.addOrUpdate(3, NumNodeID(2), CapacityPool_EMERGENCY);
+
+   std::vector<uint16_t> chosen;
+   pools.chooseStorageTargetsLoadAware(4, 3, TargetLoadMap(), &chosen);
+
+   ASSERT_EQ(chosen.size(), 3u);
+   ASSERT_EQ(chosen[0], 1);
+   ASSERT_EQ(chosen[1], 2);
+   ASSERT_EQ(chosen[2], 3);
+}
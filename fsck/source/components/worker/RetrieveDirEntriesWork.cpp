@@ -1,6 +1,8 @@
 #include "RetrieveDirEntriesWork.h"
 #include <common/net/message/fsck/RetrieveDirEntriesMsg.h>
 #include <common/net/message/fsck/RetrieveDirEntriesRespMsg.h>
+#include <common/net/message/fsck/StreamFsckDirEntriesMsg.h>
+#include <common/net/message/fsck/StreamFsckDirEntriesRespMsg.h>
 #include <common/toolkit/MessagingTk.h>
 #include <common/toolkit/MetaStorageTk.h>
 #include <database/FsckDBException.h>
@@ -10,6 +12,8 @@
 
 #include <set>
 
+#include <boost/lexical_cast.hpp>
+
 RetrieveDirEntriesWork::RetrieveDirEntriesWork(FsckDB* db, Node& node, SynchronizedCounter* counter,
       AtomicUInt64& errors, unsigned hashDirStart, unsigned hashDirEnd,
       AtomicUInt64* numDentriesFound, AtomicUInt64* numFileInodesFound,
@@ -30,8 +34,11 @@ void RetrieveDirEntriesWork::process(char* bufIn, unsigned bufInLen, char* bufOu
 
    try
    {
-      doWork(false);
-      doWork(true);
+      if (!doStreamingWork(false) )
+         doWork(false);
+
+      if (!doStreamingWork(true) )
+         doWork(true);
       // flush buffers before signaling completion
       dentries->flush(dentriesHandle);
       files->flush(filesHandle);
@@ -51,6 +58,110 @@ void RetrieveDirEntriesWork::process(char* bufIn, unsigned bufInLen, char* bufOu
    log.log(4, "Processed RetrieveDirEntriesWork");
 }
 
+/**
+ * Fetch all dir entries of the hash dir range as one stream (StreamFsckDirEntriesMsg).
+ *
+ * @return false if the node doesn't support streaming (i.e. it closed the connection before
+ *    sending anything) or rejected the stream because it is busy with other streams, so that the
+ *    caller can fall back to doWork().
+ */
+bool RetrieveDirEntriesWork::doStreamingWork(bool isBuddyMirrored)
+{
+   NodeConnPool* connPool = node.getConnPool();
+   auto netMessageFactory = Program::getApp()->getNetMessageFactory();
+
+   StreamFsckDirEntriesMsg streamMsg(hashDirStart, hashDirEnd, isBuddyMirrored);
+
+   Socket* sock = NULL;
+   bool receivedAny = false;
+
+   try
+   {
+      sock = connPool->acquireStreamSocket();
+
+      const auto sendBuf = MessagingTk::createMsgVec(streamMsg);
+      sock->send(&sendBuf[0], sendBuf.size(), 0);
+
+      while (true)
+      {
+         auto respBuf = MessagingTk::recvMsgBuf(*sock);
+         if (respBuf.empty() )
+            throw SocketException("Received invalid message");
+
+         const auto respMsg = netMessageFactory->createFromBuf(std::move(respBuf) );
+         if (respMsg->getMsgType() != NETMSGTYPE_StreamFsckDirEntriesResp)
+            throw SocketException("Received invalid response type: " +
+               respMsg->getMsgTypeStr() );
+
+         auto* batchMsg = (StreamFsckDirEntriesRespMsg*) respMsg.get();
+
+         // the node limits the number of concurrent streams and rejects this one
+         if (!receivedAny && batchMsg->getIsLast() &&
+            batchMsg->getResult() == FhgfsOpsErr_AGAIN)
+         {
+            connPool->releaseStreamSocket(sock);
+
+            LOG(GENERAL, DEBUG, "Node is busy with other streams, using paged dir entry "
+                  "retrieval.", ("node", node.getAlias()), isBuddyMirrored);
+            return false;
+         }
+
+         receivedAny = true;
+
+         processDirEntries(batchMsg->getContDirs(), batchMsg->getDirEntries(),
+            batchMsg->getInlinedFileInodes() );
+
+         if (batchMsg->getIsLast() )
+         {
+            if (batchMsg->getResult() != FhgfsOpsErr_SUCCESS)
+            {
+               LOG(GENERAL, ERR, "Node failed to export all dir entries.",
+                     ("node", node.getAlias()), isBuddyMirrored,
+                     ("error", boost::lexical_cast<std::string>(batchMsg->getResult())));
+               errors->increase();
+            }
+
+            break;
+         }
+
+         // if any of the worker threads threw an exception, we should stop now! (the rest of the
+         // stream is not read, so the connection can't be reused)
+         if (Program::getApp()->getShallAbort() )
+         {
+            connPool->invalidateStreamSocket(sock);
+            return true;
+         }
+      }
+
+      connPool->releaseStreamSocket(sock);
+      return true;
+   }
+   catch (SocketException& e)
+   {
+      if (sock)
+         connPool->invalidateStreamSocket(sock);
+
+      if (receivedAny)
+         throw FsckException("Communication error occured with node " + node.getAlias() + ": " +
+            e.what() );
+
+      LOG(GENERAL, NOTICE, "Dir entry streaming failed, falling back to paged retrieval.",
+            ("node", node.getAlias()), ("error", e.what()));
+      return false;
+   }
+   catch (...)
+   {
+      if (sock)
+         connPool->invalidateStreamSocket(sock);
+
+      throw;
+   }
+}
+
+/**
+ * Fetch the dir entries of the hash dir range in batches of RETRIEVE_DIR_ENTRIES_PACKET_SIZE, one
+ * RetrieveDirEntriesMsg per batch (for nodes that don't support StreamFsckDirEntriesMsg).
+ */
 void RetrieveDirEntriesWork::doWork(bool isBuddyMirrored)
 {
    for ( unsigned firstLevelhashDirNum = hashDirStart; firstLevelhashDirNum <= hashDirEnd;
@@ -84,128 +195,13 @@ void RetrieveDirEntriesWork::doWork(bool isBuddyMirrored)
                hashDirOffset = retrieveDirEntriesRespMsg->getNewHashDirOffset();
                contDirOffset = retrieveDirEntriesRespMsg->getNewContDirOffset();
 
-               // parse directory entries
-               FsckDirEntryList& dirEntries = retrieveDirEntriesRespMsg->getDirEntries();
                // this is the actual result count we are interested in, because if no dirEntries
                // were read, there is nothing left on the server
+               resultCount = retrieveDirEntriesRespMsg->getDirEntries().size();
 
-               resultCount = dirEntries.size();
-
-               // check dentry entry IDs
-               for (auto it = dirEntries.begin(); it != dirEntries.end(); )
-               {
-                  if (db::EntryID::tryFromStr(it->getID()).first
-                        && db::EntryID::tryFromStr(it->getParentDirID()).first)
-                  {
-                     ++it;
-                     continue;
-                  }
-
-                  LOG(GENERAL, ERR, "Found dentry with invalid entry IDs.",
-                        ("node", it->getSaveNodeID()),
-                        ("isBuddyMirrored", it->getIsBuddyMirrored()),
-                        ("entryID", it->getID()),
-                        ("parentEntryID", it->getParentDirID()));
-
-                  ++it;
-                  errors->increase();
-                  dirEntries.erase(std::prev(it));
-               }
-
-               this->dentries->insert(dirEntries, this->dentriesHandle);
-
-               numDentriesFound->increase(resultCount);
-
-               // parse inlined file inodes
-               FsckFileInodeList& inlinedFileInodes =
-                  retrieveDirEntriesRespMsg->getInlinedFileInodes();
-
-               // check inode entry IDs
-               for (auto it = inlinedFileInodes.begin(); it != inlinedFileInodes.end(); )
-               {
-                  if (db::EntryID::tryFromStr(it->getID()).first
-                        && db::EntryID::tryFromStr(it->getParentDirID()).first
-                        && (!it->getPathInfo()->hasOrigFeature()
-                              || db::EntryID::tryFromStr(
-                                    it->getPathInfo()->getOrigParentEntryID()).first))
-                  {
-                     ++it;
-                     continue;
-                  }
-
-                  LOG(GENERAL, ERR, "Found inode with invalid entry IDs.",
-                        ("node", it->getSaveNodeID()),
-                        ("isBuddyMirrored", it->getIsBuddyMirrored()),
-                        ("entryID", it->getID()),
-                        ("parentEntryID", it->getParentDirID()),
-                        ("origParent", it->getPathInfo()->getOrigParentEntryID()));
-
-                  ++it;
-                  errors->increase();
-                  inlinedFileInodes.erase(std::prev(it));
-               }
-
-               struct ops
-               {
-                  static bool dentryCmp(const FsckDirEntry& a, const FsckDirEntry& b)
-                  {
-                     return a.getID() < b.getID();
-                  }
-
-                  static bool inodeCmp(const FsckFileInode& a, const FsckFileInode& b)
-                  {
-                     return a.getID() < b.getID();
-                  }
-               };
-
-               dirEntries.sort(ops::dentryCmp);
-               inlinedFileInodes.sort(ops::inodeCmp);
-
-               this->files->insert(inlinedFileInodes, this->filesHandle);
-
-               numFileInodesFound->increase(inlinedFileInodes.size());
-
-               // add used targetIDs
-               for ( FsckFileInodeListIter iter = inlinedFileInodes.begin();
-                  iter != inlinedFileInodes.end(); iter++ )
-               {
-                  FsckTargetIDType fsckTargetIDType;
-
-                  if (iter->getStripePatternType() == FsckStripePatternType_BUDDYMIRROR)
-                     fsckTargetIDType = FsckTargetIDType_BUDDYGROUP;
-                  else
-                     fsckTargetIDType = FsckTargetIDType_TARGET;
-
-                  for (auto targetsIter = iter->getStripeTargets().begin();
-                     targetsIter != iter->getStripeTargets().end(); targetsIter++)
-                  {
-                     this->usedTargets->insert(FsckTargetID(*targetsIter, fsckTargetIDType) );
-                  }
-               }
-
-               // parse all new cont. directories
-               FsckContDirList& contDirs = retrieveDirEntriesRespMsg->getContDirs();
-
-               // check entry IDs
-               for (auto it = contDirs.begin(); it != contDirs.end(); )
-               {
-                  if (db::EntryID::tryFromStr(it->getID()).first)
-                  {
-                     ++it;
-                     continue;
-                  }
-
-                  LOG(GENERAL, ERR, "Found content directory with invalid entry ID.",
-                        ("node", it->getSaveNodeID()),
-                        ("isBuddyMirrored", it->getIsBuddyMirrored()),
-                        ("entryID", it->getID()));
-
-                  ++it;
-                  errors->increase();
-                  contDirs.erase(std::prev(it));
-               }
-
-               this->contDirs->insert(contDirs, this->contDirsHandle);
+               processDirEntries(retrieveDirEntriesRespMsg->getContDirs(),
+                  retrieveDirEntriesRespMsg->getDirEntries(),
+                  retrieveDirEntriesRespMsg->getInlinedFileInodes() );
             }
             else
             {
@@ -220,3 +216,122 @@ void RetrieveDirEntriesWork::doWork(bool isBuddyMirrored)
       }
    }
 }
+
+/**
+ * Check the received dir entries, inlined inodes and content dirs, collect the targets of the
+ * inodes and save everything to the DB.
+ */
+void RetrieveDirEntriesWork::processDirEntries(FsckContDirList& newContDirs,
+   FsckDirEntryList& dirEntries, FsckFileInodeList& inlinedFileInodes)
+{
+   const size_t numDentries = dirEntries.size();
+
+   // check dentry entry IDs
+   for (auto it = dirEntries.begin(); it != dirEntries.end(); )
+   {
+      if (db::EntryID::tryFromStr(it->getID()).first
+            && db::EntryID::tryFromStr(it->getParentDirID()).first)
+      {
+         ++it;
+         continue;
+      }
+
+      LOG(GENERAL, ERR, "Found dentry with invalid entry IDs.",
+            ("node", it->getSaveNodeID()),
+            ("isBuddyMirrored", it->getIsBuddyMirrored()),
+            ("entryID", it->getID()),
+            ("parentEntryID", it->getParentDirID()));
+
+      ++it;
+      errors->increase();
+      dirEntries.erase(std::prev(it));
+   }
+
+   this->dentries->insert(dirEntries, this->dentriesHandle);
+
+   numDentriesFound->increase(numDentries);
+
+   // check inode entry IDs
+   for (auto it = inlinedFileInodes.begin(); it != inlinedFileInodes.end(); )
+   {
+      if (db::EntryID::tryFromStr(it->getID()).first
+            && db::EntryID::tryFromStr(it->getParentDirID()).first
+            && (!it->getPathInfo()->hasOrigFeature()
+                  || db::EntryID::tryFromStr(
+                        it->getPathInfo()->getOrigParentEntryID()).first))
+      {
+         ++it;
+         continue;
+      }
+
+      LOG(GENERAL, ERR, "Found inode with invalid entry IDs.",
+            ("node", it->getSaveNodeID()),
+            ("isBuddyMirrored", it->getIsBuddyMirrored()),
+            ("entryID", it->getID()),
+            ("parentEntryID", it->getParentDirID()),
+            ("origParent", it->getPathInfo()->getOrigParentEntryID()));
+
+      ++it;
+      errors->increase();
+      inlinedFileInodes.erase(std::prev(it));
+   }
+
+   struct ops
+   {
+      static bool dentryCmp(const FsckDirEntry& a, const FsckDirEntry& b)
+      {
+         return a.getID() < b.getID();
+      }
+
+      static bool inodeCmp(const FsckFileInode& a, const FsckFileInode& b)
+      {
+         return a.getID() < b.getID();
+      }
+   };
+
+   dirEntries.sort(ops::dentryCmp);
+   inlinedFileInodes.sort(ops::inodeCmp);
+
+   this->files->insert(inlinedFileInodes, this->filesHandle);
+
+   numFileInodesFound->increase(inlinedFileInodes.size());
+
+   // add used targetIDs
+   for ( FsckFileInodeListIter iter = inlinedFileInodes.begin();
+      iter != inlinedFileInodes.end(); iter++ )
+   {
+      FsckTargetIDType fsckTargetIDType;
+
+      if (iter->getStripePatternType() == FsckStripePatternType_BUDDYMIRROR)
+         fsckTargetIDType = FsckTargetIDType_BUDDYGROUP;
+      else
+         fsckTargetIDType = FsckTargetIDType_TARGET;
+
+      for (auto targetsIter = iter->getStripeTargets().begin();
+         targetsIter != iter->getStripeTargets().end(); targetsIter++)
+      {
+         this->usedTargets->insert(FsckTargetID(*targetsIter, fsckTargetIDType) );
+      }
+   }
+
+   // check entry IDs
+   for (auto it = newContDirs.begin(); it != newContDirs.end(); )
+   {
+      if (db::EntryID::tryFromStr(it->getID()).first)
+      {
+         ++it;
+         continue;
+      }
+
+      LOG(GENERAL, ERR, "Found content directory with invalid entry ID.",
+            ("node", it->getSaveNodeID()),
+            ("isBuddyMirrored", it->getIsBuddyMirrored()),
+            ("entryID", it->getID()));
+
+      ++it;
+      errors->increase();
+      newContDirs.erase(std::prev(it));
+   }
+
+   this->contDirs->insert(newContDirs, this->contDirsHandle);
+}
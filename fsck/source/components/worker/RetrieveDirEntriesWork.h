@@ -56,7 +56,10 @@ class RetrieveDirEntriesWork : public Work
       FsckDBContDirsTable* contDirs;
       FsckDBContDirsTable::BulkHandle contDirsHandle;
 
+      bool doStreamingWork(bool isBuddyMirrored);
       void doWork(bool isBuddyMirrored);
+      void processDirEntries(FsckContDirList& newContDirs, FsckDirEntryList& dirEntries,
+         FsckFileInodeList& inlinedFileInodes);
 };
 
 #endif /* RETRIEVEDIRENTRIESWORK_H */
@@ -1,6 +1,8 @@
 #include "RetrieveInodesWork.h"
 #include <common/net/message/fsck/RetrieveInodesMsg.h>
 #include <common/net/message/fsck/RetrieveInodesRespMsg.h>
+#include <common/net/message/fsck/StreamFsckInodesMsg.h>
+#include <common/net/message/fsck/StreamFsckInodesRespMsg.h>
 #include <common/toolkit/MetaStorageTk.h>
 #include <common/toolkit/MessagingTk.h>
 #include <database/FsckDBException.h>
@@ -10,6 +12,8 @@
 
 #include <set>
 
+#include <boost/lexical_cast.hpp>
+
 RetrieveInodesWork::RetrieveInodesWork(FsckDB* db, Node& node, SynchronizedCounter* counter,
       AtomicUInt64& errors, unsigned hashDirStart, unsigned hashDirEnd,
       AtomicUInt64* numFileInodesFound, AtomicUInt64* numDirInodesFound,
@@ -29,8 +33,11 @@ void RetrieveInodesWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
 
    try
    {
-      doWork(false);
-      doWork(true);
+      if (!doStreamingWork(false) )
+         doWork(false);
+
+      if (!doStreamingWork(true) )
+         doWork(true);
       // flush buffers before signaling completion
       files->flush(filesHandle);
       dirs->flush(dirsHandle);
@@ -50,13 +57,111 @@ void RetrieveInodesWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
    log.log(4, "Processed RetrieveInodesWork");
 }
 
-void RetrieveInodesWork::doWork(bool isBuddyMirrored)
+/**
+ * Fetch all inodes of the hash dir range as one stream (StreamFsckInodesMsg).
+ *
+ * @return false if the node doesn't support streaming (i.e. it closed the connection before
+ *    sending anything) or rejected the stream because it is busy with other streams, so that the
+ *    caller can fall back to doWork().
+ */
+bool RetrieveInodesWork::doStreamingWork(bool isBuddyMirrored)
 {
-   const NumNodeID& metaRootID = Program::getApp()->getMetaRoot().getID();
-   const NumNodeID& nodeID = node.getNumID();
-   const NumNodeID nodeBuddyGroupID = NumNodeID(Program::getApp()->getMetaMirrorBuddyGroupMapper()
-         ->getBuddyGroupID(node.getNumID().val()));
+   NodeConnPool* connPool = node.getConnPool();
+   auto netMessageFactory = Program::getApp()->getNetMessageFactory();
+
+   StreamFsckInodesMsg streamMsg(hashDirStart, hashDirEnd, isBuddyMirrored);
+
+   Socket* sock = NULL;
+   bool receivedAny = false;
+
+   try
+   {
+      sock = connPool->acquireStreamSocket();
+
+      const auto sendBuf = MessagingTk::createMsgVec(streamMsg);
+      sock->send(&sendBuf[0], sendBuf.size(), 0);
+
+      while (true)
+      {
+         auto respBuf = MessagingTk::recvMsgBuf(*sock);
+         if (respBuf.empty() )
+            throw SocketException("Received invalid message");
+
+         const auto respMsg = netMessageFactory->createFromBuf(std::move(respBuf) );
+         if (respMsg->getMsgType() != NETMSGTYPE_StreamFsckInodesResp)
+            throw SocketException("Received invalid response type: " +
+               respMsg->getMsgTypeStr() );
+
+         auto* batchMsg = (StreamFsckInodesRespMsg*) respMsg.get();
+
+         // the node limits the number of concurrent streams and rejects this one
+         if (!receivedAny && batchMsg->getIsLast() &&
+            batchMsg->getResult() == FhgfsOpsErr_AGAIN)
+         {
+            connPool->releaseStreamSocket(sock);
+
+            LOG(GENERAL, DEBUG, "Node is busy with other inode streams, using paged retrieval.",
+                  ("node", node.getAlias()), isBuddyMirrored);
+            return false;
+         }
 
+         receivedAny = true;
+
+         processInodes(batchMsg->getFileInodes(), batchMsg->getDirInodes() );
+
+         if (batchMsg->getIsLast() )
+         {
+            if (batchMsg->getResult() != FhgfsOpsErr_SUCCESS)
+            {
+               LOG(GENERAL, ERR, "Node failed to export all inodes.", ("node", node.getAlias()),
+                     isBuddyMirrored,
+                     ("error", boost::lexical_cast<std::string>(batchMsg->getResult())));
+               errors->increase();
+            }
+
+            break;
+         }
+
+         // if any of the worker threads threw an exception, we should stop now! (the rest of the
+         // stream is not read, so the connection can't be reused)
+         if (Program::getApp()->getShallAbort() )
+         {
+            connPool->invalidateStreamSocket(sock);
+            return true;
+         }
+      }
+
+      connPool->releaseStreamSocket(sock);
+      return true;
+   }
+   catch (SocketException& e)
+   {
+      if (sock)
+         connPool->invalidateStreamSocket(sock);
+
+      if (receivedAny)
+         throw FsckException("Communication error occured with node " + node.getAlias() + ": " +
+            e.what() );
+
+      LOG(GENERAL, NOTICE, "Inode streaming failed, falling back to paged retrieval.",
+            ("node", node.getAlias()), ("error", e.what()));
+      return false;
+   }
+   catch (...)
+   {
+      if (sock)
+         connPool->invalidateStreamSocket(sock);
+
+      throw;
+   }
+}
+
+/**
+ * Fetch the inodes of the hash dir range in batches of RETRIEVE_INODES_PACKET_SIZE, one
+ * RetrieveInodesMsg per batch (for nodes that don't support StreamFsckInodesMsg).
+ */
+void RetrieveInodesWork::doWork(bool isBuddyMirrored)
+{
    for ( unsigned firstLevelhashDirNum = hashDirStart; firstLevelhashDirNum <= hashDirEnd;
       firstLevelhashDirNum++ )
    {
@@ -67,8 +172,7 @@ void RetrieveInodesWork::doWork(bool isBuddyMirrored)
             secondLevelhashDirNum);
 
          int64_t lastOffset = 0;
-         size_t fileInodeCount;
-         size_t dirInodeCount;
+         size_t numInodesReceived;
 
          do
          {
@@ -84,93 +188,11 @@ void RetrieveInodesWork::doWork(bool isBuddyMirrored)
                // set new parameters
                lastOffset = retrieveInodesRespMsg->getLastOffset();
 
-               // parse all file inodes
-               FsckFileInodeList& fileInodes = retrieveInodesRespMsg->getFileInodes();
-
-               // check inode entry IDs
-               for (auto it = fileInodes.begin(); it != fileInodes.end(); )
-               {
-                  if (db::EntryID::tryFromStr(it->getID()).first
-                        && db::EntryID::tryFromStr(it->getParentDirID()).first
-                        && (!it->getPathInfo()->hasOrigFeature()
-                              || db::EntryID::tryFromStr(
-                                    it->getPathInfo()->getOrigParentEntryID()).first))
-                  {
-                     ++it;
-                     continue;
-                  }
-
-                  LOG(GENERAL, ERR, "Found inode with invalid entry IDs.",
-                        ("node", it->getSaveNodeID()),
-                        ("isBuddyMirrored", it->getIsBuddyMirrored()),
-                        ("entryID", it->getID()),
-                        ("parentEntryID", it->getParentDirID()),
-                        ("origParent", it->getPathInfo()->getOrigParentEntryID()));
-
-                  ++it;
-                  errors->increase();
-                  fileInodes.erase(std::prev(it));
-               }
-
-               // add targetIDs
-               for (auto iter = fileInodes.begin(); iter != fileInodes.end(); iter++)
-               {
-                  FsckTargetIDType fsckTargetIDType;
-
-                  if (iter->getStripePatternType() == FsckStripePatternType_BUDDYMIRROR)
-                     fsckTargetIDType = FsckTargetIDType_BUDDYGROUP;
-                  else
-                     fsckTargetIDType = FsckTargetIDType_TARGET;
-
-                  for (auto targetsIter = iter->getStripeTargets().begin();
-                     targetsIter != iter->getStripeTargets().end(); targetsIter++)
-                  {
-                     this->usedTargets->insert(FsckTargetID(*targetsIter, fsckTargetIDType) );
-                  }
-               }
-
-               // parse all directory inodes
-               FsckDirInodeList& dirInodes = retrieveInodesRespMsg->getDirInodes();
-
-               // check inode entry IDs
-               for (auto it = dirInodes.begin(); it != dirInodes.end(); )
-               {
-                  auto entryIDPair = db::EntryID::tryFromStr(it->getID());
-                  if (!entryIDPair.first ||
-                        !db::EntryID::tryFromStr(it->getParentDirID()).first)
-                  {
-                     LOG(GENERAL, ERR, "Found inode with invalid entry IDs.",
-                           ("node", it->getSaveNodeID()),
-                           ("isBuddyMirrored", it->getIsBuddyMirrored()),
-                           ("entryID", it->getID()),
-                           ("parentEntryID", it->getParentDirID()));
-
-                     ++it;
-                     errors->increase();
-                     dirInodes.erase(std::prev(it));
-                     continue;
-                  }
-
-                  // remove root inodes from non root metas
-                  if (entryIDPair.second.isRootDir() &&
-                        ((it->getIsBuddyMirrored() && nodeBuddyGroupID != metaRootID)
-                        || (!it->getIsBuddyMirrored() && nodeID != metaRootID)))
-                  {
-                     ++it;
-                     dirInodes.erase(std::prev(it));
-                     continue;
-                  }
-                  ++it;
-               }
-
-               fileInodeCount = fileInodes.size();
-               dirInodeCount = dirInodes.size();
-
-               this->files->insert(fileInodes, this->filesHandle);
-               this->dirs->insert(dirInodes, this->dirsHandle);
-
-               numFileInodesFound->increase(fileInodeCount);
-               numDirInodesFound->increase(dirInodeCount);
+               numInodesReceived = retrieveInodesRespMsg->getFileInodes().size() +
+                  retrieveInodesRespMsg->getDirInodes().size();
+
+               processInodes(retrieveInodesRespMsg->getFileInodes(),
+                  retrieveInodesRespMsg->getDirInodes() );
             }
             else
             {
@@ -181,7 +203,100 @@ void RetrieveInodesWork::doWork(bool isBuddyMirrored)
             if ( Program::getApp()->getShallAbort() )
                return;
 
-         } while ( (fileInodeCount + dirInodeCount) > 0 );
+         } while (numInodesReceived > 0);
+      }
+   }
+}
+
+/**
+ * Check the received inodes, collect their targets and save them to the DB.
+ */
+void RetrieveInodesWork::processInodes(FsckFileInodeList& fileInodes, FsckDirInodeList& dirInodes)
+{
+   const NumNodeID& metaRootID = Program::getApp()->getMetaRoot().getID();
+   const NumNodeID& nodeID = node.getNumID();
+   const NumNodeID nodeBuddyGroupID = NumNodeID(Program::getApp()->getMetaMirrorBuddyGroupMapper()
+         ->getBuddyGroupID(node.getNumID().val()));
+
+   // check inode entry IDs
+   for (auto it = fileInodes.begin(); it != fileInodes.end(); )
+   {
+      if (db::EntryID::tryFromStr(it->getID()).first
+            && db::EntryID::tryFromStr(it->getParentDirID()).first
+            && (!it->getPathInfo()->hasOrigFeature()
+                  || db::EntryID::tryFromStr(
+                        it->getPathInfo()->getOrigParentEntryID()).first))
+      {
+         ++it;
+         continue;
+      }
+
+      LOG(GENERAL, ERR, "Found inode with invalid entry IDs.",
+            ("node", it->getSaveNodeID()),
+            ("isBuddyMirrored", it->getIsBuddyMirrored()),
+            ("entryID", it->getID()),
+            ("parentEntryID", it->getParentDirID()),
+            ("origParent", it->getPathInfo()->getOrigParentEntryID()));
+
+      ++it;
+      errors->increase();
+      fileInodes.erase(std::prev(it));
+   }
+
+   // add targetIDs
+   for (auto iter = fileInodes.begin(); iter != fileInodes.end(); iter++)
+   {
+      FsckTargetIDType fsckTargetIDType;
+
+      if (iter->getStripePatternType() == FsckStripePatternType_BUDDYMIRROR)
+         fsckTargetIDType = FsckTargetIDType_BUDDYGROUP;
+      else
+         fsckTargetIDType = FsckTargetIDType_TARGET;
+
+      for (auto targetsIter = iter->getStripeTargets().begin();
+         targetsIter != iter->getStripeTargets().end(); targetsIter++)
+      {
+         this->usedTargets->insert(FsckTargetID(*targetsIter, fsckTargetIDType) );
       }
    }
+
+   // check inode entry IDs
+   for (auto it = dirInodes.begin(); it != dirInodes.end(); )
+   {
+      auto entryIDPair = db::EntryID::tryFromStr(it->getID());
+      if (!entryIDPair.first ||
+            !db::EntryID::tryFromStr(it->getParentDirID()).first)
+      {
+         LOG(GENERAL, ERR, "Found inode with invalid entry IDs.",
+               ("node", it->getSaveNodeID()),
+               ("isBuddyMirrored", it->getIsBuddyMirrored()),
+               ("entryID", it->getID()),
+               ("parentEntryID", it->getParentDirID()));
+
+         ++it;
+         errors->increase();
+         dirInodes.erase(std::prev(it));
+         continue;
+      }
+
+      // remove root inodes from non root metas
+      if (entryIDPair.second.isRootDir() &&
+            ((it->getIsBuddyMirrored() && nodeBuddyGroupID != metaRootID)
+            || (!it->getIsBuddyMirrored() && nodeID != metaRootID)))
+      {
+         ++it;
+         dirInodes.erase(std::prev(it));
+         continue;
+      }
+      ++it;
+   }
+
+   const size_t fileInodeCount = fileInodes.size();
+   const size_t dirInodeCount = dirInodes.size();
+
+   this->files->insert(fileInodes, this->filesHandle);
+   this->dirs->insert(dirInodes, this->dirsHandle);
+
+   numFileInodesFound->increase(fileInodeCount);
+   numDirInodesFound->increase(dirInodeCount);
 }
@@ -52,7 +52,9 @@ class RetrieveInodesWork : public Work
       FsckDBDirInodesTable* dirs;
       FsckDBDirInodesTable::BulkHandle dirsHandle;
 
+      bool doStreamingWork(bool isBuddyMirrored);
       void doWork(bool isBuddyMirrored);
+      void processInodes(FsckFileInodeList& fileInodes, FsckDirInodeList& dirInodes);
 };
 
 #endif /* RETRIEVEINODESWORK_H */
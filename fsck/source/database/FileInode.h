@@ -36,10 +36,11 @@ struct FileInode {
    uint32_t isInlined:1;
    uint32_t pathInfoFlags:4;
    uint32_t stripePatternType:4;
-   uint32_t stripePatternSize:20;
+   uint32_t stripePatternSize:19;
    uint32_t readable:1;
    uint32_t isBuddyMirrored:1;
-   uint32_t isMismirrored:1;     /* 112 */
+   uint32_t isMismirrored:1;
+   uint32_t hasInlineData:1;     /* 112 */
 
    typedef EntryID KeyType;
 
@@ -49,10 +50,14 @@ struct FileInode {
    {
       PathInfo info(origParentUID, origParentEntryID.str(), pathInfoFlags);
 
-      return FsckFileInode(id.str(), parentDirID.str(), NumNodeID(parentNodeID), info, uid, gid,
+      FsckFileInode result(id.str(), parentDirID.str(), NumNodeID(parentNodeID), info, uid, gid,
             fileSize, numHardlinks, usedBlocks, {}, FsckStripePatternType(stripePatternType),
             chunkSize, NumNodeID(saveNodeID), saveInode, saveDevice, isInlined, isBuddyMirrored,
             readable, isMismirrored);
+
+      result.setHasInlineData(hasInlineData);
+
+      return result;
    }
 
    friend std::ostream& operator<<(std::ostream& os, FileInode const& obj)
@@ -89,7 +94,8 @@ struct FileInode {
          os << "stripePatternSize: " << obj.stripePatternSize << "\n";
          os << "readable: " << obj.readable << "\n";
          os << "isBuddyMirrored: " << obj.isBuddyMirrored << "\n";
-         os << "isMismirrored: " << obj.isMismirrored << "\n\n";
+         os << "isMismirrored: " << obj.isMismirrored << "\n";
+         os << "hasInlineData: " << obj.hasInlineData << "\n\n";
          return os;
    }
 };
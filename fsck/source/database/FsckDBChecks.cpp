@@ -1094,6 +1094,10 @@ Cursor<std::pair<FsckFileInode, checks::OptionalInodeAttribs> > FsckDB::findWron
    {
       static bool fileAttribsIncorrect(std::pair<db::FileInode, uint64_t>& pair)
       {
+         // the data of inline data files is in the inode, so there are no chunks to compare with
+         if (pair.first.hasInlineData)
+            return false;
+
          return pair.first.fileSize != pair.second;
       }
 
@@ -185,6 +185,7 @@ void FsckDBFileInodesTable::insert(FsckFileInodeList& fileInodes, const BulkHand
          it->getReadable(),
          it->getIsBuddyMirrored(),
          it->getIsMismirrored(),
+         it->getHasInlineData(),
       };
 
       db::StripeTargets extraTargets = { inode.id, {}, 0 };
@@ -24,6 +24,8 @@
 #include <common/net/message/fsck/UpdateFileAttribsRespMsg.h>
 #include <net/message/fsck/FsckModificationEventMsgEx.h>
 #include <common/net/message/fsck/CheckAndRepairDupInodeRespMsg.h>
+#include <common/net/message/fsck/StreamFsckInodesRespMsg.h>
+#include <common/net/message/fsck/StreamFsckDirEntriesRespMsg.h>
 
 // nodes messages
 #include <common/net/message/nodes/GetMirrorBuddyGroupsRespMsg.h>
@@ -110,6 +112,8 @@ std::unique_ptr<NetMessage> NetMessageFactory::createFromMsgType(unsigned short
       case NETMSGTYPE_MoveChunkFileResp: { msg = new MoveChunkFileRespMsg(); } break;
       case NETMSGTYPE_RemoveInodesResp: { msg = new RemoveInodesRespMsg(); } break;
       case NETMSGTYPE_CheckAndRepairDupInodeResp: { msg = new CheckAndRepairDupInodeRespMsg(); } break;
+      case NETMSGTYPE_StreamFsckInodesResp: { msg = new StreamFsckInodesRespMsg(); } break;
+      case NETMSGTYPE_StreamFsckDirEntriesResp: { msg = new StreamFsckDirEntriesRespMsg(); } break;
 
       //testing
       case NETMSGTYPE_Dummy: { msg = new DummyMsgEx(); } break;
@@ -1269,6 +1269,35 @@ DB_TEST(testCheckForAndInsertFileInodesWithWrongAttribs)
    ASSERT_EQ(countCursor(this->db->findWrongInodeFileAttribs()), WRONG_DATA_INODES);
 }
 
+DB_TEST(testCheckForWrongInodeFileAttribsInlineData)
+{
+   // inline data files have no chunks, so only the size of the other file is wrong
+
+   FsckFileInodeList inodesIn;
+   DatabaseTk::createDummyFsckFileInodes(2, &inodesIn);
+
+   FsckDirEntryList dentries;
+   DatabaseTk::createDummyFsckDirEntries(2, &dentries);
+
+   for (FsckFileInodeListIter iter = inodesIn.begin(); iter != inodesIn.end(); iter++)
+   {
+      iter->fileSize = 100;
+      iter->numHardLinks = 1;
+   }
+
+   inodesIn.front().setHasInlineData(true);
+
+   this->db->getFileInodesTable()->insert(inodesIn);
+   this->db->getDentryTable()->insert(dentries);
+
+   auto cursor = this->db->findWrongInodeFileAttribs();
+
+   ASSERT_TRUE(cursor.step() );
+   ASSERT_EQ(cursor.get()->first.getID(), inodesIn.back().getID() );
+   ASSERT_EQ(*cursor.get()->second.size, 0u);
+   ASSERT_FALSE(cursor.step() );
+}
+
 DB_TEST(testCheckForAndInsertDirInodesWithWrongAttribs)
 {
    unsigned NUM_INODES = 10;
@@ -59,6 +59,7 @@ class TestDatabase: public ::testing::Test
       void testCheckForAndInsertInodesWithoutContDir();
       void testCheckForAndInsertOrphanedContDirs();
       void testCheckForAndInsertFileInodesWithWrongAttribs();
+      void testCheckForWrongInodeFileAttribsInlineData();
       void testCheckForAndInsertDirInodesWithWrongAttribs();
       void testCheckForAndInsertFilesWithMissingStripeTargets();
       void testCheckForAndInsertChunksWithWrongPermissions();
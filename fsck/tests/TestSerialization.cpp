@@ -1,5 +1,8 @@
 #include <common/net/message/nodes/HeartbeatRequestMsg.h>
 #include <common/net/message/nodes/HeartbeatMsg.h>
+#include <common/net/message/fsck/StreamFsckDirEntriesRespMsg.h>
+#include <common/net/message/fsck/StreamFsckInodesRespMsg.h>
+#include <common/toolkit/MessagingTk.h>
 #include <common/toolkit/ZipIterator.h>
 #include <net/message/NetMessageFactory.h>
 #include <toolkit/DatabaseTk.h>
@@ -75,3 +78,88 @@ TEST(Serialization, fsckFsIDSerialization)
    FsckFsID fsIDIn = DatabaseTk::createDummyFsckFsID();
    testObjectRoundTrip(fsIDIn);
 }
+
+TEST(Serialization, streamFsckInodesRespMsgSerialization)
+{
+   FsckFileInodeList fileInodes;
+   FsckDirInodeList dirInodes;
+
+   for (unsigned i = 0; i < STREAMFSCKINODES_BATCH_SIZE / 2; i++)
+   {
+      fileInodes.push_back(DatabaseTk::createDummyFsckFileInode() );
+      dirInodes.push_back(DatabaseTk::createDummyFsckDirInode() );
+   }
+
+   StreamFsckInodesRespMsg msgIn(&fileInodes, &dirInodes, false, FhgfsOpsErr_SUCCESS);
+
+   // a full batch has to fit into a message that fsck accepts
+   auto buf = MessagingTk::createMsgVec(msgIn);
+   ASSERT_LT(buf.size(), 4u*1024*1024);
+
+   NetMessageFactory factory;
+   auto msgOut = factory.createFromBuf(std::move(buf) );
+   ASSERT_EQ(msgOut->getMsgType(), NETMSGTYPE_StreamFsckInodesResp);
+
+   auto& respOut = static_cast<StreamFsckInodesRespMsg&>(*msgOut);
+   ASSERT_EQ(respOut.getFileInodes(), fileInodes);
+   ASSERT_EQ(respOut.getDirInodes(), dirInodes);
+   ASSERT_FALSE(respOut.getIsLast() );
+   ASSERT_EQ(respOut.getResult(), FhgfsOpsErr_SUCCESS);
+
+   FsckFileInodeList noFileInodes;
+   FsckDirInodeList noDirInodes;
+
+   StreamFsckInodesRespMsg lastIn(&noFileInodes, &noDirInodes, true, FhgfsOpsErr_INTERNAL);
+
+   auto lastOut = factory.createFromBuf(MessagingTk::createMsgVec(lastIn) );
+   ASSERT_EQ(lastOut->getMsgType(), NETMSGTYPE_StreamFsckInodesResp);
+
+   auto& lastRespOut = static_cast<StreamFsckInodesRespMsg&>(*lastOut);
+   ASSERT_TRUE(lastRespOut.getFileInodes().empty() );
+   ASSERT_TRUE(lastRespOut.getIsLast() );
+   ASSERT_EQ(lastRespOut.getResult(), FhgfsOpsErr_INTERNAL);
+}
+
+TEST(Serialization, streamFsckDirEntriesRespMsgSerialization)
+{
+   FsckContDirList contDirs;
+   FsckDirEntryList dirEntries;
+   FsckFileInodeList inlinedFileInodes;
+
+   DatabaseTk::createDummyFsckContDirs(STREAMFSCKDIRENTRIES_BATCH_SIZE, &contDirs);
+   DatabaseTk::createDummyFsckDirEntries(STREAMFSCKDIRENTRIES_BATCH_SIZE, &dirEntries);
+   DatabaseTk::createDummyFsckFileInodes(STREAMFSCKDIRENTRIES_BATCH_SIZE, &inlinedFileInodes);
+
+   StreamFsckDirEntriesRespMsg msgIn(&contDirs, &dirEntries, &inlinedFileInodes, false,
+      FhgfsOpsErr_SUCCESS);
+
+   // a full batch (all files with inlined inodes) has to fit into a message that fsck accepts
+   auto buf = MessagingTk::createMsgVec(msgIn);
+   ASSERT_LT(buf.size(), 4u*1024*1024);
+
+   NetMessageFactory factory;
+   auto msgOut = factory.createFromBuf(std::move(buf) );
+   ASSERT_EQ(msgOut->getMsgType(), NETMSGTYPE_StreamFsckDirEntriesResp);
+
+   auto& respOut = static_cast<StreamFsckDirEntriesRespMsg&>(*msgOut);
+   ASSERT_EQ(respOut.getContDirs(), contDirs);
+   ASSERT_EQ(respOut.getDirEntries(), dirEntries);
+   ASSERT_EQ(respOut.getInlinedFileInodes(), inlinedFileInodes);
+   ASSERT_FALSE(respOut.getIsLast() );
+   ASSERT_EQ(respOut.getResult(), FhgfsOpsErr_SUCCESS);
+
+   FsckContDirList noContDirs;
+   FsckDirEntryList noDirEntries;
+   FsckFileInodeList noInlinedFileInodes;
+
+   StreamFsckDirEntriesRespMsg lastIn(&noContDirs, &noDirEntries, &noInlinedFileInodes, true,
+      FhgfsOpsErr_AGAIN);
+
+   auto lastOut = factory.createFromBuf(MessagingTk::createMsgVec(lastIn) );
+   ASSERT_EQ(lastOut->getMsgType(), NETMSGTYPE_StreamFsckDirEntriesResp);
+
+   auto& lastRespOut = static_cast<StreamFsckDirEntriesRespMsg&>(*lastOut);
+   ASSERT_TRUE(lastRespOut.getDirEntries().empty() );
+   ASSERT_TRUE(lastRespOut.getIsLast() );
+   ASSERT_EQ(lastRespOut.getResult(), FhgfsOpsErr_AGAIN);
+}
@@ -11,7 +11,9 @@
 #include <common/system/UUID.h>
 #include <common/toolkit/NodesTk.h>
 #include <components/FileEventLogger.h>
+#include <components/ChunkUnlinker.h>
 #include <components/ModificationEventFlusher.h>
+#include <components/StorageLoadsPoller.h>
 #include <components/DisposalGarbageCollector.h>
 #include <program/Program.h>
 #include <session/SessionStore.h>
@@ -38,6 +40,7 @@
 
 #define APP_WORKERS_DIRECT_NUM      1
 #define APP_SYSLOG_IDENTIFIER       "beegfs-meta"
+#define APP_MIRRORFORWARD_MAX_INFLIGHT_BATCHES   8 /* concurrent batches to the secondary */
 
 
 App::App(int argc, char** argv)
@@ -82,6 +85,8 @@ App::App(int argc, char** argv)
    this->statsCollector = NULL;
    this->internodeSyncer = NULL;
    this->modificationEventFlusher = NULL;
+   this->chunkUnlinker = NULL;
+   this->storageLoadsPoller = NULL;
    this->timerQueue = new TimerQueue(1, 1);
    this->gcQueue = new TimerQueue(1, 1);
    this->buddyResyncer = NULL;
@@ -99,6 +104,8 @@ App::~App()
 
    SAFE_DELETE(this->buddyResyncer);
    SAFE_DELETE(this->timerQueue);
+   SAFE_DELETE(this->storageLoadsPoller);
+   SAFE_DELETE(this->chunkUnlinker);
    SAFE_DELETE(this->modificationEventFlusher);
    SAFE_DELETE(this->internodeSyncer);
    SAFE_DELETE(this->statsCollector);
@@ -436,6 +443,8 @@ void App::initDataObjects()
 
    this->targetMapper->attachExceededQuotaStores(&exceededQuotaStores);
 
+   this->storageNodeLoads = boost::make_unique<StorageNodeLoads>();
+
    this->workQueue = new MultiWorkQueue();
    this->commSlaveQueue = new MultiWorkQueue();
 
@@ -447,6 +456,10 @@ void App::initDataObjects()
    this->sessions = new SessionStore();
    this->mirroredSessions = new SessionStore();
 
+   if(cfg->getTuneMirrorForwardBatchSize() > 1)
+      mirrorForwardBatcher.reset(new MirrorForwardBatcher(cfg->getTuneMirrorForwardBatchSize(),
+         cfg->getTuneMirrorForwardBatchDelayUS(), APP_MIRRORFORWARD_MAX_INFLIGHT_BATCHES) );
+
    this->nodeOperationStats = new MetaNodeOpStats();
 
    this->isRootBuddyMirrored = false;
@@ -879,6 +892,12 @@ void App::initComponents(TargetConsistencyState initialConsistencyState)
 
    this->modificationEventFlusher = new ModificationEventFlusher();
 
+   if (cfg->getTuneChunkUnlinkQueueSize() )
+      this->chunkUnlinker = new ChunkUnlinker(cfg->getTuneChunkUnlinkQueueSize() );
+
+   if (cfg->getTuneTargetChooserNum() == TargetChooserType_LOADAWARE)
+      this->storageLoadsPoller = new StorageLoadsPoller();
+
    workersInit();
    commSlavesInit();
 
@@ -916,6 +935,12 @@ void App::startComponents()
 
    this->modificationEventFlusher->start();
 
+   if(chunkUnlinker)
+      this->chunkUnlinker->start();
+
+   if(storageLoadsPoller)
+      this->storageLoadsPoller->start();
+
    if(const auto wait = getConfig()->getTuneDisposalGCPeriod()) {
        this->gcQueue->enqueue(std::chrono::seconds(wait), disposalGarbageCollector);
    }
@@ -953,6 +978,12 @@ void App::stopComponents()
    if(internodeSyncer)
       internodeSyncer->selfTerminate();
 
+   if(chunkUnlinker)
+      chunkUnlinker->selfTerminate();
+
+   if(storageLoadsPoller)
+      storageLoadsPoller->selfTerminate();
+
    if(statsCollector)
       statsCollector->selfTerminate();
 
@@ -1028,6 +1059,8 @@ void App::joinComponents()
    streamListenersJoin();
 
    waitForComponentTermination(internodeSyncer);
+   waitForComponentTermination(chunkUnlinker); // (uses comm slaves)
+   waitForComponentTermination(storageLoadsPoller);
 
    commSlavesStop(); // placed here because otherwise it would keep workers from terminating
    commSlavesJoin();
@@ -1048,6 +1081,11 @@ void App::streamListenersInit()
       if(cfg->getTuneUseAggressiveStreamPoll() )
          listener->setUseAggressivePoll();
 
+      if(cfg->getTuneUseIoUringStreamPoll() )
+         listener->setUseIoUring();
+
+      listener->setMaxRunToCompletionMsgs(cfg->getTuneRunToCompletionMsgs() );
+
       streamLisVec.push_back(listener);
    }
 }
@@ -27,10 +27,12 @@
 #include <components/buddyresyncer/BuddyResyncer.h>
 #include <net/message/NetMessageFactory.h>
 #include <nodes/MetaNodeOpStats.h>
+#include <nodes/StorageNodeLoads.h>
 #include <session/SessionStore.h>
 #include <storage/DirInode.h>
 #include <storage/MetaStore.h>
 #include <storage/SyncedDiskAccessPath.h>
+#include <toolkit/MirrorForwardBatcher.h>
 
 
 
@@ -53,12 +55,16 @@ typedef StreamLisVec::iterator StreamLisVecIter;
 
 
 // forward declarations
+class ChunkUnlinker;
 class LogContext;
 class ModificationEventFlusher;
+class StorageLoadsPoller;
 
 
 class App : public AbstractApp
 {
+   friend class TestApp; // sets up the parts of the App that tests need (see meta/tests)
+
    public:
       App(int argc, char** argv);
       virtual ~App();
@@ -104,6 +110,7 @@ class App : public AbstractApp
       TargetStateStore* targetStateStore; // map storage targets to a state
       TargetStateStore* metaStateStore; // map mds targets (i.e. nodeIDs) to a state
       std::unique_ptr<StoragePoolStore> storagePoolStore; // stores (category) storage pools
+      std::unique_ptr<StorageNodeLoads> storageNodeLoads; // for the loadaware target chooser
 
       MultiWorkQueue* workQueue;
       MultiWorkQueue* commSlaveQueue;
@@ -117,6 +124,7 @@ class App : public AbstractApp
 
       SessionStore* sessions;
       SessionStore* mirroredSessions;
+      std::unique_ptr<MirrorForwardBatcher> mirrorForwardBatcher; // NULL if pipelining disabled
       AcknowledgmentStore* ackStore;
       MetaNodeOpStats* nodeOperationStats; // file system operation statistics
 
@@ -131,6 +139,8 @@ class App : public AbstractApp
       StatsCollector* statsCollector;
       InternodeSyncer* internodeSyncer;
       ModificationEventFlusher* modificationEventFlusher;
+      ChunkUnlinker* chunkUnlinker; // NULL if disabled
+      StorageLoadsPoller* storageLoadsPoller; // NULL if loadaware target chooser is disabled
       TimerQueue* timerQueue;
       TimerQueue* gcQueue;
 
@@ -406,6 +416,11 @@ class App : public AbstractApp
          return mirroredSessions;
       }
 
+      MirrorForwardBatcher* getMirrorForwardBatcher() const
+      {
+         return mirrorForwardBatcher.get();
+      }
+
       std::string getMetaPath() const
       {
          return metaPathStr;
@@ -471,6 +486,16 @@ class App : public AbstractApp
          return modificationEventFlusher;
       }
 
+      ChunkUnlinker* getChunkUnlinker() const
+      {
+         return chunkUnlinker;
+      }
+
+      StorageLoadsPoller* getStorageLoadsPoller() const
+      {
+         return storageLoadsPoller;
+      }
+
       WorkerList* getWorkers()
       {
          return &workerList;
@@ -496,6 +521,11 @@ class App : public AbstractApp
          return storagePoolStore.get();
       }
 
+      StorageNodeLoads* getStorageNodeLoads() const
+      {
+         return storageNodeLoads.get();
+      }
+
       FileEventLogger* getFileEventLogger()
       {
          return fileEventLogger.get();
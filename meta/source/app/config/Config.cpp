@@ -11,6 +11,7 @@
 #define TARGETCHOOSERTYPE_RANDOMROBIN_STR       "randomrobin"
 #define TARGETCHOOSERTYPE_RANDOMINTERNODE_STR   "randominternode"
 #define TARGETCHOOSERTYPE_RANDOMINTRANODE_STR   "randomintranode"
+#define TARGETCHOOSERTYPE_LOADAWARE_STR         "loadaware"
 
 
 Config::Config(int argc, char** argv):
@@ -66,6 +67,11 @@ void Config::loadDefaults(bool addDashes)
    configMapRedefine("tuneBindToNumaZone",         "");
    configMapRedefine("tuneListenerPrioShift",      "-1");
    configMapRedefine("tuneDirMetadataCacheLimit",  "1024");
+   configMapRedefine("tuneInodeStatCacheSize",     "0");
+   configMapRedefine("tuneNumFsckExportThreads",   "4");
+   configMapRedefine("tuneNumFsckExportStreams",   "4");
+   configMapRedefine("tuneDirEntryLockShards",     "0");
+   configMapRedefine("tuneChunkUnlinkQueueSize",   "0");
    configMapRedefine("tuneTargetChooser",          TARGETCHOOSERTYPE_RANDOMIZED_STR);
    configMapRedefine("tuneLockGrantWaitMS",        "333");
    configMapRedefine("tuneLockGrantNumRetries",    "15");
@@ -73,9 +79,15 @@ void Config::loadDefaults(bool addDashes)
    configMapRedefine("tuneEarlyUnlinkResponse",    "true");
    configMapRedefine("tuneUsePerUserMsgQueues",    "false");
    configMapRedefine("tuneUseAggressiveStreamPoll","false");
+   configMapRedefine("tuneUseIoUringStreamPoll",   "false");
+   configMapRedefine("tuneRunToCompletionMsgs",    "0");
    configMapRedefine("tuneNumResyncSlaves",        "12");
    configMapRedefine("tuneMirrorTimestamps",        "true");
+   configMapRedefine("tuneMirrorForwardBatchSize", "0");
+   configMapRedefine("tuneMirrorForwardBatchDelayUS", "0");
+   configMapRedefine("tuneSecondaryServesReads",   "false");
    configMapRedefine("tuneDisposalGCPeriod",       "0");
+   configMapRedefine("tuneInlineFileDataMaxSize",  "0");
 
    configMapRedefine("quotaEarlyChownResponse",    "true");
    configMapRedefine("quotaEnableEnforcement",     "false");
@@ -170,6 +182,16 @@ void Config::applyConfigMap(bool enableException, bool addDashes)
          tuneListenerPrioShift = StringTk::strToInt(iter->second);
       else if (iter->first == std::string("tuneDirMetadataCacheLimit"))
          tuneDirMetadataCacheLimit = StringTk::strToUInt(iter->second);
+      else if (iter->first == std::string("tuneInodeStatCacheSize"))
+         tuneInodeStatCacheSize = StringTk::strToUInt(iter->second);
+      else if (iter->first == std::string("tuneNumFsckExportThreads"))
+         tuneNumFsckExportThreads = StringTk::strToUInt(iter->second);
+      else if (iter->first == std::string("tuneNumFsckExportStreams"))
+         tuneNumFsckExportStreams = StringTk::strToUInt(iter->second);
+      else if (iter->first == std::string("tuneDirEntryLockShards"))
+         tuneDirEntryLockShards = StringTk::strToUInt(iter->second);
+      else if (iter->first == std::string("tuneChunkUnlinkQueueSize"))
+         tuneChunkUnlinkQueueSize = StringTk::strToUInt(iter->second);
       else if (iter->first == std::string("tuneTargetChooser"))
          tuneTargetChooser = iter->second;
       else if (iter->first == std::string("tuneLockGrantWaitMS"))
@@ -182,6 +204,10 @@ void Config::applyConfigMap(bool enableException, bool addDashes)
          tuneEarlyUnlinkResponse = StringTk::strToBool(iter->second);
       else if (iter->first == std::string("tuneUseAggressiveStreamPoll"))
          tuneUseAggressiveStreamPoll = StringTk::strToBool(iter->second);
+      else if (iter->first == std::string("tuneUseIoUringStreamPoll"))
+         tuneUseIoUringStreamPoll = StringTk::strToBool(iter->second);
+      else if (iter->first == std::string("tuneRunToCompletionMsgs"))
+         tuneRunToCompletionMsgs = StringTk::strToUInt(iter->second);
       else if (iter->first == std::string("tuneNumResyncSlaves"))
          this->tuneNumResyncSlaves = StringTk::strToUInt(iter->second);
       else if (iter->first == std::string("quotaEarlyChownResponse"))
@@ -204,8 +230,16 @@ void Config::applyConfigMap(bool enableException, bool addDashes)
          tuneUsePerUserMsgQueues = StringTk::strToBool(iter->second);
       else if (iter->first == std::string("tuneMirrorTimestamps"))
          tuneMirrorTimestamps = StringTk::strToBool(iter->second);
+      else if (iter->first == std::string("tuneMirrorForwardBatchSize"))
+         tuneMirrorForwardBatchSize = StringTk::strToUInt(iter->second);
+      else if (iter->first == std::string("tuneMirrorForwardBatchDelayUS"))
+         tuneMirrorForwardBatchDelayUS = StringTk::strToUInt(iter->second);
+      else if (iter->first == std::string("tuneSecondaryServesReads"))
+         tuneSecondaryServesReads = StringTk::strToBool(iter->second);
       else if(iter->first == std::string("tuneDisposalGCPeriod"))
           tuneDisposalGCPeriod = StringTk::strToUInt(iter->second);
+      else if (iter->first == std::string("tuneInlineFileDataMaxSize"))
+         tuneInlineFileDataMaxSize = StringTk::strToUInt(iter->second);
       else if (iter->first == std::string("sysFileEventLogTarget"))
          sysFileEventLogTarget = iter->second;
       else if (iter->first == std::string("sysFileEventPersistDirectory"))
@@ -303,6 +337,8 @@ void Config::initTuneTargetChooserNum()
       this->tuneTargetChooserNum = TargetChooserType_RANDOMROBIN;
    else if (this->tuneTargetChooser == TARGETCHOOSERTYPE_RANDOMINTERNODE_STR)
       this->tuneTargetChooserNum = TargetChooserType_RANDOMINTERNODE;
+   else if (this->tuneTargetChooser == TARGETCHOOSERTYPE_LOADAWARE_STR)
+      this->tuneTargetChooserNum = TargetChooserType_LOADAWARE;
    // Don't allow RANDOMINTRANODE Target Chooser
    else
    {
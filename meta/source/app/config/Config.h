@@ -11,6 +11,7 @@ enum TargetChooserType
    TargetChooserType_RANDOMROBIN = 2, // randomized round-robin (round-robin, but shuffle result)
    TargetChooserType_RANDOMINTERNODE = 3, // select random targets from different nodes/domains
    TargetChooserType_RANDOMINTRANODE = 4, // select random targets from the same node/domain
+   TargetChooserType_LOADAWARE = 5, // two random choices, less loaded storage server wins
 };
 
 
@@ -53,6 +54,11 @@ class Config : public AbstractConfig
       int               tuneBindToNumaZone; // bind all threads to this zone, -1 means no binding
       int               tuneListenerPrioShift; // inc/dec thread priority of listener components
       unsigned          tuneDirMetadataCacheLimit;
+      unsigned          tuneInodeStatCacheSize; // 0 disables the cache
+      unsigned          tuneNumFsckExportThreads; // hash dir walkers per streamed fsck request
+      unsigned          tuneNumFsckExportStreams; // max concurrent streamed fsck requests
+      unsigned          tuneDirEntryLockShards; // 0 or 1 disables parallel creates in a dir
+      unsigned          tuneChunkUnlinkQueueSize; // 0 disables background chunk unlink
       std::string       tuneTargetChooser;
       TargetChooserType tuneTargetChooserNum;  // auto-generated based on tuneTargetChooser
       unsigned          tuneLockGrantWaitMS; // time to wait for an ack per retry
@@ -61,9 +67,15 @@ class Config : public AbstractConfig
       bool              tuneEarlyUnlinkResponse; // true to send response before chunk files unlink
       bool              tuneUsePerUserMsgQueues; // true to use UserWorkContainer for MultiWorkQueue
       bool              tuneUseAggressiveStreamPoll; // true to not sleep on epoll in streamlisv2
+      bool              tuneUseIoUringStreamPoll; // true to use io_uring instead of epoll
+      unsigned          tuneRunToCompletionMsgs; // max back-to-back msgs per work (0 disables)
       unsigned          tuneNumResyncSlaves;
       bool              tuneMirrorTimestamps;
+      unsigned          tuneMirrorForwardBatchSize; // max msgs per batch to secondary (<2 disables)
+      unsigned          tuneMirrorForwardBatchDelayUS; // max wait for a batch to fill up
+      bool              tuneSecondaryServesReads; // true to serve client reads as buddy secondary
       unsigned          tuneDisposalGCPeriod; // sleep between disposal garbage collector runs [seconds], 0 = disabled
+      unsigned          tuneInlineFileDataMaxSize; // max data size of inline files (0 disables)
 
       bool              quotaEarlyChownResponse; // true to send response before chunk files chown
       bool              quotaEnableEnforcement;
@@ -207,6 +219,31 @@ class Config : public AbstractConfig
          return tuneDirMetadataCacheLimit;
       }
 
+      unsigned getTuneInodeStatCacheSize() const
+      {
+         return tuneInodeStatCacheSize;
+      }
+
+      unsigned getTuneNumFsckExportThreads() const
+      {
+         return tuneNumFsckExportThreads;
+      }
+
+      unsigned getTuneNumFsckExportStreams() const
+      {
+         return tuneNumFsckExportStreams;
+      }
+
+      unsigned getTuneDirEntryLockShards() const
+      {
+         return tuneDirEntryLockShards;
+      }
+
+      unsigned getTuneChunkUnlinkQueueSize() const
+      {
+         return tuneChunkUnlinkQueueSize;
+      }
+
       TargetChooserType getTuneTargetChooserNum() const
       {
          return tuneTargetChooserNum;
@@ -242,6 +279,16 @@ class Config : public AbstractConfig
          return tuneUseAggressiveStreamPoll;
       }
 
+      bool getTuneUseIoUringStreamPoll() const
+      {
+         return tuneUseIoUringStreamPoll;
+      }
+
+      unsigned getTuneRunToCompletionMsgs() const
+      {
+         return tuneRunToCompletionMsgs;
+      }
+
       unsigned getTuneNumResyncSlaves() const
       {
          return tuneNumResyncSlaves;
@@ -279,8 +326,16 @@ class Config : public AbstractConfig
 
       bool getTuneMirrorTimestamps() const { return tuneMirrorTimestamps; }
 
+      unsigned getTuneMirrorForwardBatchSize() const { return tuneMirrorForwardBatchSize; }
+
+      unsigned getTuneMirrorForwardBatchDelayUS() const { return tuneMirrorForwardBatchDelayUS; }
+
+      bool getTuneSecondaryServesReads() const { return tuneSecondaryServesReads; }
+
       unsigned getTuneDisposalGCPeriod() const { return tuneDisposalGCPeriod; }
 
+      unsigned getTuneInlineFileDataMaxSize() const { return tuneInlineFileDataMaxSize; }
+
       bool getSysAllowUserSetPattern() const { return sysAllowUserSetPattern; }
 
       bool getLimitXAttrListLength() const { return limitXAttrListLength; }
@@ -0,0 +1,345 @@
+#include <common/net/message/storage/creating/UnlinkLocalFilesMsg.h>
+#include <common/toolkit/SynchronizedCounter.h>
+#include <components/worker/UnlinkChunkFileWork.h>
+#include <components/worker/UnlinkLocalFilesWork.h>
+#include <net/msghelpers/MsgHelperUnlink.h>
+#include <program/Program.h>
+#include "ChunkUnlinker.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <mutex>
+
+
+/**
+ * @param retryBaseMS delay before the first retry of a file (doubled for each further retry).
+ */
+ChunkUnlinker::ChunkUnlinker(size_t maxQueueSize, unsigned retryBaseMS) :
+   PThread("ChunkUnlinker"),
+   log("ChunkUnlinker"),
+   maxQueueSize(maxQueueSize),
+   retryBaseMS(retryBaseMS)
+{
+}
+
+void ChunkUnlinker::run()
+{
+   try
+   {
+      registerSignalHandler();
+
+      unlinkLoop();
+
+      log.log(Log_DEBUG, "Component stopped.");
+   }
+   catch (std::exception& e)
+   {
+      PThread::getCurrentThreadApp()->handleComponentException(e);
+   }
+}
+
+/**
+ * Add an unlinked file to the disposal dir and queue it for the deletion of its chunk files.
+ *
+ * Note: Only for files with non-mirrored metadata.
+ *
+ * @param unlinkedInode will be deleted inside this method or owned by another object if this
+ *    returns true; caller still owns it if this returns false.
+ * @param msgUserID only used in msg header info.
+ * @return false if the queue is full (caller should unlink the chunks synchronously).
+ */
+bool ChunkUnlinker::enqueue(FileInode* unlinkedInode, unsigned msgUserID)
+{
+   if (unlikely(unlinkedInode->getIsBuddyMirrored() ) )
+      return false; // the disposal entry wouldn't be mirrored
+
+   {
+      const std::lock_guard<Mutex> lock(mutex);
+
+      /* note: the lock is released while the disposal entry is created, so the queue might grow
+         beyond maxQueueSize by up to the number of workers. */
+      if (queue.size() >= maxQueueSize)
+         return false;
+   }
+
+   Item item;
+
+   item.entryID = unlinkedInode->getEntryID();
+   item.pattern.reset(unlinkedInode->getStripePattern()->clone() );
+   unlinkedInode->getPathInfo(&item.pathInfo);
+   item.msgUserID = msgUserID;
+   item.numRetries = 0;
+   item.result = FhgfsOpsErr_SUCCESS;
+
+   // (if this fails, the chunks are still deleted, but a crash before that would leak them)
+   item.isPersisted = persistItem(unlinkedInode); // destructs unlinkedInode
+
+   const std::lock_guard<Mutex> lock(mutex);
+
+   queue.push_back(std::move(item) );
+   itemsAddedCond.signal();
+
+   return true;
+}
+
+void ChunkUnlinker::unlinkLoop()
+{
+   while (!getSelfTerminate() )
+      unlinkRound(CHUNKUNLINKER_IDLE_WAIT_MS);
+}
+
+/**
+ * Unlink the chunks of the retries that are due and of new files (up to CHUNKUNLINKER_BATCH_FILES
+ * files in total).
+ *
+ * @param idleWaitMS max time to wait for new files if there is nothing to do (0 to return
+ *    immediately).
+ */
+void ChunkUnlinker::unlinkRound(unsigned idleWaitMS)
+{
+   ItemList items;
+
+   // retries that are due first...
+
+   for (ItemListIter iter = retryItems.begin();
+        (iter != retryItems.end() ) && (items.size() < CHUNKUNLINKER_BATCH_FILES); )
+   {
+      ItemListIter nextIter = std::next(iter);
+
+      if (iter->lastTryT.elapsedMS() >= getRetryDelayMS(iter->numRetries) )
+         items.splice(items.end(), retryItems, iter);
+
+      iter = nextIter;
+   }
+
+   // ...then new items
+
+   {
+      const std::lock_guard<Mutex> lock(mutex);
+
+      if (idleWaitMS && items.empty() && queue.empty() )
+         itemsAddedCond.timedwait(&mutex, idleWaitMS);
+
+      while (!queue.empty() && (items.size() < CHUNKUNLINKER_BATCH_FILES) )
+         items.splice(items.end(), queue, queue.begin() );
+   }
+
+   if (items.empty() )
+      return;
+
+   unlinkBatched(items);
+
+   for (ItemListIter iter = items.begin(); iter != items.end(); )
+   {
+      ItemListIter nextIter = std::next(iter);
+
+      if (iter->result == FhgfsOpsErr_SUCCESS)
+         finishItem(*iter);
+      else
+      if (iter->numRetries < CHUNKUNLINKER_MAX_RETRIES)
+      {
+         iter->numRetries++;
+         iter->lastTryT.setToNow();
+
+         retryItems.splice(retryItems.end(), items, iter);
+      }
+      else
+      {
+         LOG(GENERAL, ERR, "Failed to delete all chunk files. Giving up; the file stays in the "
+               "disposal directory.", ("entryID", iter->entryID),
+               ("error", boost::lexical_cast<std::string>(iter->result) ) );
+      }
+
+      iter = nextIter;
+   }
+}
+
+/**
+ * Delete the chunks of the given files and set their results.
+ *
+ * Chunks of first tries are grouped by storage node and sent in UnlinkLocalFilesMsgs (all nodes in
+ * parallel); buddy mirrored chunks and retries are unlinked per chunk.
+ */
+void ChunkUnlinker::unlinkBatched(ItemList& items)
+{
+   std::map<NumNodeID, std::list<NodeBatch>> nodeBatches; // back() of each list is being filled
+   std::vector<NodeBatch*> batches;
+
+   for (ItemListIter iter = items.begin(); iter != items.end(); iter++)
+   {
+      iter->result = FhgfsOpsErr_SUCCESS;
+
+      if (iter->numRetries || (iter->pattern->getPatternType() == StripePatternType_BuddyMirror) )
+      {
+         unlinkSingle(*iter);
+         continue;
+      }
+
+      const UInt16Vector* targetIDs = iter->pattern->getStripeTargetIDs();
+
+      for (UInt16VectorConstIter targetIter = targetIDs->begin(); targetIter != targetIDs->end();
+           targetIter++)
+      {
+         const NumNodeID nodeID = getStorageNodeID(*targetIter);
+         if (!nodeID)
+         { /* not an error for unlink to allow easy deletion of files after intentional target
+              removal (see MsgHelperUnlink) */
+            LOG(GENERAL, WARNING, "Unable to resolve storage node of target.", *targetIter);
+            continue;
+         }
+
+         std::list<NodeBatch>& nodeBatchList = nodeBatches[nodeID];
+
+         if (nodeBatchList.empty() ||
+             (nodeBatchList.back().entries.size() >= UNLINKLOCALFILESMSG_MAX_ENTRIES) )
+         {
+            nodeBatchList.emplace_back();
+            nodeBatchList.back().nodeID = nodeID;
+            batches.push_back(&nodeBatchList.back() );
+         }
+
+         nodeBatchList.back().entries.emplace_back(iter->entryID, *targetIter, iter->pathInfo);
+         nodeBatchList.back().entryItems.push_back(&*iter);
+      }
+   }
+
+   if (batches.empty() )
+      return;
+
+   unlinkNodeBatches(batches);
+
+   // assign the results to the items
+
+   for (auto batchIter = batches.begin(); batchIter != batches.end(); batchIter++)
+   {
+      NodeBatch& batch = **batchIter;
+
+      for (size_t i = 0; i < batch.results.size(); i++)
+      {
+         const FhgfsOpsErr result = batch.results[i];
+         Item* item = batch.entryItems[i];
+
+         if ( (result != FhgfsOpsErr_SUCCESS) && (result != FhgfsOpsErr_UNKNOWNNODE) &&
+              (result != FhgfsOpsErr_UNKNOWNTARGET) && (item->result == FhgfsOpsErr_SUCCESS) )
+            item->result = result;
+      }
+   }
+}
+
+/**
+ * Add the disposal entry of a file before it is queued.
+ *
+ * @param unlinkedInode will be deleted inside this method or owned by another object.
+ * @return true if the disposal entry was created.
+ */
+bool ChunkUnlinker::persistItem(FileInode* unlinkedInode)
+{
+   FhgfsOpsErr insertRes = Program::getApp()->getMetaStore()->insertDisposableFile(
+      unlinkedInode); // destructs unlinkedInode
+
+   return insertRes == FhgfsOpsErr_SUCCESS;
+}
+
+/**
+ * @return storage node of the given target; invalid ID if unknown.
+ */
+NumNodeID ChunkUnlinker::getStorageNodeID(uint16_t targetID)
+{
+   return Program::getApp()->getTargetMapper()->getNodeID(targetID);
+}
+
+/**
+ * Send one UnlinkLocalFilesMsg per batch (all in parallel) and set the results of the batches.
+ */
+void ChunkUnlinker::unlinkNodeBatches(std::vector<NodeBatch*>& batches)
+{
+   App* app = Program::getApp();
+   NodeStoreServers* storageNodes = app->getStorageNodes();
+   MultiWorkQueue* slaveQ = app->getCommSlaveQueue();
+
+   SynchronizedCounter counter;
+   size_t numWorks = 0;
+
+   for (auto batchIter = batches.begin(); batchIter != batches.end(); batchIter++)
+   {
+      NodeBatch& batch = **batchIter;
+
+      NodeHandle node = storageNodes->referenceNode(batch.nodeID);
+      if (!node)
+      { // same as unknown target
+         LOG(GENERAL, WARNING, "Unknown storage node.", batch.nodeID);
+
+         batch.results.assign(batch.entries.size(), FhgfsOpsErr_UNKNOWNNODE);
+         continue;
+      }
+
+      slaveQ->addDirectWork(new UnlinkLocalFilesWork(std::move(node), &batch.entries,
+         &batch.results, &counter) );
+      numWorks++;
+   }
+
+   counter.waitForCount(numWorks);
+}
+
+/**
+ * Delete the chunks of a single file with one UnlinkLocalFileMsg per chunk (like
+ * MsgHelperUnlink::unlinkChunkFileParallel() ).
+ */
+void ChunkUnlinker::unlinkSingle(Item& item)
+{
+   MultiWorkQueue* slaveQ = Program::getApp()->getCommSlaveQueue();
+   const UInt16Vector* targetIDs = item.pattern->getStripeTargetIDs();
+
+   const size_t numTargetWorks = targetIDs->size();
+
+   FhgfsOpsErrVec nodeResults(numTargetWorks);
+   SynchronizedCounter counter;
+
+   for (size_t i = 0; i < numTargetWorks; i++)
+   {
+      UnlinkChunkFileWork* work = new UnlinkChunkFileWork(item.entryID, item.pattern.get(),
+         (*targetIDs)[i], &item.pathInfo, &nodeResults[i], &counter);
+
+      work->setMsgUserID(item.msgUserID);
+
+      slaveQ->addDirectWork(work);
+   }
+
+   counter.waitForCount(numTargetWorks);
+
+   for (size_t i = 0; i < numTargetWorks; i++)
+   {
+      if ( (nodeResults[i] != FhgfsOpsErr_SUCCESS) &&
+           (nodeResults[i] != FhgfsOpsErr_UNKNOWNNODE) &&
+           (nodeResults[i] != FhgfsOpsErr_UNKNOWNTARGET) )
+      {
+         item.result = nodeResults[i];
+         return;
+      }
+   }
+}
+
+/**
+ * Remove the disposal entry of a file whose chunks are deleted.
+ */
+void ChunkUnlinker::finishItem(Item& item)
+{
+   if (!item.isPersisted)
+      return;
+
+   std::unique_ptr<FileInode> unlinkedInode;
+   unsigned numHardlinks; // not used here
+
+   FhgfsOpsErr unlinkRes = MsgHelperUnlink::unlinkMetaFile(*Program::getApp()->getDisposalDir(),
+      item.entryID, &unlinkedInode, numHardlinks);
+
+   // (the disposal garbage collection might have been faster)
+   if ( (unlinkRes != FhgfsOpsErr_SUCCESS) && (unlinkRes != FhgfsOpsErr_PATHNOTEXISTS) )
+      LOG(GENERAL, WARNING, "Failed to remove disposal entry.", ("entryID", item.entryID),
+            ("error", boost::lexical_cast<std::string>(unlinkRes) ) );
+}
+
+unsigned ChunkUnlinker::getRetryDelayMS(unsigned numRetries) const
+{
+   return retryBaseMS << (numRetries ? numRetries - 1 : 0);
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <common/app/log/LogContext.h>
+#include <common/net/message/storage/creating/UnlinkLocalFilesMsg.h>
+#include <common/storage/striping/StripePattern.h>
+#include <common/storage/PathInfo.h>
+#include <common/threading/Condition.h>
+#include <common/threading/Mutex.h>
+#include <common/threading/PThread.h>
+#include <common/toolkit/Time.h>
+#include <common/Common.h>
+
+#include <memory>
+
+
+#define CHUNKUNLINKER_BATCH_FILES         4096 // max files per round (chunks are grouped per node)
+#define CHUNKUNLINKER_MAX_RETRIES         5
+#define CHUNKUNLINKER_RETRY_BASE_MS       1000 // doubled for each retry
+#define CHUNKUNLINKER_IDLE_WAIT_MS        1000
+
+
+class FileInode;
+
+/**
+ * Deletes the chunk files of unlinked files in the background, so that unlinks only have to wait
+ * for the metadata.
+ *
+ * Queued files are persisted as entries of the disposal dir first, so nothing is lost if the
+ * server stops before the chunks are deleted (leftovers are removed by the disposal garbage
+ * collection or "beegfs-ctl --disposeunused" later, as for failed synchronous unlinks).
+ *
+ * In each round, the chunks of up to CHUNKUNLINKER_BATCH_FILES files are grouped by storage node
+ * and sent as one UnlinkLocalFilesMsg per node (buddy mirrored chunks need forwarding to the
+ * secondary and thus use one UnlinkLocalFileMsg per chunk). Files with errors are retried with
+ * single-chunk messages (which also works with old storage servers) and exponential backoff.
+ *
+ * The queue is bounded; enqueue() fails if it is full, so that callers fall back to synchronous
+ * unlinks, which slows down unlinks to the rate at which the storage servers delete chunks.
+ */
+class ChunkUnlinker : public PThread
+{
+   public:
+      ChunkUnlinker(size_t maxQueueSize, unsigned retryBaseMS = CHUNKUNLINKER_RETRY_BASE_MS);
+
+      bool enqueue(FileInode* unlinkedInode, unsigned msgUserID);
+
+
+   protected:
+      struct Item
+      {
+         std::string entryID;
+         std::unique_ptr<StripePattern> pattern;
+         PathInfo pathInfo;
+         bool isPersisted; // true if the disposal entry was created
+         unsigned msgUserID;
+
+         unsigned numRetries;
+         Time lastTryT;
+
+         FhgfsOpsErr result; // of the current round
+      };
+
+      /**
+       * Chunks of one storage node for one UnlinkLocalFilesMsg.
+       */
+      struct NodeBatch
+      {
+         NumNodeID nodeID;
+         UnlinkLocalFilesEntryVec entries;
+         std::vector<Item*> entryItems; // item of each entry
+         FhgfsOpsErrVec results; // one per entry, set by unlinkNodeBatches()
+      };
+
+      typedef std::list<Item> ItemList;
+      typedef ItemList::iterator ItemListIter;
+
+      void unlinkRound(unsigned idleWaitMS);
+      unsigned getRetryDelayMS(unsigned numRetries) const;
+
+      virtual bool persistItem(FileInode* unlinkedInode);
+      virtual NumNodeID getStorageNodeID(uint16_t targetID);
+      virtual void unlinkNodeBatches(std::vector<NodeBatch*>& batches);
+      virtual void unlinkSingle(Item& item);
+      virtual void finishItem(Item& item);
+
+
+   private:
+      LogContext log;
+
+      const size_t maxQueueSize;
+      const unsigned retryBaseMS;
+
+      Mutex mutex; // protects queue
+      Condition itemsAddedCond;
+      ItemList queue;
+
+      ItemList retryItems; // only accessed by the unlinker thread
+
+      virtual void run();
+      void unlinkLoop();
+
+      void unlinkBatched(ItemList& items);
+};
@@ -0,0 +1,275 @@
+#include <common/net/message/fsck/StreamFsckDirEntriesRespMsg.h>
+#include <common/toolkit/MessagingTk.h>
+#include <program/Program.h>
+#include <toolkit/StorageTkEx.h>
+#include "FsckDirEntryExporter.h"
+
+#include <boost/lexical_cast.hpp>
+
+
+FsckDirEntryExporter::FsckDirEntryExporter(Socket* sock, unsigned hashDirStart,
+   unsigned hashDirEnd, bool isBuddyMirrored, NumNodeID saveNodeID, unsigned msgUserID) :
+   sock(sock), hashDirStart(hashDirStart), hashDirEnd(hashDirEnd),
+   isBuddyMirrored(isBuddyMirrored), saveNodeID(saveNodeID), msgUserID(msgUserID),
+   result(FhgfsOpsErr_SUCCESS)
+{
+}
+
+/**
+ * Walk all hash dirs of the range with the given number of threads and wait for them.
+ *
+ * @return FhgfsOpsErr_COMMUNICATION if sending a batch failed (the stream is broken then and the
+ *    connection should be closed); otherwise the first error that occurred while reading the hash
+ *    dirs (all other hash dirs are still exported in that case).
+ */
+FhgfsOpsErr FsckDirEntryExporter::run(unsigned numThreads)
+{
+   if (hashDirEnd < hashDirStart)
+      return FhgfsOpsErr_INVAL;
+
+   numThreads = BEEGFS_MAX(1u, BEEGFS_MIN(numThreads, hashDirEnd - hashDirStart + 1) );
+
+   std::vector<std::unique_ptr<Slave>> slaves;
+
+   for (unsigned i = 0; i < numThreads; i++)
+   {
+      std::unique_ptr<Slave> slave(new Slave(*this, i, numThreads) );
+
+      try
+      {
+         slave->start();
+      }
+      catch (PThreadCreateException& e)
+      {
+         LOG(GENERAL, ERR, "Unable to start fsck dir entry export thread.", ("error", e.what()));
+         setError(FhgfsOpsErr_INTERNAL);
+         break;
+      }
+
+      slaves.push_back(std::move(slave) );
+   }
+
+   for (auto iter = slaves.begin(); iter != slaves.end(); iter++)
+      (*iter)->join();
+
+   return result;
+}
+
+/**
+ * Send one batch over the stream.
+ *
+ * @return false if the stream is broken (by this or any other slave), so that all slaves stop.
+ */
+bool FsckDirEntryExporter::sendBatch(FsckContDirList& contDirs, FsckDirEntryList& dirEntries,
+   FsckFileInodeList& inlinedFileInodes)
+{
+   StreamFsckDirEntriesRespMsg batchMsg(&contDirs, &dirEntries, &inlinedFileInodes, false,
+      FhgfsOpsErr_SUCCESS);
+
+   const auto sendBuf = MessagingTk::createMsgVec(batchMsg);
+
+   const std::lock_guard<Mutex> lock(mutex);
+
+   if (result == FhgfsOpsErr_COMMUNICATION)
+      return false;
+
+   try
+   {
+      sock->send(&sendBuf[0], sendBuf.size(), 0);
+   }
+   catch (SocketException& e)
+   {
+      LOG(GENERAL, ERR, "Unable to send dir entries to fsck.", ("peer", sock->getPeername()),
+            ("error", e.what()));
+      result = FhgfsOpsErr_COMMUNICATION;
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Remember the error for the final message of the stream. A broken stream takes precedence over
+ * errors while reading the hash dirs.
+ */
+void FsckDirEntryExporter::setError(FhgfsOpsErr error)
+{
+   const std::lock_guard<Mutex> lock(mutex);
+
+   if (result == FhgfsOpsErr_SUCCESS || error == FhgfsOpsErr_COMMUNICATION)
+      result = error;
+}
+
+bool FsckDirEntryExporter::hasFailed()
+{
+   const std::lock_guard<Mutex> lock(mutex);
+
+   return result == FhgfsOpsErr_COMMUNICATION;
+}
+
+/**
+ * Read the IDs of all content dirs in a hash dir (in a single readdir pass).
+ */
+FhgfsOpsErr FsckDirEntryExporter::readContDirIDs(unsigned hashDirNum, StringList& outContDirIDs)
+{
+   int64_t lastOffset; // (unused, the whole dir is read at once)
+
+   return StorageTkEx::getContDirIDsIncremental(hashDirNum, isBuddyMirrored, 0, ~0u,
+      &outContDirIDs, &lastOffset);
+}
+
+/**
+ * Read the names of all dir entries in a content dir (in a single readdir pass).
+ */
+FhgfsOpsErr FsckDirEntryExporter::readDirEntryNames(const std::string& contDirID,
+   StringList& outNames)
+{
+   MetaStore* metaStore = Program::getApp()->getMetaStore();
+
+   int64_t lastOffset; // (unused, the whole dir is read at once)
+
+   return metaStore->getFsckDirEntryNames(contDirID, isBuddyMirrored, 0, ~0u, &outNames,
+      &lastOffset);
+}
+
+/**
+ * Load the dir entries of a batch of names returned by readDirEntryNames().
+ */
+void FsckDirEntryExporter::readDirEntries(const std::string& contDirID,
+   StringListConstIter start, StringListConstIter end, FsckDirEntryList& outDirEntries,
+   FsckFileInodeList& outInlinedFileInodes)
+{
+   MetaStore* metaStore = Program::getApp()->getMetaStore();
+
+   metaStore->getFsckDirEntries(contDirID, start, end, isBuddyMirrored, msgUserID,
+      &outDirEntries, &outInlinedFileInodes);
+}
+
+
+FsckDirEntryExporter::Slave::Slave(FsckDirEntryExporter& exporter, unsigned sliceIndex,
+   unsigned numSlices) :
+   PThread("FsckExportDentry" + StringTk::uintToStr(sliceIndex) ),
+   exporter(exporter), sliceIndex(sliceIndex), numSlices(numSlices)
+{
+}
+
+void FsckDirEntryExporter::Slave::run()
+{
+   try
+   {
+      for (unsigned firstLevelHashDir = exporter.hashDirStart + sliceIndex;
+         firstLevelHashDir <= exporter.hashDirEnd; firstLevelHashDir += numSlices)
+      {
+         for (unsigned secondLevelHashDir = 0;
+            secondLevelHashDir < META_DENTRIES_LEVEL2_SUBDIR_NUM; secondLevelHashDir++)
+         {
+            if (!exportHashDir(StorageTk::mergeHashDirs(firstLevelHashDir, secondLevelHashDir) ) )
+               return;
+         }
+      }
+
+      // the last batch of this slave is usually not full
+      if (!contDirs.empty() || !dirEntries.empty() )
+         sendBatch();
+   }
+   catch (std::exception& e)
+   {
+      LOG(GENERAL, ERR, "Fsck dir entry export failed.", ("error", e.what()));
+      exporter.setError(FhgfsOpsErr_INTERNAL);
+   }
+}
+
+/**
+ * @return false if the stream is broken and the export should be stopped.
+ */
+bool FsckDirEntryExporter::Slave::exportHashDir(unsigned hashDirNum)
+{
+   StringList contDirIDs;
+
+   FhgfsOpsErr readRes = exporter.readContDirIDs(hashDirNum, contDirIDs);
+   if (readRes != FhgfsOpsErr_SUCCESS)
+   {
+      LOG(GENERAL, ERR, "Failed to read content dirs from hash dir.", hashDirNum,
+            ("error", boost::lexical_cast<std::string>(readRes)));
+      exporter.setError(readRes);
+      return !exporter.hasFailed();
+   }
+
+   for (auto iter = contDirIDs.begin(); iter != contDirIDs.end(); iter++)
+   {
+      if (!exportContDir(*iter) )
+         return false;
+   }
+
+   return true;
+}
+
+/**
+ * Add the content dir and its entries to the current batch and send the batch whenever it is
+ * full, so the entries of a large dir may be spread over several batches.
+ *
+ * @return false if the stream is broken and the export should be stopped.
+ */
+bool FsckDirEntryExporter::Slave::exportContDir(const std::string& contDirID)
+{
+   // (many empty dirs would fill a batch, too)
+   if (contDirs.size() >= STREAMFSCKDIRENTRIES_BATCH_SIZE)
+   {
+      if (!sendBatch() )
+         return false;
+   }
+
+   contDirs.push_back(FsckContDir(contDirID, exporter.saveNodeID, exporter.isBuddyMirrored) );
+
+   StringList names;
+
+   FhgfsOpsErr readRes = exporter.readDirEntryNames(contDirID, names);
+   if (readRes != FhgfsOpsErr_SUCCESS)
+   {
+      // (the paged retrieval also skips such dirs, but doesn't report it)
+      LOG(GENERAL, WARNING, "Could not list contents of directory.", ("entryID", contDirID),
+            ("error", boost::lexical_cast<std::string>(readRes)));
+      exporter.setError(readRes);
+      return !exporter.hasFailed();
+   }
+
+   auto batchStart = names.begin();
+
+   while (batchStart != names.end() )
+   {
+      auto batchEnd = batchStart;
+
+      for (size_t i = dirEntries.size();
+         i < STREAMFSCKDIRENTRIES_BATCH_SIZE && batchEnd != names.end(); i++)
+         batchEnd++;
+
+      exporter.readDirEntries(contDirID, batchStart, batchEnd, dirEntries, inlinedFileInodes);
+
+      // (entries that couldn't be read are skipped, so the batch may still have room)
+      if (batchEnd != names.end() || dirEntries.size() >= STREAMFSCKDIRENTRIES_BATCH_SIZE)
+      {
+         if (!sendBatch() )
+            return false;
+      }
+
+      batchStart = batchEnd;
+   }
+
+   return true;
+}
+
+/**
+ * Send and clear the current batch.
+ *
+ * @return false if the stream is broken and the export should be stopped.
+ */
+bool FsckDirEntryExporter::Slave::sendBatch()
+{
+   bool sendRes = exporter.sendBatch(contDirs, dirEntries, inlinedFileInodes);
+
+   contDirs.clear();
+   dirEntries.clear();
+   inlinedFileInodes.clear();
+
+   return sendRes;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <common/fsck/FsckContDir.h>
+#include <common/fsck/FsckDirEntry.h>
+#include <common/fsck/FsckFileInode.h>
+#include <common/net/sock/Socket.h>
+#include <common/threading/Mutex.h>
+#include <common/threading/PThread.h>
+#include <common/Common.h>
+
+
+/**
+ * Streams all dir entries (with their content dirs and inlined file inodes) of a range of
+ * top-level hash dirs to fsck (see StreamFsckDirEntriesMsg).
+ *
+ * Works like FsckInodeExporter: several slave threads walk disjoint sets of top-level hash dirs,
+ * each hash dir and each content dir is read in a single readdir pass (no seekdir per batch like
+ * RetrieveDirEntriesMsg), the entries are converted in batches and each batch is sent as its own
+ * StreamFsckDirEntriesRespMsg over the socket of the request.
+ *
+ * The final message of the stream (isLast) is sent by the caller after run() returned. The
+ * number of concurrent streams is limited by FsckInodeExporter::StreamSlot (shared with the
+ * inode streams).
+ */
+class FsckDirEntryExporter
+{
+   public:
+      FsckDirEntryExporter(Socket* sock, unsigned hashDirStart, unsigned hashDirEnd,
+         bool isBuddyMirrored, NumNodeID saveNodeID, unsigned msgUserID);
+      virtual ~FsckDirEntryExporter() {}
+
+      FhgfsOpsErr run(unsigned numThreads);
+
+
+   protected:
+      virtual FhgfsOpsErr readContDirIDs(unsigned hashDirNum, StringList& outContDirIDs);
+      virtual FhgfsOpsErr readDirEntryNames(const std::string& contDirID,
+         StringList& outNames);
+      virtual void readDirEntries(const std::string& contDirID, StringListConstIter start,
+         StringListConstIter end, FsckDirEntryList& outDirEntries,
+         FsckFileInodeList& outInlinedFileInodes);
+
+
+   private:
+      class Slave : public PThread
+      {
+         public:
+            Slave(FsckDirEntryExporter& exporter, unsigned sliceIndex, unsigned numSlices);
+
+         private:
+            FsckDirEntryExporter& exporter;
+            unsigned sliceIndex; // this slave walks every numSlices-th top-level hash dir...
+            unsigned numSlices; // ... starting at hashDirStart + sliceIndex
+
+            // the batch that is currently filled
+            FsckContDirList contDirs;
+            FsckDirEntryList dirEntries;
+            FsckFileInodeList inlinedFileInodes;
+
+            virtual void run();
+
+            bool exportHashDir(unsigned hashDirNum);
+            bool exportContDir(const std::string& contDirID);
+            bool sendBatch();
+      };
+
+      Socket* sock;
+      const unsigned hashDirStart;
+      const unsigned hashDirEnd; // inclusive
+      const bool isBuddyMirrored;
+      const NumNodeID saveNodeID; // node ID or buddy group ID (if isBuddyMirrored) for fsck
+      const unsigned msgUserID;
+
+      Mutex mutex; // protects sock and result
+      FhgfsOpsErr result; // first error of any slave
+
+      bool sendBatch(FsckContDirList& contDirs, FsckDirEntryList& dirEntries,
+         FsckFileInodeList& inlinedFileInodes);
+      void setError(FhgfsOpsErr error);
+      bool hasFailed();
+};
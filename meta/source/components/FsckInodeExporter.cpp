@@ -0,0 +1,227 @@
+#include <common/net/message/fsck/StreamFsckInodesRespMsg.h>
+#include <common/toolkit/MessagingTk.h>
+#include <program/Program.h>
+#include "FsckInodeExporter.h"
+
+#include <boost/lexical_cast.hpp>
+
+
+Mutex FsckInodeExporter::StreamSlot::mutex;
+unsigned FsckInodeExporter::StreamSlot::numActiveStreams = 0;
+
+/**
+ * @param maxStreams max number of streams that may run at the same time (including this one).
+ */
+FsckInodeExporter::StreamSlot::StreamSlot(unsigned maxStreams) : acquired(false)
+{
+   const std::lock_guard<Mutex> lock(mutex);
+
+   if (numActiveStreams < maxStreams)
+   {
+      numActiveStreams++;
+      acquired = true;
+   }
+}
+
+FsckInodeExporter::StreamSlot::~StreamSlot()
+{
+   if (!acquired)
+      return;
+
+   const std::lock_guard<Mutex> lock(mutex);
+
+   numActiveStreams--;
+}
+
+
+FsckInodeExporter::FsckInodeExporter(Socket* sock, unsigned hashDirStart, unsigned hashDirEnd,
+   bool isBuddyMirrored) :
+   sock(sock), hashDirStart(hashDirStart), hashDirEnd(hashDirEnd),
+   isBuddyMirrored(isBuddyMirrored), result(FhgfsOpsErr_SUCCESS)
+{
+}
+
+/**
+ * Walk all hash dirs of the range with the given number of threads and wait for them.
+ *
+ * @return FhgfsOpsErr_COMMUNICATION if sending a batch failed (the stream is broken then and the
+ *    connection should be closed); otherwise the first error that occurred while reading the hash
+ *    dirs (all other hash dirs are still exported in that case).
+ */
+FhgfsOpsErr FsckInodeExporter::run(unsigned numThreads)
+{
+   if (hashDirEnd < hashDirStart)
+      return FhgfsOpsErr_INVAL;
+
+   numThreads = BEEGFS_MAX(1u, BEEGFS_MIN(numThreads, hashDirEnd - hashDirStart + 1) );
+
+   std::vector<std::unique_ptr<Slave>> slaves;
+
+   for (unsigned i = 0; i < numThreads; i++)
+   {
+      std::unique_ptr<Slave> slave(new Slave(*this, i, numThreads) );
+
+      try
+      {
+         slave->start();
+      }
+      catch (PThreadCreateException& e)
+      {
+         LOG(GENERAL, ERR, "Unable to start fsck inode export thread.", ("error", e.what()));
+         setError(FhgfsOpsErr_INTERNAL);
+         break;
+      }
+
+      slaves.push_back(std::move(slave) );
+   }
+
+   for (auto iter = slaves.begin(); iter != slaves.end(); iter++)
+      (*iter)->join();
+
+   return result;
+}
+
+/**
+ * Send one batch over the stream.
+ *
+ * @return false if the stream is broken (by this or any other slave), so that all slaves stop.
+ */
+bool FsckInodeExporter::sendBatch(FsckFileInodeList& fileInodes, FsckDirInodeList& dirInodes)
+{
+   StreamFsckInodesRespMsg batchMsg(&fileInodes, &dirInodes, false, FhgfsOpsErr_SUCCESS);
+
+   const auto sendBuf = MessagingTk::createMsgVec(batchMsg);
+
+   const std::lock_guard<Mutex> lock(mutex);
+
+   if (result == FhgfsOpsErr_COMMUNICATION)
+      return false;
+
+   try
+   {
+      sock->send(&sendBuf[0], sendBuf.size(), 0);
+   }
+   catch (SocketException& e)
+   {
+      LOG(GENERAL, ERR, "Unable to send inodes to fsck.", ("peer", sock->getPeername()),
+            ("error", e.what()));
+      result = FhgfsOpsErr_COMMUNICATION;
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Remember the error for the final message of the stream. A broken stream takes precedence over
+ * errors while reading the hash dirs.
+ */
+void FsckInodeExporter::setError(FhgfsOpsErr error)
+{
+   const std::lock_guard<Mutex> lock(mutex);
+
+   if (result == FhgfsOpsErr_SUCCESS || error == FhgfsOpsErr_COMMUNICATION)
+      result = error;
+}
+
+/**
+ * Read the IDs of all inodes in a hash dir (in a single readdir pass).
+ */
+FhgfsOpsErr FsckInodeExporter::readEntryIDs(unsigned firstLevelHashDir,
+   unsigned secondLevelHashDir, StringList& outEntryIDs)
+{
+   MetaStore* metaStore = Program::getApp()->getMetaStore();
+
+   int64_t lastOffset; // (unused, the whole dir is read at once)
+
+   return metaStore->getAllEntryIDFilesIncremental(firstLevelHashDir, secondLevelHashDir, 0, ~0u,
+      &outEntryIDs, &lastOffset, isBuddyMirrored);
+}
+
+/**
+ * Load the inodes of a batch of entry IDs returned by readEntryIDs().
+ */
+void FsckInodeExporter::readInodes(StringListConstIter start, StringListConstIter end,
+   FsckDirInodeList& outDirInodes, FsckFileInodeList& outFileInodes)
+{
+   MetaStore* metaStore = Program::getApp()->getMetaStore();
+
+   metaStore->getFsckInodes(start, end, isBuddyMirrored, &outDirInodes, &outFileInodes);
+}
+
+bool FsckInodeExporter::hasFailed()
+{
+   const std::lock_guard<Mutex> lock(mutex);
+
+   return result == FhgfsOpsErr_COMMUNICATION;
+}
+
+
+FsckInodeExporter::Slave::Slave(FsckInodeExporter& exporter, unsigned sliceIndex,
+   unsigned numSlices) :
+   PThread("FsckExport" + StringTk::uintToStr(sliceIndex) ),
+   exporter(exporter), sliceIndex(sliceIndex), numSlices(numSlices)
+{
+}
+
+void FsckInodeExporter::Slave::run()
+{
+   try
+   {
+      for (unsigned firstLevelHashDir = exporter.hashDirStart + sliceIndex;
+         firstLevelHashDir <= exporter.hashDirEnd; firstLevelHashDir += numSlices)
+      {
+         for (unsigned secondLevelHashDir = 0; secondLevelHashDir < META_INODES_LEVEL2_SUBDIR_NUM;
+            secondLevelHashDir++)
+         {
+            if (!exportHashDir(firstLevelHashDir, secondLevelHashDir) )
+               return;
+         }
+      }
+   }
+   catch (std::exception& e)
+   {
+      LOG(GENERAL, ERR, "Fsck inode export failed.", ("error", e.what()));
+      exporter.setError(FhgfsOpsErr_INTERNAL);
+   }
+}
+
+/**
+ * @return false if the stream is broken and the export should be stopped.
+ */
+bool FsckInodeExporter::Slave::exportHashDir(unsigned firstLevelHashDir,
+   unsigned secondLevelHashDir)
+{
+   StringList entryIDs;
+
+   FhgfsOpsErr readRes = exporter.readEntryIDs(firstLevelHashDir, secondLevelHashDir, entryIDs);
+   if (readRes != FhgfsOpsErr_SUCCESS)
+   {
+      LOG(GENERAL, ERR, "Failed to read inodes from hash dir.", firstLevelHashDir,
+            secondLevelHashDir, ("error", boost::lexical_cast<std::string>(readRes)));
+      exporter.setError(readRes);
+      return !exporter.hasFailed();
+   }
+
+   auto batchStart = entryIDs.begin();
+
+   while (batchStart != entryIDs.end() )
+   {
+      auto batchEnd = batchStart;
+
+      for (unsigned i = 0; i < STREAMFSCKINODES_BATCH_SIZE && batchEnd != entryIDs.end(); i++)
+         batchEnd++;
+
+      FsckFileInodeList fileInodes;
+      FsckDirInodeList dirInodes;
+
+      exporter.readInodes(batchStart, batchEnd, dirInodes, fileInodes);
+
+      if (!exporter.sendBatch(fileInodes, dirInodes) )
+         return false;
+
+      batchStart = batchEnd;
+   }
+
+   return true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <common/fsck/FsckDirInode.h>
+#include <common/fsck/FsckFileInode.h>
+#include <common/net/sock/Socket.h>
+#include <common/threading/Mutex.h>
+#include <common/threading/PThread.h>
+#include <common/Common.h>
+
+
+/**
+ * Streams all inodes of a range of top-level hash dirs to fsck (see StreamFsckInodesMsg).
+ *
+ * Several slave threads walk disjoint sets of top-level hash dirs. Each hash dir is read in a
+ * single readdir pass (no seekdir per batch like RetrieveInodesMsg), the inodes are converted in
+ * batches and each batch is sent as its own StreamFsckInodesRespMsg over the socket of the
+ * request. Only the sending is serialized; reading and converting inodes runs in parallel.
+ *
+ * The final message of the stream (isLast) is sent by the caller after run() returned.
+ *
+ * Each stream occupies the worker that handles the request until the export is done, so the
+ * number of concurrent streams is limited (see StreamSlot).
+ */
+class FsckInodeExporter
+{
+   public:
+      /**
+       * Reserves one of the limited export stream slots for its lifetime (if one is free).
+       */
+      class StreamSlot
+      {
+         public:
+            StreamSlot(unsigned maxStreams);
+            ~StreamSlot();
+
+            StreamSlot(const StreamSlot&) = delete;
+            StreamSlot& operator=(const StreamSlot&) = delete;
+
+         private:
+            bool acquired;
+
+            static Mutex mutex; // protects numActiveStreams
+            static unsigned numActiveStreams;
+
+         public:
+            bool isAcquired() const
+            {
+               return acquired;
+            }
+      };
+
+      FsckInodeExporter(Socket* sock, unsigned hashDirStart, unsigned hashDirEnd,
+         bool isBuddyMirrored);
+      virtual ~FsckInodeExporter() {}
+
+      FhgfsOpsErr run(unsigned numThreads);
+
+
+   protected:
+      virtual FhgfsOpsErr readEntryIDs(unsigned firstLevelHashDir, unsigned secondLevelHashDir,
+         StringList& outEntryIDs);
+      virtual void readInodes(StringListConstIter start, StringListConstIter end,
+         FsckDirInodeList& outDirInodes, FsckFileInodeList& outFileInodes);
+
+
+   private:
+      class Slave : public PThread
+      {
+         public:
+            Slave(FsckInodeExporter& exporter, unsigned sliceIndex, unsigned numSlices);
+
+         private:
+            FsckInodeExporter& exporter;
+            unsigned sliceIndex; // this slave walks every numSlices-th top-level hash dir...
+            unsigned numSlices; // ... starting at hashDirStart + sliceIndex
+
+            virtual void run();
+
+            bool exportHashDir(unsigned firstLevelHashDir, unsigned secondLevelHashDir);
+      };
+
+      Socket* sock;
+      const unsigned hashDirStart;
+      const unsigned hashDirEnd; // inclusive
+      const bool isBuddyMirrored;
+
+      Mutex mutex; // protects sock and result
+      FhgfsOpsErr result; // first error of any slave
+
+      bool sendBatch(FsckFileInodeList& fileInodes, FsckDirInodeList& dirInodes);
+      void setError(FhgfsOpsErr error);
+      bool hasFailed();
+};
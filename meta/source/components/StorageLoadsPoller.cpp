@@ -0,0 +1,36 @@
+#include <program/Program.h>
+#include "StorageLoadsPoller.h"
+
+
+StorageLoadsPoller::StorageLoadsPoller() :
+   PThread("StorageLoads"),
+   log("StorageLoads")
+{
+}
+
+void StorageLoadsPoller::run()
+{
+   try
+   {
+      registerSignalHandler();
+
+      pollLoop();
+
+      log.log(Log_DEBUG, "Component stopped.");
+   }
+   catch (std::exception& e)
+   {
+      PThread::getCurrentThreadApp()->handleComponentException(e);
+   }
+}
+
+void StorageLoadsPoller::pollLoop()
+{
+   App* app = Program::getApp();
+
+   while (!waitForSelfTerminateOrder(STORAGELOADSPOLLER_INTERVAL_MS) )
+   {
+      app->getStorageNodeLoads()->update(app->getStorageNodes(), app->getTargetMapper(),
+         app->getStorageBuddyGroupMapper() );
+   }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <common/app/log/LogContext.h>
+#include <common/threading/PThread.h>
+#include <common/Common.h>
+
+
+#define STORAGELOADSPOLLER_INTERVAL_MS    1000 // (storage servers update their stats every second)
+
+
+/**
+ * Periodically updates the StorageNodeLoads for the loadaware target chooser (only running if that
+ * chooser is configured).
+ *
+ * This is a separate component, so that storage servers that are slow to answer don't delay the
+ * InternodeSyncer.
+ */
+class StorageLoadsPoller : public PThread
+{
+   public:
+      StorageLoadsPoller();
+
+
+   private:
+      LogContext log;
+
+      virtual void run();
+      void pollLoop();
+};
+
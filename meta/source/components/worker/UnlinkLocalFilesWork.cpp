@@ -0,0 +1,40 @@
+#include <common/net/message/storage/creating/UnlinkLocalFilesRespMsg.h>
+#include <common/toolkit/MessagingTk.h>
+#include "UnlinkLocalFilesWork.h"
+
+
+void UnlinkLocalFilesWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
+   unsigned bufOutLen)
+{
+   FhgfsOpsErr commRes = communicate();
+   if (commRes != FhgfsOpsErr_SUCCESS)
+      outResults->assign(entries->size(), commRes);
+
+   counter->incCount();
+}
+
+FhgfsOpsErr UnlinkLocalFilesWork::communicate()
+{
+   UnlinkLocalFilesMsg unlinkMsg(entries);
+
+   auto respMsg = MessagingTk::requestResponse(*node, unlinkMsg, NETMSGTYPE_UnlinkLocalFilesResp);
+   if (!respMsg)
+   {
+      LOG(GENERAL, WARNING, "Communication with storage node failed.",
+            ("nodeID", node->getNodeIDWithTypeStr() ), ("numChunks", entries->size() ) );
+      return FhgfsOpsErr_COMMUNICATION;
+   }
+
+   FhgfsOpsErrVec& results = static_cast<UnlinkLocalFilesRespMsg*>(respMsg.get() )->getResults();
+   if (results.size() != entries->size() )
+   {
+      LOG(GENERAL, ERR, "Storage node returned wrong number of results.",
+            ("nodeID", node->getNodeIDWithTypeStr() ), ("numChunks", entries->size() ),
+            ("numResults", results.size() ) );
+      return FhgfsOpsErr_INTERNAL;
+   }
+
+   *outResults = std::move(results);
+
+   return FhgfsOpsErr_SUCCESS;
+}
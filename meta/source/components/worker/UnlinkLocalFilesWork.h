@@ -0,0 +1,42 @@
+#pragma once
+
+#include <common/components/worker/Work.h>
+#include <common/net/message/storage/creating/UnlinkLocalFilesMsg.h>
+#include <common/nodes/Node.h>
+#include <common/storage/StorageErrors.h>
+#include <common/toolkit/SynchronizedCounter.h>
+#include <common/Common.h>
+
+
+/**
+ * Sends one UnlinkLocalFilesMsg to a storage node.
+ */
+class UnlinkLocalFilesWork : public Work
+{
+   public:
+      /**
+       * @param entries just a reference, so do not free it as long as you use this object!
+       * @param outResults one result per entry on return; all entries get the communication error
+       *    if the request failed.
+       */
+      UnlinkLocalFilesWork(NodeHandle node, UnlinkLocalFilesEntryVec* entries,
+         FhgfsOpsErrVec* outResults, SynchronizedCounter* counter) :
+         node(std::move(node) ), entries(entries), outResults(outResults), counter(counter)
+      {
+         // all assignments done in initializer list
+      }
+
+      virtual ~UnlinkLocalFilesWork() {}
+
+
+      virtual void process(char* bufIn, unsigned bufInLen, char* bufOut, unsigned bufOutLen);
+
+
+   private:
+      NodeHandle node;
+      UnlinkLocalFilesEntryVec* entries;
+      FhgfsOpsErrVec* outResults;
+      SynchronizedCounter* counter;
+
+      FhgfsOpsErr communicate();
+};
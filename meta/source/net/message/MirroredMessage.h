@@ -23,7 +23,7 @@ class MirroredMessage : public BaseT
       LockStateT lockState;
 
       MirroredMessage():
-         resyncJob(nullptr)
+         resyncJob(nullptr), secondaryRead(false)
       {}
 
       virtual FhgfsOpsErr processSecondaryResponse(NetMessage& resp) = 0;
@@ -35,6 +35,12 @@ class MirroredMessage : public BaseT
 
       virtual bool isMirrored() = 0;
 
+      /**
+       * @return true if the msg neither changes state nor needs the primary's entry locks, so
+       *    that it may be served by the secondary of a buddy group (see processSecondaryRead() ).
+       */
+      virtual bool isReadOnly() { return false; }
+
       // IMPORTANT NOTE ON LOCKING ORDER:
       //  * always take locks the order
       //     - HashDirLock
@@ -57,6 +63,9 @@ class MirroredMessage : public BaseT
          Session* session = nullptr;
          bool isNewState = true;
 
+         if (isMirrored() && BuddyCommTk::isSecondaryRead(*this))
+            return processSecondaryRead(ctx);
+
          if (isMirrored() && !this->hasFlag(NetMessageHeader::Flag_BuddyMirrorSecond))
          {
             if (Program::getApp()->getInternodeSyncer()->getResyncInProgress())
@@ -151,6 +160,44 @@ class MirroredMessage : public BaseT
          return true;
       }
 
+      /**
+       * Serve a read-only request that the client sent directly to us as the secondary. No entry
+       * locks, no sequence number and nothing to forward. If we can't guarantee that the client
+       * sees its own previous mirrored operations, the client is told to ask the primary.
+       */
+      bool processSecondaryRead(NetMessage::ResponseContext& ctx)
+      {
+         if (!isReadOnly() ||
+               !BuddyCommTk::canServeSecondaryRead(this->getRequestorID(ctx).second,
+                  this->getSequenceNumberDone()))
+         {
+            ctx.sendResponse(
+                  GenericResponseMsg(
+                     GenericRespMsgCode_READFROMPRIMARY,
+                     "Secondary can't serve this request"));
+            return true;
+         }
+
+         // executeLocally() runs without the primary's entry locks, so msgs must check
+         // isSecondaryRead() and must not change any state (e.g. refresh dynamic attribs)
+         secondaryRead = true;
+
+         auto responseState = executeLocally(ctx, false);
+
+         if (responseState)
+            responseState->sendResponse(ctx);
+
+         return true;
+      }
+
+      /**
+       * @return true if the msg is currently served by processSecondaryRead().
+       */
+      bool isSecondaryRead() const
+      {
+         return secondaryRead;
+      }
+
       template<typename ResponseT>
       void earlyComplete(NetMessage::ResponseContext& ctx, ResponseT&& state)
       {
@@ -304,7 +351,11 @@ class MirroredMessage : public BaseT
          message.addFlag(this->getFlags() & NetMessageHeader::Flag_IsSelectiveAck);
          message.addFlag(this->getFlags() & NetMessageHeader::Flag_HasSequenceNumber);
 
-         FhgfsOpsErr commRes = MessagingTk::requestResponseNode(&rrNode, &rrArgs);
+         MirrorForwardBatcher* forwardBatcher = app->getMirrorForwardBatcher();
+
+         FhgfsOpsErr commRes = forwardBatcher ?
+            forwardBatcher->requestResponseNode(&rrNode, &rrArgs) :
+            MessagingTk::requestResponseNode(&rrNode, &rrArgs);
 
          message.removeFlag(NetMessageHeader::Flag_BuddyMirrorSecond);
 
@@ -436,6 +487,7 @@ class MirroredMessage : public BaseT
 
    private:
       std::shared_ptr<MirrorStateSlot> mirrorState;
+      bool secondaryRead; // true while served by processSecondaryRead()
 
       void setBuddyNeedsResync()
       {
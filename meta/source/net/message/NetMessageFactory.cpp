@@ -38,6 +38,7 @@
 #include <common/net/message/storage/attribs/GetChunkFileAttribsRespMsg.h>
 #include <common/net/message/storage/listing/ListDirFromOffsetRespMsg.h>
 #include <common/net/message/storage/lookup/FindOwnerRespMsg.h>
+#include <common/net/message/storage/GetTargetLoadStatsRespMsg.h>
 #include <common/net/message/storage/lookup/LookupIntentRespMsg.h>
 #include <common/net/message/storage/creating/MkDirRespMsg.h>
 #include <common/net/message/storage/creating/MkFileRespMsg.h>
@@ -62,6 +63,7 @@
 #include <common/net/message/storage/TruncLocalFileRespMsg.h>
 #include <common/net/message/storage/creating/UnlinkFileRespMsg.h>
 #include <common/net/message/storage/creating/UnlinkLocalFileRespMsg.h>
+#include <common/net/message/storage/creating/UnlinkLocalFilesRespMsg.h>
 #include <common/net/message/storage/creating/MoveFileInodeMsg.h>
 #include <common/net/message/storage/creating/MoveFileInodeRespMsg.h>
 #include <common/net/message/storage/creating/UnlinkLocalFileInodeRespMsg.h>
@@ -106,6 +108,7 @@
 #include <net/message/storage/TruncFileMsgEx.h>
 #include <net/message/storage/creating/UnlinkFileMsgEx.h>
 #include <net/message/storage/GetHighResStatsMsgEx.h>
+#include <net/message/storage/GetLatencyStatsMsgEx.h>
 #include <net/message/storage/attribs/RefreshEntryInfoMsgEx.h>
 #include <net/message/storage/lookup/FindLinkOwnerMsgEx.h>
 #include <net/message/storage/creating/HardlinkMsgEx.h>
@@ -132,6 +135,8 @@
 #include <net/message/session/locking/FLockRangeMsgEx.h>
 #include <net/message/session/opening/CloseFileMsgEx.h>
 #include <net/message/session/opening/OpenFileMsgEx.h>
+#include <net/message/session/rw/ReadInlineFileMsgEx.h>
+#include <net/message/session/rw/WriteInlineFileMsgEx.h>
 
 // mon message
 #include <net/message/mon/RequestMetaDataMsgEx.h>
@@ -154,6 +159,8 @@
 #include <net/message/fsck/UpdateFileAttribsMsgEx.h>
 #include <net/message/fsck/AdjustChunkPermissionsMsgEx.h>
 #include <net/message/fsck/CheckAndRepairDupInodeMsgEx.h>
+#include <net/message/fsck/StreamFsckInodesMsgEx.h>
+#include <net/message/fsck/StreamFsckDirEntriesMsgEx.h>
 
 // chunk balancing
 #include <common/net/message/storage/chunkbalancing/CpChunkPathsRespMsg.h>
@@ -226,6 +233,8 @@ std::unique_ptr<NetMessage> NetMessageFactory::createFromMsgType(unsigned short
       case NETMSGTYPE_GetEntryInfo: { msg = new GetEntryInfoMsgEx(); } break;
       case NETMSGTYPE_GetEntryInfoResp: { msg = new GetEntryInfoRespMsg(); } break;
       case NETMSGTYPE_GetHighResStats: { msg = new GetHighResStatsMsgEx(); } break;
+      case NETMSGTYPE_GetLatencyStats: { msg = new GetLatencyStatsMsgEx(); } break;
+      case NETMSGTYPE_GetTargetLoadStatsResp: { msg = new GetTargetLoadStatsRespMsg(); } break;
       case NETMSGTYPE_GetMetaResyncStats: { msg = new GetMetaResyncStatsMsgEx(); } break;
       case NETMSGTYPE_RequestExceededQuotaResp: {msg = new RequestExceededQuotaRespMsg(); } break;
       case NETMSGTYPE_SetExceededQuota: {msg = new SetExceededQuotaMsgEx(); } break;
@@ -289,6 +298,7 @@ std::unique_ptr<NetMessage> NetMessageFactory::createFromMsgType(unsigned short
       case NETMSGTYPE_UnlinkFile: { msg = new UnlinkFileMsgEx(); } break;
       case NETMSGTYPE_UnlinkFileResp: { msg = new UnlinkFileRespMsg(); } break;
       case NETMSGTYPE_UnlinkLocalFileResp: { msg = new UnlinkLocalFileRespMsg(); } break;
+      case NETMSGTYPE_UnlinkLocalFilesResp: { msg = new UnlinkLocalFilesRespMsg(); } break;
       case NETMSGTYPE_UpdateDirParent: { msg = new UpdateDirParentMsgEx(); } break;
       case NETMSGTYPE_UpdateDirParentResp: { msg = new UpdateDirParentRespMsg(); } break;
       case NETMSGTYPE_MoveFileInode: { msg = new MoveFileInodeMsgEx(); } break;
@@ -318,6 +328,8 @@ std::unique_ptr<NetMessage> NetMessageFactory::createFromMsgType(unsigned short
       case NETMSGTYPE_FLockRangeResp: { msg = new FLockRangeRespMsg(); } break;
       case NETMSGTYPE_GetFileVersion: { msg = new GetFileVersionMsgEx(); } break;
       case NETMSGTYPE_GetFileVersionResp: { msg = new GetFileVersionRespMsg(); } break;
+      case NETMSGTYPE_ReadInlineFile: { msg = new ReadInlineFileMsgEx(); } break;
+      case NETMSGTYPE_WriteInlineFile: { msg = new WriteInlineFileMsgEx(); } break;
       case NETMSGTYPE_AckNotify: { msg = new AckNotifiyMsgEx(); } break;
       case NETMSGTYPE_AckNotifyResp: { msg = new AckNotifiyRespMsg(); } break;
 
@@ -342,6 +354,8 @@ std::unique_ptr<NetMessage> NetMessageFactory::createFromMsgType(unsigned short
       case NETMSGTYPE_FsckSetEventLogging: { msg = new FsckSetEventLoggingMsgEx(); } break;
       case NETMSGTYPE_AdjustChunkPermissions: { msg = new AdjustChunkPermissionsMsgEx(); } break;
       case NETMSGTYPE_CheckAndRepairDupInode: { msg = new CheckAndRepairDupInodeMsgEx(); } break;
+      case NETMSGTYPE_StreamFsckInodes: { msg = new StreamFsckInodesMsgEx(); } break;
+      case NETMSGTYPE_StreamFsckDirEntries: { msg = new StreamFsckDirEntriesMsgEx(); } break;
 
       default:
       {
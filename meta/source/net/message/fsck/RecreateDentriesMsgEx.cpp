@@ -123,6 +123,8 @@ bool RecreateDentriesMsgEx::processIncoming(ResponseContext& ctx)
             chunkSize, localNodeID, iter->getSaveInode(), iter->getSaveDevice(), true,
             iter->getIsBuddyMirrored(), true, false);
 
+         fsckFileInode.setHasInlineData(inodeData->getHasInlineData() );
+
          createdInodes.push_back(fsckFileInode);
       }
       else
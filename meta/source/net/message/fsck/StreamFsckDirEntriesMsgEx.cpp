@@ -0,0 +1,57 @@
+#include <components/FsckDirEntryExporter.h>
+#include <components/FsckInodeExporter.h>
+#include <program/Program.h>
+#include "StreamFsckDirEntriesMsgEx.h"
+
+bool StreamFsckDirEntriesMsgEx::processIncoming(ResponseContext& ctx)
+{
+   LogContext log("Incoming StreamFsckDirEntriesMsg");
+
+   App* app = Program::getApp();
+   Config* cfg = app->getConfig();
+   MirrorBuddyGroupMapper* bgm = app->getMetaBuddyGroupMapper();
+
+   FsckContDirList noContDirs;
+   FsckDirEntryList noDirEntries;
+   FsckFileInodeList noInlinedFileInodes;
+
+   // only the primary of a buddy group exports mirrored dir entries (like RetrieveDirEntriesMsg)
+   if (getIsBuddyMirrored() &&
+         (bgm->getLocalBuddyGroup().secondTargetID == app->getLocalNode().getNumID().val()
+          || bgm->getLocalGroupID() == 0))
+   {
+      ctx.sendResponse(StreamFsckDirEntriesRespMsg(&noContDirs, &noDirEntries,
+         &noInlinedFileInodes, true, FhgfsOpsErr_SUCCESS) );
+      return true;
+   }
+
+   // same limit as for the inode streams (see StreamFsckInodesMsgEx), the slots are shared
+   const unsigned maxStreams = BEEGFS_MAX(1u,
+      BEEGFS_MIN(cfg->getTuneNumFsckExportStreams(), cfg->getTuneNumWorkers() / 4) );
+
+   FsckInodeExporter::StreamSlot slot(maxStreams);
+   if (!slot.isAcquired() )
+   {
+      LOG(GENERAL, DEBUG, "Too many fsck export streams, rejecting request.", maxStreams);
+
+      ctx.sendResponse(StreamFsckDirEntriesRespMsg(&noContDirs, &noDirEntries,
+         &noInlinedFileInodes, true, FhgfsOpsErr_AGAIN) );
+      return true;
+   }
+
+   const NumNodeID localNodeNumID = getIsBuddyMirrored()
+      ? NumNodeID(bgm->getLocalGroupID() )
+      : app->getLocalNode().getNumID();
+
+   FsckDirEntryExporter exporter(ctx.getSocket(), getHashDirStart(), getHashDirEnd(),
+      getIsBuddyMirrored(), localNodeNumID, getMsgHeaderUserID() );
+
+   FhgfsOpsErr exportRes = exporter.run(cfg->getTuneNumFsckExportThreads() );
+   if (exportRes == FhgfsOpsErr_COMMUNICATION)
+      return false; // stream is broken => disconnect
+
+   ctx.sendResponse(StreamFsckDirEntriesRespMsg(&noContDirs, &noDirEntries,
+      &noInlinedFileInodes, true, exportRes) );
+
+   return true;
+}
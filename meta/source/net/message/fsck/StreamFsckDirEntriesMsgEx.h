@@ -0,0 +1,11 @@
+#pragma once
+
+#include <common/net/message/fsck/StreamFsckDirEntriesMsg.h>
+#include <common/net/message/fsck/StreamFsckDirEntriesRespMsg.h>
+
+class StreamFsckDirEntriesMsgEx : public StreamFsckDirEntriesMsg
+{
+   public:
+      virtual bool processIncoming(ResponseContext& ctx);
+};
+
@@ -0,0 +1,51 @@
+#include <components/FsckInodeExporter.h>
+#include <program/Program.h>
+#include "StreamFsckInodesMsgEx.h"
+
+bool StreamFsckInodesMsgEx::processIncoming(ResponseContext& ctx)
+{
+   LogContext log("Incoming StreamFsckInodesMsg");
+
+   App* app = Program::getApp();
+   Config* cfg = app->getConfig();
+   MirrorBuddyGroupMapper* bgm = app->getMetaBuddyGroupMapper();
+
+   FsckFileInodeList noFileInodes;
+   FsckDirInodeList noDirInodes;
+
+   // only the primary of a buddy group exports mirrored inodes (like RetrieveInodesMsg)
+   if (getIsBuddyMirrored() &&
+         (bgm->getLocalBuddyGroup().secondTargetID == app->getLocalNode().getNumID().val()
+          || bgm->getLocalGroupID() == 0))
+   {
+      ctx.sendResponse(StreamFsckInodesRespMsg(&noFileInodes, &noDirInodes, true,
+         FhgfsOpsErr_SUCCESS) );
+      return true;
+   }
+
+   // the stream keeps this worker busy until the export is done, so leave most of the workers
+   // for client requests; fsck falls back to paged retrieval (short requests) if we reject
+   const unsigned maxStreams = BEEGFS_MAX(1u,
+      BEEGFS_MIN(cfg->getTuneNumFsckExportStreams(), cfg->getTuneNumWorkers() / 4) );
+
+   FsckInodeExporter::StreamSlot slot(maxStreams);
+   if (!slot.isAcquired() )
+   {
+      LOG(GENERAL, DEBUG, "Too many fsck inode export streams, rejecting request.", maxStreams);
+
+      ctx.sendResponse(StreamFsckInodesRespMsg(&noFileInodes, &noDirInodes, true,
+         FhgfsOpsErr_AGAIN) );
+      return true;
+   }
+
+   FsckInodeExporter exporter(ctx.getSocket(), getHashDirStart(), getHashDirEnd(),
+      getIsBuddyMirrored() );
+
+   FhgfsOpsErr exportRes = exporter.run(cfg->getTuneNumFsckExportThreads() );
+   if (exportRes == FhgfsOpsErr_COMMUNICATION)
+      return false; // stream is broken => disconnect
+
+   ctx.sendResponse(StreamFsckInodesRespMsg(&noFileInodes, &noDirInodes, true, exportRes) );
+
+   return true;
+}
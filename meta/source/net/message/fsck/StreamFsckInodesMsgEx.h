@@ -0,0 +1,11 @@
+#pragma once
+
+#include <common/net/message/fsck/StreamFsckInodesMsg.h>
+#include <common/net/message/fsck/StreamFsckInodesRespMsg.h>
+
+class StreamFsckInodesMsgEx : public StreamFsckInodesMsg
+{
+   public:
+      virtual bool processIncoming(ResponseContext& ctx);
+};
+
@@ -372,10 +372,28 @@ std::string GenericDebugMsgEx::processOpCacheStatistics(std::istringstream& comm
 
    std::ostringstream responseStream;
    size_t numDirs;
+   CachePolicyStats policyStats;
 
-   metaStore->getCacheStats(&numDirs);
+   metaStore->getCacheStats(&numDirs, &policyStats);
 
-   responseStream << "Dirs: " << numDirs;
+   responseStream << "Dirs: " << numDirs << std::endl;
+   responseStream << "Hot dirs: " << policyStats.numHotEntries << std::endl;
+   responseStream << "Hits: " << policyStats.numHits << std::endl;
+   responseStream << "Misses: " << policyStats.numMisses << std::endl;
+   responseStream << "Evictions: " << policyStats.numEvictions;
+
+   InodeStatCache* statCache = metaStore->getInodeStatCache();
+
+   if (statCache->isEnabled() )
+   {
+      InodeStatCacheStats statCacheStats = statCache->getStats();
+
+      responseStream << std::endl;
+      responseStream << "Stat cache inodes: " << statCacheStats.numEntries << std::endl;
+      responseStream << "Stat cache hits: " << statCacheStats.numHits << std::endl;
+      responseStream << "Stat cache misses: " << statCacheStats.numMisses << std::endl;
+      responseStream << "Stat cache invalidations: " << statCacheStats.numInvalidations;
+   }
 
    return responseStream.str();
 }
@@ -41,6 +41,7 @@ std::unique_ptr<MirroredMessageResponseState> OpenFileMsgEx::executeLocally(Resp
    EntryInfo* entryInfo = this->getEntryInfo();
    bool useQuota = isMsgHeaderFeatureFlagSet(OPENFILEMSG_FLAG_USE_QUOTA);
    bool bypassAccessCheck = isMsgHeaderFeatureFlagSet(OPENFILEMSG_FLAG_BYPASS_ACCESS_CHECK);
+   bool inlineDataSupported = isMsgHeaderFeatureFlagSet(OPENFILEMSG_FLAG_INLINE_DATA);
 
    const bool eventLoggingEnabled = !isSecondary && app->getFileEventLogger() && getFileEvent();
    MetaFileHandle inode;
@@ -54,7 +55,7 @@ std::unique_ptr<MirroredMessageResponseState> OpenFileMsgEx::executeLocally(Resp
 
    FhgfsOpsErr openRes = MsgHelperOpen::openFile(
       entryInfo, getAccessFlags(), useQuota, bypassAccessCheck, getMsgHeaderUserID(),
-      inode, isSecondary);
+      inode, isSecondary, inlineDataSupported);
 
    if (openRes == FhgfsOpsErr_SUCCESS && shouldFixTimestamps())
       fixInodeTimestamp(*inode, fileTimestamps, entryInfo);
@@ -147,8 +148,13 @@ std::unique_ptr<MirroredMessageResponseState> OpenFileMsgEx::executeLocally(Resp
 
    sessionFile->getInode()->getPathInfo(&pathInfo);
 
-   return boost::make_unique<OpenFileResponseState>(openRes, fileHandleID, *pattern, pathInfo,
-         sessionFile->getInode()->getFileVersion());
+   auto response = boost::make_unique<OpenFileResponseState>(openRes, fileHandleID, *pattern,
+         pathInfo, sessionFile->getInode()->getFileVersion());
+
+   if (sessionFile->getInode()->getHasInlineData())
+      response->setIsInlineData(true);
+
+   return response;
 }
 
 void OpenFileMsgEx::forwardToSecondary(ResponseContext& ctx)
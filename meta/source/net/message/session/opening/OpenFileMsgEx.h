@@ -12,11 +12,11 @@ class OpenFileResponseState : public MirroredMessageResponseState
 {
    public:
       OpenFileResponseState()
-         : isIndirectCommErr(true)
+         : isIndirectCommErr(true), isInlineData(false)
       {
       }
 
-      explicit OpenFileResponseState(Deserializer& des)
+      explicit OpenFileResponseState(Deserializer& des) : isInlineData(false)
       {
          serialize(this, des);
       }
@@ -24,7 +24,8 @@ class OpenFileResponseState : public MirroredMessageResponseState
       OpenFileResponseState(FhgfsOpsErr result, const std::string& fileHandleID,
             const StripePattern& pattern, const PathInfo& pathInfo, uint32_t fileVersion)
          : isIndirectCommErr(false), result(result), fileHandleID(fileHandleID),
-           pattern(pattern.clone()), pathInfo(pathInfo), fileVersion(fileVersion)
+           pattern(pattern.clone()), pathInfo(pathInfo), fileVersion(fileVersion),
+           isInlineData(false)
       {
       }
 
@@ -36,11 +37,18 @@ class OpenFileResponseState : public MirroredMessageResponseState
                      GenericRespMsgCode_INDIRECTCOMMERR,
                      "Communication with storage targets failed"));
          else
-            ctx.sendResponse(
-                  OpenFileRespMsg(
-                     result, fileHandleID, pattern.get(), &pathInfo, fileVersion));
+         {
+            OpenFileRespMsg resp(result, fileHandleID, pattern.get(), &pathInfo, fileVersion);
+
+            if (isInlineData)
+               resp.addMsgHeaderFeatureFlag(OPENFILERESPMSG_FLAG_INLINE_DATA);
+
+            ctx.sendResponse(resp);
+         }
       }
 
+      void setIsInlineData(bool isInlineData) { this->isInlineData = isInlineData; }
+
       bool changesObservableState() const override
       {
          return !isIndirectCommErr && result == FhgfsOpsErr_SUCCESS;
@@ -76,6 +84,7 @@ class OpenFileResponseState : public MirroredMessageResponseState
       std::unique_ptr<StripePattern> pattern;
       PathInfo pathInfo;
       uint32_t fileVersion;
+      bool isInlineData; // not serialized, inline data files are never mirrored
 };
 
 class OpenFileMsgEx : public MirroredMessage<OpenFileMsg, FileIDLock>
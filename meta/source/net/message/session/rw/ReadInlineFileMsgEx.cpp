@@ -0,0 +1,24 @@
+#include <common/net/message/session/rw/ReadInlineFileRespMsg.h>
+#include <net/msghelpers/MsgHelperInlineData.h>
+#include <program/Program.h>
+#include "ReadInlineFileMsgEx.h"
+
+
+bool ReadInlineFileMsgEx::processIncoming(ResponseContext& ctx)
+{
+   EntryInfo* entryInfo = getEntryInfo();
+
+   LOG_DBG(GENERAL, SPAM, "", entryInfo->getEntryID(), getOffset(), getCount() );
+
+   std::string data;
+   FhgfsOpsErr readRes;
+
+   if(entryInfo->getIsBuddyMirrored() )
+      readRes = FhgfsOpsErr_NOTSUPP;
+   else
+      readRes = MsgHelperInlineData::readData(entryInfo, getOffset(), getCount(), data);
+
+   ctx.sendResponse(ReadInlineFileRespMsg(readRes, std::move(data) ) );
+
+   return true;
+}
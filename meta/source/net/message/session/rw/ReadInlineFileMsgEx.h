@@ -0,0 +1,14 @@
+#pragma once
+
+#include <common/net/message/session/rw/ReadInlineFileMsg.h>
+#include <common/storage/StorageErrors.h>
+
+/**
+ * Note: Inline data files are never buddy mirrored, so this is not a mirrored message.
+ */
+class ReadInlineFileMsgEx : public ReadInlineFileMsg
+{
+   public:
+      virtual bool processIncoming(ResponseContext& ctx);
+};
+
@@ -0,0 +1,24 @@
+#include <common/net/message/session/rw/WriteInlineFileRespMsg.h>
+#include <net/msghelpers/MsgHelperInlineData.h>
+#include <program/Program.h>
+#include "WriteInlineFileMsgEx.h"
+
+
+bool WriteInlineFileMsgEx::processIncoming(ResponseContext& ctx)
+{
+   EntryInfo* entryInfo = getEntryInfo();
+
+   LOG_DBG(GENERAL, SPAM, "", entryInfo->getEntryID(), getOffset(), getDataLen() );
+
+   FhgfsOpsErr writeRes;
+
+   if(entryInfo->getIsBuddyMirrored() )
+      writeRes = FhgfsOpsErr_NOTSUPP;
+   else
+      writeRes = MsgHelperInlineData::writeData(entryInfo, getOffset(), getData(), getDataLen(),
+         getMsgHeaderUserID() );
+
+   ctx.sendResponse(WriteInlineFileRespMsg(writeRes) );
+
+   return true;
+}
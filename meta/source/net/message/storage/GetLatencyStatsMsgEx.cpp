@@ -0,0 +1,16 @@
+#include <common/components/worker/WorkerLatencyStats.h>
+#include <common/net/message/storage/GetLatencyStatsRespMsg.h>
+#include "GetLatencyStatsMsgEx.h"
+
+
+bool GetLatencyStatsMsgEx::processIncoming(ResponseContext& ctx)
+{
+   LatencyHistogramData queueWait;
+   LatencyHistogramDataMap msgProcessing;
+
+   WorkerLatencyStats::getAggregated(queueWait, msgProcessing);
+
+   ctx.sendResponse(GetLatencyStatsRespMsg(&queueWait, &msgProcessing) );
+
+   return true;
+}
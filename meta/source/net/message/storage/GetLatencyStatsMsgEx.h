@@ -0,0 +1,11 @@
+#pragma once
+
+#include <common/net/message/storage/GetLatencyStatsMsg.h>
+
+
+class GetLatencyStatsMsgEx : public GetLatencyStatsMsg
+{
+   public:
+      virtual bool processIncoming(ResponseContext& ctx);
+};
+
@@ -59,6 +59,8 @@ class GetXAttrMsgEx : public MirroredMessage<GetXAttrMsg, FileIDLock>
          return getEntryInfo()->getIsBuddyMirrored();
       }
 
+      bool isReadOnly() override { return true; }
+
    private:
        std::unique_ptr<MirroredMessageResponseState> executeLocally(ResponseContext& ctx,
          bool isSecondary) override;
@@ -42,6 +42,12 @@ std::unique_ptr<MirroredMessageResponseState> StatMsgEx::executeLocally(Response
       statRes = statRoot(statData);
    }
    else
+   if (isSecondaryRead() )
+   { // secondary must not refresh dynamic attribs from the storage servers
+      statRes = MsgHelperStat::statCached(entryInfo, true, statData, &parentNodeID,
+         &parentEntryID);
+   }
+   else
    {
       statRes = MsgHelperStat::stat(entryInfo, true, getMsgHeaderUserID(), statData, &parentNodeID,
          &parentEntryID);
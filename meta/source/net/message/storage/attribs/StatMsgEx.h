@@ -106,6 +106,8 @@ class StatMsgEx: public MirroredMessage<StatMsg, FileIDLock>
          return getEntryInfo()->getIsBuddyMirrored();
       }
 
+      bool isReadOnly() override { return true; }
+
    private:
       std::unique_ptr<MirroredMessageResponseState> executeLocally(ResponseContext& ctx,
          bool isSecondary) override;
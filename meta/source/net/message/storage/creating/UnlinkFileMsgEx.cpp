@@ -205,7 +205,7 @@ std::unique_ptr<UnlinkFileMsgEx::ResponseState> UnlinkFileMsgEx::executePrimary(
       /* note: if the file is still opened or if there were hardlinks then unlinkedInode will be
          NULL even on FhgfsOpsErr_SUCCESS */
       if ((unlinkMetaRes == FhgfsOpsErr_SUCCESS) && unlinkedInode)
-         MsgHelperUnlink::unlinkChunkFiles(unlinkedInode.release(), getMsgHeaderUserID() );
+         MsgHelperUnlink::unlinkChunkFilesAsync(unlinkedInode.release(), getMsgHeaderUserID() );
 
       if (unlinkMetaRes == FhgfsOpsErr_SUCCESS && app->getFileEventLogger() && getFileEvent())
       {
@@ -243,7 +243,7 @@ std::unique_ptr<UnlinkFileMsgEx::ResponseState> UnlinkFileMsgEx::executePrimary(
    /* note: if the file is still opened or if there are/were hardlinks then unlinkedInode will be
       NULL even on FhgfsOpsErr_SUCCESS */
    if ((unlinkRes == FhgfsOpsErr_SUCCESS) && unlinkedInode)
-      MsgHelperUnlink::unlinkChunkFiles(unlinkedInode.release(), getMsgHeaderUserID());
+      MsgHelperUnlink::unlinkChunkFilesAsync(unlinkedInode.release(), getMsgHeaderUserID());
 
    app->getMetaStore()->releaseDir(dir.getID());
    if ((unlinkRes == FhgfsOpsErr_SUCCESS) && app->getFileEventLogger() && getFileEvent())
@@ -49,7 +49,7 @@ std::unique_ptr<MirroredMessageResponseState> UnlinkLocalFileInodeMsgEx::execute
 
    if ((unlinkInodeRes == FhgfsOpsErr_SUCCESS) && unlinkedInode && !isSecondary)
    {
-      MsgHelperUnlink::unlinkChunkFiles(unlinkedInode.release(), getMsgHeaderUserID());
+      MsgHelperUnlink::unlinkChunkFilesAsync(unlinkedInode.release(), getMsgHeaderUserID());
    }
 
    return boost::make_unique<ResponseState>(std::move(resp));
@@ -251,8 +251,10 @@ std::unique_ptr<MirroredMessageResponseState> LookupIntentMsgEx::executeLocally(
          return boost::make_unique<ResponseState>(std::move(response));
 
       StripePattern* pattern = NULL;
+      bool isInlineData = false;
 
-      FhgfsOpsErr openRes = open(&diskEntryInfo, &fileHandleID, &pattern, &pathInfo, isSecondary);
+      FhgfsOpsErr openRes = open(&diskEntryInfo, &fileHandleID, &pattern, &pathInfo,
+         &isInlineData, isSecondary);
 
       if(openRes != FhgfsOpsErr_SUCCESS)
       { // open failed => use dummy pattern for response
@@ -264,6 +266,9 @@ std::unique_ptr<MirroredMessageResponseState> LookupIntentMsgEx::executeLocally(
 
       response.addResponseOpen(openRes, std::move(fileHandleID),
             std::unique_ptr<StripePattern>(pattern->clone()), pathInfo);
+
+      if (isInlineData)
+         response.addResponseInlineData();
    }
 
    updateNodeOp(ctx, getOpCounterType());
@@ -337,6 +342,10 @@ FhgfsOpsErr LookupIntentMsgEx::create(EntryInfo* parentInfo, const std::string&
    MkFileDetails mkDetails(entryName, getUserID(), getGroupID(), getMode(), getUmask(),
          TimeAbs().getTimeval()->tv_sec);
    StripePattern* pattern = nullptr;
+
+   // only files that are opened right away by a client with inline data support start inlined
+   mkDetails.inlineDataSupported = (getIntentFlags() & LOOKUPINTENTMSG_FLAG_OPEN) &&
+      (getIntentFlags() & LOOKUPINTENTMSG_FLAG_INLINE_DATA);
    std::unique_ptr<RemoteStorageTarget> rstInfo;
    FhgfsOpsErr res;
 
@@ -450,7 +459,12 @@ FhgfsOpsErr LookupIntentMsgEx::stat(EntryInfo* entryInfo, bool loadFromDisk, Sta
    else
       expectedOwner = localNode.getNumID();
 
-   if(entryInfo->getOwnerNodeID() == expectedOwner)
+   if(entryInfo->getOwnerNodeID() != expectedOwner)
+      return statRes;
+
+   if (isSecondaryRead() ) // secondary must not refresh dynamic attribs from the storage servers
+      statRes = MsgHelperStat::statCached(entryInfo, loadFromDisk, outStatData);
+   else
       statRes = MsgHelperStat::stat(entryInfo, loadFromDisk, getMsgHeaderUserID(), outStatData);
 
    return statRes;
@@ -461,7 +475,7 @@ FhgfsOpsErr LookupIntentMsgEx::stat(EntryInfo* entryInfo, bool loadFromDisk, Sta
  * not need to be free'd/deleted.
  */
 FhgfsOpsErr LookupIntentMsgEx::open(EntryInfo* entryInfo, std::string* outFileHandleID,
-   StripePattern** outPattern, PathInfo* outPathInfo, bool isSecondary)
+   StripePattern** outPattern, PathInfo* outPathInfo, bool* outIsInlineData, bool isSecondary)
 {
    App* app = Program::getApp();
    SessionStore* sessions = entryInfo->getIsBuddyMirrored()
@@ -471,10 +485,11 @@ FhgfsOpsErr LookupIntentMsgEx::open(EntryInfo* entryInfo, std::string* outFileHa
    MetaFileHandle inode;
 
    bool useQuota = isMsgHeaderFeatureFlagSet(LOOKUPINTENTMSG_FLAG_USE_QUOTA);
+   bool inlineDataSupported = getIntentFlags() & LOOKUPINTENTMSG_FLAG_INLINE_DATA;
 
    FhgfsOpsErr openRes = MsgHelperOpen::openFile(
       entryInfo, getAccessFlags(), useQuota, /* bypassFileAccessCheck */ false,
-      getMsgHeaderUserID(), inode, isSecondary);
+      getMsgHeaderUserID(), inode, isSecondary, inlineDataSupported);
 
    if (openRes == FhgfsOpsErr_SUCCESS && shouldFixTimestamps())
       fixInodeTimestamp(*inode, fileTimestamps, entryInfo);
@@ -490,6 +505,7 @@ FhgfsOpsErr LookupIntentMsgEx::open(EntryInfo* entryInfo, std::string* outFileHa
 
    *outPattern = sessionFile->getInode()->getStripePattern();
    sessionFile->getInode()->getPathInfo(outPathInfo);
+   *outIsInlineData = sessionFile->getInode()->getHasInlineData();
 
    unsigned sessionFileID;
 
@@ -54,6 +54,9 @@ class LookupIntentResponseState : public MirroredMessageResponseState
          if (responseFlags & LOOKUPINTENTRESPMSG_FLAG_OPEN)
             resp.addResponseOpen(openResult, fileHandleID, pattern.get(), &pathInfo);
 
+         if (responseFlags & LOOKUPINTENTRESPMSG_FLAG_INLINE_DATA)
+            resp.addResponseInlineData();
+
          resp.setEntryInfo(&entryInfo);
 
          ctx.sendResponse(resp);
@@ -147,6 +150,11 @@ class LookupIntentResponseState : public MirroredMessageResponseState
          this->pathInfo = pathInfo;
       }
 
+      void addResponseInlineData()
+      {
+         responseFlags |= LOOKUPINTENTRESPMSG_FLAG_INLINE_DATA;
+      }
+
       void addResponseStat(FhgfsOpsErr statResult, const StatData& statData)
       {
          responseFlags |= LOOKUPINTENTRESPMSG_FLAG_STAT;
@@ -175,6 +183,11 @@ class LookupIntentMsgEx : public MirroredMessage<LookupIntentMsg,
 
       bool isMirrored() override { return getParentInfo()->getIsBuddyMirrored(); }
 
+      bool isReadOnly() override
+      {
+         return !(getIntentFlags() & (LOOKUPINTENTMSG_FLAG_CREATE | LOOKUPINTENTMSG_FLAG_OPEN));
+      }
+
       const char* mirrorLogContext() const override { return "LookupIntentMsgEx/forward"; }
 
       std::unique_ptr<MirroredMessageResponseState> executeLocally(ResponseContext& ctx,
@@ -205,7 +218,8 @@ class LookupIntentMsgEx : public MirroredMessage<LookupIntentMsg,
          EntryInfo* outEntryInfo, FileInodeStoreData* outInodeData, bool isSecondary);
       FhgfsOpsErr stat(EntryInfo* entryInfo, bool loadFromDisk, StatData& outStatData);
       FhgfsOpsErr open(EntryInfo* entryInfo, std::string* outFileHandleID,
-         StripePattern** outPattern, PathInfo* outPathInfo, bool isSecondary);
+         StripePattern** outPattern, PathInfo* outPathInfo, bool* outIsInlineData,
+         bool isSecondary);
 
       void forwardToSecondary(ResponseContext& ctx) override;
 
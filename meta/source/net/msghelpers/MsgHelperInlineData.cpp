@@ -0,0 +1,237 @@
+#include <common/components/worker/WriteLocalFileWork.h>
+#include <common/toolkit/SessionTk.h>
+#include <common/toolkit/SynchronizedCounter.h>
+#include <net/msghelpers/MsgHelperClose.h>
+#include <program/Program.h>
+#include <session/EntryLock.h>
+#include <session/SessionStore.h>
+#include "MsgHelperInlineData.h"
+
+#include <boost/lexical_cast.hpp>
+
+
+/**
+ * @param outData less than count bytes if the end of file is reached
+ * @return FhgfsOpsErr_NOTSUPP if the file data is not inlined, so the caller has to read the
+ *    chunk files.
+ */
+FhgfsOpsErr MsgHelperInlineData::readData(EntryInfo* entryInfo, int64_t offset, int64_t count,
+   std::string& outData)
+{
+   MetaStore* metaStore = Program::getApp()->getMetaStore();
+
+   auto [inode, referenceRes] = metaStore->referenceFile(entryInfo);
+   if(!inode)
+      return referenceRes;
+
+   FhgfsOpsErr readRes = inode->readInlineData(offset, count, outData);
+
+   metaStore->releaseFile(entryInfo->getParentEntryID(), inode);
+
+   return readRes;
+}
+
+/**
+ * Write to the inline data of a file. If the file would grow beyond the inline data limit, the
+ * file is promoted to a regular chunk file first.
+ *
+ * @param msgUserID only used for msg header info.
+ * @return FhgfsOpsErr_NOTSUPP if the file data is not inlined (anymore), so the caller has to
+ *    write to the chunk files; FhgfsOpsErr_DQUOT if the size quota of the file owner is exceeded.
+ */
+FhgfsOpsErr MsgHelperInlineData::writeData(EntryInfo* entryInfo, int64_t offset, const char* buf,
+   size_t count, unsigned msgUserID)
+{
+   App* app = Program::getApp();
+   MetaStore* metaStore = app->getMetaStore();
+
+   // serializes writes with promotion (which writes to the chunks without holding the inode lock)
+   FileIDLock lock(app->getSessions()->getEntryLockStore(), entryInfo->getEntryID(), true);
+
+   auto [inode, referenceRes] = metaStore->referenceFile(entryInfo);
+   if(!inode)
+      return referenceRes;
+
+   if(app->getConfig()->getQuotaEnableEnforcement() )
+   { // the storage servers would refuse the write to the chunk files, so we do the same
+      FhgfsOpsErr quotaRes = checkSizeQuota(*inode);
+      if(quotaRes != FhgfsOpsErr_SUCCESS)
+      {
+         metaStore->releaseFile(entryInfo->getParentEntryID(), inode);
+         return quotaRes;
+      }
+   }
+
+   FhgfsOpsErr writeRes = inode->writeInlineData(entryInfo, offset, buf, count,
+      getMaxDataSize() );
+
+   if(writeRes == FhgfsOpsErr_TOOBIG)
+   { // file outgrows the inode => move data to chunks and let the client write there
+      writeRes = promoteFileUnlocked(*inode, entryInfo, msgUserID);
+      if(writeRes == FhgfsOpsErr_SUCCESS)
+         writeRes = FhgfsOpsErr_NOTSUPP;
+   }
+
+   metaStore->releaseFile(entryInfo->getParentEntryID(), inode);
+
+   return writeRes;
+}
+
+/**
+ * Truncate the inline data of a file. If the new size is beyond the inline data limit, the file is
+ * promoted to a regular chunk file.
+ *
+ * Note: Will update persistent metadata on disk.
+ *
+ * @param msgUserID only used for msg header info.
+ * @return FhgfsOpsErr_NOTSUPP if the file data is not inlined (anymore), so the caller has to
+ *    truncate the chunk files.
+ */
+FhgfsOpsErr MsgHelperInlineData::truncData(FileInode& inode, EntryInfo* entryInfo,
+   int64_t filesize, unsigned msgUserID)
+{
+   FileIDLock lock(Program::getApp()->getSessions()->getEntryLockStore(), entryInfo->getEntryID(),
+      true);
+
+   FhgfsOpsErr truncRes = inode.truncInlineData(entryInfo, filesize, getMaxDataSize() );
+
+   if(truncRes == FhgfsOpsErr_TOOBIG)
+   {
+      truncRes = promoteFileUnlocked(inode, entryInfo, msgUserID);
+      if(truncRes == FhgfsOpsErr_SUCCESS)
+         truncRes = FhgfsOpsErr_NOTSUPP;
+   }
+
+   return truncRes;
+}
+
+/**
+ * Move the inline data of a file to its chunk files and turn it into a regular chunk file (e.g. if
+ * it is opened by a client that doesn't support inline data).
+ *
+ * @param msgUserID only used for msg header info.
+ * @return FhgfsOpsErr_SUCCESS also if the file was not an inline data file
+ */
+FhgfsOpsErr MsgHelperInlineData::promoteFile(FileInode& inode, EntryInfo* entryInfo,
+   unsigned msgUserID)
+{
+   FileIDLock lock(Program::getApp()->getSessions()->getEntryLockStore(), entryInfo->getEntryID(),
+      true);
+
+   return promoteFileUnlocked(inode, entryInfo, msgUserID);
+}
+
+/**
+ * @return the configured max size of inline file data, capped to what fits into an inode
+ */
+size_t MsgHelperInlineData::getMaxDataSize()
+{
+   return std::min<size_t>(Program::getApp()->getConfig()->getTuneInlineFileDataMaxSize(),
+      FILEINODE_INLINE_DATA_MAX_SIZE);
+}
+
+/**
+ * Check the size quota of the file owner on the stripe targets of the file, i.e. the targets that
+ * the data would be written to if it was stored in chunk files.
+ *
+ * @return FhgfsOpsErr_DQUOT if the size quota of the owner user or group is exceeded.
+ */
+FhgfsOpsErr MsgHelperInlineData::checkSizeQuota(FileInode& inode)
+{
+   App* app = Program::getApp();
+   const UInt16Vector* targetIDs = inode.getStripePattern()->getStripeTargetIDs();
+   const unsigned userID = inode.getUserID();
+   const unsigned groupID = inode.getGroupID();
+
+   for(auto targetIter = targetIDs->begin(); targetIter != targetIDs->end(); targetIter++)
+   {
+      ExceededQuotaStorePtr quotaExStore = app->getExceededQuotaStores()->get(*targetIter);
+
+      // check if exceeded quotas exist, before doing a more expensive and explicit check
+      if(!quotaExStore || !quotaExStore->someQuotaExceeded() )
+         continue;
+
+      QuotaExceededErrorType quotaExceeded = quotaExStore->isQuotaExceeded(userID, groupID,
+         QuotaLimitType_SIZE);
+
+      if(quotaExceeded != QuotaExceededErrorType_NOT_EXCEEDED)
+      {
+         LOG(QUOTA, NOTICE, QuotaData::QuotaExceededErrorTypeToString(quotaExceeded),
+               ("UID", userID), ("GID", groupID) );
+         return FhgfsOpsErr_DQUOT;
+      }
+   }
+
+   return FhgfsOpsErr_SUCCESS;
+}
+
+/**
+ * Note: Caller must hold the FileIDLock of the file.
+ */
+FhgfsOpsErr MsgHelperInlineData::promoteFileUnlocked(FileInode& inode, EntryInfo* entryInfo,
+   unsigned msgUserID)
+{
+   const char* logContext = "Inline data helper (promote)";
+
+   if(!inode.getHasInlineData() )
+      return FhgfsOpsErr_SUCCESS; // promoted by someone else in the meantime
+
+   const std::string data = inode.getInlineData();
+
+   if(data.empty() )
+      return inode.clearInlineData(entryInfo, data); // no chunk data, just clear the flag
+
+   /* the data is smaller than a chunk, so it all goes to the first target. we use our own storage
+      session for the write, which is closed again after the inode was updated. */
+
+   const NumNodeID localNodeID = Program::getApp()->getLocalNodeNumID();
+   const std::string fileHandleID = SessionTk::generateFileHandleID(0, inode.getEntryID() );
+
+   FhgfsOpsErr retVal = writeChunkData(inode, fileHandleID, data);
+
+   if(retVal == FhgfsOpsErr_SUCCESS)
+      retVal = inode.clearInlineData(entryInfo, data);
+
+   MsgHelperClose::closeChunkFile(localNodeID, fileHandleID, 0, inode, entryInfo, msgUserID);
+
+   if(retVal != FhgfsOpsErr_SUCCESS)
+      LogContext(logContext).log(Log_WARNING, "Unable to move inline data to chunk files. "
+         "fileID: " + inode.getEntryID() + "; "
+         "Error: " + boost::lexical_cast<std::string>(retVal) );
+
+   return retVal;
+}
+
+/**
+ * Write the given data to the beginning of the first chunk file of the given inode.
+ */
+FhgfsOpsErr MsgHelperInlineData::writeChunkData(FileInode& inode,
+   const std::string& fileHandleID, const std::string& data)
+{
+   App* app = Program::getApp();
+   StripePattern* pattern = inode.getStripePattern();
+   const uint16_t targetID = pattern->getStripeTargetIDs()->front();
+
+   PathInfo pathInfo;
+   inode.getPathInfo(&pathInfo);
+
+   int64_t nodeResult = -FhgfsOpsErr_INTERNAL;
+   SynchronizedCounter counter;
+
+   WriteLocalFileWorkInfo writeInfo(app->getLocalNodeNumID(), app->getTargetMapper(),
+      app->getStorageNodes(), &counter);
+
+   app->getCommSlaveQueue()->addDirectWork(new WriteLocalFileWork(fileHandleID.c_str(),
+      data.data(), OPENFILE_ACCESS_WRITE, 0, data.size(), targetID, &pathInfo, &nodeResult,
+      &writeInfo, false) );
+
+   counter.waitForCount(1);
+
+   if(nodeResult < 0)
+      return (FhgfsOpsErr) -nodeResult;
+
+   if( (size_t) nodeResult != data.size() )
+      return FhgfsOpsErr_INTERNAL; // short write
+
+   return FhgfsOpsErr_SUCCESS;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <common/Common.h>
+#include <storage/MetaStore.h>
+
+
+/**
+ * Access to the data of small files that is stored in the inode instead of chunk files (see
+ * FILEINODE_FEATURE_HAS_INLINE_DATA), and promotion of such files to regular chunk files when they
+ * grow beyond the configured limit or a client without inline data support opens them.
+ *
+ * Note: Inline data files are never buddy mirrored.
+ */
+class MsgHelperInlineData
+{
+   public:
+      static FhgfsOpsErr readData(EntryInfo* entryInfo, int64_t offset, int64_t count,
+         std::string& outData);
+      static FhgfsOpsErr writeData(EntryInfo* entryInfo, int64_t offset, const char* buf,
+         size_t count, unsigned msgUserID);
+      static FhgfsOpsErr truncData(FileInode& inode, EntryInfo* entryInfo, int64_t filesize,
+         unsigned msgUserID);
+      static FhgfsOpsErr promoteFile(FileInode& inode, EntryInfo* entryInfo, unsigned msgUserID);
+
+      static size_t getMaxDataSize();
+
+   private:
+      MsgHelperInlineData() {}
+
+      static FhgfsOpsErr checkSizeQuota(FileInode& inode);
+
+      static FhgfsOpsErr promoteFileUnlocked(FileInode& inode, EntryInfo* entryInfo,
+         unsigned msgUserID);
+      static FhgfsOpsErr writeChunkData(FileInode& inode, const std::string& fileHandleID,
+         const std::string& data);
+};
+
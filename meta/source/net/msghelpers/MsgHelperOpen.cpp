@@ -2,6 +2,7 @@
 #include <common/toolkit/MessagingTk.h>
 #include <common/toolkit/SessionTk.h>
 #include <common/storage/striping/Raid0Pattern.h>
+#include <net/msghelpers/MsgHelperInlineData.h>
 #include <net/msghelpers/MsgHelperTrunc.h>
 #include <program/Program.h>
 #include <storage/MetaStore.h>
@@ -12,12 +13,16 @@
  * opened file afterwards.
  * Note: Also performs truncation based on accessFlags if necessary.
  *
+ * Note: Also moves inline file data to the chunk files if the client can't access it.
+ *
  * @param msgUserID only used for msg header info.
  * @param outOpenFile only set if return indicates success.
+ * @param inlineDataSupported true if the client reads/writes inline file data through the meta
+ *    server (see MsgHelperInlineData).
  */
 FhgfsOpsErr MsgHelperOpen::openFile(EntryInfo* entryInfo, unsigned accessFlags,
    bool useQuota, bool bypassAccessCheck, unsigned msgUserID, MetaFileHandle& outFileInode,
-   bool isSecondary)
+   bool isSecondary, bool inlineDataSupported)
 {
    const char* logContext = "Open File Helper";
    IGNORE_UNUSED_VARIABLE(logContext);
@@ -63,7 +68,19 @@ FhgfsOpsErr MsgHelperOpen::openFile(EntryInfo* entryInfo, unsigned accessFlags,
       if(unlikely(truncRes != FhgfsOpsErr_SUCCESS) )
       { // error => undo open()
          openMetaFileCompensate(entryInfo, std::move(outFileInode), accessFlags);
-         openRes = truncRes;
+         return truncRes;
+      }
+   }
+
+   if(!inlineDataSupported && !isSecondary && outFileInode->getHasInlineData() )
+   { // client would access the chunk files directly => move the data there
+      FhgfsOpsErr promoteRes = MsgHelperInlineData::promoteFile(
+         *outFileInode, entryInfo, msgUserID);
+
+      if(unlikely(promoteRes != FhgfsOpsErr_SUCCESS) )
+      { // error => undo open()
+         openMetaFileCompensate(entryInfo, std::move(outFileInode), accessFlags);
+         openRes = promoteRes;
       }
    }
 
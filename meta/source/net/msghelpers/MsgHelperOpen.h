@@ -11,7 +11,7 @@ class MsgHelperOpen
    public:
       static FhgfsOpsErr openFile(EntryInfo* entryInfo, unsigned accessFlags,
          bool useQuota, bool bypassAccessCheck, unsigned msgUserID, MetaFileHandle& outFileInode,
-	 bool isSecondary);
+	 bool isSecondary, bool inlineDataSupported);
 
 
    private:
@@ -55,6 +55,25 @@ FhgfsOpsErr MsgHelperStat::stat(EntryInfo* entryInfo, bool loadFromDisk, unsigne
    return retVal;
 }
 
+/**
+ * Like stat(), but outdated dynamic attribs are returned as they are instead of being refreshed
+ * from the storage servers. For reads on the secondary of a buddy group, which must neither
+ * contact the storage servers nor update the inode on behalf of the primary.
+ */
+FhgfsOpsErr MsgHelperStat::statCached(EntryInfo* entryInfo, bool loadFromDisk,
+   StatData& outStatData, NumNodeID* outParentNodeID, std::string* outParentEntryID)
+{
+   MetaStore* metaStore = Program::getApp()->getMetaStore();
+
+   FhgfsOpsErr retVal = metaStore->stat(entryInfo, loadFromDisk, outStatData, outParentNodeID,
+      outParentEntryID);
+
+   if(retVal == FhgfsOpsErr_DYNAMICATTRIBSOUTDATED)
+      retVal = FhgfsOpsErr_SUCCESS;
+
+   return retVal;
+}
+
 
 /**
  * Refresh current file size and other dynamic attribs from storage servers.
@@ -81,6 +100,9 @@ FhgfsOpsErr MsgHelperStat::refreshDynAttribs(EntryInfo* entryInfo, bool makePers
       return referenceRes;
    }
 
+   if(inode->getHasInlineData() )
+      retVal = FhgfsOpsErr_SUCCESS; // no chunk files, the inode is always up to date
+   else
    if(inode->getStripePattern()->getAssignedNumTargets() == 1)
       retVal = refreshDynAttribsSequential(*inode, entryID, msgUserID);
    else
@@ -11,6 +11,9 @@ class MsgHelperStat
       static FhgfsOpsErr stat(EntryInfo* entryInfo, bool loadFromDisk, unsigned msgUserID,
          StatData& outStatData, NumNodeID* outParentNodeID = NULL,
          std::string* outParentEntryID = NULL);
+      static FhgfsOpsErr statCached(EntryInfo* entryInfo, bool loadFromDisk,
+         StatData& outStatData, NumNodeID* outParentNodeID = NULL,
+         std::string* outParentEntryID = NULL);
       static FhgfsOpsErr refreshDynAttribs(EntryInfo* entryInfo, bool makePersistent,
          unsigned msgUserID);
 
@@ -1,6 +1,7 @@
 #include <common/net/message/storage/TruncLocalFileMsg.h>
 #include <common/net/message/storage/TruncLocalFileRespMsg.h>
 #include <components/worker/TruncChunkFileWork.h>
+#include <net/msghelpers/MsgHelperInlineData.h>
 #include <program/Program.h>
 #include "MsgHelperTrunc.h"
 
@@ -41,6 +42,14 @@ FhgfsOpsErr MsgHelperTrunc::truncFile(EntryInfo* entryInfo, int64_t filesize, bo
 FhgfsOpsErr MsgHelperTrunc::truncChunkFile(FileInode& inode, EntryInfo* entryInfo,
    int64_t filesize, bool useQuota, unsigned userIDHint, DynamicFileAttribsVec& dynAttribs)
 {
+   if(inode.getHasInlineData() )
+   { // no chunk files, unless the new size is too large for inline data
+      FhgfsOpsErr inlineRes = MsgHelperInlineData::truncData(inode, entryInfo, filesize,
+         userIDHint);
+      if(inlineRes != FhgfsOpsErr_NOTSUPP)
+         return inlineRes;
+   }
+
    StripePattern* pattern = inode.getStripePattern();
 
    if( (pattern->getStripeTargetIDs()->size() > 1) ||
@@ -1,6 +1,7 @@
 #include <common/toolkit/MessagingTk.h>
 #include <common/net/message/storage/creating/UnlinkLocalFileMsg.h>
 #include <common/net/message/storage/creating/UnlinkLocalFileRespMsg.h>
+#include <components/ChunkUnlinker.h>
 #include <components/ModificationEventFlusher.h>
 #include <components/worker/UnlinkChunkFileWork.h>
 #include <net/msghelpers/MsgHelperMkFile.h>
@@ -114,6 +115,30 @@ FhgfsOpsErr MsgHelperUnlink::unlinkChunkFiles(FileInode* unlinkedInode, unsigned
    return retVal;
 }
 
+/**
+ * Like unlinkChunkFiles(), but hands the file over to the ChunkUnlinker (if enabled) to delete the
+ * chunk files in the background.
+ *
+ * Falls back to unlinkChunkFiles() if the ChunkUnlinker is disabled, its queue is full or the file
+ * has mirrored metadata.
+ *
+ * @param unlinkedInode will be deleted inside this method or owned by another object, so caller
+ * may no longer access it after calling this.
+ * @param msgUserID only used in msg header info.
+ * @return FhgfsOpsErr_SUCCESS if the file was queued (the chunks are not deleted yet).
+ */
+FhgfsOpsErr MsgHelperUnlink::unlinkChunkFilesAsync(FileInode* unlinkedInode, unsigned msgUserID)
+{
+   ChunkUnlinker* chunkUnlinker = Program::getApp()->getChunkUnlinker();
+
+   // (inline data files have no chunks, so there's nothing to defer)
+   if (chunkUnlinker && !unlinkedInode->getHasInlineData() &&
+       chunkUnlinker->enqueue(unlinkedInode, msgUserID) )
+      return FhgfsOpsErr_SUCCESS;
+
+   return unlinkChunkFiles(unlinkedInode, msgUserID);
+}
+
 /**
  * Wrapper to decide parallel or sequential chunks unlink.
  *
@@ -123,6 +148,9 @@ FhgfsOpsErr MsgHelperUnlink::unlinkChunkFilesInternal(FileInode& file, unsigned
 {
    StripePattern* pattern = file.getStripePattern();
 
+   if(file.getHasInlineData() )
+      return FhgfsOpsErr_SUCCESS; // file data lives in the inode, no chunk files were created
+
    if( (pattern->getStripeTargetIDs()->size() > 1) ||
        (pattern->getPatternType() == StripePatternType_BuddyMirror) )
       return unlinkChunkFileParallel(file, msgUserID);
@@ -15,6 +15,7 @@ class MsgHelperUnlink
       static FhgfsOpsErr unlinkFileInode(EntryInfo* delFileInfo,
          std::unique_ptr<FileInode>* outUnlinkedFile, unsigned& outInitialHardlinkCount);
       static FhgfsOpsErr unlinkChunkFiles(FileInode* unlinkedInode, unsigned msgUserID);
+      static FhgfsOpsErr unlinkChunkFilesAsync(FileInode* unlinkedInode, unsigned msgUserID);
 
    private:
       MsgHelperUnlink() {}
@@ -5,6 +5,8 @@
 #include <common/nodes/Node.h>
 #include <common/nodes/NodeOpStats.h>
 
+#include <mutex>
+
 /**
  * Count filesystem metadata operations
  */
@@ -20,35 +22,27 @@ class MetaNodeOpStats : public NodeOpStats
        */
       void updateNodeOp(unsigned nodeIP, MetaOpCounterTypes opType, unsigned userID)
       {
-         SafeRWLock safeLock(&lock, SafeRWLock_READ);
-
-         NodeOpCounterMapIter nodeIter = clientCounterMap.find(nodeIP);
-         NodeOpCounterMapIter userIter = userCounterMap.find(userID);
+         CounterTable& table = getThreadCounterTable();
 
-         if( (nodeIter == clientCounterMap.end() ) ||
-             (userIter == userCounterMap.end() ) )
-         { // nodeIP or userID NOT found in map yet, we need a write lock
+         std::lock_guard<Mutex> lock(table.mutex);
 
-            safeLock.unlock(); // possible race, but insert below is a NOOP if key already exists
-            safeLock.lock(SafeRWLock_WRITE);
+         NodeOpCounterMapIter nodeIter = table.clientCounterMap.find(nodeIP);
+         NodeOpCounterMapIter userIter = table.userCounterMap.find(userID);
 
-            if(nodeIter == clientCounterMap.end() )
-            {
-               nodeIter = clientCounterMap.insert(
-                  NodeOpCounterMapVal(nodeIP, MetaOpCounter() ) ).first;
-            }
+         if(nodeIter == table.clientCounterMap.end() )
+         { // first op of this nodeIP in this thread
+            nodeIter = table.clientCounterMap.insert(
+               NodeOpCounterMapVal(nodeIP, MetaOpCounter() ) ).first;
+         }
 
-            if(userIter == userCounterMap.end() )
-            {
-               userIter = userCounterMap.insert(
-                  NodeOpCounterMapVal(userID, MetaOpCounter() ) ).first;
-            }
+         if(userIter == table.userCounterMap.end() )
+         { // first op of this userID in this thread
+            userIter = table.userCounterMap.insert(
+               NodeOpCounterMapVal(userID, MetaOpCounter() ) ).first;
          }
 
          nodeIter->second.increaseOpCounter(opType);
          userIter->second.increaseOpCounter(opType);
-
-         safeLock.unlock();
       }
 };
 
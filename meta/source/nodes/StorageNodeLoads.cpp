@@ -0,0 +1,195 @@
+#include <common/app/AbstractApp.h>
+#include <common/components/StatsCollector.h>
+#include <common/net/message/storage/GetTargetLoadStatsMsg.h>
+#include <common/net/message/storage/GetTargetLoadStatsRespMsg.h>
+#include <common/toolkit/MessagingTk.h>
+#include <common/toolkit/Time.h>
+#include "StorageNodeLoads.h"
+
+
+/**
+ * Request the current stats from all storage servers and rebuild the target and buddy group load
+ * maps.
+ *
+ * The requests to all servers are sent before the first answer is received, so that a server that
+ * doesn't answer delays the update by at most STORAGENODELOADS_TIMEOUT_MS (plus the connect timeout
+ * for servers that are not connected yet). The targets of such a server are rated as unreachable.
+ *
+ * Note: Not thread-safe, only to be called by a single thread.
+ */
+void StorageNodeLoads::update(NodeStoreServers* storageNodes, TargetMapper* targetMapper,
+   MirrorBuddyGroupMapper* buddyGroupMapper)
+{
+   const std::vector<NodeHandle> nodes = storageNodes->referenceAllNodes();
+
+   std::vector<Socket*> socks; // (NULL if the request couldn't be sent)
+
+   for (const auto& node : nodes)
+      socks.push_back(sendStatsRequest(*node) );
+
+   Time startT;
+   TargetLoadMap newSmoothedLoads; // (targets of removed servers are dropped this way)
+
+   for (size_t i = 0; i < nodes.size(); i++)
+   {
+      TargetHighResStatsMap targetStats;
+
+      const int timeoutMS =
+         std::max<int>(STORAGENODELOADS_TIMEOUT_MS - (int)startT.elapsedMS(), 1);
+
+      if (!socks[i] || !recvStatsResponse(*nodes[i], socks[i], timeoutMS, targetStats) )
+      {
+         LOG(GENERAL, DEBUG, "Unable to get target loads of storage node.",
+               ("NodeID", nodes[i]->getNodeIDWithTypeStr() ) );
+         continue;
+      }
+
+      for (TargetHighResStatsMapCIter iter = targetStats.begin(); iter != targetStats.end();
+           iter++)
+      {
+         const uint64_t loadMicro = computeLoadMicro(iter->second);
+
+         // smooth a bit to not react to single peaks
+         TargetLoadMapCIter oldIter = smoothedLoads.find(iter->first);
+
+         newSmoothedLoads[iter->first] = (oldIter == smoothedLoads.end() ) ?
+            loadMicro : (oldIter->second + loadMicro) / 2;
+      }
+   }
+
+   smoothedLoads.swap(newSmoothedLoads);
+
+   // loads of all known targets and buddy groups
+
+   auto newTargetLoads = std::make_shared<TargetLoadMap>();
+   auto newGroupLoads = std::make_shared<TargetLoadMap>();
+
+   const TargetMap targetMap = targetMapper->getMapping();
+
+   for (TargetMapCIter iter = targetMap.begin(); iter != targetMap.end(); iter++)
+   {
+      TargetLoadMapCIter loadIter = smoothedLoads.find(iter->first);
+
+      (*newTargetLoads)[iter->first] = (loadIter == smoothedLoads.end() ) ?
+         STORAGENODELOADS_UNREACHABLE : loadIter->second;
+   }
+
+   const MirrorBuddyGroupMap groupMap = buddyGroupMapper->getMapping();
+
+   for (MirrorBuddyGroupMapCIter iter = groupMap.begin(); iter != groupMap.end(); iter++)
+   { // writes go to both targets of a group, so the more loaded one counts
+      TargetLoadMapCIter firstIter = newTargetLoads->find(iter->second.firstTargetID);
+      TargetLoadMapCIter secondIter = newTargetLoads->find(iter->second.secondTargetID);
+
+      const uint64_t firstLoad = (firstIter == newTargetLoads->end() ) ? 0 : firstIter->second;
+      const uint64_t secondLoad = (secondIter == newTargetLoads->end() ) ? 0 : secondIter->second;
+
+      (*newGroupLoads)[iter->first] = std::max(firstLoad, secondLoad);
+   }
+
+   std::lock_guard<Mutex> lock(mutex);
+
+   targetLoads = std::move(newTargetLoads);
+   groupLoads = std::move(newGroupLoads);
+}
+
+/**
+ * @param stats stats of the last stats interval of the worker queue of a target.
+ * @return estimated time in microseconds that a new request spends in the server before it is
+ *    processed.
+ */
+uint64_t StorageNodeLoads::computeLoadMicro(const HighResolutionStats& stats)
+{
+   const uint64_t numRequests = stats.rawVals.busyWorkers + stats.rawVals.queuedRequests;
+
+   // finished requests of the last stats interval (at least one to avoid division by zero, so that
+   // a stalled queue gets the whole interval per request)
+   const uint64_t numFinished = std::max(stats.incVals.workRequests, 1u);
+
+   return numRequests * STATSCOLLECTOR_COLLECT_INTERVAL_MS * 1000 / numFinished;
+}
+
+/**
+ * @return socket for recvStatsResponse() or NULL if the request couldn't be sent.
+ */
+Socket* StorageNodeLoads::sendStatsRequest(Node& node)
+{
+   NodeConnPool* connPool = node.getConnPool();
+   Socket* sock = NULL;
+
+   try
+   {
+      sock = connPool->acquireStreamSocket();
+
+      GetTargetLoadStatsMsg getStatsMsg;
+
+      const auto sendBuf = MessagingTk::createMsgVec(getStatsMsg);
+      sock->send(&sendBuf[0], sendBuf.size(), 0);
+
+      return sock;
+   }
+   catch (SocketException& e)
+   {
+      if (sock)
+         connPool->invalidateStreamSocket(sock);
+
+      return NULL;
+   }
+}
+
+/**
+ * Receive the response to sendStatsRequest() and release the socket.
+ *
+ * Note: MessagingTk doesn't allow receive timeouts below connMsgLongTimeout, so the response is
+ * received here.
+ *
+ * @param timeoutMS max wait time for each part of the response.
+ * @return false on error or timeout.
+ */
+bool StorageNodeLoads::recvStatsResponse(Node& node, Socket* sock, int timeoutMS,
+   TargetHighResStatsMap& outTargetStats)
+{
+   NodeConnPool* connPool = node.getConnPool();
+
+   try
+   {
+      std::vector<char> respBuf(NETMSG_MIN_LENGTH);
+
+      sock->recvExactT(&respBuf[0], NETMSG_MIN_LENGTH, 0, timeoutMS);
+
+      const unsigned msgLength =
+         NetMessageHeader::extractMsgLengthFromBuf(&respBuf[0], NETMSG_MIN_LENGTH);
+
+      if ( (msgLength < NETMSG_MIN_LENGTH) || (msgLength > STORAGENODELOADS_MAX_RESP_LEN) )
+      {
+         connPool->invalidateStreamSocket(sock);
+         return false;
+      }
+
+      respBuf.resize(msgLength);
+
+      if (msgLength > NETMSG_MIN_LENGTH)
+         sock->recvExactT(&respBuf[NETMSG_MIN_LENGTH], msgLength - NETMSG_MIN_LENGTH, 0,
+            timeoutMS);
+
+      auto respMsg = PThread::getCurrentThreadApp()->getNetMessageFactory()->createFromBuf(
+         std::move(respBuf) );
+
+      if (respMsg->getMsgType() != NETMSGTYPE_GetTargetLoadStatsResp)
+      { // (e.g. old server that doesn't know the request)
+         connPool->invalidateStreamSocket(sock);
+         return false;
+      }
+
+      outTargetStats.swap(static_cast<GetTargetLoadStatsRespMsg&>(*respMsg).getTargetStats() );
+
+      connPool->releaseStreamSocket(sock);
+
+      return true;
+   }
+   catch (SocketException& e)
+   { // (includes timeout)
+      connPool->invalidateStreamSocket(sock);
+      return false;
+   }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <common/nodes/MirrorBuddyGroupMapper.h>
+#include <common/nodes/NodeStoreServers.h>
+#include <common/nodes/TargetCapacityPools.h>
+#include <common/nodes/TargetMapper.h>
+#include <common/threading/Mutex.h>
+#include <common/toolkit/HighResolutionStats.h>
+#include <common/Common.h>
+
+#include <memory>
+#include <mutex>
+
+
+#define STORAGENODELOADS_UNREACHABLE   (~0ULL) // load of targets of servers that didn't answer
+#define STORAGENODELOADS_TIMEOUT_MS    500 // max wait for the answers of all servers of an update
+#define STORAGENODELOADS_MAX_RESP_LEN  (1024*1024)
+
+
+/**
+ * Load of the storage targets for the loadaware target chooser.
+ *
+ * The load of a target is the estimated time in microseconds that a new request for the target
+ * spends in the storage server before it is processed, i.e. the residence time of the queued and
+ * busy requests of the worker queue that serves the target (Little's law with the number of
+ * finished requests of the last stats interval as throughput). With per-target worker queues
+ * (storage tuneUsePerTargetWorkers) each target has its own load, otherwise all targets of a server
+ * share the load of the server's queue. The load is smoothed over the updates; the load of a buddy
+ * group is the higher load of its two targets.
+ *
+ * The per-target and per-group maps are rebuilt by update() (called by the StorageLoadsPoller), so
+ * that file creates only take a reference to the current maps.
+ */
+class StorageNodeLoads
+{
+   public:
+      StorageNodeLoads() : targetLoads(std::make_shared<TargetLoadMap>() ),
+         groupLoads(std::make_shared<TargetLoadMap>() )
+      {
+      }
+
+      void update(NodeStoreServers* storageNodes, TargetMapper* targetMapper,
+         MirrorBuddyGroupMapper* buddyGroupMapper);
+
+      static uint64_t computeLoadMicro(const HighResolutionStats& stats);
+
+
+   private:
+      // smoothed loads of the targets of the servers that answered the last update; only accessed
+      // by update()
+      TargetLoadMap smoothedLoads;
+
+      Mutex mutex; // protects the map pointers below (not the maps, which are never modified)
+      std::shared_ptr<const TargetLoadMap> targetLoads;
+      std::shared_ptr<const TargetLoadMap> groupLoads; // keys are buddy group IDs
+
+      static Socket* sendStatsRequest(Node& node);
+      static bool recvStatsResponse(Node& node, Socket* sock, int timeoutMS,
+         TargetHighResStatsMap& outTargetStats);
+
+
+   public:
+      // getters & setters
+
+      std::shared_ptr<const TargetLoadMap> getTargetLoads()
+      {
+         std::lock_guard<Mutex> lock(mutex);
+         return targetLoads;
+      }
+
+      std::shared_ptr<const TargetLoadMap> getBuddyGroupLoads()
+      {
+         std::lock_guard<Mutex> lock(mutex);
+         return groupLoads;
+      }
+};
@@ -9,6 +9,8 @@
  */
 class Program
 {
+   friend class TestApp;
+
    public:
       static int main(int argc, char** argv);
    
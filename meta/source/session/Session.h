@@ -41,12 +41,12 @@ struct MirrorStateSlot
 class Session
 {
    public:
-      Session(NumNodeID sessionID) : sessionID(sessionID) {}
+      Session(NumNodeID sessionID) : sessionID(sessionID), highestSeqNo(0) {}
 
       /*
        * For deserialization only
        */
-      Session() {};
+      Session() : highestSeqNo(0) {};
 
       void mergeSessionFiles(Session* session);
 
@@ -82,6 +82,12 @@ class Session
       //    the response state alive as long as some thread is still operating on it.
       std::map<uint64_t, std::shared_ptr<MirrorStateSlot>> mirrorProcessState;
 
+      // highest sequence number seen since startup (not serialized). on the secondary, this is the
+      // watermark for read-only requests that a client sends to the secondary directly: the client
+      // only learns that a sequence number is done from the primary's response, which is sent after
+      // the secondary has processed the forwarded request.
+      uint64_t highestSeqNo;
+
       void dropEmptyStateSlots(Serializer&) const
       {
       }
@@ -148,6 +154,8 @@ class Session
                mirrorProcessState.begin(),
                mirrorProcessState.lower_bound(endSeqno + 1));
 
+         highestSeqNo = std::max(highestSeqNo, thisSeqno);
+
          auto inserted = mirrorProcessState.insert(
                {thisSeqno, std::make_shared<MirrorStateSlot>()});
          return {inserted.first->second, inserted.second};
@@ -160,11 +168,20 @@ class Session
 
          mirrorProcessState.erase(finishedSeqno);
 
+         highestSeqNo = std::max(highestSeqNo, thisSeqno);
+
          auto inserted = mirrorProcessState.insert(
                {thisSeqno, std::make_shared<MirrorStateSlot>()});
          return {inserted.first->second, inserted.second};
       }
 
+      uint64_t getHighestSeqNo()
+      {
+         std::lock_guard<Mutex> lock(mirrorProcessStateLock);
+
+         return highestSeqNo;
+      }
+
       uint64_t getSeqNoBase()
       {
          std::lock_guard<Mutex> lock(mirrorProcessStateLock);
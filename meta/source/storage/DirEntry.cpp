@@ -181,6 +181,8 @@ bool DirEntry::storeUpdatedDirEntryBuf(const std::string& idStorePath, char* buf
       ? storeUpdatedDirEntryBufAsXAttr(idStorePath, buf, bufLen)
       : storeUpdatedDirEntryBufAsContents(idStorePath, buf, bufLen);
 
+   InodeStatCache::invalidateEntry(getEntryID() ); // (might contain an inlined inode)
+
    return result;
 }
 
@@ -415,6 +417,8 @@ FhgfsOpsErr DirEntry::removeDirEntryID(const std::string& dirEntryPath,
       if (auto* resync = BuddyResyncer::getSyncChangeset())
          resync->addDeletion(idPath, MetaSyncFileType::Inode);
 
+   InodeStatCache::invalidateEntry(entryID);
+
    return idUnlinkRes;
 }
 
@@ -532,6 +536,8 @@ FhgfsOpsErr DirEntry::removeBusyFile(const std::string& dirEntryBasePath,
    }
 
 out:
+   InodeStatCache::invalidateEntry(entryID);
+
    return retVal;
 }
 
@@ -865,5 +871,7 @@ FhgfsOpsErr DirEntry::storeInitialDirEntry(const std::string& dirEntryPath)
          resync->addModification(namePath, MetaSyncFileType::Dentry);
       }
 
+   InodeStatCache::invalidateEntry(getEntryID() );
+
    return result;
 }
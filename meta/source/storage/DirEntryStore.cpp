@@ -31,20 +31,66 @@ static inline std::string getDirEntryStoreDynamicEntryPath(const std::string& pa
  * adding any elements.
  */
 DirEntryStore::DirEntryStore() :
-   parentID("<undef>"), isBuddyMirrored(false)
+   parentID("<undef>"), isBuddyMirrored(false), numNameLockShards(0)
 {
 }
 
 /**
  * @param parentID ID of the directory to which this store belongs
  * @param isBuddyMirrored true if the directory to which this store belongs is buddy mirrored
+ * @param numNameLockShards number of name lock shards (see lockNames() ), 0 or 1 to lock the whole
+ *    store for every op.
  */
-DirEntryStore::DirEntryStore(const std::string& parentID, bool isBuddyMirrored) :
+DirEntryStore::DirEntryStore(const std::string& parentID, bool isBuddyMirrored,
+   unsigned numNameLockShards) :
    parentID(parentID), dirEntryPath(getDirEntryStoreDynamicEntryPath(parentID, isBuddyMirrored) ),
-   isBuddyMirrored(isBuddyMirrored)
+   isBuddyMirrored(isBuddyMirrored),
+   nameLockShards(numNameLockShards > 1 ? new RWLock[numNameLockShards] : NULL),
+   numNameLockShards(numNameLockShards > 1 ? numNameLockShards : 0)
 {
 }
 
+/**
+ * Lock the store for an op on the given entry name(s).
+ *
+ * Without name lock shards, this simply locks the store rwlock in the given mode. With shards, the
+ * store rwlock is only read-locked (so that it still excludes ops on the whole store) and the
+ * shards of the names are locked in the given mode (in index order if there are two of them).
+ *
+ * @param name empty if the op doesn't refer to a name (e.g. unlink by ID only), which locks the
+ *    whole store.
+ * @param secondName may be NULL.
+ */
+DirEntryStore::NameLock DirEntryStore::lockNames(SafeRWLockType lockType,
+   const std::string& name, const std::string* secondName)
+{
+   NameLock lock;
+
+   if (!numNameLockShards || name.empty() || (secondName && secondName->empty() ) )
+   {
+      lock.storeLock = UniqueRWLock(rwlock, lockType);
+      return lock;
+   }
+
+   lock.storeLock = UniqueRWLock(rwlock, SafeRWLock_READ);
+
+   const std::hash<std::string> nameHash;
+
+   unsigned firstShard = nameHash(name) % numNameLockShards;
+   unsigned secondShard = secondName ?
+      nameHash(*secondName) % numNameLockShards : firstShard;
+
+   if (secondShard < firstShard)
+      std::swap(firstShard, secondShard);
+
+   lock.firstShardLock = UniqueRWLock(nameLockShards[firstShard], lockType);
+
+   if (secondShard != firstShard)
+      lock.secondShardLock = UniqueRWLock(nameLockShards[secondShard], lockType);
+
+   return lock;
+}
+
 /*
  * Create the new directory for dentries (dir-entries). This directory will contain directory
  * entries of files and sub-directories of the directory given by dirID.
@@ -181,15 +227,9 @@ bool DirEntryStore::rmDirEntryStoreDir(const std::string& id, bool isBuddyMirror
  */
 FhgfsOpsErr DirEntryStore::makeEntry(DirEntry* entry)
 {
-   FhgfsOpsErr mkRes;
-
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE);
-
-   mkRes = makeEntryUnlocked(entry);
-
-   safeLock.unlock();
+   NameLock lock = lockNames(SafeRWLock_WRITE, entry->getName() ); // L O C K
 
-   return mkRes;
+   return makeEntryUnlocked(entry);
 }
 
 /**
@@ -216,13 +256,9 @@ FhgfsOpsErr DirEntryStore::makeEntryUnlocked(DirEntry* entry)
  */
 FhgfsOpsErr DirEntryStore::linkInodeToDir(const std::string& inodePath, const std::string &fileName)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE);
-
-   FhgfsOpsErr retVal = linkInodeToDirUnlocked(inodePath, fileName);
-
-   safeLock.unlock();
+   NameLock lock = lockNames(SafeRWLock_WRITE, fileName); // L O C K
 
-   return retVal;
+   return linkInodeToDirUnlocked(inodePath, fileName);
 }
 
 
@@ -256,13 +292,9 @@ FhgfsOpsErr DirEntryStore::linkInodeToDirUnlocked(const std::string& inodePath,
  */
 FhgfsOpsErr DirEntryStore::removeDir(const std::string& entryName, DirEntry** outDirEntry)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE);
-
-   FhgfsOpsErr delErr = removeDirUnlocked(entryName, outDirEntry);
+   NameLock lock = lockNames(SafeRWLock_WRITE, entryName); // L O C K
 
-   safeLock.unlock();
-
-   return delErr;
+   return removeDirUnlocked(entryName, outDirEntry);
 }
 
 /**
@@ -276,13 +308,9 @@ FhgfsOpsErr DirEntryStore::removeDir(const std::string& entryName, DirEntry** ou
 FhgfsOpsErr DirEntryStore::unlinkDirEntry(const std::string& entryName, DirEntry* entry,
    unsigned unlinkTypeFlags)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE);
-
-   FhgfsOpsErr delErr = unlinkDirEntryUnlocked(entryName, entry, unlinkTypeFlags);
+   NameLock lock = lockNames(SafeRWLock_WRITE, entryName); // L O C K
 
-   safeLock.unlock();
-
-   return delErr;
+   return unlinkDirEntryUnlocked(entryName, entry, unlinkTypeFlags);
 }
 
 /**
@@ -352,7 +380,7 @@ FhgfsOpsErr DirEntryStore::linkEntryInDir(const std::string& fromEntryName,
 {
    const char *logContext = "DirEntryStore renameEntry";
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE);
+   NameLock lock = lockNames(SafeRWLock_WRITE, fromEntryName, &toEntryName); // L O C K
 
    FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS;
 
@@ -373,7 +401,7 @@ FhgfsOpsErr DirEntryStore::linkEntryInDir(const std::string& fromEntryName,
       }
    }
 
-   safeLock.unlock();
+   lock = NameLock(); // U N L O C K
 
    if (getIsBuddyMirrored())
       if (auto* resync = BuddyResyncer::getSyncChangeset())
@@ -395,7 +423,7 @@ FhgfsOpsErr DirEntryStore::renameEntry(const std::string& fromEntryName,
 {
    const char *logContext = "DirEntryStore renameEntry";
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE);
+   NameLock lock = lockNames(SafeRWLock_WRITE, fromEntryName, &toEntryName); // L O C K
 
    FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS;
 
@@ -413,7 +441,7 @@ FhgfsOpsErr DirEntryStore::renameEntry(const std::string& fromEntryName,
       retVal = FhgfsOpsErr_INTERNAL;
    }
 
-   safeLock.unlock();
+   lock = NameLock(); // U N L O C K
 
    if (isBuddyMirrored)
       if (auto* resync = BuddyResyncer::getSyncChangeset())
@@ -639,15 +667,9 @@ err_unlock:
 
 bool DirEntryStore::exists(const std::string& entryName)
 {
-   bool existsRes = false;
-   
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
-   
-   existsRes = existsUnlocked(entryName);
+   NameLock lock = lockNames(SafeRWLock_READ, entryName); // L O C K
 
-   safeLock.unlock(); // U N L O C K
-   
-   return existsRes;   
+   return existsUnlocked(entryName);
 }
 
 bool DirEntryStore::existsUnlocked(const std::string& entryName)
@@ -673,8 +695,8 @@ FhgfsOpsErr DirEntryStore::getEntryData(const std::string& entryName, EntryInfo*
    FileInodeStoreData* outInodeMetaData)
 {
    FhgfsOpsErr retVal = FhgfsOpsErr_PATHNOTEXISTS;
-   
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+
+   NameLock lock = lockNames(SafeRWLock_READ, entryName); // L O C K
 
    DirEntry entry(entryName);
 
@@ -707,8 +729,6 @@ FhgfsOpsErr DirEntryStore::getEntryData(const std::string& entryName, EntryInfo*
       retVal = FhgfsOpsErr_SUCCESS;
    }
 
-   safeLock.unlock(); // U N L O C K
-   
    return retVal;
 }
 
@@ -717,13 +737,9 @@ FhgfsOpsErr DirEntryStore::getEntryData(const std::string& entryName, EntryInfo*
  */
 DirEntry* DirEntryStore::dirEntryCreateFromFile(const std::string& entryName)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
-
-   DirEntry* dirEntry= DirEntry::createFromFile(this->getDirEntryPathUnlocked(), entryName);
-
-   safeLock.unlock(); // U N L O C K
+   NameLock lock = lockNames(SafeRWLock_READ, entryName); // L O C K
 
-   return dirEntry;
+   return DirEntry::createFromFile(this->getDirEntryPathUnlocked(), entryName);
 }
 
 /**
@@ -747,7 +763,7 @@ FhgfsOpsErr DirEntryStore::setOwnerNodeID(const std::string& entryName, NumNodeI
    DirEntry entry(entryName);
    bool loadRes;
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE);
+   NameLock lock = lockNames(SafeRWLock_WRITE, entryName); // L O C K
 
    loadRes = entry.loadFromFileName(getDirEntryPathUnlocked(), entryName);
    if(!loadRes)
@@ -761,7 +777,6 @@ FhgfsOpsErr DirEntryStore::setOwnerNodeID(const std::string& entryName, NumNodeI
          retVal = FhgfsOpsErr_SUCCESS;
       }
    }
-   safeLock.unlock();
 
    return retVal;
 }
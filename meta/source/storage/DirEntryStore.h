@@ -2,6 +2,7 @@
 
 #include <common/Common.h>
 #include <common/threading/Mutex.h>
+#include <common/threading/UniqueRWLock.h>
 #include <common/toolkit/MetadataTk.h>
 #include <common/storage/StorageDefinitions.h>
 #include <common/storage/StorageErrors.h>
@@ -36,7 +37,8 @@ class DirEntryStore
 
    public:
       DirEntryStore();
-      DirEntryStore(const std::string& parentID, bool isBuddyMirrored);
+      DirEntryStore(const std::string& parentID, bool isBuddyMirrored,
+         unsigned numNameLockShards = 0);
 
       FhgfsOpsErr makeEntry(DirEntry* entry);
 
@@ -66,6 +68,16 @@ class DirEntryStore
       static bool rmDirEntryStoreDir(const std::string& id, bool isBuddyMirrored);
 
    private:
+      /**
+       * Lock for an op on one or two entry names (see lockNames() ).
+       */
+      struct NameLock
+      {
+         UniqueRWLock storeLock;
+         UniqueRWLock firstShardLock;
+         UniqueRWLock secondShardLock;
+      };
+
       std::string parentID; // ID of the directory to which this store belongs
       std::string dirEntryPath; /* path to dirEntry, without the last element (fileName)
                                  * depends on parentID, so changes when parentID is set */
@@ -73,6 +85,15 @@ class DirEntryStore
       RWLock rwlock;
       bool isBuddyMirrored;
 
+      /* name lock shards (tuneDirEntryLockShards). if set, ops on entry names only read-lock
+       * rwlock and write-lock the shards of their names, so that e.g. creates of different names
+       * in the same dir don't exclude each other. */
+      std::unique_ptr<RWLock[]> nameLockShards;
+      unsigned numNameLockShards; // 0 if sharding is disabled
+
+      NameLock lockNames(SafeRWLockType lockType, const std::string& name,
+         const std::string* secondName = NULL);
+
       FhgfsOpsErr makeEntryUnlocked(DirEntry* entry);
       FhgfsOpsErr linkInodeToDirUnlocked(const std::string& inodePath, const std::string &fileName);
 
@@ -97,15 +118,9 @@ class DirEntryStore
          // note: the difference to getDirDentry/getFileDentry is that this works independent
             // of the link type
 
-         bool exists = false;
-
-         SafeRWLock safeLock(&rwlock, SafeRWLock_READ);
-
-         exists = outEntry.loadFromFileName(getDirEntryPathUnlocked(), entryName);
-
-         safeLock.unlock();
+         NameLock lock = lockNames(SafeRWLock_READ, entryName); // L O C K
 
-         return exists;
+         return outEntry.loadFromFileName(getDirEntryPathUnlocked(), entryName);
       }
 
       const std::string& getParentEntryID() const
@@ -176,6 +191,14 @@ class DirEntryStore
          return this->isBuddyMirrored;
       }
 
+      /*
+       * Note: No locking here, the shards are only set on initialization
+       */
+      bool getHasNameLockShards() const
+      {
+         return numNameLockShards != 0;
+      }
+
       // getters & setters
       void setParentID(const std::string& parentID, bool parentIsBuddyMirrored);
 
@@ -187,14 +210,10 @@ class DirEntryStore
       FhgfsOpsErr removeBusyFile(const std::string& entryName, DirEntry* dentry,
          unsigned unlinkTypeFlags)
       {
-         SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // Lock
-
-         FhgfsOpsErr retVal = dentry->removeBusyFile(getDirEntryPathUnlocked(), dentry->getID(),
-            entryName, unlinkTypeFlags);
-
-         safeLock.unlock();
+         NameLock lock = lockNames(SafeRWLock_WRITE, entryName); // L O C K
 
-         return retVal;
+         return dentry->removeBusyFile(getDirEntryPathUnlocked(), dentry->getID(), entryName,
+            unlinkTypeFlags);
       }
 };
 
@@ -137,6 +137,12 @@ StripePattern* DirInode::createFileStripePatternUnlocked(const UInt16List* prefe
                                              preferredTargets, &stripeTargets);
       }
       else
+      if(chooserType == TargetChooserType_LOADAWARE)
+      { // groups on less loaded storage servers
+         capacityPools->chooseStorageTargetsLoadAware(desiredNumTargets, minNumRequiredTargets,
+            *app->getStorageNodeLoads()->getBuddyGroupLoads(), &stripeTargets);
+      }
+      else
       { // round robin or randomized round robin chooser
          capacityPools->chooseStorageTargetsRoundRobin(desiredNumTargets, &stripeTargets);
 
@@ -177,6 +183,12 @@ StripePattern* DirInode::createFileStripePatternUnlocked(const UInt16List* prefe
                                                  &stripeTargets);
       }
       else
+      if(chooserType == TargetChooserType_LOADAWARE)
+      { // targets on less loaded storage servers
+         capacityPools->chooseStorageTargetsLoadAware(desiredNumTargets, minNumRequiredTargets,
+            *app->getStorageNodeLoads()->getTargetLoads(), &stripeTargets);
+      }
+      else
       { // round robin or randomized round robin chooser
          capacityPools->chooseStorageTargetsRoundRobin(desiredNumTargets, &stripeTargets);
 
@@ -486,6 +498,9 @@ FhgfsOpsErr DirInode::getEntryData(const std::string& entryName, EntryInfo* outI
  */
 FhgfsOpsErr DirInode::makeDirEntry(DirEntry& entry)
 {
+   if (entries.getHasNameLockShards() )
+      return makeDirEntryParallel(entry);
+
    SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
 
    // we always delete the entry from this method
@@ -496,6 +511,67 @@ FhgfsOpsErr DirInode::makeDirEntry(DirEntry& entry)
    return mkRes;
 }
 
+/**
+ * Like makeDirEntry(), but only read-locks this dir while the dentry is created, so that creates of
+ * different names in the same dir only serialize on the name lock shards of the DirEntryStore and
+ * on the update of the dir attributes afterwards (and in the underlying file system, which locks
+ * the dentries dir for the link of the new dentry).
+ *
+ * This is fine, because all other ops that modify entries write-lock the dir and because the
+ * dentry-by-name file of a new entry is created atomically by link(). The dir can't be removed
+ * between the creation of the dentry and the increase of the number of entries, because the caller
+ * holds a reference to it (see InodeDirStore::isRemovableUnlocked() ).
+ */
+FhgfsOpsErr DirInode::makeDirEntryParallel(DirEntry& entry)
+{
+   DirEntryType entryType = entry.getEntryType();
+   if (unlikely( (!DirEntryType_ISFILE(entryType) && (!DirEntryType_ISDIR(entryType) ) ) ) )
+      return FhgfsOpsErr_INTERNAL;
+
+   UniqueRWLock lock(rwlock, SafeRWLock_READ); // L O C K
+
+   if (unlikely(!isLoaded) )
+   { // loading needs the write lock (keep it for this create, it's rare)
+      lock.unlock();
+      lock.lock(SafeRWLock_WRITE);
+
+      if (!loadIfNotLoadedUnlocked() )
+         return FhgfsOpsErr_PATHNOTEXISTS;
+   }
+
+   FhgfsOpsErr mkRes = entries.makeEntry(&entry);
+
+   lock.unlock(); // U N L O C K
+
+   if (mkRes == FhgfsOpsErr_SUCCESS)
+   {
+      lock.lock(SafeRWLock_WRITE); // L O C K
+
+      // (reloads the counters from disk if the dir was invalidated in the meantime)
+      if (loadIfNotLoadedUnlocked() )
+      {
+         if (DirEntryType_ISDIR(entryType) )
+            increaseNumSubDirsAndStoreOnDisk();
+         else
+            increaseNumFilesAndStoreOnDisk();
+      }
+
+      lock.unlock(); // U N L O C K
+   }
+
+   if (getIsBuddyMirrored())
+   {
+      if (auto* resync = BuddyResyncer::getSyncChangeset())
+      {
+         const Path* inodePath = Program::getApp()->getBuddyMirrorInodesPath();
+         std::string inodeFilename = MetaStorageTk::getMetaInodePath(inodePath->str(), id);
+         resync->addModification(inodeFilename, MetaSyncFileType::Inode);
+      }
+   }
+
+   return mkRes;
+}
+
 FhgfsOpsErr DirInode::makeDirEntryUnlocked(DirEntry* entry)
 {
    FhgfsOpsErr mkRes = FhgfsOpsErr_INTERNAL;
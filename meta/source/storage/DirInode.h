@@ -48,13 +48,16 @@ class DirInode
       /**
        * Constructur used to load inodes from disk
        * Note: Not all values are set, as we load those from disk.
+       *
+       * @param numEntryLockShards see DirEntryStore, only useful for dirs that are shared by
+       *    several threads (i.e. cached in the InodeDirStore).
        */
-      DirInode(const std::string& id, bool isBuddyMirrored)
+      DirInode(const std::string& id, bool isBuddyMirrored, unsigned numEntryLockShards = 0)
        : id(id),
          stripePattern(NULL),
          featureFlags(isBuddyMirrored ? DIRINODE_FEATURE_BUDDYMIRRORED : 0),
          exclusive(false),
-         entries(id, isBuddyMirrored),
+         entries(id, isBuddyMirrored, numEntryLockShards),
          isLoaded(false)
       { }
 
@@ -173,6 +176,7 @@ class DirInode
       FhgfsOpsErr refreshMetaInfoUnlocked();
 
 
+      FhgfsOpsErr makeDirEntryParallel(DirEntry& entry);
       FhgfsOpsErr makeDirEntryUnlocked(DirEntry* entry);
       FhgfsOpsErr linkFileInodeToDirUnlocked(const std::string& inodePath,
          const std::string &fileName);
@@ -490,6 +490,9 @@ void DiskMetaData::serializeDentryV6(Serializer& ser)
       ser % inodeData->getFileVersion();
       ser % inodeData->getMetaVersion();
    }
+
+   if (inodeFeatureFlags & FILEINODE_FEATURE_HAS_INLINE_DATA)
+      ser % serdes::stringAlign4(inodeData->getInlineData());
 }
       
 
@@ -596,6 +599,9 @@ void DiskMetaData::deserializeDentryV5V6(Deserializer& des, bool hasStoragePool)
       des % inodeData->metaVersion;
    }
    inodeData->addInodeFeatureFlag(FILEINODE_FEATURE_HAS_VERSIONS);
+
+   if (inodeFeatureFlags & FILEINODE_FEATURE_HAS_INLINE_DATA)
+      des % serdes::stringAlign4(inodeData->getInlineDataRef());
 }
 
 void DiskMetaData::deserializeDentryV5(Deserializer& des)
@@ -824,7 +830,8 @@ unsigned DiskMetaData::getSupportedDentryV5FileInodeFeatureFlags()
 {
    return FILEINODE_FEATURE_MIRRORED | FILEINODE_FEATURE_BUDDYMIRRORED |
       FILEINODE_FEATURE_HAS_ORIG_PARENTID | FILEINODE_FEATURE_HAS_ORIG_UID |
-      FILEINODE_FEATURE_HAS_VERSIONS | FILEINODE_FEATURE_HAS_RST | FILEINODE_FEATURE_HAS_STATE_FLAGS;
+      FILEINODE_FEATURE_HAS_VERSIONS | FILEINODE_FEATURE_HAS_RST | FILEINODE_FEATURE_HAS_STATE_FLAGS |
+      FILEINODE_FEATURE_HAS_INLINE_DATA;
 }
 
 /**
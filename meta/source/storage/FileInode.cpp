@@ -332,6 +332,8 @@ bool FileInode::storeUpdatedMetaDataBuf(char* buf, unsigned bufLen)
       if (auto* resync = BuddyResyncer::getSyncChangeset())
          resync->addModification(metaFilename, MetaSyncFileType::Inode);
 
+   InodeStatCache::invalidateEntry(inodeDiskData.getEntryID() );
+
    return result;
 }
 
@@ -776,6 +778,8 @@ bool FileInode::removeStoredMetaData(const std::string& id, bool isBuddyMirrored
 
    LOG_DEBUG(logContext, 4, "Inode file deleted: " + inodeFilename);
 
+   InodeStatCache::invalidateEntry(id);
+
    if (isBuddyMirrored)
       if (auto* resync = BuddyResyncer::getSyncChangeset())
          resync->addDeletion(inodeFilename, MetaSyncFileType::Inode);
@@ -784,6 +788,35 @@ bool FileInode::removeStoredMetaData(const std::string& id, bool isBuddyMirrored
 }
 
 
+/**
+ * Get the stat data of an inode from disk (or from the MetaStore's stat cache).
+ *
+ * Note: Use this only if the file is not loaded already (because otherwise the dyn attribs
+ * will be outdated)
+ */
+FhgfsOpsErr FileInode::getStatData(EntryInfo* entryInfo, StatData& outStatData)
+{
+   InodeStatCache* statCache = Program::getApp()->getMetaStore()->getInodeStatCache();
+   uint64_t cacheGeneration = 0;
+
+   if (statCache->isEnabled() && statCache->get(entryInfo, outStatData, cacheGeneration) )
+      return FhgfsOpsErr_SUCCESS;
+
+   FileInode* inode = createFromEntryInfo(entryInfo);
+
+   if(!inode)
+      return FhgfsOpsErr_PATHNOTEXISTS;
+
+   FhgfsOpsErr retVal = inode->getStatData(outStatData);
+
+   delete inode;
+
+   if (statCache->isEnabled() && (retVal == FhgfsOpsErr_SUCCESS) )
+      statCache->put(entryInfo, outStatData, cacheGeneration);
+
+   return retVal;
+}
+
 /**
  * Note: Wrapper/chooser for loadFromFileXAttr/Contents.
  * Note: This also (indirectly) calls initFileInfoVec()
@@ -3036,4 +3069,150 @@ FhgfsOpsErr FileInode::checkAccessAndOpen(unsigned accessFlags, bool bypassAcces
    // Access allowed - increment session counter
    incNumSessionsUnlocked(accessFlags);
    return FhgfsOpsErr_SUCCESS;
-}
\ No newline at end of file
+}
+
+/**
+ * Read from the data of an inline data file (see FILEINODE_FEATURE_HAS_INLINE_DATA).
+ *
+ * @param outData less than count bytes at the end of the file, empty beyond the end
+ * @return FhgfsOpsErr_NOTSUPP if the file data is not inlined (i.e. lives in chunks)
+ */
+FhgfsOpsErr FileInode::readInlineData(int64_t offset, int64_t count, std::string& outData)
+{
+   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+
+   if (!inodeDiskData.getHasInlineData())
+      return FhgfsOpsErr_NOTSUPP;
+
+   if ( (offset < 0) || (count < 0) )
+      return FhgfsOpsErr_INVAL;
+
+   const std::string& data = inodeDiskData.getInlineData();
+
+   if (offset < (int64_t) data.size())
+      outData.assign(data, offset, count);
+   else
+      outData.clear();
+
+   return FhgfsOpsErr_SUCCESS;
+}
+
+/**
+ * Write to the data of an inline data file and store the updated inode. Holes are filled with
+ * zeros.
+ *
+ * @param maxSize max size of the file data, e.g. the configured inline data size limit
+ * @return FhgfsOpsErr_NOTSUPP if the file data is not inlined, FhgfsOpsErr_TOOBIG if the file
+ *    would grow beyond maxSize (so the caller has to move the data to the chunks first).
+ */
+FhgfsOpsErr FileInode::writeInlineData(EntryInfo* entryInfo, int64_t offset, const char* buf,
+   size_t count, size_t maxSize)
+{
+   UniqueRWLock lock(rwlock, SafeRWLock_WRITE);
+
+   if (!inodeDiskData.getHasInlineData())
+      return FhgfsOpsErr_NOTSUPP;
+
+   if (offset < 0)
+      return FhgfsOpsErr_INVAL;
+
+   if ( (uint64_t) offset + count > std::min<size_t>(maxSize, FILEINODE_INLINE_DATA_MAX_SIZE) )
+      return FhgfsOpsErr_TOOBIG;
+
+   std::string& data = inodeDiskData.getInlineDataRef();
+   StatData* statData = inodeDiskData.getInodeStatData();
+
+   // keep the old state to undo the write if the inode can't be stored
+   const std::string oldData = data;
+   const StatData oldStatData = *statData;
+   const int64_t now = TimeAbs().getTimeval()->tv_sec;
+
+   if (offset + count > data.size())
+      data.resize(offset + count, '\0');
+
+   data.replace(offset, count, buf, count);
+
+   statData->setFileSize(data.size());
+   statData->setModificationTimeSecs(now);
+   statData->setAttribChangeTimeSecs(now);
+
+   if (!storeUpdatedInodeUnlocked(entryInfo))
+   {
+      data = oldData;
+      *statData = oldStatData;
+      return FhgfsOpsErr_SAVEERROR;
+   }
+
+   return FhgfsOpsErr_SUCCESS;
+}
+
+/**
+ * Truncate or extend (with zeros) the data of an inline data file and store the updated inode.
+ *
+ * @return FhgfsOpsErr_NOTSUPP if the file data is not inlined, FhgfsOpsErr_TOOBIG if filesize is
+ *    larger than maxSize.
+ */
+FhgfsOpsErr FileInode::truncInlineData(EntryInfo* entryInfo, int64_t filesize, size_t maxSize)
+{
+   UniqueRWLock lock(rwlock, SafeRWLock_WRITE);
+
+   if (!inodeDiskData.getHasInlineData())
+      return FhgfsOpsErr_NOTSUPP;
+
+   if (filesize < 0)
+      return FhgfsOpsErr_INVAL;
+
+   if ( (uint64_t) filesize > std::min<size_t>(maxSize, FILEINODE_INLINE_DATA_MAX_SIZE) )
+      return FhgfsOpsErr_TOOBIG;
+
+   std::string& data = inodeDiskData.getInlineDataRef();
+   StatData* statData = inodeDiskData.getInodeStatData();
+
+   const std::string oldData = data;
+   const StatData oldStatData = *statData;
+   const int64_t now = TimeAbs().getTimeval()->tv_sec;
+
+   data.resize(filesize, '\0');
+
+   statData->setFileSize(filesize);
+   statData->setModificationTimeSecs(now);
+   statData->setAttribChangeTimeSecs(now);
+
+   if (!storeUpdatedInodeUnlocked(entryInfo))
+   {
+      data = oldData;
+      *statData = oldStatData;
+      return FhgfsOpsErr_SAVEERROR;
+   }
+
+   return FhgfsOpsErr_SUCCESS;
+}
+
+/**
+ * Turn an inline data file into a regular chunk file after its data was written to the chunks and
+ * store the updated inode.
+ *
+ * @param promotedData the data that was written to the chunks; if the inline data was modified in
+ *    the meantime, nothing is changed.
+ * @return FhgfsOpsErr_AGAIN if the inline data was modified while it was written to the chunks.
+ */
+FhgfsOpsErr FileInode::clearInlineData(EntryInfo* entryInfo, const std::string& promotedData)
+{
+   UniqueRWLock lock(rwlock, SafeRWLock_WRITE);
+
+   if (!inodeDiskData.getHasInlineData())
+      return FhgfsOpsErr_SUCCESS; // already promoted
+
+   if (inodeDiskData.getInlineData() != promotedData)
+      return FhgfsOpsErr_AGAIN;
+
+   inodeDiskData.clearInlineData();
+
+   if (!storeUpdatedInodeUnlocked(entryInfo))
+   {
+      inodeDiskData.setInlineData(promotedData);
+      return FhgfsOpsErr_SAVEERROR;
+   }
+
+   return FhgfsOpsErr_SUCCESS;
+}
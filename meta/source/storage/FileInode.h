@@ -136,6 +136,12 @@ class FileInode
 
       FhgfsOpsErr checkAccessAndOpen(unsigned openAccessFlags, bool bypassAccessCheck);
 
+      FhgfsOpsErr readInlineData(int64_t offset, int64_t count, std::string& outData);
+      FhgfsOpsErr writeInlineData(EntryInfo* entryInfo, int64_t offset, const char* buf,
+         size_t count, size_t maxSize);
+      FhgfsOpsErr truncInlineData(EntryInfo* entryInfo, int64_t filesize, size_t maxSize);
+      FhgfsOpsErr clearInlineData(EntryInfo* entryInfo, const std::string& promotedData);
+
    public:
       template<typename InodeT>
       class LockState
@@ -504,19 +510,7 @@ class FileInode
        * Note: Use this only if the file is not loaded already (because otherwise the dyn attribs
        * will be outdated)
        */
-      static FhgfsOpsErr getStatData(EntryInfo* entryInfo, StatData& outStatData)
-      {
-         FileInode* inode = createFromEntryInfo(entryInfo);
-
-         if(!inode)
-            return FhgfsOpsErr_PATHNOTEXISTS;
-
-         FhgfsOpsErr retVal = inode->getStatData(outStatData);
-
-         delete inode;
-
-         return retVal;
-      }
+      static FhgfsOpsErr getStatData(EntryInfo* entryInfo, StatData& outStatData);
 
       /**
        * Unlocked method to get statdata
@@ -953,6 +947,20 @@ class FileInode
          return inodeDiskData.getMetaVersion();
       }
 
+      bool getHasInlineData()
+      {
+         UniqueRWLock lock(rwlock, SafeRWLock_READ);
+
+         return inodeDiskData.getHasInlineData();
+      }
+
+      std::string getInlineData()
+      {
+         UniqueRWLock lock(rwlock, SafeRWLock_READ);
+
+         return inodeDiskData.getInlineData();
+      }
+
 
 
    protected:
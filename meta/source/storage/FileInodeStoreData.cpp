@@ -41,5 +41,6 @@ bool FileInodeStoreData::operator==(const FileInodeStoreData& second) const
       && stripePattern->stripePatternEquals(second.stripePattern)
       && origFeature == second.origFeature
       && origParentUID == second.origParentUID
-      && origParentEntryID == second.origParentEntryID;
+      && origParentEntryID == second.origParentEntryID
+      && inlineData == second.inlineData;
 }
@@ -22,6 +22,11 @@
 #define FILEINODE_FEATURE_HAS_VERSIONS      128 // file has a cto version counter
 #define FILEINODE_FEATURE_HAS_RST           256 // file has remote targets
 #define FILEINODE_FEATURE_HAS_STATE_FLAGS   512 // file has state flags (access state + data state)
+#define FILEINODE_FEATURE_HAS_INLINE_DATA  1024 // file data is stored in the inode, not in chunks
+
+/* upper limit for inline file data, so that the inode still fits into DIRENTRY_SERBUF_SIZE with a
+   large stripe pattern */
+#define FILEINODE_INLINE_DATA_MAX_SIZE     2048
 
 enum FileInodeOrigFeature
 {
@@ -182,6 +187,8 @@ class FileInodeStoreData
       // raw byte value representing access flags + data state
       uint8_t rawFileState;
 
+      std::string inlineData; // file contents if FILEINODE_FEATURE_HAS_INLINE_DATA is set
+
       void getPathInfo(PathInfo* outPathInfo);
 
 
@@ -236,6 +243,7 @@ class FileInodeStoreData
          this->fileVersion       = diskData->fileVersion;
          setMetaVersion(diskData->metaVersion);
          this->rawFileState     = diskData->rawFileState;
+         this->inlineData        = diskData->inlineData;
       }
 
       void setInodeFeatureFlags(unsigned flags)
@@ -288,6 +296,40 @@ class FileInodeStoreData
             addInodeFeatureFlag(FILEINODE_FEATURE_HAS_STATE_FLAGS);
       }
 
+      /**
+       * Turn this into an inline data file (or update its data), the file size is not updated.
+       */
+      void setInlineData(const std::string& data)
+      {
+         this->inlineData = data;
+         addInodeFeatureFlag(FILEINODE_FEATURE_HAS_INLINE_DATA);
+      }
+
+      /**
+       * Turn this into a regular chunk file (e.g. after the data was written to the chunks).
+       */
+      void clearInlineData()
+      {
+         this->inlineData.clear();
+         this->inlineData.shrink_to_fit();
+         removeInodeFeatureFlag(FILEINODE_FEATURE_HAS_INLINE_DATA);
+      }
+
+      bool getHasInlineData() const
+      {
+         return (getInodeFeatureFlags() & FILEINODE_FEATURE_HAS_INLINE_DATA);
+      }
+
+      const std::string& getInlineData() const
+      {
+         return this->inlineData;
+      }
+
+      std::string& getInlineDataRef()
+      {
+         return this->inlineData;
+      }
+
       uint8_t getFileState() const
       {
          // If FILEINODE_FEATURE_HAS_STATE_FLAGS is not set,
@@ -6,8 +6,8 @@
 #include "InodeDirStore.h"
 
 
-#define DIRSTORE_REFCACHE_REMOVE_SKIP_SYNC     (4) /* n-th elements to be removed on sync sweep */
-#define DIRSTORE_REFCACHE_REMOVE_SKIP_ASYNC    (3) /* n-th elements to be removed on async sweep */
+#define DIRSTORE_REFCACHE_REMOVE_SKIP_SYNC     (4) /* 1/n of elements removed on sync sweep */
+#define DIRSTORE_REFCACHE_REMOVE_SKIP_ASYNC    (3) /* 1/n of elements removed on async sweep */
 
 /**
   * not inlined as we need to include <program/Program.h>
@@ -18,6 +18,8 @@ InodeDirStore::InodeDirStore()
 
    this->refCacheSyncLimit = cfg->getTuneDirMetadataCacheLimit();
    this->refCacheAsyncLimit = refCacheSyncLimit - (refCacheSyncLimit/2);
+
+   this->numDirEntryLockShards = cfg->getTuneDirEntryLockShards();
 }
 
 bool InodeDirStore::dirInodeInStoreUnlocked(const std::string& dirID)
@@ -71,6 +73,8 @@ DirInode* InodeDirStore::referenceDirInode(const std::string& dirID, bool isBudd
          dir = dirRefer->reference();
          LOG_DBG(GENERAL, SPAM,  "referenceDirInode", dir->getID(), dirRefer->getRefCount());
 
+         refCachePolicy.touch(dirID); // (safe under read lock)
+
          if (!wasReferenced)
             cacheAddUnlocked(dirID, dirRefer);
       }
@@ -348,7 +352,8 @@ void InodeDirStore::invalidateMirroredDirInodes()
 DirectoryMapIter InodeDirStore::insertDirInodeUnlocked(const std::string& dirID,
    bool isBuddyMirrored, bool forceLoad)
 {
-   std::unique_ptr<DirInode> inode(new (std::nothrow) DirInode(dirID, isBuddyMirrored));
+   std::unique_ptr<DirInode> inode(new (std::nothrow) DirInode(dirID, isBuddyMirrored,
+      numDirEntryLockShards) );
    if (unlikely (!inode) )
       return dirs.end(); // out of memory
 
@@ -401,6 +406,7 @@ void InodeDirStore::cacheAddUnlocked(const std::string& dirID, DirectoryReferenc
    if(refCache.insert(DirCacheMapVal(dirID, dirRefer->getReferencedObject()) ).second)
    { // new insert => inc refcount
       dirRefer->reference();
+      refCachePolicy.insert(dirID);
 
       LOG_DBG(GENERAL, SPAM, "InodeDirStore cache add DirInode.", dirID, dirRefer->getRefCount());
    }
@@ -413,6 +419,7 @@ void InodeDirStore::cacheRemoveUnlocked(const std::string& dirID)
       return;
 
    releaseDirUnlocked(dirID);
+   refCachePolicy.remove(dirID);
    refCache.erase(iter);
 }
 
@@ -423,6 +430,8 @@ void InodeDirStore::cacheRemoveAllUnlocked()
       releaseDirUnlocked(iter->first);
       refCache.erase(iter++);
    }
+
+   refCachePolicy.clear();
 }
 
 /**
@@ -433,8 +442,7 @@ void InodeDirStore::cacheRemoveAllUnlocked()
  */
 bool InodeDirStore::cacheSweepUnlocked(bool isSyncSweep)
 {
-   // sweeping means we remove every n-th element from the cache, starting with a random element
-   // in the range 0 to n
+   // sweeping means we remove 1/n of the elements from the cache, selected by the cache policy
    size_t cacheLimit;
    size_t removeSkipNum;
 
@@ -455,25 +463,13 @@ bool InodeDirStore::cacheSweepUnlocked(bool isSyncSweep)
       return false;
 
 
-   // pick a random start element (note: the element will be removed in first loop pass below)
-
-   unsigned randStart = randGen.getNextInRange(0, removeSkipNum - 1);
-   DirCacheMapIter iter = refCache.begin();
+   DirCacheMapSizeT numRemove = refCache.size() / removeSkipNum;
+   std::string dirID;
 
-   while(randStart--)
-      iter++;
-
-   // walk over all cached elements and remove every n-th element
-   DirCacheMapSizeT i = 0; // counts elements
-   while (iter != refCache.end() )
+   while (numRemove-- && refCachePolicy.evict(dirID) )
    {
-      if ( (++i % removeSkipNum) == 0)
-      {
-         releaseDirUnlocked(iter->first);
-         refCache.erase(iter++);
-      }
-      else
-         iter++;
+      releaseDirUnlocked(dirID);
+      refCache.erase(dirID);
    }
 
    return true;
@@ -496,3 +492,12 @@ size_t InodeDirStore::getCacheSize()
    RWLockGuard lock(rwlock, SafeRWLock_READ);
    return refCache.size();
 }
+
+/**
+ * @return hit/miss/eviction counters of the cache policy
+ */
+CachePolicyStats InodeDirStore::getCacheStats()
+{
+   RWLockGuard lock(rwlock, SafeRWLock_READ);
+   return refCachePolicy.getStats();
+}
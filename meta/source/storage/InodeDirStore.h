@@ -4,7 +4,7 @@
 #include <common/threading/Mutex.h>
 #include <common/toolkit/AtomicObjectReferencer.h>
 #include <common/toolkit/MetadataTk.h>
-#include <common/toolkit/Random.h>
+#include <common/toolkit/ClockProCachePolicy.h>
 #include <common/storage/StatData.h>
 #include <common/storage/StorageDefinitions.h>
 #include <common/storage/StorageErrors.h>
@@ -54,6 +54,7 @@ class InodeDirStore
 
       size_t getSize();
       size_t getCacheSize();
+      CachePolicyStats getCacheStats();
 
       FhgfsOpsErr stat(const std::string& dirID, bool isBuddyMirrored, StatData& outStatData,
          NumNodeID* outParentNodeID, std::string* outParentEntryID);
@@ -70,9 +71,11 @@ class InodeDirStore
 
       size_t refCacheSyncLimit; // synchronous access limit (=> async limit plus some grace size)
       size_t refCacheAsyncLimit; // asynchronous cleanup limit (this is what the user configures)
-      Random randGen; // for random cache removal
+      ClockProCachePolicy<std::string> refCachePolicy; // selects entries to remove on sweep
       DirCacheMap refCache;
 
+      unsigned numDirEntryLockShards; // for the DirEntryStores of the dirs in this store
+
       RWLock rwlock;
 
       void releaseDirUnlocked(const std::string& dirID);
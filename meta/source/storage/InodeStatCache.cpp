@@ -0,0 +1,149 @@
+#include <program/Program.h>
+#include "InodeStatCache.h"
+
+
+InodeStatCache::InodeStatCache(size_t maxEntries) :
+   maxEntriesPerShard(maxEntries ?
+      std::max<size_t>(maxEntries / INODESTATCACHE_NUM_SHARDS, 1) : 0),
+   numHits(0), numMisses(0), numInvalidations(0)
+{
+   for (size_t i = 0; i < INODESTATCACHE_NUM_SHARDS; i++)
+      shards[i].generation = 0;
+}
+
+/**
+ * @param outGeneration generation to pass to put() after a miss.
+ * @return true on cache hit.
+ */
+bool InodeStatCache::get(EntryInfo* entryInfo, StatData& outStatData, uint64_t& outGeneration)
+{
+   Shard& shard = getShard(entryInfo->getEntryID() );
+
+   std::lock_guard<std::mutex> lock(shard.mutex);
+
+   auto iter = shard.entries.find(entryInfo->getEntryID() );
+
+   if (iter == shard.entries.end() ||
+         iter->second.parentEntryID != entryInfo->getParentEntryID() ||
+         iter->second.isBuddyMirrored != entryInfo->getIsBuddyMirrored() )
+   {
+      outGeneration = shard.generation;
+      numMisses.fetch_add(1, std::memory_order_relaxed);
+      return false;
+   }
+
+   shard.lru.splice(shard.lru.begin(), shard.lru, iter->second.lruIter);
+
+   outStatData = iter->second.statData;
+
+   numHits.fetch_add(1, std::memory_order_relaxed);
+   return true;
+}
+
+/**
+ * Add stat data that was read from disk.
+ *
+ * @param generation as returned by get() before the data was read from disk.
+ */
+void InodeStatCache::put(EntryInfo* entryInfo, const StatData& statData, uint64_t generation)
+{
+   const std::string& entryID = entryInfo->getEntryID();
+   Shard& shard = getShard(entryID);
+
+   std::lock_guard<std::mutex> lock(shard.mutex);
+
+   if (shard.generation != generation)
+      return; // something was invalidated while the data was read, might be outdated
+
+   auto iter = shard.entries.find(entryID);
+   if (iter != shard.entries.end() )
+   { // (e.g. stale parentEntryID of another requestor)
+      shard.lru.erase(iter->second.lruIter);
+      shard.entries.erase(iter);
+   }
+
+   if (shard.entries.size() >= maxEntriesPerShard)
+   {
+      shard.entries.erase(shard.lru.back() );
+      shard.lru.pop_back();
+   }
+
+   shard.lru.push_front(entryID);
+
+   CacheEntry& entry = shard.entries[entryID];
+
+   entry.parentEntryID = entryInfo->getParentEntryID();
+   entry.isBuddyMirrored = entryInfo->getIsBuddyMirrored();
+   entry.statData = statData;
+   entry.lruIter = shard.lru.begin();
+}
+
+void InodeStatCache::invalidate(const std::string& entryID)
+{
+   Shard& shard = getShard(entryID);
+
+   std::lock_guard<std::mutex> lock(shard.mutex);
+
+   shard.generation++;
+
+   auto iter = shard.entries.find(entryID);
+   if (iter == shard.entries.end() )
+      return;
+
+   shard.lru.erase(iter->second.lruIter);
+   shard.entries.erase(iter);
+
+   numInvalidations.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Drop all entries, e.g. when metadata files are written by resync.
+ */
+void InodeStatCache::invalidateAll()
+{
+   for (size_t i = 0; i < INODESTATCACHE_NUM_SHARDS; i++)
+   {
+      Shard& shard = shards[i];
+
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      shard.generation++;
+      shard.entries.clear();
+      shard.lru.clear();
+   }
+}
+
+InodeStatCacheStats InodeStatCache::getStats()
+{
+   InodeStatCacheStats stats;
+
+   stats.numHits = numHits.load(std::memory_order_relaxed);
+   stats.numMisses = numMisses.load(std::memory_order_relaxed);
+   stats.numInvalidations = numInvalidations.load(std::memory_order_relaxed);
+   stats.numEntries = 0;
+
+   for (size_t i = 0; i < INODESTATCACHE_NUM_SHARDS; i++)
+   {
+      std::lock_guard<std::mutex> lock(shards[i].mutex);
+      stats.numEntries += shards[i].entries.size();
+   }
+
+   return stats;
+}
+
+/**
+ * Invalidate entryID in the stat cache of the MetaStore (if it exists already). To be called
+ * whenever the on-disk inode data or the dentry of a file changes.
+ */
+void InodeStatCache::invalidateEntry(const std::string& entryID)
+{
+   App* app = Program::getApp();
+
+   if (!app || !app->getMetaStore() )
+      return;
+
+   InodeStatCache* statCache = app->getMetaStore()->getInodeStatCache();
+
+   if (statCache->isEnabled() )
+      statCache->invalidate(entryID);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <common/storage/EntryInfo.h>
+#include <common/storage/StatData.h>
+#include <common/Common.h>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+
+#define INODESTATCACHE_NUM_SHARDS   16
+
+
+struct InodeStatCacheStats
+{
+   uint64_t numHits;
+   uint64_t numMisses;
+   uint64_t numInvalidations;
+   size_t numEntries;
+};
+
+/**
+ * Cache of the stat data of file inodes that are not loaded (i.e. not open), so that repeated
+ * stats of the same files don't need to read and deserialize the inode from disk every time.
+ *
+ * The cache must always match the on-disk state: every code path that writes or removes the
+ * on-disk data of a file inode (or its dentry) invalidates the entry (see invalidateEntry() ).
+ * To avoid that a stat that read the inode from disk before a concurrent update inserts outdated
+ * data after the update invalidated the entry, get() returns the generation of the entry's
+ * shard, which is incremented by every invalidation, and put() drops the data if the generation
+ * changed in the meantime.
+ *
+ * Each shard is a bounded LRU list.
+ */
+class InodeStatCache
+{
+   public:
+      /**
+       * @param maxEntries 0 disables the cache.
+       */
+      explicit InodeStatCache(size_t maxEntries);
+
+      InodeStatCache(const InodeStatCache&) = delete;
+      InodeStatCache& operator=(const InodeStatCache&) = delete;
+
+      bool get(EntryInfo* entryInfo, StatData& outStatData, uint64_t& outGeneration);
+      void put(EntryInfo* entryInfo, const StatData& statData, uint64_t generation);
+      void invalidate(const std::string& entryID);
+      void invalidateAll();
+
+      InodeStatCacheStats getStats();
+
+      static void invalidateEntry(const std::string& entryID);
+
+
+   private:
+      struct CacheEntry
+      {
+         std::string parentEntryID; // inlined inodes are stored in the parent's dentries
+         bool isBuddyMirrored;
+         StatData statData;
+         std::list<std::string>::iterator lruIter;
+      };
+
+      struct Shard
+      {
+         std::mutex mutex;
+         std::unordered_map<std::string, CacheEntry> entries;
+         std::list<std::string> lru; // most recently used first
+         uint64_t generation;
+      };
+
+      const size_t maxEntriesPerShard;
+
+      Shard shards[INODESTATCACHE_NUM_SHARDS];
+
+      std::atomic<uint64_t> numHits;
+      std::atomic<uint64_t> numMisses;
+      std::atomic<uint64_t> numInvalidations;
+
+      Shard& getShard(const std::string& entryID)
+      {
+         return shards[std::hash<std::string>()(entryID) % INODESTATCACHE_NUM_SHARDS];
+      }
+
+   public:
+      // getters & setters
+      bool isEnabled() const
+      {
+         return maxEntriesPerShard != 0;
+      }
+};
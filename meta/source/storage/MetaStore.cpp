@@ -17,6 +17,11 @@
 
 #define MAX_DEBUG_LOCK_TRY_TIME 30 // max lock wait time in seconds
 
+MetaStore::MetaStore() :
+   statCache(Program::getApp()->getConfig()->getTuneInodeStatCacheSize() )
+{
+}
+
 /**
  * Reference the given directory.
  *
@@ -33,7 +38,7 @@
 DirInode* MetaStore::referenceDir(const std::string& dirID, const bool isBuddyMirrored,
    const bool forceLoad)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
    return referenceDirUnlocked(dirID, isBuddyMirrored, forceLoad);
 }
 
@@ -45,7 +50,7 @@ DirInode* MetaStore::referenceDirUnlocked(const std::string& dirID, bool isBuddy
 
 void MetaStore::releaseDir(const std::string& dirID)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
    releaseDirUnlocked(dirID);
 }
 
@@ -60,7 +65,7 @@ void MetaStore::releaseDirUnlocked(const std::string& dirID)
  */
 MetaFileHandleRes MetaStore::referenceFile(EntryInfo* entryInfo, bool checkLockStore)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
 
    auto [inode, referenceRes] = referenceFileUnlocked(entryInfo, checkLockStore);
    if (unlikely(!inode))
@@ -176,7 +181,7 @@ MetaFileHandleRes MetaStore::referenceFileUnlocked(DirInode& subDir, EntryInfo*
 MetaFileHandle MetaStore::referenceLoadedFile(const std::string& parentEntryID,
    bool parentIsBuddyMirrored, const std::string& entryID)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
    return referenceLoadedFileUnlocked(parentEntryID, parentIsBuddyMirrored, entryID);
 }
 
@@ -244,7 +249,7 @@ MetaFileHandle MetaStore::referenceLoadedFileUnlocked(DirInode& subDir, const st
  */
 MetaFileHandleRes MetaStore::tryReferenceFileWriteLocked(EntryInfo* entryInfo, bool checkLockStore)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_WRITE);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_WRITE);
 
    if (!this->fileStore.isInStore(entryInfo->getEntryID()))
    {
@@ -273,7 +278,7 @@ MetaFileHandleRes MetaStore::tryReferenceFileWriteLocked(EntryInfo* entryInfo, b
 FhgfsOpsErr MetaStore::tryOpenFileWriteLocked(EntryInfo* entryInfo, unsigned accessFlags,
    bool bypassAccessCheck, MetaFileHandle& outInode)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_WRITE);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_WRITE);
 
    if (!this->fileStore.isInStore(entryInfo->getEntryID()))
    {
@@ -290,7 +295,7 @@ FhgfsOpsErr MetaStore::tryOpenFileWriteLocked(EntryInfo* entryInfo, unsigned acc
 
 bool MetaStore::releaseFile(const std::string& parentEntryID, MetaFileHandle& inode)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
    return releaseFileUnlocked(parentEntryID, inode);
 }
 
@@ -475,7 +480,7 @@ bool MetaStore::moveReferenceToMetaFileStoreUnlocked(const std::string& parentEn
 FhgfsOpsErr MetaStore::openFile(EntryInfo* entryInfo, unsigned accessFlags, bool bypassAccessCheck,
    MetaFileHandle& outInode, bool checkDisposalFirst)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
 
    // session restore must load disposed files with disposal as parent entry id - if the file is
    // disposed any other parent id will also work, but will make that parent id unremovable for
@@ -589,7 +594,7 @@ void MetaStore::closeFile(EntryInfo* entryInfo, MetaFileHandle inode, unsigned a
    unsigned* outNumHardlinks, unsigned* outNumRefs, bool& outLastWriterClosed)
 {
    const char* logContext = "Close file";
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
 
    // now release (and possible free (delete) the inode if not further referenced)
 
@@ -641,7 +646,7 @@ FhgfsOpsErr MetaStore::stat(EntryInfo* entryInfo, bool loadFromDisk, StatData& o
 {
    FhgfsOpsErr statRes = FhgfsOpsErr_PATHNOTEXISTS;
 
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
 
    if (entryInfo->getEntryType() == DirEntryType_DIRECTORY)
    { // entry is a dir
@@ -683,7 +688,7 @@ FhgfsOpsErr MetaStore::stat(EntryInfo* entryInfo, bool loadFromDisk, StatData& o
 
 FhgfsOpsErr MetaStore::setAttr(EntryInfo* entryInfo, int validAttribs, SettableFileAttribs* attribs)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
    return setAttrUnlocked(entryInfo, validAttribs, attribs);
 }
 
@@ -722,7 +727,7 @@ FhgfsOpsErr MetaStore::setAttrUnlocked(EntryInfo* entryInfo, int validAttribs,
 
 FhgfsOpsErr MetaStore::incDecLinkCount(EntryInfo* entryInfo, int value)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_WRITE);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_WRITE);
    return incDecLinkCountUnlocked(entryInfo, value);
 }
 
@@ -846,7 +851,7 @@ FhgfsOpsErr MetaStore::mkNewMetaFile(DirInode& dir, MkFileDetails* mkDetails,
    std::unique_ptr<StripePattern> stripePattern, RemoteStorageTarget* rstInfo,
    EntryInfo* outEntryInfo, FileInodeStoreData* outInodeData)
 {
-   UniqueRWLock metaLock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock metaLock(rwlock, SafeRWLock_READ);
    UniqueRWLock dirLock(dir.rwlock, SafeRWLock_WRITE);
 
    const char* logContext = "Make New Meta File";
@@ -940,6 +945,15 @@ FhgfsOpsErr MetaStore::mkNewMetaFile(DirInode& dir, MkFileDetails* mkDetails,
    else
       fileInodeFlags = 0;
 
+   /* small regular files keep their data in the inode until they grow (see MsgHelperInlineData).
+      only done for clients that can access the inline data, otherwise the file would be promoted
+      by the first open anyways. */
+   if (mkDetails->inlineDataSupported && !dir.getIsBuddyMirrored() && S_ISREG(mkDetails->mode) &&
+       (stripePattern->getPatternType() == StripePatternType_Raid0) &&
+       (!rstInfo || rstInfo->hasInvalidVersion() ) &&
+       Program::getApp()->getConfig()->getTuneInlineFileDataMaxSize() )
+      fileInodeFlags |= FILEINODE_FEATURE_HAS_INLINE_DATA;
+
    // (note: inodeMetaData constructor clones stripePattern)
    FileInodeStoreData inodeMetaData(newEntryID, &statData, stripePattern.get(), fileInodeFlags,
       origParentUID, parentEntryID, FileInodeOrigFeature_TRUE);
@@ -1034,7 +1048,7 @@ FhgfsOpsErr MetaStore::makeDirInode(DirInode& inode, const CharVector& defaultAC
 
 FhgfsOpsErr MetaStore::removeDirInode(const std::string& entryID, bool isBuddyMirrored)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
    return dirStore.removeDirInode(entryID, isBuddyMirrored);
 }
 
@@ -1045,7 +1059,7 @@ FhgfsOpsErr MetaStore::removeDirInode(const std::string& entryID, bool isBuddyMi
  */
 FhgfsOpsErr MetaStore::fsckUnlinkFileInode(const std::string& entryID, bool isBuddyMirrored)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
 
    // generic code needs an entryInfo, but most values can be empty for non-inlined inodes
    NumNodeID ownerNodeID;
@@ -1101,7 +1115,7 @@ FhgfsOpsErr MetaStore::unlinkInodeUnlocked(EntryInfo* entryInfo, DirInode* subDi
  */
 FhgfsOpsErr MetaStore::unlinkInode(EntryInfo* entryInfo, std::unique_ptr<FileInode>* outInode)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
    return unlinkInodeUnlocked(entryInfo, NULL, outInode);
 }
 
@@ -1174,7 +1188,7 @@ FhgfsOpsErr MetaStore::unlinkFile(DirInode& dir, const std::string& fileName,
    const char* logContext = "Unlink File";
    FhgfsOpsErr retVal = FhgfsOpsErr_PATHNOTEXISTS;
 
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
    UniqueRWLock subDirLock(dir.rwlock, SafeRWLock_WRITE);
 
    bool wasInlined;
@@ -1223,7 +1237,7 @@ FhgfsOpsErr MetaStore::unlinkFileInode(EntryInfo* delFileInfo, std::unique_ptr<F
    unsigned& outNumHardlinks)
 {
    const char* logContext = "Unlink File Inode";
-   UniqueRWLock lock(rwlock, SafeRWLock_WRITE);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_WRITE);
 
    FhgfsOpsErr retVal;
    FhgfsOpsErr isUnlinkable = this->fileStore.isUnlinkable(delFileInfo);
@@ -1548,7 +1562,7 @@ FhgfsOpsErr MetaStore::unlinkDentryAndInodeUnlocked(const std::string& fileName,
  */
 FhgfsOpsErr MetaStore::unlinkInodeLater(EntryInfo* entryInfo, bool wasInlined)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_WRITE);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_WRITE);
    return unlinkInodeLaterUnlocked(entryInfo, wasInlined);
 }
 
@@ -1662,11 +1676,6 @@ FhgfsOpsErr MetaStore::getAllInodesIncremental(unsigned hashDirNum, int64_t last
           || bgm->getLocalGroupID() == 0))
       return FhgfsOpsErr_SUCCESS;
 
-   NumNodeID rootNodeNumID = app->getMetaRoot().getID();
-   NumNodeID localNodeNumID = isBuddyMirrored
-      ? NumNodeID(app->getMetaBuddyGroupMapper()->getLocalGroupID())
-      : app->getLocalNode().getNumID();
-
    StringList entryIDs;
    unsigned firstLevelHashDir;
    unsigned secondLevelHashDir;
@@ -1684,9 +1693,34 @@ FhgfsOpsErr MetaStore::getAllInodesIncremental(unsigned hashDirNum, int64_t last
       return readRes;
    }
 
+   getFsckInodes(entryIDs.begin(), entryIDs.end(), isBuddyMirrored, outDirInodes, outFileInodes);
+
+   return FhgfsOpsErr_SUCCESS;
+}
+
+/**
+ * Load the given inodes and convert them for fsck.
+ *
+ * Note: This is intended for use by Fsck.
+ *
+ * @param begin/end range of raw entryID filenames from an "inodes" hash dir (see
+ *    getAllEntryIDFilesIncremental() ).
+ * @param outDirInodes also receives dummy dir inodes for entries that could not be loaded.
+ */
+void MetaStore::getFsckInodes(StringListConstIter begin, StringListConstIter end,
+   bool isBuddyMirrored, FsckDirInodeList* outDirInodes, FsckFileInodeList* outFileInodes)
+{
+   const char* logContext = "MetaStore (get fsck inodes)";
+
+   App* app = Program::getApp();
+
+   NumNodeID rootNodeNumID = app->getMetaRoot().getID();
+   NumNodeID localNodeNumID = isBuddyMirrored
+      ? NumNodeID(app->getMetaBuddyGroupMapper()->getLocalGroupID())
+      : app->getLocalNode().getNumID();
+
    // the actual entry processing
-   for ( StringListIter entryIDIter = entryIDs.begin(); entryIDIter != entryIDs.end();
-      entryIDIter++ )
+   for (StringListConstIter entryIDIter = begin; entryIDIter != end; entryIDIter++)
    {
       const std::string& entryID = *entryIDIter;
 
@@ -1783,6 +1817,8 @@ FhgfsOpsErr MetaStore::getAllInodesIncremental(unsigned hashDirNum, int64_t last
                localNodeNumID, 0, 0, false, isBuddyMirrored, true,
                fileInode->getIsBuddyMirrored() != isBuddyMirrored);
 
+         fsckFileInode.setHasInlineData(fileInode->getHasInlineData() );
+
          outFileInodes->push_back(fsckFileInode);
 
          // parentID is absolutely irrelevant here, because we know that this inode is not inlined
@@ -1800,8 +1836,234 @@ FhgfsOpsErr MetaStore::getAllInodesIncremental(unsigned hashDirNum, int64_t last
       }
 
    } // end of for loop
+}
 
-   return FhgfsOpsErr_SUCCESS;
+/**
+ * List the names of the dir entries in a content dir.
+ *
+ * Note: This is intended for use by Fsck.
+ *
+ * Note: Offset is an internal value and should not be assumed to be just 0, 1, 2, 3, ...;
+ * so make sure you use either 0 (at the beginning) or something that has been returned by this
+ * method as outNewOffset.
+ *
+ * @param contDirID ID of the directory; if the dir inode doesn't exist, the content dir is still
+ *    listed (using a temporary dir inode), so that fsck can fix the dentries.
+ * @param outNewOffset is only valid if return value indicates success.
+ */
+FhgfsOpsErr MetaStore::getFsckDirEntryNames(const std::string& contDirID, bool isBuddyMirrored,
+   int64_t lastOffset, unsigned maxOutNames, StringList* outNames, int64_t* outNewOffset)
+{
+   bool isTempDir;
+   DirInode* dirInode = referenceFsckContDir(contDirID, isBuddyMirrored, &isTempDir);
+
+   if (unlikely(isTempDir) )
+      LOG(GENERAL, NOTICE, "Could not reference directory, using temporary directory inode.",
+            ("entryID", contDirID));
+
+   FhgfsOpsErr listRes = dirInode->listIncremental(lastOffset, maxOutNames, outNames,
+      outNewOffset);
+
+   releaseFsckContDir(dirInode, isTempDir);
+
+   return listRes;
+}
+
+/**
+ * Load the given dir entries of a content dir (and the inodes that are inlined into them) and
+ * convert them for fsck.
+ *
+ * Note: This is intended for use by Fsck.
+ *
+ * @param begin/end range of entry names in the content dir (see getFsckDirEntryNames() ).
+ * @param msgUserID for the stat of inlined inodes with outdated dynamic attribs.
+ */
+void MetaStore::getFsckDirEntries(const std::string& contDirID, StringListConstIter begin,
+   StringListConstIter end, bool isBuddyMirrored, unsigned msgUserID,
+   FsckDirEntryList* outDirEntries, FsckFileInodeList* outInlinedFileInodes)
+{
+   const char* logContext = "MetaStore (get fsck dir entries)";
+
+   App* app = Program::getApp();
+
+   NumNodeID localNodeNumID = isBuddyMirrored
+      ? NumNodeID(app->getMetaBuddyGroupMapper()->getLocalGroupID())
+      : app->getLocalNode().getNumID();
+
+   const std::string contDirPath = MetaStorageTk::getMetaDirEntryPath(
+      isBuddyMirrored
+         ? app->getBuddyMirrorDentriesPath()->str()
+         : app->getDentriesPath()->str(), contDirID);
+
+   bool isTempDir;
+   DirInode* parentDirInode = referenceFsckContDir(contDirID, isBuddyMirrored, &isTempDir);
+
+   for (StringListConstIter namesIter = begin; namesIter != end; namesIter++)
+   {
+      std::string filename = contDirPath + "/" + *namesIter;
+
+      // create a EntryInfo and put the information into an FsckDirEntry object
+      EntryInfo entryInfo;
+      FileInodeStoreData inodeDiskData;
+      bool hasInlinedInode = false;
+
+      int32_t saveDevice = 0;
+      uint64_t saveInode = 0;
+
+      auto [getEntryRes, isFileOpen] = getEntryData(parentDirInode, *namesIter, &entryInfo,
+         &inodeDiskData);
+
+      if (getEntryRes == FhgfsOpsErr_SUCCESS ||
+          getEntryRes == FhgfsOpsErr_DYNAMICATTRIBSOUTDATED  )
+      {
+         DirEntryType entryType = entryInfo.getEntryType();
+
+         const std::string& dentryID = entryInfo.getEntryID();
+         const std::string& dentryName = *namesIter;
+         NumNodeID dentryOwnerID = entryInfo.getOwnerNodeID();
+         FsckDirEntryType fsckEntryType = FsckTk::DirEntryTypeToFsckDirEntryType(entryType);
+
+         // stat the file to get device and inode information
+         struct stat statBuf;
+
+         int statRes = ::stat(filename.c_str(), &statBuf);
+
+         if (likely(!statRes))
+         {
+            saveDevice = statBuf.st_dev;
+            saveInode = statBuf.st_ino;
+         }
+         else
+         {
+            LogContext(logContext).log(Log_CRITICAL, "Could not stat dir entry file; entryID: " +
+               dentryID + ";filename: " + filename);
+         }
+
+         if ( (DirEntryType_ISFILE(entryType)) && (entryInfo.getIsInlined() ) )
+         {
+            hasInlinedInode = true;
+         }
+
+         FsckDirEntry fsckDirEntry(dentryID, dentryName, contDirID, localNodeNumID,
+            dentryOwnerID, fsckEntryType, hasInlinedInode, localNodeNumID,
+            saveDevice, saveInode, entryInfo.getIsBuddyMirrored());
+
+         outDirEntries->push_back(fsckDirEntry);
+      }
+      else
+      {
+         LogContext(logContext).log(Log_WARNING, "Unable to create dir entry from entry with "
+            "name " + *namesIter + " in directory with ID " + contDirID);
+      }
+
+      // now, if the inode data is inlined we create an fsck inode object here
+      if ( hasInlinedInode )
+      {
+         std::string inodeID = inodeDiskData.getEntryID();
+
+         int pathInfoFlag;
+         if (inodeDiskData.getOrigFeature() == FileInodeOrigFeature_TRUE)
+            pathInfoFlag = PATHINFO_FEATURE_ORIG;
+         else
+            pathInfoFlag = PATHINFO_FEATURE_ORIG_UNKNOWN;
+
+         unsigned origUID = inodeDiskData.getOrigUID();
+         std::string origParentEntryID = inodeDiskData.getOrigParentEntryID();
+         PathInfo pathInfo(origUID, origParentEntryID, pathInfoFlag);
+
+         unsigned userID;
+         unsigned groupID;
+
+         int64_t fileSize;
+         unsigned numHardLinks;
+         uint64_t numBlocks;
+
+         StatData* statData;
+         StatData updatedStatData;
+
+         if (getEntryRes == FhgfsOpsErr_SUCCESS)
+            statData = inodeDiskData.getInodeStatData();
+         else
+         {
+            FhgfsOpsErr statRes = MsgHelperStat::stat(&entryInfo, true, msgUserID,
+               updatedStatData);
+
+            if (statRes == FhgfsOpsErr_SUCCESS)
+               statData = &updatedStatData;
+            else
+               statData = NULL;
+         }
+
+         if ( statData )
+         {
+            userID = statData->getUserID();
+            groupID = statData->getGroupID();
+            fileSize = statData->getFileSize();
+            numHardLinks = statData->getNumHardlinks();
+            numBlocks = statData->getNumBlocks();
+         }
+         else
+         {
+            LogContext(logContext).logErr(std::string("Unable to get stat data of inlined file "
+               "inode: ") + inodeID + ". SysErr: " + System::getErrString());
+            userID = 0;
+            groupID = 0;
+            fileSize = 0;
+            numHardLinks = 0;
+            numBlocks = 0;
+         }
+
+         UInt16Vector stripeTargets;
+         unsigned chunkSize;
+         FsckStripePatternType stripePatternType = FsckTk::stripePatternToFsckStripePattern(
+            inodeDiskData.getPattern(), &chunkSize, &stripeTargets);
+
+         FsckFileInode fileInode(inodeID, contDirID, localNodeNumID, pathInfo, userID, groupID,
+               fileSize, numHardLinks, numBlocks, stripeTargets, stripePatternType, chunkSize,
+               localNodeNumID, saveInode, saveDevice, true, entryInfo.getIsBuddyMirrored(),
+               true, inodeDiskData.getIsBuddyMirrored() != isBuddyMirrored);
+
+         fileInode.setHasInlineData(inodeDiskData.getHasInlineData() );
+
+         outInlinedFileInodes->push_back(fileInode);
+      }
+   }
+
+   releaseFsckContDir(parentDirInode, isTempDir);
+}
+
+/**
+ * Reference the dir inode of a content dir for fsck. If the dir inode doesn't exist, a temporary
+ * dir inode is created, so that fsck can still get (and later modify) the dentries; hopefully,
+ * the inode itself will get fixed later.
+ *
+ * @param outIsTemp true if the returned inode is temporary.
+ * @return must be released with releaseFsckContDir().
+ */
+DirInode* MetaStore::referenceFsckContDir(const std::string& contDirID, bool isBuddyMirrored,
+   bool* outIsTemp)
+{
+   DirInode* dirInode = referenceDir(contDirID, isBuddyMirrored, true);
+
+   *outIsTemp = !dirInode;
+
+   if (likely(dirInode) )
+      return dirInode;
+
+   int mode = S_IFDIR | S_IRWXU;
+   UInt16Vector stripeTargets;
+   Raid0Pattern stripePattern(0, stripeTargets, 0);
+
+   return new DirInode(contDirID, mode, 0, 0, Program::getApp()->getLocalNode().getNumID(),
+      stripePattern, isBuddyMirrored);
+}
+
+void MetaStore::releaseFsckContDir(DirInode* dirInode, bool isTemp)
+{
+   if (isTemp)
+      delete dirInode;
+   else
+      releaseDir(dirInode->getID() );
 }
 
 
@@ -1840,7 +2102,7 @@ FhgfsOpsErr MetaStore::getAllEntryIDFilesIncremental(unsigned firstLevelhashDirN
       inodesPath, firstLevelhashDirNum, secondLevelhashDirNum);
 
 
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
 
    DIR* dirHandle = opendir(path.c_str() );
    if(!dirHandle)
@@ -1884,16 +2146,17 @@ FhgfsOpsErr MetaStore::getAllEntryIDFilesIncremental(unsigned firstLevelhashDirN
 
 void MetaStore::getReferenceStats(size_t* numReferencedDirs, size_t* numReferencedFiles)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
 
    *numReferencedDirs = dirStore.getSize();
    *numReferencedFiles = fileStore.getSize();
 }
 
-void MetaStore::getCacheStats(size_t* numCachedDirs)
+void MetaStore::getCacheStats(size_t* numCachedDirs, CachePolicyStats* outPolicyStats)
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
    *numCachedDirs = dirStore.getCacheSize();
+   *outPolicyStats = dirStore.getCacheStats();
 }
 
 /**
@@ -1903,7 +2166,7 @@ void MetaStore::getCacheStats(size_t* numCachedDirs)
  */
 bool MetaStore::cacheSweepAsync()
 {
-   UniqueRWLock lock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock lock(rwlock, SafeRWLock_READ);
    return dirStore.cacheSweepAsync();
 }
 
@@ -1923,7 +2186,7 @@ FhgfsOpsErr MetaStore::insertDisposableFile(FileInode* inode)
       ? Program::getApp()->getBuddyMirrorDisposalDir()
       : Program::getApp()->getDisposalDir();
 
-   UniqueRWLock metaLock(this->rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock metaLock(this->rwlock, SafeRWLock_READ);
    UniqueRWLock dirLock(disposalDir->rwlock, SafeRWLock_WRITE);
 
    const std::string& fileName = inode->getEntryID(); // ID is also the file name
@@ -2009,7 +2272,7 @@ FhgfsOpsErr MetaStore::linkInSameDir(DirInode& parentDir, EntryInfo* fromFileInf
 {
    const char* logContext = "link in same dir";
 
-   UniqueRWLock metaLock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock metaLock(rwlock, SafeRWLock_READ);
    UniqueRWLock parentDirLock(parentDir.rwlock, SafeRWLock_WRITE);
 
    auto [fromFileInode, retVal] = referenceFileUnlocked(parentDir, fromFileInfo);
@@ -2075,7 +2338,7 @@ outUnlock:
  */
 std::pair<FhgfsOpsErr, unsigned> MetaStore::makeNewHardlink(EntryInfo* fromFileInfo)
 {
-   UniqueRWLock metaLock(rwlock, SafeRWLock_WRITE);
+   UniqueShardedRWLock metaLock(rwlock, SafeRWLock_WRITE);
    FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS;
    unsigned updatedLinkCount = 0;
 
@@ -2150,7 +2413,7 @@ std::pair<FhgfsOpsErr, unsigned> MetaStore::makeNewHardlink(EntryInfo* fromFileI
  */
 FhgfsOpsErr MetaStore::verifyAndMoveFileInode(DirInode& parentDir, EntryInfo* fileInfo, FileInodeMode moveMode)
 {
-   UniqueRWLock metaLock(rwlock, SafeRWLock_WRITE);
+   UniqueShardedRWLock metaLock(rwlock, SafeRWLock_WRITE);
    return verifyAndMoveFileInodeUnlocked(parentDir, fileInfo, moveMode);
 }
 
@@ -2395,7 +2658,7 @@ FhgfsOpsErr MetaStore::reinlineFileInode(DirInode& parentDir, EntryInfo* entryIn
  */
 FhgfsOpsErr MetaStore::checkAndRepairDupFileInode(DirInode& parentDir, EntryInfo* entryInfo)
 {
-   UniqueRWLock metaLock(rwlock, SafeRWLock_WRITE);
+   UniqueShardedRWLock metaLock(rwlock, SafeRWLock_WRITE);
    FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS;
 
    if (!parentDir.loadIfNotLoadedUnlocked())
@@ -2529,6 +2792,9 @@ FhgfsOpsErr MetaStore::getRawMetadata(const Path& path, const char* attrName, Ch
 std::pair<FhgfsOpsErr, IncompleteInode> MetaStore::beginResyncFor(const Path& path,
    bool isDirectory)
 {
+   // raw metadata files may contain any inode, so the stat cache can't be kept consistent
+   statCache.invalidateAll();
+
    // first try to create the path directly, and if that fails with ENOENT (ie a directory in the
    // path does not exist), create all parent directories and try again.
    for (int round = 0; round < 2; round++)
@@ -2574,6 +2840,8 @@ FhgfsOpsErr MetaStore::unlinkRawMetadata(const Path& path)
    App* app = Program::getApp();
    const std::string metaPath = app->getMetaPath();
 
+   statCache.invalidateAll();
+
    int unlinkRes = ::unlink(path.str().c_str());
 
    if (!unlinkRes)
@@ -2605,7 +2873,7 @@ FhgfsOpsErr MetaStore::unlinkRawMetadata(const Path& path)
 FhgfsOpsErr MetaStore::setFileState(EntryInfo* entryInfo, const FileState& state)
 {
    const char* logContext = "MetaStore (set file state)";
-   UniqueRWLock metaLock(rwlock, SafeRWLock_READ);
+   UniqueShardedRWLock metaLock(rwlock, SafeRWLock_READ);
 
    // Add inode to global lock store for exclusive access
    GlobalInodeLockStore* lockStore = this->getInodeLockStore();
@@ -2657,4 +2925,5 @@ FhgfsOpsErr MetaStore::setFileState(EntryInfo* entryInfo, const FileState& state
 void MetaStore::invalidateMirroredDirInodes()
 {
    dirStore.invalidateMirroredDirInodes();
+   statCache.invalidateAll();
 }
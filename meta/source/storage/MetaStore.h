@@ -1,5 +1,6 @@
 #pragma once
 
+#include <common/fsck/FsckDirEntry.h>
 #include <common/fsck/FsckDirInode.h>
 #include <common/storage/striping/StripePattern.h>
 #include <common/storage/RemoteStorageTarget.h>
@@ -8,6 +9,7 @@
 #include <common/storage/StorageErrors.h>
 #include <common/storage/EntryInfo.h>
 #include <common/threading/SafeRWLock.h>
+#include <common/threading/ShardedRWLock.h>
 #include <common/threading/Atomics.h>
 #include <common/toolkit/FsckTk.h>
 #include <common/Common.h>
@@ -18,6 +20,7 @@
 #include "DirEntry.h"
 #include "InodeDirStore.h"
 #include "InodeFileStore.h"
+#include "InodeStatCache.h"
 #include "MetadataEx.h"
 #include "MetaFileHandle.h"
 
@@ -30,6 +33,8 @@ typedef std::pair<MetaFileHandle, FhgfsOpsErr>  MetaFileHandleRes;
 class MetaStore
 {
    public:
+      MetaStore();
+
       DirInode* referenceDir(const std::string& dirID, const bool isBuddyMirrored,
          const bool forceLoad);
       void releaseDir(const std::string& dirID);
@@ -84,13 +89,20 @@ class MetaStore
       FhgfsOpsErr getAllInodesIncremental(unsigned hashDirNum, int64_t lastOffset,
           unsigned maxOutInodes, FsckDirInodeList* outDirInodes, FsckFileInodeList* outFileInodes,
           int64_t* outNewOffset, bool isBuddyMirrored);
+      void getFsckInodes(StringListConstIter begin, StringListConstIter end, bool isBuddyMirrored,
+         FsckDirInodeList* outDirInodes, FsckFileInodeList* outFileInodes);
+      FhgfsOpsErr getFsckDirEntryNames(const std::string& contDirID, bool isBuddyMirrored,
+         int64_t lastOffset, unsigned maxOutNames, StringList* outNames, int64_t* outNewOffset);
+      void getFsckDirEntries(const std::string& contDirID, StringListConstIter begin,
+         StringListConstIter end, bool isBuddyMirrored, unsigned msgUserID,
+         FsckDirEntryList* outDirEntries, FsckFileInodeList* outInlinedFileInodes);
 
       FhgfsOpsErr getAllEntryIDFilesIncremental(unsigned firstLevelhashDirNum,
          unsigned secondLevelhashDirNum, int64_t lastOffset, unsigned maxOutEntries,
          StringList* outEntryIDFiles, int64_t* outNewOffset, bool buddyMirrored);
 
       void getReferenceStats(size_t* numReferencedDirs, size_t* numReferencedFiles);
-      void getCacheStats(size_t* numCachedDirs);
+      void getCacheStats(size_t* numCachedDirs, CachePolicyStats* outPolicyStats);
 
       bool cacheSweepAsync();
 
@@ -125,9 +137,12 @@ class MetaStore
 
       GlobalInodeLockStore inodeLockStore;
 
-      RWLock rwlock; /* note: this is mostly not used as a read/write-lock but rather a shared/excl
-         lock (because we're not really modifying anyting directly) - especially relevant for the
-         mutliple dirStore locking dual-move methods */
+      InodeStatCache statCache; // stat data of unloaded file inodes
+
+      ShardedRWLock rwlock; /* note: this is mostly not used as a read/write-lock but rather a
+         shared/excl lock (because we're not really modifying anyting directly) - especially
+         relevant for the mutliple dirStore locking dual-move methods. it's taken shared by almost
+         every operation, hence sharded to keep readers from bouncing a single cache line. */
 
       FhgfsOpsErr isFileUnlinkable(DirInode& subDir, EntryInfo* entryInfo);
 
@@ -158,6 +173,9 @@ class MetaStore
       DirInode* referenceDirUnlocked(const std::string& dirID, bool isBuddyMirrored,
          bool forceLoad);
       void releaseDirUnlocked(const std::string& dirID);
+      DirInode* referenceFsckContDir(const std::string& contDirID, bool isBuddyMirrored,
+         bool* outIsTemp);
+      void releaseFsckContDir(DirInode* dirInode, bool isTemp);
       MetaFileHandleRes referenceFileUnlocked(EntryInfo* entryInfo, bool checkLockStore = true);
       MetaFileHandleRes referenceFileUnlocked(DirInode& subDir, EntryInfo* entryInfo,
          bool checkLockStore = true);
@@ -195,6 +213,11 @@ class MetaStore
       {
         return &inodeLockStore;
       }
+
+      InodeStatCache* getInodeStatCache()
+      {
+         return &statCache;
+      }
       // inliners
 
 };
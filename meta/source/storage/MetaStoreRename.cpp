@@ -29,7 +29,7 @@ FhgfsOpsErr MetaStore::renameInSameDir(DirInode& parentDir, const std::string& f
 {
    const char* logContext = "Rename in dir";
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   UniqueShardedRWLock safeLock(rwlock, SafeRWLock_READ); // L O C K
    SafeRWLock fromMutexLock(&parentDir.rwlock, SafeRWLock_WRITE); // L O C K ( F R O M )
 
    FhgfsOpsErr retVal;
@@ -132,7 +132,7 @@ FhgfsOpsErr MetaStore::renameInSameDir(DirInode& parentDir, const std::string& f
 FhgfsOpsErr MetaStore::unlinkOverwrittenEntry(DirInode& parentDir,
    DirEntry* overWrittenEntry, std::unique_ptr<FileInode>* outInode)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   UniqueShardedRWLock safeLock(rwlock, SafeRWLock_READ); // L O C K
    SafeRWLock parentLock(&parentDir.rwlock, SafeRWLock_WRITE);
 
    FhgfsOpsErr unlinkRes = unlinkOverwrittenEntryUnlocked(parentDir, overWrittenEntry, outInode);
@@ -347,7 +347,7 @@ FhgfsOpsErr MetaStore::moveRemoteFileInsert(EntryInfo* fromFileInfo, DirInode& t
    FhgfsOpsErr retVal = FhgfsOpsErr_INTERNAL;
    outUnlinkedInode->reset();
 
-   SafeRWLock safeMetaStoreLock(&rwlock, SafeRWLock_READ); // L O C K
+   UniqueShardedRWLock safeMetaStoreLock(rwlock, SafeRWLock_READ); // L O C K
    SafeRWLock toParentMutexLock(&toParent.rwlock, SafeRWLock_WRITE); // L O C K ( T O )
 
    std::unique_ptr<DirEntry> overWrittenEntry(toParent.dirEntryCreateFromFileUnlocked(newEntryName));
@@ -478,7 +478,7 @@ FhgfsOpsErr MetaStore::moveRemoteFileBegin(DirInode& dir, EntryInfo* entryInfo,
 {
    FhgfsOpsErr retVal = FhgfsOpsErr_INTERNAL;
 
-   SafeRWLock safeLock(&this->rwlock, SafeRWLock_READ); // L O C K
+   UniqueShardedRWLock safeLock(this->rwlock, SafeRWLock_READ); // L O C K
 
    // lock the dir to make sure no renameInSameDir is going on
    SafeRWLock safeDirLock(&dir.rwlock, SafeRWLock_READ);
@@ -512,7 +512,7 @@ FhgfsOpsErr MetaStore::moveRemoteFileBegin(DirInode& dir, EntryInfo* entryInfo,
 
 void MetaStore::moveRemoteFileComplete(DirInode& dir, const std::string& entryID)
 {
-   SafeRWLock safeLock(&this->rwlock, SafeRWLock_WRITE); // L O C K
+   UniqueShardedRWLock safeLock(this->rwlock, SafeRWLock_WRITE); // L O C K
 
    if (this->fileStore.isInStore(entryID) )
       this->fileStore.moveRemoteComplete(entryID);
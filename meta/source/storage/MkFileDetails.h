@@ -25,6 +25,7 @@ struct MkFileDetails
       int mode;
       int umask;
       int64_t createTime;
+      bool inlineDataSupported = false; // creating client accesses inline file data via meta
 };
 
 
@@ -227,5 +227,66 @@ namespace BuddyCommTk
    {
       return ::getBuddyNeedsResync();
    }
+
+   /**
+    * @return true if msg is a read-only request that a client sent directly to the secondary of
+    *    its buddy group and this node is currently the secondary (if the groups were switched in
+    *    the meantime, we are the primary and process the msg normally).
+    */
+   bool isSecondaryRead(const NetMessage& msg)
+   {
+      if (!msg.hasFlag(NetMessageHeader::Flag_ReadFromSecondary))
+         return false;
+
+      auto* const app = Program::getApp();
+
+      bool isPrimary;
+      const uint16_t buddyID = app->getMetaBuddyGroupMapper()->getBuddyTargetID(
+            app->getLocalNodeNumID().val(), &isPrimary);
+
+      return buddyID && !isPrimary;
+   }
+
+   /**
+    * Consistency guard for read-only requests that a client sends to the secondary directly.
+    *
+    * The secondary may serve such a request only if serving reads is enabled, if it is in sync
+    * with the primary (online/good) and if it has seen all sequence numbers of the client's
+    * mirrored requests that the client has received a response for (seqNoWatermark, which the
+    * client sends as msgSequenceDone). Otherwise the client must send the request to the primary.
+    */
+   bool canServeSecondaryRead(const NumNodeID clientID, const uint64_t seqNoWatermark)
+   {
+      auto* const app = Program::getApp();
+
+      if (!app->getConfig()->getTuneSecondaryServesReads())
+         return false;
+
+      if (app->getBuddyResyncer()->getResyncJob() &&
+            app->getBuddyResyncer()->getResyncJob()->isRunning())
+         return false;
+
+      CombinedTargetState localState;
+
+      if (!app->getMetaStateStore()->getState(app->getLocalNodeNumID().val(), localState)
+            || localState.reachabilityState != TargetReachabilityState_ONLINE
+            || localState.consistencyState != TargetConsistencyState_GOOD)
+         return false;
+
+      if (!seqNoWatermark)
+         return true; // client has not sent any mirrored requests to this group yet
+
+      SessionStore* const sessions = app->getMirroredSessions();
+      Session* const session = sessions->referenceSession(clientID, false);
+
+      if (!session)
+         return false;
+
+      const bool watermarkReached = session->getHighestSeqNo() >= seqNoWatermark;
+
+      sessions->releaseSession(session);
+
+      return watermarkReached;
+   }
 };
 
@@ -6,6 +6,7 @@
 #include <common/nodes/NumNodeID.h>
 
 class MirrorBuddyGroupMapper;
+class NetMessage;
 class TimerQueue;
 
 /**
@@ -21,5 +22,8 @@ namespace BuddyCommTk
    void checkBuddyNeedsResync();
    void setBuddyNeedsResync(const std::string& path, bool needsResync);
    bool getBuddyNeedsResync();
+
+   bool isSecondaryRead(const NetMessage& msg);
+   bool canServeSecondaryRead(NumNodeID clientID, uint64_t seqNoWatermark);
 };
 
@@ -0,0 +1,160 @@
+#include <common/app/log/Logger.h>
+#include "MirrorForwardBatcher.h"
+
+
+MirrorForwardBatcher::MirrorForwardBatcher(unsigned maxBatchSize, unsigned maxBatchDelayUS,
+   unsigned maxInFlightBatches) :
+   maxBatchSize(std::max(maxBatchSize, 1u) ), maxBatchDelayUS(maxBatchDelayUS),
+   maxInFlightBatches(std::max(maxInFlightBatches, 1u) ), numInFlightBatches(0)
+{
+}
+
+/**
+ * Drop-in replacement for MessagingTk::requestResponseNode() for msgs to the secondary of a
+ * buddy group.
+ *
+ * Requests that can't be batched (sendExtraData, secondary not online/good) and batched requests that
+ * failed with a communication error or were answered with TRYAGAIN (e.g. because a request with
+ * the same sequence number was still in progress on the secondary) are (re-)sent via
+ * MessagingTk::requestResponseNode(), so the error handling is the same as without batching.
+ */
+FhgfsOpsErr MirrorForwardBatcher::requestResponseNode(RequestResponseNode* rrNode,
+   RequestResponseArgs* rrArgs)
+{
+   if(rrArgs->sendExtraData || rrArgs->node || !rrNode->mirrorBuddies || !rrNode->targetStates)
+      return MessagingTk::requestResponseNode(rrNode, rrArgs);
+
+   NumNodeID nodeID(rrNode->useBuddyMirrorSecond ?
+      rrNode->mirrorBuddies->getSecondaryTargetID(rrNode->nodeID.val() ) :
+      rrNode->mirrorBuddies->getPrimaryTargetID(rrNode->nodeID.val() ) );
+
+   CombinedTargetState targetState;
+
+   if(!nodeID ||
+      !rrNode->targetStates->getState(nodeID.val(), targetState) ||
+      (targetState.reachabilityState != TargetReachabilityState_ONLINE) ||
+      (targetState.consistencyState != TargetConsistencyState_GOOD) )
+      return MessagingTk::requestResponseNode(rrNode, rrArgs); // (handles and logs the error)
+
+   FhgfsOpsErr batchRes = requestResponseBatched(nodeID, rrNode->nodeStore, rrArgs);
+   if( (batchRes != FhgfsOpsErr_COMMUNICATION) && (batchRes != FhgfsOpsErr_AGAIN) )
+      return (batchRes == FhgfsOpsErr_WOULDBLOCK) ? FhgfsOpsErr_COMMUNICATION : batchRes;
+
+   LOG(COMMUNICATION, WARNING, "Retrying communication without batching.",
+         ("peer", rrNode->nodeStore->getNodeIDWithTypeStr(nodeID)),
+         ("message type", rrArgs->requestMsg->getMsgTypeStr()), ("batchRes", batchRes));
+
+   rrArgs->outRespMsg.reset();
+
+   return MessagingTk::requestResponseNode(rrNode, rrArgs);
+}
+
+/**
+ * Queue the request and wait until it was sent as part of a batch, either by this thread as the
+ * leader of a batch or by another thread.
+ *
+ * @return result of MessagingTk::requestResponseCommBatch() for this request.
+ */
+FhgfsOpsErr MirrorForwardBatcher::requestResponseBatched(NumNodeID nodeID,
+   NodeStoreServers* nodeStore, RequestResponseArgs* rrArgs)
+{
+   Request request(nodeID, rrArgs);
+
+   std::unique_lock<std::mutex> lock(mutex);
+
+   queue.push_back(&request);
+
+   if(maxBatchDelayUS)
+      requestQueuedCond.notify_all();
+
+   while(!request.isDone)
+   {
+      if(request.isTaken || (numInFlightBatches >= maxInFlightBatches) )
+      {
+         batchDoneCond.wait(lock);
+         continue;
+      }
+
+      // become leader of the next batch for our node
+
+      numInFlightBatches++;
+
+      if(maxBatchDelayUS && (countQueued(nodeID) < maxBatchSize) )
+         requestQueuedCond.wait_for(lock, std::chrono::microseconds(maxBatchDelayUS),
+            [&] () { return countQueued(nodeID) >= maxBatchSize; } );
+
+      std::vector<Request*> batch;
+
+      for(auto iter = queue.begin(); (iter != queue.end() ) && (batch.size() < maxBatchSize); )
+      {
+         if( (*iter)->nodeID != nodeID)
+         {
+            iter++;
+            continue;
+         }
+
+         (*iter)->isTaken = true;
+         batch.push_back(*iter);
+         iter = queue.erase(iter);
+      }
+
+      if(batch.empty() )
+      { // another leader took our request while we were waiting for more requests
+         numInFlightBatches--;
+         batchDoneCond.notify_all();
+         continue;
+      }
+
+      lock.unlock();
+
+      std::vector<RequestResponseArgs*> batchArgs;
+      std::vector<FhgfsOpsErr> batchResults;
+
+      batchArgs.reserve(batch.size() );
+      for(auto iter = batch.begin(); iter != batch.end(); iter++)
+         batchArgs.push_back( (*iter)->rrArgs);
+
+      sendBatch(nodeID, nodeStore, batchArgs, batchResults);
+
+      lock.lock();
+
+      for(size_t i = 0; i < batch.size(); i++)
+      {
+         batch[i]->result = batchResults[i];
+         batch[i]->isDone = true;
+      }
+
+      numInFlightBatches--;
+      batchDoneCond.notify_all();
+   }
+
+   return request.result;
+}
+
+/**
+ * Note: Caller must hold mutex.
+ */
+size_t MirrorForwardBatcher::countQueued(NumNodeID nodeID) const
+{
+   return std::count_if(queue.begin(), queue.end(),
+      [nodeID] (const Request* request) { return request->nodeID == nodeID; } );
+}
+
+/**
+ * @param outResults will be resized to batch size.
+ */
+void MirrorForwardBatcher::sendBatch(NumNodeID nodeID, NodeStoreServers* nodeStore,
+   std::vector<RequestResponseArgs*>& batch, std::vector<FhgfsOpsErr>& outResults)
+{
+   outResults.assign(batch.size(), FhgfsOpsErr_COMMUNICATION);
+
+   auto node = nodeStore->referenceNode(nodeID);
+   if(!node)
+   {
+      LOG(COMMUNICATION, WARNING, "Unknown nodeID.", nodeID,
+            ("type", nodeStore->getStoreType()));
+      return;
+   }
+
+   MessagingTk::requestResponseCommBatch(*node, &batch[0], batch.size(), &outResults[0]);
+}
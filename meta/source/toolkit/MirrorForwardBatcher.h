@@ -0,0 +1,76 @@
+#pragma once
+
+#include <common/toolkit/MessagingTk.h>
+#include <common/Common.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+
+/**
+ * Pipelining of the msgs that a buddy group primary forwards to its secondary (state changing
+ * operations and AckNotify msgs).
+ *
+ * Instead of one request-response round trip per forwarded msg, the msgs of concurrently
+ * forwarding workers are pipelined: the first waiting worker becomes the leader of a batch, takes
+ * up to maxBatchSize queued requests and sends them back to back over a single connection before
+ * it receives the responses (MessagingTk::requestResponseCommBatch); all workers of the batch get
+ * their own response. While batches are in flight, new requests queue up and form the next batch,
+ * so batches grow with the load and a single forward doesn't wait for anything.
+ *
+ * Note: The msgs of a batch are not merged. The secondary still receives, processes and answers
+ * (and persists) each msg on its own, so this saves round trips, but not per-msg work on the
+ * secondary.
+ *
+ * Ordering: Requests are sent in queue order and the secondary processes the msgs of a connection
+ * in order. Different batches may be processed concurrently by the secondary (like unbatched
+ * forwards of different workers), which is fine because the primary holds the entry locks while
+ * forwarding, so operations on the same entry are never in flight at the same time.
+ */
+class MirrorForwardBatcher
+{
+   public:
+      MirrorForwardBatcher(unsigned maxBatchSize, unsigned maxBatchDelayUS,
+         unsigned maxInFlightBatches);
+      virtual ~MirrorForwardBatcher() {}
+
+      MirrorForwardBatcher(const MirrorForwardBatcher&) = delete;
+      MirrorForwardBatcher& operator=(const MirrorForwardBatcher&) = delete;
+
+      FhgfsOpsErr requestResponseNode(RequestResponseNode* rrNode, RequestResponseArgs* rrArgs);
+
+   protected:
+      FhgfsOpsErr requestResponseBatched(NumNodeID nodeID, NodeStoreServers* nodeStore,
+         RequestResponseArgs* rrArgs);
+
+      virtual void sendBatch(NumNodeID nodeID, NodeStoreServers* nodeStore,
+         std::vector<RequestResponseArgs*>& batch, std::vector<FhgfsOpsErr>& outResults);
+
+   private:
+      struct Request
+      {
+         Request(NumNodeID nodeID, RequestResponseArgs* rrArgs) :
+            nodeID(nodeID), rrArgs(rrArgs), result(FhgfsOpsErr_COMMUNICATION), isTaken(false),
+            isDone(false)
+         {}
+
+         NumNodeID nodeID;
+         RequestResponseArgs* rrArgs;
+         FhgfsOpsErr result;
+         bool isTaken; // in a batch that is in flight
+         bool isDone;
+      };
+
+      const unsigned maxBatchSize;
+      const unsigned maxBatchDelayUS; // time that a leader waits for more requests to join
+      const unsigned maxInFlightBatches;
+
+      std::mutex mutex;
+      std::condition_variable batchDoneCond;
+      std::condition_variable requestQueuedCond; // for leaders that wait for more requests
+      std::deque<Request*> queue;
+      unsigned numInFlightBatches;
+
+      size_t countQueued(NumNodeID nodeID) const;
+};
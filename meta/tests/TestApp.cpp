@@ -0,0 +1,111 @@
+#include <common/storage/striping/Raid0Pattern.h>
+#include <common/toolkit/StorageTk.h>
+#include <program/Program.h>
+#include <storage/MetaStore.h>
+#include <common/nodes/LocalNode.h>
+#include "TestApp.h"
+
+#include <unistd.h>
+
+
+/**
+ * @param cfgArgs additional config values ("key=value"), e.g. the tune options to test.
+ * @throw InvalidConfigException if the config or storage setup fails.
+ */
+TestApp::TestApp(const StringList& cfgArgs)
+{
+   char metaDirTemplate[] = "/tmp/beegfs-meta-test.XXXXXX";
+   if (!mkdtemp(metaDirTemplate) )
+      throw InvalidConfigException("Unable to create temporary dir: " + System::getErrString() );
+
+   metaDir = metaDirTemplate;
+
+   char* cwd = get_current_dir_name();
+   prevWorkingDir = cwd ? cwd : "/";
+   free(cwd);
+
+   args.push_back("beegfs-meta");
+   args.push_back("storeMetaDirectory=" + metaDir);
+   args.push_back("storeUseExtendedAttribs=false");
+   args.push_back("connDisableAuthentication=true");
+   args.push_back("tuneProcessFDLimit=0");
+   args.insert(args.end(), cfgArgs.begin(), cfgArgs.end() );
+
+   for (auto iter = args.begin(); iter != args.end(); iter++)
+      argv.push_back(&(*iter)[0]);
+
+   AbstractApp::runTimeInitsAndChecks();
+
+   app.reset(new App(argv.size(), &argv[0]) );
+   app->cfg = new Config(argv.size(), &argv[0]);
+
+   Program::app = app.get(); // (the storage init uses the config of Program's app)
+
+   // (loading inodes from disk sets the local node as their owner)
+   NicAddressList nicList;
+   app->localNode = std::make_shared<LocalNode>(NODETYPE_Meta, "", NumNodeID(1), 0, 0, nicList);
+
+   // data objects for msg processing (see App::initDataObjects() )
+   app->metaBuddyGroupMapper = new MirrorBuddyGroupMapper();
+   app->metaStateStore = new TargetStateStore(NODETYPE_Meta);
+   app->sessions = new SessionStore();
+   app->mirroredSessions = new SessionStore();
+   app->nodeOperationStats = new MetaNodeOpStats();
+   app->buddyResyncer = new BuddyResyncer();
+
+   app->storageNodes = new NodeStoreServers(NODETYPE_Storage, false);
+   app->targetMapper = new TargetMapper();
+   app->storageNodes->attachTargetMapper(app->targetMapper);
+   app->targetStateStore = new TargetStateStore(NODETYPE_Storage);
+   app->targetMapper->attachStateStore(app->targetStateStore);
+
+   app->preinitStorage();
+   app->initStorage(); // (changes the working dir)
+}
+
+TestApp::~TestApp()
+{
+   Program::app = NULL;
+
+   app->rootDir = NULL;
+   app.reset();
+
+   if (chdir(prevWorkingDir.c_str() ) )
+      std::cerr << "Unable to change working dir: " << prevWorkingDir << std::endl;
+
+   StorageTk::removeDirRecursive(metaDir);
+}
+
+/**
+ * Create the root dir (in memory only) and set it as the App's root dir.
+ *
+ * @param ownerID node ID or buddy group ID (if isBuddyMirrored) of the owner.
+ */
+DirInode* TestApp::createRootDir(NumNodeID ownerID, bool isBuddyMirrored)
+{
+   Raid0Pattern pattern(512*1024, {}, 1);
+
+   rootDir.reset(new DirInode(META_ROOTDIR_ID_STR, S_IFDIR | 0755, 0, 0, ownerID, pattern,
+      isBuddyMirrored) );
+
+   app->rootDir = rootDir.get();
+
+   return rootDir.get();
+}
+
+/**
+ * Create the MetaStore of the App (without loading a root dir from it), so that msgs that
+ * reference inodes through the MetaStore can be processed.
+ */
+void TestApp::createMetaStore()
+{
+   app->metaStore = new MetaStore();
+}
+
+/**
+ * Set the ChunkUnlinker of the App (not started, owned by the App afterwards).
+ */
+void TestApp::setChunkUnlinker(ChunkUnlinker* chunkUnlinker)
+{
+   app->chunkUnlinker = chunkUnlinker;
+}
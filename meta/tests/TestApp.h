@@ -0,0 +1,47 @@
+#pragma once
+
+#include <app/App.h>
+#include <storage/DirInode.h>
+
+
+/**
+ * Sets up the parts of the App that the storage classes and msg processing need (config, metadata
+ * storage paths, a local node with numeric ID 1, sessions, buddy group and state stores, empty
+ * storage node store and target mapper), so that tests can use them without running the server.
+ * No components are started.
+ *
+ * The metadata storage dir is a new temporary dir, which is also the working dir (like after
+ * App::initStorage() ) until the TestApp is destroyed.
+ *
+ * Note: Only one TestApp may exist at a time, because it sets the App of Program.
+ */
+class TestApp
+{
+   public:
+      TestApp(const StringList& cfgArgs);
+      ~TestApp();
+
+      TestApp(const TestApp&) = delete;
+      TestApp& operator=(const TestApp&) = delete;
+
+      DirInode* createRootDir(NumNodeID ownerID, bool isBuddyMirrored);
+      void createMetaStore();
+      void setChunkUnlinker(ChunkUnlinker* chunkUnlinker);
+
+
+   private:
+      std::vector<std::string> args;
+      std::vector<char*> argv;
+      std::unique_ptr<App> app;
+      std::unique_ptr<DirInode> rootDir; // (owned by the MetaStore in a running server)
+
+      std::string metaDir;
+      std::string prevWorkingDir;
+
+
+   public:
+      App* getApp() const
+      {
+         return app.get();
+      }
+};
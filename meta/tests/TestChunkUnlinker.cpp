@@ -0,0 +1,359 @@
+#include <common/components/worker/Worker.h>
+#include <common/net/message/storage/creating/UnlinkLocalFilesMsg.h>
+#include <common/net/message/storage/creating/UnlinkLocalFilesRespMsg.h>
+#include <common/storage/striping/BuddyMirrorPattern.h>
+#include <common/storage/striping/Raid0Pattern.h>
+#include <common/toolkit/MessagingTk.h>
+#include <components/ChunkUnlinker.h>
+#include <net/message/NetMessageFactory.h>
+#include <net/msghelpers/MsgHelperUnlink.h>
+#include <storage/FileInode.h>
+#include "TestApp.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <thread>
+
+
+namespace {
+
+/**
+ * ChunkUnlinker that doesn't talk to storage servers or the disposal dir, but records what it
+ * would send and fails the entries that the test wants to fail.
+ */
+class RecordingChunkUnlinker : public ChunkUnlinker
+{
+   public:
+      RecordingChunkUnlinker(size_t maxQueueSize,
+         unsigned retryBaseMS = CHUNKUNLINKER_RETRY_BASE_MS) :
+         ChunkUnlinker(maxQueueSize, retryBaseMS)
+      {}
+
+      using ChunkUnlinker::unlinkRound;
+      using ChunkUnlinker::getRetryDelayMS;
+
+      std::map<uint16_t, NumNodeID> targetNodes;
+      std::set<std::string> failingEntryIDs; // fail in UnlinkLocalFilesMsgs and as single file
+
+      std::vector<std::pair<NumNodeID, UnlinkLocalFilesEntryVec>> sentBatches;
+      StringVector persistedIDs;
+      StringVector singleIDs;
+      StringVector finishedIDs;
+
+   protected:
+      bool persistItem(FileInode* unlinkedInode) override
+      {
+         persistedIDs.push_back(unlinkedInode->getEntryID() );
+         delete unlinkedInode;
+
+         return true;
+      }
+
+      NumNodeID getStorageNodeID(uint16_t targetID) override
+      {
+         auto iter = targetNodes.find(targetID);
+
+         return iter == targetNodes.end() ? NumNodeID() : iter->second;
+      }
+
+      void unlinkNodeBatches(std::vector<NodeBatch*>& batches) override
+      {
+         for (auto batchIter = batches.begin(); batchIter != batches.end(); batchIter++)
+         {
+            NodeBatch& batch = **batchIter;
+
+            sentBatches.emplace_back(batch.nodeID, batch.entries);
+
+            for (auto iter = batch.entries.begin(); iter != batch.entries.end(); iter++)
+               batch.results.push_back(failingEntryIDs.count(iter->entryID) ?
+                  FhgfsOpsErr_COMMUNICATION : FhgfsOpsErr_SUCCESS);
+         }
+      }
+
+      void unlinkSingle(Item& item) override
+      {
+         singleIDs.push_back(item.entryID);
+
+         if (failingEntryIDs.count(item.entryID) )
+            item.result = FhgfsOpsErr_COMMUNICATION;
+      }
+
+      void finishItem(Item& item) override
+      {
+         finishedIDs.push_back(item.entryID);
+      }
+};
+
+FileInode* createFile(const std::string& fileID, StripePattern* pattern)
+{
+   StatData statData(S_IFREG | 0644, 0, 0, 1);
+
+   FileInodeStoreData storeData(fileID, &statData, pattern, 0, 0, "",
+      FileInodeOrigFeature_TRUE);
+
+   return new FileInode(fileID, &storeData, DirEntryType_REGULARFILE, 0);
+}
+
+FileInode* createRaid0File(const std::string& fileID, const UInt16Vector& targetIDs)
+{
+   Raid0Pattern pattern(512*1024, targetIDs);
+
+   return createFile(fileID, &pattern);
+}
+
+std::set<std::string> entryIDsOf(const UnlinkLocalFilesEntryVec& entries)
+{
+   std::set<std::string> result;
+
+   for (auto iter = entries.begin(); iter != entries.end(); iter++)
+      result.insert(iter->entryID + "@" + StringTk::uintToStr(iter->targetID) );
+
+   return result;
+}
+
+}
+
+TEST(ChunkUnlinker, groupsChunksPerNode)
+{
+   RecordingChunkUnlinker unlinker(100);
+
+   unlinker.targetNodes = { {1, NumNodeID(1)}, {2, NumNodeID(1)}, {3, NumNodeID(2)} };
+
+   ASSERT_TRUE(unlinker.enqueue(createRaid0File("f1", {1, 3}), 0) );
+   ASSERT_TRUE(unlinker.enqueue(createRaid0File("f2", {2, 3}), 0) );
+   ASSERT_TRUE(unlinker.enqueue(createRaid0File("f3", {1, 2, 4}), 0) ); // 4 is unknown
+
+   BuddyMirrorPattern mirrorPattern(512*1024, {1});
+
+   ASSERT_TRUE(unlinker.enqueue(createFile("m", &mirrorPattern), 0) );
+
+   ASSERT_EQ(unlinker.persistedIDs, StringVector({"f1", "f2", "f3", "m"}) );
+
+   unlinker.unlinkRound(0);
+
+   // one msg per node...
+   ASSERT_EQ(unlinker.sentBatches.size(), 2u);
+
+   std::map<NumNodeID, std::set<std::string>> nodeEntries;
+
+   for (auto iter = unlinker.sentBatches.begin(); iter != unlinker.sentBatches.end(); iter++)
+   {
+      ASSERT_EQ(nodeEntries.count(iter->first), 0u);
+      nodeEntries[iter->first] = entryIDsOf(iter->second);
+   }
+
+   ASSERT_EQ(nodeEntries[NumNodeID(1)],
+      std::set<std::string>({"f1@1", "f2@2", "f3@1", "f3@2"}) );
+   ASSERT_EQ(nodeEntries[NumNodeID(2)], std::set<std::string>({"f1@3", "f2@3"}) );
+
+   // ...except for buddy mirrored chunks
+   ASSERT_EQ(unlinker.singleIDs, StringVector({"m"}) );
+
+   // (unknown targets are no error for unlink)
+   ASSERT_EQ(unlinker.finishedIDs, StringVector({"f1", "f2", "f3", "m"}) );
+}
+
+TEST(ChunkUnlinker, splitsLargeBatches)
+{
+   const unsigned numFiles = UNLINKLOCALFILESMSG_MAX_ENTRIES + 100;
+
+   RecordingChunkUnlinker unlinker(numFiles);
+
+   unlinker.targetNodes = { {1, NumNodeID(1)} };
+
+   for (unsigned i = 0; i < numFiles; i++)
+      ASSERT_TRUE(unlinker.enqueue(createRaid0File("f" + StringTk::uintToStr(i), {1}), 0) );
+
+   unlinker.unlinkRound(0);
+
+   ASSERT_EQ(unlinker.sentBatches.size(), 2u);
+   ASSERT_EQ(unlinker.sentBatches[0].first, NumNodeID(1) );
+   ASSERT_EQ(unlinker.sentBatches[0].second.size(), size_t(UNLINKLOCALFILESMSG_MAX_ENTRIES) );
+   ASSERT_EQ(unlinker.sentBatches[1].first, NumNodeID(1) );
+   ASSERT_EQ(unlinker.sentBatches[1].second.size(), 100u);
+   ASSERT_EQ(unlinker.finishedIDs.size(), numFiles);
+}
+
+TEST(ChunkUnlinker, retryDelay)
+{
+   RecordingChunkUnlinker unlinker(1);
+
+   ASSERT_EQ(unlinker.getRetryDelayMS(1), unsigned(CHUNKUNLINKER_RETRY_BASE_MS) );
+   ASSERT_EQ(unlinker.getRetryDelayMS(2), 2u * CHUNKUNLINKER_RETRY_BASE_MS);
+   ASSERT_EQ(unlinker.getRetryDelayMS(3), 4u * CHUNKUNLINKER_RETRY_BASE_MS);
+}
+
+TEST(ChunkUnlinker, retriesFailedBatchWithBackoff)
+{
+   const unsigned retryBaseMS = 200;
+   const auto retryWait = std::chrono::milliseconds(retryBaseMS + 20);
+
+   RecordingChunkUnlinker unlinker(100, retryBaseMS);
+
+   unlinker.targetNodes = { {1, NumNodeID(1)} };
+   unlinker.failingEntryIDs = {"f1"};
+
+   ASSERT_TRUE(unlinker.enqueue(createRaid0File("f1", {1}), 0) );
+   ASSERT_TRUE(unlinker.enqueue(createRaid0File("f2", {1}), 0) );
+
+   unlinker.unlinkRound(0);
+
+   ASSERT_EQ(unlinker.sentBatches.size(), 1u);
+   ASSERT_EQ(unlinker.finishedIDs, StringVector({"f2"}) );
+
+   // not due yet
+   unlinker.unlinkRound(0);
+
+   ASSERT_TRUE(unlinker.singleIDs.empty() );
+
+   // first retry (with single-chunk msgs) fails again...
+   std::this_thread::sleep_for(retryWait);
+   unlinker.unlinkRound(0);
+
+   ASSERT_EQ(unlinker.singleIDs, StringVector({"f1"}) );
+
+   // ...and the second retry waits twice as long
+   std::this_thread::sleep_for(retryWait);
+   unlinker.unlinkRound(0);
+
+   ASSERT_EQ(unlinker.singleIDs, StringVector({"f1"}) );
+
+   unlinker.failingEntryIDs.clear();
+
+   std::this_thread::sleep_for(retryWait);
+   unlinker.unlinkRound(0);
+
+   ASSERT_EQ(unlinker.singleIDs, StringVector({"f1", "f1"}) );
+   ASSERT_EQ(unlinker.finishedIDs, StringVector({"f2", "f1"}) );
+   ASSERT_EQ(unlinker.sentBatches.size(), 1u);
+}
+
+TEST(ChunkUnlinker, givesUpAfterMaxRetries)
+{
+   RecordingChunkUnlinker unlinker(100, 1);
+
+   unlinker.targetNodes = { {1, NumNodeID(1)} };
+   unlinker.failingEntryIDs = {"f1"};
+
+   ASSERT_TRUE(unlinker.enqueue(createRaid0File("f1", {1}), 0) );
+
+   // (total backoff is 1+2+4+8+16 ms)
+   for (unsigned i = 0; i < 100; i++)
+   {
+      unlinker.unlinkRound(0);
+      std::this_thread::sleep_for(std::chrono::milliseconds(5) );
+   }
+
+   ASSERT_EQ(unlinker.singleIDs.size(), unsigned(CHUNKUNLINKER_MAX_RETRIES) );
+   ASSERT_TRUE(unlinker.finishedIDs.empty() );
+}
+
+TEST(ChunkUnlinker, queueFull)
+{
+   RecordingChunkUnlinker unlinker(2);
+
+   unlinker.targetNodes = { {1, NumNodeID(1)} };
+
+   ASSERT_TRUE(unlinker.enqueue(createRaid0File("f1", {1}), 0) );
+   ASSERT_TRUE(unlinker.enqueue(createRaid0File("f2", {1}), 0) );
+
+   // caller keeps the inode to unlink the chunks synchronously
+   std::unique_ptr<FileInode> rejected(createRaid0File("f3", {1}) );
+
+   ASSERT_FALSE(unlinker.enqueue(rejected.get(), 0) );
+   ASSERT_EQ(rejected->getEntryID(), "f3");
+   ASSERT_EQ(unlinker.persistedIDs, StringVector({"f1", "f2"}) );
+
+   unlinker.unlinkRound(0);
+
+   ASSERT_TRUE(unlinker.enqueue(rejected.release(), 0) );
+}
+
+TEST(ChunkUnlinker, mirroredMetadataNotQueued)
+{
+   RecordingChunkUnlinker unlinker(100);
+
+   std::unique_ptr<FileInode> file(createRaid0File("f1", {1}) );
+   file->setIsBuddyMirrored();
+
+   ASSERT_FALSE(unlinker.enqueue(file.get(), 0) );
+   ASSERT_TRUE(unlinker.persistedIDs.empty() );
+}
+
+TEST(ChunkUnlinker, asyncUnlinkFallsBackToSync)
+{
+   TestApp testApp({});
+
+   RecordingChunkUnlinker* unlinker = new RecordingChunkUnlinker(1);
+   testApp.setChunkUnlinker(unlinker);
+
+   ASSERT_EQ(MsgHelperUnlink::unlinkChunkFilesAsync(createRaid0File("f1", {1}), 0),
+      FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(unlinker->persistedIDs, StringVector({"f1"}) );
+
+   /* queue is full: the chunk is unlinked right away (the target is unknown to the test App,
+      which is no error for unlink) */
+   ASSERT_EQ(MsgHelperUnlink::unlinkChunkFilesAsync(createRaid0File("f2", {2}), 0),
+      FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(unlinker->persistedIDs, StringVector({"f1"}) );
+}
+
+TEST(ChunkUnlinker, unlinkLocalFilesMsgSerialization)
+{
+   const std::string maxEntryID = "FFFFFFFF-FFFFFFFF-FFFFFFFF";
+
+   UnlinkLocalFilesEntryVec entries;
+
+   entries.emplace_back("1-5E0F8A12-1", 1, PathInfo() );
+   entries.emplace_back("2-5E0F8A12-1", 65535, PathInfo(1000, "0-5E0F8A00-1",
+      PATHINFO_FEATURE_ORIG) );
+
+   while (entries.size() < UNLINKLOCALFILESMSG_MAX_ENTRIES)
+      entries.emplace_back(maxEntryID, 65535, PathInfo(~0u, maxEntryID, PATHINFO_FEATURE_ORIG) );
+
+   UnlinkLocalFilesMsg msgIn(&entries);
+
+   // a full msg has to fit into the receive buffer of a storage worker
+   auto buf = MessagingTk::createMsgVec(msgIn);
+   ASSERT_LT(buf.size(), size_t(WORKER_BUFIN_SIZE) );
+
+   UnlinkLocalFilesMsg msgOut;
+
+   Deserializer des(&buf[NETMSG_HEADER_LENGTH], buf.size() - NETMSG_HEADER_LENGTH);
+   UnlinkLocalFilesMsg::serialize(&msgOut, des);
+   ASSERT_TRUE(des.good() );
+   ASSERT_EQ(des.size(), buf.size() - NETMSG_HEADER_LENGTH);
+
+   ASSERT_EQ(msgOut.getEntries().size(), entries.size() );
+
+   for (size_t i = 0; i < entries.size(); i++)
+   {
+      ASSERT_EQ(msgOut.getEntries()[i].entryID, entries[i].entryID);
+      ASSERT_EQ(msgOut.getEntries()[i].targetID, entries[i].targetID);
+      ASSERT_EQ(msgOut.getEntries()[i].pathInfo, entries[i].pathInfo);
+   }
+}
+
+TEST(ChunkUnlinker, unlinkLocalFilesRespMsgSerialization)
+{
+   FhgfsOpsErrVec results({FhgfsOpsErr_SUCCESS, FhgfsOpsErr_UNKNOWNTARGET, FhgfsOpsErr_INTERNAL,
+      FhgfsOpsErr_SUCCESS});
+
+   UnlinkLocalFilesRespMsg respIn(&results);
+
+   NetMessageFactory factory;
+   auto respOut = factory.createFromBuf(MessagingTk::createMsgVec(respIn) );
+   ASSERT_EQ(respOut->getMsgType(), NETMSGTYPE_UnlinkLocalFilesResp);
+
+   ASSERT_EQ(static_cast<UnlinkLocalFilesRespMsg&>(*respOut).getResults(), results);
+
+   FhgfsOpsErrVec noResults;
+
+   UnlinkLocalFilesRespMsg emptyIn(&noResults);
+
+   auto emptyOut = factory.createFromBuf(MessagingTk::createMsgVec(emptyIn) );
+   ASSERT_EQ(emptyOut->getMsgType(), NETMSGTYPE_UnlinkLocalFilesResp);
+   ASSERT_TRUE(static_cast<UnlinkLocalFilesRespMsg&>(*emptyOut).getResults().empty() );
+}
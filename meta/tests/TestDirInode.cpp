@@ -0,0 +1,129 @@
+#include <common/storage/striping/Raid0Pattern.h>
+#include <common/toolkit/StorageTk.h>
+#include <storage/DirInode.h>
+#include "TestApp.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+
+namespace {
+
+const unsigned numThreads = 8;
+const unsigned numNamesPerThread = 200; // created by only one thread
+const unsigned numSharedNames = 50; // created by all threads
+
+/**
+ * Store a new dir on disk.
+ *
+ * @return ID of the new dir
+ */
+std::string createDir()
+{
+   const Raid0Pattern pattern(512*1024, UInt16Vector() );
+   const std::string dirID = StorageTk::generateFileID(NumNodeID(1) );
+
+   DirInode dir(dirID, 0755, 0, 0, NumNodeID(1), pattern, false);
+
+   EXPECT_EQ(dir.storePersistentMetaData(), FhgfsOpsErr_SUCCESS);
+
+   return dirID;
+}
+
+FhgfsOpsErr makeSubdirEntry(DirInode& dir, const std::string& name)
+{
+   DirEntry entry(DirEntryType_DIRECTORY, name, StorageTk::generateFileID(NumNodeID(1) ),
+      NumNodeID(1) );
+
+   return dir.makeDirEntry(entry);
+}
+
+size_t countEntriesOnDisk(DirInode& dir)
+{
+   size_t numEntries = 0;
+   int64_t serverOffset = 0;
+   StringList names;
+
+   do
+   {
+      names.clear();
+
+      if (dir.listIncremental(serverOffset, 128, &names, &serverOffset) != FhgfsOpsErr_SUCCESS)
+         return 0;
+
+      numEntries += names.size();
+   } while (!names.empty() );
+
+   return numEntries;
+}
+
+}
+
+/**
+ * Param: number of name lock shards of the dir (tuneDirEntryLockShards), 0 for the locking without
+ * shards (i.e. makeDirEntry() without makeDirEntryParallel() ).
+ */
+class TestDirInodeCreate : public ::testing::TestWithParam<unsigned>
+{
+};
+
+INSTANTIATE_TEST_CASE_P(Name, TestDirInodeCreate,
+      ::testing::Values(0, 2, 16) );
+
+TEST_P(TestDirInodeCreate, concurrentCreates)
+{
+   TestApp testApp({"tuneDirEntryLockShards=" + StringTk::uintToStr(GetParam() )});
+
+   const std::string dirID = createDir();
+
+   // like a dir in the InodeDirStore, which gets its shards from the config
+   DirInode dir(dirID, false, testApp.getApp()->getConfig()->getTuneDirEntryLockShards() );
+
+   std::atomic<unsigned> numSharedCreated(0);
+   std::atomic<unsigned> numSharedExisting(0);
+   std::vector<std::thread> threads;
+
+   for (unsigned t = 0; t < numThreads; t++)
+      threads.emplace_back([&, t] () {
+         for (unsigned i = 0; i < numNamesPerThread; i++)
+         {
+            EXPECT_EQ(makeSubdirEntry(dir, "own-" + StringTk::uintToStr(t) + "-" +
+               StringTk::uintToStr(i) ), FhgfsOpsErr_SUCCESS);
+
+            if (i >= numSharedNames)
+               continue;
+
+            FhgfsOpsErr sharedRes = makeSubdirEntry(dir, "shared-" + StringTk::uintToStr(i) );
+
+            if (sharedRes == FhgfsOpsErr_SUCCESS)
+               numSharedCreated++;
+            else if (sharedRes == FhgfsOpsErr_EXISTS)
+               numSharedExisting++;
+            else
+               ADD_FAILURE() << "shared create failed: " << sharedRes;
+         }
+      });
+
+   for (auto& thread : threads)
+      thread.join();
+
+   const size_t numExpected = numThreads * numNamesPerThread + numSharedNames;
+
+   // every name was created exactly once
+   ASSERT_EQ(numSharedCreated, numSharedNames);
+   ASSERT_EQ(numSharedExisting, numSharedNames * (numThreads - 1) );
+
+   for (unsigned i = 0; i < numSharedNames; i++)
+      ASSERT_TRUE(dir.exists("shared-" + StringTk::uintToStr(i) ) );
+
+   ASSERT_EQ(countEntriesOnDisk(dir), numExpected);
+
+   // no increase of the entry counters got lost, neither in memory nor on disk
+   ASSERT_EQ(dir.getNumSubEntries(), numExpected);
+
+   StatData statData;
+   ASSERT_EQ(DirInode::getStatData(dirID, false, statData, NULL, NULL), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(statData.getFileSize(), int64_t(numExpected) );
+}
@@ -0,0 +1,273 @@
+#include <common/net/message/session/rw/ReadInlineFileMsg.h>
+#include <common/net/message/session/rw/ReadInlineFileRespMsg.h>
+#include <common/net/message/session/rw/WriteInlineFileMsg.h>
+#include <common/net/message/session/rw/WriteInlineFileRespMsg.h>
+#include <common/net/sock/StandardSocket.h>
+#include <common/storage/striping/Raid0Pattern.h>
+#include <common/toolkit/MessagingTk.h>
+#include <common/toolkit/StorageTk.h>
+#include <common/toolkit/Time.h>
+#include <net/message/NetMessageFactory.h>
+#include <storage/FileInode.h>
+#include "TestApp.h"
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+
+
+namespace {
+
+const size_t maxSize = 16;
+
+/**
+ * Store a new inline data file in a separate inode file.
+ */
+std::unique_ptr<FileInode> createInlineFile(EntryInfo& outEntryInfo)
+{
+   const std::string fileID = StorageTk::generateFileID(NumNodeID(1) );
+   Raid0Pattern pattern(512*1024, {1});
+   StatData statData(S_IFREG | 0644, 0, 0, 1);
+
+   FileInodeStoreData storeData(fileID, &statData, &pattern, FILEINODE_FEATURE_HAS_INLINE_DATA, 0,
+      "", FileInodeOrigFeature_TRUE);
+
+   std::unique_ptr<FileInode> inode(new FileInode(fileID, &storeData, DirEntryType_REGULARFILE,
+      0) );
+   inode->setIsInlinedUnlocked(false);
+
+   outEntryInfo = EntryInfo(NumNodeID(1), META_ROOTDIR_ID_STR, fileID, "file",
+      DirEntryType_REGULARFILE, 0);
+
+   EXPECT_TRUE(inode->updateInodeOnDisk(&outEntryInfo) );
+
+   return inode;
+}
+
+std::string readAll(FileInode& inode)
+{
+   std::string data;
+
+   EXPECT_EQ(inode.readInlineData(0, maxSize, data), FhgfsOpsErr_SUCCESS);
+
+   return data;
+}
+
+}
+
+TEST(FileInodeInlineData, writeAndRead)
+{
+   TestApp testApp({});
+
+   EntryInfo entryInfo;
+   std::unique_ptr<FileInode> inode = createInlineFile(entryInfo);
+
+   ASSERT_EQ(readAll(*inode), "");
+
+   ASSERT_EQ(inode->writeInlineData(&entryInfo, 0, "abcdef", 6, maxSize), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(inode->writeInlineData(&entryInfo, 2, "XY", 2, maxSize), FhgfsOpsErr_SUCCESS);
+
+   // a hole is filled with zeros
+   ASSERT_EQ(inode->writeInlineData(&entryInfo, 8, "gh", 2, maxSize), FhgfsOpsErr_SUCCESS);
+
+   ASSERT_EQ(readAll(*inode), std::string("abXYef\0\0gh", 10) );
+
+   std::string data;
+   ASSERT_EQ(inode->readInlineData(7, 2, data), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(data, std::string("\0g", 2) );
+
+   ASSERT_EQ(inode->readInlineData(20, 2, data), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(data, "");
+
+   StatData statData;
+   ASSERT_EQ(inode->getStatData(statData), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(statData.getFileSize(), 10);
+
+   // the data is stored with the inode
+   std::unique_ptr<FileInode> loadedInode(FileInode::createFromEntryInfo(&entryInfo) );
+   ASSERT_TRUE(loadedInode);
+   ASSERT_TRUE(loadedInode->getHasInlineData() );
+   ASSERT_EQ(readAll(*loadedInode), std::string("abXYef\0\0gh", 10) );
+
+   ASSERT_EQ(loadedInode->getStatData(statData), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(statData.getFileSize(), 10);
+}
+
+TEST(FileInodeInlineData, limit)
+{
+   TestApp testApp({});
+
+   EntryInfo entryInfo;
+   std::unique_ptr<FileInode> inode = createInlineFile(entryInfo);
+
+   ASSERT_EQ(inode->writeInlineData(&entryInfo, 0, "abcd", 4, maxSize), FhgfsOpsErr_SUCCESS);
+
+   // the caller has to move the data to the chunks, the inode stays unchanged
+   ASSERT_EQ(inode->writeInlineData(&entryInfo, maxSize - 1, "xy", 2, maxSize),
+      FhgfsOpsErr_TOOBIG);
+   ASSERT_EQ(inode->truncInlineData(&entryInfo, maxSize + 1, maxSize), FhgfsOpsErr_TOOBIG);
+
+   ASSERT_EQ(readAll(*inode), "abcd");
+}
+
+TEST(FileInodeInlineData, truncate)
+{
+   TestApp testApp({});
+
+   EntryInfo entryInfo;
+   std::unique_ptr<FileInode> inode = createInlineFile(entryInfo);
+
+   ASSERT_EQ(inode->writeInlineData(&entryInfo, 0, "abcdef", 6, maxSize), FhgfsOpsErr_SUCCESS);
+
+   ASSERT_EQ(inode->truncInlineData(&entryInfo, 3, maxSize), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(readAll(*inode), "abc");
+
+   ASSERT_EQ(inode->truncInlineData(&entryInfo, 5, maxSize), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(readAll(*inode), std::string("abc\0\0", 5) );
+
+   StatData statData;
+   ASSERT_EQ(inode->getStatData(statData), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(statData.getFileSize(), 5);
+}
+
+TEST(FileInodeInlineData, clear)
+{
+   TestApp testApp({});
+
+   EntryInfo entryInfo;
+   std::unique_ptr<FileInode> inode = createInlineFile(entryInfo);
+
+   ASSERT_EQ(inode->writeInlineData(&entryInfo, 0, "abc", 3, maxSize), FhgfsOpsErr_SUCCESS);
+
+   // modified while it was written to the chunks
+   ASSERT_EQ(inode->clearInlineData(&entryInfo, "ab"), FhgfsOpsErr_AGAIN);
+   ASSERT_TRUE(inode->getHasInlineData() );
+
+   ASSERT_EQ(inode->clearInlineData(&entryInfo, "abc"), FhgfsOpsErr_SUCCESS);
+   ASSERT_FALSE(inode->getHasInlineData() );
+
+   std::string data;
+   ASSERT_EQ(inode->readInlineData(0, maxSize, data), FhgfsOpsErr_NOTSUPP);
+   ASSERT_EQ(inode->writeInlineData(&entryInfo, 0, "x", 1, maxSize), FhgfsOpsErr_NOTSUPP);
+
+   // the size stays, it is now the size of the chunk files
+   StatData statData;
+   ASSERT_EQ(inode->getStatData(statData), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(statData.getFileSize(), 3);
+
+   std::unique_ptr<FileInode> loadedInode(FileInode::createFromEntryInfo(&entryInfo) );
+   ASSERT_TRUE(loadedInode);
+   ASSERT_FALSE(loadedInode->getHasInlineData() );
+}
+
+/**
+ * Small file write+read through the inline data msgs that a client sends to the meta server,
+ * compared to the local work that a storage target does for the same file in chunk file mode
+ * (create, write, read and unlink the chunk file). The round trips to the meta server for open and
+ * close are the same in both modes, but chunk files need one storage round trip per write, read
+ * and unlink in addition.
+ */
+TEST(FileInodeInlineData, DISABLED_benchmarkSmallFiles)
+{
+   const unsigned numFiles = 1000;
+   const size_t fileSize = 1024;
+
+   TestApp testApp({"tuneInlineFileDataMaxSize=2048"});
+   testApp.createMetaStore();
+
+   StandardSocket* endpointA;
+   StandardSocket* endpointB;
+
+   StandardSocket::createSocketPair(PF_UNIX, SOCK_STREAM, 0, &endpointA, &endpointB);
+
+   std::unique_ptr<StandardSocket> serverSock(endpointA);
+   std::unique_ptr<StandardSocket> clientSock(endpointB);
+
+   NetMessageFactory msgFactory;
+   std::vector<char> respBuf(NETMSG_MAX_MSG_SIZE);
+   HighResolutionStats stats;
+
+   // deserialize the msg like a worker does, process it and receive the response
+   auto process = [&] (NetMessage& msg, auto& outResp) {
+      auto incomingMsg = msgFactory.createFromBuf(MessagingTk::createMsgVec(msg) );
+
+      NetMessage::ResponseContext ctx(NULL, serverSock.get(), &respBuf[0], respBuf.size(),
+         &stats);
+
+      incomingMsg->processIncoming(ctx);
+
+      // (the response types are unknown to the server's msg factory)
+      auto recvBuf = MessagingTk::recvMsgBuf(*clientSock);
+
+      Deserializer des(&recvBuf[NETMSG_HEADER_LENGTH], recvBuf.size() - NETMSG_HEADER_LENGTH);
+      des % outResp;
+
+      return des.good();
+   };
+
+   const std::string data(fileSize, 'x');
+   std::vector<EntryInfo> entryInfos(numFiles);
+   unsigned numMetaRoundTrips = 0;
+
+   for (unsigned i = 0; i < numFiles; i++)
+      createInlineFile(entryInfos[i]);
+
+   Time startT;
+
+   for (unsigned i = 0; i < numFiles; i++)
+   {
+      WriteInlineFileMsg writeMsg(&entryInfos[i], 0, data.data(), data.size() );
+      WriteInlineFileRespMsg writeResp;
+      ASSERT_TRUE(process(writeMsg, writeResp) );
+      numMetaRoundTrips++;
+
+      ASSERT_EQ(writeResp.getResult(), FhgfsOpsErr_SUCCESS);
+
+      ReadInlineFileMsg readMsg(&entryInfos[i], 0, data.size() );
+      ReadInlineFileRespMsg readResp;
+      ASSERT_TRUE(process(readMsg, readResp) );
+      numMetaRoundTrips++;
+
+      ASSERT_EQ(readResp.getResult(), FhgfsOpsErr_SUCCESS);
+      ASSERT_EQ(readResp.getData(), data);
+   }
+
+   const unsigned inlineUS = startT.elapsedMicro();
+
+   // chunk file mode: what a storage target does for the same files
+
+   const std::string chunkDir = testApp.getApp()->getConfig()->getStoreMetaDirectory() +
+      "/benchmarkChunks";
+   ASSERT_TRUE(StorageTk::createPathOnDisk(Path(chunkDir), false) );
+
+   std::vector<char> readBuf(fileSize);
+
+   startT.setToNow();
+
+   for (unsigned i = 0; i < numFiles; i++)
+   {
+      const std::string chunkPath = chunkDir + "/" + entryInfos[i].getEntryID();
+
+      int fd = open(chunkPath.c_str(), O_CREAT | O_WRONLY, 0644);
+      ASSERT_GE(fd, 0);
+      ASSERT_EQ(pwrite(fd, data.data(), data.size(), 0), ssize_t(data.size() ) );
+      close(fd);
+
+      fd = open(chunkPath.c_str(), O_RDONLY);
+      ASSERT_GE(fd, 0);
+      ASSERT_EQ(pread(fd, &readBuf[0], readBuf.size(), 0), ssize_t(readBuf.size() ) );
+      close(fd);
+
+      ASSERT_EQ(unlink(chunkPath.c_str() ), 0);
+   }
+
+   const unsigned chunkFileUS = startT.elapsedMicro();
+
+   std::cout << "files: " << numFiles << "; size: " << fileSize << "; " <<
+      "inline: " << inlineUS / numFiles << "us/file (" << numMetaRoundTrips / numFiles <<
+         " meta round trips/file, no storage round trips); " <<
+      "chunk files: " << chunkFileUS / numFiles << "us/file for the target's local file IO only " <<
+         "(+3 storage round trips/file for write, read and unlink)" << std::endl;
+}
@@ -0,0 +1,292 @@
+#include <common/net/message/fsck/StreamFsckDirEntriesRespMsg.h>
+#include <common/net/sock/StandardSocket.h>
+#include <common/storage/Metadata.h>
+#include <common/toolkit/MessagingTk.h>
+#include <common/toolkit/StorageTk.h>
+#include <components/FsckDirEntryExporter.h>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <thread>
+
+
+/**
+ * Exporter that doesn't read the meta store, but generates the content dirs of each hash dir and
+ * the entry names of each content dir, so that the test knows which entries have to arrive.
+ *
+ * Every second entry of a content dir is a file with an inlined inode.
+ */
+class GeneratedDirEntriesExporter : public FsckDirEntryExporter
+{
+   public:
+      GeneratedDirEntriesExporter(Socket* sock, unsigned hashDirStart, unsigned hashDirEnd) :
+         FsckDirEntryExporter(sock, hashDirStart, hashDirEnd, false, NumNodeID(1), 0)
+      {}
+
+      static unsigned numContDirs(unsigned firstLevelHashDir, unsigned secondLevelHashDir)
+      {
+         return (firstLevelHashDir + secondLevelHashDir) % 3;
+      }
+
+      static std::string contDirID(unsigned firstLevelHashDir, unsigned secondLevelHashDir,
+         unsigned index)
+      {
+         return "C" + StringTk::uintToStr(firstLevelHashDir) + "-" +
+            StringTk::uintToStr(secondLevelHashDir) + "-" + StringTk::uintToStr(index);
+      }
+
+      static unsigned numEntries(const std::string& contDirID)
+      {
+         // one content dir needs several batches
+         if (contDirID == "C3-5-1")
+            return 2 * STREAMFSCKDIRENTRIES_BATCH_SIZE + 7;
+
+         return contDirID.size() % 4;
+      }
+
+      static std::string entryName(unsigned index)
+      {
+         return "file" + StringTk::uintToStr(index);
+      }
+
+      static std::string entryID(const std::string& contDirID, const std::string& name)
+      {
+         return contDirID + "/" + name;
+      }
+
+      std::string failingContDirID;
+
+   protected:
+      FhgfsOpsErr readContDirIDs(unsigned hashDirNum, StringList& outContDirIDs) override
+      {
+         unsigned firstLevelHashDir;
+         unsigned secondLevelHashDir;
+
+         StorageTk::splitHashDirs(hashDirNum, &firstLevelHashDir, &secondLevelHashDir);
+
+         for (unsigned i = 0; i < numContDirs(firstLevelHashDir, secondLevelHashDir); i++)
+            outContDirIDs.push_back(contDirID(firstLevelHashDir, secondLevelHashDir, i) );
+
+         return FhgfsOpsErr_SUCCESS;
+      }
+
+      FhgfsOpsErr readDirEntryNames(const std::string& contDirID, StringList& outNames) override
+      {
+         if (contDirID == failingContDirID)
+            return FhgfsOpsErr_INTERNAL;
+
+         for (unsigned i = 0; i < numEntries(contDirID); i++)
+            outNames.push_back(entryName(i) );
+
+         return FhgfsOpsErr_SUCCESS;
+      }
+
+      void readDirEntries(const std::string& contDirID, StringListConstIter start,
+         StringListConstIter end, FsckDirEntryList& outDirEntries,
+         FsckFileInodeList& outInlinedFileInodes) override
+      {
+         unsigned index = 0;
+
+         for (auto iter = start; iter != end; iter++, index++)
+         {
+            const std::string id = entryID(contDirID, *iter);
+            const bool hasInlinedInode = index % 2;
+
+            outDirEntries.push_back(FsckDirEntry(id, *iter, contDirID, NumNodeID(1),
+               NumNodeID(1), FsckDirEntryType_REGULARFILE, hasInlinedInode, NumNodeID(1), 0, 0,
+               false) );
+
+            if (hasInlinedInode)
+               outInlinedFileInodes.push_back(FsckFileInode(id, contDirID, NumNodeID(1),
+                  PathInfo(), 0, 0, 0, 1, 0, {}, FsckStripePatternType_RAID0, 0, NumNodeID(1), 0,
+                  0, true, false, true, false) );
+         }
+      }
+};
+
+class TestFsckDirEntryExporter : public ::testing::Test
+{
+   protected:
+      std::unique_ptr<StandardSocket> sender;
+      std::unique_ptr<StandardSocket> receiver;
+
+      struct Received
+      {
+         std::map<std::string, unsigned> numContDirs;
+         std::map<std::string, unsigned> numDirEntries;
+         std::map<std::string, unsigned> numInlinedFileInodes;
+      };
+
+      void SetUp() override
+      {
+         StandardSocket* endpointA;
+         StandardSocket* endpointB;
+
+         StandardSocket::createSocketPair(PF_UNIX, SOCK_STREAM, 0, &endpointA, &endpointB);
+
+         sender.reset(endpointA);
+         receiver.reset(endpointB);
+      }
+
+      /**
+       * Run the exporter and send the final message like StreamFsckDirEntriesMsgEx does.
+       */
+      static void exportAll(GeneratedDirEntriesExporter& exporter, Socket& sock,
+         unsigned numThreads)
+      {
+         FsckContDirList noContDirs;
+         FsckDirEntryList noDirEntries;
+         FsckFileInodeList noInlinedFileInodes;
+
+         FhgfsOpsErr exportRes = exporter.run(numThreads);
+
+         StreamFsckDirEntriesRespMsg lastMsg(&noContDirs, &noDirEntries, &noInlinedFileInodes,
+            true, exportRes);
+
+         const auto sendBuf = MessagingTk::createMsgVec(lastMsg);
+         sock.send(&sendBuf[0], sendBuf.size(), 0);
+      }
+
+      /**
+       * Receive the stream until the final message (like RetrieveDirEntriesWork does) and count
+       * how often each content dir, entry and inlined inode was received.
+       *
+       * @return result of the final message
+       */
+      FhgfsOpsErr receiveAll(Received& outReceived)
+      {
+         while (true)
+         {
+            std::vector<char> buf(NETMSG_HEADER_LENGTH);
+
+            receiver->recvExactT(&buf[0], NETMSG_HEADER_LENGTH, 0, 10000);
+
+            buf.resize(NetMessageHeader::extractMsgLengthFromBuf(&buf[0], buf.size() ) );
+            receiver->recvExactT(&buf[NETMSG_HEADER_LENGTH], buf.size() - NETMSG_HEADER_LENGTH,
+               0, 10000);
+
+            StreamFsckDirEntriesRespMsg msg;
+
+            Deserializer des(&buf[NETMSG_HEADER_LENGTH], buf.size() - NETMSG_HEADER_LENGTH);
+            StreamFsckDirEntriesRespMsg::serialize(&msg, des);
+            EXPECT_TRUE(des.good() );
+
+            EXPECT_LE(msg.getDirEntries().size(), size_t(STREAMFSCKDIRENTRIES_BATCH_SIZE) );
+            EXPECT_LE(msg.getContDirs().size(), size_t(STREAMFSCKDIRENTRIES_BATCH_SIZE) );
+
+            for (auto iter = msg.getContDirs().begin(); iter != msg.getContDirs().end(); iter++)
+               outReceived.numContDirs[iter->getID()]++;
+
+            for (auto iter = msg.getDirEntries().begin(); iter != msg.getDirEntries().end();
+               iter++)
+            {
+               // the content dir of an entry is sent before or together with the entry
+               EXPECT_EQ(outReceived.numContDirs.count(iter->getParentDirID() ), 1u);
+
+               outReceived.numDirEntries[iter->getID()]++;
+            }
+
+            for (auto iter = msg.getInlinedFileInodes().begin();
+               iter != msg.getInlinedFileInodes().end(); iter++)
+               outReceived.numInlinedFileInodes[iter->getID()]++;
+
+            if (msg.getIsLast() )
+               return msg.getResult();
+         }
+      }
+};
+
+TEST_F(TestFsckDirEntryExporter, allDirEntriesOnce)
+{
+   const unsigned hashDirStart = 2;
+   const unsigned hashDirEnd = 6;
+
+   for (unsigned numThreads : {1u, 3u, 16u})
+   {
+      GeneratedDirEntriesExporter exporter(sender.get(), hashDirStart, hashDirEnd);
+
+      std::thread exportThread(exportAll, std::ref(exporter), std::ref(*sender), numThreads);
+
+      Received received;
+      FhgfsOpsErr result = receiveAll(received);
+
+      exportThread.join();
+
+      ASSERT_EQ(result, FhgfsOpsErr_SUCCESS);
+
+      size_t numContDirsExpected = 0;
+      size_t numDirEntriesExpected = 0;
+
+      for (unsigned l1 = hashDirStart; l1 <= hashDirEnd; l1++)
+      {
+         for (unsigned l2 = 0; l2 < META_DENTRIES_LEVEL2_SUBDIR_NUM; l2++)
+         {
+            for (unsigned c = 0; c < GeneratedDirEntriesExporter::numContDirs(l1, l2); c++)
+            {
+               const std::string contDirID = GeneratedDirEntriesExporter::contDirID(l1, l2, c);
+
+               ASSERT_EQ(received.numContDirs[contDirID], 1u) << numThreads;
+               numContDirsExpected++;
+
+               for (unsigned i = 0; i < GeneratedDirEntriesExporter::numEntries(contDirID); i++)
+               {
+                  const std::string id = GeneratedDirEntriesExporter::entryID(contDirID,
+                     GeneratedDirEntriesExporter::entryName(i) );
+
+                  ASSERT_EQ(received.numDirEntries[id], 1u) << numThreads;
+                  numDirEntriesExpected++;
+               }
+            }
+         }
+      }
+
+      // nothing outside of the range
+      ASSERT_EQ(received.numContDirs.size(), numContDirsExpected);
+      ASSERT_EQ(received.numDirEntries.size(), numDirEntriesExpected);
+
+      // each inlined inode once, with its dentry
+      for (auto iter = received.numInlinedFileInodes.begin();
+         iter != received.numInlinedFileInodes.end(); iter++)
+      {
+         ASSERT_EQ(iter->second, 1u);
+         ASSERT_EQ(received.numDirEntries.count(iter->first), 1u);
+      }
+
+      ASSERT_FALSE(received.numInlinedFileInodes.empty() );
+   }
+}
+
+TEST_F(TestFsckDirEntryExporter, readErrorDoesNotStopExport)
+{
+   GeneratedDirEntriesExporter exporter(sender.get(), 3, 4);
+   exporter.failingContDirID = "C4-10-0";
+
+   std::thread exportThread(exportAll, std::ref(exporter), std::ref(*sender), 2);
+
+   Received received;
+   FhgfsOpsErr result = receiveAll(received);
+
+   exportThread.join();
+
+   ASSERT_EQ(result, FhgfsOpsErr_INTERNAL);
+
+   // the content dir itself is still known to fsck
+   ASSERT_EQ(received.numContDirs["C4-10-0"], 1u);
+   ASSERT_EQ(received.numDirEntries.count(
+      GeneratedDirEntriesExporter::entryID("C4-10-0", "file0") ), 0u);
+
+   ASSERT_EQ(received.numDirEntries[GeneratedDirEntriesExporter::entryID("C4-10-1", "file0")],
+      1u);
+   ASSERT_EQ(received.numDirEntries[GeneratedDirEntriesExporter::entryID("C3-5-1", "file2000")],
+      1u);
+}
+
+TEST_F(TestFsckDirEntryExporter, brokenStream)
+{
+   GeneratedDirEntriesExporter exporter(sender.get(), 0, 3);
+
+   receiver.reset();
+
+   ASSERT_EQ(exporter.run(4), FhgfsOpsErr_COMMUNICATION);
+}
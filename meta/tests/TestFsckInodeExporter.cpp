@@ -0,0 +1,235 @@
+#include <common/net/message/fsck/StreamFsckInodesRespMsg.h>
+#include <common/net/sock/StandardSocket.h>
+#include <common/storage/Metadata.h>
+#include <common/toolkit/MessagingTk.h>
+#include <components/FsckInodeExporter.h>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <thread>
+
+
+/**
+ * Exporter that doesn't read the meta store, but generates the entry IDs of each hash dir, so
+ * that the test knows which inodes have to arrive.
+ *
+ * Entry IDs starting with "D" are dir inodes, all others are file inodes.
+ */
+class GeneratedInodesExporter : public FsckInodeExporter
+{
+   public:
+      GeneratedInodesExporter(Socket* sock, unsigned hashDirStart, unsigned hashDirEnd) :
+         FsckInodeExporter(sock, hashDirStart, hashDirEnd, false)
+      {}
+
+      static unsigned numEntries(unsigned firstLevelHashDir, unsigned secondLevelHashDir)
+      {
+         // one hash dir needs several batches
+         if (firstLevelHashDir == 3 && secondLevelHashDir == 5)
+            return 2 * STREAMFSCKINODES_BATCH_SIZE + 7;
+
+         return (firstLevelHashDir + secondLevelHashDir) % 4;
+      }
+
+      static std::string entryID(unsigned firstLevelHashDir, unsigned secondLevelHashDir,
+         unsigned index)
+      {
+         return std::string(index % 2 ? "D" : "F") + StringTk::uintToStr(firstLevelHashDir) +
+            "-" + StringTk::uintToStr(secondLevelHashDir) + "-" + StringTk::uintToStr(index);
+      }
+
+      unsigned failingFirstLevelHashDir = ~0u;
+      unsigned failingSecondLevelHashDir = ~0u;
+
+   protected:
+      FhgfsOpsErr readEntryIDs(unsigned firstLevelHashDir, unsigned secondLevelHashDir,
+         StringList& outEntryIDs) override
+      {
+         if (firstLevelHashDir == failingFirstLevelHashDir &&
+            secondLevelHashDir == failingSecondLevelHashDir)
+            return FhgfsOpsErr_INTERNAL;
+
+         for (unsigned i = 0; i < numEntries(firstLevelHashDir, secondLevelHashDir); i++)
+            outEntryIDs.push_back(entryID(firstLevelHashDir, secondLevelHashDir, i) );
+
+         return FhgfsOpsErr_SUCCESS;
+      }
+
+      void readInodes(StringListConstIter start, StringListConstIter end,
+         FsckDirInodeList& outDirInodes, FsckFileInodeList& outFileInodes) override
+      {
+         for (auto iter = start; iter != end; iter++)
+         {
+            if ( (*iter)[0] == 'D')
+               outDirInodes.push_back(FsckDirInode(*iter, "parent", NumNodeID(1), NumNodeID(1),
+                  0, 2, {}, FsckStripePatternType_RAID0, NumNodeID(1), false, true, false) );
+            else
+               outFileInodes.push_back(FsckFileInode(*iter, "parent", NumNodeID(1), PathInfo(),
+                  0, 0, 0, 1, 0, {}, FsckStripePatternType_RAID0, 0, NumNodeID(1), 0, 0, false,
+                  false, true, false) );
+         }
+      }
+};
+
+class TestFsckInodeExporter : public ::testing::Test
+{
+   protected:
+      std::unique_ptr<StandardSocket> sender;
+      std::unique_ptr<StandardSocket> receiver;
+
+      void SetUp() override
+      {
+         StandardSocket* endpointA;
+         StandardSocket* endpointB;
+
+         StandardSocket::createSocketPair(PF_UNIX, SOCK_STREAM, 0, &endpointA, &endpointB);
+
+         sender.reset(endpointA);
+         receiver.reset(endpointB);
+      }
+
+      /**
+       * Run the exporter and send the final message like StreamFsckInodesMsgEx does.
+       */
+      static void exportAll(GeneratedInodesExporter& exporter, Socket& sock, unsigned numThreads)
+      {
+         FsckFileInodeList noFileInodes;
+         FsckDirInodeList noDirInodes;
+
+         FhgfsOpsErr exportRes = exporter.run(numThreads);
+
+         StreamFsckInodesRespMsg lastMsg(&noFileInodes, &noDirInodes, true, exportRes);
+
+         const auto sendBuf = MessagingTk::createMsgVec(lastMsg);
+         sock.send(&sendBuf[0], sendBuf.size(), 0);
+      }
+
+      /**
+       * Receive the stream until the final message (like RetrieveInodesWork does) and count how
+       * often each entry ID was received.
+       *
+       * @return result of the final message
+       */
+      FhgfsOpsErr receiveAll(std::map<std::string, unsigned>& outNumReceived)
+      {
+         while (true)
+         {
+            std::vector<char> buf(NETMSG_HEADER_LENGTH);
+
+            receiver->recvExactT(&buf[0], NETMSG_HEADER_LENGTH, 0, 10000);
+
+            buf.resize(NetMessageHeader::extractMsgLengthFromBuf(&buf[0], buf.size() ) );
+            receiver->recvExactT(&buf[NETMSG_HEADER_LENGTH], buf.size() - NETMSG_HEADER_LENGTH,
+               0, 10000);
+
+            StreamFsckInodesRespMsg msg;
+
+            Deserializer des(&buf[NETMSG_HEADER_LENGTH], buf.size() - NETMSG_HEADER_LENGTH);
+            StreamFsckInodesRespMsg::serialize(&msg, des);
+            EXPECT_TRUE(des.good() );
+
+            EXPECT_LE(msg.getFileInodes().size() + msg.getDirInodes().size(),
+               size_t(STREAMFSCKINODES_BATCH_SIZE) );
+
+            for (auto iter = msg.getFileInodes().begin(); iter != msg.getFileInodes().end(); iter++)
+               outNumReceived[iter->getID()]++;
+
+            for (auto iter = msg.getDirInodes().begin(); iter != msg.getDirInodes().end(); iter++)
+               outNumReceived[iter->getID()]++;
+
+            if (msg.getIsLast() )
+               return msg.getResult();
+         }
+      }
+};
+
+TEST_F(TestFsckInodeExporter, allInodesOnce)
+{
+   const unsigned hashDirStart = 2;
+   const unsigned hashDirEnd = 6;
+
+   for (unsigned numThreads : {1u, 3u, 16u})
+   {
+      GeneratedInodesExporter exporter(sender.get(), hashDirStart, hashDirEnd);
+
+      std::thread exportThread(exportAll, std::ref(exporter), std::ref(*sender), numThreads);
+
+      std::map<std::string, unsigned> numReceived;
+      FhgfsOpsErr result = receiveAll(numReceived);
+
+      exportThread.join();
+
+      ASSERT_EQ(result, FhgfsOpsErr_SUCCESS);
+
+      size_t numExpected = 0;
+
+      for (unsigned l1 = hashDirStart; l1 <= hashDirEnd; l1++)
+      {
+         for (unsigned l2 = 0; l2 < META_INODES_LEVEL2_SUBDIR_NUM; l2++)
+         {
+            for (unsigned i = 0; i < GeneratedInodesExporter::numEntries(l1, l2); i++)
+            {
+               ASSERT_EQ(numReceived[GeneratedInodesExporter::entryID(l1, l2, i)], 1u)
+                  << numThreads;
+               numExpected++;
+            }
+         }
+      }
+
+      // nothing outside of the range
+      ASSERT_EQ(numReceived.size(), numExpected);
+   }
+}
+
+TEST_F(TestFsckInodeExporter, readErrorDoesNotStopExport)
+{
+   GeneratedInodesExporter exporter(sender.get(), 3, 4);
+   exporter.failingFirstLevelHashDir = 4;
+   exporter.failingSecondLevelHashDir = 9;
+
+   std::thread exportThread(exportAll, std::ref(exporter), std::ref(*sender), 2);
+
+   std::map<std::string, unsigned> numReceived;
+   FhgfsOpsErr result = receiveAll(numReceived);
+
+   exportThread.join();
+
+   ASSERT_EQ(result, FhgfsOpsErr_INTERNAL);
+
+   ASSERT_EQ(numReceived.count(GeneratedInodesExporter::entryID(4, 9, 0) ), 0u);
+   ASSERT_EQ(numReceived[GeneratedInodesExporter::entryID(4, 10, 1)], 1u);
+   ASSERT_EQ(numReceived[GeneratedInodesExporter::entryID(3, 5, 2000)], 1u);
+}
+
+TEST_F(TestFsckInodeExporter, brokenStream)
+{
+   GeneratedInodesExporter exporter(sender.get(), 0, 3);
+
+   receiver.reset();
+
+   ASSERT_EQ(exporter.run(4), FhgfsOpsErr_COMMUNICATION);
+}
+
+TEST(FsckInodeExporter, streamSlots)
+{
+   std::unique_ptr<FsckInodeExporter::StreamSlot> first(new FsckInodeExporter::StreamSlot(2) );
+   FsckInodeExporter::StreamSlot second(2);
+
+   ASSERT_TRUE(first->isAcquired() );
+   ASSERT_TRUE(second.isAcquired() );
+
+   {
+      FsckInodeExporter::StreamSlot third(2);
+      ASSERT_FALSE(third.isAcquired() );
+   }
+
+   // a rejected slot doesn't free anything
+   FsckInodeExporter::StreamSlot fourth(2);
+   ASSERT_FALSE(fourth.isAcquired() );
+
+   first.reset();
+
+   FsckInodeExporter::StreamSlot fifth(2);
+   ASSERT_TRUE(fifth.isAcquired() );
+}
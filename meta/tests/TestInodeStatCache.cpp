@@ -0,0 +1,104 @@
+#include <storage/InodeStatCache.h>
+
+#include <gtest/gtest.h>
+
+
+static EntryInfo fileInfo(const std::string& parentID, const std::string& entryID)
+{
+   return EntryInfo(NumNodeID(1), parentID, entryID, entryID, DirEntryType_REGULARFILE, 0);
+}
+
+static StatData statWithSize(int64_t fileSize)
+{
+   StatData statData;
+   statData.setFileSize(fileSize);
+   return statData;
+}
+
+TEST(InodeStatCache, hitAfterPut)
+{
+   InodeStatCache cache(1024);
+   EntryInfo info = fileInfo("parent", "file");
+   StatData statData;
+   uint64_t generation;
+
+   ASSERT_FALSE(cache.get(&info, statData, generation) );
+
+   cache.put(&info, statWithSize(42), generation);
+
+   ASSERT_TRUE(cache.get(&info, statData, generation) );
+   ASSERT_EQ(statData.getFileSize(), 42);
+
+   // inlined inodes live in the parent's dentries, so another parent must not hit
+   EntryInfo movedInfo = fileInfo("otherParent", "file");
+   ASSERT_FALSE(cache.get(&movedInfo, statData, generation) );
+
+   InodeStatCacheStats stats = cache.getStats();
+
+   ASSERT_EQ(stats.numHits, 1u);
+   ASSERT_EQ(stats.numMisses, 2u);
+   ASSERT_EQ(stats.numEntries, 1u);
+}
+
+TEST(InodeStatCache, invalidate)
+{
+   InodeStatCache cache(1024);
+   EntryInfo info = fileInfo("parent", "file");
+   StatData statData;
+   uint64_t generation;
+
+   cache.get(&info, statData, generation);
+   cache.put(&info, statWithSize(1), generation);
+
+   cache.invalidate("file");
+   ASSERT_FALSE(cache.get(&info, statData, generation) );
+
+   cache.put(&info, statWithSize(2), generation);
+   cache.invalidateAll();
+   ASSERT_FALSE(cache.get(&info, statData, generation) );
+
+   ASSERT_EQ(cache.getStats().numInvalidations, 1u);
+}
+
+/*
+ * A stat that read the inode from disk before a concurrent update must not insert its (outdated)
+ * data after the update invalidated the entry.
+ */
+TEST(InodeStatCache, putAfterInvalidationIsDropped)
+{
+   InodeStatCache cache(1024);
+   EntryInfo info = fileInfo("parent", "file");
+   StatData statData;
+   uint64_t generation;
+
+   ASSERT_FALSE(cache.get(&info, statData, generation) );
+
+   cache.invalidate("file"); // concurrent update
+
+   cache.put(&info, statWithSize(1), generation);
+
+   ASSERT_FALSE(cache.get(&info, statData, generation) );
+}
+
+TEST(InodeStatCache, bounded)
+{
+   const size_t maxEntries = 256;
+
+   InodeStatCache cache(maxEntries);
+   StatData statData;
+   uint64_t generation;
+
+   for (unsigned i = 0; i < 10 * maxEntries; i++)
+   {
+      EntryInfo info = fileInfo("parent", "file" + std::to_string(i) );
+
+      cache.get(&info, statData, generation);
+      cache.put(&info, statWithSize(i), generation);
+   }
+
+   ASSERT_LE(cache.getStats().numEntries, maxEntries);
+
+   // the most recently added entry is still cached
+   EntryInfo lastInfo = fileInfo("parent", "file" + std::to_string(10 * maxEntries - 1) );
+   ASSERT_TRUE(cache.get(&lastInfo, statData, generation) );
+}
@@ -0,0 +1,159 @@
+#include <common/toolkit/Time.h>
+#include <toolkit/MirrorForwardBatcher.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+
+/**
+ * Batcher that doesn't communicate, but simulates the round trip time to the secondary.
+ *
+ * The result of a request is derived from its respMsgType, so that tests can check that every
+ * request gets its own result.
+ */
+class SimulatedRTTBatcher : public MirrorForwardBatcher
+{
+   public:
+      SimulatedRTTBatcher(unsigned maxBatchSize, unsigned maxInFlightBatches, unsigned rttUS) :
+         MirrorForwardBatcher(maxBatchSize, 0, maxInFlightBatches), rttUS(rttUS),
+         numBatches(0), numInFlight(0), maxInFlight(0)
+      {}
+
+      FhgfsOpsErr forward(NumNodeID nodeID, RequestResponseArgs* rrArgs)
+      {
+         return requestResponseBatched(nodeID, NULL, rrArgs);
+      }
+
+      static FhgfsOpsErr expectedResult(const RequestResponseArgs& rrArgs)
+      {
+         return (rrArgs.respMsgType % 2) ? FhgfsOpsErr_SUCCESS : FhgfsOpsErr_EXISTS;
+      }
+
+      const unsigned rttUS;
+
+      std::atomic<unsigned> numBatches;
+      std::atomic<unsigned> numInFlight;
+      std::atomic<unsigned> maxInFlight;
+
+   protected:
+      void sendBatch(NumNodeID nodeID, NodeStoreServers* nodeStore,
+         std::vector<RequestResponseArgs*>& batch, std::vector<FhgfsOpsErr>& outResults) override
+      {
+         unsigned inFlight = ++numInFlight;
+         unsigned prevMax = maxInFlight;
+
+         while( (inFlight > prevMax) && !maxInFlight.compare_exchange_weak(prevMax, inFlight) )
+         { } // (prevMax is updated by compare_exchange)
+
+         numBatches++;
+
+         if(rttUS)
+            ::usleep(rttUS);
+
+         for(auto iter = batch.begin(); iter != batch.end(); iter++)
+            outResults.push_back(expectedResult(**iter) );
+
+         numInFlight--;
+      }
+};
+
+/**
+ * Runs numThreads threads that forward numOpsPerThread requests each.
+ *
+ * @return elapsed time in ms.
+ */
+static unsigned runForwardThreads(SimulatedRTTBatcher* batcher, unsigned numThreads,
+   unsigned numOpsPerThread, std::atomic<unsigned>& numWrongResults)
+{
+   std::vector<std::thread> threads;
+
+   Time startTime;
+
+   for(unsigned t = 0; t < numThreads; t++)
+   {
+      threads.emplace_back([=, &numWrongResults] () {
+         for(unsigned i = 0; i < numOpsPerThread; i++)
+         {
+            RequestResponseArgs rrArgs(NULL, NULL, t * numOpsPerThread + i);
+
+            FhgfsOpsErr res;
+
+            if(batcher)
+               res = batcher->forward(NumNodeID(1 + (t % 2) ), &rrArgs);
+            else
+               res = SimulatedRTTBatcher::expectedResult(rrArgs); // unmirrored: no forward
+
+            if(res != SimulatedRTTBatcher::expectedResult(rrArgs) )
+               numWrongResults++;
+         }
+      });
+   }
+
+   for(auto iter = threads.begin(); iter != threads.end(); iter++)
+      iter->join();
+
+   return startTime.elapsedMS();
+}
+
+TEST(MirrorForwardBatcher, everyRequestGetsItsResult)
+{
+   const unsigned numThreads = 16;
+   const unsigned numOpsPerThread = 500;
+
+   SimulatedRTTBatcher batcher(8, 2, 100);
+   std::atomic<unsigned> numWrongResults(0);
+
+   runForwardThreads(&batcher, numThreads, numOpsPerThread, numWrongResults);
+
+   ASSERT_EQ(numWrongResults, 0u);
+   ASSERT_LE(batcher.maxInFlight, 2u);
+   ASSERT_LT(batcher.numBatches, numThreads * numOpsPerThread);
+}
+
+TEST(MirrorForwardBatcher, singleRequestIsNotDelayed)
+{
+   SimulatedRTTBatcher batcher(32, 1, 0);
+   RequestResponseArgs rrArgs(NULL, NULL, 1);
+
+   ASSERT_EQ(batcher.forward(NumNodeID(1), &rrArgs), FhgfsOpsErr_SUCCESS);
+   ASSERT_EQ(batcher.numBatches, 1u);
+}
+
+/*
+ * Compares the op rate of concurrent workers without mirroring, with one forward round trip per op
+ * (batch size 1) and with batched forwarding, for a simulated round trip time to the secondary.
+ * The number of concurrent round trips is limited in both cases, like the number of connections
+ * to the secondary. Only the round trip is simulated, not the processing on the secondary, so
+ * this is the upper bound of what pipelining saves. Disabled by default, because it only prints
+ * timings.
+ */
+TEST(MirrorForwardBatcher, DISABLED_benchmarkSimulatedRTT)
+{
+   const unsigned numThreads = 32;
+   const unsigned numOpsPerThread = 200;
+   const unsigned rttUS = 200;
+   const unsigned maxInFlight = 8;
+   const unsigned numOps = numThreads * numOpsPerThread;
+
+   std::atomic<unsigned> numWrongResults(0);
+
+   unsigned unmirroredMS = runForwardThreads(NULL, numThreads, numOpsPerThread, numWrongResults);
+
+   // unbatched: every op needs its own round trip
+   SimulatedRTTBatcher unbatched(1, maxInFlight, rttUS);
+   unsigned unbatchedMS = runForwardThreads(&unbatched, numThreads, numOpsPerThread,
+      numWrongResults);
+
+   SimulatedRTTBatcher batched(32, maxInFlight, rttUS);
+   unsigned batchedMS = runForwardThreads(&batched, numThreads, numOpsPerThread, numWrongResults);
+
+   ASSERT_EQ(numWrongResults, 0u);
+
+   std::cout << "ops: " << numOps << "; threads: " << numThreads << "; rtt: " << rttUS << "us; " <<
+      "unmirrored: " << unmirroredMS << "ms; " <<
+      "unbatched: " << unbatchedMS << "ms (" << unbatched.numBatches << " round trips); " <<
+      "batched: " << batchedMS << "ms (" << batched.numBatches << " round trips)" << std::endl;
+}
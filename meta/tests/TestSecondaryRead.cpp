@@ -0,0 +1,190 @@
+#include <common/net/message/control/GenericResponseMsg.h>
+#include <common/net/message/session/AckNotifyMsg.h>
+#include <common/net/message/storage/attribs/StatMsg.h>
+#include <common/net/message/storage/attribs/StatRespMsg.h>
+#include <common/net/sock/StandardSocket.h>
+#include <common/toolkit/MessagingTk.h>
+#include <net/message/NetMessageFactory.h>
+#include <program/Program.h>
+
+#include "TestApp.h"
+
+#include <gtest/gtest.h>
+
+
+/**
+ * Read-only requests that a client sends to the secondary of a buddy group directly (see
+ * MirroredMessage::processSecondaryRead() ). The local node (ID 1) is the secondary of meta buddy
+ * group 1, the primary is node 2.
+ */
+class TestSecondaryRead : public ::testing::Test
+{
+   protected:
+      static const uint16_t BUDDY_GROUP_ID = 1;
+      static const NumNodeID CLIENT_ID;
+
+      std::unique_ptr<TestApp> testApp;
+
+      std::unique_ptr<StandardSocket> serverSock;
+      std::unique_ptr<StandardSocket> clientSock;
+
+      void initApp(bool secondaryServesReads)
+      {
+         testApp.reset(new TestApp({
+            std::string("tuneSecondaryServesReads=") + (secondaryServesReads ? "true" : "false")
+         }) );
+
+         App* app = testApp->getApp();
+
+         ASSERT_EQ(FhgfsOpsErr_SUCCESS, app->getMetaBuddyGroupMapper()->mapMirrorBuddyGroup(
+            BUDDY_GROUP_ID, 2, 1, app->getLocalNodeNumID(), true, NULL) );
+
+         app->getMetaStateStore()->addIfNotExists(1, CombinedTargetState(
+            TargetReachabilityState_ONLINE, TargetConsistencyState_GOOD) );
+
+         testApp->createRootDir(NumNodeID(BUDDY_GROUP_ID), true);
+
+         StandardSocket* endpointA;
+         StandardSocket* endpointB;
+
+         StandardSocket::createSocketPair(PF_UNIX, SOCK_STREAM, 0, &endpointA, &endpointB);
+
+         serverSock.reset(endpointA);
+         clientSock.reset(endpointB);
+
+         serverSock->setNodeID(CLIENT_ID);
+      }
+
+      void TearDown() override
+      {
+         serverSock.reset();
+         clientSock.reset();
+         testApp.reset();
+      }
+
+      /**
+       * Deserialize the msg like a worker does, process it and receive the response.
+       */
+      std::unique_ptr<NetMessage> process(NetMessage& msg)
+      {
+         NetMessageFactory msgFactory;
+
+         auto incomingMsg = msgFactory.createFromBuf(MessagingTk::createMsgVec(msg) );
+         if (!incomingMsg)
+            return {};
+
+         std::vector<char> respBuf(NETMSG_MAX_MSG_SIZE);
+         HighResolutionStats stats;
+
+         NetMessage::ResponseContext ctx(NULL, serverSock.get(), &respBuf[0], respBuf.size(),
+            &stats);
+
+         incomingMsg->processIncoming(ctx);
+
+         return msgFactory.createFromBuf(MessagingTk::recvMsgBuf(*clientSock) );
+      }
+
+      /**
+       * Apply a client request with the given sequence number like the primary forwards it
+       * (here: the ACK of a request that didn't change anything).
+       */
+      void applyForwarded(uint64_t seqNo)
+      {
+         AckNotifiyMsg msg;
+
+         msg.addFlag(NetMessageHeader::Flag_BuddyMirrorSecond);
+         msg.addFlag(NetMessageHeader::Flag_HasSequenceNumber);
+         msg.setSequenceNumber(seqNo);
+         msg.setSequenceNumberDone(seqNo - 1);
+         msg.setRequestorID({NODETYPE_Client, CLIENT_ID});
+
+         auto resp = process(msg);
+
+         ASSERT_TRUE(resp);
+         ASSERT_EQ(NETMSGTYPE_AckNotifyResp, resp->getMsgType() );
+      }
+
+      /**
+       * Stat the root dir from the secondary like a client that has received responses for all
+       * its mirrored requests up to seqNoWatermark.
+       */
+      std::unique_ptr<NetMessage> statRootFromSecondary(uint64_t seqNoWatermark)
+      {
+         EntryInfo rootInfo(NumNodeID(BUDDY_GROUP_ID), "", META_ROOTDIR_ID_STR,
+            META_ROOTDIR_ID_STR, DirEntryType_DIRECTORY, ENTRYINFO_FEATURE_BUDDYMIRRORED);
+
+         StatMsg msg(&rootInfo);
+
+         msg.addFlag(NetMessageHeader::Flag_ReadFromSecondary);
+         msg.setSequenceNumberDone(seqNoWatermark);
+
+         return process(msg);
+      }
+
+      static void expectServed(const std::unique_ptr<NetMessage>& resp)
+      {
+         ASSERT_TRUE(resp);
+         ASSERT_EQ(NETMSGTYPE_StatResp, resp->getMsgType() );
+         EXPECT_EQ(FhgfsOpsErr_SUCCESS,
+            (FhgfsOpsErr) static_cast<StatRespMsg&>(*resp).getResult() );
+      }
+
+      static void expectRedirected(const std::unique_ptr<NetMessage>& resp)
+      {
+         ASSERT_TRUE(resp);
+         ASSERT_EQ(NETMSGTYPE_GenericResponse, resp->getMsgType() );
+         EXPECT_EQ(GenericRespMsgCode_READFROMPRIMARY,
+            static_cast<GenericResponseMsg&>(*resp).getControlCode() );
+      }
+};
+
+const NumNodeID TestSecondaryRead::CLIENT_ID(1000);
+
+TEST_F(TestSecondaryRead, noMirroredRequestsYet)
+{
+   initApp(true);
+
+   expectServed(statRootFromSecondary(0) );
+}
+
+TEST_F(TestSecondaryRead, behindWatermark)
+{
+   initApp(true);
+
+   // the client has responses for seqNo 1..3, but the secondary has only seen 1 and 2 yet
+   applyForwarded(1);
+   applyForwarded(2);
+
+   expectRedirected(statRootFromSecondary(3) );
+
+   applyForwarded(3);
+
+   expectServed(statRootFromSecondary(3) );
+}
+
+TEST_F(TestSecondaryRead, unknownClient)
+{
+   initApp(true);
+
+   // no session for the client on the secondary, so it can't have seen the client's requests
+   expectRedirected(statRootFromSecondary(1) );
+}
+
+TEST_F(TestSecondaryRead, notGood)
+{
+   initApp(true);
+
+   applyForwarded(1);
+
+   testApp->getApp()->getMetaStateStore()->setState(1, CombinedTargetState(
+      TargetReachabilityState_ONLINE, TargetConsistencyState_NEEDS_RESYNC) );
+
+   expectRedirected(statRootFromSecondary(1) );
+}
+
+TEST_F(TestSecondaryRead, disabled)
+{
+   initApp(false);
+
+   expectRedirected(statRootFromSecondary(0) );
+}
@@ -265,6 +265,7 @@ void TestSerialization::initSessionStoreForTests(SessionStore& testSessionStore)
    FileInodeStoreData* fileInodeStoreData30 = new FileInodeStoreData(*entryID30, statData30,
       stripePattern30, FILEINODE_FEATURE_HAS_ORIG_UID, 3121, *origParentEntryID30,
       FileInodeOrigFeature_TRUE);
+   fileInodeStoreData30->setInlineData(std::string("small\0file\ndata", 15) );
    FileInode* inode30 = new FileInode(*entryID30, fileInodeStoreData30, DirEntryType_REGULARFILE,
       DENTRY_FEATURE_IS_FILEINODE);
    inode30->setIsInlinedUnlocked(true);
@@ -2,6 +2,7 @@
 
 #include <common/toolkit/SocketTk.h>
 #include <common/nodes/OpCounterTypes.h>
+#include <common/net/message/NetMessageLogHelper.h>
 
 #include <app/App.h>
 
@@ -81,6 +82,9 @@ void StatsCollector::requestLoop()
                app->getTSDB()->insertHighResMetaNodeData(iter->node, *listIter);
             }
 
+            if (iter->hasLatencyStats)
+               processLatencyStats(iter->node, iter->queueWaitLatency, iter->msgLatencies);
+
             if (collectClientOpsByNode)
             {
                for (auto mapIter = iter->ipOpsUnorderedMap.begin();
@@ -117,6 +121,9 @@ void StatsCollector::requestLoop()
                app->getTSDB()->insertStorageTargetsData(iter->node, *listIter);
             }
 
+            if (iter->hasLatencyStats)
+               processLatencyStats(iter->node, iter->queueWaitLatency, iter->msgLatencies);
+
             if (collectClientOpsByNode)
             {
                for (auto mapIter = iter->ipOpsUnorderedMap.begin();
@@ -204,3 +211,22 @@ void StatsCollector::processClientOps(ClientOps& clientOps, NodeType nodeType, b
 
    clientOps.clear();
 }
+
+void StatsCollector::processLatencyStats(std::shared_ptr<Node> node,
+      const LatencyHistogramData& queueWait, const LatencyHistogramDataMap& msgLatencies)
+{
+   if (queueWait.count)
+      app->getTSDB()->insertLatencyData(node, "QueueWait", queueWait);
+
+   for (auto iter = msgLatencies.begin(); iter != msgLatencies.end(); iter++)
+   {
+      if (!iter->second.count)
+         continue;
+
+      // netMessageTypeToStr() returns "<name> (<number>)", we only want the name here
+      std::string opName = netMessageTypeToStr(iter->first);
+      opName = opName.substr(0, opName.find(' '));
+
+      app->getTSDB()->insertLatencyData(node, opName, iter->second);
+   }
+}
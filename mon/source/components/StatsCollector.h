@@ -35,6 +35,8 @@ class StatsCollector : public PThread
       virtual void run() override;
       void requestLoop();
       void processClientOps(ClientOps& clientOps, NodeType nodeType, bool perUser);
+      void processLatencyStats(std::shared_ptr<Node> node, const LatencyHistogramData& queueWait,
+            const LatencyHistogramDataMap& msgLatencies);
 
       void insertMetaData(RequestMetaDataWork::Result result)
       {
@@ -60,6 +60,9 @@ void RequestMetaDataWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
 
          if (collectClientOpsByUser)
             result.userOpsUnorderedMap = ClientOpsRequestor::request(*node, true);
+
+         result.hasLatencyStats = node->getLatencyStats().requestIntervalStats(*node,
+               result.queueWaitLatency, result.msgLatencies);
       }
    }
 
@@ -18,6 +18,9 @@ class RequestMetaDataWork : public Work
          HighResStatsList highResStatsList;
          ClientOpsRequestor::IdOpsUnorderedMap ipOpsUnorderedMap;
          ClientOpsRequestor::IdOpsUnorderedMap userOpsUnorderedMap;
+         bool hasLatencyStats;
+         LatencyHistogramData queueWaitLatency; // interval since last request
+         LatencyHistogramDataMap msgLatencies; // interval since last request, key is msg type
       };
 
       RequestMetaDataWork(std::shared_ptr<MetaNodeEx> node,
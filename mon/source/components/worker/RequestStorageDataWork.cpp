@@ -65,6 +65,9 @@ void RequestStorageDataWork::process(char* bufIn, unsigned bufInLen,
 
          if (collectClientOpsByUser)
             result.userOpsUnorderedMap = ClientOpsRequestor::request(*node, true);
+
+         result.hasLatencyStats = node->getLatencyStats().requestIntervalStats(*node,
+               result.queueWaitLatency, result.msgLatencies);
       }
    }
 
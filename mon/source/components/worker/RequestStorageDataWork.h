@@ -20,6 +20,9 @@ class RequestStorageDataWork : public Work
          StorageTargetInfoList storageTargetList;
          ClientOpsRequestor::IdOpsUnorderedMap ipOpsUnorderedMap;
          ClientOpsRequestor::IdOpsUnorderedMap userOpsUnorderedMap;
+         bool hasLatencyStats;
+         LatencyHistogramData queueWaitLatency; // interval since last request
+         LatencyHistogramDataMap msgLatencies; // interval since last request, key is msg type
       };
 
       RequestStorageDataWork(std::shared_ptr<StorageNodeEx> node,
@@ -149,6 +149,12 @@ Cassandra::Cassandra(Config config) :
    query("CREATE TABLE IF NOT EXISTS storageClientOpsByUser ("
          "time timestamp, user varchar, ops map<varchar,int> ,"
          "PRIMARY KEY(time, user));");
+   query("CREATE TABLE IF NOT EXISTS latencyMeta ("
+         "time timestamp, nodeNumID int, nodeID varchar, op varchar, count bigint, "
+         "mean bigint, p50 bigint, p99 bigint, p999 bigint, PRIMARY KEY(time, nodeNumID, op));");
+   query("CREATE TABLE IF NOT EXISTS latencyStorage ("
+         "time timestamp, nodeNumID int, nodeID varchar, op varchar, count bigint, "
+         "mean bigint, p50 bigint, p99 bigint, p999 bigint, PRIMARY KEY(time, nodeNumID, op));");
 }
 
 void Cassandra::query(const std::string& query, bool waitForResult)
@@ -312,6 +318,28 @@ void Cassandra::insertClientNodeData(const std::string& id, const NodeType nodeT
       appendQuery(statement.str());
 }
 
+void Cassandra::insertLatencyData(std::shared_ptr<Node> node, const std::string& opName,
+      const LatencyHistogramData& data)
+{
+   std::ostringstream statement;
+   statement << "INSERT INTO ";
+   if (node->getNodeType() == NODETYPE_Meta)
+      statement << "latencyMeta";
+   else if (node->getNodeType() == NODETYPE_Storage)
+      statement << "latencyStorage";
+   else
+      throw DatabaseException("Invalid Nodetype given.");
+
+   statement << " (time, nodeNumID, nodeID, op, count, mean, p50, p99, p999) VALUES (";
+   statement << "TOTIMESTAMP(NOW()), " << node->getNumID() << ", '" << node->getAlias() << "', ";
+   statement << "'" << opName << "', " << data.count << ", " << data.meanMicro() << ", ";
+   statement << data.percentileMicro(0.5) << ", " << data.percentileMicro(0.99) << ", ";
+   statement << data.percentileMicro(0.999) << ") ";
+   statement << "USING TTL " << config.TTLSecs << ";";
+
+   appendQuery(statement.str());
+}
+
 void Cassandra::appendQuery(const std::string& query)
 {
    const std::lock_guard<Mutex> lock(queryMutex);
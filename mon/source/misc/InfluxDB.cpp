@@ -210,6 +210,31 @@ void InfluxDB::insertClientNodeData(const std::string& id, const NodeType nodeTy
       appendPoint(point.str());
 }
 
+void InfluxDB::insertLatencyData(std::shared_ptr<Node> node, const std::string& opName,
+      const LatencyHistogramData& data)
+{
+   std::ostringstream point;
+   if (node->getNodeType() == NODETYPE_Meta)
+      point << "latencyMeta";
+   else if (node->getNodeType() == NODETYPE_Storage)
+      point << "latencyStorage";
+   else
+      throw DatabaseException("Invalid Nodetype given.");
+
+   point << ",nodeID=" << escapeStringForWrite(node->getAlias());
+   point << ",nodeNumID=" << node->getNumID();
+   point << ",op=" << escapeStringForWrite(opName);
+
+   // all latencies in microseconds
+   point << " count=" << data.count;
+   point << ",mean=" << data.meanMicro();
+   point << ",p50=" << data.percentileMicro(0.5);
+   point << ",p99=" << data.percentileMicro(0.99);
+   point << ",p999=" << data.percentileMicro(0.999);
+
+   appendPoint(point.str());
+}
+
 
 void InfluxDB::appendPoint(const std::string& point)
 {
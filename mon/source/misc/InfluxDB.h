@@ -56,6 +56,9 @@ class InfluxDB : public TSDatabase
       virtual void insertClientNodeData(
             const std::string& id, const NodeType nodeType,
             const std::map<std::string, uint64_t>& opMap, bool perUser) override;
+      virtual void insertLatencyData(
+            std::shared_ptr<Node> node, const std::string& opName,
+            const LatencyHistogramData& data) override;
       virtual void write() override;
 
       static std::string escapeStringForWrite(const std::string& str);
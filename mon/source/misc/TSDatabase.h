@@ -2,6 +2,7 @@
 #define TS_DATABASE_H_
 
 #include <common/nodes/NodeType.h>
+#include <common/toolkit/LatencyHistogram.h>
 #include <nodes/MetaNodeEx.h>
 #include <nodes/StorageNodeEx.h>
 #include <app/Config.h>
@@ -27,6 +28,9 @@ class TSDatabase
       virtual void insertClientNodeData(
             const std::string& id, const NodeType nodeType,
             const std::map<std::string, uint64_t>& opMap, bool perUser) = 0;
+      virtual void insertLatencyData(
+            std::shared_ptr<Node> node, const std::string& opName,
+            const LatencyHistogramData& data) = 0;
 
       virtual void write() = 0;
 };
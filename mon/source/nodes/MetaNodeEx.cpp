@@ -10,7 +10,8 @@ MetaNodeEx::MetaNodeEx(std::shared_ptr<Node> receivedNode) :
 MetaNodeEx::MetaNodeEx(std::shared_ptr<Node> receivedNode, std::shared_ptr<MetaNodeEx> oldNode) :
    Node(NODETYPE_Meta, receivedNode->getAlias(), receivedNode->getNumID(),
    receivedNode->getPortUDP(), receivedNode->getPortTCP(),
-   receivedNode->getConnPool()->getNicList())
+   receivedNode->getConnPool()->getNicList()),
+   latencyStats(oldNode->latencyStats)
 {
    setLastStatRequestTime(oldNode->getLastStatRequestTime());
    setIsResponding(oldNode->getIsResponding());
@@ -4,6 +4,7 @@
 #include <common/nodes/Node.h>
 #include <common/Common.h>
 #include <common/threading/RWLockGuard.h>
+#include <nodes/NodeLatencyStats.h>
 
 struct MetaNodeDataContent
 {
@@ -24,8 +25,14 @@ class MetaNodeEx: public Node
       mutable RWLock lock;
       bool isResponding;
       std::chrono::milliseconds lastStatRequestTime{0};
+      NodeLatencyStats latencyStats;
 
    public:
+      NodeLatencyStats& getLatencyStats()
+      {
+         return latencyStats;
+      }
+
       std::chrono::milliseconds getLastStatRequestTime() const
       {
          RWLockGuard safeLock(lock, SafeRWLock_READ);
@@ -0,0 +1,34 @@
+#include "NodeLatencyStats.h"
+
+#include <common/net/message/storage/GetLatencyStatsMsg.h>
+#include <common/net/message/storage/GetLatencyStatsRespMsg.h>
+#include <common/nodes/Node.h>
+#include <common/toolkit/MessagingTk.h>
+
+/**
+ * Requests the cumulative latency histograms from the given server and turns them into the
+ * histograms of the interval since the last call.
+ *
+ * @return false if the server did not answer (e.g. because it is too old to know the
+ *    GetLatencyStats message) or if there is no previous state to compute a delta against.
+ */
+bool NodeLatencyStats::requestIntervalStats(Node& node, LatencyHistogramData& outQueueWait,
+   LatencyHistogramDataMap& outMsgProcessing)
+{
+   GetLatencyStatsMsg getLatencyStatsMsg;
+
+   auto respMsg = MessagingTk::requestResponse(node, getLatencyStatsMsg,
+         NETMSGTYPE_GetLatencyStatsResp);
+   if (!respMsg)
+   {
+      LOG(GENERAL, DEBUG, "Unable to get latency stats.", ("NodeID", node.getNodeIDWithTypeStr()));
+      return false;
+   }
+
+   auto latencyRespMsg = static_cast<GetLatencyStatsRespMsg*>(respMsg.get());
+
+   outQueueWait = std::move(latencyRespMsg->getQueueWait());
+   outMsgProcessing = std::move(latencyRespMsg->getMsgProcessing());
+
+   return updateAndGetDelta(outQueueWait, outMsgProcessing);
+}
@@ -0,0 +1,80 @@
+#ifndef NODELATENCYSTATS_H_
+#define NODELATENCYSTATS_H_
+
+#include <common/threading/Mutex.h>
+#include <common/toolkit/LatencyHistogram.h>
+#include <common/Common.h>
+
+#include <mutex>
+
+class Node;
+
+/**
+ * Keeps the last cumulative latency histograms received from a server, so that the histograms of
+ * the next stats request can be turned into the histograms of the elapsed interval.
+ */
+class NodeLatencyStats
+{
+   public:
+      NodeLatencyStats() : hasLastStats(false) {}
+
+      NodeLatencyStats(const NodeLatencyStats& other) : hasLastStats(false)
+      {
+         std::lock_guard<Mutex> lock(other.mutex);
+
+         hasLastStats = other.hasLastStats;
+         lastQueueWait = other.lastQueueWait;
+         lastMsgProcessing = other.lastMsgProcessing;
+      }
+
+      NodeLatencyStats& operator=(const NodeLatencyStats&) = delete;
+
+   private:
+      mutable Mutex mutex;
+      bool hasLastStats;
+      LatencyHistogramData lastQueueWait;
+      LatencyHistogramDataMap lastMsgProcessing;
+
+   public:
+      bool requestIntervalStats(Node& node, LatencyHistogramData& outQueueWait,
+         LatencyHistogramDataMap& outMsgProcessing);
+
+      /**
+       * Stores the given cumulative histograms and replaces them with the delta to the previously
+       * stored ones.
+       *
+       * @return false if there is no previous state to compute a delta against (first request or
+       *    server restart), in which case the given histograms are left unmodified.
+       */
+      bool updateAndGetDelta(LatencyHistogramData& inOutQueueWait,
+         LatencyHistogramDataMap& inOutMsgProcessing)
+      {
+         std::lock_guard<Mutex> lock(mutex);
+
+         LatencyHistogramData newQueueWait = inOutQueueWait;
+         LatencyHistogramDataMap newMsgProcessing = inOutMsgProcessing;
+
+         // counters of a server only grow, so a smaller value means that the server restarted
+         bool canComputeDelta = hasLastStats && (inOutQueueWait.count >= lastQueueWait.count);
+
+         if(canComputeDelta)
+         {
+            inOutQueueWait.subtract(lastQueueWait);
+
+            for(auto iter = inOutMsgProcessing.begin(); iter != inOutMsgProcessing.end(); iter++)
+            {
+               auto lastIter = lastMsgProcessing.find(iter->first);
+               if(lastIter != lastMsgProcessing.end() )
+                  iter->second.subtract(lastIter->second);
+            }
+         }
+
+         hasLastStats = true;
+         lastQueueWait = std::move(newQueueWait);
+         lastMsgProcessing = std::move(newMsgProcessing);
+
+         return canComputeDelta;
+      }
+};
+
+#endif /*NODELATENCYSTATS_H_*/
@@ -11,7 +11,8 @@ StorageNodeEx::StorageNodeEx(std::shared_ptr<Node> receivedNode,
       std::shared_ptr<StorageNodeEx> oldNode) :
    Node(NODETYPE_Storage, receivedNode->getAlias(), receivedNode->getNumID(),
    receivedNode->getPortUDP(), receivedNode->getPortTCP(),
-   receivedNode->getConnPool()->getNicList())
+   receivedNode->getConnPool()->getNicList()),
+   latencyStats(oldNode->latencyStats)
 {
    setLastStatRequestTime(oldNode->getLastStatRequestTime());
    setIsResponding(oldNode->getIsResponding());
@@ -4,6 +4,7 @@
 #include <common/nodes/Node.h>
 #include <common/Common.h>
 #include <common/threading/RWLockGuard.h>
+#include <nodes/NodeLatencyStats.h>
 
 struct StorageNodeDataContent
 {
@@ -31,8 +32,14 @@ class StorageNodeEx : public Node
       mutable RWLock lock;
       bool isResponding;
       std::chrono::milliseconds lastStatRequestTime{0};
+      NodeLatencyStats latencyStats;
 
    public:
+      NodeLatencyStats& getLatencyStats()
+      {
+         return latencyStats;
+      }
+
       std::chrono::milliseconds getLastStatRequestTime() const
       {
          RWLockGuard safeLock(lock, SafeRWLock_READ);
@@ -29,6 +29,7 @@
 #include <blkid/blkid.h>
 #include <uuid/uuid.h>
 #include <fstream>
+#include <set>
 #include <sstream>
 
 
@@ -41,6 +42,8 @@
 
 #define APP_LIB_ZFS_NAME "libzfs.so"
 
+#define APP_NUMA_CONN_TABLE_MAX_FDS (1024*1024) // max fd for NUMA placement of connections
+
 App::App(int argc, char** argv)
 {
    this->argc = argc;
@@ -76,11 +79,15 @@ App::App(int argc, char** argv)
    this->timerQueue = new TimerQueue();
 
    this->nextNumaBindTarget = 0;
+   this->streamLisIndexByFDLen = 0;
 
    this->workersRunning = false;
 
    this->buddyResyncer = NULL;
    this->chunkLockStore = NULL;
+   this->chunkFDCache = NULL;
+   this->chunkCompression = NULL;
+   this->readAheadPrefetcher = NULL;
 
    this->dlOpenHandleLibZfs = NULL;
    this->libZfsErrorReported = false;
@@ -125,6 +132,9 @@ App::~App()
    SAFE_DELETE(this->storageTargets);
    SAFE_DELETE(this->storageBenchOperator);
    SAFE_DELETE(this->chunkLockStore);
+   SAFE_DELETE(this->chunkFDCache); // after sessions, which return their fds on destruction
+   SAFE_DELETE(this->chunkCompression);
+   SAFE_DELETE(this->readAheadPrefetcher); // after workers, which might still issue read-ahead
 
    SAFE_DELETE(this->cfg);
 
@@ -524,6 +534,24 @@ void App::initStorage()
             "(SysErr: " + System::getErrString() + ")");
    }
 
+   // (needs the final fd limit)
+   struct rlimit fdLimit;
+   const size_t processFDLimit = getrlimit(RLIMIT_NOFILE, &fdLimit) ? 0 : fdLimit.rlim_cur;
+
+   this->chunkFDCache = new ChunkFDCache(cfg->getTuneChunkFDCacheSize(), processFDLimit);
+
+   std::set<StoragePoolId> compressPoolIDs;
+
+   for (auto poolID : cfg->getStoreCompressStoragePools())
+      compressPoolIDs.insert(StoragePoolId(poolID));
+
+   if ( (!cfg->getStoreCompressTargets().empty() || !compressPoolIDs.empty() ) &&
+        !ChunkCompression::isSupported() )
+      throw InvalidConfigException("Chunk compression is configured, but this build of the "
+         "storage server has no LZ4 support.");
+
+   this->chunkCompression = new ChunkCompression(cfg->getStoreCompressTargets(), compressPoolIDs,
+      storagePoolStore.get());
 }
 
 /**
@@ -550,6 +578,15 @@ void App::initPostTargetRegistration()
    // init exceeded quota stores
    for (const auto& mapping : storageTargets->getTargets())
       exceededQuotaStores.add(mapping.first);
+
+   std::vector<uint16_t> targetIDs;
+
+   for (const auto& mapping : storageTargets->getTargets())
+      targetIDs.push_back(mapping.first);
+
+   // (no read-ahead threads if read-ahead is disabled)
+   this->readAheadPrefetcher = new ReadAheadPrefetcher(
+      cfg->getTuneFileReadAheadSize() ? cfg->getTuneFileReadAheadNumThreads() : 0, targetIDs);
 }
 
 void App::initComponents()
@@ -605,6 +642,8 @@ void App::startComponents()
 
    timerQueue->enqueue(std::chrono::seconds(30), InternodeSyncer::requestBuddyTargetStates);
 
+   readAheadPrefetcher->startSlaves();
+
    workersStart();
 
    PThread::unblockInterruptSignals(); // main app thread may receive SIGINT/SIGTERM
@@ -619,6 +658,9 @@ void App::stopComponents()
 
    workersStop();
 
+   if (readAheadPrefetcher)
+      readAheadPrefetcher->stopSlaves();
+
    if (chunkFetcher)
       chunkFetcher->stopFetching(); // ignored if not running
 
@@ -696,6 +738,9 @@ void App::joinComponents()
 
    workersJoin();
 
+   // (the ReadAheadPrefetcher is not a normal component, so it gets special treatment here)
+   readAheadPrefetcher->joinSlaves();
+
    // (the ChunkFetcher is not a normal component, so it gets special treatment here)
    if(chunkFetcher)
       chunkFetcher->waitForStopFetching();
@@ -729,8 +774,114 @@ void App::streamListenersInit()
       if(cfg->getTuneUseAggressiveStreamPoll() )
          listener->setUseAggressivePoll();
 
+      if(cfg->getTuneUseIoUringStreamPoll() )
+         listener->setUseIoUring();
+
+      listener->setMaxRunToCompletionMsgs(cfg->getTuneRunToCompletionMsgs() );
+
       streamLisVec.push_back(listener);
    }
+
+   // NUMA placement of listeners (nodes of the local NICs, equally distributed)
+
+   streamLisNumaNodes.assign(numStreamListeners, -1);
+
+   if(!cfg->getTuneDeviceNumaAffinity() )
+      return;
+
+   const int numNumaNodes = System::getNumNumaNodes();
+   std::set<int> nicNumaNodes;
+
+   for(const auto& nic : getLocalNicList() )
+   {
+      const int numaNode = System::getNumaNodeOfNetDevice(nic.name);
+
+      if( (numaNode >= 0) && (numaNode < numNumaNodes) )
+         nicNumaNodes.insert(numaNode);
+   }
+
+   if(nicNumaNodes.empty() )
+   {
+      log->log(Log_NOTICE, "NUMA nodes of network interfaces unknown. "
+         "Not placing connections by NUMA node.");
+      return;
+   }
+
+   const std::vector<int> lisNumaNodes(nicNumaNodes.begin(), nicNumaNodes.end() );
+
+   streamLisIndicesByNumaNode.resize(numNumaNodes);
+
+   for(unsigned i=0; i < numStreamListeners; i++)
+   {
+      streamLisNumaNodes[i] = lisNumaNodes[i % lisNumaNodes.size()];
+      streamLisIndicesByNumaNode[streamLisNumaNodes[i] ].push_back(i);
+   }
+
+   /* table for connection => listener mapping. sized by the process fd limit, connections with
+      higher fds fall back to fd-based selection. */
+
+   struct rlimit fdLimit;
+
+   streamLisIndexByFDLen = getrlimit(RLIMIT_NOFILE, &fdLimit)
+      ? APP_NUMA_CONN_TABLE_MAX_FDS
+      : std::min<rlim_t>(fdLimit.rlim_cur, APP_NUMA_CONN_TABLE_MAX_FDS);
+   streamLisIndexByFD.reset(new std::atomic<uint16_t>[streamLisIndexByFDLen]() );
+}
+
+/**
+ * Select a stream listener on the NUMA node of the NIC that the connection arrived on (with
+ * tuneDeviceNumaAffinity), so that the connection is polled and its requests are received by
+ * threads close to the NIC.
+ */
+StreamListenerV2* App::getStreamListenerForNewConn(Socket* sock)
+{
+   const int fd = sock->getFD();
+
+   if( (size_t)fd >= streamLisIndexByFDLen)
+      return getStreamListenerByFD(fd);
+
+   unsigned lisIndex = fd % numStreamListeners;
+
+   const int numaNode = getConnNumaNode(sock);
+
+   if( (numaNode >= 0) && ( (size_t)numaNode < streamLisIndicesByNumaNode.size() ) &&
+      !streamLisIndicesByNumaNode[numaNode].empty() )
+   {
+      const std::vector<unsigned>& nodeLisIndices = streamLisIndicesByNumaNode[numaNode];
+
+      lisIndex = nodeLisIndices[fd % nodeLisIndices.size()];
+   }
+
+   // note: always set, because the fd might have belonged to another connection before
+   streamLisIndexByFD[fd].store(lisIndex + 1, std::memory_order_relaxed);
+
+   return streamLisVec[lisIndex];
+}
+
+/**
+ * @return NUMA node of the local NIC of the given connection, -1 if unknown (e.g. for RDMA
+ *    connections, which don't have a socket fd)
+ */
+int App::getConnNumaNode(Socket* sock)
+{
+   if(sock->getSockType() != NICADDRTYPE_STANDARD)
+      return -1;
+
+   struct sockaddr_in localAddr;
+   socklen_t localAddrLen = sizeof(localAddr);
+
+   if(getsockname(sock->getFD(), (struct sockaddr*)&localAddr, &localAddrLen) ||
+      (localAddr.sin_family != AF_INET) )
+      return -1;
+
+   for(const auto& nic : getLocalNicList() )
+   {
+      if( (nic.nicType == NICADDRTYPE_STANDARD) &&
+         (nic.ipAddr.s_addr == localAddr.sin_addr.s_addr) )
+         return System::getNumaNodeOfNetDevice(nic.name);
+   }
+
+   return -1;
 }
 
 void App::workersInit()
@@ -774,21 +925,55 @@ void App::streamListenersStart()
 {
    unsigned numNumaNodes = System::getNumNumaNodes();
 
-   for(StreamLisVecIter iter = streamLisVec.begin(); iter != streamLisVec.end(); iter++)
+   for(size_t i = 0; i < streamLisVec.size(); i++)
    {
+      if(streamLisNumaNodes[i] >= 0)
+         streamLisVec[i]->startOnNumaNode(streamLisNumaNodes[i]);
+      else
       if(cfg->getTuneListenerNumaAffinity() )
-         (*iter)->startOnNumaNode( (++nextNumaBindTarget) % numNumaNodes);
+         streamLisVec[i]->startOnNumaNode( (++nextNumaBindTarget) % numNumaNodes);
       else
-         (*iter)->start();
+         streamLisVec[i]->start();
    }
 }
 
+/**
+ * @return NUMA node that the workers of the given queue are bound to with tuneDeviceNumaAffinity
+ *    (i.e. the node of the queue's target), -1 for default placement
+ */
+int App::getWorkQueueNumaNode(const MultiWorkQueue* workQueue) const
+{
+   if(!cfg->getTuneDeviceNumaAffinity() || !cfg->getTuneUsePerTargetWorkers() )
+      return -1;
+
+   for(MultiWorkQueueMapCIter iter = workQueueMap.begin(); iter != workQueueMap.end(); iter++)
+   {
+      if(iter->second != workQueue)
+         continue;
+
+      const StorageTarget* target = storageTargets->getTarget(iter->first);
+      const int numaNode = target ? target->getNumaNode() : -1;
+
+      return (numaNode < System::getNumNumaNodes() ) ? numaNode : -1;
+   }
+
+   return -1;
+}
+
 void App::workersStart()
 {
    unsigned numNumaNodes = System::getNumNumaNodes();
 
    for(WorkerListIter iter = workerList.begin(); iter != workerList.end(); iter++)
    {
+      /* note: worker buffers are allocated by the worker thread (first touch), so they end up on
+         the bound node */
+
+      const int targetNumaNode = getWorkQueueNumaNode( (*iter)->getWorkQueue() );
+
+      if(targetNumaNode >= 0)
+         (*iter)->startOnNumaNode(targetNumaNode);
+      else
       if(cfg->getTuneWorkerNumaAffinity() )
          (*iter)->startOnNumaNode( (++nextNumaBindTarget) % numNumaNodes);
       else
@@ -896,7 +1081,7 @@ void App::logInfos()
    // print numa info
    // (getTuneBindToNumaZone==-1 means disable binding)
    if(cfg->getTuneListenerNumaAffinity() || cfg->getTuneWorkerNumaAffinity() ||
-      (cfg->getTuneBindToNumaZone() != -1) )
+      cfg->getTuneDeviceNumaAffinity() || (cfg->getTuneBindToNumaZone() != -1) )
    {
       unsigned numNumaNodes = System::getNumNumaNodes();
 
@@ -922,6 +1107,13 @@ void App::logInfos()
 
          log->log(Log_SPAM, "NUMA area " + StringTk::uintToStr(nodeNum) + " cores: " + coreListStr);
       }
+
+      if(cfg->getTuneDeviceNumaAffinity() )
+      {
+         for(const auto& mapping : storageTargets->getTargets() )
+            log->log(Log_NOTICE, "Target " + StringTk::uintToStr(mapping.first) + " NUMA area: " +
+               StringTk::intToStr(mapping.second->getNumaNode() ) );
+      }
    }
 }
 
@@ -21,13 +21,16 @@
 #include <components/benchmarker/StorageBenchOperator.h>
 #include <components/buddyresyncer/BuddyResyncer.h>
 #include <components/chunkfetcher/ChunkFetcher.h>
+#include <components/readahead/ReadAheadPrefetcher.h>
 #include <components/DatagramListener.h>
 #include <components/InternodeSyncer.h>
 #include <components/StorageStatsCollector.h>
 #include <net/message/NetMessageFactory.h>
 #include <nodes/StorageNodeOpStats.h>
 #include <session/SessionStore.h>
+#include <storage/ChunkCompression.h>
 #include <storage/ChunkLockStore.h>
+#include <storage/ChunkFDCache.h>
 #include <storage/ChunkStore.h>
 #include <storage/SyncedStoragePaths.h>
 #include <storage/StorageTargets.h>
@@ -105,7 +108,7 @@ class App : public AbstractApp
 
       DatagramListener* dgramListener;
       ConnAcceptor* connAcceptor;
-      StatsCollector* statsCollector;
+      StorageStatsCollector* statsCollector;
       InternodeSyncer* internodeSyncer;
       TimerQueue* timerQueue;
 
@@ -113,6 +116,12 @@ class App : public AbstractApp
 
       unsigned numStreamListeners; // value copied from cfg (for performance)
       StreamLisVec streamLisVec;
+      std::vector<int> streamLisNumaNodes; // per stream listener, -1 if not bound to a NUMA node
+      std::vector<std::vector<unsigned>> streamLisIndicesByNumaNode;
+      /* stream listener index + 1 of each accepted connection by fd number (only with
+         tuneDeviceNumaAffinity; 0 means "fd % numStreamListeners") */
+      std::unique_ptr<std::atomic<uint16_t>[]> streamLisIndexByFD;
+      size_t streamLisIndexByFDLen;
 
       WorkerList workerList;
       bool workersRunning;
@@ -126,6 +135,9 @@ class App : public AbstractApp
 
       BuddyResyncer* buddyResyncer;
       ChunkLockStore* chunkLockStore;
+      ChunkFDCache* chunkFDCache;
+      ChunkCompression* chunkCompression;
+      ReadAheadPrefetcher* readAheadPrefetcher;
 
       std::unique_ptr<StoragePoolStore> storagePoolStore;
 
@@ -141,6 +153,8 @@ class App : public AbstractApp
       void streamListenersJoin();
 
       void workersInit();
+      int getWorkQueueNumaNode(const MultiWorkQueue* workQueue) const;
+      int getConnNumaNode(Socket* sock);
       void workersStart();
       void workersStop();
       void workersDelete();
@@ -197,9 +211,20 @@ class App : public AbstractApp
        */
       virtual StreamListenerV2* getStreamListenerByFD(int fd) override
       {
+         if( (size_t)fd < streamLisIndexByFDLen)
+         { // connection was placed by NUMA node on accept (see getStreamListenerForNewConn() )
+            const uint16_t lisIndexPlusOne = streamLisIndexByFD[fd].load(
+               std::memory_order_relaxed);
+
+            if(lisIndexPlusOne)
+               return streamLisVec[lisIndexPlusOne - 1];
+         }
+
          return streamLisVec[fd % numStreamListeners];
       }
 
+      virtual StreamListenerV2* getStreamListenerForNewConn(Socket* sock) override;
+
       // getters & setters
       virtual const ICommonConfig* getCommonConfig() const override
       {
@@ -323,7 +348,16 @@ class App : public AbstractApp
          return &streamLisVec;
       }
 
-      StatsCollector* getStatsCollector() const
+      /**
+       * @return NUMA node of each stream listener (same order as getStreamListenerVec() ), -1 for
+       *    listeners that are not bound to a NUMA node
+       */
+      const std::vector<int>& getStreamListenerNumaNodes() const
+      {
+         return streamLisNumaNodes;
+      }
+
+      StorageStatsCollector* getStatsCollector() const
       {
          return statsCollector;
       }
@@ -374,6 +408,21 @@ class App : public AbstractApp
          return chunkLockStore;
       }
 
+      ChunkFDCache* getChunkFDCache() const
+      {
+         return chunkFDCache;
+      }
+
+      ChunkCompression* getChunkCompression() const
+      {
+         return chunkCompression;
+      }
+
+      ReadAheadPrefetcher* getReadAheadPrefetcher() const
+      {
+         return readAheadPrefetcher;
+      }
+
       WorkerList* getWorkers()
       {
          return &workerList;
@@ -32,18 +32,24 @@ void Config::loadDefaults(bool addDashes)
    configMapRedefine("storeStorageDirectory",    "");
    configMapRedefine("storeFsUUID",              "");
    configMapRedefine("storeAllowFirstRunInit",   "true");
+   configMapRedefine("storeCompressTargets",     "");
+   configMapRedefine("storeCompressStoragePools", "");
 
    configMapRedefine("tuneNumStreamListeners",        "1");
    configMapRedefine("tuneNumWorkers",                "8");
    configMapRedefine("tuneWorkerBufSize",             "4m");
    configMapRedefine("tuneProcessFDLimit",            "50000");
+   configMapRedefine("tuneChunkFDCacheSize",          "0");
    configMapRedefine("tuneWorkerNumaAffinity",        "false");
    configMapRedefine("tuneListenerNumaAffinity",      "false");
+   configMapRedefine("tuneDeviceNumaAffinity",        "false");
    configMapRedefine("tuneListenerPrioShift",         "-1");
    configMapRedefine("tuneBindToNumaZone",            "");
    configMapRedefine("tuneFileReadSize",              "32k");
    configMapRedefine("tuneFileReadAheadTriggerSize",  "4m");
    configMapRedefine("tuneFileReadAheadSize",         "0");
+   configMapRedefine("tuneFileReadAheadMaxSize",      "0");
+   configMapRedefine("tuneFileReadAheadNumThreads",   "2");
    configMapRedefine("tuneFileWriteSize",             "64k");
    configMapRedefine("tuneFileWriteSyncSize",         "0");
    configMapRedefine("tuneUsePerUserMsgQueues",       "false");
@@ -52,6 +58,8 @@ void Config::loadDefaults(bool addDashes)
    configMapRedefine("tuneNumResyncSlaves",           "12");
    configMapRedefine("tuneNumResyncGatherSlaves",     "6");
    configMapRedefine("tuneUseAggressiveStreamPoll",   "false");
+   configMapRedefine("tuneUseIoUringStreamPoll",      "false");
+   configMapRedefine("tuneRunToCompletionMsgs",       "0");
    configMapRedefine("tuneUsePerTargetWorkers",       "true");
 
    configMapRedefine("quotaEnableEnforcement",        "false");
@@ -129,6 +137,25 @@ void Config::applyConfigMap(bool enableException, bool addDashes)
       }
       else if (iter->first == std::string("storeAllowFirstRunInit"))
          storeAllowFirstRunInit = StringTk::strToBool(iter->second);
+      else if (iter->first == std::string("storeCompressTargets")
+            || iter->first == std::string("storeCompressStoragePools"))
+      {
+         UInt16Set& ids = iter->first == std::string("storeCompressTargets")
+            ? storeCompressTargets
+            : storeCompressStoragePools;
+
+         ids.clear();
+
+         std::list<std::string> split;
+
+         StringTk::explode(iter->second, CONFIG_STORAGETARGETS_DELIMITER, &split);
+
+         for (auto& id : split)
+         {
+            if (!StringTk::trim(id).empty())
+               ids.insert(StringTk::strToUInt(StringTk::trim(id)));
+         }
+      }
       else if (iter->first == std::string("tuneNumStreamListeners"))
          tuneNumStreamListeners = StringTk::strToUInt(iter->second);
       else if (iter->first == std::string("tuneNumWorkers"))
@@ -137,10 +164,14 @@ void Config::applyConfigMap(bool enableException, bool addDashes)
          tuneWorkerBufSize = UnitTk::strHumanToInt64(iter->second);
       else if (iter->first == std::string("tuneProcessFDLimit"))
          tuneProcessFDLimit = StringTk::strToUInt(iter->second);
+      else if (iter->first == std::string("tuneChunkFDCacheSize"))
+         tuneChunkFDCacheSize = StringTk::strToUInt(iter->second);
       else if (iter->first == std::string("tuneWorkerNumaAffinity"))
          tuneWorkerNumaAffinity = StringTk::strToBool(iter->second);
       else if (iter->first == std::string("tuneListenerNumaAffinity"))
          tuneListenerNumaAffinity = StringTk::strToBool(iter->second);
+      else if (iter->first == std::string("tuneDeviceNumaAffinity"))
+         tuneDeviceNumaAffinity = StringTk::strToBool(iter->second);
       else if (iter->first == std::string("tuneBindToNumaZone"))
       {
          if (iter->second.empty()) // not defined => disable
@@ -156,6 +187,10 @@ void Config::applyConfigMap(bool enableException, bool addDashes)
          tuneFileReadAheadTriggerSize = UnitTk::strHumanToInt64(iter->second);
       else if (iter->first == std::string("tuneFileReadAheadSize"))
          tuneFileReadAheadSize = UnitTk::strHumanToInt64(iter->second);
+      else if (iter->first == std::string("tuneFileReadAheadMaxSize"))
+         tuneFileReadAheadMaxSize = UnitTk::strHumanToInt64(iter->second);
+      else if (iter->first == std::string("tuneFileReadAheadNumThreads"))
+         tuneFileReadAheadNumThreads = StringTk::strToUInt(iter->second);
       else if (iter->first == std::string("tuneFileWriteSize"))
          tuneFileWriteSize = UnitTk::strHumanToInt64(iter->second);
       else if (iter->first == std::string("tuneFileWriteSyncSize"))
@@ -172,6 +207,10 @@ void Config::applyConfigMap(bool enableException, bool addDashes)
          this->tuneNumResyncSlaves = StringTk::strToUInt(iter->second);
       else if (iter->first == std::string("tuneUseAggressiveStreamPoll"))
          tuneUseAggressiveStreamPoll = StringTk::strToBool(iter->second);
+      else if (iter->first == std::string("tuneUseIoUringStreamPoll"))
+         tuneUseIoUringStreamPoll = StringTk::strToBool(iter->second);
+      else if (iter->first == std::string("tuneRunToCompletionMsgs"))
+         tuneRunToCompletionMsgs = StringTk::strToUInt(iter->second);
       else if (iter->first == std::string("tuneUsePerTargetWorkers"))
          tuneUsePerTargetWorkers = StringTk::strToBool(iter->second);
       else if (iter->first == std::string("quotaEnableEnforcement"))
@@ -224,6 +263,13 @@ void Config::initImplicitVals()
    if(tuneFileReadAheadTriggerSize < tuneFileReadAheadSize)
       tuneFileReadAheadTriggerSize = tuneFileReadAheadSize;
 
+   // tuneFileReadAheadMaxSize (0 means "4 x tuneFileReadAheadSize")
+   if(!tuneFileReadAheadMaxSize)
+      tuneFileReadAheadMaxSize = 4 * tuneFileReadAheadSize;
+   else
+   if(tuneFileReadAheadMaxSize < tuneFileReadAheadSize)
+      tuneFileReadAheadMaxSize = tuneFileReadAheadSize;
+
    // connInterfacesList(/File)
    AbstractConfig::initInterfacesList(connInterfacesFile, connInterfacesList);
 
@@ -31,18 +31,24 @@ class Config : public AbstractConfig
       std::list<Path> storageDirectories;
       std::list<std::string> storeFsUUID;
       bool        storeAllowFirstRunInit;
+      UInt16Set   storeCompressTargets; // IDs of targets to compress new chunk data on
+      UInt16Set   storeCompressStoragePools; // compress on all targets of these pools
 
       unsigned    tuneNumStreamListeners;
       unsigned    tuneNumWorkers;
       unsigned    tuneWorkerBufSize;
       unsigned    tuneProcessFDLimit; // 0 means "don't touch limit"
+      unsigned    tuneChunkFDCacheSize; // max idle chunk fds to keep open for later sessions
       bool        tuneWorkerNumaAffinity;
       bool        tuneListenerNumaAffinity;
+      bool        tuneDeviceNumaAffinity; // bind to NUMA nodes of target devices and NICs
       int         tuneBindToNumaZone; // bind all threads to this zone, -1 means no binding
       int         tuneListenerPrioShift;
       ssize_t     tuneFileReadSize;
       ssize_t     tuneFileReadAheadTriggerSize; // after how much seq read to start read-ahead
       ssize_t     tuneFileReadAheadSize; // read-ahead with posix_fadvise(..., POSIX_FADV_WILLNEED)
+      ssize_t     tuneFileReadAheadMaxSize; // max adaptive read-ahead window
+      unsigned    tuneFileReadAheadNumThreads; // 0 means "read-ahead from worker threads"
       ssize_t     tuneFileWriteSize;
       ssize_t     tuneFileWriteSyncSize; // after how many of per session data to sync_file_range()
       bool        tuneUsePerUserMsgQueues; // true to use UserWorkContainer for MultiWorkQueue
@@ -51,6 +57,8 @@ class Config : public AbstractConfig
       unsigned    tuneNumResyncGatherSlaves;
       unsigned    tuneNumResyncSlaves;
       bool        tuneUseAggressiveStreamPoll; // true to not sleep on epoll in streamlisv2
+      bool        tuneUseIoUringStreamPoll; // true to use io_uring instead of epoll
+      unsigned    tuneRunToCompletionMsgs; // max back-to-back msgs per work (0 disables)
       bool        tuneUsePerTargetWorkers; // true to have tuneNumWorkers separate for each target
 
       bool        quotaEnableEnforcement;
@@ -90,6 +98,16 @@ class Config : public AbstractConfig
          return storeAllowFirstRunInit;
       }
 
+      const UInt16Set& getStoreCompressTargets() const
+      {
+         return storeCompressTargets;
+      }
+
+      const UInt16Set& getStoreCompressStoragePools() const
+      {
+         return storeCompressStoragePools;
+      }
+
       unsigned getTuneNumStreamListeners() const
       {
          return tuneNumStreamListeners;
@@ -110,6 +128,11 @@ class Config : public AbstractConfig
          return tuneProcessFDLimit;
       }
 
+      unsigned getTuneChunkFDCacheSize() const
+      {
+         return tuneChunkFDCacheSize;
+      }
+
       bool getTuneWorkerNumaAffinity() const
       {
          return tuneWorkerNumaAffinity;
@@ -120,6 +143,11 @@ class Config : public AbstractConfig
          return tuneListenerNumaAffinity;
       }
 
+      bool getTuneDeviceNumaAffinity() const
+      {
+         return tuneDeviceNumaAffinity;
+      }
+
       int getTuneBindToNumaZone() const
       {
          return tuneBindToNumaZone;
@@ -145,6 +173,16 @@ class Config : public AbstractConfig
          return tuneFileReadAheadSize;
       }
 
+      ssize_t getTuneFileReadAheadMaxSize() const
+      {
+         return tuneFileReadAheadMaxSize;
+      }
+
+      unsigned getTuneFileReadAheadNumThreads() const
+      {
+         return tuneFileReadAheadNumThreads;
+      }
+
       ssize_t getTuneFileWriteSize() const
       {
          return tuneFileWriteSize;
@@ -210,6 +248,16 @@ class Config : public AbstractConfig
          return tuneUseAggressiveStreamPoll;
       }
 
+      bool getTuneUseIoUringStreamPoll() const
+      {
+         return tuneUseIoUringStreamPoll;
+      }
+
+      unsigned getTuneRunToCompletionMsgs() const
+      {
+         return tuneRunToCompletionMsgs;
+      }
+
       bool getTuneUsePerTargetWorkers() const
       {
          return tuneUsePerTargetWorkers;
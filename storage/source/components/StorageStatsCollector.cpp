@@ -21,6 +21,8 @@ void StorageStatsCollector::collectStats()
 
    iter->second->getAndResetStats(&newStats);
 
+   queueStats[iter->first] = newStats;
+
    // add the stat values from following queues
 
    iter++;
@@ -31,6 +33,8 @@ void StorageStatsCollector::collectStats()
 
       iter->second->getAndResetStats(&currentStats);
 
+      queueStats[iter->first] = currentStats;
+
       HighResolutionStatsTk::addHighResRawStats(currentStats, newStats);
       HighResolutionStatsTk::addHighResIncStats(currentStats, newStats);
    }
@@ -45,3 +49,29 @@ void StorageStatsCollector::collectStats()
    // push new stats to front
    statsList.push_front(newStats);
 }
+
+/**
+ * Get the stats of the last interval of the work queue that serves each target (i.e. the global
+ * queue for all targets if tuneUsePerTargetWorkers is disabled).
+ *
+ * @param outTargetStats keys are targetIDs
+ */
+void StorageStatsCollector::getTargetStats(TargetHighResStatsMap& outTargetStats)
+{
+   App* app = Program::getApp();
+
+   const std::lock_guard<Mutex> lock(mutex);
+
+   if(queueStats.empty() )
+      return; // nothing collected yet
+
+   for(const auto& mapping : app->getStorageTargets()->getTargets() )
+   {
+      // (same fallback to the first queue as App::getWorkQueue() )
+      TargetHighResStatsMapCIter iter = queueStats.find(mapping.first);
+      if(iter == queueStats.end() )
+         iter = queueStats.begin();
+
+      outTargetStats[mapping.first] = iter->second;
+   }
+}
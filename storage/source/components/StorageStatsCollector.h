@@ -17,9 +17,16 @@ class StorageStatsCollector : public StatsCollector
 
       virtual ~StorageStatsCollector() {}
 
+      void getTargetStats(TargetHighResStatsMap& outTargetStats);
+
 
    protected:
       virtual void collectStats();
 
+
+   private:
+      // stats of the last interval per work queue (keys: targetIDs, or 0 for the global queue)
+      TargetHighResStatsMap queueStats;
+
 };
 
@@ -0,0 +1,138 @@
+#include "StorageBenchIoUring.h"
+
+#if __has_include(<linux/io_uring.h>)
+   #include <linux/io_uring.h>
+   #define STORAGEBENCHIOURING_SUPPORTED
+#endif
+
+
+#ifdef STORAGEBENCHIOURING_SUPPORTED
+
+/**
+ * @param ioDepth max number of ops in flight.
+ * @return false on error (with errno set), e.g. if the kernel doesn't support io_uring.
+ */
+bool StorageBenchIoUring::init(unsigned ioDepth)
+{
+   this->ioDepth = ioDepth;
+
+   return ring.init(ioDepth);
+}
+
+/**
+ * Run the ops with up to ioDepth ops in flight: the first ops are submitted together and
+ * each completed op is replaced by the next one, so the queue depth stays constant until the last
+ * ops complete.
+ *
+ * @param ops result of each op is set on return.
+ * @param outLatency latency of each op from submission to completion is recorded here (may be
+ *    NULL).
+ * @return false if submission failed (with errno set); individual op errors are only reported in
+ *    the op results.
+ */
+bool StorageBenchIoUring::run(std::vector<StorageBenchIoUringOp>& ops,
+   LatencyHistogram* outLatency)
+{
+   const size_t maxInFlight = ioDepth;
+
+   std::vector<struct iovec> iovecs(ops.size() );
+   std::vector<TimeFine> submitTimes(ops.size() );
+
+   size_t numQueued = 0;
+   size_t numInFlight = 0; // queued, but not completed yet
+   size_t numCompleted = 0;
+
+   while (numCompleted < ops.size() )
+   {
+      for ( ; (numQueued < ops.size() ) && (numInFlight < maxInFlight); numQueued++, numInFlight++)
+      {
+         // (ring has at least ioDepth entries, so this never needs to submit)
+         struct io_uring_sqe* sqe = ring.getFreeSqe();
+         StorageBenchIoUringOp& op = ops[numQueued];
+
+         iovecs[numQueued].iov_base = op.buf;
+         iovecs[numQueued].iov_len = op.len;
+
+         sqe->opcode = op.isWrite ? IORING_OP_WRITEV : IORING_OP_READV;
+         sqe->fd = op.fd;
+         sqe->addr = (uint64_t)(uintptr_t)&iovecs[numQueued];
+         sqe->len = 1;
+         sqe->off = op.offset;
+         sqe->user_data = numQueued;
+
+         ring.queueSqe();
+
+         submitTimes[numQueued].setToNow();
+      }
+
+      // wait for at least one completion per syscall, so that each op gets its own timestamp
+      int waitRes = ring.submitAndWait(1, 0);
+      if (waitRes < 0)
+      {
+         if (waitRes == -EINTR)
+            continue;
+
+         // queued ops must complete before their buffers can be reused
+         drainInFlight(numInFlight);
+
+         errno = -waitRes;
+         return false;
+      }
+
+      uint64_t opIndex;
+      int opRes;
+
+      while (ring.popCompletion(opIndex, opRes) )
+      {
+         ops[opIndex].result = opRes;
+
+         if (outLatency)
+            outLatency->record(submitTimes[opIndex].elapsedMicro() );
+
+         numCompleted++;
+         numInFlight--;
+      }
+   }
+
+   return true;
+}
+
+/**
+ * Submit the remaining queued ops and wait for the completions of all ops in flight after an error
+ * (results are dropped). Gives up if submitting fails again.
+ */
+void StorageBenchIoUring::drainInFlight(size_t numInFlight)
+{
+   uint64_t opIndex;
+   int opRes;
+
+   while (numInFlight)
+   {
+      if (ring.submitAndWait(1, 0) < 0)
+         return;
+
+      while (numInFlight && ring.popCompletion(opIndex, opRes) )
+         numInFlight--;
+   }
+}
+
+#else // STORAGEBENCHIOURING_SUPPORTED
+
+bool StorageBenchIoUring::init(unsigned ioDepth)
+{
+   errno = ENOSYS;
+   return false;
+}
+
+bool StorageBenchIoUring::run(std::vector<StorageBenchIoUringOp>& ops,
+   LatencyHistogram* outLatency)
+{
+   errno = ENOSYS;
+   return false;
+}
+
+void StorageBenchIoUring::drainInFlight(size_t numInFlight)
+{
+}
+
+#endif // STORAGEBENCHIOURING_SUPPORTED
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <common/toolkit/IoUring.h>
+#include <common/toolkit/LatencyHistogram.h>
+#include <common/toolkit/TimeFine.h>
+#include <common/Common.h>
+
+#include <sys/uio.h>
+
+
+struct StorageBenchIoUringOp
+{
+   bool isWrite;
+   int fd;
+   char* buf;
+   size_t len;
+   off_t offset;
+
+   ssize_t result; // set by StorageBenchIoUring::run(): bytes transferred or -errno
+};
+
+/**
+ * Reads/writes of the storage benchmark on an IoUring, with up to ioDepth ops in flight.
+ *
+ * Not thread-safe; each benchmark thread has its own ring and only one work package of a thread
+ * is processed at a time.
+ */
+class StorageBenchIoUring
+{
+   public:
+      StorageBenchIoUring() : ioDepth(0) {}
+
+      bool init(unsigned ioDepth);
+      bool run(std::vector<StorageBenchIoUringOp>& ops, LatencyHistogram* outLatency);
+
+
+   private:
+      IoUring ring;
+      unsigned ioDepth; // max ops in flight
+
+      void drainInFlight(size_t numInFlight);
+
+
+   public:
+      // inliners
+
+      unsigned getIoDepth() const
+      {
+         return ioDepth;
+      }
+};
@@ -2,9 +2,11 @@
 
 
 int StorageBenchOperator::initAndStartStorageBench(UInt16List* targetIDs, int64_t blocksize,
-   int64_t size, int threads, bool odirect, StorageBenchType type)
+   int64_t size, int threads, bool odirect, StorageBenchType type,
+   const StorageBenchOptions& options)
 {
-   return this->slave.initAndStartStorageBench(targetIDs, blocksize, size, threads, odirect, type);
+   return this->slave.initAndStartStorageBench(targetIDs, blocksize, size, threads, odirect, type,
+      options);
 }
 
 int StorageBenchOperator::cleanup(UInt16List* targetIDs)
@@ -18,9 +20,9 @@ int StorageBenchOperator::stopBenchmark()
 }
 
 StorageBenchStatus StorageBenchOperator::getStatusWithResults(UInt16List* targetIDs,
-   StorageBenchResultsMap* outResults)
+   StorageBenchResultsMap* outResults, StorageBenchLatencyMap* outLatencies)
 {
-   return this->slave.getStatusWithResults(targetIDs, outResults);
+   return this->slave.getStatusWithResults(targetIDs, outResults, outLatencies);
 }
 
 void StorageBenchOperator::shutdownBenchmark()
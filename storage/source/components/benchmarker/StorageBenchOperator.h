@@ -10,12 +10,12 @@ class StorageBenchOperator
       StorageBenchOperator() {}
 
       int initAndStartStorageBench(UInt16List* targetIDs, int64_t blocksize, int64_t size,
-         int threads, bool odirect, StorageBenchType type);
+         int threads, bool odirect, StorageBenchType type, const StorageBenchOptions& options);
 
       int cleanup(UInt16List* targetIDs);
       int stopBenchmark();
       StorageBenchStatus getStatusWithResults(UInt16List* targetIDs,
-         StorageBenchResultsMap* outResults);
+         StorageBenchResultsMap* outResults, StorageBenchLatencyMap* outLatencies);
       void shutdownBenchmark();
       void waitForShutdownBenchmark();
 
@@ -9,6 +9,9 @@
 
 #define STORAGEBENCH_STORAGE_SUBDIR_NAME              "benchmark"
 #define STORAGEBENCH_READ_PIPE_TIMEOUT_MS             2000
+#define STORAGEBENCH_CHUNKMETA_OPS_PER_WORK           64 // chunk ops per work package
+#define STORAGEBENCH_MAX_IODEPTH                      1024
+#define STORAGEBENCH_IOURING_OPS_PER_DEPTH            16 // work package size in ops (x ioDepth)
 
 
 /*
@@ -19,11 +22,13 @@
  * @param size the size for the benchmark
  * @param threads the number (simulated clients) of threads for the benchmark
  * @param type the type of the benchmark
+ * @param options io engine and read/write mix
  * @return the error code, 0 if the benchmark was initialize successful (STORAGEBENCH_ERROR..)
  *
  */
 int StorageBenchSlave::initAndStartStorageBench(UInt16List* targetIDs, int64_t blocksize,
-   int64_t size, int threads, bool odirect, StorageBenchType type)
+   int64_t size, int threads, bool odirect, StorageBenchType type,
+   const StorageBenchOptions& options)
 {
    const char* logContext = "Storage Benchmark (init)";
 
@@ -44,7 +49,7 @@ int StorageBenchSlave::initAndStartStorageBench(UInt16List* targetIDs, int64_t b
    }
    else
    {
-      retVal = initStorageBench(targetIDs, blocksize, size, threads, odirect, type);
+      retVal = initStorageBench(targetIDs, blocksize, size, threads, odirect, type, options);
    }
 
    if(retVal == STORAGEBENCH_ERROR_NO_ERROR)
@@ -91,33 +96,52 @@ int StorageBenchSlave::initAndStartStorageBench(UInt16List* targetIDs, int64_t b
  * @param size the size for the benchmark
  * @param threads the number (simulated clients) of threads for the benchmark
  * @param type the type of the benchmark
+ * @param options io engine and read/write mix
  * @return the error code, 0 if the benchmark was initialize successful (STORAGEBENCH_ERROR..)
  *
  */
 int StorageBenchSlave::initStorageBench(UInt16List* targetIDs, int64_t blocksize,
-   int64_t size, int threads, bool odirect, StorageBenchType type)
+   int64_t size, int threads, bool odirect, StorageBenchType type,
+   const StorageBenchOptions& options)
 {
    const char* logContext = "Storage Benchmark (init)";
    LogContext(logContext).log(Log_DEBUG, "Initializing benchmark ...");
 
-   this->benchType = type;
+   this->params.type = type;
    this->targetIDs = new auto(*targetIDs);
-   this->blocksize = blocksize;
-   this->size = size;
+   this->params.blocksize = blocksize;
+   this->params.size = size;
+   this->params.options = options;
    this->numThreads = threads;
    this->odirect = odirect;
    this->numThreadsDone = 0;
 
+   if (!checkOptions() )
+   {
+      this->lastRunErrorCode = STORAGEBENCH_ERROR_INIT_INVALID_OPTIONS;
+      this->status = StorageBenchStatus_ERROR;
+      return STORAGEBENCH_ERROR_INIT_INVALID_OPTIONS;
+   }
+
    initThreadData();
 
-   if (!initTransferData())
+   if (!initIoUrings() )
+   {
+      this->lastRunErrorCode = STORAGEBENCH_ERROR_INIT_IO_ENGINE;
+      this->status = StorageBenchStatus_ERROR;
+      return STORAGEBENCH_ERROR_INIT_IO_ENGINE;
+   }
+
+   if ( (this->params.type != StorageBenchType_CHUNKMETA) && !initTransferData() )
    {
       this->lastRunErrorCode = STORAGEBENCH_ERROR_INIT_TRANSFER_DATA;
       this->status = StorageBenchStatus_ERROR;
       return STORAGEBENCH_ERROR_INIT_TRANSFER_DATA;
    }
 
-   if (this->benchType == StorageBenchType_READ)
+   if ( (this->params.type == StorageBenchType_READ) ||
+        (this->params.type == StorageBenchType_RANDREAD) ||
+        (this->params.type == StorageBenchType_RANDMIXED) )
    {
       if (!checkReadData())
       {
@@ -131,7 +155,9 @@ int StorageBenchSlave::initStorageBench(UInt16List* targetIDs, int64_t blocksize
       }
    }
    else
-   if (this->benchType == StorageBenchType_WRITE)
+   if ( (this->params.type == StorageBenchType_WRITE) ||
+        (this->params.type == StorageBenchType_RANDWRITE) ||
+        (this->params.type == StorageBenchType_CHUNKMETA) )
    {
       if (!createBenchmarkFolder() )
       {
@@ -146,7 +172,7 @@ int StorageBenchSlave::initStorageBench(UInt16List* targetIDs, int64_t blocksize
    else
    {
       LogContext(logContext).logErr(std::string(
-         "Unknown benchmark type: " + StringTk::uintToStr(this->benchType) ) );
+         "Unknown benchmark type: " + StringTk::uintToStr(this->params.type) ) );
       return STORAGEBENCH_ERROR_INITIALIZATION_ERROR;
    }
 
@@ -158,6 +184,62 @@ int StorageBenchSlave::initStorageBench(UInt16List* targetIDs, int64_t blocksize
    return STORAGEBENCH_ERROR_NO_ERROR;
 }
 
+/*
+ * checks the benchmark parameters, incl. the ones which are only used by some benchmark types
+ *
+ * @return true if the parameters are valid for the benchmark type
+ *
+ */
+bool StorageBenchSlave::checkOptions()
+{
+   const char* logContext = "Storage Benchmark (init)";
+
+   const StorageBenchOptions& options = this->params.options;
+
+   if (this->params.size <= 0)
+   {
+      LogContext(logContext).logErr("Invalid size: " + StringTk::int64ToStr(this->params.size) );
+      return false;
+   }
+
+   if ( (this->params.type != StorageBenchType_CHUNKMETA) && (this->params.blocksize <= 0) )
+   {
+      LogContext(logContext).logErr(
+         "Invalid blocksize: " + StringTk::int64ToStr(this->params.blocksize) );
+      return false;
+   }
+
+   if (STORAGEBENCHTYPE_IS_RANDOM(this->params.type) &&
+       (this->params.size < this->params.blocksize) )
+   {
+      LogContext(logContext).logErr("Size must not be smaller than blocksize for random I/O.");
+      return false;
+   }
+
+   if (options.readPercent > 100)
+   {
+      LogContext(logContext).logErr(
+         "Invalid read percentage: " + StringTk::uintToStr(options.readPercent) );
+      return false;
+   }
+
+   if ( (options.ioEngine != StorageBenchIOEngine_SYNC) &&
+        (options.ioEngine != StorageBenchIOEngine_IOURING) )
+   {
+      LogContext(logContext).logErr("Unknown I/O engine: " + StringTk::intToStr(options.ioEngine) );
+      return false;
+   }
+
+   if ( (options.ioEngine == StorageBenchIOEngine_IOURING) &&
+        ( (options.ioDepth < 1) || (options.ioDepth > STORAGEBENCH_MAX_IODEPTH) ) )
+   {
+      LogContext(logContext).logErr("Invalid I/O depth: " + StringTk::uintToStr(options.ioDepth) );
+      return false;
+   }
+
+   return true;
+}
+
 /*
  * initialize the data which will be written to the disk, the size of the transfer data a equal
  * to the blocksize and initialized with random characters
@@ -172,13 +254,13 @@ bool StorageBenchSlave::initTransferData()
    LogContext(logContext).log(Log_DEBUG, std::string("Initializing random data..."));
 
    void* rawTransferData;
-   if (posix_memalign(&rawTransferData, 4096, blocksize) != 0)
+   if (posix_memalign(&rawTransferData, 4096, this->params.blocksize) != 0)
       return false;
    transferData.reset(static_cast<char*>(rawTransferData));
 
    Random randomizer = Random();
 
-   for (int64_t counter = 0; counter < this->blocksize; counter++)
+   for (int64_t counter = 0; counter < this->params.blocksize; counter++)
    {
       this->transferData[counter] = randomizer.getNextInt();
    }
@@ -218,6 +300,8 @@ void StorageBenchSlave::initThreadData()
          data.engagedSize = 0;
          data.fileDescriptor = 0;
          data.neededTime = 0;
+         data.randomizer = Random(data.randomizer.getNextInt() + allThreadCounter);
+         data.latency = std::make_shared<LatencyHistogram>();
 
 
          this->threadData[allThreadCounter] = data;
@@ -254,11 +338,9 @@ void StorageBenchSlave::run()
          LOG_DEBUG(logContext, Log_DEBUG, std::string("- threadID: ") +
             StringTk::intToStr(iter->first) );
          LOG_DEBUG(logContext, Log_DEBUG, std::string("- type: ") +
-            StringTk::intToStr(this->benchType) );
+            StringTk::intToStr(this->params.type) );
 
-         StorageBenchWork* work = new StorageBenchWork(iter->second.targetID, iter->first,
-            iter->second.fileDescriptor, this->benchType, getNextPackageSize(iter->first),
-            this->threadCommunication, this->transferData.get());
+         StorageBenchWork* work = createWork(iter->first, getNextPackageSize(iter->first) );
 
          app->getWorkQueue(iter->second.targetID)->addIndirectWork(work);
       }
@@ -334,9 +416,7 @@ void StorageBenchSlave::run()
          // data size for the thread is bigger then 0
          if (workSize != 0)
          {
-            StorageBenchWork* work = new StorageBenchWork(currentData->targetID, threadID,
-               currentData->fileDescriptor, this->benchType, workSize, this->threadCommunication,
-               this->transferData.get());
+            StorageBenchWork* work = createWork(threadID, workSize);
             app->getWorkQueue(currentData->targetID)->addIndirectWork(work);
          }
          else
@@ -402,6 +482,9 @@ void StorageBenchSlave::run()
    }
    else
    {
+      closeFiles();
+      freeTransferData();
+
       this->lastRunErrorCode = STORAGEBENCH_ERROR_RUNTIME_OPEN_FILES;
       setStatus(StorageBenchStatus_ERROR);
    }
@@ -440,10 +523,10 @@ bool StorageBenchSlave::checkReadData()
 
       if (error != -1)
       {
-         if (fileStat.st_size < this->size)
+         if (fileStat.st_size < this->params.size)
          {
             LogContext(logContext).logErr(std::string("Existing benchmark file too small. "
-               "Requested file size: " + StringTk::int64ToStr(this->size) + " "
+               "Requested file size: " + StringTk::int64ToStr(this->params.size) + " "
                "File size: " + StringTk::intToStr(fileStat.st_size)));
             return false;
          }
@@ -526,14 +609,34 @@ bool StorageBenchSlave::openFiles()
       // open file
 
       int directFlag = this->odirect ? O_DIRECT : 0;
-      if(this->benchType == StorageBenchType_READ)
+      if (this->params.type == StorageBenchType_CHUNKMETA)
+      { // chunks are created in the benchmark dir (with the usual chunk dir layout)
+         path = target->getPath().str() + "/" STORAGEBENCH_STORAGE_SUBDIR_NAME;
+         fileDescriptor = open(path.c_str(), O_RDONLY | O_DIRECTORY);
+      }
+      else
+      if( (this->params.type == StorageBenchType_READ) ||
+          (this->params.type == StorageBenchType_RANDREAD) )
          fileDescriptor = open(path.c_str(), O_RDONLY | directFlag);
+      else
+      if(this->params.type == StorageBenchType_RANDMIXED)
+         fileDescriptor = open(path.c_str(), O_RDWR | directFlag);
+      else
+      if(this->params.type == StorageBenchType_RANDWRITE)
+         fileDescriptor = open(path.c_str(), O_CREAT | O_WRONLY | directFlag, openMode);
       else
          fileDescriptor = open(path.c_str(), O_CREAT | O_WRONLY | O_TRUNC | directFlag, openMode);
 
       if (fileDescriptor != -1)
          iter->second.fileDescriptor = fileDescriptor;
       else
+      if (this->params.type == StorageBenchType_CHUNKMETA)
+      {
+         LogContext(logContext).logErr("Couldn't open benchmark directory: " + path + "; "
+            "SysErr: " + System::getErrString() );
+         return false;
+      }
+      else
       { // open failed
          LogContext(logContext).logErr("Couldn't open benchmark file: " + path + "; "
             "SysErr: " + System::getErrString() );
@@ -554,7 +657,13 @@ bool StorageBenchSlave::closeFiles()
       iter != threadData.end();
       iter++)
    {
+      iter->second.ioUring.reset();
+
+      if (iter->second.fileDescriptor <= 0)
+         continue; // not opened (because an earlier open failed)
+
       int tmpRetVal = close(iter->second.fileDescriptor);
+      iter->second.fileDescriptor = 0;
 
       if (tmpRetVal != 0)
       {
@@ -584,9 +693,60 @@ bool StorageBenchSlave::closeFiles()
    return retVal;
 }
 
+/*
+ * creates an io_uring for each thread if the benchmark uses the io_uring engine
+ *
+ * @return true if the rings are ready (or not needed),
+ *         false if a error occurred (e.g. io_uring not supported by the kernel)
+ *
+ */
+bool StorageBenchSlave::initIoUrings()
+{
+   const char* logContext = "Storage Benchmark (io_uring)";
+
+   if (this->params.options.ioEngine != StorageBenchIOEngine_IOURING)
+      return true;
+
+   for(StorageBenchThreadDataMapIter iter = threadData.begin();
+      iter != threadData.end();
+      iter++)
+   {
+      auto ioUring = std::make_shared<StorageBenchIoUring>();
+
+      if (!ioUring->init(this->params.options.ioDepth) )
+      {
+         LogContext(logContext).logErr("Unable to set up io_uring. SysErr: " +
+            System::getErrString() );
+         return false;
+      }
+
+      iter->second.ioUring = ioUring;
+   }
+
+   return true;
+}
+
+/*
+ * creates the next work package for the given thread
+ *
+ * @param threadID the threadID
+ * @param workSize the result of getNextPackageSize() for this package
+ *
+ */
+StorageBenchWork* StorageBenchSlave::createWork(int threadID, int64_t workSize)
+{
+   StorageBenchThreadData* currentData = &this->threadData[threadID];
+
+   // (getNextPackageSize() already added this package to the engaged size)
+   int64_t offset = currentData->engagedSize - workSize;
+
+   return new StorageBenchWork(threadID, currentData, &this->params, offset, workSize,
+      this->threadCommunication, this->transferData.get() );
+}
+
 /*
  * calculates the size (bytes) of the data which will be written on the disk by the worker with
- * the next work package for the given thread
+ * the next work package for the given thread (number of ops for StorageBenchType_CHUNKMETA)
  *
  * @param threadID the threadID
  * @return the size of the data for next work package in bytes,
@@ -595,8 +755,22 @@ bool StorageBenchSlave::closeFiles()
  */
 int64_t StorageBenchSlave::getNextPackageSize(int threadID)
 {
-   int64_t retVal = BEEGFS_MIN(this->blocksize,
-      this->size - this->threadData[threadID].engagedSize);
+   int64_t packageSize = this->params.blocksize;
+   int64_t totalSize = this->params.size;
+
+   if (this->params.type == StorageBenchType_CHUNKMETA)
+   { // create, stat and unlink each chunk
+      packageSize = STORAGEBENCH_CHUNKMETA_OPS_PER_WORK;
+      totalSize = 3 * this->params.size;
+   }
+   else
+   if (this->params.options.ioEngine == StorageBenchIOEngine_IOURING)
+   { // big packages, so that the ring only drains at the end of a package
+      packageSize *= this->params.options.ioDepth * STORAGEBENCH_IOURING_OPS_PER_DEPTH;
+   }
+
+   int64_t retVal = BEEGFS_MIN(packageSize,
+      totalSize - this->threadData[threadID].engagedSize);
    this->threadData[threadID].engagedSize += retVal;
 
    return retVal;
@@ -607,7 +781,8 @@ int64_t StorageBenchSlave::getNextPackageSize(int threadID)
  * calculates the throughput (kB/s) of the given target
  *
  * @param targetID the targetID
- * @return the throughput of the given target in kilobytes per second
+ * @return the throughput of the given target in kilobytes per second (ops per second for
+ *         StorageBenchType_CHUNKMETA)
  *
  */
 int64_t StorageBenchSlave::getResult(uint16_t targetID)
@@ -639,24 +814,59 @@ int64_t StorageBenchSlave::getResult(uint16_t targetID)
    if ( (size == 0) || (time == 0) )
       return 0;
 
+   if (this->params.type == StorageBenchType_CHUNKMETA)
+      return (size * 1000) / time;
+
    // input: size in bytes, time in milliseconds,
    // output: in kilobytes per second
    return ( (size * 1000) / (time * 1024) );
 }
 
 /*
- * calculates the throughput (kB/s) of the given targets
+ * collects the latencies of all ops of the threads of the given target
+ *
+ * @param targetID the targetID
+ * @return latency histogram of the given target
+ *
+ */
+LatencyHistogramData StorageBenchSlave::getLatency(uint16_t targetID)
+{
+   LatencyHistogramData latency;
+
+   for(StorageBenchThreadDataMapIter iter = this->threadData.begin();
+      iter != this->threadData.end();
+      iter++)
+   {
+      if ( (iter->second.targetID == targetID) && iter->second.latency)
+      {
+         LatencyHistogramData threadLatency;
+
+         iter->second.latency->snapshot(threadLatency);
+         latency.add(threadLatency);
+      }
+   }
+
+   return latency;
+}
+
+/*
+ * calculates the throughput (kB/s) and latencies of the given targets
  *
  * @param targetIDs the list of targetIDs
  * @param outResults a initialized map for the results, which contains the results after
  *        execution of the method
+ * @param outLatencies a initialized map for the latencies (may be NULL)
  *
  */
-void StorageBenchSlave::getResults(UInt16List* targetIDs, StorageBenchResultsMap* outResults)
+void StorageBenchSlave::getResults(UInt16List* targetIDs, StorageBenchResultsMap* outResults,
+   StorageBenchLatencyMap* outLatencies)
 {
    for (UInt16ListIter iter = targetIDs->begin(); iter != targetIDs->end(); iter++)
    {
       (*outResults)[*iter] = getResult(*iter);
+
+      if (outLatencies)
+         (*outLatencies)[*iter] = getLatency(*iter);
    }
 }
 
@@ -681,13 +891,14 @@ void StorageBenchSlave::getAllResults(StorageBenchResultsMap* outResults)
  * @param targetIDs the list of targetIDs
  * @param outResults a initialized map for the results, which contains the results after
  *        execution of the method
+ * @param outLatencies a initialized map for the latencies (may be NULL)
  * @return the status of the benchmark
  *
  */
 StorageBenchStatus StorageBenchSlave::getStatusWithResults(UInt16List* targetIDs,
-   StorageBenchResultsMap* outResults)
+   StorageBenchResultsMap* outResults, StorageBenchLatencyMap* outLatencies)
 {
-   getResults(targetIDs, outResults);
+   getResults(targetIDs, outResults, outLatencies);
    return getStatus();
 }
 
@@ -797,6 +1008,19 @@ int StorageBenchSlave::cleanup(UInt16List* targetIDs)
             }
          }
          else
+         if ( (retVal == 0) && S_ISDIR(statData.st_mode) )
+         { // chunk dirs of a chunk ops benchmark that was aborted
+            if (!StorageTk::removeDirRecursive(filePath) )
+            {
+               LogContext(logContext).logErr(
+                  "Unable to delete directory in benchmark directory: " + filePath);
+               this->lastRunErrorCode = STORAGEBENCH_ERROR_RUNTIME_DELETE_FOLDER;
+
+               closedir(dir);
+               return STORAGEBENCH_ERROR_RUNTIME_DELETE_FOLDER;
+            }
+         }
+         else
          if(!S_ISREG(statData.st_mode))
              LogContext(logContext).logErr("Unable to delete files in benchmark directory: " +
                 path + " It's not a regular file.");
@@ -5,8 +5,12 @@
 #include <common/threading/Condition.h>
 #include <common/threading/PThread.h>
 #include <common/toolkit/Pipe.h>
+#include <common/toolkit/Random.h>
 #include <common/toolkit/TimeFine.h>
 #include <common/Common.h>
+#include "StorageBenchIoUring.h"
+
+class StorageBenchWork;
 
 #include <mutex>
 
@@ -15,9 +19,22 @@ struct StorageBenchThreadData
 {
    uint16_t targetID;
    int targetThreadID;
-   int64_t engagedSize; // amount of data which was submitted for write/read
-   int fileDescriptor;
+   int64_t engagedSize; // amount of data (ops for CHUNKMETA) which was submitted for write/read
+   int fileDescriptor; // benchmark file; benchmark dir of the target for CHUNKMETA
    int64_t neededTime;
+
+   Random randomizer; // for random offsets and the read/write mix
+   std::shared_ptr<LatencyHistogram> latency; // per op (shared_ptr only to keep this copyable)
+   std::shared_ptr<StorageBenchIoUring> ioUring; // only for StorageBenchIOEngine_IOURING
+};
+
+// parameters of a benchmark run, which are the same for all threads
+struct StorageBenchParams
+{
+   StorageBenchType type;
+   int64_t blocksize;
+   int64_t size; // per thread
+   StorageBenchOptions options;
 };
 
 // deleter functor for transferData
@@ -42,9 +59,7 @@ class StorageBenchSlave : public PThread
          log("Storage Benchmark"),
          lastRunErrorCode(STORAGEBENCH_ERROR_NO_ERROR),
          status(StorageBenchStatus_UNINITIALIZED),
-         benchType(StorageBenchType_NONE),
-         blocksize(1),  // useless defaults
-         size(1),       // useless defaults
+         params{StorageBenchType_NONE, 1, 1, {}}, // useless defaults for blocksize and size
          numThreads(1), // useless defaults
          numThreadsDone(0),
          targetIDs(NULL),
@@ -58,12 +73,12 @@ class StorageBenchSlave : public PThread
       }
 
       int initAndStartStorageBench(UInt16List* targetIDs, int64_t blocksize, int64_t size,
-         int threads, bool odirect, StorageBenchType type);
+         int threads, bool odirect, StorageBenchType type, const StorageBenchOptions& options);
 
       int cleanup(UInt16List* targetIDs);
       int stopBenchmark();
       StorageBenchStatus getStatusWithResults(UInt16List* targetIDs,
-         StorageBenchResultsMap* outResults);
+         StorageBenchResultsMap* outResults, StorageBenchLatencyMap* outLatencies);
       void shutdownBenchmark();
       void waitForShutdownBenchmark();
 
@@ -78,9 +93,7 @@ class StorageBenchSlave : public PThread
       int lastRunErrorCode; // STORAGEBENCH_ERROR_...
 
       StorageBenchStatus status;
-      StorageBenchType benchType;
-      int64_t blocksize;
-      int64_t size;
+      StorageBenchParams params;
       int numThreads;
       bool odirect;
       unsigned int numThreadsDone;
@@ -95,7 +108,8 @@ class StorageBenchSlave : public PThread
       virtual void run();
 
       int initStorageBench(UInt16List* targetIDs, int64_t blocksize, int64_t size,
-         int threads, bool odirect, StorageBenchType type);
+         int threads, bool odirect, StorageBenchType type, const StorageBenchOptions& options);
+      bool checkOptions(void);
       bool initTransferData(void);
       void initThreadData();
       void freeTransferData();
@@ -104,10 +118,14 @@ class StorageBenchSlave : public PThread
       bool createBenchmarkFolder(void);
       bool openFiles(void);
       bool closeFiles(void);
+      bool initIoUrings(void);
 
+      StorageBenchWork* createWork(int threadID, int64_t workSize);
       int64_t getNextPackageSize(int threadID);
       int64_t getResult(uint16_t targetID);
-      void getResults(UInt16List* targetIDs, StorageBenchResultsMap* outResults);
+      LatencyHistogramData getLatency(uint16_t targetID);
+      void getResults(UInt16List* targetIDs, StorageBenchResultsMap* outResults,
+         StorageBenchLatencyMap* outLatencies);
       void getAllResults(StorageBenchResultsMap* outResults);
 
       void setStatus(StorageBenchStatus newStatus)
@@ -134,7 +152,7 @@ class StorageBenchSlave : public PThread
 
       StorageBenchType getType()
       {
-         return this->benchType;
+         return this->params.type;
       }
 
       UInt16List* getTargetIDs()
@@ -184,7 +184,12 @@ FhgfsOpsErr BuddyResyncerFileSyncSlave::doResync(std::string& chunkPathStr, uint
          goto cleanup;
       }
 
-      readRes = read(fd, data.get(), SYNC_BLOCK_SIZE);
+      // (buddy gets uncompressed data and compresses according to its own config)
+      if (target->getHasCompressedChunks())
+         readRes = app->getChunkCompression()->read(fd, entryID, data.get(), SYNC_BLOCK_SIZE,
+            offset);
+      else
+         readRes = read(fd, data.get(), SYNC_BLOCK_SIZE);
 
       if( readRes == -1)
       {
@@ -0,0 +1,170 @@
+#include <common/app/log/LogContext.h>
+#include <net/msghelpers/MsgHelperIO.h>
+#include "ReadAheadPrefetcher.h"
+
+
+ReadAheadPrefetcherSlave::ReadAheadPrefetcherSlave(ReadAheadPrefetcher& prefetcher,
+   unsigned slaveNum) :
+   PThread("ReadAhead" + StringTk::uintToStr(slaveNum) ),
+   prefetcher(prefetcher)
+{
+}
+
+void ReadAheadPrefetcherSlave::run()
+{
+   try
+   {
+      registerSignalHandler();
+
+      ReadAheadPrefetcher::Job job;
+
+      while(prefetcher.waitForJob(job) )
+      {
+         ReadAheadPrefetcher::readAhead(job.fd, job.ranges);
+         close(job.fd);
+      }
+
+      LogContext("ReadAheadPrefetcher").log(Log_DEBUG, "Component stopped.");
+   }
+   catch(std::exception& e)
+   {
+      PThread::getCurrentThreadApp()->handleComponentException(e);
+   }
+}
+
+
+ReadAheadPrefetcher::ReadAheadPrefetcher(unsigned numThreads,
+   const std::vector<uint16_t>& targetIDs) :
+   terminate(false)
+{
+   for(unsigned i = 0; i < numThreads; i++)
+      slaves.emplace_back(*this, i + 1);
+
+   for(auto targetID : targetIDs)
+      targetStats[targetID]; // (default-construct counters)
+}
+
+ReadAheadPrefetcher::~ReadAheadPrefetcher()
+{
+   for(const auto& job : queue)
+      close(job.fd);
+}
+
+void ReadAheadPrefetcher::startSlaves()
+{
+   for(auto& slave : slaves)
+      slave.start();
+}
+
+void ReadAheadPrefetcher::stopSlaves()
+{
+   const std::lock_guard<Mutex> lock(queueMutex);
+
+   terminate = true;
+   queueCond.broadcast();
+}
+
+void ReadAheadPrefetcher::joinSlaves()
+{
+   for(auto& slave : slaves)
+      slave.join();
+}
+
+/**
+ * Account the read of the given advice and issue its read-ahead ranges (if any).
+ *
+ * @param fd chunk file fd, which is duplicated for asynchronous read-ahead (so the caller may close
+ *    it before the read-ahead is issued)
+ */
+void ReadAheadPrefetcher::prefetch(uint16_t targetID, int fd, const ReadAheadAdvice& advice)
+{
+   auto statsIter = targetStats.find(targetID);
+   if(statsIter == targetStats.end() )
+      return; // (should not happen, targets are known at startup)
+
+   TargetStats& stats = statsIter->second;
+
+   if(advice.isHit)
+      stats.numHits.fetch_add(1, std::memory_order_relaxed);
+   else
+   if(advice.isMiss)
+      stats.numMisses.fetch_add(1, std::memory_order_relaxed);
+
+   if(advice.ranges.empty() )
+      return;
+
+   if(slaves.empty() )
+   { // no async read-ahead => issue directly
+      readAhead(fd, advice.ranges);
+   }
+   else
+   {
+      const std::lock_guard<Mutex> lock(queueMutex);
+
+      if(terminate || (queue.size() >= READAHEADPREFETCHER_MAX_QUEUE_LEN) )
+      {
+         stats.numDropped.fetch_add(1, std::memory_order_relaxed);
+         return;
+      }
+
+      const int dupFD = dup(fd);
+      if(dupFD < 0)
+      {
+         stats.numDropped.fetch_add(1, std::memory_order_relaxed);
+         return;
+      }
+
+      queue.push_back({dupFD, advice.ranges});
+      queueCond.signal();
+   }
+
+   for(const auto& range : advice.ranges)
+   {
+      stats.numRanges.fetch_add(1, std::memory_order_relaxed);
+      stats.numBytes.fetch_add(range.len, std::memory_order_relaxed);
+   }
+}
+
+ReadAheadStats ReadAheadPrefetcher::getStats(uint16_t targetID) const
+{
+   ReadAheadStats stats = ReadAheadStats();
+
+   auto statsIter = targetStats.find(targetID);
+   if(statsIter == targetStats.end() )
+      return stats;
+
+   stats.numHits = statsIter->second.numHits.load(std::memory_order_relaxed);
+   stats.numMisses = statsIter->second.numMisses.load(std::memory_order_relaxed);
+   stats.numRanges = statsIter->second.numRanges.load(std::memory_order_relaxed);
+   stats.numBytes = statsIter->second.numBytes.load(std::memory_order_relaxed);
+   stats.numDropped = statsIter->second.numDropped.load(std::memory_order_relaxed);
+
+   return stats;
+}
+
+/**
+ * Wait until a job is queued.
+ *
+ * @return false if the slaves shall terminate
+ */
+bool ReadAheadPrefetcher::waitForJob(Job& outJob)
+{
+   const std::lock_guard<Mutex> lock(queueMutex);
+
+   while(queue.empty() && !terminate)
+      queueCond.wait(&queueMutex);
+
+   if(terminate)
+      return false;
+
+   outJob = std::move(queue.front() );
+   queue.pop_front();
+
+   return true;
+}
+
+void ReadAheadPrefetcher::readAhead(int fd, const std::vector<ReadAheadRange>& ranges)
+{
+   for(const auto& range : ranges)
+      MsgHelperIO::readAhead(fd, range.offset, range.len);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <common/threading/Condition.h>
+#include <common/threading/PThread.h>
+#include <common/Common.h>
+#include <storage/ReadAheadDetector.h>
+
+#include <atomic>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+
+
+#define READAHEADPREFETCHER_MAX_QUEUE_LEN    1024 // pending jobs, further read-ahead is dropped
+
+
+struct ReadAheadStats
+{
+   uint64_t numHits; // reads of a detected pattern that were covered by read-ahead
+   uint64_t numMisses; // reads of a detected pattern that were not covered by read-ahead
+   uint64_t numRanges; // ranges handed to the kernel for read-ahead
+   uint64_t numBytes; // bytes handed to the kernel for read-ahead
+   uint64_t numDropped; // read-ahead jobs dropped because the queue was full
+};
+
+class ReadAheadPrefetcher; // forward declaration
+
+/**
+ * Thread that issues the queued read-ahead jobs of the ReadAheadPrefetcher.
+ */
+class ReadAheadPrefetcherSlave : public PThread
+{
+   public:
+      ReadAheadPrefetcherSlave(ReadAheadPrefetcher& prefetcher, unsigned slaveNum);
+
+   private:
+      ReadAheadPrefetcher& prefetcher;
+
+      virtual void run();
+};
+
+/**
+ * Issues read-ahead (see ReadAheadDetector) asynchronously from a small pool of slave threads, so
+ * that workers don't block on posix_fadvise() when the device queue is full or the file system has
+ * to read extent metadata first. With 0 threads, read-ahead is issued directly by the caller.
+ *
+ * Also keeps read-ahead statistics per target.
+ *
+ * This is not a normal component: the slaves are started and stopped by the App together with the
+ * workers.
+ */
+class ReadAheadPrefetcher
+{
+   friend class ReadAheadPrefetcherSlave;
+
+   public:
+      ReadAheadPrefetcher(unsigned numThreads, const std::vector<uint16_t>& targetIDs);
+      ~ReadAheadPrefetcher();
+
+      void startSlaves();
+      void stopSlaves();
+      void joinSlaves();
+
+      void prefetch(uint16_t targetID, int fd, const ReadAheadAdvice& advice);
+      ReadAheadStats getStats(uint16_t targetID) const;
+
+
+   private:
+      struct Job
+      {
+         int fd; // dup of the chunk fd, closed after read-ahead
+         std::vector<ReadAheadRange> ranges;
+      };
+
+      struct TargetStats
+      {
+         TargetStats() : numHits(0), numMisses(0), numRanges(0), numBytes(0), numDropped(0) { }
+
+         std::atomic<uint64_t> numHits;
+         std::atomic<uint64_t> numMisses;
+         std::atomic<uint64_t> numRanges;
+         std::atomic<uint64_t> numBytes;
+         std::atomic<uint64_t> numDropped;
+      };
+
+      std::list<ReadAheadPrefetcherSlave> slaves;
+
+      Mutex queueMutex;
+      Condition queueCond; // signalled when a job is added or slaves shall terminate
+      std::deque<Job> queue;
+      bool terminate; // protected by queueMutex
+
+      std::map<uint16_t, TargetStats> targetStats; // fixed set of targets, so no lock needed
+
+      bool waitForJob(Job& outJob);
+      static void readAhead(int fd, const std::vector<ReadAheadRange>& ranges);
+};
@@ -1,20 +1,76 @@
 #include <common/app/log/LogContext.h>
 #include <common/benchmark/StorageBench.h>
+#include <common/storage/PathInfo.h>
+#include <common/toolkit/StorageTk.h>
 #include <common/toolkit/StringTk.h>
 #include <program/Program.h>
 #include "StorageBenchWork.h"
 
+#include <boost/lexical_cast.hpp>
+
 void StorageBenchWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
    unsigned bufOutLen)
 {
    const char* logContext = "Storage Benchmark (run)";
 
+   int workRes = 0; // return value for benchmark operator
+   ssize_t ioRes = 0; // read/write result
+
+   if ( (this->type == StorageBenchType_READ) || (this->type == StorageBenchType_WRITE) ||
+        STORAGEBENCHTYPE_IS_RANDOM(this->type) )
+   {
+      if (params->options.ioEngine == StorageBenchIOEngine_IOURING)
+         ioRes = doIoUring();
+      else
+      if (STORAGEBENCHTYPE_IS_RANDOM(this->type) )
+         ioRes = doRandomIO();
+      else
+         ioRes = doSequentialIO();
+   }
+   else
+   if (this->type == StorageBenchType_CHUNKMETA)
+   {
+      ioRes = doChunkOps();
+   }
+   else
+   { // unknown benchmark type
+      workRes = STORAGEBENCH_ERROR_WORKER_ERROR;
+      LogContext(logContext).logErr("Error: unknown benchmark type");
+   }
+
+   if(unlikely(workRes < 0) || unlikely(ioRes == -1) )
+   { // error occurred
+      if (ioRes == -1)
+      { // read or write operation failed
+         LogContext(logContext).logErr(std::string("Error: I/O failure. SysErr: ") +
+            System::getErrString() );
+      }
+
+      workRes = STORAGEBENCH_ERROR_WORKER_ERROR;
+
+      this->operatorCommunication->getWriteFD()->write(&workRes, sizeof(int) );
+   }
+   else
+   { // success
+      this->operatorCommunication->getWriteFD()->write(&this->threadID, sizeof(int) );
+   }
+}
+
+/**
+ * Sequential read/write of the whole package with the file offset of the fd (in chunks of
+ * tuneFileRead/WriteSize).
+ *
+ * @return result of the last read/write, -1 on error (with errno set).
+ */
+ssize_t StorageBenchWork::doSequentialIO()
+{
    App* app = Program::getApp();
    Config* cfg = app->getConfig();
 
-   int workRes = 0; // return value for benchmark operator
    ssize_t ioRes = 0; // read/write result
 
+   TimeFine startTime;
+
    if (this->type == StorageBenchType_READ)
    {
       size_t readSize = cfg->getTuneFileReadSize();
@@ -37,7 +93,6 @@ void StorageBenchWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
          this->bufLen, NETMSG_DEFAULT_USERID);
    }
    else
-   if (this->type == StorageBenchType_WRITE)
    {
       size_t writeSize = cfg->getTuneFileWriteSize();
       size_t toBeWritten = this->bufLen;
@@ -58,27 +113,224 @@ void StorageBenchWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
       app->getNodeOpStats()->updateNodeOp(0, StorageOpCounter_WRITEOPS,
          this->bufLen, NETMSG_DEFAULT_USERID);
    }
-   else
-   { // unknown benchmark type
-      workRes = STORAGEBENCH_ERROR_WORKER_ERROR;
-      LogContext(logContext).logErr("Error: unknown benchmark type");
-   }
 
-   if(unlikely(workRes < 0) || unlikely(ioRes == -1) )
-   { // error occurred
-      if (ioRes == -1)
-      { // read or write operation failed
-         LogContext(logContext).logErr(std::string("Error: I/O failure. SysErr: ") +
-            System::getErrString() );
+   threadData->latency->record(startTime.elapsedMicro() );
+
+   return ioRes;
+}
+
+/**
+ * One blocking pread/pwrite of blocksize at a random offset per op.
+ *
+ * @return -1 on error (with errno set).
+ */
+ssize_t StorageBenchWork::doRandomIO()
+{
+   App* app = Program::getApp();
+
+   ssize_t ioRes = 0; // read/write result
+   int64_t readBytes = 0;
+   int64_t writtenBytes = 0;
+
+   for (int64_t done = 0; done < this->bufLen; done += params->blocksize)
+   {
+      const size_t opLen = BEEGFS_MIN(params->blocksize, this->bufLen - done);
+      const off_t opOffset = getRandomOffset();
+
+      TimeFine startTime;
+
+      if (nextOpIsWrite() )
+      {
+         ioRes = pwrite(this->fileDescriptor, this->buf, opLen, opOffset);
+         writtenBytes += opLen;
+      }
+      else
+      {
+         ioRes = pread(this->fileDescriptor, this->buf, opLen, opOffset);
+         readBytes += opLen;
       }
 
-      workRes = STORAGEBENCH_ERROR_WORKER_ERROR;
+      threadData->latency->record(startTime.elapsedMicro() );
 
-      this->operatorCommunication->getWriteFD()->write(&workRes, sizeof(int) );
+      if (ioRes <= 0)
+         break;
    }
-   else
-   { // success
-      this->operatorCommunication->getWriteFD()->write(&this->threadID, sizeof(int) );
+
+   if (readBytes)
+      app->getNodeOpStats()->updateNodeOp(0, StorageOpCounter_READOPS, readBytes,
+         NETMSG_DEFAULT_USERID);
+
+   if (writtenBytes)
+      app->getNodeOpStats()->updateNodeOp(0, StorageOpCounter_WRITEOPS, writtenBytes,
+         NETMSG_DEFAULT_USERID);
+
+   return ioRes;
+}
+
+/**
+ * Submits the package as ops of blocksize to the io_uring of the thread, so that up to ioDepth
+ * ops are in flight at the same time.
+ *
+ * @return -1 on error (with errno set).
+ */
+ssize_t StorageBenchWork::doIoUring()
+{
+   App* app = Program::getApp();
+
+   std::vector<StorageBenchIoUringOp> ops;
+   int64_t readBytes = 0;
+   int64_t writtenBytes = 0;
+
+   for (int64_t done = 0; done < this->bufLen; done += params->blocksize)
+   {
+      StorageBenchIoUringOp op;
+
+      op.isWrite = nextOpIsWrite();
+      op.fd = this->fileDescriptor;
+      op.buf = this->buf;
+      op.len = BEEGFS_MIN(params->blocksize, this->bufLen - done);
+      op.offset = STORAGEBENCHTYPE_IS_RANDOM(this->type) ?
+         getRandomOffset() : this->offset + done;
+      op.result = 0;
+
+      ops.push_back(op);
+
+      if (op.isWrite)
+         writtenBytes += op.len;
+      else
+         readBytes += op.len;
+   }
+
+   if (!threadData->ioUring->run(ops, threadData->latency.get() ) )
+      return -1;
+
+   if (readBytes)
+      app->getNodeOpStats()->updateNodeOp(0, StorageOpCounter_READOPS, readBytes,
+         NETMSG_DEFAULT_USERID);
+
+   if (writtenBytes)
+      app->getNodeOpStats()->updateNodeOp(0, StorageOpCounter_WRITEOPS, writtenBytes,
+         NETMSG_DEFAULT_USERID);
+
+   for (auto iter = ops.begin(); iter != ops.end(); iter++)
+   {
+      if (iter->result < 0)
+      {
+         errno = -iter->result;
+         return -1;
+      }
+   }
+
+   return this->bufLen;
+}
+
+/**
+ * Chunk create/stat/unlink ops with the same paths and ChunkStore locking as client requests.
+ * The ops of a thread are numbered: the first <size> ops create the chunks, the next <size> ops
+ * stat them and the last <size> ops unlink them.
+ *
+ * @return -1 on error (with errno set).
+ */
+ssize_t StorageBenchWork::doChunkOps()
+{
+   const char* logContext = "Storage Benchmark (chunk ops)";
+
+   ChunkStore* chunkDirStore = Program::getApp()->getChunkDirStore();
+
+   const int targetFD = this->fileDescriptor; // benchmark dir of the target
+   const int64_t numChunks = params->size;
+
+   PathInfo pathInfo(STORAGEBENCHWORK_CHUNKMETA_CHUNK_UID,
+      getChunkParentID(threadData->targetThreadID), PATHINFO_FEATURE_ORIG);
+   SessionQuotaInfo quotaInfo(false, false, 0, 0);
+
+   for (int64_t opIndex = this->offset; opIndex < this->offset + this->bufLen; opIndex++)
+   {
+      const int64_t phase = opIndex / numChunks;
+      const std::string chunkID = getChunkID(threadData->targetThreadID, opIndex % numChunks);
+
+      Path chunkDirPath;
+      std::string chunkFilePath;
+
+      StorageTk::getChunkDirChunkFilePath(&pathInfo, chunkID, true, chunkDirPath, chunkFilePath);
+
+      TimeFine startTime;
+
+      if (phase == 0)
+      { // create
+         int fd = -1;
+
+         FhgfsOpsErr openRes = chunkDirStore->openChunkFile(targetFD, &chunkDirPath,
+            chunkFilePath, true, O_CREAT | O_WRONLY, &fd, &quotaInfo, ExceededQuotaStorePtr() );
+         if (openRes != FhgfsOpsErr_SUCCESS)
+         {
+            LogContext(logContext).logErr("Unable to create chunk: " + chunkFilePath + "; " +
+               "Error: " + boost::lexical_cast<std::string>(openRes) );
+            errno = EIO;
+            return -1;
+         }
+
+         close(fd);
+      }
+      else
+      if (phase == 1)
+      { // stat
+         struct stat statBuf;
+
+         if (fstatat(targetFD, chunkFilePath.c_str(), &statBuf, 0) == -1)
+            return -1;
+      }
+      else
+      { // unlink (and rmdir the chunk dir after the last chunk, like UnlinkLocalFileMsgEx)
+         if (unlinkat(targetFD, chunkFilePath.c_str(), 0) == -1)
+            return -1;
+
+         chunkDirStore->rmdirChunkDirPath(targetFD, &chunkDirPath);
+      }
+
+      threadData->latency->record(startTime.elapsedMicro() );
    }
+
+   return this->bufLen;
 }
 
+/**
+ * @return true if the next op of a random benchmark should be a write.
+ */
+bool StorageBenchWork::nextOpIsWrite()
+{
+   if ( (this->type == StorageBenchType_WRITE) || (this->type == StorageBenchType_RANDWRITE) )
+      return true;
+
+   if (this->type == StorageBenchType_RANDMIXED)
+      return threadData->randomizer.getNextInRange(0, 99) >= (int)params->options.readPercent;
+
+   return false;
+}
+
+/**
+ * @return blocksize-aligned offset within the benchmark file of the thread.
+ */
+int64_t StorageBenchWork::getRandomOffset()
+{
+   const int64_t numBlocks = params->size / params->blocksize;
+
+   // (two random ints, because files may have more than INT_MAX blocks)
+   const int64_t randVal = ( (int64_t)threadData->randomizer.getNextInt() << 31) |
+      threadData->randomizer.getNextInt();
+
+   return (randVal % numBlocks) * params->blocksize;
+}
+
+/**
+ * @return parent entryID of the chunks of a thread (i.e. each thread uses its own chunk dir).
+ */
+std::string StorageBenchWork::getChunkParentID(int targetThreadID)
+{
+   return "storagebench-" + StringTk::intToStr(targetThreadID);
+}
+
+std::string StorageBenchWork::getChunkID(int targetThreadID, int64_t chunkIndex)
+{
+   return StringTk::intToStr(targetThreadID) + "-" + StringTk::int64ToStr(chunkIndex);
+}
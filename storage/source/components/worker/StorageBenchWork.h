@@ -4,20 +4,34 @@
 #include <common/components/worker/Work.h>
 #include <common/toolkit/Pipe.h>
 #include <common/Common.h>
+#include <components/benchmarker/StorageBenchSlave.h>
 
 
+#define STORAGEBENCHWORK_CHUNKMETA_CHUNK_UID    0 // origParentUID of the benchmark chunks
+
 
 class StorageBenchWork: public Work
 {
    public:
-      StorageBenchWork(uint16_t targetID, int threadID, int fileDescriptor,
-         StorageBenchType type, int64_t bufLen, Pipe* operatorCommunication, char* buf)
+      /**
+       * @param threadData state of the benchmark thread; only one work package per thread may be
+       *    queued at any time.
+       * @param params must stay valid until the work is processed.
+       * @param offset offset in the benchmark file (index of the first op for CHUNKMETA).
+       * @param bufLen bytes to read/write in this package (number of ops for CHUNKMETA).
+       */
+      StorageBenchWork(int threadID, StorageBenchThreadData* threadData,
+         const StorageBenchParams* params, int64_t offset, int64_t bufLen,
+         Pipe* operatorCommunication, char* buf)
       {
-         this->targetID = targetID;
+         this->targetID = threadData->targetID;
          this->threadID = threadID;
-         this->fileDescriptor = fileDescriptor;
+         this->fileDescriptor = threadData->fileDescriptor;
+         this->threadData = threadData;
+         this->params = params;
 
-         this->type = type;
+         this->type = params->type;
+         this->offset = offset;
          this->bufLen = bufLen;
          this->operatorCommunication = operatorCommunication;
          this->buf = buf;
@@ -29,15 +43,28 @@ class StorageBenchWork: public Work
 
       void process(char* bufIn, unsigned bufInLen, char* bufOut, unsigned bufOutLen);
 
+      static std::string getChunkParentID(int targetThreadID);
+      static std::string getChunkID(int targetThreadID, int64_t chunkIndex);
+
    protected:
 
    private:
       uint16_t targetID;
       int threadID; // virtual threadID
       int fileDescriptor;
+      StorageBenchThreadData* threadData;
+      const StorageBenchParams* params;
       StorageBenchType type;
+      int64_t offset;
       int64_t bufLen;
       char* buf;
       Pipe* operatorCommunication;
-};
 
+      ssize_t doSequentialIO();
+      ssize_t doRandomIO();
+      ssize_t doIoUring();
+      ssize_t doChunkOps();
+
+      bool nextOpIsWrite();
+      int64_t getRandomOffset();
+};
@@ -48,6 +48,7 @@
 #include <net/message/storage/attribs/SetLocalAttrMsgEx.h>
 #include <net/message/storage/creating/RmChunkPathsMsgEx.h>
 #include <net/message/storage/creating/UnlinkLocalFileMsgEx.h>
+#include <net/message/storage/creating/UnlinkLocalFilesMsgEx.h>
 #include <net/message/storage/listing/ListChunkDirIncrementalMsgEx.h>
 #include <net/message/storage/mirroring/GetStorageResyncStatsMsgEx.h>
 #include <net/message/storage/mirroring/ResyncLocalFileMsgEx.h>
@@ -56,6 +57,8 @@
 #include <net/message/storage/quota/GetQuotaInfoMsgEx.h>
 #include <net/message/storage/quota/SetExceededQuotaMsgEx.h>
 #include <net/message/storage/GetHighResStatsMsgEx.h>
+#include <net/message/storage/GetLatencyStatsMsgEx.h>
+#include <net/message/storage/GetTargetLoadStatsMsgEx.h>
 #include <net/message/storage/StatStoragePathMsgEx.h>
 #include <net/message/storage/TruncLocalFileMsgEx.h>
 
@@ -149,6 +152,8 @@ std::unique_ptr<NetMessage> NetMessageFactory::createFromMsgType(unsigned short
       case NETMSGTYPE_FindOwnerResp: { msg = new FindOwnerRespMsg(); } break;
       case NETMSGTYPE_GetChunkFileAttribs: { msg = new GetChunkFileAttribsMsgEx(); } break;
       case NETMSGTYPE_GetHighResStats: { msg = new GetHighResStatsMsgEx(); } break;
+      case NETMSGTYPE_GetLatencyStats: { msg = new GetLatencyStatsMsgEx(); } break;
+      case NETMSGTYPE_GetTargetLoadStats: { msg = new GetTargetLoadStatsMsgEx(); } break;
       case NETMSGTYPE_GetQuotaInfo: {msg = new GetQuotaInfoMsgEx(); } break;
       case NETMSGTYPE_GetStorageResyncStats: { msg = new GetStorageResyncStatsMsgEx(); } break;
       case NETMSGTYPE_ListChunkDirIncremental: { msg = new ListChunkDirIncrementalMsgEx(); } break;
@@ -171,6 +176,7 @@ std::unique_ptr<NetMessage> NetMessageFactory::createFromMsgType(unsigned short
       case NETMSGTYPE_TruncLocalFileResp: { msg = new TruncLocalFileRespMsg(); } break;
       case NETMSGTYPE_UnlinkLocalFile: { msg = new UnlinkLocalFileMsgEx(); } break;
       case NETMSGTYPE_UnlinkLocalFileResp: { msg = new UnlinkLocalFileRespMsg(); } break;
+      case NETMSGTYPE_UnlinkLocalFiles: { msg = new UnlinkLocalFilesMsgEx(); } break;
 
       // session messages
       case NETMSGTYPE_CloseChunkFile: { msg = new CloseChunkFileMsgEx(); } break;
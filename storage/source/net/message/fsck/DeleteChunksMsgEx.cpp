@@ -35,6 +35,8 @@ bool DeleteChunksMsgEx::processIncoming(ResponseContext& ctx)
       { // valid targetID
          int targetFD = isMirrorFD ? *target->getMirrorFD() : *target->getChunkFD();
          int unlinkRes = unlinkat(targetFD, delPathStrRelative.c_str(), 0);
+
+         app->getChunkFDCache()->invalidate(targetFD, delPathStrRelative);
          if ( (unlinkRes == -1) && (errno != ENOENT) )
          { // error
             LogContext(logContext).logErr(
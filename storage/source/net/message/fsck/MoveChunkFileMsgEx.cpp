@@ -73,6 +73,9 @@ unsigned MoveChunkFileMsgEx::moveChunk()
 
    // perform the actual move
    renameRes = renameat(targetFD, moveFrom.c_str(), targetFD, moveTo.c_str() );
+
+   app->getChunkFDCache()->invalidate(targetFD, moveFrom);
+   app->getChunkFDCache()->invalidate(targetFD, moveTo);
    if ( renameRes != 0 )
    {
       LogContext(logContext).log(Log_CRITICAL,
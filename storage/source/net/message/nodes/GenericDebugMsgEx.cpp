@@ -8,6 +8,7 @@
 #include <toolkit/QuotaTk.h>
 #include "GenericDebugMsgEx.h"
 
+#include <iomanip>
 
 
 #define GENDBGMSG_OP_LISTOPENFILES          "listopenfiles"
@@ -17,6 +18,10 @@
 #define GENDBGMSG_OP_CHUNKLOCKSTORESIZE     "chunklockstoresize"
 #define GENDBGMSG_OP_CHUNKLOCKSTORECONTENTS "chunklockstore"
 #define GENDBGMSG_OP_SETREJECTIONRATE       "setrejectionrate"
+#define GENDBGMSG_OP_CACHESTATISTICS        "cachestats"
+#define GENDBGMSG_OP_COMPRESSIONSTATS       "compressionstats"
+#define GENDBGMSG_OP_NUMATOPOLOGY           "numatopology"
+#define GENDBGMSG_OP_READAHEADSTATS         "readaheadstats"
 
 
 bool GenericDebugMsgEx::processIncoming(ResponseContext& ctx)
@@ -111,6 +116,18 @@ std::string GenericDebugMsgEx::processCommand()
    else
    if(operation == GENDBGMSG_OP_SETREJECTIONRATE)
       responseStr = processOpSetRejectionRate(commandStream);
+   else
+   if(operation == GENDBGMSG_OP_CACHESTATISTICS)
+      responseStr = processOpCacheStatistics(commandStream);
+   else
+   if(operation == GENDBGMSG_OP_COMPRESSIONSTATS)
+      responseStr = processOpCompressionStats(commandStream);
+   else
+   if(operation == GENDBGMSG_OP_NUMATOPOLOGY)
+      responseStr = processOpNumaTopology(commandStream);
+   else
+   if(operation == GENDBGMSG_OP_READAHEADSTATS)
+      responseStr = processOpReadAheadStats(commandStream);
    else
       responseStr = "Unknown/invalid operation";
 
@@ -426,3 +443,122 @@ std::string GenericDebugMsgEx::processOpSetRejectionRate(std::istringstream& com
    return responseStream.str();
 }
 
+std::string GenericDebugMsgEx::processOpCacheStatistics(std::istringstream& commandStream)
+{
+   // protocol: no arguments
+
+   App* app = Program::getApp();
+   ChunkStore* chunkDirStore = app->getChunkDirStore();
+
+   std::ostringstream responseStream;
+
+   size_t numDirs = chunkDirStore->getCacheSize();
+   CachePolicyStats policyStats = chunkDirStore->getCacheStats();
+
+   responseStream << "Dirs: " << numDirs << std::endl;
+   responseStream << "Hot dirs: " << policyStats.numHotEntries << std::endl;
+   responseStream << "Hits: " << policyStats.numHits << std::endl;
+   responseStream << "Misses: " << policyStats.numMisses << std::endl;
+   responseStream << "Evictions: " << policyStats.numEvictions << std::endl;
+
+   ChunkFDCacheStats fdStats = app->getChunkFDCache()->getStats();
+
+   responseStream << "Chunk FDs: " << fdStats.numFDs << std::endl;
+   responseStream << "Idle chunk FDs: " << fdStats.numIdleFDs << std::endl;
+   responseStream << "Chunk opens: " << fdStats.numOpens << std::endl;
+   responseStream << "Chunk opens avoided: " << fdStats.numOpensAvoided << std::endl;
+   responseStream << "Chunk FD evictions: " << fdStats.numEvictions;
+
+   return responseStream.str();
+}
+
+std::string GenericDebugMsgEx::processOpCompressionStats(std::istringstream& commandStream)
+{
+   // protocol: no arguments
+
+   ChunkCompressionStats stats = Program::getApp()->getChunkCompression()->getStats();
+
+   std::ostringstream responseStream;
+
+   responseStream << "Blocks compressed: " << stats.numBlocksCompressed << std::endl;
+   responseStream << "Blocks incompressible: " << stats.numBlocksIncompressible << std::endl;
+   responseStream << "Blocks decompressed: " << stats.numBlocksDecompressed << std::endl;
+   responseStream << "Read-modify-writes: " << stats.numReadModifyWrites << std::endl;
+   responseStream << "Compressed bytes (raw): " << stats.compressedRawBytes << std::endl;
+   responseStream << "Compressed bytes (disk): " << stats.compressedDiskBytes << std::endl;
+   responseStream << "Compression ratio: " << std::fixed << std::setprecision(2)
+      << (stats.compressedDiskBytes ?
+         double(stats.compressedRawBytes) / stats.compressedDiskBytes : 1.0) << std::endl;
+   responseStream << "Compression CPU time (ms): " << stats.compressMicros / 1000 << std::endl;
+   responseStream << "Decompression CPU time (ms): " << stats.decompressMicros / 1000;
+
+   return responseStream.str();
+}
+
+std::string GenericDebugMsgEx::processOpNumaTopology(std::istringstream& commandStream)
+{
+   // protocol: no arguments
+
+   App* app = Program::getApp();
+   const Config* cfg = app->getConfig();
+   const StreamLisVec* streamLisVec = app->getStreamListenerVec();
+   const std::vector<int>& streamLisNumaNodes = app->getStreamListenerNumaNodes();
+
+   // workers are only bound to the node of their target with per-target workers
+   const bool targetWorkersBound =
+      cfg->getTuneDeviceNumaAffinity() && cfg->getTuneUsePerTargetWorkers();
+
+   std::ostringstream responseStream;
+
+   responseStream << "NUMA nodes: " << System::getNumNumaNodes() << std::endl;
+
+   responseStream << "Targets:" << std::endl;
+
+   for(const auto& mapping : app->getStorageTargets()->getTargets() )
+   {
+      const int numaNode = mapping.second->getNumaNode();
+
+      responseStream << "* [target id " << mapping.first << "] " <<
+         mapping.second->getPath().str() << ": NUMA node " << numaNode << "; workers " <<
+         ( (targetWorkersBound && (numaNode >= 0) ) ? "bound" : "not bound") << std::endl;
+   }
+
+   responseStream << "Network interfaces:" << std::endl;
+
+   for(const auto& nic : app->getLocalNicList() )
+      responseStream << "* " << nic.name << " (" << Socket::ipaddrToStr(nic.ipAddr) << ", " <<
+         NetworkInterfaceCard::nicTypeToString(nic.nicType) << "): NUMA node " <<
+         System::getNumaNodeOfNetDevice(nic.name) << std::endl;
+
+   responseStream << "Stream listeners:";
+
+   for(size_t i = 0; i < streamLisVec->size(); i++)
+      responseStream << std::endl << "* " << (*streamLisVec)[i]->getName() << ": NUMA node " <<
+         streamLisNumaNodes[i];
+
+   return responseStream.str();
+}
+
+std::string GenericDebugMsgEx::processOpReadAheadStats(std::istringstream& commandStream)
+{
+   // protocol: no arguments
+
+   App* app = Program::getApp();
+   ReadAheadPrefetcher* readAheadPrefetcher = app->getReadAheadPrefetcher();
+
+   std::ostringstream responseStream;
+
+   for(const auto& mapping : app->getStorageTargets()->getTargets() )
+   {
+      const ReadAheadStats stats = readAheadPrefetcher->getStats(mapping.first);
+
+      responseStream << "* [target id " << mapping.first << "] "
+         "hits: " << stats.numHits << "; "
+         "misses: " << stats.numMisses << "; "
+         "ranges: " << stats.numRanges << "; "
+         "bytes: " << stats.numBytes << "; "
+         "dropped: " << stats.numDropped << std::endl;
+   }
+
+   return responseStream.str();
+}
@@ -20,5 +20,9 @@ class GenericDebugMsgEx : public GenericDebugMsg
       std::string processOpChunkLockStoreSize(std::istringstream& commandStream);
       std::string processOpChunkLockStoreContents(std::istringstream& commandStream);
       std::string processOpSetRejectionRate(std::istringstream& commandStream);
+      std::string processOpCacheStatistics(std::istringstream& commandStream);
+      std::string processOpCompressionStats(std::istringstream& commandStream);
+      std::string processOpNumaTopology(std::istringstream& commandStream);
+      std::string processOpReadAheadStats(std::istringstream& commandStream);
 };
 
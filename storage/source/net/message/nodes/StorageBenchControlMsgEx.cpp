@@ -9,6 +9,7 @@ bool StorageBenchControlMsgEx::processIncoming(ResponseContext& ctx)
    const char* logContext = "StorageBenchControlMsg incoming";
 
    StorageBenchResultsMap results;
+   StorageBenchLatencyMap latencies;
    int cmdErrorCode = STORAGEBENCH_ERROR_NO_ERROR;
 
    App* app = Program::getApp();
@@ -19,7 +20,7 @@ bool StorageBenchControlMsgEx::processIncoming(ResponseContext& ctx)
       case StorageBenchAction_START:
       {
          cmdErrorCode = storageBench->initAndStartStorageBench(&getTargetIDs(), getBlocksize(),
-            getSize(), getThreads(), getODirect(), getType() );
+            getSize(), getThreads(), getODirect(), getType(), getOptions() );
       } break;
 
       case StorageBenchAction_STOP:
@@ -29,7 +30,7 @@ bool StorageBenchControlMsgEx::processIncoming(ResponseContext& ctx)
 
       case StorageBenchAction_STATUS:
       {
-         storageBench->getStatusWithResults(&getTargetIDs(), &results);
+         storageBench->getStatusWithResults(&getTargetIDs(), &results, &latencies);
          cmdErrorCode = STORAGEBENCH_ERROR_NO_ERROR;
       } break;
 
@@ -58,9 +59,14 @@ bool StorageBenchControlMsgEx::processIncoming(ResponseContext& ctx)
       errorCode = storageBench->getLastRunErrorCode();
    }
 
-   ctx.sendResponse(
-         StorageBenchControlMsgResp(storageBench->getStatus(), getAction(),
-            storageBench->getType(), errorCode, results) );
+   StorageBenchControlMsgResp respMsg(storageBench->getStatus(), getAction(),
+      storageBench->getType(), errorCode, results);
+
+   // (only clients that sent options know how to deserialize the latencies)
+   if (isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSG_FLAG_HAS_OPTIONS) )
+      respMsg.setLatencies(std::move(latencies) );
+
+   ctx.sendResponse(respMsg);
 
    return true;
 }
@@ -240,18 +240,14 @@ int64_t ReadLocalFileMsgExBase<Msg, ReadState>::incrementalReadStatefulAndSendV2
    int64_t oldOffset = sessionLocalFile->getOffset();
    int64_t newOffset = getOffset();
 
+   /* (no read-ahead for compressed chunks: the message offsets are logical file offsets, which
+      don't match the compressed blocks in the chunk file) */
    bool skipReadAhead =
       unlikely(isMsgHeaderFeatureFlagSet(READLOCALFILEMSG_FLAG_DISABLE_IO) ||
-      sessionLocalFile->getIsDirectIO());
-
-   ssize_t readAheadSize = skipReadAhead ? 0 : cfg->getTuneFileReadAheadSize();
-   ssize_t readAheadTriggerSize = cfg->getTuneFileReadAheadTriggerSize();
+      sessionLocalFile->getIsDirectIO() || sessionLocalFile->getIsCompressed() );
 
    if( (oldOffset < 0) || (oldOffset != newOffset) )
-   {
       sessionLocalFile->resetReadCounter(); // reset sequential read counter
-      sessionLocalFile->resetLastReadAheadTrigger();
-   }
    else
    { // read continues at previous offset
       LOG_DEBUG(logContext, Log_SPAM,
@@ -279,12 +275,20 @@ int64_t ReadLocalFileMsgExBase<Msg, ReadState>::incrementalReadStatefulAndSendV2
       return -1;
    }
 
+   if(!skipReadAhead)
+      startReadAhead(sessionLocalFile);
+
    for( ; ; )
    {
       ssize_t readLength = getReadLength(readState, BEEGFS_MIN(maxReadAtOnceLen, readState.toBeRead));
 
-      readState.readRes = unlikely(isMsgHeaderFeatureFlagSet(READLOCALFILEMSG_FLAG_DISABLE_IO) ) ?
-         readLength : MsgHelperIO::pread(*fd, dataBuf, readLength, readOffset);
+      if(unlikely(isMsgHeaderFeatureFlagSet(READLOCALFILEMSG_FLAG_DISABLE_IO) ) )
+         readState.readRes = readLength;
+      else if(sessionLocalFile->getIsCompressed() )
+         readState.readRes = Program::getApp()->getChunkCompression()->read(*fd,
+            sessionLocalFile->getFileID(), dataBuf, readLength, readOffset);
+      else
+         readState.readRes = MsgHelperIO::pread(*fd, dataBuf, readLength, readOffset);
 
       LOG_DEBUG(logContext, Log_SPAM,
          "toBeRead: " + StringTk::int64ToStr(readState.toBeRead) + "; "
@@ -314,8 +318,6 @@ int64_t ReadLocalFileMsgExBase<Msg, ReadState>::incrementalReadStatefulAndSendV2
             return -1;
          }
 
-         checkAndStartReadAhead(sessionLocalFile, readAheadTriggerSize, newOffset, readAheadSize);
-
          if(isFinal)
          { // we reached the end of the requested data
             return getCount();
@@ -385,44 +387,39 @@ int64_t ReadLocalFileMsgExBase<Msg, ReadState>::incrementalReadStatefulAndSendV2
 }
 
 /**
- * Starts read-ahead if enough sequential data has been read.
+ * Feeds this read into the access pattern detection of the session and starts read-ahead for the
+ * next expected reads (see ReadAheadDetector).
  *
- * Note: if getDisableIO() is true, we assume the caller sets readAheadSize==0, so getDisableIO()
- * is not checked explicitly within this function.
- *
- * @sessionLocalFile lastReadAheadOffset will be updated if read-head was triggered
- * @param readAheadTriggerSize the length of sequential IO that triggers read-ahead
- * @param currentOffset current file offset (where read-ahead would start)
+ * Note: if getDisableIO() is true, the caller is supposed to not call this.
  */
 template <class Msg, typename ReadState>
-void ReadLocalFileMsgExBase<Msg, ReadState>::checkAndStartReadAhead(SessionLocalFile* sessionLocalFile,
-   ssize_t readAheadTriggerSize, off_t currentOffset, off_t readAheadSize)
+void ReadLocalFileMsgExBase<Msg, ReadState>::startReadAhead(SessionLocalFile* sessionLocalFile)
 {
-   std::string logContext = Msg::logContextPref + " (read-ahead)";
-
-   if(!readAheadSize)
-      return;
+   App* app = Program::getApp();
+   Config* cfg = app->getConfig();
 
-   int64_t readCounter = sessionLocalFile->getReadCounter();
-   int64_t nextReadAheadTrigger = sessionLocalFile->getLastReadAheadTrigger() ?
-      sessionLocalFile->getLastReadAheadTrigger() + readAheadSize : readAheadTriggerSize;
+   ReadAheadDetector::Config detectorCfg;
 
-   if(readCounter < nextReadAheadTrigger)
-      return; // we're not at the trigger point yet
+   detectorCfg.triggerSize = cfg->getTuneFileReadAheadTriggerSize();
+   detectorCfg.initialWindow = cfg->getTuneFileReadAheadSize();
+   detectorCfg.maxWindow = cfg->getTuneFileReadAheadMaxSize();
 
-   /* start read-head...
-      (read-ahead is supposed to be non-blocking if there are free slots in the device IO queue) */
+   if(!detectorCfg.initialWindow)
+      return; // read-ahead disabled
 
-   LOG_DEBUG(logContext, Log_SPAM,
-      std::string("Starting read-ahead... ") +
-      "offset: " + StringTk::int64ToStr(currentOffset) + "; "
-      "size: " + StringTk::int64ToStr(readAheadSize) );
+   const ReadAheadAdvice advice = sessionLocalFile->detectReadAhead(getOffset(), getCount(),
+      detectorCfg);
 
-   MsgHelperIO::readAhead(*sessionLocalFile->getFD(), currentOffset, readAheadSize);
+   if(advice.pattern == ReadAheadPattern_NONE)
+      return;
 
-   // update trigger
+   LOG_DEBUG(Msg::logContextPref + " (read-ahead)", Log_SPAM,
+      "Read pattern: " + StringTk::intToStr(advice.pattern) + "; "
+      "offset: " + StringTk::int64ToStr(getOffset() ) + "; "
+      "read-ahead ranges: " + StringTk::uintToStr(advice.ranges.size() ) );
 
-   sessionLocalFile->setLastReadAheadTrigger(readCounter);
+   app->getReadAheadPrefetcher()->prefetch(sessionLocalFile->getTargetID(),
+      *sessionLocalFile->getFD(), advice);
 }
 
 
@@ -435,7 +432,7 @@ void ReadLocalFileMsgExBase<Msg, ReadState>::checkAndStartReadAhead(SessionLocal
  * ask the client for a retry (e.g. if target consistency is not good for buddymirrored chunks).
  */
 template <class Msg, typename ReadState>
-FhgfsOpsErr ReadLocalFileMsgExBase<Msg, ReadState>::openFile(const StorageTarget& target,
+FhgfsOpsErr ReadLocalFileMsgExBase<Msg, ReadState>::openFile(StorageTarget& target,
       SessionLocalFile* sessionLocalFile)
 {
    std::string logContext = Msg::logContextPref + " (open)";
@@ -462,5 +459,10 @@ FhgfsOpsErr ReadLocalFileMsgExBase<Msg, ReadState>::openFile(const StorageTarget
 
    FhgfsOpsErr openChunkRes = sessionLocalFile->openFile(targetFD, getPathInfo(), false, NULL);
 
+   // (fd is invalid if the chunk doesn't exist)
+   if( (openChunkRes == FhgfsOpsErr_SUCCESS) && sessionLocalFile->getFD().valid() )
+      sessionLocalFile->setIsCompressed(Program::getApp()->getChunkCompression()->
+         isCompressedChunk(target, *sessionLocalFile->getFD() ) );
+
    return openChunkRes;
 }
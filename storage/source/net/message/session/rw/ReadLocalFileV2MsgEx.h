@@ -35,10 +35,9 @@ class ReadLocalFileMsgExBase : public Msg
    private:
       SessionLocalFileStore* sessionLocalFiles;
 
-      FhgfsOpsErr openFile(const StorageTarget& target, SessionLocalFile* sessionLocalFile);
+      FhgfsOpsErr openFile(StorageTarget& target, SessionLocalFile* sessionLocalFile);
 
-      void checkAndStartReadAhead(SessionLocalFile* sessionLocalFile, ssize_t readAheadTriggerSize,
-         off_t currentOffset, off_t readAheadSize);
+      void startReadAhead(SessionLocalFile* sessionLocalFile);
 
       int64_t incrementalReadStatefulAndSendV2(NetMessage::ResponseContext& ctx,
          SessionLocalFile* sessionLocalFile);
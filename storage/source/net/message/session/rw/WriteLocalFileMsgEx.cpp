@@ -127,6 +127,10 @@ std::pair<bool, int64_t> WriteLocalFileMsgExBase<Msg, WriteState>::write(NetMess
       std::string fileID = SessionTk::fileIDFromHandleID(fileHandleID);
       int openFlags = SessionTk::sysOpenFlagsFromFhgfsAccessFlags(getAccessFlags() );
 
+      // write-only handles still need read access to the chunk for compressed blocks
+      openFlags = app->getChunkCompression()->getChunkOpenFlags(targetID,
+         target->getHasCompressedChunks(), openFlags);
+
       auto newFile = boost::make_unique<SessionLocalFile>(fileHandleID, targetID, fileID, openFlags,
          serverCrashed);
 
@@ -364,9 +368,18 @@ int64_t WriteLocalFileMsgExBase<Msg, WriteState>::incrementalRecvAndWriteStatefu
       // write to underlying file system...
 
       int errCode = 0;
-      ssize_t writeRes = unlikely(isMsgHeaderFeatureFlagSet(WRITELOCALFILEMSG_FLAG_DISABLE_IO) )
-         ? recvRes
-         : doWrite(*fd, ctx.getBuffer(), recvRes, writeState.writeOffset, errCode);
+      ssize_t writeRes;
+
+      if(unlikely(isMsgHeaderFeatureFlagSet(WRITELOCALFILEMSG_FLAG_DISABLE_IO) ) )
+         writeRes = recvRes;
+      else if(sessionLocalFile->getIsCompressed() )
+      {
+         writeRes = Program::getApp()->getChunkCompression()->write(*fd,
+            sessionLocalFile->getFileID(), ctx.getBuffer(), recvRes, writeState.writeOffset);
+         errCode = (writeRes == -1) ? errno : 0;
+      }
+      else
+         writeRes = doWrite(*fd, ctx.getBuffer(), recvRes, writeState.writeOffset, errCode);
 
       writeState.toBeReceived -= recvRes;
 
@@ -491,7 +504,7 @@ void WriteLocalFileMsgExBase<Msg, WriteState>::incrementalRecvPadding(NetMessage
 }
 
 template <class Msg, typename WriteState>
-FhgfsOpsErr WriteLocalFileMsgExBase<Msg, WriteState>::openFile(const StorageTarget& target,
+FhgfsOpsErr WriteLocalFileMsgExBase<Msg, WriteState>::openFile(StorageTarget& target,
       SessionLocalFile* sessionLocalFile)
 {
    std::string logContext = Msg::logContextPref + " (write incremental)";
@@ -525,6 +538,10 @@ FhgfsOpsErr WriteLocalFileMsgExBase<Msg, WriteState>::openFile(const StorageTarg
 
    FhgfsOpsErr openChunkRes = sessionLocalFile->openFile(targetFD, getPathInfo(), true, &quotaInfo);
 
+   if( (openChunkRes == FhgfsOpsErr_SUCCESS) && sessionLocalFile->getFD().valid() )
+      sessionLocalFile->setIsCompressed(Program::getApp()->getChunkCompression()->
+         isCompressedChunk(target, *sessionLocalFile->getFD() ) );
+
    return openChunkRes;
 }
 
@@ -59,7 +59,7 @@ class WriteLocalFileMsgExBase : public Msg
 
       ssize_t doWrite(int fd, char* buf, size_t count, off_t offset, int& outErrno);
 
-      FhgfsOpsErr openFile(const StorageTarget& target, SessionLocalFile* sessionLocalFile);
+      FhgfsOpsErr openFile(StorageTarget& target, SessionLocalFile* sessionLocalFile);
 
       FhgfsOpsErr prepareMirroring(char* buf, size_t bufLen,
          SessionLocalFile* sessionLocalFile, StorageTarget& target);
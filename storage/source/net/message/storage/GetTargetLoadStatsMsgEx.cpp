@@ -0,0 +1,15 @@
+#include <program/Program.h>
+#include <common/net/message/storage/GetTargetLoadStatsRespMsg.h>
+#include "GetTargetLoadStatsMsgEx.h"
+
+
+bool GetTargetLoadStatsMsgEx::processIncoming(ResponseContext& ctx)
+{
+   TargetHighResStatsMap targetStats;
+
+   Program::getApp()->getStatsCollector()->getTargetStats(targetStats);
+
+   ctx.sendResponse(GetTargetLoadStatsRespMsg(&targetStats) );
+
+   return true;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <common/net/message/storage/GetTargetLoadStatsMsg.h>
+
+
+class GetTargetLoadStatsMsgEx : public GetTargetLoadStatsMsg
+{
+   public:
+      virtual bool processIncoming(ResponseContext& ctx);
+};
+
@@ -195,6 +195,30 @@ FhgfsOpsErr TruncLocalFileMsgEx::truncFile(uint16_t targetId, int targetFD,
 
    FhgfsOpsErr clientErrRes = FhgfsOpsErr_SUCCESS;
 
+   auto* const target = app->getStorageTargets()->getTarget(targetId);
+
+   if(target && target->getHasCompressedChunks() )
+   { // compressed blocks must be decompressed if they become the partial last block
+      int fd = openat(targetFD, chunkFilePathStr.c_str(), O_RDWR | O_LARGEFILE);
+      if(fd != -1)
+      {
+         int truncRes = app->getChunkCompression()->truncate(fd, entryID, getFilesize() );
+         int truncErrCode = errno;
+
+         close(fd);
+
+         if(!truncRes)
+            return FhgfsOpsErr_SUCCESS;
+
+         LogContext(logContext).logErr("Unable to truncate compressed file: " +
+            chunkFilePathStr + ". " + "SysErr: " + System::getErrString(truncErrCode) );
+
+         return FhgfsOpsErrTk::fromSysErr(truncErrCode);
+      }
+
+      // open errors (e.g. ENOENT) are handled by the regular truncate below
+   }
+
    int truncRes = MsgHelperIO::truncateAt(targetFD, chunkFilePathStr.c_str(), getFilesize() );
    if(!truncRes)
       return FhgfsOpsErr_SUCCESS; // truncate succeeded
@@ -34,6 +34,8 @@ bool RmChunkPathsMsgEx::processIncoming(ResponseContext& ctx)
          // remove chunk
          int unlinkRes = unlinkat(targetFD, (*iter).c_str(), 0);
 
+         app->getChunkFDCache()->invalidate(targetFD, *iter);
+
          if ( (unlinkRes != 0)  && (errno != ENOENT) )
          {
             LogContext(logContext).logErr(
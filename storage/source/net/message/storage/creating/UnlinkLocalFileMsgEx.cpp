@@ -96,6 +96,8 @@ bool UnlinkLocalFileMsgEx::processIncoming(ResponseContext& ctx)
 
       unlinkRes = unlinkat(targetFD, chunkFilePathStr.c_str(), 0);
 
+      app->getChunkFDCache()->invalidate(targetFD, chunkFilePathStr);
+
       if( (unlinkRes == -1) && (errno != ENOENT) )
       { // error
          LogContext(logContext).logErr("Unable to unlink file: " + chunkFilePathStr + ". " +
@@ -0,0 +1,70 @@
+#include <common/net/message/storage/creating/UnlinkLocalFilesRespMsg.h>
+#include <program/Program.h>
+#include <toolkit/StorageTkEx.h>
+#include "UnlinkLocalFilesMsgEx.h"
+
+
+bool UnlinkLocalFilesMsgEx::processIncoming(ResponseContext& ctx)
+{
+   App* app = Program::getApp();
+
+   UnlinkLocalFilesEntryVec& entries = getEntries();
+   FhgfsOpsErrVec results;
+
+   results.reserve(entries.size() );
+
+   for (auto iter = entries.begin(); iter != entries.end(); iter++)
+      results.push_back(unlinkChunk(*iter) );
+
+   ctx.sendResponse(UnlinkLocalFilesRespMsg(&results) );
+
+   // update operation counters...
+   for (size_t i = 0; i < entries.size(); i++)
+      app->getNodeOpStats()->updateNodeOp(ctx.getSocket()->getPeerIP(), StorageOpCounter_UNLINK,
+         getMsgHeaderUserID() );
+
+   return true;
+}
+
+/**
+ * Same as the unlink of UnlinkLocalFileMsgEx for a non-mirrored chunk.
+ */
+FhgfsOpsErr UnlinkLocalFilesMsgEx::unlinkChunk(const UnlinkLocalFilesEntry& entry)
+{
+   App* app = Program::getApp();
+
+   StorageTarget* target = app->getStorageTargets()->getTarget(entry.targetID);
+   if (!target)
+   {
+      LOG(GENERAL, ERR, "Unknown targetID.", entry.targetID);
+      return FhgfsOpsErr_UNKNOWNTARGET;
+   }
+
+   const int targetFD = *target->getChunkFD();
+   const bool hasOrigFeature = entry.pathInfo.hasOrigFeature();
+
+   Path chunkDirPath;
+   std::string chunkFilePathStr; // chunkDirPathStr + '/' + entryID
+
+   StorageTk::getChunkDirChunkFilePath(&entry.pathInfo, entry.entryID, hasOrigFeature,
+      chunkDirPath, chunkFilePathStr);
+
+   const int unlinkRes = unlinkat(targetFD, chunkFilePathStr.c_str(), 0);
+
+   app->getChunkFDCache()->invalidate(targetFD, chunkFilePathStr);
+
+   if ( (unlinkRes == -1) && (errno != ENOENT) )
+   {
+      LOG(GENERAL, ERR, "Unable to unlink file.", ("path", chunkFilePathStr),
+            ("sysErr", System::getErrString() ) );
+      return FhgfsOpsErr_INTERNAL;
+   }
+
+   LOG_DBG(GENERAL, DEBUG, "File unlinked.", ("path", chunkFilePathStr) );
+
+   // try to rmdir chunkDirPath (in case this was the last chunkfile in a dir)
+   if (!unlinkRes && hasOrigFeature)
+      app->getChunkDirStore()->rmdirChunkDirPath(targetFD, &chunkDirPath);
+
+   return FhgfsOpsErr_SUCCESS;
+}
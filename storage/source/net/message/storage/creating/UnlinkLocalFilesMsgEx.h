@@ -0,0 +1,12 @@
+#pragma once
+
+#include <common/net/message/storage/creating/UnlinkLocalFilesMsg.h>
+
+class UnlinkLocalFilesMsgEx : public UnlinkLocalFilesMsg
+{
+   public:
+      virtual bool processIncoming(ResponseContext& ctx);
+
+   private:
+      FhgfsOpsErr unlinkChunk(const UnlinkLocalFilesEntry& entry);
+};
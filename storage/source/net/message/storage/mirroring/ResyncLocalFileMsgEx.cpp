@@ -19,9 +19,12 @@ bool ResyncLocalFileMsgEx::processIncoming(ResponseContext& ctx)
    size_t count = getCount();
    int64_t offset = getOffset();
    std::string relativeChunkPathStr = getRelativePathStr();
+   std::string entryID = StorageTk::getPathBasename(relativeChunkPathStr);
    int writeErrno;
    bool writeRes;
    StorageTarget* target;
+   ChunkCompression* chunkCompression = app->getChunkCompression();
+   bool useCompression;
 
    int openFlags = O_WRONLY | O_CREAT;
    SessionQuotaInfo quotaInfo(false, false, 0, 0);
@@ -68,6 +71,9 @@ bool ResyncLocalFileMsgEx::processIncoming(ResponseContext& ctx)
    if(!offset && !isMsgHeaderFeatureFlagSet (RESYNCLOCALFILEMSG_FLAG_NODATA) )
       openFlags |= O_TRUNC;
 
+   openFlags = chunkCompression->getChunkOpenFlags(targetID, target->getHasCompressedChunks(),
+      openFlags);
+
    openRes = chunkStore->openChunkFile(targetFD, NULL, relativeChunkPathStr, true,
       openFlags, &fd, &quotaInfo, {});
 
@@ -86,7 +92,20 @@ bool ResyncLocalFileMsgEx::processIncoming(ResponseContext& ctx)
    if(isMsgHeaderFeatureFlagSet (RESYNCLOCALFILEMSG_FLAG_NODATA)) // do not sync actual data
       goto set_attribs;
 
-   if(isMsgHeaderFeatureFlagSet (RESYNCLOCALFILEMSG_CHECK_SPARSE))
+   // a truncated chunk has no compressed blocks anymore, but still the block map xattr
+   if( (openFlags & O_TRUNC) && (openFlags & O_RDWR) &&
+       chunkCompression->removeBlockMap(fd, entryID) )
+      LogContext(__func__).logErr("Unable to remove block map of compressed chunk: " +
+         relativeChunkPathStr + ". SysErr: " + System::getErrString() );
+
+   useCompression = chunkCompression->isCompressedChunk(*target, fd);
+
+   if(useCompression)
+   { // (zero areas compress well, so no special sparse handling here)
+      writeRes = chunkCompression->write(fd, entryID, dataBuf, count, offset) != -1;
+      writeErrno = errno;
+   }
+   else if(isMsgHeaderFeatureFlagSet (RESYNCLOCALFILEMSG_CHECK_SPARSE))
       writeRes = doWriteSparse(fd, dataBuf, count, offset, writeErrno);
    else
       writeRes = doWrite(fd, dataBuf, count, offset, writeErrno);
@@ -106,7 +125,15 @@ bool ResyncLocalFileMsgEx::processIncoming(ResponseContext& ctx)
    {
       int truncErrno;
       // we trunc after a possible write, so we need to trunc at offset+count
-      bool truncRes = doTrunc(fd, offset + count, truncErrno);
+      bool truncRes;
+
+      if(useCompression)
+      {
+         truncRes = !chunkCompression->truncate(fd, entryID, offset + count);
+         truncErrno = errno;
+      }
+      else
+         truncRes = doTrunc(fd, offset + count, truncErrno);
 
       if(!truncRes)
       {
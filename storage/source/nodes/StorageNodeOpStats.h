@@ -6,6 +6,8 @@
 #include <common/nodes/Node.h>
 #include <common/nodes/NodeOpStats.h>
 
+#include <mutex>
+
 /**
  * Per-user storage server operation statistics.
  */
@@ -35,35 +37,27 @@ class StorageNodeOpStats : public NodeOpStats
        */
       void updateNodeOp(unsigned nodeIP, StorageOpCounterTypes opType, unsigned userID)
       {
-         SafeRWLock safeLock(&lock, SafeRWLock_READ);
-
-         NodeOpCounterMapIter nodeIter = clientCounterMap.find(nodeIP);
-         NodeOpCounterMapIter userIter = userCounterMap.find(userID);
+         CounterTable& table = getThreadCounterTable();
 
-         if( (nodeIter == clientCounterMap.end() ) ||
-             (userIter == userCounterMap.end() ) )
-         { // nodeIP or userID NOT found in map yet, we need a write lock
+         std::lock_guard<Mutex> lock(table.mutex);
 
-            safeLock.unlock(); // possible race, but insert below is a NOOP if key already exists
-            safeLock.lock(SafeRWLock_WRITE);
+         NodeOpCounterMapIter nodeIter = table.clientCounterMap.find(nodeIP);
+         NodeOpCounterMapIter userIter = table.userCounterMap.find(userID);
 
-            if(nodeIter == clientCounterMap.end() )
-            {
-               nodeIter = clientCounterMap.insert(
-                  NodeOpCounterMapVal(nodeIP, StorageOpCounter() ) ).first;
-            }
+         if(nodeIter == table.clientCounterMap.end() )
+         { // first op of this nodeIP in this thread
+            nodeIter = table.clientCounterMap.insert(
+               NodeOpCounterMapVal(nodeIP, StorageOpCounter() ) ).first;
+         }
 
-            if(userIter == userCounterMap.end() )
-            {
-               userIter = userCounterMap.insert(
-                  NodeOpCounterMapVal(userID, StorageOpCounter() ) ).first;
-            }
+         if(userIter == table.userCounterMap.end() )
+         { // first op of this userID in this thread
+            userIter = table.userCounterMap.insert(
+               NodeOpCounterMapVal(userID, StorageOpCounter() ) ).first;
          }
 
          nodeIter->second.increaseOpCounter(opType);
          userIter->second.increaseOpCounter(opType);
-
-         safeLock.unlock();
       }
 
       /**
@@ -80,35 +74,27 @@ class StorageNodeOpStats : public NodeOpStats
       void updateNodeOp(unsigned nodeIP, StorageOpCounterTypes operation, uint64_t bytes,
          unsigned userID)
       {
-         SafeRWLock safeLock(&lock, SafeRWLock_READ);
+         CounterTable& table = getThreadCounterTable();
 
-         NodeOpCounterMapIter nodeIter = clientCounterMap.find(nodeIP);
-         NodeOpCounterMapIter userIter = userCounterMap.find(userID);
+         std::lock_guard<Mutex> lock(table.mutex);
 
-         if( (nodeIter == clientCounterMap.end() ) ||
-             (userIter == userCounterMap.end() ) )
-         { // nodeID or userID NOT found in map yet, we need a write lock
+         NodeOpCounterMapIter nodeIter = table.clientCounterMap.find(nodeIP);
+         NodeOpCounterMapIter userIter = table.userCounterMap.find(userID);
 
-            safeLock.unlock(); // possible race, but insert below is a NOOP if key already exists
-            safeLock.lock(SafeRWLock_WRITE);
-
-            if(nodeIter == clientCounterMap.end() )
-            {
-               nodeIter = clientCounterMap.insert(
-                  NodeOpCounterMapVal(nodeIP, StorageOpCounter() ) ).first;
-            }
+         if(nodeIter == table.clientCounterMap.end() )
+         { // first op of this nodeIP in this thread
+            nodeIter = table.clientCounterMap.insert(
+               NodeOpCounterMapVal(nodeIP, StorageOpCounter() ) ).first;
+         }
 
-            if(userIter == userCounterMap.end() )
-            {
-               userIter = userCounterMap.insert(
-                  NodeOpCounterMapVal(userID, StorageOpCounter() ) ).first;
-            }
+         if(userIter == table.userCounterMap.end() )
+         { // first op of this userID in this thread
+            userIter = table.userCounterMap.insert(
+               NodeOpCounterMapVal(userID, StorageOpCounter() ) ).first;
          }
 
          nodeIter->second.increaseStorageOpBytes(operation, bytes);
          userIter->second.increaseStorageOpBytes(operation, bytes);
-
-         safeLock.unlock();
       }
 
 };
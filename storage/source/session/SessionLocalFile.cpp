@@ -11,7 +11,7 @@ bool SessionLocalFile::Handle::close()
    if (!fd.valid())
       return true;
 
-   if (const int err = fd.close())
+   if (const int err = fd.reset())
    {
       LOG(GENERAL, ERR, "Unable to close local file.", sysErr(err), id);
       return false;
@@ -82,6 +82,18 @@ FhgfsOpsErr SessionLocalFile::openFile(int targetFD, const PathInfo* pathInfo,
          chunkFilePathStr);
 
       ChunkStore* chunkDirStore = app->getChunkDirStore();
+      ChunkFDCache* fdCache = app->getChunkFDCache();
+
+      // another session might have this chunk open already
+      ChunkFDCache::Ref cachedFD = fdCache->acquire(targetFD, chunkFilePathStr,
+         this->openFlags);
+      if (cachedFD.valid() )
+      {
+         handle->fd = std::move(cachedFD);
+         offset = 0;
+
+         return FhgfsOpsErr_SUCCESS;
+      }
 
       int fd = -1;
 
@@ -140,7 +152,8 @@ FhgfsOpsErr SessionLocalFile::openFile(int targetFD, const PathInfo* pathInfo,
       }
 
       // prepare session data...
-      handle->fd = FDHandle(fd);
+      handle->fd = fdCache->insert(targetFD, chunkFilePathStr, this->openFlags,
+         FDHandle(fd) );
       offset = 0;
 
       log->log(Log_DEBUG, logContext, "File created. ID: " + getFileID() );
@@ -7,6 +7,8 @@
 #include <common/storage/quota/QuotaData.h>
 #include <common/threading/Mutex.h>
 #include <common/toolkit/FDHandle.h>
+#include <storage/ChunkFDCache.h>
+#include <storage/ReadAheadDetector.h>
 
 #include <atomic>
 
@@ -23,19 +25,19 @@ class SessionLocalFile
          public:
             Handle() = default;
 
-            Handle(const std::string& id, FDHandle fd):
-               id(id), fd(std::move(fd)), claimed(0)
+            explicit Handle(const std::string& id):
+               id(id), claimed(0)
             {
             }
 
             bool close();
 
-            const FDHandle& getFD() const { return fd; }
+            const FDHandle& getFD() const { return fd.getFD(); }
             const std::string& getID() const { return id; }
 
          private:
             std::string id;
-            FDHandle fd;
+            ChunkFDCache::Ref fd; // shared with other sessions that opened the same chunk
             // for use by SessionLocalFile::releaseLastReference. only one caller may receive the
             // handle if multiple threads try to release the last reference concurrently. we could
             // also do this under a lock in SessionLocalFileStore but don't since we don't expect
@@ -52,13 +54,14 @@ class SessionLocalFile
        */
       SessionLocalFile(const std::string& fileHandleID, uint16_t targetID, std::string fileID,
             int openFlags, bool serverCrashed) :
-         handle(std::make_shared<Handle>(fileHandleID, FDHandle())), targetID(targetID),
+         handle(std::make_shared<Handle>(fileHandleID)), targetID(targetID),
          fileID(fileID)
       {
          this->openFlags = openFlags;
          this->offset = -1; // initialize as invalid offset (will be set on file open)
 
          this->isMirrorSession = false;
+         this->isCompressed = false;
 
          this->writeCounter = 0;
          this->readCounter = 0;
@@ -74,6 +77,7 @@ class SessionLocalFile
          handle(std::make_shared<Handle>())
       {
          this->offset = -1; // initialize as invalid offset (will be set on file open)
+         this->isCompressed = false; // not serialized, will be set on file open
       }
 
       template<typename This, typename Ctx>
@@ -132,10 +136,12 @@ class SessionLocalFile
 
       NodeHandle mirrorNode; // the node to which all writes should be mirrored
       bool isMirrorSession; // true if this is the mirror session of a file
+      bool isCompressed; // true if chunk I/O must go through ChunkCompression
 
       AtomicInt64 writeCounter; // how much sequential data we have written after open/sync_file_range
       AtomicInt64 readCounter; // how much sequential data we have read since open / last seek
-      AtomicInt64 lastReadAheadTrigger; // last readCounter value at which read-ahead was triggered
+      AtomicInt64 lastReadAheadTrigger; // unused, only kept for the session file format
+      ReadAheadDetector readAheadDetector; // protected by sessionMutex, not serialized
 
       Mutex sessionMutex;
 
@@ -185,11 +191,11 @@ class SessionLocalFile
       const FDHandle& getFD()
       {
          if (handle->fd.valid()) // optimization: try without a lock first
-            return handle->fd;
+            return handle->fd.getFD();
 
          std::lock_guard<Mutex> const lock(sessionMutex);
 
-         return handle->fd;
+         return handle->fd.getFD();
       }
 
       int getOpenFlags() const
@@ -231,6 +237,16 @@ class SessionLocalFile
          this->isMirrorSession = isMirrorSession;
       }
 
+      bool getIsCompressed() const
+      {
+         return isCompressed;
+      }
+
+      void setIsCompressed(bool isCompressed)
+      {
+         this->isCompressed = isCompressed;
+      }
+
       void resetWriteCounter()
       {
          this->writeCounter = 0;
@@ -261,19 +277,12 @@ class SessionLocalFile
          this->readCounter.increase(size);
       }
 
-      int64_t getLastReadAheadTrigger()
+      ReadAheadAdvice detectReadAhead(int64_t offset, int64_t len,
+         const ReadAheadDetector::Config& cfg)
       {
-         return this->lastReadAheadTrigger.read();
-      }
-
-      void resetLastReadAheadTrigger()
-      {
-         this->lastReadAheadTrigger.setZero();
-      }
+         std::lock_guard<Mutex> const lock(sessionMutex);
 
-      void setLastReadAheadTrigger(int64_t lastReadAheadTrigger)
-      {
-         this->lastReadAheadTrigger.set(lastReadAheadTrigger);
+         return readAheadDetector.onRead(offset, len, cfg);
       }
 
       bool isServerCrashed()
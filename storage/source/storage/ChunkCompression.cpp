@@ -0,0 +1,740 @@
+#include <common/app/log/Logger.h>
+#include <common/nodes/StoragePoolStore.h>
+#include <common/threading/RWLockGuard.h>
+#include <common/toolkit/serialization/Byteswap.h>
+#include <common/toolkit/HashTk.h>
+#include <storage/StorageTargets.h>
+#include "ChunkCompression.h"
+
+#include <sys/xattr.h>
+#include <fcntl.h>
+#include <time.h>
+
+#ifdef BEEGFS_HAVE_LZ4
+   #include <lz4.h>
+#endif
+
+
+#define CHUNKCOMPRESSION_BLOCK_MAGIC      0x42434742 // "BGCB"
+#define CHUNKCOMPRESSION_MAP_MAGIC        0x4d434742 // "BGCM"
+#define CHUNKCOMPRESSION_IO_ALIGNMENT     4096 // for chunks opened with O_DIRECT
+
+
+namespace {
+
+/**
+ * Per-thread buffer, aligned for direct I/O and grown on demand.
+ */
+class AlignedBuffer
+{
+   public:
+      AlignedBuffer() : data(NULL), size(0) {}
+
+      ~AlignedBuffer()
+      {
+         free(data);
+      }
+
+      AlignedBuffer(const AlignedBuffer&) = delete;
+      AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+      /**
+       * @throw std::bad_alloc
+       */
+      char* get(size_t minSize)
+      {
+         if(size >= minSize)
+            return data;
+
+         free(data);
+         data = NULL;
+         size = 0;
+
+         if(posix_memalign(reinterpret_cast<void**>(&data), CHUNKCOMPRESSION_IO_ALIGNMENT,
+               minSize) )
+            throw std::bad_alloc();
+
+         size = minSize;
+         return data;
+      }
+
+   private:
+      char* data;
+      size_t size;
+};
+
+thread_local AlignedBuffer blockBuffer; // one uncompressed block
+thread_local AlignedBuffer slotBuffer; // one block as stored on disk
+thread_local AlignedBuffer writeBuffer; // new contents of all blocks of a write
+
+struct BlockMapXattrHeader
+{
+   uint32_t magic;
+   uint32_t blockSize;
+};
+
+bool pwriteFull(int fd, const char* buf, size_t count, off_t offset)
+{
+   size_t sumWriteRes = 0;
+
+   while(sumWriteRes != count)
+   {
+      ssize_t writeRes = pwrite(fd, buf + sumWriteRes, count - sumWriteRes, offset + sumWriteRes);
+      if(writeRes == -1)
+         return false;
+
+      sumWriteRes += writeRes;
+   }
+
+   return true;
+}
+
+}
+
+
+ChunkCompression::ChunkCompression(const UInt16Set& targetIDs,
+      const std::set<StoragePoolId>& poolIDs, const StoragePoolStore* storagePools) :
+   targetIDs(targetIDs), poolIDs(poolIDs), storagePools(storagePools),
+   locks(new RWLock[CHUNKCOMPRESSION_NUM_LOCKS]),
+   numBlocksCompressed(0), numBlocksIncompressible(0), compressedRawBytes(0),
+   compressedDiskBytes(0), numBlocksDecompressed(0), numReadModifyWrites(0), compressMicros(0),
+   decompressMicros(0)
+{
+}
+
+/**
+ * @return false if the storage server was built without liblz4.
+ */
+bool ChunkCompression::isSupported()
+{
+#ifdef BEEGFS_HAVE_LZ4
+   return true;
+#else
+   return false;
+#endif
+}
+
+/**
+ * @return true if new data on the given target is to be written compressed.
+ */
+bool ChunkCompression::isEnabled(uint16_t targetID) const
+{
+   if(targetIDs.count(targetID) )
+      return true;
+
+   if(poolIDs.empty() || !storagePools)
+      return false;
+
+   StoragePoolPtr pool = storagePools->getPool(targetID);
+
+   return pool && poolIDs.count(pool->getId() );
+}
+
+/**
+ * Writes to compressed chunks read the existing blocks for read-modify-write, so write-only opens
+ * of chunks on targets that (may) contain compressed chunks must be upgraded to read-write.
+ *
+ * @param targetHasCompressedChunks StorageTarget::getHasCompressedChunks() of the target.
+ * @param openFlags flags for open(2) as requested by the caller.
+ * @return openFlags with O_WRONLY replaced by O_RDWR if necessary.
+ */
+int ChunkCompression::getChunkOpenFlags(uint16_t targetID, bool targetHasCompressedChunks,
+   int openFlags) const
+{
+   if( (openFlags & O_ACCMODE) != O_WRONLY)
+      return openFlags;
+
+   if(!isEnabled(targetID) && !targetHasCompressedChunks)
+      return openFlags;
+
+   return (openFlags & ~O_ACCMODE) | O_RDWR;
+}
+
+/**
+ * Decide whether a chunk that was just opened by a session must be accessed through this class,
+ * i.e. whether it is marked as compressed chunk by a block map.
+ *
+ * Empty chunks on targets with enabled compression are marked here (with an empty block map), so
+ * that all sessions of the chunk use this class from now on. Chunks that already contain data
+ * without being marked (e.g. written before compression was enabled) stay raw chunks.
+ */
+bool ChunkCompression::isCompressedChunk(StorageTarget& target, int fd)
+{
+   const bool enabled = isEnabled(target.getID() );
+
+   if(!enabled && !target.getHasCompressedChunks() )
+      return false;
+
+   if(fgetxattr(fd, CHUNKCOMPRESSION_MAP_XATTR, NULL, 0) >= 0)
+      return true;
+
+   if(!enabled || (errno != ENODATA) )
+      return false;
+
+   struct stat statBuf;
+
+   if(fstat(fd, &statBuf) || statBuf.st_size)
+      return false;
+
+   target.setHasCompressedChunks();
+
+   if(!storeBlockMap(fd, BlockMap() ) )
+   { // (e.g. no xattr support)
+      LOG(GENERAL, WARNING, "Unable to mark chunk as compressed chunk.", sysErr);
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Like pwrite(), but compresses full blocks.
+ *
+ * @return count or -1 with errno set (in which case an unknown part of the data was written).
+ */
+ssize_t ChunkCompression::write(int fd, const std::string& chunkID, const char* buf,
+   size_t count, off_t offset)
+{
+   if(!count)
+      return 0;
+
+   RWLockGuard lock(getLock(chunkID), SafeRWLock_WRITE);
+
+   BlockMap map;
+
+   if(!readBlockMap(fd, map) )
+      return -1;
+
+   return writeUnlocked(fd, buf, count, offset, map, true);
+}
+
+/**
+ * @param allowCompression false to store all written blocks raw (blocks that were compressed before
+ *    are decompressed).
+ */
+ssize_t ChunkCompression::writeUnlocked(int fd, const char* buf, size_t count, off_t offset,
+   BlockMap& map, bool allowCompression)
+{
+   const size_t blockSize = CHUNKCOMPRESSION_BLOCK_SIZE;
+   const uint64_t maxBlocks = CHUNKCOMPRESSION_MAX_MAP_BYTES * 8;
+
+   struct stat statBuf;
+
+   if(fstat(fd, &statBuf) )
+      return -1;
+
+   const off_t endOffset = offset + count;
+   const off_t newFileSize = BEEGFS_MAX(statBuf.st_size, endOffset);
+
+   const uint64_t firstBlock = offset / blockSize;
+   const uint64_t lastBlock = (endOffset - 1) / blockSize;
+
+   char* const block = blockBuffer.get(blockSize);
+   char* const out = writeBuffer.get( (lastBlock - firstBlock + 1) * blockSize);
+
+   std::vector<BlockWrite> writes;
+   BlockMap preWriteMap(map); // with bits of newly compressed blocks
+   BlockMap postWriteMap; // also without bits of blocks that are raw now
+   bool setsBits = false;
+   bool clearsBits = false;
+
+   ChunkCompressionStats stats = ChunkCompressionStats();
+
+   for(uint64_t blockIndex = firstBlock; blockIndex <= lastBlock; blockIndex++)
+   {
+      const off_t blockStart = blockIndex * blockSize;
+      const off_t writeStart = BEEGFS_MAX(offset, blockStart);
+      const off_t writeEnd = BEEGFS_MIN(endOffset, off_t(blockStart + blockSize) );
+      const char* const writeData = buf + (writeStart - offset);
+      const bool wasCompressed = testBlock(map, blockIndex);
+      const bool isFullBlock = newFileSize >= off_t(blockStart + blockSize);
+
+      // (compressed blocks are always full blocks within the map limit)
+      if(!wasCompressed && (!allowCompression || !isFullBlock || (blockIndex >= maxBlocks) ) )
+      { // block stays raw => write only the new data
+         writes.push_back({writeStart, writeData, size_t(writeEnd - writeStart), 0});
+         continue;
+      }
+
+      // assemble the new contents of the block
+
+      const char* blockData = writeData;
+
+      if( (writeStart != blockStart) || (writeEnd != off_t(blockStart + blockSize) ) )
+      {
+         if(!loadBlock(fd, blockIndex, wasCompressed, block) )
+            return -1;
+
+         memcpy(block + (writeStart - blockStart), writeData, writeEnd - writeStart);
+
+         blockData = block;
+         stats.numReadModifyWrites++;
+      }
+
+      char* const blockOut = out + (blockIndex - firstBlock) * blockSize;
+      size_t compressedLen = 0;
+
+      if(allowCompression)
+      {
+         const uint64_t startMicros = getThreadCPUMicros();
+
+         compressedLen = compressBlock(blockData, blockOut + sizeof(BlockHeader),
+            blockSize - sizeof(BlockHeader) - CHUNKCOMPRESSION_MIN_SAVINGS);
+
+         stats.compressMicros += getThreadCPUMicros() - startMicros;
+      }
+
+      if(compressedLen)
+      {
+         const BlockHeader header = {
+            HOST_TO_LE_32(CHUNKCOMPRESSION_BLOCK_MAGIC), HOST_TO_LE_32(uint32_t(compressedLen) ),
+            HOST_TO_LE_32(HashTk::hsieh32(blockOut + sizeof(BlockHeader), compressedLen) ) };
+
+         const size_t dataLen = sizeof(header) + compressedLen;
+         const size_t slotLen = (dataLen + CHUNKCOMPRESSION_IO_ALIGNMENT - 1) &
+            ~size_t(CHUNKCOMPRESSION_IO_ALIGNMENT - 1);
+
+         memcpy(blockOut, &header, sizeof(header) );
+         memset(blockOut + dataLen, 0, slotLen - dataLen);
+
+         writes.push_back({blockStart, blockOut, slotLen, blockSize - slotLen});
+
+         if(!wasCompressed)
+         {
+            setBlock(preWriteMap, blockIndex, true);
+            setsBits = true;
+         }
+
+         stats.numBlocksCompressed++;
+         stats.compressedRawBytes += blockSize;
+         stats.compressedDiskBytes += slotLen;
+      }
+      else
+      {
+         if(allowCompression)
+            stats.numBlocksIncompressible++;
+
+         if(wasCompressed)
+         { // replace the compressed block by the raw block
+            if(blockData == block)
+            { // block buffer is reused for the next block
+               memcpy(blockOut, block, blockSize);
+               blockData = blockOut;
+            }
+
+            writes.push_back({blockStart, blockData, blockSize, 0});
+            clearsBits = true;
+         }
+         else
+            writes.push_back({writeStart, writeData, size_t(writeEnd - writeStart), 0});
+      }
+   }
+
+   // 1. set bits before writing compressed blocks, so that an interrupted write can't leave
+   // compressed data in a block that is considered raw.
+
+   if(setsBits && !storeBlockMap(fd, preWriteMap) )
+   {
+      if(!allowCompression)
+         return -1;
+
+      LOG(GENERAL, WARNING, "Unable to store block map of compressed chunk, writing raw blocks.",
+         sysErr);
+
+      return writeUnlocked(fd, buf, count, offset, map, false);
+   }
+
+   // 2. write the data of all blocks...
+
+   for(auto iter = writes.begin(); iter != writes.end(); iter++)
+   {
+      if(!writeBlock(fd, *iter) )
+         return -1;
+   }
+
+   // compressed blocks don't extend the file to the end of the block
+   if(endOffset > statBuf.st_size)
+   {
+      const BlockWrite& lastWrite = writes.back();
+
+      if(off_t(lastWrite.offset + lastWrite.len) < endOffset)
+      {
+         if(ftruncate(fd, endOffset) )
+            return -1;
+      }
+   }
+
+   // 3. ...and only then punch the raw data after compressed blocks (which are marked in the map
+   // and complete now).
+
+   for(auto iter = writes.begin(); iter != writes.end(); iter++)
+   {
+      if(iter->punchLen && !punchHole(fd, *iter) )
+         return -1;
+   }
+
+   // 4. clear the bits of blocks that are raw now
+
+   if(clearsBits)
+   {
+      postWriteMap = preWriteMap;
+
+      for(uint64_t blockIndex = firstBlock; blockIndex <= lastBlock; blockIndex++)
+      {
+         if(testBlock(map, blockIndex) && !writes[blockIndex - firstBlock].punchLen)
+            setBlock(postWriteMap, blockIndex, false);
+      }
+
+      if(!storeBlockMap(fd, postWriteMap) )
+         return -1;
+   }
+
+   numBlocksCompressed.fetch_add(stats.numBlocksCompressed, std::memory_order_relaxed);
+   numBlocksIncompressible.fetch_add(stats.numBlocksIncompressible, std::memory_order_relaxed);
+   compressedRawBytes.fetch_add(stats.compressedRawBytes, std::memory_order_relaxed);
+   compressedDiskBytes.fetch_add(stats.compressedDiskBytes, std::memory_order_relaxed);
+   numReadModifyWrites.fetch_add(stats.numReadModifyWrites, std::memory_order_relaxed);
+   compressMicros.fetch_add(stats.compressMicros, std::memory_order_relaxed);
+
+   return count;
+}
+
+/**
+ * Like pread(), but decompresses compressed blocks.
+ *
+ * @return number of bytes read (less than count only at EOF) or -1 with errno set (EIO for
+ *    corrupt compressed blocks).
+ */
+ssize_t ChunkCompression::read(int fd, const std::string& chunkID, char* buf, size_t count,
+   off_t offset)
+{
+   const size_t blockSize = CHUNKCOMPRESSION_BLOCK_SIZE;
+
+   RWLockGuard lock(getLock(chunkID), SafeRWLock_READ);
+
+   BlockMap map;
+
+   if(!readBlockMap(fd, map) )
+      return -1;
+
+   if(map.empty() )
+      return pread(fd, buf, count, offset);
+
+   struct stat statBuf;
+
+   if(fstat(fd, &statBuf) )
+      return -1;
+
+   if(offset >= statBuf.st_size)
+      return 0;
+
+   count = BEEGFS_MIN(count, size_t(statBuf.st_size - offset) );
+
+   const off_t endOffset = offset + count;
+   size_t numRead = 0;
+
+   while(numRead < count)
+   {
+      const off_t readStart = offset + numRead;
+      const uint64_t blockIndex = readStart / blockSize;
+      const off_t blockStart = blockIndex * blockSize;
+
+      if(testBlock(map, blockIndex) )
+      {
+         char* const block = blockBuffer.get(blockSize);
+
+         if(!loadBlock(fd, blockIndex, true, block) )
+            return -1;
+
+         const size_t len = BEEGFS_MIN(count - numRead, size_t(blockStart + blockSize - readStart) );
+
+         memcpy(buf + numRead, block + (readStart - blockStart), len);
+
+         numRead += len;
+         continue;
+      }
+
+      // read all following raw blocks at once
+
+      uint64_t runEndBlock = blockIndex + 1;
+
+      while( (off_t(runEndBlock * blockSize) < endOffset) && !testBlock(map, runEndBlock) )
+         runEndBlock++;
+
+      const size_t len = BEEGFS_MIN(endOffset, off_t(runEndBlock * blockSize) ) - readStart;
+
+      ssize_t readRes = pread(fd, buf + numRead, len, readStart);
+      if(readRes == -1)
+         return -1;
+
+      numRead += readRes;
+
+      if(size_t(readRes) < len)
+         break; // EOF
+   }
+
+   return numRead;
+}
+
+/**
+ * Like ftruncate(). A compressed block that becomes the partial last block is stored raw.
+ *
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+int ChunkCompression::truncate(int fd, const std::string& chunkID, off_t length)
+{
+   const size_t blockSize = CHUNKCOMPRESSION_BLOCK_SIZE;
+
+   RWLockGuard lock(getLock(chunkID), SafeRWLock_WRITE);
+
+   BlockMap map;
+
+   if(!readBlockMap(fd, map) )
+      return -1;
+
+   if(map.empty() )
+      return ftruncate(fd, length);
+
+   const uint64_t firstCutBlock = length / blockSize; // first block that is partial or removed
+   const size_t partialLen = length % blockSize;
+
+   if(partialLen && testBlock(map, firstCutBlock) )
+   {
+      char* const block = blockBuffer.get(blockSize);
+
+      if(!loadBlock(fd, firstCutBlock, true, block) )
+         return -1;
+
+      if(!pwriteFull(fd, block, partialLen, firstCutBlock * blockSize) )
+         return -1;
+   }
+
+   if(ftruncate(fd, length) )
+      return -1;
+
+   // clear bits after the truncation, so that removed blocks are never considered raw
+
+   BlockMap newMap(map);
+
+   for(uint64_t blockIndex = firstCutBlock; blockIndex < map.size() * 8; blockIndex++)
+      setBlock(newMap, blockIndex, false);
+
+   if( (newMap != map) && !storeBlockMap(fd, newMap) )
+      return -1;
+
+   return 0;
+}
+
+/**
+ * Remove the block map of a chunk before it is rewritten from scratch (e.g. by a resync), which
+ * makes it a raw chunk until it is marked again by isCompressedChunk().
+ *
+ * Note: The caller must have truncated the chunk to 0 before.
+ */
+int ChunkCompression::removeBlockMap(int fd, const std::string& chunkID)
+{
+   RWLockGuard lock(getLock(chunkID), SafeRWLock_WRITE);
+
+   if(fremovexattr(fd, CHUNKCOMPRESSION_MAP_XATTR) && (errno != ENODATA) && (errno != ENOTSUP) )
+      return -1;
+
+   return 0;
+}
+
+ChunkCompressionStats ChunkCompression::getStats() const
+{
+   ChunkCompressionStats stats;
+
+   stats.numBlocksCompressed = numBlocksCompressed.load(std::memory_order_relaxed);
+   stats.numBlocksIncompressible = numBlocksIncompressible.load(std::memory_order_relaxed);
+   stats.compressedRawBytes = compressedRawBytes.load(std::memory_order_relaxed);
+   stats.compressedDiskBytes = compressedDiskBytes.load(std::memory_order_relaxed);
+   stats.numBlocksDecompressed = numBlocksDecompressed.load(std::memory_order_relaxed);
+   stats.numReadModifyWrites = numReadModifyWrites.load(std::memory_order_relaxed);
+   stats.compressMicros = compressMicros.load(std::memory_order_relaxed);
+   stats.decompressMicros = decompressMicros.load(std::memory_order_relaxed);
+
+   return stats;
+}
+
+/**
+ * Read the uncompressed contents of a block. Raw blocks beyond EOF are zero-filled.
+ *
+ * @param outBlock CHUNKCOMPRESSION_BLOCK_SIZE bytes
+ * @return false with errno set on error
+ */
+bool ChunkCompression::loadBlock(int fd, uint64_t blockIndex, bool isCompressed, char* outBlock)
+{
+   const size_t blockSize = CHUNKCOMPRESSION_BLOCK_SIZE;
+   const off_t blockStart = blockIndex * blockSize;
+
+   if(!isCompressed)
+   {
+      ssize_t readRes = pread(fd, outBlock, blockSize, blockStart);
+      if(readRes == -1)
+         return false;
+
+      memset(outBlock + readRes, 0, blockSize - readRes);
+      return true;
+   }
+
+   char* const slot = slotBuffer.get(blockSize);
+
+   ssize_t readRes = pread(fd, slot, blockSize, blockStart);
+   if(readRes == -1)
+      return false;
+
+   BlockHeader header = BlockHeader();
+
+   if(size_t(readRes) >= sizeof(header) )
+      memcpy(&header, slot, sizeof(header) );
+
+   const uint32_t compressedLen = LE_TO_HOST_32(header.compressedLen);
+
+   if( (LE_TO_HOST_32(header.magic) != CHUNKCOMPRESSION_BLOCK_MAGIC) ||
+       (compressedLen > readRes - sizeof(header) ) )
+   {
+      LOG(GENERAL, ERR, "Invalid header of compressed chunk block.", blockIndex);
+      errno = EIO;
+      return false;
+   }
+
+   // (e.g. an interrupted write)
+   if(LE_TO_HOST_32(header.checksum) != HashTk::hsieh32(slot + sizeof(header), compressedLen) )
+   {
+      LOG(GENERAL, ERR, "Checksum mismatch of compressed chunk block.", blockIndex);
+      errno = EIO;
+      return false;
+   }
+
+   const uint64_t startMicros = getThreadCPUMicros();
+
+   const bool decompressRes = decompressBlock(slot + sizeof(header), compressedLen, outBlock);
+
+   decompressMicros.fetch_add(getThreadCPUMicros() - startMicros, std::memory_order_relaxed);
+   numBlocksDecompressed.fetch_add(1, std::memory_order_relaxed);
+
+   if(!decompressRes)
+   {
+      LOG(GENERAL, ERR, "Corrupt compressed chunk block.", blockIndex);
+      errno = EIO;
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * @return false with errno set on error; a chunk without a block map has an empty map.
+ */
+bool ChunkCompression::readBlockMap(int fd, BlockMap& outMap)
+{
+   char buf[sizeof(BlockMapXattrHeader) + CHUNKCOMPRESSION_MAX_MAP_BYTES];
+
+   outMap.clear();
+
+   ssize_t getRes = fgetxattr(fd, CHUNKCOMPRESSION_MAP_XATTR, buf, sizeof(buf) );
+   if(getRes == -1)
+      return (errno == ENODATA) || (errno == ENOTSUP);
+
+   BlockMapXattrHeader header = BlockMapXattrHeader();
+
+   if(size_t(getRes) >= sizeof(header) )
+      memcpy(&header, buf, sizeof(header) );
+
+   if( (LE_TO_HOST_32(header.magic) != CHUNKCOMPRESSION_MAP_MAGIC) ||
+       (LE_TO_HOST_32(header.blockSize) != CHUNKCOMPRESSION_BLOCK_SIZE) )
+   {
+      LOG(GENERAL, ERR, "Invalid block map of compressed chunk.",
+         ("blockSize", LE_TO_HOST_32(header.blockSize) ) );
+      errno = EIO;
+      return false;
+   }
+
+   outMap.assign(buf + sizeof(header), buf + getRes);
+   return true;
+}
+
+/**
+ * Store the block map in the chunk's xattr (an empty map still marks the chunk as compressed
+ * chunk).
+ *
+ * @return false with errno set on error
+ */
+bool ChunkCompression::storeBlockMap(int fd, const BlockMap& map)
+{
+   size_t mapLen = map.size();
+
+   while(mapLen && !map[mapLen - 1])
+      mapLen--;
+
+   const BlockMapXattrHeader header = {
+      HOST_TO_LE_32(CHUNKCOMPRESSION_MAP_MAGIC), HOST_TO_LE_32(CHUNKCOMPRESSION_BLOCK_SIZE) };
+
+   std::vector<char> value(sizeof(header) + mapLen);
+
+   memcpy(&value[0], &header, sizeof(header) );
+   std::copy(map.begin(), map.begin() + mapLen, value.begin() + sizeof(header) );
+
+   return !fsetxattr(fd, CHUNKCOMPRESSION_MAP_XATTR, &value[0], value.size(), 0);
+}
+
+/**
+ * @return false with errno set on error
+ */
+bool ChunkCompression::writeBlock(int fd, const BlockWrite& write)
+{
+   return pwriteFull(fd, write.data, write.len, write.offset);
+}
+
+/**
+ * Punch the hole after the data of a compressed block.
+ *
+ * @return false with errno set on error
+ */
+bool ChunkCompression::punchHole(int fd, const BlockWrite& write)
+{
+   // (without hole punching support we still save disk I/O, but no space)
+   return !fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, write.offset + write.len,
+      write.punchLen) || (errno == EOPNOTSUPP);
+}
+
+/**
+ * Compress a full block.
+ *
+ * @return length of the compressed data; 0 if it doesn't fit into destLen bytes.
+ */
+size_t ChunkCompression::compressBlock(const char* src, char* dest, size_t destLen)
+{
+#ifdef BEEGFS_HAVE_LZ4
+   return LZ4_compress_default(src, dest, CHUNKCOMPRESSION_BLOCK_SIZE, destLen);
+#else
+   return 0;
+#endif
+}
+
+/**
+ * Decompress a full block.
+ *
+ * @param dest CHUNKCOMPRESSION_BLOCK_SIZE bytes
+ * @return false if the data is corrupt or doesn't decompress to a full block.
+ */
+bool ChunkCompression::decompressBlock(const char* src, size_t srcLen, char* dest)
+{
+#ifdef BEEGFS_HAVE_LZ4
+   return LZ4_decompress_safe(src, dest, srcLen, CHUNKCOMPRESSION_BLOCK_SIZE) ==
+      CHUNKCOMPRESSION_BLOCK_SIZE;
+#else
+   LOG(GENERAL, ERR, "Unable to read compressed chunk block: built without liblz4.");
+   return false;
+#endif
+}
+
+uint64_t ChunkCompression::getThreadCPUMicros()
+{
+   struct timespec now;
+
+   clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+
+   return now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+}
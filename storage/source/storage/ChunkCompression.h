@@ -0,0 +1,165 @@
+#pragma once
+
+#include <common/Common.h>
+#include <common/storage/StoragePoolId.h>
+#include <common/threading/RWLock.h>
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <vector>
+
+
+#define CHUNKCOMPRESSION_BLOCK_SIZE       (64*1024)
+#define CHUNKCOMPRESSION_MIN_SAVINGS      4096 // smaller savings wouldn't free a fs block
+#define CHUNKCOMPRESSION_MAP_XATTR        "user.beegfs_cmap"
+#define CHUNKCOMPRESSION_MAX_MAP_BYTES    3072 // bitmap size limit, i.e. 1.5GiB of a chunk file
+                                               // (fits into the xattr space of an ext4 inode)
+#define CHUNKCOMPRESSION_NUM_LOCKS        1024
+
+
+class StoragePoolStore;
+class StorageTarget;
+
+struct ChunkCompressionStats
+{
+   uint64_t numBlocksCompressed; // full blocks written compressed
+   uint64_t numBlocksIncompressible; // full blocks written raw because they didn't compress
+   uint64_t compressedRawBytes; // uncompressed size of the numBlocksCompressed blocks
+   uint64_t compressedDiskBytes; // on-disk size of the numBlocksCompressed blocks
+   uint64_t numBlocksDecompressed;
+   uint64_t numReadModifyWrites; // partial writes of full blocks
+   uint64_t compressMicros; // thread CPU time for compression
+   uint64_t decompressMicros; // thread CPU time for decompression (incl. read-modify-write)
+};
+
+/**
+ * Transparent compression of chunk files on selected targets (storeCompressTargets /
+ * storeCompressStoragePools), using liblz4.
+ *
+ * A compressed chunk file keeps its logical layout: block i of CHUNKCOMPRESSION_BLOCK_SIZE bytes
+ * starts at offset i * CHUNKCOMPRESSION_BLOCK_SIZE, and the file size is the logical chunk size.
+ * A block that is stored compressed contains a small header (with a checksum of the compressed
+ * data) and the LZ4 data at the start of the block; the rest of the block is a hole (punched), so
+ * compression saves disk space and disk I/O, while stat(), fsck and everything else that only
+ * looks at chunk sizes works unchanged.
+ * The chunk's block map (an xattr with one bit per block) tells which blocks are compressed. Its
+ * existence also marks the chunk as compressed chunk; chunks without it are plain raw files.
+ *
+ * Only full blocks below EOF are compressed; partial blocks (i.e. the last block of a chunk) and
+ * blocks that don't save at least CHUNKCOMPRESSION_MIN_SAVINGS are stored raw. Partial writes to
+ * a compressed block read, decompress and rewrite the whole block. Blocks beyond the limit of the
+ * block map (CHUNKCOMPRESSION_MAX_MAP_BYTES) are always stored raw.
+ *
+ * All accesses to a compressed chunk must go through this class; reads and writes of a chunk are
+ * serialized by a read/write lock (from a fixed set of locks, selected by chunk ID).
+ *
+ * A write stores the block map with the bits of newly compressed blocks first, then writes the
+ * data of all blocks, then punches the holes after compressed blocks and finally clears the bits
+ * of blocks that are raw now. So a block is never considered raw while it contains compressed
+ * data, and the raw data of a block is only punched after the map marks it as compressed. If a
+ * write is interrupted, the blocks that it wrote return the old data, the new data or EIO (for
+ * blocks with a broken header or checksum), but never wrong data.
+ */
+class ChunkCompression
+{
+   public:
+      ChunkCompression(const UInt16Set& targetIDs, const std::set<StoragePoolId>& poolIDs,
+         const StoragePoolStore* storagePools);
+      virtual ~ChunkCompression() {}
+
+      ChunkCompression(const ChunkCompression&) = delete;
+      ChunkCompression& operator=(const ChunkCompression&) = delete;
+
+      static bool isSupported();
+
+      bool isEnabled(uint16_t targetID) const;
+      bool isCompressedChunk(StorageTarget& target, int fd);
+      int getChunkOpenFlags(uint16_t targetID, bool targetHasCompressedChunks,
+         int openFlags) const;
+
+      ssize_t write(int fd, const std::string& chunkID, const char* buf, size_t count,
+         off_t offset);
+      ssize_t read(int fd, const std::string& chunkID, char* buf, size_t count, off_t offset);
+      int truncate(int fd, const std::string& chunkID, off_t length);
+      int removeBlockMap(int fd, const std::string& chunkID);
+
+      ChunkCompressionStats getStats() const;
+
+
+   protected:
+      typedef std::vector<uint8_t> BlockMap; // bit i of byte i/8 is set if block i is compressed
+
+      struct BlockWrite
+      {
+         off_t offset;
+         const char* data;
+         size_t len;
+         size_t punchLen; // length of the hole after the data (for compressed blocks)
+      };
+
+      virtual bool storeBlockMap(int fd, const BlockMap& map);
+      virtual bool writeBlock(int fd, const BlockWrite& write);
+      virtual bool punchHole(int fd, const BlockWrite& write);
+
+
+   private:
+      struct BlockHeader
+      {
+         uint32_t magic;
+         uint32_t compressedLen; // length of the LZ4 data after the header
+         uint32_t checksum; // HashTk::hsieh32() of the LZ4 data
+      };
+
+      const UInt16Set targetIDs;
+      const std::set<StoragePoolId> poolIDs;
+      const StoragePoolStore* storagePools;
+
+      std::unique_ptr<RWLock[]> locks;
+
+      std::atomic<uint64_t> numBlocksCompressed;
+      std::atomic<uint64_t> numBlocksIncompressible;
+      std::atomic<uint64_t> compressedRawBytes;
+      std::atomic<uint64_t> compressedDiskBytes;
+      std::atomic<uint64_t> numBlocksDecompressed;
+      std::atomic<uint64_t> numReadModifyWrites;
+      std::atomic<uint64_t> compressMicros;
+      std::atomic<uint64_t> decompressMicros;
+
+      ssize_t writeUnlocked(int fd, const char* buf, size_t count, off_t offset, BlockMap& map,
+         bool allowCompression);
+      bool loadBlock(int fd, uint64_t blockIndex, bool isCompressed, char* outBlock);
+
+      static bool readBlockMap(int fd, BlockMap& outMap);
+
+      static size_t compressBlock(const char* src, char* dest, size_t destLen);
+      static bool decompressBlock(const char* src, size_t srcLen, char* dest);
+
+      static uint64_t getThreadCPUMicros();
+
+      RWLock& getLock(const std::string& chunkID)
+      {
+         return locks[std::hash<std::string>()(chunkID) % CHUNKCOMPRESSION_NUM_LOCKS];
+      }
+
+      static bool testBlock(const BlockMap& map, uint64_t blockIndex)
+      {
+         return (blockIndex / 8 < map.size() ) && (map[blockIndex / 8] & (1 << (blockIndex % 8) ) );
+      }
+
+      static void setBlock(BlockMap& map, uint64_t blockIndex, bool isCompressed)
+      {
+         if(blockIndex / 8 >= map.size() )
+         {
+            if(!isCompressed)
+               return;
+
+            map.resize(blockIndex / 8 + 1);
+         }
+
+         if(isCompressed)
+            map[blockIndex / 8] |= (1 << (blockIndex % 8) );
+         else
+            map[blockIndex / 8] &= ~(1 << (blockIndex % 8) );
+      }
+};
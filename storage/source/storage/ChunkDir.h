@@ -1,8 +1,19 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
+#include <common/threading/Mutex.h>
 #include <common/threading/RWLock.h>
+#include <common/toolkit/FDHandle.h>
+
+#include <fcntl.h>
+
+
+#define CHUNKDIR_MAX_DIRFDS   16 /* max cached dir fds per ChunkDir (different targets/uid dirs) */
+
 
 /**
  * Our inode object, but for directories only. Files are in class FileInode.
@@ -21,7 +32,19 @@ class ChunkDir
 
    private:
       std::string id; // filesystem-wide unique string
-      
+
+      /* the same dir element exists on each target (and in the chunk and mirror dirs of a target),
+         so we keep an open fd per target dir fd and relative path */
+      struct DirFD
+      {
+         int targetFD;
+         std::string path;
+         std::shared_ptr<FDHandle> fd; // shared with callers that are currently using it
+      };
+
+      Mutex dirFDsMutex;
+      std::vector<DirFD> dirFDs;
+
 
    public:
 
@@ -47,5 +70,71 @@ class ChunkDir
          return this->id;
       }
 
-};
+      /**
+       * @return NULL if no fd is open for this dir on the given target
+       */
+      std::shared_ptr<FDHandle> getDirFD(int targetFD, const std::string& path)
+      {
+         const std::lock_guard<Mutex> lock(dirFDsMutex);
+
+         for (auto& dirFD : dirFDs)
+         {
+            if (dirFD.targetFD == targetFD && dirFD.path == path)
+               return dirFD.fd;
+         }
+
+         return nullptr;
+      }
 
+      /**
+       * Open the dir relative to targetFD (if it's not open already).
+       *
+       * @return NULL if the dir couldn't be opened
+       */
+      std::shared_ptr<FDHandle> openDirFD(int targetFD, const std::string& path)
+      {
+         std::shared_ptr<FDHandle> existing = getDirFD(targetFD, path);
+         if (existing)
+            return existing;
+
+         // (O_PATH is enough to use the fd as dirfd for openat() )
+         auto fd = std::make_shared<FDHandle>(
+            openat(targetFD, path.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC) );
+         if (!fd->valid() )
+            return nullptr;
+
+         const std::lock_guard<Mutex> lock(dirFDsMutex);
+
+         for (auto& dirFD : dirFDs)
+         {
+            if (dirFD.targetFD == targetFD && dirFD.path == path)
+               return dirFD.fd; // another thread was faster, ours is closed on return
+         }
+
+         if (dirFDs.size() >= CHUNKDIR_MAX_DIRFDS)
+            dirFDs.erase(dirFDs.begin() );
+
+         dirFDs.push_back({targetFD, path, fd});
+
+         return fd;
+      }
+
+      /**
+       * Forget the dir fd (e.g. because the dir was removed). Callers that still use the fd
+       * keep it open until they're done.
+       */
+      void invalidateDirFD(int targetFD, const std::string& path)
+      {
+         const std::lock_guard<Mutex> lock(dirFDsMutex);
+
+         for (auto iter = dirFDs.begin(); iter != dirFDs.end(); iter++)
+         {
+            if (iter->targetFD == targetFD && iter->path == path)
+            {
+               dirFDs.erase(iter);
+               return;
+            }
+         }
+      }
+
+};
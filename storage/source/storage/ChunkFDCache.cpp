@@ -0,0 +1,247 @@
+#include <common/app/log/Logger.h>
+#include "ChunkFDCache.h"
+
+
+const FDHandle ChunkFDCache::Ref::invalidFD;
+
+
+int ChunkFDCache::Ref::reset()
+{
+   if (!entry)
+      return 0;
+
+   const bool mustClose = cache ? cache->release(entry) : true;
+   const int closeRes = mustClose ? entry->fd.close() : 0;
+
+   entry.reset();
+   cache = nullptr;
+
+   return closeRes;
+}
+
+/**
+ * @param maxIdleFDs max number of fds to keep open that are not used by any session.
+ * @param processFDLimit max number of open fds of the process (0 if unknown); the cache closes
+ *    idle fds when it holds more than half of this.
+ */
+ChunkFDCache::ChunkFDCache(size_t maxIdleFDs, size_t processFDLimit) :
+   maxIdleFDs(maxIdleFDs), maxFDs(processFDLimit ? processFDLimit / 2 : SIZE_MAX), numFDs(0),
+   numOpens(0), numOpensAvoided(0), numEvictions(0)
+{
+}
+
+/**
+ * Get a reference to a cached fd of the given chunk.
+ *
+ * @return invalid Ref if there is no cached fd for chunkPath and openFlags, in which case the
+ *    caller opens the chunk and hands the fd to insert().
+ */
+ChunkFDCache::Ref ChunkFDCache::acquire(int targetFD, const std::string& chunkPath,
+   int openFlags)
+{
+   const std::lock_guard<Mutex> lock(mutex);
+
+   auto iter = entries.find(makeKey(targetFD, chunkPath) );
+   if (iter != entries.end() )
+   {
+      for (auto& entry : iter->second)
+      {
+         if (entry->openFlags != openFlags)
+            continue;
+
+         if (!entry->refCount)
+            idleLRU.erase(entry->lruIter);
+
+         entry->refCount++;
+         numOpensAvoided++;
+
+         return Ref(this, entry);
+      }
+   }
+
+   return Ref();
+}
+
+/**
+ * Add a newly opened chunk fd to the cache (or use the cached one if another session opened
+ * the chunk concurrently).
+ *
+ * @param fd may be invalid (e.g. chunk didn't exist for a read open), in which case the returned
+ *    Ref is invalid as well.
+ */
+ChunkFDCache::Ref ChunkFDCache::insert(int targetFD, const std::string& chunkPath,
+   int openFlags, FDHandle fd)
+{
+   if (!fd.valid() )
+      return Ref();
+
+   const std::string key = makeKey(targetFD, chunkPath);
+
+   std::shared_ptr<Entry> entry;
+   std::vector<std::shared_ptr<Entry>> closedEntries; // closed after unlock
+
+   {
+      const std::lock_guard<Mutex> lock(mutex);
+
+      EntryVec& chunkEntries = entries[key];
+
+      for (auto& existing : chunkEntries)
+      {
+         if (existing->openFlags != openFlags)
+            continue;
+
+         // another session opened the chunk in the meantime => use its fd, close ours
+         if (!existing->refCount)
+            idleLRU.erase(existing->lruIter);
+
+         existing->refCount++;
+         numOpensAvoided++;
+
+         entry = existing;
+         break;
+      }
+
+      if (!entry)
+      {
+         entry = std::make_shared<Entry>(key, openFlags, std::move(fd) );
+         entry->refCount = 1;
+
+         chunkEntries.push_back(entry);
+         numFDs++;
+         numOpens++;
+
+         trimIdleUnlocked(closedEntries);
+      }
+   }
+
+   return Ref(this, std::move(entry) );
+}
+
+/**
+ * Remove all fds of a chunk from the cache. To be called when the chunk file is unlinked or
+ * renamed.
+ */
+void ChunkFDCache::invalidate(int targetFD, const std::string& chunkPath)
+{
+   EntryVec chunkEntries; // closed after unlock (if idle)
+
+   {
+      const std::lock_guard<Mutex> lock(mutex);
+
+      auto iter = entries.find(makeKey(targetFD, chunkPath) );
+      if (iter == entries.end() )
+         return;
+
+      chunkEntries.swap(iter->second);
+      entries.erase(iter);
+
+      for (auto& entry : chunkEntries)
+      {
+         if (entry->refCount)
+            entry->isInvalidated = true; // closed by the last Ref
+         else
+            idleLRU.erase(entry->lruIter);
+
+         numFDs--;
+      }
+   }
+}
+
+ChunkFDCacheStats ChunkFDCache::getStats()
+{
+   const std::lock_guard<Mutex> lock(mutex);
+
+   ChunkFDCacheStats stats;
+
+   stats.numOpens = numOpens;
+   stats.numOpensAvoided = numOpensAvoided;
+   stats.numEvictions = numEvictions;
+   stats.numFDs = numFDs;
+   stats.numIdleFDs = idleLRU.size();
+
+   return stats;
+}
+
+/**
+ * @return true if the entry is no longer in the cache, so the caller (as the last owner) closes
+ *    the fd.
+ */
+bool ChunkFDCache::release(const std::shared_ptr<Entry>& entry)
+{
+   std::vector<std::shared_ptr<Entry>> closedEntries; // closed after unlock
+
+   const std::lock_guard<Mutex> lock(mutex);
+
+   if (--entry->refCount)
+      return false;
+
+   if (entry->isInvalidated)
+      return true;
+
+   if (!maxIdleFDs)
+   {
+      removeEntryUnlocked(entry.get() );
+      return true;
+   }
+
+   idleLRU.push_front(entry.get() );
+   entry->lruIter = idleLRU.begin();
+
+   trimIdleUnlocked(closedEntries);
+
+   return false;
+}
+
+/**
+ * Remove an entry from the map (but not from idleLRU).
+ */
+void ChunkFDCache::removeEntryUnlocked(const Entry* entry)
+{
+   auto iter = entries.find(entry->key);
+   if (iter == entries.end() )
+      return;
+
+   EntryVec& chunkEntries = iter->second;
+
+   for (auto entryIter = chunkEntries.begin(); entryIter != chunkEntries.end(); entryIter++)
+   {
+      if (entryIter->get() != entry)
+         continue;
+
+      chunkEntries.erase(entryIter);
+      numFDs--;
+      break;
+   }
+
+   if (chunkEntries.empty() )
+      entries.erase(iter);
+}
+
+/**
+ * Close least recently used idle fds while the cache is over its limits.
+ *
+ * @param outClosed receives the removed entries, so that the caller can close them after
+ *    releasing the mutex.
+ */
+void ChunkFDCache::trimIdleUnlocked(std::vector<std::shared_ptr<Entry>>& outClosed)
+{
+   while (!idleLRU.empty() && ( (idleLRU.size() > maxIdleFDs) || (numFDs > maxFDs) ) )
+   {
+      Entry* entry = idleLRU.back();
+      idleLRU.pop_back();
+
+      auto iter = entries.find(entry->key);
+
+      for (auto& chunkEntry : iter->second)
+      {
+         if (chunkEntry.get() == entry)
+         {
+            outClosed.push_back(chunkEntry);
+            break;
+         }
+      }
+
+      removeEntryUnlocked(entry);
+      numEvictions++;
+   }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <common/Common.h>
+#include <common/threading/Mutex.h>
+#include <common/toolkit/FDHandle.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+struct ChunkFDCacheStats
+{
+   uint64_t numOpens; // chunk files opened because there was no cached fd
+   uint64_t numOpensAvoided; // session opens that got a cached fd
+   uint64_t numEvictions; // idle fds closed because of the cache limits
+   size_t numFDs; // fds in the cache (referenced and idle)
+   size_t numIdleFDs; // fds in the cache that are not used by any session
+};
+
+/**
+ * Chunk file descriptors shared between the client sessions of a target.
+ *
+ * If many clients open the same chunk (e.g. the ranks of an MPI job reading the same striped
+ * file), each SessionLocalFile would do its own path lookup and hold its own fd otherwise. The fds
+ * are keyed by target dir fd (chunk or buddy mirror dir of a target), chunk path (which contains
+ * the chunk ID) and open flags, so that sessions only share fds with identical semantics. This is
+ * fine, because all chunk I/O uses pread/pwrite and never relies on the file offset of the fd.
+ *
+ * Fds that are no longer referenced by any session stay open (idle) up to maxIdleFDs, to avoid
+ * reopening chunks of files that are opened and closed repeatedly. Idle fds are closed in LRU
+ * order if there are more than maxIdleFDs of them or if the cache holds more than half of the
+ * process fd limit.
+ *
+ * Everything that removes or renames a chunk file must call invalidate(), so that later opens
+ * don't get an fd of the old file. Sessions that still use an invalidated fd keep it until they
+ * close it, just like they would keep their own fd of an unlinked file.
+ */
+class ChunkFDCache
+{
+   private:
+      struct Entry
+      {
+         Entry(const std::string& key, int openFlags, FDHandle fd) :
+            key(key), openFlags(openFlags), fd(std::move(fd)), refCount(0), isInvalidated(false)
+         {}
+
+         const std::string key;
+         const int openFlags;
+         FDHandle fd;
+         unsigned refCount; // number of Refs (protected by cache mutex)
+         bool isInvalidated; // removed from the cache while referenced
+         std::list<Entry*>::iterator lruIter; // only valid if refCount==0
+      };
+
+   public:
+      /**
+       * A session's reference to a (shared) chunk fd. The reference is returned to the cache on
+       * reset() or destruction.
+       */
+      class Ref
+      {
+         friend class ChunkFDCache;
+
+         public:
+            Ref() : cache(nullptr) {}
+
+            Ref(Ref&& other) : cache(other.cache), entry(std::move(other.entry))
+            {
+               other.cache = nullptr;
+            }
+
+            Ref& operator=(Ref&& other)
+            {
+               if (this != &other)
+               {
+                  reset();
+                  cache = other.cache;
+                  entry = std::move(other.entry);
+                  other.cache = nullptr;
+               }
+
+               return *this;
+            }
+
+            Ref(const Ref&) = delete;
+            Ref& operator=(const Ref&) = delete;
+
+            ~Ref()
+            {
+               reset();
+            }
+
+            /**
+             * Return the reference to the cache. The fd is closed if it is not cached (anymore).
+             *
+             * @return 0 or the result of FDHandle::close() if the fd was closed.
+             */
+            int reset();
+
+            /**
+             * @return invalid FDHandle if this doesn't reference an fd.
+             */
+            const FDHandle& getFD() const
+            {
+               return entry ? entry->fd : invalidFD;
+            }
+
+            bool valid() const
+            {
+               return entry && entry->fd.valid();
+            }
+
+         private:
+            Ref(ChunkFDCache* cache, std::shared_ptr<Entry> entry) :
+               cache(cache), entry(std::move(entry))
+            {}
+
+            ChunkFDCache* cache; // NULL for unshared fds
+            std::shared_ptr<Entry> entry;
+
+            static const FDHandle invalidFD;
+      };
+
+   public:
+      ChunkFDCache(size_t maxIdleFDs, size_t processFDLimit);
+
+      ChunkFDCache(const ChunkFDCache&) = delete;
+      ChunkFDCache& operator=(const ChunkFDCache&) = delete;
+
+      Ref acquire(int targetFD, const std::string& chunkPath, int openFlags);
+      Ref insert(int targetFD, const std::string& chunkPath, int openFlags, FDHandle fd);
+      void invalidate(int targetFD, const std::string& chunkPath);
+
+      ChunkFDCacheStats getStats();
+
+
+   private:
+      typedef std::vector<std::shared_ptr<Entry>> EntryVec; // one entry per open flags
+
+      const size_t maxIdleFDs;
+      const size_t maxFDs; // max fds in the cache before idle fds are closed
+
+      Mutex mutex;
+      std::unordered_map<std::string, EntryVec> entries; // key: targetFD + chunk path
+      std::list<Entry*> idleLRU; // most recently released first
+      size_t numFDs;
+
+      uint64_t numOpens;
+      uint64_t numOpensAvoided;
+      uint64_t numEvictions;
+
+      bool release(const std::shared_ptr<Entry>& entry);
+      void removeEntryUnlocked(const Entry* entry);
+      void trimIdleUnlocked(std::vector<std::shared_ptr<Entry>>& outClosed);
+
+      static std::string makeKey(int targetFD, const std::string& chunkPath)
+      {
+         return std::to_string(targetFD) + '/' + chunkPath;
+      }
+};
@@ -5,18 +5,23 @@
 #include "ChunkStore.h"
 
 
-#define CHUNKSTORE_REFCACHE_REMOVE_SKIP_SYNC   (4) /* n-th elements to be removed on sync sweep */
-#define CHUNKSTORE_REFCACHE_REMOVE_SKIP_ASYNC  (3) /* n-th elements to be removed on async sweep */
+#define CHUNKSTORE_REFCACHE_REMOVE_SKIP_SYNC   (4) /* 1/n of elements removed on sync sweep */
+#define CHUNKSTORE_REFCACHE_REMOVE_SKIP_ASYNC  (3) /* 1/n of elements removed on async sweep */
 
 /**
   * not inlined as we need to include <program/Program.h>
   */
-ChunkStore::ChunkStore()
+ChunkStore::ChunkStore() :
+   ChunkStore(Program::getApp()->getConfig()->getTuneDirCacheLimit() )
 {
-   App* app = Program::getApp();
-   Config* cfg = app->getConfig();
+}
 
-   this->refCacheSyncLimit = cfg->getTuneDirCacheLimit();
+/**
+ * @param dirCacheLimit max number of cached ChunkDirs (and thus of cached leaf dir fds per target)
+ */
+ChunkStore::ChunkStore(size_t dirCacheLimit)
+{
+   this->refCacheSyncLimit = dirCacheLimit;
    this->refCacheAsyncLimit = refCacheSyncLimit - (refCacheSyncLimit/2);
 }
 
@@ -74,6 +79,8 @@ ChunkDir* ChunkStore::referenceDir(std::string dirID)
       //   " Refcount: " + StringTk::intToStr(dirRefer->getRefCount() ) );
       IGNORE_UNUSED_VARIABLE(logContext);
 
+      refCachePolicy.touch(dirID); // (safe under read lock)
+
       if (!wasReferenced)
          cacheAddUnlocked(dirID, dirRefer);
 
@@ -200,6 +207,7 @@ void ChunkStore::cacheAddUnlocked(std::string& dirID, ChunkDirReferencer* dirRef
    if(refCache.insert(DirCacheMapVal(dirID, dirRefer) ).second)
    { // new insert => inc refcount
       dirRefer->reference();
+      refCachePolicy.insert(dirID);
 
       // LOG_DEBUG(logContext, Log_SPAM,  std::string("DirID: ") + dirID +
       //   " Refcount: " + StringTk::intToStr(dirRefer->getRefCount() ) );
@@ -215,6 +223,7 @@ void ChunkStore::cacheRemoveUnlocked(std::string& dirID)
       return;
 
    releaseDirUnlocked(dirID);
+   refCachePolicy.remove(dirID);
    refCache.erase(iter);
 }
 
@@ -232,6 +241,8 @@ void ChunkStore::cacheRemoveAllUnlocked()
 
       iter = iterNext;
    }
+
+   refCachePolicy.clear();
 }
 
 /**
@@ -242,8 +253,7 @@ void ChunkStore::cacheRemoveAllUnlocked()
  */
 bool ChunkStore::cacheSweepUnlocked(bool isSyncSweep)
 {
-   // sweeping means we remove every n-th element from the cache, starting with a random element
-      // in the range 0 to n
+   // sweeping means we remove 1/n of the elements from the cache, selected by the cache policy
    size_t cacheLimit;
    size_t removeSkipNum;
 
@@ -264,39 +274,13 @@ bool ChunkStore::cacheSweepUnlocked(bool isSyncSweep)
       return false;
 
 
-   // pick a random start element (note: the element will be removed in first loop pass below)
+   size_t numRemove = refCache.size() / removeSkipNum;
+   std::string dirID;
 
-   unsigned randStart = randGen.getNextInRange(0, removeSkipNum - 1);
-   DirCacheMapIter iter = refCache.begin();
-
-   while(randStart--)
-      iter++;
-
-
-   // walk over all cached elements and remove every n-th element
-
-   unsigned i = removeSkipNum-1; /* counts to every n-th element ("remoteSkipNum-1" to remove the
-      random start element in the first loop pass) */
-
-   while(iter != refCache.end() )
+   while(numRemove-- && refCachePolicy.evict(dirID) )
    {
-      i++;
-
-      if(i == removeSkipNum)
-      {
-         releaseDirUnlocked(iter->first);
-
-         DirCacheMapIter iterNext(iter);
-         iterNext++;
-
-         refCache.erase(iter);
-
-         iter = iterNext;
-
-         i = 0;
-      }
-      else
-         iter++;
+      releaseDirUnlocked(dirID);
+      refCache.erase(dirID);
    }
 
    return true;
@@ -337,6 +321,20 @@ size_t ChunkStore::getCacheSize()
    return dirsSize;
 }
 
+/**
+ * @return hit/miss/eviction counters of the cache policy
+ */
+CachePolicyStats ChunkStore::getCacheStats()
+{
+   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+
+   CachePolicyStats stats = refCachePolicy.getStats();
+
+   safeLock.unlock(); // U N L O C K
+
+   return stats;
+}
+
 
 /**
  * Iterate through chunkDirPath and rmdir each path-element beginning with uidXYZ.
@@ -375,6 +373,9 @@ bool ChunkStore::rmdirChunkDirPath(int targetFD, Path* chunkDirPath)
 
       if (likely(chunkDir) )
       {
+         if (!rmdirRes)
+            chunkDir->invalidateDirFD(targetFD, rmDirPath);
+
          chunkDir->unlock();        // UNLOCK
          releaseDir(chunkDirID);
       }
@@ -391,6 +392,9 @@ bool ChunkStore::rmdirChunkDirPath(int targetFD, Path* chunkDirPath)
          break;
       }
 
+      if (chunkDirPath->size() <= 1)
+         break; // removed the uid dir (and dirname() would be ".")
+
       *chunkDirPath = chunkDirPath->dirname();
       chunkDirPos = chunkDirPath->size() - 1;
    }
@@ -587,7 +591,7 @@ std::pair<FhgfsOpsErr, int> ChunkStore::openAndChown(const int targetFD, const s
    if (fchown(fd, quota.uid, quota.gid))
    {
       LOG(GENERAL, ERR, "Failed to chown().", path);
-      unlink(path.c_str());
+      unlinkat(targetFD, path.c_str(), 0);
       close(fd);
       return {FhgfsOpsErr_INTERNAL, -1};
    }
@@ -635,20 +639,39 @@ FhgfsOpsErr ChunkStore::openChunkFile(int targetFD, const Path* chunkDirPath,
       }
    }
 
+   Path chunkDirPathTmp;
+   if (!chunkDirPath)
+   {
+      chunkDirPathTmp = chunkFilePathStr;
+      chunkDirPathTmp = chunkDirPathTmp.dirname();
+      chunkDirPath = &chunkDirPathTmp;
+   }
+
+   // only the V3 layout has ChunkDirs for the hash dirs (see mkdirChunkDirPath() )
+   const bool useDirFDCache = hasOrigFeature && !chunkDirPath->empty();
+
+   if (useDirFDCache &&
+       openChunkFileInCachedDir(targetFD, *chunkDirPath, chunkFilePathStr, openFlags, *quotaInfo,
+          retVal, *outFD) )
+   {
+      if (retVal != FhgfsOpsErr_SUCCESS)
+         LOG(GENERAL, ERR, "Failed to create file.", chunkFilePathStr, retVal);
+
+      return retVal;
+   }
+
    std::tie(retVal, *outFD) = openAndChown(targetFD, chunkFilePathStr, openFlags, *quotaInfo);
    if (retVal == FhgfsOpsErr_SUCCESS)
+   {
+      if (useDirFDCache)
+         cacheChunkDirFD(targetFD, *chunkDirPath);
+
       return FhgfsOpsErr_SUCCESS;
+   }
 
    // hash dir didn't exist yet or real error?
    if (retVal == FhgfsOpsErr_PATHNOTEXISTS)
    {  // hash dir just didn't exist yet => create it and open again
-      Path chunkDirPathTmp;
-      if (!chunkDirPath)
-      {
-         chunkDirPathTmp = chunkFilePathStr;
-         chunkDirPathTmp = chunkDirPathTmp.dirname();
-         chunkDirPath = &chunkDirPathTmp;
-      }
 
       ChunkDir* lastChunkDirElement;
 
@@ -667,6 +690,10 @@ FhgfsOpsErr ChunkStore::openChunkFile(int targetFD, const Path* chunkDirPath,
 
       if (lastChunkDirElement) // old V2 files do not get this
       {
+         // (still locked, so a racing rmdir can't remove the dir before we cached its fd)
+         if (retVal == FhgfsOpsErr_SUCCESS)
+            lastChunkDirElement->openDirFD(targetFD, chunkDirPath->str() );
+
          /* Unlock and release the last element once we have created
           * (or at least tried to create) the file. */
          lastChunkDirElement->unlock();
@@ -681,6 +708,94 @@ FhgfsOpsErr ChunkStore::openChunkFile(int targetFD, const Path* chunkDirPath,
 }
 
 
+/**
+ * Open the chunk file relative to the cached fd of its parent dir, so that the kernel only needs
+ * to look up the last path component.
+ *
+ * @return false if the dir fd is not cached (or the dir has been removed), in which case the
+ *    caller opens the chunk by its full path; true if outResult and outFD are set.
+ */
+bool ChunkStore::openChunkFileInCachedDir(int targetFD, const Path& chunkDirPath,
+   const std::string& chunkFilePathStr, int openFlags, const SessionQuotaInfo& quota,
+   FhgfsOpsErr& outResult, int& outFD)
+{
+   std::shared_ptr<FDHandle> dirFD = getCachedChunkDirFD(targetFD, chunkDirPath);
+   if (!dirFD)
+      return false;
+
+   const std::string fileName = chunkFilePathStr.substr(chunkFilePathStr.rfind('/') + 1);
+
+   std::tie(outResult, outFD) = openAndChown(**dirFD, fileName, openFlags, quota);
+
+   if (outResult == FhgfsOpsErr_PATHNOTEXISTS)
+   { // with O_CREAT, this means the dir was removed (maybe recreated since then)
+      if (openFlags & O_CREAT)
+         invalidateCachedChunkDirFD(targetFD, chunkDirPath);
+
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * @return NULL if the ChunkDir is not in the cache or has no open fd for this target.
+ */
+std::shared_ptr<FDHandle> ChunkStore::getCachedChunkDirFD(int targetFD, const Path& chunkDirPath)
+{
+   const std::string dirID = getLeafDirID(chunkDirPath);
+   std::shared_ptr<FDHandle> dirFD;
+
+   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+
+   DirCacheMapIter iter = refCache.find(dirID);
+   if (iter != refCache.end() )
+   {
+      dirFD = iter->second->getReferencedObject()->getDirFD(targetFD, chunkDirPath.str() );
+
+      if (dirFD)
+         refCachePolicy.touch(dirID); // (safe under read lock)
+   }
+
+   safeLock.unlock(); // U N L O C K
+
+   return dirFD;
+}
+
+void ChunkStore::invalidateCachedChunkDirFD(int targetFD, const Path& chunkDirPath)
+{
+   const std::string dirID = getLeafDirID(chunkDirPath);
+
+   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+
+   DirCacheMapIter iter = refCache.find(dirID);
+   if (iter != refCache.end() )
+      iter->second->getReferencedObject()->invalidateDirFD(targetFD, chunkDirPath.str() );
+
+   safeLock.unlock(); // U N L O C K
+}
+
+/**
+ * Open the leaf dir of chunkDirPath and keep its fd in the ChunkDir, which is added to the ref
+ * cache (and thus closed when the ChunkDir is evicted).
+ */
+void ChunkStore::cacheChunkDirFD(int targetFD, const Path& chunkDirPath)
+{
+   const std::string dirID = getLeafDirID(chunkDirPath);
+
+   ChunkDir* chunkDir = referenceDir(dirID);
+   if (unlikely(!chunkDir) )
+      return;
+
+   // read lock to exclude rmdirChunkDirPath(), which invalidates the fd of removed dirs
+   chunkDir->readLock();
+   chunkDir->openDirFD(targetFD, chunkDirPath.str() );
+   chunkDir->unlock();
+
+   releaseDir(dirID);
+}
+
+
 /**
  * V2 chunkDirs (2012.10 style layout: hashDir1/hashDir2) might have wrong permssions, correct that.
  */
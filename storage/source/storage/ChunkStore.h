@@ -4,7 +4,7 @@
 #include <common/threading/Mutex.h>
 #include <common/toolkit/AtomicObjectReferencer.h>
 #include <common/toolkit/MetadataTk.h>
-#include <common/toolkit/Random.h>
+#include <common/toolkit/ClockProCachePolicy.h>
 #include <common/storage/Path.h>
 #include <common/storage/StorageDefinitions.h>
 #include <common/storage/StorageErrors.h>
@@ -37,6 +37,7 @@ class ChunkStore
 {
    public:
       ChunkStore();
+      explicit ChunkStore(size_t dirCacheLimit);
 
       ~ChunkStore()
       {
@@ -48,6 +49,7 @@ class ChunkStore
       void releaseDir(std::string dirID);
 
       size_t getCacheSize();
+      CachePolicyStats getCacheStats();
 
       bool cacheSweepAsync();
 
@@ -65,7 +67,7 @@ class ChunkStore
 
       size_t refCacheSyncLimit; // synchronous access limit (=> async limit plus some grace size)
       size_t refCacheAsyncLimit; // asynchronous cleanup limit (this is what the user configures)
-      Random randGen; // for random cache removal
+      ClockProCachePolicy<std::string> refCachePolicy; // selects entries to remove on sweep
       DirCacheMap refCache;
 
       RWLock rwlock;
@@ -89,6 +91,13 @@ class ChunkStore
       std::pair<FhgfsOpsErr, int> openAndChown(const int targetFD, const std::string& path,
          const int openFlags, const SessionQuotaInfo& quota);
 
+      bool openChunkFileInCachedDir(int targetFD, const Path& chunkDirPath,
+         const std::string& chunkFilePathStr, int openFlags, const SessionQuotaInfo& quota,
+         FhgfsOpsErr& outResult, int& outFD);
+      std::shared_ptr<FDHandle> getCachedChunkDirFD(int targetFD, const Path& chunkDirPath);
+      void invalidateCachedChunkDirFD(int targetFD, const Path& chunkDirPath);
+      void cacheChunkDirFD(int targetFD, const Path& chunkDirPath);
+
       // inlined
 
       /**
@@ -102,5 +111,13 @@ class ChunkStore
          return pathElement + "-l" + StringTk::uintToStr(pathDepth);
       }
 
+      /**
+       * @return ID of the last element of chunkDirPath (as used by mkdirChunkDirPath() ).
+       */
+      std::string getLeafDirID(const Path& chunkDirPath)
+      {
+         return getUniqueDirID(chunkDirPath.back(), chunkDirPath.size() - 1);
+      }
+
 };
 
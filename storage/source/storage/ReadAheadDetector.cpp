@@ -0,0 +1,278 @@
+#include "ReadAheadDetector.h"
+
+#include <algorithm>
+
+
+/**
+ * Record an access and compute the ranges to read ahead.
+ */
+ReadAheadAdvice ReadAheadDetector::onRead(int64_t offset, int64_t len, const Config& cfg)
+{
+   ReadAheadAdvice advice = ReadAheadAdvice();
+
+   if( (offset < 0) || (len <= 0) || !cfg.initialWindow)
+      return advice;
+
+   tick++;
+
+   bool isSequential;
+   Stream* stream = findStream(offset, &isSequential);
+
+   if(!stream)
+   { // access doesn't continue any stream => stride candidate or new stream
+      stream = findStrideCandidate(offset);
+
+      if(stream)
+      {
+         stream->stride = offset - stream->lastOffset;
+         stream->numMatches = 1;
+         stream->seqBytes = len;
+         stream->raStart = 0;
+         stream->raEnd = 0;
+         stream->window = cfg.initialWindow;
+         stream->lastOffset = offset;
+         stream->lastLen = len;
+         stream->lastUseTick = tick;
+      }
+      else
+         replaceLRUStream(offset, len, cfg);
+
+      return advice;
+   }
+
+   if(offset == stream->lastOffset)
+   { // repeated access, doesn't change the pattern
+      stream->lastUseTick = tick;
+      return advice;
+   }
+
+   stream->stride = offset - stream->lastOffset;
+   stream->numMatches++;
+   stream->seqBytes = isSequential ? (stream->seqBytes + len) : 0;
+   stream->lastOffset = offset;
+   stream->lastLen = len;
+   stream->lastUseTick = tick;
+
+   if(isSequential)
+   {
+      if(stream->seqBytes < cfg.triggerSize)
+         return advice;
+
+      advice.pattern = ReadAheadPattern_SEQUENTIAL;
+   }
+   else
+   {
+      if(stream->numMatches < READAHEADDETECTOR_MIN_MATCHES)
+         return advice;
+
+      advice.pattern = (stream->stride > 0) ? ReadAheadPattern_STRIDED : ReadAheadPattern_BACKWARD;
+   }
+
+   if(stream->raEnd > stream->raStart)
+   { // read-ahead was issued for this stream before
+      advice.isHit = (offset >= stream->raStart) && (offset + len <= stream->raEnd);
+      advice.isMiss = !advice.isHit;
+
+      if(advice.isMiss) // read-ahead didn't keep up => larger window
+         stream->window = std::min(stream->window * 2, std::max(cfg.maxWindow, cfg.initialWindow) );
+   }
+
+   if(isSequential)
+      computeSequentialRanges(*stream, offset + len, advice);
+   else
+      computeStridedRanges(*stream, advice);
+
+   if(!advice.ranges.empty() ) // ramp up while the pattern continues
+      stream->window = std::min(stream->window * 2, std::max(cfg.maxWindow, cfg.initialWindow) );
+
+   return advice;
+}
+
+/**
+ * Find the stream whose next access is at the given offset (preferring sequential matches) or
+ * whose last access was at the given offset.
+ *
+ * @param outIsSequential true if the access continues the previous access of the stream
+ * @return NULL if no stream matches
+ */
+ReadAheadDetector::Stream* ReadAheadDetector::findStream(int64_t offset, bool* outIsSequential)
+{
+   Stream* strideMatch = NULL;
+
+   for(unsigned i = 0; i < READAHEADDETECTOR_NUM_STREAMS; i++)
+   {
+      Stream& stream = streams[i];
+
+      if(!stream.isValid)
+         continue;
+
+      if(offset == stream.lastOffset + stream.lastLen)
+      {
+         *outIsSequential = true;
+         return &stream;
+      }
+
+      if( (offset == stream.lastOffset) ||
+         (stream.stride && (offset == stream.lastOffset + stream.stride) ) )
+         strideMatch = strideMatch ? strideMatch : &stream;
+   }
+
+   *outIsSequential = false;
+   return strideMatch;
+}
+
+/**
+ * Find the most recently used stream that has seen only one access, so that the given offset
+ * defines its stride.
+ *
+ * @return NULL if there is no such stream within READAHEADDETECTOR_MAX_STRIDE
+ */
+ReadAheadDetector::Stream* ReadAheadDetector::findStrideCandidate(int64_t offset)
+{
+   Stream* candidate = NULL;
+
+   for(unsigned i = 0; i < READAHEADDETECTOR_NUM_STREAMS; i++)
+   {
+      Stream& stream = streams[i];
+      const int64_t delta = offset - stream.lastOffset;
+
+      if(!stream.isValid || stream.numMatches || !delta ||
+         (std::abs(delta) > READAHEADDETECTOR_MAX_STRIDE) )
+         continue;
+
+      if(!candidate || (stream.lastUseTick > candidate->lastUseTick) )
+         candidate = &stream;
+   }
+
+   return candidate;
+}
+
+ReadAheadDetector::Stream* ReadAheadDetector::replaceLRUStream(int64_t offset, int64_t len,
+   const Config& cfg)
+{
+   Stream* lruStream = &streams[0];
+
+   for(unsigned i = 1; i < READAHEADDETECTOR_NUM_STREAMS; i++)
+   {
+      if(!lruStream->isValid)
+         break;
+
+      if(!streams[i].isValid || (streams[i].lastUseTick < lruStream->lastUseTick) )
+         lruStream = &streams[i];
+   }
+
+   *lruStream = Stream();
+
+   lruStream->isValid = true;
+   lruStream->lastOffset = offset;
+   lruStream->lastLen = len;
+   lruStream->seqBytes = len;
+   lruStream->window = cfg.initialWindow;
+   lruStream->lastUseTick = tick;
+
+   return lruStream;
+}
+
+/**
+ * Read ahead the next window after end, if less than half a window is left from earlier read-ahead.
+ */
+void ReadAheadDetector::computeSequentialRanges(Stream& stream, int64_t end,
+   ReadAheadAdvice& advice)
+{
+   if(stream.raEnd - end >= stream.window / 2)
+      return; // enough data ahead
+
+   const int64_t start = std::max(stream.raEnd, end);
+   const int64_t newEnd = end + stream.window;
+
+   if(newEnd <= start)
+      return;
+
+   advice.ranges.push_back({start, newEnd - start});
+
+   if(stream.raEnd < end)
+      stream.raStart = start; // earlier read-ahead is behind us
+
+   stream.raEnd = newEnd;
+}
+
+/**
+ * Read ahead the next records (of the last access length) at multiples of the stride, up to one
+ * window of data or READAHEADDETECTOR_MAX_RANGES records, if less than half of them are covered by
+ * earlier read-ahead. Adjacent records (e.g. backwards sequential access) are merged.
+ */
+void ReadAheadDetector::computeStridedRanges(Stream& stream, ReadAheadAdvice& advice)
+{
+   const int64_t recordLen = stream.lastLen;
+   const bool isBackward = stream.stride < 0;
+   const unsigned numRecords = std::max<int64_t>(1,
+      std::min<int64_t>(stream.window / recordLen, READAHEADDETECTOR_MAX_RANGES) );
+
+   unsigned numCovered = 0;
+
+   for(unsigned k = 1; k <= numRecords; k++)
+   {
+      const int64_t recordStart = stream.lastOffset + k * stream.stride;
+
+      if( (recordStart >= stream.raStart) && (recordStart + recordLen <= stream.raEnd) )
+         numCovered++;
+   }
+
+   if(numCovered * 2 >= numRecords)
+      return; // enough data ahead
+
+   int64_t issuedStart = -1;
+   int64_t issuedEnd = -1;
+
+   for(unsigned k = 1; k <= numRecords; k++)
+   {
+      const int64_t recordStart = std::max<int64_t>(0, stream.lastOffset + k * stream.stride);
+      const int64_t recordEnd = stream.lastOffset + k * stream.stride + recordLen;
+
+      if(recordEnd <= 0)
+         break; // backward stream reached the beginning of the file
+
+      if( (recordStart >= stream.raStart) && (recordEnd <= stream.raEnd) )
+         continue; // already prefetched
+
+      if(advice.ranges.empty() )
+      {
+         advice.ranges.push_back({recordStart, recordEnd - recordStart});
+         issuedStart = recordStart;
+         issuedEnd = recordEnd;
+         continue;
+      }
+
+      ReadAheadRange& lastRange = advice.ranges.back();
+
+      if(!isBackward && (recordStart <= lastRange.offset + lastRange.len) )
+         lastRange.len = std::max(lastRange.len, recordEnd - lastRange.offset);
+      else
+      if(isBackward && (recordEnd >= lastRange.offset) )
+      {
+         lastRange.len = std::max(lastRange.offset + lastRange.len, recordEnd) - recordStart;
+         lastRange.offset = recordStart;
+      }
+      else
+         advice.ranges.push_back({recordStart, recordEnd - recordStart});
+
+      issuedStart = std::min(issuedStart, recordStart);
+      issuedEnd = std::max(issuedEnd, recordEnd);
+   }
+
+   if(advice.ranges.empty() )
+      return;
+
+   // covered region: extend the earlier one if records ahead were still covered, else start anew
+
+   if(!numCovered)
+   {
+      stream.raStart = issuedStart;
+      stream.raEnd = issuedEnd;
+   }
+   else
+   {
+      stream.raStart = std::min(stream.raStart, issuedStart);
+      stream.raEnd = std::max(stream.raEnd, issuedEnd);
+   }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <common/Common.h>
+
+#include <vector>
+
+
+#define READAHEADDETECTOR_NUM_STREAMS  4 // interleaved access streams tracked per session
+#define READAHEADDETECTOR_MAX_STRIDE   (256*1024*1024) // larger offset jumps are random access
+#define READAHEADDETECTOR_MAX_RANGES   16 // max records prefetched at once for strided access
+#define READAHEADDETECTOR_MIN_MATCHES  2 // strided accesses needed before read-ahead starts
+
+
+enum ReadAheadPattern
+{
+   ReadAheadPattern_NONE, // random access or not enough accesses yet
+   ReadAheadPattern_SEQUENTIAL,
+   ReadAheadPattern_STRIDED, // fixed positive offset delta between accesses
+   ReadAheadPattern_BACKWARD, // fixed negative offset delta (incl. backwards sequential)
+};
+
+struct ReadAheadRange
+{
+   int64_t offset;
+   int64_t len;
+};
+
+/**
+ * Result of ReadAheadDetector::onRead().
+ */
+struct ReadAheadAdvice
+{
+   ReadAheadPattern pattern; // pattern of the stream that the access belongs to
+   bool isHit; // access was completely covered by earlier read-ahead of its stream
+   bool isMiss; // access of a detected pattern that earlier read-ahead didn't cover
+   std::vector<ReadAheadRange> ranges; // to be prefetched now, empty if none
+};
+
+/**
+ * Detects the access pattern of the reads of a session file and computes the ranges to read ahead.
+ *
+ * Up to READAHEADDETECTOR_NUM_STREAMS interleaved streams are tracked (e.g. multiple readers or
+ * record streams of an MPI-IO or data loader process sharing a session). Each access is assigned
+ * to the stream whose next access it matches (contiguous with the previous access or at the
+ * previous offset + stride), otherwise it pairs with a stream that has only seen one access to
+ * form a stride candidate, otherwise it replaces the least recently used stream.
+ *
+ * Sequential streams start read-ahead after triggerSize bytes, strided and backward streams after
+ * READAHEADDETECTOR_MIN_MATCHES matching accesses. The window starts at initialWindow and doubles
+ * with each read-ahead that is issued (up to maxWindow) as long as the stream keeps its pattern,
+ * and after a miss (read-ahead didn't keep up). New read-ahead is issued when less than half of a
+ * window is left ahead of the current access.
+ *
+ * Note: Not thread-safe, the caller must serialize calls (see SessionLocalFile).
+ */
+class ReadAheadDetector
+{
+   public:
+      struct Config
+      {
+         int64_t triggerSize; // sequential bytes before read-ahead starts
+         int64_t initialWindow; // 0 disables read-ahead
+         int64_t maxWindow;
+      };
+
+      ReadAheadDetector() : streams(), tick(0) { }
+
+      ReadAheadAdvice onRead(int64_t offset, int64_t len, const Config& cfg);
+
+
+   private:
+      struct Stream
+      {
+         bool isValid;
+         int64_t lastOffset; // offset of the last access
+         int64_t lastLen; // length of the last access
+         int64_t stride; // offset delta between the last two accesses, 0 if unknown
+         unsigned numMatches; // consecutive accesses that followed the pattern
+         int64_t seqBytes; // bytes read sequentially since the stream started
+         int64_t raStart; // [raStart, raEnd) was prefetched (for strided incl. gaps)
+         int64_t raEnd;
+         int64_t window; // current read-ahead window in bytes
+         uint64_t lastUseTick;
+      };
+
+      Stream streams[READAHEADDETECTOR_NUM_STREAMS];
+      uint64_t tick; // increased with each access, for LRU replacement
+
+      Stream* findStream(int64_t offset, bool* outIsSequential);
+      Stream* findStrideCandidate(int64_t offset);
+      Stream* replaceLRUStream(int64_t offset, int64_t len, const Config& cfg);
+
+      void computeSequentialRanges(Stream& stream, int64_t end, ReadAheadAdvice& advice);
+      void computeStridedRanges(Stream& stream, ReadAheadAdvice& advice);
+};
@@ -2,6 +2,7 @@
 #include <common/net/message/nodes/SetTargetConsistencyStatesMsg.h>
 #include <common/net/message/nodes/SetTargetConsistencyStatesRespMsg.h>
 #include <common/storage/Storagedata.h>
+#include <common/system/System.h>
 #include <common/threading/RWLockGuard.h>
 #include <common/toolkit/StorageTk.h>
 #include <common/toolkit/StringTk.h>
@@ -18,6 +19,7 @@
 
 #define BUDDY_NEEDS_RESYNC_FILENAME        ".buddyneedsresync"
 #define LAST_BUDDY_COMM_TIMESTAMP_FILENAME ".lastbuddycomm"
+#define COMPRESSED_CHUNKS_FILENAME         ".compressedchunks"
 
 
 StorageTarget::StorageTarget(Path path, uint16_t targetID, TimerQueue& timerQueue,
@@ -27,7 +29,7 @@ StorageTarget::StorageTarget(Path path, uint16_t targetID, TimerQueue& timerQueu
    lastBuddyCommFile((this->path / LAST_BUDDY_COMM_TIMESTAMP_FILENAME).str(), S_IRUSR | S_IWUSR),
    timerQueue(timerQueue), mgmtNodes(mgmtNodes),
    buddyGroupMapper(buddyGroupMapper), buddyResyncInProgress(false),
-   consistencyState(TargetConsistencyState_GOOD), cleanShutdown(false)
+   hasCompressedChunks(false), consistencyState(TargetConsistencyState_GOOD), cleanShutdown(false)
 {
    const auto chunkPath = this->path / CONFIG_CHUNK_SUBDIR_NAME;
    chunkFD = FDHandle(open(chunkPath.str().c_str(), O_RDONLY | O_DIRECTORY));
@@ -43,6 +45,10 @@ StorageTarget::StorageTarget(Path path, uint16_t targetID, TimerQueue& timerQueu
 
    quotaBlockDevice = QuotaBlockDevice::getBlockDeviceOfTarget(this->path.str(), targetID);
 
+   numaNode = System::getNumaNodeOfPath(this->path.str() );
+
+   hasCompressedChunks = !access( (this->path / COMPRESSED_CHUNKS_FILENAME).str().c_str(), F_OK);
+
    if (buddyNeedsResyncFile.read().get_value_or(0) & BUDDY_RESYNC_UNACKED_FLAG)
    {
       setBuddyNeedsResyncEntry = timerQueue.enqueue(std::chrono::seconds(0), [this] {
@@ -83,6 +89,31 @@ bool StorageTarget::isTargetDir(const Path& path)
    return StorageTk::checkStorageFormatFileExists(path.str());
 }
 
+/**
+ * Remember (persistently) that chunks of this target might have compressed blocks, so that they
+ * are still read correctly after compression was disabled for the target.
+ */
+void StorageTarget::setHasCompressedChunks()
+{
+   if (hasCompressedChunks)
+      return;
+
+   const auto markerPath = path / COMPRESSED_CHUNKS_FILENAME;
+
+   const int fd = open(markerPath.str().c_str(), O_CREAT | O_WRONLY, S_IRUSR | S_IWUSR);
+   if (fd == -1)
+   {
+      LOG(GENERAL, ERR, "Unable to create compressed chunks marker file.",
+            ("path", markerPath.str()), sysErr);
+      return;
+   }
+
+   fsync(fd);
+   close(fd);
+
+   hasCompressedChunks = true;
+}
+
 void StorageTarget::setBuddyNeedsResync(bool needsResync)
 {
    const RWLockGuard lock(rwlock, SafeRWLock_WRITE);
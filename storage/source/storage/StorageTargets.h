@@ -41,6 +41,11 @@ class StorageTarget
       const FDHandle& getMirrorFD() const { return mirrorFD; }
       const QuotaBlockDevice& getQuotaBlockDevice() const { return quotaBlockDevice; }
 
+      /**
+       * @return NUMA node of the block device that holds the target, -1 if unknown
+       */
+      int getNumaNode() const { return numaNode; }
+
       TargetConsistencyState getConsistencyState() const
       {
          RWLockGuard const lock(rwlock, SafeRWLock_READ);
@@ -56,6 +61,13 @@ class StorageTarget
       bool getBuddyResyncInProgress() const { return buddyResyncInProgress; }
       void setBuddyResyncInProgress(bool b) { buddyResyncInProgress = b; }
 
+      /**
+       * @return true if chunk compression was ever enabled for this target, i.e. if chunks might
+       *    have compressed blocks.
+       */
+      bool getHasCompressedChunks() const { return hasCompressedChunks; }
+      void setHasCompressedChunks();
+
       bool getCleanShutdown() const
       {
          RWLockGuard const lock(rwlock, SafeRWLock_READ);
@@ -171,11 +183,13 @@ class StorageTarget
       PreallocatedFile<uint8_t> buddyNeedsResyncFile;
       PreallocatedFile<LastBuddyComm> lastBuddyCommFile;
       QuotaBlockDevice quotaBlockDevice; // quota related information about the block device
+      int numaNode; // NUMA node of the block device, -1 if unknown
       TimerQueue& timerQueue;
       NodeStoreServers& mgmtNodes;
       MirrorBuddyGroupMapper& buddyGroupMapper;
 
       std::atomic<bool> buddyResyncInProgress;
+      std::atomic<bool> hasCompressedChunks;
 
       mutable RWLock rwlock;
       TargetConsistencyState consistencyState;
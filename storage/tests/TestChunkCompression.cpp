@@ -0,0 +1,579 @@
+#include <common/components/TimerQueue.h>
+#include <common/nodes/MirrorBuddyGroupMapper.h>
+#include <common/nodes/NodeStoreServers.h>
+#include <common/toolkit/StorageTk.h>
+#include <common/toolkit/TimeFine.h>
+#include <storage/ChunkCompression.h>
+#include <storage/StorageTargets.h>
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <random>
+#include <sys/xattr.h>
+
+
+// the storage server may be built without liblz4. GTEST_SKIP needs googletest 1.10, with the
+// bundled 1.8 the skip is only reported in the output and as a test property.
+#ifdef GTEST_SKIP
+   #define SKIP_IF_NO_LZ4() \
+      if (!ChunkCompression::isSupported() ) GTEST_SKIP() << "built without liblz4"
+#else
+   #define SKIP_IF_NO_LZ4() \
+      if (!ChunkCompression::isSupported() ) \
+      { \
+         ::testing::Test::RecordProperty("skipped", "built without liblz4"); \
+         std::cout << "[  SKIPPED ] built without liblz4" << std::endl; \
+         return; \
+      }
+#endif
+
+
+namespace {
+
+/**
+ * Text-like data (random words from a small vocabulary), compresses to roughly 1/2 .. 1/3.
+ */
+std::vector<char> makeCompressibleData(size_t len, unsigned seed)
+{
+   static const char* const words[] = {"storage ", "target ", "chunk ", "metadata ", "buddy ",
+      "mirror ", "stripe ", "pattern ", "node ", "client ", "0x", "42", "\n", ", "};
+
+   std::mt19937 rng(seed);
+   std::vector<char> data;
+
+   data.reserve(len + 16);
+
+   while(data.size() < len)
+   {
+      const char* word = words[rng() % (sizeof(words) / sizeof(*words) )];
+      data.insert(data.end(), word, word + strlen(word) );
+   }
+
+   data.resize(len);
+   return data;
+}
+
+std::vector<char> makeRandomData(size_t len, unsigned seed)
+{
+   std::mt19937 rng(seed);
+   std::vector<char> data(len);
+
+   for(auto& byte : data)
+      byte = rng();
+
+   return data;
+}
+
+}
+
+class ChunkCompressionTest : public ::testing::Test
+{
+   protected:
+      static const size_t blockSize = CHUNKCOMPRESSION_BLOCK_SIZE;
+
+      ChunkCompression compression{UInt16Set{1}, {}, NULL};
+      std::string filePath;
+      int fd;
+
+      void SetUp() override
+      {
+         char pathTemplate[] = "/tmp/beegfs-test-chunkcompression-XXXXXX";
+
+         fd = mkstemp(pathTemplate);
+         ASSERT_GE(fd, 0);
+
+         filePath = pathTemplate;
+      }
+
+      void TearDown() override
+      {
+         close(fd);
+         unlink(filePath.c_str() );
+      }
+
+      void write(const std::vector<char>& data, off_t offset)
+      {
+         ASSERT_EQ(compression.write(fd, "chunk", data.data(), data.size(), offset),
+            ssize_t(data.size() ) );
+      }
+
+      void expectContents(const std::vector<char>& expected)
+      {
+         std::vector<char> buf(expected.size() + blockSize);
+
+         ASSERT_EQ(compression.read(fd, "chunk", buf.data(), buf.size(), 0),
+            ssize_t(expected.size() ) );
+
+         buf.resize(expected.size() );
+         ASSERT_TRUE(buf == expected);
+
+         struct stat statBuf;
+         ASSERT_EQ(fstat(fd, &statBuf), 0);
+         ASSERT_EQ(statBuf.st_size, off_t(expected.size() ) );
+      }
+
+      bool hasBlockMap()
+      {
+         return fgetxattr(fd, CHUNKCOMPRESSION_MAP_XATTR, NULL, 0) >= 0;
+      }
+
+      uint64_t getDiskUsage()
+      {
+         struct stat statBuf;
+
+         fsync(fd);
+         fstat(fd, &statBuf);
+
+         return statBuf.st_blocks * 512;
+      }
+};
+
+TEST_F(ChunkCompressionTest, isEnabled)
+{
+   ASSERT_TRUE(compression.isEnabled(1) );
+   ASSERT_FALSE(compression.isEnabled(2) );
+}
+
+TEST_F(ChunkCompressionTest, writeAndReadBack)
+{
+   SKIP_IF_NO_LZ4();
+
+   auto data = makeCompressibleData(4 * blockSize + 1000, 1);
+
+   write(data, 0);
+
+   ASSERT_TRUE(hasBlockMap() );
+   expectContents(data);
+
+   // full blocks are compressed and punched, the partial last block is raw
+   ASSERT_LT(getDiskUsage(), data.size() / 2);
+
+   ChunkCompressionStats stats = compression.getStats();
+
+   ASSERT_EQ(stats.numBlocksCompressed, 4u);
+   ASSERT_EQ(stats.compressedRawBytes, 4 * blockSize);
+   ASSERT_LT(stats.compressedDiskBytes, stats.compressedRawBytes / 2);
+
+   // unaligned reads across compressed and raw blocks
+   std::vector<char> buf(2 * blockSize);
+
+   ASSERT_EQ(compression.read(fd, "chunk", buf.data(), buf.size(), 3 * blockSize + 7),
+      ssize_t(blockSize + 993) );
+   ASSERT_EQ(0, memcmp(buf.data(), &data[3 * blockSize + 7], blockSize + 993) );
+
+   ASSERT_EQ(compression.read(fd, "chunk", buf.data(), buf.size(), data.size() ), 0);
+}
+
+TEST_F(ChunkCompressionTest, partialOverwrite)
+{
+   SKIP_IF_NO_LZ4();
+
+   auto data = makeCompressibleData(3 * blockSize, 1);
+
+   write(data, 0);
+
+   // overwrite across the border of two compressed blocks
+   auto update = makeCompressibleData(1000, 2);
+
+   write(update, blockSize - 500);
+   std::copy(update.begin(), update.end(), data.begin() + blockSize - 500);
+
+   expectContents(data);
+   ASSERT_EQ(compression.getStats().numReadModifyWrites, 2u);
+
+   // incompressible update of a compressed block => block is stored raw
+   auto random = makeRandomData(blockSize / 2, 3);
+
+   write(random, 2 * blockSize);
+   std::copy(random.begin(), random.end(), data.begin() + 2 * blockSize);
+
+   expectContents(data);
+
+   // extend the file from within the last block (partial blocks stay raw)
+   auto tail = makeCompressibleData(blockSize, 4);
+
+   write(tail, 3 * blockSize - 100);
+   data.resize(3 * blockSize - 100);
+   data.insert(data.end(), tail.begin(), tail.end() );
+
+   expectContents(data);
+}
+
+TEST_F(ChunkCompressionTest, incompressibleData)
+{
+   SKIP_IF_NO_LZ4();
+
+   auto data = makeRandomData(2 * blockSize, 1);
+
+   write(data, 0);
+
+   ASSERT_FALSE(hasBlockMap() );
+   expectContents(data);
+
+   ChunkCompressionStats stats = compression.getStats();
+
+   ASSERT_EQ(stats.numBlocksCompressed, 0u);
+   ASSERT_EQ(stats.numBlocksIncompressible, 2u);
+}
+
+TEST_F(ChunkCompressionTest, truncate)
+{
+   SKIP_IF_NO_LZ4();
+
+   auto data = makeCompressibleData(3 * blockSize, 1);
+
+   write(data, 0);
+
+   // truncate into a compressed block
+   ASSERT_EQ(compression.truncate(fd, "chunk", blockSize + 100), 0);
+   data.resize(blockSize + 100);
+
+   expectContents(data);
+
+   // extend => zeros
+   ASSERT_EQ(compression.truncate(fd, "chunk", 3 * blockSize), 0);
+   data.resize(3 * blockSize, 0);
+
+   expectContents(data);
+
+   // truncate to 0 => no compressed blocks, but the block map still marks the chunk
+   ASSERT_EQ(compression.truncate(fd, "chunk", 0), 0);
+
+   ASSERT_TRUE(hasBlockMap() );
+   expectContents({});
+}
+
+TEST_F(ChunkCompressionTest, corruptBlock)
+{
+   SKIP_IF_NO_LZ4();
+
+   auto data = makeCompressibleData(2 * blockSize, 1);
+
+   write(data, 0);
+
+   // overwrite the block header without going through ChunkCompression
+   ASSERT_EQ(pwrite(fd, "garbage!", 8, blockSize), 8);
+
+   std::vector<char> buf(blockSize);
+
+   ASSERT_EQ(compression.read(fd, "chunk", buf.data(), buf.size(), 0), ssize_t(blockSize) );
+
+   ASSERT_EQ(compression.read(fd, "chunk", buf.data(), buf.size(), blockSize), -1);
+   ASSERT_EQ(errno, EIO);
+
+   // change a byte of the compressed data (detected by the checksum)
+   char byte;
+
+   ASSERT_EQ(pread(fd, &byte, 1, 100), 1);
+   byte ^= 1;
+   ASSERT_EQ(pwrite(fd, &byte, 1, 100), 1);
+
+   ASSERT_EQ(compression.read(fd, "chunk", buf.data(), buf.size(), 0), -1);
+   ASSERT_EQ(errno, EIO);
+}
+
+TEST_F(ChunkCompressionTest, mapLimit)
+{
+   SKIP_IF_NO_LZ4();
+
+   const off_t lastMappedBlockStart = off_t(CHUNKCOMPRESSION_MAX_MAP_BYTES * 8 - 1) * blockSize;
+
+   auto data = makeCompressibleData(2 * blockSize, 1);
+
+   // the last block that the map can describe is compressed, the next one is stored raw
+   write(data, lastMappedBlockStart);
+
+   ASSERT_EQ(compression.getStats().numBlocksCompressed, 1u);
+
+   std::vector<char> buf(data.size() );
+
+   ASSERT_EQ(compression.read(fd, "chunk", buf.data(), buf.size(), lastMappedBlockStart),
+      ssize_t(data.size() ) );
+   ASSERT_TRUE(buf == data);
+}
+
+TEST_F(ChunkCompressionTest, markedChunks)
+{
+   SKIP_IF_NO_LZ4();
+
+   char targetDirTemplate[] = "/tmp/beegfs-test-chunkcompression-target-XXXXXX";
+   ASSERT_NE(mkdtemp(targetDirTemplate), nullptr);
+
+   const Path targetPath(targetDirTemplate);
+
+   StorageTarget::prepareTargetDir(targetPath);
+
+   {
+      TimerQueue timerQueue;
+      NodeStoreServers mgmtNodes(NODETYPE_Mgmt, false);
+      MirrorBuddyGroupMapper buddyGroupMapper;
+
+      StorageTarget target(targetPath, 1, timerQueue, mgmtNodes, buddyGroupMapper);
+      ChunkCompression disabledCompression(UInt16Set(), {}, NULL);
+
+      // target never had compression enabled
+      ASSERT_FALSE(disabledCompression.isCompressedChunk(target, fd) );
+      ASSERT_FALSE(hasBlockMap() );
+
+      // a chunk that already has data stays a raw chunk...
+      const std::string rawFilePath = filePath + ".raw";
+
+      int rawFD = open(rawFilePath.c_str(), O_CREAT | O_RDWR, 0600);
+      ASSERT_GE(rawFD, 0);
+      ASSERT_EQ(pwrite(rawFD, "raw", 3, 0), 3);
+
+      ASSERT_FALSE(compression.isCompressedChunk(target, rawFD) );
+      ASSERT_LT(fgetxattr(rawFD, CHUNKCOMPRESSION_MAP_XATTR, NULL, 0), 0);
+      ASSERT_FALSE(target.getHasCompressedChunks() );
+
+      // ...and a new (empty) one is marked
+      ASSERT_TRUE(compression.isCompressedChunk(target, fd) );
+      ASSERT_TRUE(hasBlockMap() );
+      ASSERT_TRUE(target.getHasCompressedChunks() );
+
+      ASSERT_TRUE(compression.isCompressedChunk(target, fd) );
+
+      // marked chunks are still compressed chunks after compression was disabled
+      ASSERT_TRUE(disabledCompression.isCompressedChunk(target, fd) );
+      ASSERT_FALSE(disabledCompression.isCompressedChunk(target, rawFD) );
+
+      close(rawFD);
+      unlink(rawFilePath.c_str() );
+   }
+
+   StorageTk::removeDirRecursive(targetPath.str() );
+}
+
+namespace {
+
+/**
+ * Simulates a crash of the server in the middle of a write: the first numSteps steps (block map
+ * updates, block writes and hole punches) succeed, the next block write only writes its first half
+ * and all further steps fail.
+ */
+class CrashingChunkCompression : public ChunkCompression
+{
+   public:
+      CrashingChunkCompression(unsigned numSteps) :
+         ChunkCompression(UInt16Set{1}, {}, NULL), numSteps(numSteps), numStepsDone(0)
+      {}
+
+      bool hasCrashed() const
+      {
+         return numStepsDone > numSteps;
+      }
+
+   protected:
+      bool storeBlockMap(int fd, const BlockMap& map) override
+      {
+         return step() && ChunkCompression::storeBlockMap(fd, map);
+      }
+
+      bool writeBlock(int fd, const BlockWrite& write) override
+      {
+         if(step() )
+            return ChunkCompression::writeBlock(fd, write);
+
+         if(numStepsDone == numSteps + 1)
+         { // torn write
+            BlockWrite firstHalf = write;
+            firstHalf.len /= 2;
+
+            ChunkCompression::writeBlock(fd, firstHalf);
+         }
+
+         return false;
+      }
+
+      bool punchHole(int fd, const BlockWrite& write) override
+      {
+         return step() && ChunkCompression::punchHole(fd, write);
+      }
+
+   private:
+      const unsigned numSteps;
+      unsigned numStepsDone;
+
+      bool step()
+      {
+         if(numStepsDone++ < numSteps)
+            return true;
+
+         errno = EIO;
+         return false;
+      }
+};
+
+}
+
+TEST_F(ChunkCompressionTest, interruptedWrite)
+{
+   SKIP_IF_NO_LZ4();
+
+   const size_t numBlocks = 4;
+
+   // blocks 0 and 2 compressed, 1 and 3 raw
+   auto oldData = makeCompressibleData(numBlocks * blockSize, 1);
+   auto oldRandom = makeRandomData(blockSize, 2);
+
+   std::copy(oldRandom.begin(), oldRandom.end(), oldData.begin() + blockSize);
+   std::copy(oldRandom.begin(), oldRandom.end(), oldData.begin() + 3 * blockSize);
+
+   // compressed => raw, raw => compressed, compressed => compressed (block 3 is untouched)
+   auto newData = makeCompressibleData(3 * blockSize, 3);
+   auto newRandom = makeRandomData(blockSize, 4);
+
+   std::copy(newRandom.begin(), newRandom.end(), newData.begin() );
+
+   for(unsigned numSteps = 0; ; numSteps++)
+   {
+      ASSERT_EQ(ftruncate(fd, 0), 0);
+      ASSERT_EQ(compression.truncate(fd, "chunk", 0), 0);
+
+      write(oldData, 0);
+
+      CrashingChunkCompression crashingCompression(numSteps);
+
+      const ssize_t writeRes = crashingCompression.write(fd, "chunk", newData.data(),
+         newData.size(), 0);
+
+      // after the crash, each block must have the old or the new data or be unreadable
+      for(size_t blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+      {
+         std::vector<char> buf(blockSize);
+
+         const ssize_t readRes = compression.read(fd, "chunk", buf.data(), blockSize,
+            blockIndex * blockSize);
+
+         if(readRes == -1)
+         {
+            ASSERT_EQ(errno, EIO) << numSteps;
+            ASSERT_TRUE(crashingCompression.hasCrashed() ) << numSteps;
+            continue;
+         }
+
+         ASSERT_EQ(readRes, ssize_t(blockSize) ) << numSteps;
+
+         const bool isOld = std::equal(buf.begin(), buf.end(),
+            oldData.begin() + blockIndex * blockSize);
+         const bool isNew = (blockIndex < 3) && std::equal(buf.begin(), buf.end(),
+            newData.begin() + blockIndex * blockSize);
+
+         ASSERT_TRUE(isOld || isNew) << "block " << blockIndex << ", steps " << numSteps;
+
+         if(!crashingCompression.hasCrashed() )
+         {
+            ASSERT_TRUE(isNew || (blockIndex == 3) ) << numSteps;
+         }
+      }
+
+      if(!crashingCompression.hasCrashed() )
+      {
+         ASSERT_EQ(writeRes, ssize_t(newData.size() ) );
+         ASSERT_GE(numSteps, 5u); // map update, 3 block writes, 2 hole punches, map update
+         break;
+      }
+
+      ASSERT_EQ(writeRes, -1);
+   }
+}
+
+TEST_F(ChunkCompressionTest, writeOnlyHandle)
+{
+   // targets without compressed chunks keep the access mode of the handle
+   ASSERT_EQ(compression.getChunkOpenFlags(2, false, O_WRONLY | O_CREAT), O_WRONLY | O_CREAT);
+   ASSERT_EQ(compression.getChunkOpenFlags(1, false, O_RDONLY), O_RDONLY);
+   ASSERT_EQ(compression.getChunkOpenFlags(2, true, O_RDWR), O_RDWR);
+
+   ASSERT_EQ(compression.getChunkOpenFlags(1, false, O_WRONLY | O_CREAT), O_RDWR | O_CREAT);
+   ASSERT_EQ(compression.getChunkOpenFlags(2, true, O_WRONLY), O_RDWR);
+
+   SKIP_IF_NO_LZ4();
+
+   auto data = makeCompressibleData(2 * blockSize, 1);
+
+   write(data, 0);
+
+   // partial overwrite of a compressed block needs to read the block
+   auto update = makeCompressibleData(1000, 2);
+   std::copy(update.begin(), update.end(), data.begin() + 100);
+
+   int writeOnlyFD = open(filePath.c_str(), O_WRONLY);
+   ASSERT_GE(writeOnlyFD, 0);
+
+   ASSERT_EQ(compression.write(writeOnlyFD, "chunk", update.data(), update.size(), 100), -1);
+   ASSERT_EQ(errno, EBADF);
+
+   close(writeOnlyFD);
+
+   int sessionFD = open(filePath.c_str(), compression.getChunkOpenFlags(1, false, O_WRONLY) );
+   ASSERT_GE(sessionFD, 0);
+
+   ASSERT_EQ(compression.write(sessionFD, "chunk", update.data(), update.size(), 100),
+      ssize_t(update.size() ) );
+
+   close(sessionFD);
+
+   expectContents(data);
+}
+
+/**
+ * Write and read throughput and compression ratio for text-like data.
+ */
+TEST_F(ChunkCompressionTest, DISABLED_throughput)
+{
+   SKIP_IF_NO_LZ4();
+
+   const size_t fileSize = 64 << 20;
+   const size_t ioSize = 512 << 10;
+
+   auto data = makeCompressibleData(fileSize, 1);
+
+   for(bool compressed : {false, true})
+   {
+      TimeFine startWriteT;
+
+      for(size_t offset = 0; offset < fileSize; offset += ioSize)
+      {
+         ssize_t writeRes = compressed
+            ? compression.write(fd, "chunk", &data[offset], ioSize, offset)
+            : pwrite(fd, &data[offset], ioSize, offset);
+
+         ASSERT_EQ(writeRes, ssize_t(ioSize) );
+      }
+
+      const uint64_t writeMicros = TimeFine().elapsedSinceMicro(&startWriteT);
+      const uint64_t diskUsage = getDiskUsage();
+
+      std::vector<char> buf(ioSize);
+      TimeFine startReadT;
+
+      for(size_t offset = 0; offset < fileSize; offset += ioSize)
+      {
+         ssize_t readRes = compressed
+            ? compression.read(fd, "chunk", buf.data(), ioSize, offset)
+            : pread(fd, buf.data(), ioSize, offset);
+
+         ASSERT_EQ(readRes, ssize_t(ioSize) );
+      }
+
+      const uint64_t readMicros = TimeFine().elapsedSinceMicro(&startReadT);
+
+      std::cout << (compressed ? "compressed: " : "raw:        ")
+         << "write " << fileSize / writeMicros << " MB/s, "
+         << "read " << fileSize / readMicros << " MB/s (page cache), "
+         << "disk usage " << (diskUsage >> 20) << " MiB" << std::endl;
+
+      ASSERT_EQ(ftruncate(fd, 0), 0);
+      ASSERT_EQ(compression.removeBlockMap(fd, "chunk"), 0);
+   }
+
+   ChunkCompressionStats stats = compression.getStats();
+
+   std::cout << "ratio " << double(stats.compressedRawBytes) / stats.compressedDiskBytes
+      << ", compress " << stats.compressedRawBytes / BEEGFS_MAX(stats.compressMicros, 1u)
+      << " MB/s/core, decompress "
+      << stats.numBlocksDecompressed * blockSize / BEEGFS_MAX(stats.decompressMicros, 1u)
+      << " MB/s/core" << std::endl;
+}
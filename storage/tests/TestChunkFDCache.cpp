@@ -0,0 +1,91 @@
+#include <storage/ChunkFDCache.h>
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+
+
+static FDHandle openDevNull()
+{
+   return FDHandle(::open("/dev/null", O_RDONLY) );
+}
+
+TEST(ChunkFDCache, sessionsShareFD)
+{
+   ChunkFDCache cache(0, 0);
+
+   ASSERT_FALSE(cache.acquire(3, "a/b/chunk", O_RDONLY).valid() );
+
+   ChunkFDCache::Ref first = cache.insert(3, "a/b/chunk", O_RDONLY, openDevNull() );
+   ChunkFDCache::Ref second = cache.acquire(3, "a/b/chunk", O_RDONLY);
+
+   ASSERT_TRUE(second.valid() );
+   ASSERT_EQ(first.getFD().get(), second.getFD().get() );
+
+   // other open flags or another target dir don't share the fd
+   ASSERT_FALSE(cache.acquire(3, "a/b/chunk", O_RDWR).valid() );
+   ASSERT_FALSE(cache.acquire(4, "a/b/chunk", O_RDONLY).valid() );
+
+   ChunkFDCacheStats stats = cache.getStats();
+
+   ASSERT_EQ(stats.numOpens, 1u);
+   ASSERT_EQ(stats.numOpensAvoided, 1u);
+   ASSERT_EQ(stats.numFDs, 1u);
+
+   // without idle fds, the last session closes the fd
+   first.reset();
+   ASSERT_EQ(cache.getStats().numFDs, 1u);
+
+   second.reset();
+   ASSERT_EQ(cache.getStats().numFDs, 0u);
+}
+
+TEST(ChunkFDCache, idleFDsAreEvictedLRU)
+{
+   ChunkFDCache cache(2, 0);
+
+   for (const char* chunk : {"c1", "c2", "c3"})
+      cache.insert(3, chunk, O_RDONLY, openDevNull() ); // released immediately => idle
+
+   ChunkFDCacheStats stats = cache.getStats();
+
+   ASSERT_EQ(stats.numIdleFDs, 2u);
+   ASSERT_EQ(stats.numEvictions, 1u);
+
+   ASSERT_FALSE(cache.acquire(3, "c1", O_RDONLY).valid() );
+   ASSERT_TRUE(cache.acquire(3, "c2", O_RDONLY).valid() );
+   ASSERT_TRUE(cache.acquire(3, "c3", O_RDONLY).valid() );
+}
+
+TEST(ChunkFDCache, fdLimit)
+{
+   ChunkFDCache cache(100, 4); // at most 2 fds
+
+   ChunkFDCache::Ref used1 = cache.insert(3, "c1", O_RDONLY, openDevNull() );
+   ChunkFDCache::Ref used2 = cache.insert(3, "c2", O_RDONLY, openDevNull() );
+
+   cache.insert(3, "c3", O_RDONLY, openDevNull() );
+
+   // referenced fds are never closed by the cache
+   ASSERT_EQ(cache.getStats().numFDs, 2u);
+   ASSERT_TRUE(used1.valid() );
+   ASSERT_TRUE(used2.valid() );
+}
+
+TEST(ChunkFDCache, invalidate)
+{
+   ChunkFDCache cache(10, 0);
+
+   ChunkFDCache::Ref used = cache.insert(3, "c1", O_RDONLY, openDevNull() );
+   cache.insert(3, "c1", O_RDWR, openDevNull() ); // idle
+
+   cache.invalidate(3, "c1");
+
+   ASSERT_EQ(cache.getStats().numFDs, 0u);
+   ASSERT_FALSE(cache.acquire(3, "c1", O_RDONLY).valid() );
+   ASSERT_FALSE(cache.acquire(3, "c1", O_RDWR).valid() );
+
+   // sessions keep using their fd until they close it
+   ASSERT_TRUE(used.valid() );
+   ASSERT_EQ(used.reset(), 0);
+}
@@ -0,0 +1,224 @@
+#include <common/storage/quota/ExceededQuotaStore.h>
+#include <common/storage/PathInfo.h>
+#include <common/toolkit/StorageTk.h>
+#include <common/toolkit/Time.h>
+#include <storage/ChunkStore.h>
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <functional>
+#include <iostream>
+#include <sys/stat.h>
+
+
+/**
+ * Uses a temporary dir as storage target.
+ */
+class ChunkStoreTest : public ::testing::Test
+{
+   protected:
+      std::string targetPath;
+      int targetFD;
+
+      void SetUp() override
+      {
+         char pathTemplate[] = "/tmp/beegfs-test-chunkstore-XXXXXX";
+
+         ASSERT_NE(mkdtemp(pathTemplate), nullptr);
+
+         targetPath = pathTemplate;
+         targetFD = open(targetPath.c_str(), O_DIRECTORY | O_RDONLY);
+
+         ASSERT_GE(targetFD, 0);
+      }
+
+      void TearDown() override
+      {
+         close(targetFD);
+         StorageTk::removeDirRecursive(targetPath);
+      }
+
+      static void getChunkPath(const std::string& parentID, const std::string& chunkID,
+         Path& outChunkDirPath, std::string& outChunkFilePath)
+      {
+         PathInfo pathInfo(1000, parentID, PATHINFO_FEATURE_ORIG);
+
+         StorageTk::getChunkDirChunkFilePath(&pathInfo, chunkID, true, outChunkDirPath,
+            outChunkFilePath);
+      }
+
+      /**
+       * @return fd of the chunk or -1
+       */
+      int openChunk(ChunkStore& store, const std::string& parentID, const std::string& chunkID,
+         int openFlags)
+      {
+         Path chunkDirPath;
+         std::string chunkFilePath;
+         SessionQuotaInfo quotaInfo(false, false, 0, 0);
+         int fd = -1;
+
+         getChunkPath(parentID, chunkID, chunkDirPath, chunkFilePath);
+
+         FhgfsOpsErr openRes = store.openChunkFile(targetFD, &chunkDirPath, chunkFilePath, true,
+            openFlags, &fd, &quotaInfo, ExceededQuotaStorePtr() );
+
+         return (openRes == FhgfsOpsErr_SUCCESS) ? fd : -1;
+      }
+
+      bool chunkExists(const std::string& parentID, const std::string& chunkID)
+      {
+         Path chunkDirPath;
+         std::string chunkFilePath;
+         struct stat statBuf;
+
+         getChunkPath(parentID, chunkID, chunkDirPath, chunkFilePath);
+
+         return fstatat(targetFD, chunkFilePath.c_str(), &statBuf, 0) == 0;
+      }
+};
+
+TEST_F(ChunkStoreTest, reopenUsesCachedDirFD)
+{
+   ChunkStore store(1024);
+
+   int fd = openChunk(store, "parent", "chunk1", O_CREAT | O_RDWR);
+   ASSERT_GE(fd, 0);
+   close(fd);
+
+   uint64_t hitsBefore = store.getCacheStats().numHits;
+
+   fd = openChunk(store, "parent", "chunk2", O_CREAT | O_RDWR);
+   ASSERT_GE(fd, 0);
+   close(fd);
+
+   ASSERT_GT(store.getCacheStats().numHits, hitsBefore);
+   ASSERT_TRUE(chunkExists("parent", "chunk1") );
+   ASSERT_TRUE(chunkExists("parent", "chunk2") );
+}
+
+TEST_F(ChunkStoreTest, removedDirIsRecreated)
+{
+   ChunkStore store(1024);
+   Path chunkDirPath;
+   std::string chunkFilePath;
+
+   getChunkPath("parent", "chunk", chunkDirPath, chunkFilePath);
+
+   // keeps the uid dir, which rmdirChunkDirPath() would remove otherwise
+   int fd = openChunk(store, "otherParent", "chunk", O_CREAT | O_RDWR);
+   ASSERT_GE(fd, 0);
+   close(fd);
+
+   fd = openChunk(store, "parent", "chunk", O_CREAT | O_RDWR);
+   ASSERT_GE(fd, 0);
+   close(fd);
+
+   // like UnlinkLocalFileMsgEx
+   ASSERT_EQ(unlinkat(targetFD, chunkFilePath.c_str(), 0), 0);
+   ASSERT_TRUE(store.rmdirChunkDirPath(targetFD, &chunkDirPath) );
+   ASSERT_FALSE(chunkExists("parent", "chunk") );
+
+   fd = openChunk(store, "parent", "chunk", O_CREAT | O_RDWR);
+   ASSERT_GE(fd, 0);
+   close(fd);
+
+   ASSERT_TRUE(chunkExists("parent", "chunk") );
+}
+
+/*
+ * The chunk dir was removed and recreated without rmdirChunkDirPath(), so the cached fd refers
+ * to the removed dir.
+ */
+TEST_F(ChunkStoreTest, staleDirFDFallsBackToPath)
+{
+   ChunkStore store(1024);
+   Path chunkDirPath;
+   std::string chunkFilePath;
+
+   getChunkPath("parent", "chunk", chunkDirPath, chunkFilePath);
+
+   int fd = openChunk(store, "parent", "chunk", O_CREAT | O_RDWR);
+   ASSERT_GE(fd, 0);
+   close(fd);
+
+   ASSERT_EQ(unlinkat(targetFD, chunkFilePath.c_str(), 0), 0);
+   ASSERT_EQ(unlinkat(targetFD, chunkDirPath.str().c_str(), AT_REMOVEDIR), 0);
+   ASSERT_EQ(mkdirat(targetFD, chunkDirPath.str().c_str(), 0755), 0);
+
+   fd = openat(targetFD, chunkFilePath.c_str(), O_CREAT | O_RDWR, 0644);
+   ASSERT_GE(fd, 0);
+   close(fd);
+
+   // without O_CREAT
+   fd = openChunk(store, "parent", "chunk", O_RDWR);
+   ASSERT_GE(fd, 0);
+   close(fd);
+
+   // with O_CREAT
+   fd = openChunk(store, "parent", "chunk2", O_CREAT | O_RDWR);
+   ASSERT_GE(fd, 0);
+   close(fd);
+
+   ASSERT_TRUE(chunkExists("parent", "chunk2") );
+}
+
+/*
+ * Compares chunk opens via ChunkStore (with cached dir fds) to opens by full path. Disabled by
+ * default, because it only prints timings.
+ */
+TEST_F(ChunkStoreTest, DISABLED_benchmarkOpenCreate)
+{
+   const unsigned numDirs = 100;
+   const unsigned numChunksPerDir = 200;
+   const unsigned numChunks = numDirs * numChunksPerDir;
+
+   ChunkStore store(2 * numDirs);
+
+   auto forEachChunk = [&] (std::function<void (const std::string&, const std::string&)> func) {
+      for (unsigned chunk = 0; chunk < numChunksPerDir; chunk++)
+         for (unsigned dir = 0; dir < numDirs; dir++)
+            func("parent" + std::to_string(dir), "chunk" + std::to_string(chunk) );
+   };
+
+   Time startTime;
+
+   forEachChunk([&] (const std::string& parentID, const std::string& chunkID) {
+      int fd = openChunk(store, parentID, chunkID, O_CREAT | O_RDWR);
+      ASSERT_GE(fd, 0);
+      close(fd);
+   });
+
+   unsigned createMS = startTime.elapsedMS();
+
+   startTime.setToNow();
+
+   forEachChunk([&] (const std::string& parentID, const std::string& chunkID) {
+      int fd = openChunk(store, parentID, chunkID, O_CREAT | O_RDWR);
+      ASSERT_GE(fd, 0);
+      close(fd);
+   });
+
+   unsigned openCachedMS = startTime.elapsedMS();
+
+   startTime.setToNow();
+
+   forEachChunk([&] (const std::string& parentID, const std::string& chunkID) {
+      Path chunkDirPath;
+      std::string chunkFilePath;
+
+      getChunkPath(parentID, chunkID, chunkDirPath, chunkFilePath);
+
+      int fd = openat(targetFD, chunkFilePath.c_str(), O_CREAT | O_RDWR, 0644);
+      ASSERT_GE(fd, 0);
+      close(fd);
+   });
+
+   unsigned openPathMS = startTime.elapsedMS();
+
+   std::cout << "chunks: " << numChunks << " in " << numDirs << " dirs; " <<
+      "create: " << createMS << "ms; " <<
+      "open (cached dir fds): " << openCachedMS << "ms; " <<
+      "open (full path): " << openPathMS << "ms" << std::endl;
+}
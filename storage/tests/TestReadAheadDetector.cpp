@@ -0,0 +1,195 @@
+#include <storage/ReadAheadDetector.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+
+#define KB (1024LL)
+#define MB (1024LL*1024)
+
+static const ReadAheadDetector::Config defaultCfg = {2*MB, 1*MB, 4*MB};
+
+
+TEST(ReadAheadDetector, sequential)
+{
+   ReadAheadDetector detector;
+
+   // below trigger size
+   ReadAheadAdvice advice = detector.onRead(0, 1*MB, defaultCfg);
+   ASSERT_EQ(advice.pattern, ReadAheadPattern_NONE);
+   ASSERT_TRUE(advice.ranges.empty() );
+
+   // trigger reached => first window
+   advice = detector.onRead(1*MB, 1*MB, defaultCfg);
+   ASSERT_EQ(advice.pattern, ReadAheadPattern_SEQUENTIAL);
+   ASSERT_FALSE(advice.isHit);
+   ASSERT_FALSE(advice.isMiss);
+   ASSERT_EQ(advice.ranges.size(), 1u);
+   ASSERT_EQ(advice.ranges[0].offset, 2*MB);
+   ASSERT_EQ(advice.ranges[0].len, 1*MB);
+
+   // hits, window ramps up to the max size
+   advice = detector.onRead(2*MB, 1*MB, defaultCfg);
+   ASSERT_TRUE(advice.isHit);
+   ASSERT_EQ(advice.ranges.size(), 1u);
+   ASSERT_EQ(advice.ranges[0].offset, 3*MB);
+   ASSERT_EQ(advice.ranges[0].len, 2*MB);
+
+   advice = detector.onRead(3*MB, 1*MB, defaultCfg);
+   ASSERT_TRUE(advice.isHit);
+   ASSERT_EQ(advice.ranges.size(), 1u);
+   ASSERT_EQ(advice.ranges[0].offset, 5*MB);
+   ASSERT_EQ(advice.ranges[0].len, 3*MB);
+
+   // enough data ahead => nothing new
+   advice = detector.onRead(4*MB, 1*MB, defaultCfg);
+   ASSERT_TRUE(advice.isHit);
+   ASSERT_TRUE(advice.ranges.empty() );
+
+   // read-ahead stays within max window ahead of the reads
+   for(int64_t offset = 5*MB; offset < 64*MB; offset += 1*MB)
+   {
+      advice = detector.onRead(offset, 1*MB, defaultCfg);
+      ASSERT_TRUE(advice.isHit);
+
+      for(const auto& range : advice.ranges)
+         ASSERT_LE(range.offset + range.len, offset + 1*MB + defaultCfg.maxWindow);
+   }
+}
+
+TEST(ReadAheadDetector, missGrowsWindow)
+{
+   ReadAheadDetector detector;
+   const ReadAheadDetector::Config cfg = {4*MB, 1*MB, 16*MB};
+
+   detector.onRead(0, 4*MB, cfg);
+
+   ReadAheadAdvice advice = detector.onRead(4*MB, 4*MB, cfg);
+   ASSERT_EQ(advice.ranges.size(), 1u);
+   ASSERT_EQ(advice.ranges[0].offset, 8*MB);
+   ASSERT_EQ(advice.ranges[0].len, 1*MB);
+
+   // read is larger than the read-ahead => miss, window grows
+   advice = detector.onRead(8*MB, 4*MB, cfg);
+   ASSERT_TRUE(advice.isMiss);
+   ASSERT_EQ(advice.ranges.size(), 1u);
+   ASSERT_EQ(advice.ranges[0].offset, 12*MB);
+   ASSERT_EQ(advice.ranges[0].len, 4*MB);
+
+   advice = detector.onRead(12*MB, 4*MB, cfg);
+   ASSERT_TRUE(advice.isHit);
+}
+
+TEST(ReadAheadDetector, strided)
+{
+   ReadAheadDetector detector;
+
+   // 4k records every 64k
+   ASSERT_EQ(detector.onRead(0, 4*KB, defaultCfg).pattern, ReadAheadPattern_NONE);
+   ASSERT_EQ(detector.onRead(64*KB, 4*KB, defaultCfg).pattern, ReadAheadPattern_NONE);
+
+   ReadAheadAdvice advice = detector.onRead(128*KB, 4*KB, defaultCfg);
+   ASSERT_EQ(advice.pattern, ReadAheadPattern_STRIDED);
+   ASSERT_EQ(advice.ranges.size(), unsigned(READAHEADDETECTOR_MAX_RANGES) );
+
+   for(unsigned i = 0; i < advice.ranges.size(); i++)
+   {
+      ASSERT_EQ(advice.ranges[i].offset, 128*KB + (i + 1) * 64*KB);
+      ASSERT_EQ(advice.ranges[i].len, 4*KB);
+   }
+
+   // following records are hits, new records are prefetched when half of them were read
+   unsigned numRangesIssued = 0;
+
+   for(int64_t offset = 192*KB; offset < 128*KB + 64*64*KB; offset += 64*KB)
+   {
+      advice = detector.onRead(offset, 4*KB, defaultCfg);
+      ASSERT_EQ(advice.pattern, ReadAheadPattern_STRIDED);
+      ASSERT_TRUE(advice.isHit) << offset;
+
+      for(const auto& range : advice.ranges)
+      {
+         ASSERT_GT(range.offset, offset);
+         ASSERT_EQ( (range.offset - offset) % (64*KB), 0);
+         numRangesIssued++;
+      }
+   }
+
+   ASSERT_GT(numRangesIssued, 0u);
+}
+
+TEST(ReadAheadDetector, backward)
+{
+   ReadAheadDetector detector;
+
+   // 64k reads backwards from 10M => adjacent records are merged into one range
+   detector.onRead(10*MB, 64*KB, defaultCfg);
+   detector.onRead(10*MB - 64*KB, 64*KB, defaultCfg);
+
+   ReadAheadAdvice advice = detector.onRead(10*MB - 128*KB, 64*KB, defaultCfg);
+   ASSERT_EQ(advice.pattern, ReadAheadPattern_BACKWARD);
+   ASSERT_EQ(advice.ranges.size(), 1u);
+   ASSERT_EQ(advice.ranges[0].offset, 10*MB - 128*KB - 1*MB);
+   ASSERT_EQ(advice.ranges[0].len, 1*MB);
+
+   advice = detector.onRead(10*MB - 192*KB, 64*KB, defaultCfg);
+   ASSERT_TRUE(advice.isHit);
+
+   // read-ahead stops at the beginning of the file
+   ReadAheadDetector startDetector;
+
+   startDetector.onRead(256*KB, 64*KB, defaultCfg);
+   startDetector.onRead(192*KB, 64*KB, defaultCfg);
+
+   advice = startDetector.onRead(128*KB, 64*KB, defaultCfg);
+   ASSERT_EQ(advice.pattern, ReadAheadPattern_BACKWARD);
+   ASSERT_EQ(advice.ranges.size(), 1u);
+   ASSERT_EQ(advice.ranges[0].offset, 0);
+   ASSERT_EQ(advice.ranges[0].len, 128*KB);
+}
+
+TEST(ReadAheadDetector, interleavedStreams)
+{
+   ReadAheadDetector detector;
+   unsigned numSequentialA = 0;
+   unsigned numSequentialB = 0;
+
+   // two sequential readers sharing a session, e.g. two ranks of an MPI job
+   for(int64_t i = 0; i < 16; i++)
+   {
+      if(detector.onRead(i * MB, 1*MB, defaultCfg).pattern == ReadAheadPattern_SEQUENTIAL)
+         numSequentialA++;
+
+      if(detector.onRead(512*MB + i * MB, 1*MB, defaultCfg).pattern ==
+            ReadAheadPattern_SEQUENTIAL)
+         numSequentialB++;
+   }
+
+   ASSERT_GE(numSequentialA, 14u);
+   ASSERT_GE(numSequentialB, 14u);
+}
+
+TEST(ReadAheadDetector, random)
+{
+   ReadAheadDetector detector;
+   std::mt19937_64 rand(42);
+
+   for(unsigned i = 0; i < 1000; i++)
+   {
+      const int64_t offset = (rand() % (16*1024) ) * 64*KB;
+      const ReadAheadAdvice advice = detector.onRead(offset, 64*KB, defaultCfg);
+
+      ASSERT_EQ(advice.pattern, ReadAheadPattern_NONE) << i;
+      ASSERT_TRUE(advice.ranges.empty() );
+   }
+}
+
+TEST(ReadAheadDetector, disabled)
+{
+   ReadAheadDetector detector;
+   const ReadAheadDetector::Config cfg = {0, 0, 0};
+
+   for(int64_t offset = 0; offset < 16*MB; offset += 1*MB)
+      ASSERT_EQ(detector.onRead(offset, 1*MB, cfg).pattern, ReadAheadPattern_NONE);
+}
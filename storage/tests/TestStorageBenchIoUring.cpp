@@ -0,0 +1,161 @@
+#include <components/benchmarker/StorageBenchIoUring.h>
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+
+
+// io_uring may be unavailable (old kernel, seccomp). GTEST_SKIP needs googletest 1.10, with the
+// bundled 1.8 the skip is only reported in the output and as a test property.
+#ifdef GTEST_SKIP
+   #define SKIP_IF_NO_IOURING(initRes) \
+      if (!(initRes) ) GTEST_SKIP() << "io_uring not available: " << strerror(errno)
+#else
+   #define SKIP_IF_NO_IOURING(initRes) \
+      if (!(initRes) ) \
+      { \
+         const std::string skipReason = std::string("io_uring not available: ") + strerror(errno); \
+         ::testing::Test::RecordProperty("skipped", skipReason); \
+         std::cout << "[  SKIPPED ] " << skipReason << std::endl; \
+         return; \
+      }
+#endif
+
+
+class StorageBenchIoUringTest : public ::testing::Test
+{
+   protected:
+      StorageBenchIoUring ioUring;
+      std::string filePath;
+      int fd;
+
+      void SetUp() override
+      {
+         char pathTemplate[] = "/tmp/beegfs-test-storagebench-XXXXXX";
+
+         fd = mkstemp(pathTemplate);
+         ASSERT_GE(fd, 0);
+
+         filePath = pathTemplate;
+      }
+
+      void TearDown() override
+      {
+         close(fd);
+         unlink(filePath.c_str() );
+      }
+
+      static StorageBenchIoUringOp makeOp(bool isWrite, int fd, char* buf, size_t len,
+         off_t offset)
+      {
+         StorageBenchIoUringOp op;
+
+         op.isWrite = isWrite;
+         op.fd = fd;
+         op.buf = buf;
+         op.len = len;
+         op.offset = offset;
+         op.result = 0;
+
+         return op;
+      }
+};
+
+TEST_F(StorageBenchIoUringTest, writeAndReadBack)
+{
+   const unsigned numOps = 8;
+   const size_t blocksize = 4096;
+
+   SKIP_IF_NO_IOURING(ioUring.init(numOps) );
+
+   std::vector<std::vector<char>> writeBufs;
+   std::vector<std::vector<char>> readBufs(numOps, std::vector<char>(blocksize, 0) );
+   std::vector<StorageBenchIoUringOp> ops;
+
+   for (unsigned i = 0; i < numOps; i++)
+      writeBufs.emplace_back(blocksize, char('a' + i) );
+
+   // write blocks in reverse order
+   for (unsigned i = 0; i < numOps; i++)
+      ops.push_back(makeOp(true, fd, writeBufs[i].data(), blocksize,
+         (numOps - 1 - i) * blocksize) );
+
+   LatencyHistogram latency;
+
+   ASSERT_TRUE(ioUring.run(ops, &latency) );
+
+   for (auto iter = ops.begin(); iter != ops.end(); iter++)
+      ASSERT_EQ(iter->result, ssize_t(blocksize) );
+
+   ops.clear();
+
+   for (unsigned i = 0; i < numOps; i++)
+      ops.push_back(makeOp(false, fd, readBufs[i].data(), blocksize, i * blocksize) );
+
+   ASSERT_TRUE(ioUring.run(ops, &latency) );
+
+   for (unsigned i = 0; i < numOps; i++)
+   {
+      ASSERT_EQ(ops[i].result, ssize_t(blocksize) );
+      ASSERT_EQ(readBufs[i], writeBufs[numOps - 1 - i]);
+   }
+
+   LatencyHistogramData latencyData;
+   latency.snapshot(latencyData);
+
+   ASSERT_EQ(latencyData.count, 2 * numOps);
+}
+
+TEST_F(StorageBenchIoUringTest, opErrorsAreReported)
+{
+   SKIP_IF_NO_IOURING(ioUring.init(4) );
+
+   char buf[512];
+   std::vector<StorageBenchIoUringOp> ops;
+
+   ops.push_back(makeOp(false, -1, buf, sizeof(buf), 0) );
+   ops.push_back(makeOp(true, fd, buf, sizeof(buf), 0) );
+
+   ASSERT_TRUE(ioUring.run(ops, NULL) );
+   ASSERT_EQ(ops[0].result, -EBADF);
+   ASSERT_EQ(ops[1].result, ssize_t(sizeof(buf) ) );
+}
+
+TEST_F(StorageBenchIoUringTest, moreOpsThanIoDepth)
+{
+   const unsigned ioDepth = 3;
+   const unsigned numOps = 100;
+   const size_t blocksize = 512;
+
+   SKIP_IF_NO_IOURING(ioUring.init(ioDepth) );
+
+   std::vector<std::vector<char>> bufs;
+   std::vector<StorageBenchIoUringOp> ops;
+
+   for (unsigned i = 0; i < numOps; i++)
+      bufs.emplace_back(blocksize, char(i) );
+
+   for (unsigned i = 0; i < numOps; i++)
+      ops.push_back(makeOp(true, fd, bufs[i].data(), blocksize, i * blocksize) );
+
+   LatencyHistogram latency;
+
+   // completed ops are replaced by the next ones, so ops.size() may exceed the ring size
+   ASSERT_TRUE(ioUring.run(ops, &latency) );
+
+   for (auto iter = ops.begin(); iter != ops.end(); iter++)
+      ASSERT_EQ(iter->result, ssize_t(blocksize) );
+
+   std::vector<char> readBuf(blocksize);
+
+   for (unsigned i = 0; i < numOps; i++)
+   {
+      ASSERT_EQ(pread(fd, readBuf.data(), blocksize, i * blocksize), ssize_t(blocksize) );
+      ASSERT_EQ(readBuf, bufs[i]);
+   }
+
+   LatencyHistogramData latencyData;
+   latency.snapshot(latencyData);
+
+   ASSERT_EQ(latencyData.count, numOps);
+}